@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  bandSolver.h: Banded linear solver of tKinemat::SolveLinearSystem, the
+**                bandec()/banbks() of Numerical Recipes in C by Press et.
+**                al with the band width as a template argument
+**
+***************************************************************************/
+
+#ifndef BANDSOLVER_H
+#define BANDSOLVER_H
+
+#include <cmath>
+
+/*****************************************************************************
+**
+**  BandDecompose<M1,M2>(), BandBackSubstitute<M1,M2>()
+**
+**  LU decomposition with partial pivoting of a banded matrix with M1 sub-
+**  and M2 super-diagonals, and the solution of A*x = b with it. Same
+**  algorithm as bandec()/banbks(), but the band width is a template
+**  argument and the matrix is stored row by row in one flat array: row i
+**  is a[i*(M1+M2+2)+1 .. i*(M1+M2+2)+M1+M2+1], the factor al has rows of
+**  M1+1. Indices of rows and of 'b' start from 1.
+**
+*****************************************************************************/
+
+#define TINY 1.0E-20
+
+template <int M1, int M2>
+inline void BandDecompose(double *a, double *al, unsigned long *indx,
+                          unsigned long N) {
+    const unsigned long mm = M1 + M2 + 1;
+    const unsigned long ra = mm + 1, rl = M1 + 1;
+    unsigned long i, j, k, l;
+    double dum;
+
+    l = M1;
+    for (i = 1; i <= M1; i++) {
+        for (j = M1 + 2 - i; j <= mm; j++) a[i * ra + j - l] = a[i * ra + j];
+        l--;
+        for (j = mm - l; j <= mm; j++) a[i * ra + j] = 0.0;
+    }
+    l = M1;
+
+    for (k = 1; k <= N; k++) {
+        dum = a[k * ra + 1];
+        i = k;
+        if (l < N) l++;
+        for (j = k + 1; j <= l; j++) {
+            if (fabs(a[j * ra + 1]) > fabs(dum)) {
+                dum = a[j * ra + 1];
+                i = j;
+            }
+        }
+        indx[k] = i;
+        if (dum == 0.0) a[k * ra + 1] = TINY;
+        if (i != k) {
+            for (j = 1; j <= mm; j++) {
+                dum = a[k * ra + j];
+                a[k * ra + j] = a[i * ra + j];
+                a[i * ra + j] = dum;
+            }
+        }
+        for (i = k + 1; i <= l; i++) {
+            dum = a[i * ra + 1] / a[k * ra + 1];
+            al[k * rl + i - k] = dum;
+            for (j = 2; j <= mm; j++) a[i * ra + j - 1] = a[i * ra + j] - dum * a[k * ra + j];
+            a[i * ra + mm] = 0.0;
+        }
+    }
+}
+
+template <int M1, int M2>
+inline void BandBackSubstitute(const double *a, const double *al,
+                               const unsigned long *indx, double *b,
+                               unsigned long N) {
+    const unsigned long mm = M1 + M2 + 1;
+    const unsigned long ra = mm + 1, rl = M1 + 1;
+    unsigned long i, k, l;
+    double dum;
+
+    l = M1;
+    for (k = 1; k <= N; k++) {
+        i = indx[k];
+        if (i != k) {
+            dum = b[k];
+            b[k] = b[i];
+            b[i] = dum;
+        }
+        if (l < N) l++;
+        for (i = k + 1; i <= l; i++) b[i] -= al[k * rl + i - k] * b[k];
+    }
+    l = 1;
+    for (i = N; i >= 1; i--) {
+        dum = b[i];
+        for (k = 2; k <= l; k++) dum -= a[i * ra + k] * b[k + i - 1];
+        b[i] = dum / a[i * ra + 1];
+        if (l < mm) l++;
+    }
+}
+
+#undef TINY
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of bandSolver.h
+//
+//
+//=========================================================================
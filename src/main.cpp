@@ -18,6 +18,7 @@
 #include "src/tSimulator/tSimul.h"
 #include "src/Headers/TemplDefinitions.h"
 #include "src/tHydro/tSnowPack.h" // SKY2008Snow from AJR2007
+#include "src/tThreadPool/tThreadPool.h"
 
 
 #ifdef PARALLEL_TRIBS
@@ -69,6 +70,9 @@ int serialSimulation( int argc, char **argv )
 	Cout<<"\n\nPart 1: Read Input Parameters from "<<"'"<<argv[1]<<"'"<<endl;
 	Cout<<"---------------------------------------------------"<<endl;
 	tInputFile InputFile( SimCtrl.infile );
+
+	// Shared-memory threads, NUMTHREADS keyword (default 1)
+	tThreadPool::initialize( InputFile );
 	
 	// Preprocessing meteorological data
 	tPreProcess PreProcessor( &SimCtrl, InputFile );
@@ -87,7 +91,7 @@ int serialSimulation( int argc, char **argv )
 
 	Cout<<"\n\nPart 4: Creating Resampling Object"<<endl;
 	Cout<<"--------------------------------------"<<endl;
-	tResample RsmplMaster( &SimCtrl, &BasinMesh ); 
+	tResample RsmplMaster( &SimCtrl, &BasinMesh, InputFile ); 
 
 	Cout<<"\n\nPart 4a: Creating Sheltering Object for DEM Input" << endl;
 	Cout<<"----------------------------------------------------"<<endl;
@@ -137,13 +141,19 @@ int serialSimulation( int argc, char **argv )
 		Simulant.readRestart(InputFile);
 	}
 
+	// Runs of the ensemble members instead of a single run, see ENSEMBLEFILE
+	Simulant.initialize_ensemble(InputFile);
+
 	Cout<<"\n\nPart 8: Hydrologic Simulation Loop"<<endl;
 	Cout<<"--------------------------------------"<<endl;
-	Simulant.simulation_loop( &Moisture, &Flow, &EvapoTrans, 
-							  &Intercept, &Balance, &SnowPack, // SKY2008Snow from AJR2007
-							  InputFile); // SKY2008Snow
-	Simulant.end_simulation( &Flow );
-	
+	if (!Simulant.RunEnsemble(InputFile, &Moisture, &Flow, &EvapoTrans,
+							  &Intercept, &Balance, &PreProcessor, &SnowPack)) {
+		Simulant.simulation_loop( &Moisture, &Flow, &EvapoTrans, 
+								  &Intercept, &Balance, &SnowPack, // SKY2008Snow from AJR2007
+								  InputFile); // SKY2008Snow
+		Simulant.end_simulation( &Flow );
+	}
+
 	while ( Simulant.check_mod_status() )
 		Simulant.RunItAgain(InputFile, &Moisture, &Flow, &EvapoTrans,
 							&Intercept, &Balance, &PreProcessor, &SnowPack); // SKY2008Snow from AJR2007
@@ -151,6 +161,7 @@ int serialSimulation( int argc, char **argv )
 
 	Cout<<"\n\nPart 9: Deleting Objects and Exiting Program"<<endl;
 	Cout<<"------------------------------------------------"<<endl<<endl;
+	tThreadPool::finalize();
 	return 0; // 04/07/2020 Added this to eliminate warning Clizarraga 
 }
 
@@ -173,6 +184,9 @@ int parallelSimulation(int argc, char **argv)
 	Cout<<"\n\nPart 1: Read Input Parameters from "<<"'"<<argv[1]<<"'"<<endl;
 	Cout<<"---------------------------------------------------"<<endl;
 	tInputFile InputFile( SimCtrl.infile );
+
+	// Shared-memory threads, NUMTHREADS keyword (default 1)
+	tThreadPool::initialize( InputFile );
         
 	// Preprocessing meteorological data
 	tPreProcess PreProcessor( &SimCtrl, InputFile );
@@ -209,7 +223,7 @@ int parallelSimulation(int argc, char **argv)
 
 		cout<<"\n\nPart 4: Creating Resampling Object"<<endl;
 		Cout<<"--------------------------------------"<<endl;
-		tResample RsmplMaster( &SimCtrl, &BasinMesh );  
+		tResample RsmplMaster( &SimCtrl, &BasinMesh, InputFile );  
 
 		cout<<"\n\nPart 4a: Creating Sheltering Object for DEM Input" << endl;
 		Cout<<"----------------------------------------------------"<<endl;
@@ -288,7 +302,7 @@ int parallelSimulation(int argc, char **argv)
 
 		Cout<<"\n\nPart 4: Creating Resampling Object"<<endl;
 		Cout<<"--------------------------------------"<<endl;
-		tResample RsmplMaster( &SimCtrl, &BasinMesh );  
+		tResample RsmplMaster( &SimCtrl, &BasinMesh, InputFile );  
 
 		Cout<<"\n\nPart 4a: Creating Sheltering Object for DEM Input" << endl;
 		Cout<<"----------------------------------------------------"<<endl;
@@ -357,6 +371,9 @@ int parallelSimulation(int argc, char **argv)
   // Finalize graph partitioning
   tGraph::finalize();
 
+  // Stop shared-memory threads
+  tThreadPool::finalize();
+
   // Finalize parallel communications
   tParallel::finalize();
 
@@ -70,8 +70,7 @@ tCNode::tCNode() :tNode()
 	QgwIn = QgwOut = 0.0;
 	Hlevel = Qstrm = Width = Roughness = RunOn = 0.0;
 	StreamPtr = 0;
-	TimeInd = 0;
-	Qeff = 0;
+	Travel = 0;
 	FlowVelocity = 0.0;
 	tracer = flood = soiID = LandUse = satOccur = 0;
    Reach = -1;
@@ -205,8 +204,7 @@ tCNode::tCNode(tInputFile &infile) :tNode() {
 	QgwIn = QgwOut = 0.0;
 	Hlevel = Qstrm = Width = Roughness = RunOn = 0.0;
 	StreamPtr = 0;
-	TimeInd = 0;
-	Qeff = 0;
+	Travel = 0;
 	FlowVelocity = 0.0;
 	tracer = flood = soiID = LandUse = satOccur = 0;
    Reach = -1;
@@ -308,7 +306,7 @@ tCNode::~tCNode() {//}
 	
 	// GMnSKY2008MLE to fix memory leaks
 	deleteVertArrays(); 
-	//deleteDataStack(); //WR not necessary as TimeInd and Qeff are now smart pointers
+	//deleteDataStack(); //WR not necessary as the travel queue is now a smart pointer
 }
 
 //=========================================================================
@@ -321,34 +319,34 @@ tCNode::~tCNode() {//}
 
 // Get Functions 
 
-double tCNode::getNwtOld() { return NwtOld; }
-double tCNode::getNwtNew() { return NwtNew; }
-double tCNode::getMuOld()  { return MuOld; }
-double tCNode::getMuNew()  { return MuNew; }
-double tCNode::getMiOld()  { return MiOld; }
-double tCNode::getMiNew()  { return MiNew; }
-double tCNode::getNtOld()  { return NtOld; }
-double tCNode::getNtNew()  { return NtNew; }
-double tCNode::getNfOld()  { return NfOld; }
-double tCNode::getNfNew()  { return NfNew; }
-double tCNode::getRuOld()  { return RuOld; }
-double tCNode::getRuNew()  { return RuNew; }
-double tCNode::getRiOld()  { return RiOld; }
-double tCNode::getRiNew()  { return RiNew; }
+double tCNode::getNwtOld() { return field(kStNwtOld, NwtOld); }
+double tCNode::getNwtNew() { return field(kStNwtNew, NwtNew); }
+double tCNode::getMuOld()  { return field(kStMuOld, MuOld); }
+double tCNode::getMuNew()  { return field(kStMuNew, MuNew); }
+double tCNode::getMiOld()  { return field(kStMiOld, MiOld); }
+double tCNode::getMiNew()  { return field(kStMiNew, MiNew); }
+double tCNode::getNtOld()  { return field(kStNtOld, NtOld); }
+double tCNode::getNtNew()  { return field(kStNtNew, NtNew); }
+double tCNode::getNfOld()  { return field(kStNfOld, NfOld); }
+double tCNode::getNfNew()  { return field(kStNfNew, NfNew); }
+double tCNode::getRuOld()  { return field(kStRuOld, RuOld); }
+double tCNode::getRuNew()  { return field(kStRuNew, RuNew); }
+double tCNode::getRiOld()  { return field(kStRiOld, RiOld); }
+double tCNode::getRiNew()  { return field(kStRiNew, RiNew); }
 double tCNode::getQin()    { return Qin;  }
-double tCNode::getQpin()   { return Qpin; }
+double tCNode::getQpin()   { return field(kStQpin, Qpin); }
 double tCNode::getQout()   { return Qout; }
-double tCNode::getQpout()  { return Qpout; }
+double tCNode::getQpout()  { return field(kStQpout, Qpout); }
 double tCNode::getRain()   { return Rain;  }
 double tCNode::getSrf_Hr() { return srf_hr;  }
-double tCNode::getSrf()    { return srf;  }
+double tCNode::getSrf()    { return field(kStSrf, srf);  }
 double tCNode::getCumSrf() { return cumsrf;  } // added CJC2021
-double tCNode::getHsrf()   { return hsrf; }
-double tCNode::getPsrf()   { return psrf; }
-double tCNode::getSatsrf() { return satsrf; }
-double tCNode::getSbsrf()  { return sbsrf;  }
+double tCNode::getHsrf()   { return field(kStHsrf, hsrf); }
+double tCNode::getPsrf()   { return field(kStPsrf, psrf); }
+double tCNode::getSatsrf() { return field(kStSatsrf, satsrf); }
+double tCNode::getSbsrf()  { return field(kStSbsrf, sbsrf);  }
 double tCNode::getRsrf()   { return rsrf; }
-double tCNode::getEsrf()   { return esrf; }
+double tCNode::getEsrf()   { return field(kStEsrf, esrf); }
 double tCNode::getRunOn()  { return RunOn; }
 double tCNode::getTTime()  { return traveltime; }
 double tCNode::getHillPath()   { return hillpath; }
@@ -373,20 +371,20 @@ list<double>& tCNode::getGwaterChngList() { return gwc; }
 double tCNode::getIntStormVar()   { return intstorm; }
 double tCNode::getInterceptLoss() { return Interception; }
 double tCNode::getCanStorage()    { return CanStorage; }
-double tCNode::getPotEvap()       { return PotEvaporation; }
+double tCNode::getPotEvap()       { return field(kStPotEvap, PotEvaporation); }
 double tCNode::getActEvap()       { return ActEvaporation; }
 double tCNode::getNetPrecipitation() { return NetPrecipitation; }
 double tCNode::getStormLength()   { return StormLength; }
 double tCNode::getCumIntercept()  { return CumIntercept; }
-double tCNode::getEvapoTrans()    { return EvapoTranspiration; }
+double tCNode::getEvapoTrans()    { return field(kStEvapoTrans, EvapoTranspiration); }
 double tCNode::getEvapWetCanopy() { return EvapWetCanopy; }
 double tCNode::getEvapDryCanopy() { return EvapDryCanopy; }
 double tCNode::getEvapSoil()      { return EvapSoil; }
-double tCNode::getSoilMoisture()     { return SoilMoisture; }
+double tCNode::getSoilMoisture()     { return field(kStSoilMoist, SoilMoisture); }
 double tCNode::getSoilMoistureSC()   { return SoilMoistureSC; }
 double tCNode::getSoilMoistureUNSC() { return SoilMoistureUNSC; }
 int    tCNode::getReach()            { return Reach; }
-double tCNode::getRootMoisture()     { return RootMoisture; }
+double tCNode::getRootMoisture()     { return field(kStRootMoist, RootMoisture); }
 double tCNode::getRootMoistureSC()   { return RootMoistureSC; }
 double tCNode::getTransmiss()  { return Transmissivity; }
 double tCNode::getAirPressure(){ return AirPressure; }
@@ -522,8 +520,7 @@ int    tCNode::getLandUse()      { return LandUse; }
 tEdge * tCNode::getFlowEdg()     { return flowedge; }
 tCNode * tCNode::getStreamNode() { return StreamPtr; }
 
-tList< int >    * tCNode::getTimeIndList() { return TimeInd.get(); }
-tList< double > * tCNode::getQeffList()    { return Qeff.get(); }
+tTravelQueue * tCNode::getTravelQueue() { return Travel.get(); }
 
 // SKY2008Snow from AJR2007
 // snowpack -- RINEHART 2007 @ NMT
@@ -614,30 +611,30 @@ double tCNode::getRootCutoff() {return root_cutoff;}
 
 // Set Functions
 
-void tCNode::setMuOld(double value)  { MuOld = value; }
-void tCNode::setMuNew(double value)  { MuNew = value; }
-void tCNode::setRiOld(double value)  { RiOld = value; }
-void tCNode::setRiNew(double value)  { RiNew = value; }
-void tCNode::setRuOld(double value)  { RuOld = value; }
-void tCNode::setRuNew(double value)  { RuNew = value; }
-void tCNode::setNfOld(double value)  { NfOld = value; }
-void tCNode::setNfNew(double value)  { NfNew = value; }
-void tCNode::setNtOld(double value)  { NtOld = value; }
-void tCNode::setNtNew(double value)  { NtNew = value; }
-void tCNode::setNwtOld(double value) { NwtOld = value; }
-void tCNode::setNwtNew(double value) { NwtNew = value; }
-void tCNode::setMiOld(double value)  { MiOld = value; }
-void tCNode::setMiNew(double value)  { MiNew = value; }
-void tCNode::setQpout(double value)  { Qpout = value; }
-void tCNode::setQpin(double value)   { Qpin = value; }
+void tCNode::setMuOld(double value)  { field(kStMuOld, MuOld) = value; }
+void tCNode::setMuNew(double value)  { field(kStMuNew, MuNew) = value; }
+void tCNode::setRiOld(double value)  { field(kStRiOld, RiOld) = value; }
+void tCNode::setRiNew(double value)  { field(kStRiNew, RiNew) = value; }
+void tCNode::setRuOld(double value)  { field(kStRuOld, RuOld) = value; }
+void tCNode::setRuNew(double value)  { field(kStRuNew, RuNew) = value; }
+void tCNode::setNfOld(double value)  { field(kStNfOld, NfOld) = value; }
+void tCNode::setNfNew(double value)  { field(kStNfNew, NfNew) = value; }
+void tCNode::setNtOld(double value)  { field(kStNtOld, NtOld) = value; }
+void tCNode::setNtNew(double value)  { field(kStNtNew, NtNew) = value; }
+void tCNode::setNwtOld(double value) { field(kStNwtOld, NwtOld) = value; }
+void tCNode::setNwtNew(double value) { field(kStNwtNew, NwtNew) = value; }
+void tCNode::setMiOld(double value)  { field(kStMiOld, MiOld) = value; }
+void tCNode::setMiNew(double value)  { field(kStMiNew, MiNew) = value; }
+void tCNode::setQpout(double value)  { field(kStQpout, Qpout) = value; }
+void tCNode::setQpin(double value)   { field(kStQpin, Qpin) = value; }
 void tCNode::setRain(double value)   { Rain = value; }
 void tCNode::setSrf_Hr(double value) { srf_hr = value; }
-void tCNode::setsrf(double value)    { srf = value; }
-void tCNode::sethsrf(double value)   { hsrf = value; }
-void tCNode::setesrf(double value)   { esrf = value; }
-void tCNode::setpsrf(double value)   { psrf = value; }
-void tCNode::setsatsrf(double value) { satsrf = value; }
-void tCNode::setsbsrf(double value)  { sbsrf = value; }
+void tCNode::setsrf(double value)    { field(kStSrf, srf) = value; }
+void tCNode::sethsrf(double value)   { field(kStHsrf, hsrf) = value; }
+void tCNode::setesrf(double value)   { field(kStEsrf, esrf) = value; }
+void tCNode::setpsrf(double value)   { field(kStPsrf, psrf) = value; }
+void tCNode::setsatsrf(double value) { field(kStSatsrf, satsrf) = value; }
+void tCNode::setsbsrf(double value)  { field(kStSbsrf, sbsrf) = value; }
 void tCNode::setRunOn(double value)  { RunOn = value; }
 void tCNode::setFlowEdg(tEdge * edgs) { flowedge = edgs; }
 void tCNode::setGwaterChng(double value)  { 
@@ -657,7 +654,7 @@ void tCNode::setInterceptLoss(double interception) {
 void tCNode::setNetPrecipitation(double netprecip) {  
 	NetPrecipitation = netprecip; }
 void tCNode::setCanStorage(double canstore) { CanStorage = canstore; }
-void tCNode::setPotEvap(double potEvap) { PotEvaporation = potEvap; }
+void tCNode::setPotEvap(double potEvap) { field(kStPotEvap, PotEvaporation) = potEvap; }
 void tCNode::setActEvap(double actEvap) { ActEvaporation = actEvap; }
 void tCNode::setTransmiss(double Tr)    { Transmissivity = Tr; }
 void tCNode::setStormLength(int option, double time){
@@ -668,20 +665,20 @@ void tCNode::setStormLength(int option, double time){
 }
 void tCNode::setCumIntercept(double cum) {CumIntercept = cum;}
 void tCNode::setEvapoTrans(double evapoTrans) {
-	EvapoTranspiration = evapoTrans;}
+	field(kStEvapoTrans, EvapoTranspiration) = evapoTrans;}
 void tCNode::setEvapWetCanopy(double evapWetCanopy) {
 	EvapWetCanopy = evapWetCanopy;}
 void tCNode::setEvapDryCanopy(double evapDryCanopy) {
 	EvapDryCanopy = evapDryCanopy;}
 void tCNode::setEvapSoil(double evapSoil) {EvapSoil = evapSoil;}
 void tCNode::setSoilMoisture(double soilMoisture) {
-	SoilMoisture = soilMoisture;}
+	field(kStSoilMoist, SoilMoisture) = soilMoisture;}
 void tCNode::setSoilMoistureSC(double soilMoisture) {
 	SoilMoistureSC = soilMoisture;}
 void tCNode::setSoilMoistureUNSC(double soilMoisture) {
 	SoilMoistureUNSC = soilMoisture;}
 void tCNode::setRootMoisture(double rootMoisture) {
-	RootMoisture = rootMoisture;}
+	field(kStRootMoist, RootMoisture) = rootMoisture;}
 void tCNode::setRootMoistureSC(double rootMoisture) {
 	RootMoistureSC = rootMoisture;}
 void tCNode::setAirPressure(double airpress){ AirPressure = airpress;}
@@ -891,7 +888,7 @@ void tCNode::addGwaterChng(double value) {
     // sorting and summing. SMM - 09232008
     gwc.push_back(value);
 }
-void tCNode::addQpin(double value)  { Qpin += value; }
+void tCNode::addQpin(double value)  { field(kStQpin, Qpin) += value; }
 void tCNode::addTTime(double value) { traveltime += value; } 
 void tCNode::addIntStormVar(double value) { intstorm += value; }
 void tCNode::addContrArea(double value)   { ContrArea += value; }
@@ -1011,34 +1008,18 @@ void tCNode::allocVertArrays(int n)
 	return;
 }
 
-void tCNode::allocDataStack()
+void tCNode::allocDataStack(int capacity)
 {
     //WR debug convert to smart pointers
-	//TimeInd = new tList< int >;
-	//Qeff = new tList< double >;
-    TimeInd = std::make_shared<tList<int> >();
-    Qeff = std::make_shared<tList<double> >();
+    Travel = std::make_shared<tTravelQueue>(capacity);
 
-	assert(TimeInd != 0);
-	assert(Qeff != 0);
+	assert(Travel != 0);
 	return; 
 }
 
 void tCNode::deleteDataStack()
 {
-/*SMM - 08132008, this code is currently causing an error
-	if (TimeInd != 0) {
-		if (!(TimeInd->isEmpty())) 
-			TimeInd->Flush();
-		delete TimeInd;
-	}
-	if (Qeff != 0) {
-		if (!(Qeff->isEmpty())) 
-			Qeff->Flush();
-		delete Qeff;
-	}
-	return;
-*/
+	Travel.reset();
 }
 
 //=========================================================================
@@ -1248,31 +1229,31 @@ void tCNode::writeRestart(fstream& rStr) const
   BinaryWrite(rStr, satsrfOccur);
   BinaryWrite(rStr, sbsrfOccur);
   BinaryWrite(rStr, RechDisch);
-  BinaryWrite(rStr, NwtOld);
-  BinaryWrite(rStr, MuOld);
-  BinaryWrite(rStr, MiOld);
-  BinaryWrite(rStr, NtOld);
-  BinaryWrite(rStr, NfOld);
-  BinaryWrite(rStr, RuOld);
-  BinaryWrite(rStr, RiOld);
-  BinaryWrite(rStr, Qpout);
+  BinaryWrite(rStr, field(kStNwtOld, NwtOld));
+  BinaryWrite(rStr, field(kStMuOld, MuOld));
+  BinaryWrite(rStr, field(kStMiOld, MiOld));
+  BinaryWrite(rStr, field(kStNtOld, NtOld));
+  BinaryWrite(rStr, field(kStNfOld, NfOld));
+  BinaryWrite(rStr, field(kStRuOld, RuOld));
+  BinaryWrite(rStr, field(kStRiOld, RiOld));
+  BinaryWrite(rStr, field(kStQpout, Qpout));
   BinaryWrite(rStr, Rain);
   BinaryWrite(rStr, intstorm);
   BinaryWrite(rStr, Interception);
   BinaryWrite(rStr, NetPrecipitation);
   BinaryWrite(rStr, CanStorage);
-  BinaryWrite(rStr, PotEvaporation);
+  BinaryWrite(rStr, field(kStPotEvap, PotEvaporation));
   BinaryWrite(rStr, ActEvaporation);
   BinaryWrite(rStr, StormLength);
   BinaryWrite(rStr, CumIntercept);
   BinaryWrite(rStr, EvapWetCanopy);
   BinaryWrite(rStr, EvapDryCanopy);
   BinaryWrite(rStr, EvapSoil);
-  BinaryWrite(rStr, EvapoTranspiration);
-  BinaryWrite(rStr, SoilMoisture);
+  BinaryWrite(rStr, field(kStEvapoTrans, EvapoTranspiration));
+  BinaryWrite(rStr, field(kStSoilMoist, SoilMoisture));
   BinaryWrite(rStr, SoilMoistureSC);
   BinaryWrite(rStr, SoilMoistureUNSC);
-  BinaryWrite(rStr, RootMoisture);
+  BinaryWrite(rStr, field(kStRootMoist, RootMoisture));
   BinaryWrite(rStr, RootMoistureSC);
   BinaryWrite(rStr, Transmissivity);
   BinaryWrite(rStr, AirTemp);
@@ -1447,33 +1428,11 @@ void tCNode::writeRestart(fstream& rStr) const
   BinaryWrite(rStr, SoilHeatCap);
 
   int size;
-  if (TimeInd != 0) {
-    size = TimeInd->getSize();
-    BinaryWrite(rStr, size);
-    tListIter< int > IndIter;
-    IndIter.Reset(*TimeInd);
-    IndIter.First();
-    while ( !(IndIter.AtEnd())) {
-      BinaryWrite(rStr, IndIter.DatRef());
-      IndIter.Next();
-    }
-  } else {
+  if (Travel != 0)
+    Travel->writeRestart(rStr);
+  else {
     size = 0;
     BinaryWrite(rStr, size);
-  }
-
-  if (Qeff != 0) {
-    size = Qeff->getSize();
-    BinaryWrite(rStr, size);
-    tListIter< double > QIter;
-    QIter.Reset(*Qeff);
-    QIter.First();
-    while ( !(QIter.AtEnd())) {
-      BinaryWrite(rStr, QIter.DatRef());
-      QIter.Next();
-    }
-  } else {
-    size = 0;
     BinaryWrite(rStr, size);
   }
 }
@@ -1726,19 +1685,16 @@ void tCNode::readRestart(fstream& rStr)
   BinaryRead(rStr, SoilHeatCap);
 
   int size;
-  int timeInd;
-  BinaryRead(rStr, size);
-  for (int i = 0; i < size; i++) {
-    BinaryRead(rStr, timeInd);
-    TimeInd->insertAtBack(timeInd);
+  if (Travel != 0)
+    Travel->readRestart(rStr);
+  else {
+    BinaryRead(rStr, size);
+    BinaryRead(rStr, size);
   }
 
-  BinaryRead(rStr, size);
-  double qeff;
-  for (int i = 0; i < size; i++) {
-    BinaryRead(rStr, qeff);
-    Qeff->insertAtBack(qeff);
-  }
+  // Values read for stored variables go to the state store
+  if (state)
+    attachState(state, stateID);
 }
 
 /***************************************************************************
@@ -1762,16 +1718,16 @@ void tCNode::printVariables()
   cout << " satsrfOccur " << satsrfOccur << endl;
   cout << " sbsrfOccur " << sbsrfOccur << endl;
   cout << " RechDisch " << RechDisch << endl;
-  cout << " NwtOld " << NwtOld << endl;
-  cout << " MuOld " << MuOld << endl;
-  cout << " MiOld " << MiOld << endl;
-  cout << " NtOld " << NtOld << endl;
-  cout << " NfOld " << NfOld << endl;
-  cout << " RuOld " << RuOld << endl;
-  cout << " RiOld " << RiOld << endl;
+  cout << " NwtOld " << field(kStNwtOld, NwtOld) << endl;
+  cout << " MuOld " << field(kStMuOld, MuOld) << endl;
+  cout << " MiOld " << field(kStMiOld, MiOld) << endl;
+  cout << " NtOld " << field(kStNtOld, NtOld) << endl;
+  cout << " NfOld " << field(kStNfOld, NfOld) << endl;
+  cout << " RuOld " << field(kStRuOld, RuOld) << endl;
+  cout << " RiOld " << field(kStRiOld, RiOld) << endl;
   cout << " Qin " << Qin << endl;
   cout << " Qout " << Qout << endl;
-  cout << " Qpout " << Qpout << endl;
+  cout << " Qpout " << field(kStQpout, Qpout) << endl;
   cout << " Rain " << Rain << endl;
   cout << " intstorm " << intstorm << endl;
   cout << " traveltime " << traveltime << endl;
@@ -1780,18 +1736,18 @@ void tCNode::printVariables()
   cout << " Interception " << Interception << endl;
   cout << " NetPrecipitation " << NetPrecipitation << endl;
   cout << " CanStorage " << CanStorage << endl;
-  cout << " PotEvaporation " << PotEvaporation << endl;
+  cout << " PotEvaporation " << field(kStPotEvap, PotEvaporation) << endl;
   cout << " ActEvaporation " << ActEvaporation << endl;
   cout << " StormLength " << StormLength << endl;
   cout << " CumIntercept " << CumIntercept << endl;
   cout << " EvapWetCanopy " << EvapWetCanopy << endl;
   cout << " EvapDryCanopy " << EvapDryCanopy << endl;
   cout << " EvapSoil " << EvapSoil << endl;
-  cout << " EvapoTranspiration " << EvapoTranspiration << endl;
-  cout << " SoilMoisture " << SoilMoisture << endl;
+  cout << " EvapoTranspiration " << field(kStEvapoTrans, EvapoTranspiration) << endl;
+  cout << " SoilMoisture " << field(kStSoilMoist, SoilMoisture) << endl;
   cout << " SoilMoistureSC " << SoilMoistureSC << endl;
   cout << " SoilMoistureUNSC " << SoilMoistureUNSC << endl;
-  cout << " RootMoisture " << RootMoisture << endl;
+  cout << " RootMoisture " << field(kStRootMoist, RootMoisture) << endl;
   cout << " RootMoistureSC " << RootMoistureSC << endl;
   cout << " Transmissivity " << Transmissivity << endl;
   cout << " AirTemp " << AirTemp << endl;
@@ -1975,6 +1931,64 @@ void tCNode::printVariables()
   cout << " SoilHeatCap " << SoilHeatCap;
 }
 
+/*************************************************************************
+**
+**  tCNode::attachState(tCNodeState *store, int id)
+**  tCNode::detachState()
+**
+**  Moves the values of the variables kept in the state store into row
+**  'id' of 'store', after which they are accessed there; detachState()
+**  copies them back into the node. Called by tCNodeState.
+**
+*************************************************************************/
+void tCNode::attachState(tCNodeState *store, int id)
+{
+	state = store;
+	stateID = id;
+	state->value(kStNwtOld, id) = NwtOld;   state->value(kStNwtNew, id) = NwtNew;
+	state->value(kStMuOld, id) = MuOld;     state->value(kStMuNew, id) = MuNew;
+	state->value(kStMiOld, id) = MiOld;     state->value(kStMiNew, id) = MiNew;
+	state->value(kStNtOld, id) = NtOld;     state->value(kStNtNew, id) = NtNew;
+	state->value(kStNfOld, id) = NfOld;     state->value(kStNfNew, id) = NfNew;
+	state->value(kStRuOld, id) = RuOld;     state->value(kStRuNew, id) = RuNew;
+	state->value(kStRiOld, id) = RiOld;     state->value(kStRiNew, id) = RiNew;
+	state->value(kStQpin, id) = Qpin;       state->value(kStQpout, id) = Qpout;
+	state->value(kStSrf, id) = srf;         state->value(kStHsrf, id) = hsrf;
+	state->value(kStEsrf, id) = esrf;       state->value(kStPsrf, id) = psrf;
+	state->value(kStSatsrf, id) = satsrf;   state->value(kStSbsrf, id) = sbsrf;
+	state->value(kStPotEvap, id) = PotEvaporation;
+	state->value(kStEvapoTrans, id) = EvapoTranspiration;
+	state->value(kStSoilMoist, id) = SoilMoisture;
+	state->value(kStRootMoist, id) = RootMoisture;
+}
+
+void tCNode::detachState()
+{
+	if (!state)
+		return;
+	int id = stateID;
+	NwtOld = state->value(kStNwtOld, id);   NwtNew = state->value(kStNwtNew, id);
+	MuOld = state->value(kStMuOld, id);     MuNew = state->value(kStMuNew, id);
+	MiOld = state->value(kStMiOld, id);     MiNew = state->value(kStMiNew, id);
+	NtOld = state->value(kStNtOld, id);     NtNew = state->value(kStNtNew, id);
+	NfOld = state->value(kStNfOld, id);     NfNew = state->value(kStNfNew, id);
+	RuOld = state->value(kStRuOld, id);     RuNew = state->value(kStRuNew, id);
+	RiOld = state->value(kStRiOld, id);     RiNew = state->value(kStRiNew, id);
+	Qpin = state->value(kStQpin, id);       Qpout = state->value(kStQpout, id);
+	srf = state->value(kStSrf, id);         hsrf = state->value(kStHsrf, id);
+	esrf = state->value(kStEsrf, id);       psrf = state->value(kStPsrf, id);
+	satsrf = state->value(kStSatsrf, id);   sbsrf = state->value(kStSbsrf, id);
+	PotEvaporation = state->value(kStPotEvap, id);
+	EvapoTranspiration = state->value(kStEvapoTrans, id);
+	SoilMoisture = state->value(kStSoilMoist, id);
+	RootMoisture = state->value(kStRootMoist, id);
+	state = NULL;
+	stateID = -1;
+}
+
+int tCNode::getStateID() { return stateID; }
+tCNodeState *tCNode::getState() { return state; }
+
 
 //=========================================================================
 //
@@ -31,6 +31,8 @@
 #include "src/tMeshElements/meshElements.h"
 #include "src/tInOut/tInputFile.h"
 #include "src/Headers/globalFns.h"
+#include "src/tCNode/tCNodeState.h"
+#include "src/tCNode/tTravelQueue.h"
 #include <memory> // WR - added 09192023 :)
 #include <list> //SMM - added 09232008
 
@@ -646,9 +648,8 @@ public:
   tCNode * getDownstrmNbr();
   tCNode * getStreamNode();
 
-  tList< int >    * getTimeIndList();
-  tList< double > * getQeffList();
-  void   allocDataStack();
+  tTravelQueue * getTravelQueue();
+  void   allocDataStack(int capacity = 0);
   void   deleteDataStack();
 
   int    nVerts;                         //tResample Members
@@ -662,6 +663,12 @@ public:
   void   readRestart(fstream&);
   void   printVariables();
 
+  // Optional store of the dynamic variables (see tCNodeState)
+  void   attachState(tCNodeState *, int);
+  void   detachState();
+  int    getStateID();
+  tCNodeState *getState();
+
   int    satOccur;              // Surface saturation occurence 
   double hsrfOccur;             // Infiltration excess runoff Occurence
   double psrfOccur; 		// Perched Saturation Runoff Occurence 
@@ -907,8 +914,7 @@ protected:
   int LandUse;  
   int Reach;
 
-  std::shared_ptr<tList<double> > Qeff; //WR debug convert to smart shared pointer to prevent memory leak
-  std::shared_ptr<tList<int> > TimeInd;
+  std::shared_ptr<tTravelQueue> Travel; // Lateral influx of stream nodes
 
   double xC;
   double yC;
@@ -918,6 +924,15 @@ protected:
   double soil_cutoff;
   double root_cutoff;
 
+  // State store: the variables listed in tCNodeState.h are read and
+  // written through field(), i.e. in the store once the node is attached
+  tCNodeState *state{};
+  int stateID{-1};
+  double &field(int f, double &member) {
+    return (state ? state->value(f, stateID) : member); }
+  double field(int f, const double &member) const {
+    return (state ? state->value(f, stateID) : member); }
+
 
 };
 
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tCNodeState.cpp: Functions for class tCNodeState (see tCNodeState.h)
+**
+***************************************************************************/
+
+#include "src/tCNode/tCNodeState.h"
+#include "src/tCNode/tCNode.h"
+#include <algorithm>
+#include <cstring>
+
+//=========================================================================
+//
+//
+//                  Section 1: tCNodeState Constructors/Destructors
+//
+//
+//=========================================================================
+
+tCNodeState::tCNodeState() {}
+
+tCNodeState::~tCNodeState()
+{
+	detach();
+}
+
+//=========================================================================
+//
+//
+//                  Section 2: tCNodeState Functions
+//
+//
+//=========================================================================
+
+/*************************************************************************
+**
+**  tCNodeState::attach(const std::vector<tCNode*> &)
+**
+**  Sizes the arrays for the nodes given (in the order of the store) and
+**  moves their current values into the store. Nodes attached before are
+**  detached first.
+**
+*************************************************************************/
+void tCNodeState::attach(const std::vector<tCNode*> &nodeVec)
+{
+	detach();
+	nodes = nodeVec;
+	for (int f=0; f < kNumStateFields; f++)
+		fields[f].assign(nodes.size(), 0.0);
+	for (size_t i=0; i < nodes.size(); i++)
+		nodes[i]->attachState(this, (int)i);
+}
+
+/*************************************************************************
+**
+**  tCNodeState::detach()
+**
+**  Copies the stored values back to the node objects
+**
+*************************************************************************/
+void tCNodeState::detach()
+{
+	for (size_t i=0; i < nodes.size(); i++)
+		nodes[i]->detachState();
+	nodes.clear();
+	for (int f=0; f < kNumStateFields; f++)
+		fields[f].clear();
+}
+
+int tCNodeState::size() const { return (int)nodes.size(); }
+
+/*************************************************************************
+**
+**  tCNodeState::isStoreOrder(const std::vector<tCNode*> &)
+**
+**  1 if the nodes given are those of the store, in its order, so that
+**  a loop over them can read the arrays of the store directly.
+**
+*************************************************************************/
+int tCNodeState::isStoreOrder(const std::vector<tCNode*> &nodeVec) const
+{
+	return nodeVec == nodes;
+}
+
+/*************************************************************************
+**
+**  tCNodeState::copyField(int dest, int src)
+**  tCNodeState::fillField(int f, double v)
+**
+**  Whole-array updates, e.g. setting the 'Old' state to the 'New' one
+**  for all nodes at the end of a time step.
+**
+*************************************************************************/
+void tCNodeState::copyField(int dest, int src)
+{
+	if (!nodes.empty())
+		memcpy(fields[dest].data(), fields[src].data(), nodes.size()*sizeof(double));
+}
+
+void tCNodeState::fillField(int f, double v)
+{
+	std::fill(fields[f].begin(), fields[f].end(), v);
+}
+
+//=========================================================================
+//
+//
+//                          End of tCNodeState.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tCNodeState.h: Header for tCNodeState class
+**
+**  tCNodeState is an optional store for the most frequently updated
+**  dynamic variables of the active tCNodes (moisture state, runoff
+**  components and a few ET and soil moisture fluxes). Each variable is
+**  kept in a contiguous array indexed by the position of the node in
+**  the active node list. Once a node is attached, its get/set functions
+**  for these variables read and write the store instead of the node
+**  object, so loops over all nodes can also work on whole arrays: the
+**  per-step resets of tHydroModel (Reset, ResetGW) and the visualization
+**  columns of tSnapshot do. The other loops, e.g. those of tEvapoTrans
+**  that compute the variables node by node, use the node functions.
+**
+**  The store is enabled with the optional keyword OPTNODESTATE (0: off
+**  (default), 1: on), see tHydroModel.
+**
+***************************************************************************/
+
+#ifndef TCNODESTATE_H
+#define TCNODESTATE_H
+
+//=========================================================================
+//
+//
+//                  Section 1: tCNodeState Include and Define Statements
+//
+//
+//=========================================================================
+
+#include <vector>
+
+class tCNode;
+
+// Variables kept in the store
+enum {
+  kStNwtOld, kStNwtNew, kStMuOld, kStMuNew, kStMiOld, kStMiNew,
+  kStNtOld, kStNtNew, kStNfOld, kStNfNew, kStRuOld, kStRuNew,
+  kStRiOld, kStRiNew, kStQpin, kStQpout,
+  kStSrf, kStHsrf, kStEsrf, kStPsrf, kStSatsrf, kStSbsrf,
+  kStPotEvap, kStEvapoTrans, kStSoilMoist, kStRootMoist,
+  kNumStateFields
+};
+
+//=========================================================================
+//
+//
+//                  Section 2: tCNodeState Class Definitions
+//
+//
+//=========================================================================
+
+class tCNodeState
+{
+public:
+  tCNodeState();
+  ~tCNodeState();
+
+  void    attach(const std::vector<tCNode*> &); // Move values to the store
+  void    detach();                             // Move values back to nodes
+  int     size() const;
+  int     isStoreOrder(const std::vector<tCNode*> &) const;
+
+  double &value(int f, int id)       { return fields[f][id]; }
+  double  value(int f, int id) const { return fields[f][id]; }
+  double *getField(int f)            { return fields[f].data(); }
+  tCNode *getNode(int id)            { return nodes[id]; }
+
+  void    copyField(int dest, int src);    // dest = src for all nodes
+  void    fillField(int f, double v);      // f = v for all nodes
+
+private:
+  std::vector<double> fields[kNumStateFields];
+  std::vector<tCNode*> nodes;              // Attached nodes in store order
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tCNodeState.h
+//
+//
+//=========================================================================
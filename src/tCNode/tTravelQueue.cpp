@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tTravelQueue.cpp: Functions for class tTravelQueue (see tTravelQueue.h)
+**
+***************************************************************************/
+
+#include "src/tCNode/tTravelQueue.h"
+#include "src/Headers/globalFns.h"
+
+using namespace std;
+
+tTravelQueue::tTravelQueue(int capacity)
+  : base(0), head(0), span(0), nUsed(0)
+{
+  int n = 1;
+  while (n < capacity)
+    n *= 2;
+  bin.assign(n, 0.0);
+  used.assign(n, 0);
+}
+
+/***************************************************************************
+**
+**  tTravelQueue::deposit()
+**
+**  Adds q to the bin of 'step'. A step before the oldest bin moves the
+**  start of the buffer back to it.
+**
+***************************************************************************/
+void tTravelQueue::deposit(int step, double q)
+{
+  if (nUsed == 0) {
+    base = step;
+    span = 0;
+  }
+  else if (step < base) {
+    grow(span + base - step);
+    head = (head - (base - step)) & ((int)bin.size() - 1);
+    span += base - step;
+    base = step;
+  }
+
+  int off = step - base;
+  if (off >= (int)bin.size())
+    grow(off + 1);
+
+  int pos = (head + off) & ((int)bin.size() - 1);
+  if (used[pos])
+    bin[pos] += q;
+  else {
+    bin[pos] = q;
+    used[pos] = 1;
+    nUsed++;
+  }
+  if (off >= span)
+    span = off + 1;
+}
+
+double tTravelQueue::value(int step) const
+{
+  int off = step - base;
+  if (off < 0 || off >= span)
+    return 0.0;
+  return bin[(head + off) & ((int)bin.size() - 1)];
+}
+
+/***************************************************************************
+**
+**  tTravelQueue::release()
+**
+**  Removes the bins of the steps up to and including 'step', at the end
+**  of a Reff interval
+**
+***************************************************************************/
+void tTravelQueue::release(int step)
+{
+  int mask = (int)bin.size() - 1;
+  while (span > 0 && base <= step) {
+    if (used[head]) {
+      used[head] = 0;
+      nUsed--;
+    }
+    bin[head] = 0.0;
+    head = (head + 1) & mask;
+    base++;
+    span--;
+  }
+}
+
+void tTravelQueue::clear()
+{
+  bin.assign(bin.size(), 0.0);
+  used.assign(used.size(), 0);
+  base = head = span = nUsed = 0;
+}
+
+/***************************************************************************
+**
+**  tTravelQueue::grow()
+**
+**  Doubles the capacity until 'n' steps fit, moving the oldest bin to
+**  the start of the buffer
+**
+***************************************************************************/
+void tTravelQueue::grow(int n)
+{
+  int size = (int)bin.size();
+  int newSize = (size > 0) ? size : 1;
+  while (newSize < n)
+    newSize *= 2;
+  if (newSize == size)
+    return;
+
+  vector<double> newBin(newSize, 0.0);
+  vector<char> newUsed(newSize, 0);
+  for (int i = 0; i < span; i++) {
+    int pos = (head + i) & (size - 1);
+    newBin[i] = bin[pos];
+    newUsed[i] = used[pos];
+  }
+  bin.swap(newBin);
+  used.swap(newUsed);
+  head = 0;
+}
+
+/***************************************************************************
+**
+**  tTravelQueue::print()
+**
+**  Steps of the occupied bins on one line, their values on the next
+**
+***************************************************************************/
+void tTravelQueue::print(ostream &Otp) const
+{
+  int mask = (int)bin.size() - 1;
+  for (int i = 0; i < span; i++)
+    if (used[(head + i) & mask])
+      Otp << base + i << " ";
+  Otp << endl;
+  for (int i = 0; i < span; i++)
+    if (used[(head + i) & mask])
+      Otp << bin[(head + i) & mask] << " ";
+  Otp << endl;
+}
+
+/***************************************************************************
+**
+**  tTravelQueue::writeRestart() and readRestart()
+**
+**  Only the occupied bins are written, as the number of bins and their
+**  steps followed by the number of bins and their values (the layout of
+**  the former time index and Qeff lists)
+**
+***************************************************************************/
+void tTravelQueue::writeRestart(fstream &rStr) const
+{
+  int mask = (int)bin.size() - 1;
+  int step;
+
+  BinaryWrite(rStr, nUsed);
+  for (int i = 0; i < span; i++)
+    if (used[(head + i) & mask]) {
+      step = base + i;
+      BinaryWrite(rStr, step);
+    }
+  BinaryWrite(rStr, nUsed);
+  for (int i = 0; i < span; i++)
+    if (used[(head + i) & mask])
+      BinaryWrite(rStr, bin[(head + i) & mask]);
+}
+
+void tTravelQueue::readRestart(fstream &rStr)
+{
+  int size;
+  double q;
+  vector<int> steps;
+
+  clear();
+  BinaryRead(rStr, size);
+  steps.resize(size);
+  for (int i = 0; i < size; i++)
+    BinaryRead(rStr, steps[i]);
+  BinaryRead(rStr, size);
+  for (int i = 0; i < size; i++) {
+    BinaryRead(rStr, q);
+    deposit(steps[i], q);
+  }
+}
+
+//=========================================================================
+//
+//
+//                          End of tTravelQueue.cpp
+//
+//
+//=========================================================================
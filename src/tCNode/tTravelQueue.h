@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tTravelQueue.h: Header for tTravelQueue class
+**
+**  tTravelQueue holds the lateral influx that the hillslope routing of
+**  tKinemat sends to a stream node, by the index of the Reff interval
+**  (step of length dtReff) in which it arrives. The bins of the pending
+**  steps are kept in a circular buffer starting at the oldest pending
+**  step, so a deposit or a retrieval is a single array access. The
+**  capacity is a power of two, set from the maximum travel time of the
+**  basin, and doubles if a deposit falls beyond it.
+**
+***************************************************************************/
+
+#ifndef TTRAVELQUEUE_H
+#define TTRAVELQUEUE_H
+
+//=========================================================================
+//
+//
+//                  Section 1: tTravelQueue Include and Define Statements
+//
+//
+//=========================================================================
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+
+//=========================================================================
+//
+//
+//                  Section 2: tTravelQueue Class Definitions
+//
+//
+//=========================================================================
+
+class tTravelQueue
+{
+public:
+  tTravelQueue(int capacity = 0);
+
+  void   deposit(int step, double q);  // Adds q to the bin of step
+  double value(int step) const;        // Bin of step, 0 if none
+  void   release(int step);            // Removes the bins up to step
+  void   clear();
+
+  int    isEmpty() const     { return nUsed == 0; }
+  int    getSize() const     { return nUsed; }      // Occupied bins
+  int    getCapacity() const { return (int)bin.size(); }
+
+  void   print(std::ostream &) const;
+  void   writeRestart(std::fstream &) const;
+  void   readRestart(std::fstream &);
+
+private:
+  std::vector<double> bin;
+  std::vector<char> used;
+  int base;    // Step of the oldest bin
+  int head;    // Position of the oldest bin in the buffer
+  int span;    // Steps from base to the last occupied bin + 1
+  int nUsed;
+
+  void grow(int);
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tTravelQueue.h
+//
+//
+//=========================================================================
@@ -15,6 +15,7 @@
 ***************************************************************************/
 
 #include "src/tFlowNet/tFlowNet.h"
+#include "src/tFlowNet/tNetOrder.h"
 #include "src/Headers/TemplDefinitions.h"
 #include "src/Headers/globalIO.h"
 
@@ -33,6 +34,9 @@
 tFlowNet::tFlowNet() 
 {
 	gridPtr = 0;
+	timer = 0;
+	res = 0;
+	OutletNode = 0;
 }
 
 tFlowNet::tFlowNet(SimulationControl *simCtrPtr, tMesh<tCNode> *gridRef, 
@@ -44,6 +48,17 @@ tFlowNet::tFlowNet(SimulationControl *simCtrPtr, tMesh<tCNode> *gridRef,
 	BasArea = 0.0;
 	
 	SetFlowVariables( infile );
+
+	// Stream nodes settled by least path variable (1, default) or in the
+	// order they are reached (0), see WeightedShortestPath()
+	pathHeapOption = 1;
+	if (infile.IsItemIn( "OPTPATHHEAP" ))
+		pathHeapOption = infile.ReadItem(pathHeapOption, "OPTPATHHEAP");
+	if (pathHeapOption != 0 && pathHeapOption != 1) {
+		Cout<<"\ntFlowNet: Warning: OPTPATHHEAP = "<<pathHeapOption
+			<<" is not valid, using 1"<<endl;
+		pathHeapOption = 1;
+	}
     
 	// If the mesh was created by the MeshBuilder read FlowNet info from file
 	int option = infile.ReadItem(option, "OPTMESHINPUT");
@@ -87,6 +102,9 @@ tFlowNet::tFlowNet(SimulationControl *simCtrPtr, tMesh<tCNode> *gridRef,
 		Cout <<"\nRead MeshBuilder flownet information..."<<endl;
 		ReadFlowNetFromMeshBuilder();
 	}
+
+	// Node order and flow edges are final: refresh the active node index
+	gridPtr->BuildActiveIndex();
 	
 	Cout<<"\nHillslope velocity: \t\t"<<hillvel<<" m/sec"<<endl;
 	Cout<<"Stream velocity: \t\t"<<streamvel<<" m/sec"<<endl;
@@ -102,8 +120,10 @@ tFlowNet::~tFlowNet()
 {
 	gridPtr = NULL;
 	timer   = NULL;
-	delete res;
-	Cout<<"tFlowNet Object has been destroyed..."<<endl<<flush;
+	if (res != NULL) {
+		delete res;
+		Cout<<"tFlowNet Object has been destroyed..."<<endl<<flush;
+	}
 }
 
 /*****************************************************************************
@@ -401,79 +421,35 @@ void tFlowNet::FlowDirs()
 **  tFlowNet::SortNodesByNetOrder()
 **  
 **  This function sorts the list of nodes according to their order in the
-**  network (upstream to downstream). The sorting algorithm is based on the 
-**  "cascade" algorithm of Braun and Sambridge. 
-**     The single-direction sorting algorithm works by initially assigning a 
-**  tracer (like a packet of water) to each node. At each iteration, a tracer 
-**  from each node issent downstream. Any nodes that have zero tracers left 
-**  are moved to the bottom of the list (a FIFO stack), so that for example 
-**  the very first node moved will be the first node on the list when the 
-**  sorting is completed. The process continues until no unsorted nodes remain.
-**    The multi-flow option was added to allow for multiple flow directions
-**  and kinematic-wave routing. The algorithm is slightly different. At
-**  each pass, the unsorted nodes are "de-flagged" by setting their
-**  tracer variables to zero. Then each unsorted node flags _all_ of the
-**  adjacent nodes that are downhill by setting their tracer to 1 (this
-**  is accomplished through a call to ActivateSortTracer). Finally, any
-**  unflagged nodes are moved to the back of the list, and the process
-**  is repeated until all nodes have been sorted.
-**
-**  TODO: it is possible that the "flagging" method, as opposed to the
-**  "tracer movement" method, is more efficient even for single-flow
-**  routing. The added cost lies in unflagging the unsorted nodes at
-**  each pass. However, the gain comes from the fact that you never have
-**  multiple "tracers" at a node that need to be removed one by one.
-**  The two methods should be tested and compared.
+**  network (upstream to downstream). The order is that of the "cascade" 
+**  algorithm of Braun and Sambridge, which assigns a tracer (like a packet
+**  of water) to each node and at each pass sends one tracer from each 
+**  node downstream, moving the nodes left without tracers to the bottom 
+**  of the list. A node runs out of tracers after as many passes as there
+**  are nodes draining through it (itself included), so the list ends up
+**  sorted by this number, ties in their former list order. BuildNetOrder()
+**  finds the numbers in one pass over the flow network and the active 
+**  part of the list is relinked in that order, instead of iterating the
+**  passes until no tracers are left.
 **
 *****************************************************************************/
 void tFlowNet::SortNodesByNetOrder()
 {
-	int nThisPass;                   // Number moved in current iteration
-	int i;
-	int done=0;
-	
 	tCNode * cn;
 	tMeshList<tCNode> *nodeList = gridPtr->getNodeList();
 	tMeshListIter<tCNode> listIter( nodeList );
-	int nUnsortedNodes = nodeList->getActiveSize(); // Number not yet sorted
+	std::vector< tListNode<tCNode>* > listNodes;
+	std::vector< tListNode<tCNode>* > order;
+	
+	BuildNetOrder();
 	
-	// Assign initial tracers: use "qs" field which 
-	// contains garbage at this stage
+	// List nodes by position in the active part of the list
 	for ( cn=listIter.FirstP(); listIter.IsActive(); cn=listIter.NextP() ) 
-		cn->ActivateSortTracer();
+		listNodes.push_back( listIter.NodePtr() );
 	
-	// Iterate: move tracers downstream and sort
-	// until no nodes with tracers are left 
-	do {
-		// Send tracers downstream
-		cn = listIter.FirstP();
-		for ( i=1; i <= nUnsortedNodes; i++ ) {
-			assert( cn != 0 );
-			cn->MoveSortTracerDownstream();
-			cn = listIter.NextP();
-		}
-		
-		// Scan for nodes with no tracers, and move to the bottom of the list
-		tListNode< tCNode > * nodeToMove;
-		nThisPass = 0;
-		done = TRUE;
-		
-		cn = listIter.FirstP();
-		for ( i=1; i<=nUnsortedNodes; i++ ) {
-			if ( cn->NoMoreTracers() ) {  // If no tracers, move to bottom of list
-				nodeToMove = listIter.NodePtr();
-				cn = listIter.NextP();
-				nodeList->moveToActiveBack( nodeToMove );
-				nThisPass++;
-			}
-			else {
-				cn = listIter.NextP();
-				done = FALSE;
-			}
-		}
-		
-		nUnsortedNodes -= nThisPass;
-	} while ( !done );
+	for (size_t k=0; k < netOrder.size(); k++)
+		order.push_back( listNodes[gridPtr->getActiveIndex(netOrder[k])] );
+	nodeList->setActiveOrder( order );
 	
 	// Changed to make edge IDs consistent
 	tEdge     * ce;
@@ -494,6 +470,59 @@ void tFlowNet::SortNodesByNetOrder()
         ce->setID( id );
 	for ( ct=titer.FirstP(), id=0; id<ntri; ct=titer.NextP(), id++ )
         ct->setID( id );
+	
+	// Node order and IDs changed: refresh the active node index
+	gridPtr->BuildActiveIndex();
+	return;
+}
+
+/*****************************************************************************
+**  
+**  tFlowNet::BuildNetOrder()
+**  
+**  Orders the active nodes from upstream to downstream in O(N) with
+**  NetOrder() (see tNetOrder.h), on the flow receivers by position in
+**  the list, so equal counts of upstream nodes keep the list order. The
+**  order, the receivers and the counts are kept (getNetOrder,
+**  getNetReceiver) for other modules.
+**
+*****************************************************************************/
+void tFlowNet::BuildNetOrder()
+{
+	int i, k, n;
+	tCNode *dn;
+	
+	gridPtr->BuildActiveIndex();
+	n = gridPtr->getNumActiveNodes();
+	
+	// Flow receiver of each node by list position, -1 if not active
+	std::vector<int> receiver(n, -1);
+	for (i=0; i < n; i++) {
+		dn = gridPtr->getActiveNode(i)->getDownstrmNbr();
+		if (dn != 0)
+			receiver[i] = gridPtr->getActiveIndex(dn);
+	}
+	
+	std::vector<int> order, upstream, position(n);
+	int inLoop = NetOrder(receiver, order, upstream);
+	if (inLoop) {
+		Cout<<"\nError: BuildNetOrder(): "<<inLoop
+			<<" nodes drain in a loop"
+			<<"\nExiting Program..."<<endl<<flush;
+		exit(2);
+	}
+	
+	netOrder.resize(n);
+	netReceiver.resize(n);
+	netUpstream.resize(n);
+	for (k=0; k < n; k++) {
+		netOrder[k] = gridPtr->getActiveNode(order[k]);
+		netUpstream[k] = upstream[order[k]];
+		position[order[k]] = k;
+	}
+	for (k=0; k < n; k++)
+		netReceiver[k] = (receiver[order[k]] >= 0) ? 
+			position[receiver[order[k]]] : -1;
 	return;
 }
 
@@ -679,7 +708,13 @@ void tFlowNet::setMaxTravelTime()
 	
 	maxttime = dist_hill_max/hillvel + dist_stream_max/streamvel; //SECONDS
 	res->iimax = timer->getResStep(maxttime/(3600.0));
-	
+
+	// Binary store: arrays follow the run, no fixed limit
+	if (res->optStore) {
+		res->advance();
+		return;
+	}
+
 	// Set MAX index in hydrograph
 	if (res->iimax > res->limit || res->iimax < 0) {
 		Cout<<"\nError: setTravelTime(): iimax > limit,  iimax = "
@@ -1187,26 +1222,43 @@ void tFlowNet::SetBasinOutlet()
 **  Computes drainage area for each node by summing the Voronoi areas of all
 **  nodes that drain to it, using the following algorithm:
 **
-**    FOR each active node
-**      Cascade downstream, adding starting node's Voronoi area to each
-**      ownstream node's drainage area, until an outlet or sink is reached
+**    FOR each active node, in network order (upstream to downstream)
+**      Add the node's Voronoi area to its drainage area, and pass its 
+**      drainage area to its downstream node
 **
 **    Note that each node's drainage area includes its own Voronoi area.
+**    Each node is visited once, instead of cascading the area of every
+**    node down to the outlet.
 **
 **    Modifies:  node contrbuting area
 **
 *****************************************************************************/
 void tFlowNet::DrainAreaVoronoi()
 {
+	int k, n;
 	tCNode * cn;
-	tMeshListIter<tCNode> nodIter( gridPtr->getNodeList() );
 	
-	// Send voronoi area for each node to the node at 
-	// the other end of the flowedge and downstream  
+	// Flow directions and node order may have changed since the nodes 
+	// were sorted
+	BuildNetOrder();
+	n = (int)netOrder.size();
+	
+	// Send the drainage area of each node to the node at 
+	// the other end of the flowedge
 	Cout.setf( ios::fixed, ios::floatfield);
 	
-	for ( cn = nodIter.FirstP(); nodIter.IsActive(); cn = nodIter.NextP() )
-		RouteFlowArea( cn, cn->getVArea() );
+	std::vector<double> area(n, 0.0);
+	for (k=0; k < n; k++) {
+		cn = netOrder[k];
+		area[k] += cn->getVArea();
+		cn->addContrArea( area[k] );
+		if (netReceiver[k] >= 0)
+			area[netReceiver[k]] += area[k];
+		else {
+			assert( cn->getDownstrmNbr() == OutletNode );
+			OutletNode->addContrArea( area[k] );
+		}
+	}
 	
 	if (OutletNode->getContrArea() < THRESH)
 		Cout<<"\nOutlet contributing area:\t"
@@ -1217,33 +1269,6 @@ void tFlowNet::DrainAreaVoronoi()
 	return;
 }
 
-/*****************************************************************************
-**
-**  RouteFlowArea
-**
-**  Starting from the current node 'cn', this routine increments 
-**  the drainage area of the node and each node downstream by _addedArea_
-**
-*****************************************************************************/
-void tFlowNet::RouteFlowArea( tCNode *cn, double addedArea )
-{
-	int niterations=0;  // Safety feature: prevents endless loops
-	
-	// As long as the current node is neither a boundary nor a sink, add
-	// _addedArea_ to its total drain. area and advance to the next downstream
-	
-	do {
-		cn->addContrArea( addedArea );
-		cn = cn->getDownstrmNbr();
-		niterations++;
-		assert( niterations <= gridPtr->getNodeList()->getActiveSize() );
-	} while ( cn != OutletNode);
-	
-	cn->addContrArea( addedArea ); //Add it to the Outlet node as well
-	
-	return;
-}
-
 /****************************************************************************
 **
 **  DeriveCurvature
@@ -1428,6 +1453,17 @@ void tFlowNet::PrintArcInfoLinks(tInputFile &infile)
 **  
 **  WeightedShortestPath()
 **
+**  Connects the stream nodes to the outlet by the path of least weight,
+**  using the contributing area variable for the path variable. Stream 
+**  nodes reached from the settled ones are kept in a tNodeHeap by the 
+**  path variable through their settled neighbors and settled in order of
+**  increasing path variable (Dijkstra's algorithm), so a settled node is
+**  rarely corrected afterwards (UpdatePathVariable). Nodes of equal path
+**  variable, common on flat meshes, are settled by their number of edges
+**  from the outlet, then in the order they were reached. With 
+**  OPTPATHHEAP = 0 all nodes are settled in the order they were reached,
+**  as by the former list of nodes, to check a network against it.
+**
 *****************************************************************************/
 
 #define STEDGWEIGHT 2.5
@@ -1439,17 +1475,24 @@ void tFlowNet::WeightedShortestPath()
 {
 	int flag = 1;
 	int niterations = 0;
+	int maxID = -1;
 	tCNode *cn;
 	
 	tMeshListIter<tCNode>  niter( gridPtr->getNodeList() );
 	tPtrListIter< tCNode > HeadsIter( HeadsLst );
-	tPtrList< tCNode >     NodesLst; 
-	tPtrListIter< tCNode > NodesIter( NodesLst );
-	tPtrList< tEdge >      EdgeLst; 
-	tPtrListIter< tEdge >  EdgeIter( EdgeLst );
+	tNodeHeap              NodesHeap;
 	
 	Cout<<"\nConnect stream nodes by weighted short path..."<<endl<<flush;
 	
+	// Nodes are queued by ID
+	for ( cn=niter.FirstP(); !(niter.AtEnd()); cn=niter.NextP() )
+		maxID = max( maxID, cn->getID() );
+	pathNodes.assign(maxID+1, 0);
+	for ( cn=niter.FirstP(); !(niter.AtEnd()); cn=niter.NextP() )
+		pathNodes[cn->getID()] = cn;
+	NodesHeap.resize(maxID+1);
+	NodesHeap.setFifo(pathHeapOption == 0);
+	
 	// Set tracer to '1' and use the contributing area variable 
 	// to find the shortest path (summing weights for edge length) 
 	
@@ -1462,8 +1505,8 @@ void tFlowNet::WeightedShortestPath()
 	OutletNode->setTracer(SETTLED);
 	OutletNode->setContrArea(0.0);
 	
-	// Start adding stream nodes to the least
-	AddUnsettledNeighbors(OutletNode, NodesLst, EdgeLst);
+	// Start adding stream nodes to the heap
+	AddUnsettledNeighbors(OutletNode, NodesHeap);
 	
 	// The first 'while' loop is intended not to miss  
 	// any possible disjoints in stream network of the 
@@ -1472,29 +1515,18 @@ void tFlowNet::WeightedShortestPath()
 	// correction of flow directions between disjoints
 	
 	while ( flag ) { 
-		// Loop through the nodes of the list 
-		// Update the list as we move up in the basin
-		NodesIter.FirstP();
-		while ( !NodesLst.isEmpty() ) {
+		// Settle the nodes of the heap, the least path variable first,
+		// adding their unsettled neighbors as we move up in the basin
+		while ( !NodesHeap.isEmpty() ) {
 			
 			// Take the current node
-			cn = NodesIter.DatPtr();
-			
-			AddUnsettledNeighbors(cn, NodesLst, EdgeLst);
+			cn = pathNodes[ NodesHeap.pop() ];
 			
-			// Now, remove the current node from the list  
-			NodesLst.removeFromFront();
-			EdgeLst.removeFromFront();
-			
-			// If list is not empty, take the next node
-			if (!NodesLst.isEmpty())
-				NodesIter.FirstP();
+			AddUnsettledNeighbors(cn, NodesHeap);
 			
 			assert( niterations <= gridPtr->getNodeList()->getActiveSize());
 			niterations++;
 		}
-		NodesLst.Flush();
-		EdgeLst.Flush();
 		
 		// Now, define the basin stream heads among "settled" nodes
 		
@@ -1517,7 +1549,7 @@ void tFlowNet::WeightedShortestPath()
 		for (cn=HeadsIter.FirstP(); !(HeadsIter.AtEnd()); cn=HeadsIter.NextP()) {
 			//Cout<<"\n\n # Checking stream heads:"<<endl;
 			//TellAboutNode(cn);
-			flag += FindStreamDisjoints(cn, 1, NodesLst);
+			flag += FindStreamDisjoints(cn, 1, NodesHeap);
 		}
 		
 		// If disjoint nodes have been found Flush the stream head list, it would
@@ -1529,7 +1561,7 @@ void tFlowNet::WeightedShortestPath()
 		// (i.e. searching at a defined stream head), they still may exist, 
 		// so use another procedure to figure out if they indeed exist 
 		else {
-			flag = FindConfluenceDisjoints(NodesLst);
+			flag = FindConfluenceDisjoints(NodesHeap);
 		}
 	}
 
@@ -1559,8 +1591,9 @@ void tFlowNet::WeightedShortestPath()
 	
 	// Due to some peculiarities, we need to re-check stream heads again
 	for (cn=HeadsIter.FirstP(); !(HeadsIter.AtEnd()); cn=HeadsIter.NextP()) {
-		AddUnsettledNeighbors(cn, NodesLst, EdgeLst);
+		AddUnsettledNeighbors(cn, NodesHeap);
 	}
+	NodesHeap.clear();
 	HeadsLst.Flush();
 	
 	// Re-define the basin stream heads one more time 
@@ -1612,13 +1645,11 @@ void tFlowNet::WeightedShortestPath()
 **  The function considers neighboring to 'cn' nodes and sets the shortest 
 **  path. It first take an edge to a node that has been "settled" already 
 **  and searches for the other "settled" nodes to set the flowedge. All
-**  "unsettled" nodes are added to the general list of nodes that are to 
-**  be checked by the calling function
+**  "unsettled" nodes are added to the heap of nodes that are to be 
+**  checked by the calling function, with the path variable through 'cn'
 **
 *****************************************************************************/
-void tFlowNet::AddUnsettledNeighbors(tCNode *cn,
-					 tPtrList<tCNode> &NodesLst,
-					 tPtrList<tEdge> &EdgeLst)
+void tFlowNet::AddUnsettledNeighbors(tCNode *cn, tNodeHeap &NodesHeap)
 {
 	int cnt = 0;
 	double ttt = 0;
@@ -1651,11 +1682,11 @@ void tFlowNet::AddUnsettledNeighbors(tCNode *cn,
 		}
 	}
 	// Start checking the nodes... 
-	cnt = CheckNeighbor( cn, firstedg, NodesLst, EdgeLst );
+	cnt = CheckNeighbor( cn, firstedg, NodesHeap );
 	
 	curedg = firstedg->getCCWEdg();
 	while (curedg != firstedg) {
-		cnt += CheckNeighbor( cn, curedg, NodesLst, EdgeLst );
+		cnt += CheckNeighbor( cn, curedg, NodesHeap );
 		curedg = curedg->getCCWEdg();
 	}
 
@@ -1671,6 +1702,17 @@ void tFlowNet::AddUnsettledNeighbors(tCNode *cn,
 		else
 			cn->setTracer(SETTLED);
 	}
+	
+	// The path variable of 'cn' is set: lower the keys of the 
+	// queued neighbors that have a shorter path through 'cn'
+	curedg = firstedg;
+	do {
+		cnn = (tCNode*)curedg->getDestinationPtrNC();
+		if ( NodesHeap.contains(cnn->getID()) )
+			NodesHeap.push( cnn->getID(), cn->getContrArea() + 
+							ComputeEdgeWeight( curedg, STEDGWEIGHT ) );
+		curedg = curedg->getCCWEdg();
+	} while (curedg != firstedg);
 	return;
 }
 
@@ -1679,17 +1721,15 @@ void tFlowNet::AddUnsettledNeighbors(tCNode *cn,
 **  CheckNeighbor()
 **  
 **  The function takes as arguments a ptr to a current node 'cn', an edge
-**  'curedge' that originates at 'cn' and a node list NodesLst. The routine
+**  'curedge' that originates at 'cn' and a node heap NodesHeap. The routine
 **  analyzes the node located on another end of 'curedg'. Depending to what 
 **  its tracer equals to, it:
 **      - Does nothing with it (tracer == INSTACK);
 **      - Checks if 'cnn' is suitable for flowing into (tracer == SETTLED);  
-**      - Adds the node to the list of nodes to be analyzed ((tracer < INSTACK);
+**      - Adds the node to the heap of nodes to be analyzed ((tracer < INSTACK);
 **
 *****************************************************************************/
-int tFlowNet::CheckNeighbor(tCNode *cn, tEdge *curedg,
-				tPtrList<tCNode> &NodesLst,
-				tPtrList<tEdge> &EdgeLst)
+int tFlowNet::CheckNeighbor(tCNode *cn, tEdge *curedg, tNodeHeap &NodesHeap)
 {
 	int cnt = 0;
 	double tempo;
@@ -1732,10 +1772,12 @@ int tFlowNet::CheckNeighbor(tCNode *cn, tEdge *curedg,
 				}
 			}
 		}
-		// If the stream node is "Unsettled" --> put it in the stack 
+		// If the stream node is "Unsettled" --> put it in the heap, its
+		// key is set once the path variable of 'cn' is known. Its level
+		// (one past 'cn') keeps ties in the order of the former search
 		else if (cnn->getTracer() < INSTACK) {
-			NodesLst.insertAtBack( cnn );
-			EdgeLst.insertAtBack( curedg );
+			NodesHeap.push( cnn->getID(), 1.0E+9, 
+							NodesHeap.getLevel(cn->getID()) + 1 );
 			cnn->setTracer(INSTACK);
 			cnt++;
 		}
@@ -1864,34 +1906,37 @@ int tFlowNet::IsToEliminate(tCNode *chead)
 **  node for search of the confluence)
 **  
 *****************************************************************************/
-int tFlowNet::FindConfluenceDisjoints(tPtrList<tCNode> &NodesLst)
+int tFlowNet::FindConfluenceDisjoints(tNodeHeap &NodesHeap)
 {
 	int cnt = 1;
 	int flag = 0;
 	int niterations = 0;
-	tCNode *cn, *cmove;
+	tCNode *cmove, *cscan;
 	
 	tMeshListIter<tCNode> niter( gridPtr->getNodeList() );
 	
 	// Loop through the nodelist until all the possibilities are checked, i.e.
 	// loop until you find stream head that may lead us to a confluence, if it
 	// does - get out and work with this tributary, if not - continue searching 
+	// from the next node. A tributary that does not lead to a disjoint only 
+	// changes the tracers of its own nodes, so the nodes passed before do not
+	// have to be checked again
 	
+	cscan = niter.FirstP();
 	while (cnt > 0 && flag == 0) {
 		
 		cnt  = 0;
 		flag = 0;
 		
-		cn = niter.FirstP();
 		while ( niter.IsActive() && cnt == 0 ) {
 			// Consider only nodes with (tracer == 0)
-			if (cn->getBoundaryFlag() == kStream && cn->NoMoreTracers()) {
-				if ( IsStreamHead(cn) ) {
+			if (cscan->getBoundaryFlag() == kStream && cscan->NoMoreTracers()) {
+				if ( IsStreamHead(cscan) ) {
 					cnt++;
 				}
 			}
-			cmove = cn;
-			cn = niter.NextP();
+			cmove = cscan;
+			cscan = niter.NextP();
 		}
 		
 		// If an unsettled stream head has been found --> we need 
@@ -1902,7 +1947,6 @@ int tFlowNet::FindConfluenceDisjoints(tPtrList<tCNode> &NodesLst)
 		if ( cnt ) {
 			niterations = 0;
 			do { 
-				cn = cmove;
 				cmove->setTracer(-1); // <-- Assign tracer to '-1'
 				cmove = cmove->getDownstrmNbr();
 				
@@ -1927,7 +1971,7 @@ int tFlowNet::FindConfluenceDisjoints(tPtrList<tCNode> &NodesLst)
 			// found in the vicinity of 'cmove', the algorithm will return 
 			// (flag = 0) and therefore the tributary will not be ever found
 			
-			flag = FindStreamDisjoints(cmove, 1, NodesLst);
+			flag = FindStreamDisjoints(cmove, 1, NodesHeap);
 		}
 	}
 	return flag;
@@ -1943,7 +1987,7 @@ int tFlowNet::FindConfluenceDisjoints(tPtrList<tCNode> &NodesLst)
 **  to a stream node that has "unsettled" value of tracer (< INSTACK) then the 
 **  node 'cn' is a disjoint node. Correspondingly, an optimum path to the found
 **  "unsettled" stream node is defined through a hillslope node (which becomes
-**  'stream') and it is stored in the general stack of nodes 'NodesLst'.
+**  'stream') and it is stored in the general heap of nodes 'NodesHeap'.
 **  
 **  NOTE: - So far, it is assumed that there might be only ONE hillslope node 
 **  that disjoints stream network. The function might be designed for recursive
@@ -1952,7 +1996,7 @@ int tFlowNet::FindConfluenceDisjoints(tPtrList<tCNode> &NodesLst)
 ** 
 *****************************************************************************/
 int tFlowNet::FindStreamDisjoints(tCNode *cn, int times, 
-				  tPtrList<tCNode> &NodesLst)
+				  tNodeHeap &NodesHeap)
 {
 	int cnt = 0;
 	double tempo = 0;
@@ -2023,9 +2067,12 @@ int tFlowNet::FindStreamDisjoints(tCNode *cn, int times,
 				tempo += ComputeEdgeWeight(firstedg, STEDGWEIGHT);
 				cnn->setContrArea( tempo );
 				
-				// 5.) Put the found stream node in stack
+				// 5.) Put the found stream node in the heap, two edges
+				//     past 'cn'
 				cnn = (tCNode*)curedg->getDestinationPtrNC();
-				NodesLst.insertAtBack( cnn );
+				NodesHeap.push( cnn->getID(), 
+								tempo + ComputeEdgeWeight(curedg, STEDGWEIGHT),
+								NodesHeap.getLevel(cn->getID()) + 2 );
 				
 				// 6.) Clean up temporary stacks
 				EdgeLst1.Flush();
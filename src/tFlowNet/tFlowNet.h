@@ -33,6 +33,9 @@
 #include "src/tCNode/tCNode.h"
 #include "src/tSimulator/tRunTimer.h"
 #include "src/tFlowNet/tFlowResults.h"
+#include "src/tFlowNet/tNodeHeap.h"
+
+#include <vector>
 
 //=========================================================================
 //
@@ -59,9 +62,9 @@ public:
   int IsStreamDisjoint(tEdge*,tCNode*,tPtrList<tEdge> &,tPtrList<tEdge> &);
   int IsToEliminate(tCNode*);
 
-  int CheckNeighbor(tCNode*, tEdge*,tPtrList<tCNode> &,tPtrList<tEdge> &);
-  int FindStreamDisjoints(tCNode*, int, tPtrList<tCNode> &);
-  int FindConfluenceDisjoints(tPtrList<tCNode> &);
+  int CheckNeighbor(tCNode*, tEdge*, tNodeHeap &);
+  int FindStreamDisjoints(tCNode*, int, tNodeHeap &);
+  int FindConfluenceDisjoints(tNodeHeap &);
 
   void SetFlowVariables(tInputFile &);
   void SetBasinOutlet();
@@ -69,6 +72,7 @@ public:
   void InitFlowDirs();
   void FlowDirs();
   void SortNodesByNetOrder();
+  void BuildNetOrder();
   void FillLakes();
   void initializeTravelTime();
   void initializeTravelTimeOnly();     
@@ -77,14 +81,13 @@ public:
   void setTravelVelocity(double);
   void SurfaceFlow();
   void DrainAreaVoronoi();
-  void RouteFlowArea(tCNode *, double);
   void DeriveStreamReaches(tInputFile &); 
   void ComputeDistanceToStream();         
   void SortStreamNodes();                 
   void TellAboutNode(tCNode *cn);       
   void PrintArcInfoLinks(tInputFile &);  
   void WeightedShortestPath(); 
-  void AddUnsettledNeighbors(tCNode*,tPtrList<tCNode> &,tPtrList<tEdge> &);
+  void AddUnsettledNeighbors(tCNode*, tNodeHeap &);
   void UpdatePathVariable(tCNode*);
   void CheckVDrainageWidths();
   void FixVoronoiEdgeWidth(tCNode *);
@@ -114,6 +117,12 @@ public:
   tPtrList< tCNode >& getReachOutletList() { return NodesLstO; }
   tList< int >& getReachSizeList() { return NNodes; }
 
+  // Network order of the active nodes, as of the last BuildNetOrder():
+  // upstream to downstream, with the position in this order of the flow
+  // receiver of each node (-1 if the receiver is not active)
+  const std::vector<tCNode*>& getNetOrder() const { return netOrder; }
+  const std::vector<int>& getNetReceiver() const { return netReceiver; }
+
 
   tFlowResults* getResultsPtr() { return res; }
   tCNode*       getOutletPtr()  { return OutletNode;}
@@ -146,6 +155,13 @@ protected:
   double dist_stream_max;	// MAX distance in stream, [m]
   double BasArea;               // Total Basin Area, [m^2]
   int percolationOption;	// ASM percolation option
+  int pathHeapOption;           // Order of WeightedShortestPath (OPTPATHHEAP)
+
+  std::vector<tCNode*> pathNodes;   // Nodes by ID, for tNodeHeap items
+  std::vector<tCNode*> netOrder;    // Active nodes, upstream to downstream
+  std::vector<int> netReceiver;     // Position of the flow receiver
+  std::vector<int> netUpstream;     // Number of active nodes draining
+                                    // through each node, itself included
 };
 
 #endif
@@ -107,123 +107,85 @@ void tFlowResults::SetFlowResVariables(tInputFile &infile, double add_time)
 	Cout<<"Hydrograph Outlet Name: \t\t "<<outlet<<endl;
 	Cout<<"Hydrograph File Extension: \t"<<Extension<<endl;
 	
-	limit = (int)add_time; //TODO: this limit should really just be the length of runtime, rigth?
-	
-	if ((phydro = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: phydro failed..."<<endl;
-	
-	if ((mhydro = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: mhydro failed..."<<endl;
-	
-	if ((HsrfRout = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: HsrfRout failed..."<<endl;
-	
-	if ((SbsrfRout = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: SbsrfRout failed..."<<endl;
-	
-	if ((PsrfRout = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: PsrfRout failed..."<<endl;
-	
-	if ((SatsrfRout = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: SatsrfRout failed..."<<endl;
-	
-	if ((prr = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: prr failed..."<<endl;
-	
-	if ((crr = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: crr failed..."<<endl;
-	
-	if ((max = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: max failed..."<<endl;
-    
-	if ((min = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: min failed..."<<endl;
-	
-	if ((sat = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: sat failed..."<<endl;
-	
-	if ((msm = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: msm failed..."<<endl;
-	
-	if ((msmRt = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: msmRt failed..."<<endl;
-	
-	if ((msmU = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: msmU failed..."<<endl;
-	
-	if ((mgw = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: mgw failed..."<<endl;
-	
-	if ((met = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: met failed..."<<endl;
-
-	// SKY2008Snow from AJR2007
-	if ((swe = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: swe failed..."<<endl;
-	if ((melt = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: melt failed..."<<endl;
-	if ((snsub = (double*)calloc(limit,sizeof(double)))==NULL) // CJC2020
-		cout <<"\ntFlowResults: snsub failed..."<<endl; // CJC2020
-	if ((snevap = (double*)calloc(limit,sizeof(double)))==NULL) // CJC2020
-		cout <<"\ntFlowResults: snevap failed..."<<endl; // CJC2020
-	if ((stC = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: stC failed..."<<endl;
-	if ((DUint = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: DUint failed..."<<endl;
-	if ((slhf = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: slhf failed..."<<endl;
-	if ((sshf = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: sshf failed..."<<endl;
-	if ((sghf = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: sghf failed..."<<endl;
-	if ((sphf = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: sphf failed..."<<endl;
-	if ((srli = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: srli failed..."<<endl;
-	if ((srlo = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: srlo failed..."<<endl;
-	if ((srsi = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: srsi failed..."<<endl;
-	if ((intsn = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: intsn failed..."<<endl;
-	if ((intsub = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\ntFlowResults: intsub failed..."<<endl;
-	if ((intunl = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\nFlowResults: intunl failed..."<<endl;
-	if ((sca = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout <<"\nFlowResults: sca failed..."<<endl;
-
-	if ((frac = (double*)calloc(limit,sizeof(double)))==NULL)
-		cout<<"\ntFlowResults: frac failed..."<<endl;
-	
-	if ((fState = (int*)calloc(limit,sizeof(int)))==NULL)
-		cout<<"\ntFlowResults: fState failed..."<<endl;
-	
-	if ((qunsat = (double*)calloc(limit,sizeof(double)))==NULL) // CJC2025
-		cout<<"\ntFlowResults: qunsat failed..."<<endl;
+	optStore = 0;
+	if (infile.IsItemIn("OPTHYDROBINARY"))
+		optStore = infile.ReadItem(optStore, "OPTHYDROBINARY");
+
+	block = NULL;
+	fState = NULL;
+	store = NULL;
+	limit = base = 0;
+
+	// The store keeps two blocks of steps to start with, resizeResults()
+	// extends it to the maximum travel time when needed. The file is
+	// opened with the first block (see openStore), once a restart file
+	// has given the first step of the arrays
+	if (optStore)
+		resizeResults(2*kStoreBlock);
+	else
+		resizeResults((int)add_time); //TODO: this limit should really just be the length of runtime, rigth?
+	iimax=0;
 
-    if ((Perc = (double*)calloc(limit,sizeof(double)))==NULL)
-        cout<<"\ntFlowResults: Percolation failed..."<<endl; //ASM percolation option
+	return;
+}
 
-    for (i=0; i<limit; i++) {
-		mhydro[i] = phydro[i] = 0.0;
-		prr[i] = crr[i] = 0.0;
-		HsrfRout[i] = SbsrfRout[i] = 0.0;
-		PsrfRout[i] = SatsrfRout[i] = 0.0;
-		fState[i] = 0;
-		max[i]=sat[i]=msm[i]=mgw[i]=msmU[i]=msmRt[i]=met[i]=frac[i]=0.0;
-		      
-		// SKY2008Snow from AJR2007
-		swe[i] = melt[i] = intsn[i] = intsub[i] = intunl[i] = sca[i] = 0.0;
-		stC[i] = DUint[i] = srsi[i] = srlo[i] = srli[i] = sghf[i] = sphf[i] = 0.0;
-		sshf[i] = slhf[i] = snsub[i] = snevap[i] = 0.0; // Added snsub, snevap CJC2020
-		qunsat[i] = 0.0; // CJC2025
+/***************************************************************************
+**
+**  tFlowResults::getColumns()
+**
+**  Addresses of the double arrays, in the order of their columns in block
+**
+***************************************************************************/
+void tFlowResults::getColumns(double **cols[])
+{
+	double **all[kNumColumns] = {
+		&prr, &crr, &phydro, &mhydro, &HsrfRout, &SbsrfRout, &PsrfRout,
+		&SatsrfRout, &max, &min, &msm, &msmRt, &msmU, &mgw, &met, &sat,
+		&frac, &swe, &melt, &snsub, &snevap, &stC, &DUint, &slhf, &sshf,
+		&sghf, &sphf, &srli, &srlo, &srsi, &intsn, &intsub, &intunl, &sca,
+		&Perc, &qunsat };
+	for (int c = 0; c < kNumColumns; c++)
+		cols[c] = all[c];
+}
+
+/***************************************************************************
+**
+**  tFlowResults::resizeResults(int n)
+**
+**  (Re)allocates the result arrays for n steps from base. Entries kept
+**  from the previous arrays are copied, new entries are initialized.
+**
+***************************************************************************/
+void tFlowResults::resizeResults(int n)
+{
+	double **cols[kNumColumns];
+	double *newBlock;
+	int *newState;
+	int keep = (limit < n) ? limit : n;
 
-                Perc[i]=0.0; //ASM Percolation opt
+	getColumns(cols);
 
-		min[i]=9999.99;
+	if ((newBlock = (double*)calloc((size_t)n*kNumColumns,sizeof(double)))==NULL)
+		cout<<"\ntFlowResults: result arrays failed..."<<endl;
+	if ((newState = (int*)calloc(n,sizeof(int)))==NULL)
+		cout<<"\ntFlowResults: fState failed..."<<endl;
+
+	for (int c = 0; c < kNumColumns; c++) {
+		double *col = newBlock + (size_t)c*n;
+		if (keep > 0)
+			memcpy(col, *cols[c], keep*sizeof(double));
+		*cols[c] = col;
 	}
-	iimax=0;
+	if (keep > 0)
+		memcpy(newState, fState, keep*sizeof(int));
+	for (int i = keep; i < n; i++)
+		min[i]=9999.99;
+
+	free(block);
+	free(fState);
+	block = newBlock;
+	fState = newState;
+	limit = n;
 	return;
 }
 
@@ -237,90 +199,22 @@ void tFlowResults::SetFlowResVariables(tInputFile &infile, double add_time)
 ***************************************************************************/
 void tFlowResults::free_results() 
 { 
+	double **cols[kNumColumns];
+
 	limit= 0;
-	
-	free(phydro);
-	free(mhydro);
-	free(HsrfRout);
-	free(SbsrfRout);
-	free(PsrfRout);
-	free(SatsrfRout);
-	free(prr);
-	free(crr);
-	free(max);
-	free(min);
-	free(sat);
-	free(msm);
-	free(msmU);
-	free(msmRt);
-	free(mgw);
-	free(met);
-	free(frac);
+	base = 0;
+
+	free(block);
 	free(fState);
-	// SKY2008Snow from AJR2007
-	free(swe);
-	free(melt);
-	free(snsub); // CJC2020
-	free(snevap); // CJC2020
-	free(stC);
-	free(DUint);
-	free(slhf);
-	free(sshf);
-	free(sghf);
-	free(sphf);
-	free(srli);
-	free(srlo);
-	free(srsi);
-	free(intsn);
-	free(intsub);
-	free(intunl);
-	free(sca);
-	free(qunsat); // CJC2025
-
-    //ASM 5/5/2016
-    free(Perc); //ASM percolation option
-
-	prr=nullptr;
-	crr=NULL;
-	phydro=NULL;
-	mhydro=NULL;
-	HsrfRout=NULL;
-	SbsrfRout=NULL;
-	PsrfRout=NULL;
-	SatsrfRout=NULL;
-	fState=NULL;
-	max = NULL;
-	min = NULL;
-	msm = NULL;
-	msmU = NULL;
-	msmRt = NULL;
-	mgw = NULL;
-	met = NULL;
-	sat = nullptr;
-	frac = NULL;
-
-	// SKY2008Snow from AJR2007
-	swe = NULL;
-	melt = NULL;
-	snsub = NULL; // CJC2020
-	snevap = NULL; // CJC2020
-	stC = NULL;
-	DUint = NULL;
-	slhf = NULL;
-	sshf = NULL;
-	sghf = NULL;
-	sphf = NULL;
-	srli = NULL;
-	srlo = NULL;
-	srsi = NULL;
-	intsn = NULL;
-	intsub = NULL;
-	intunl = NULL;
-	sca = NULL;
-    //ASM 5/5/2016
-    Perc = NULL; //ASM percolation option
-	qunsat = NULL; // CJC2025
+	block = NULL;
+	fState = NULL;
 
+	getColumns(cols);
+	for (int c = 0; c < kNumColumns; c++)
+		*cols[c] = NULL;
+
+	delete store;
+	store = NULL;
 	return;
 }
 
@@ -443,6 +337,15 @@ void tFlowResults::writeAndUpdate( double time, int forenum )
 		cout<<"\n\ttFlowResults: Time to write hydrograph; time = "
 			<<time<<endl<<flush;
 	
+	// Binary store: append the completed steps
+	if (optStore) {
+		if (timer->getoptForecast()!=0 && count >= base && count < base+limit)
+			fState[count-base] = checkForecast();
+		flushStore(timer->getResStep(0.0) - 1);
+		count++;
+		return;
+	}
+
 	hour   = (int)floor(time);
 	minute = (int)floor((time-hour)*60);
 
@@ -802,6 +705,19 @@ void tFlowResults::whenTimeIsOver( double time )
 		cout<<"\n\ttFlowResults: Time to write runoff types; time = "
 			<<time<<endl<<flush;
 	
+	// Binary store: append the remaining steps, including those still
+	// receiving routed runoff, as the *.mrf file at the end of the run
+	if (optStore) {
+		flushStore(iimax);
+		if (store == NULL)
+			openStore();
+		if (store)
+			store->close();
+		Cout<<"Creating Hydrograph Store Output: '"<<baseHydroName
+			<<".hts'"<<endl;
+		return;
+	}
+
 	hour   = (int)floor(time);
 	minute = (int)floor((time-hour)*60);
 	
@@ -865,6 +781,8 @@ void tFlowResults::store_volume(double time, double value)
 	
 	init = timer->getResStep(time+.01*dCalc); 
 	end  = timer->getResStep(time+.99*dCalc);
+	if (optStore && end-base >= limit)
+		resizeResults(2*(end-base+1));
 	
 	if (init==end) {
 		add_m_volume(value, init); 
@@ -920,6 +838,8 @@ void tFlowResults::store_volume_Type(double time, double value, int Type)
 	// To prevent synchronous stuff 
 	init = timer->getResStep(time+.01*dCalc); 
 	end  = timer->getResStep(time+.99*dCalc);
+	if (optStore && end-base >= limit)
+		resizeResults(2*(end-base+1));
 	
 	if (init == end) {
 		add_m_volume_Type(value, init, Type); 
@@ -966,19 +886,19 @@ void tFlowResults::add_m_volume_Type(double value, int iStep, int Type)
 {
 	// Hortonian runoff
 	if (Type == 1)      
-		HsrfRout[iStep] += value/timer->getOutputIntervalSec();
+		HsrfRout[iStep-base] += value/timer->getOutputIntervalSec();
 	
 	// Saturation from below
 	else if (Type == 2) 
-		SbsrfRout[iStep] += value/timer->getOutputIntervalSec();
+		SbsrfRout[iStep-base] += value/timer->getOutputIntervalSec();
 	
 	// Perched saturation runoff
 	else if (Type == 3) 
-		PsrfRout[iStep] += value/timer->getOutputIntervalSec();
+		PsrfRout[iStep-base] += value/timer->getOutputIntervalSec();
 	
 	// Ground water return flow
 	else if (Type == 4) 
-		SatsrfRout[iStep] += value/timer->getOutputIntervalSec();
+		SatsrfRout[iStep-base] += value/timer->getOutputIntervalSec();
 	return;
 }
 
@@ -1034,22 +954,22 @@ void tFlowResults::store_rain(double time, double value)
 	end  = timer->getResStep(time-.99*dcalc);
 	
 	if (init==end) {
-		crr[init] += value*dcalc/dres;
+		crr[init-base] += value*dcalc/dres;
 	}
 	else {
 		if (end-init == 1) { 
 			dint = timer->res_hour_end(init) - timer->get_abs_hour(time);
-			crr[init] += value*dint/dres; 
-			crr[end]  += value*(dcalc-dint)/dres; 
+			crr[init-base] += value*dint/dres; 
+			crr[end-base]  += value*(dcalc-dint)/dres; 
 		}
 		else { 
 			dint = timer->res_hour_end(init) - timer->get_abs_hour(time);
-			crr[init] += value*dint/dres; 
+			crr[init-base] += value*dint/dres; 
 			for (ii=init+1; ii < end; ii++) {
-				crr[ii] +=value;
+				crr[ii-base] +=value;
 			}
 			dint=timer->get_abs_hour(time+dcalc) - timer->res_hour_begin(end); 
-			crr[end] += value*dint/dres;
+			crr[end-base] += value*dint/dres;
 		}
 	}
 	return;
@@ -1070,6 +990,9 @@ void tFlowResults::store_maxminrain(double time, double value, int flag)
 	init = timer->getResStep(time-.01*dcalc); 
 	end  = timer->getResStep(time-.99*dcalc);
 	
+	init -= base;  // Array entries from base
+	end  -= base;
+	
 	if (init==end) {
 		if (flag == 0) {
 			if (value > max[init])
@@ -1099,6 +1022,9 @@ void tFlowResults::store_saturation(double time, double value, int flag)
 	init  = timer->getResStep(time-.01*dcalc); 
 	end   = timer->getResStep(time-.99*dcalc);
 	
+	init -= base;  // Array entries from base
+	end  -= base;
+	
 	if (init==end) {
 		if (flag == 0)
 			msm[init] += value*dcalc/dres;
@@ -1190,6 +1116,179 @@ int tFlowResults::checkForecast()
 	return state;
 }
 
+//=========================================================================
+//
+//
+//                  Section 5: tFlowResults: Binary Store
+//
+//
+//=========================================================================
+
+/***************************************************************************
+**
+**  tFlowResults::openStore()
+**
+**  Creates <OUTHYDROFILENAME>.hts with the columns of the *.mrf file
+**  followed by those of the *.rft file. A run continued from a restart
+**  file (base > 0) appends to the store of the run it continues if there
+**  is one, keeping its steps before base.
+**
+***************************************************************************/
+void tFlowResults::openStore()
+{
+	char storeName[kMaxNameSize+kMaxExt];
+	const char *colNames[] = {
+		"Srf", "MAP", "RainMax", "RainMin", "FState", "MSM100", "MSMRt",
+		"MSMU", "MDGW", "MET", "SatPercent", "RainPercent",
+		"AvSWE", "AvMelt", "AvSnSub", "AvSnEvap", "AvSTC", "AvDUInt",
+		"AvSLHF", "AvSSHF", "AvSPHF", "AvSGHF", "AvSRLI", "AvSRLO",
+		"AvSRSI", "AvInSn", "AvInSu", "AvInUn", "SCA",
+		"ChannelPercolation", "Qunsat",
+		"Hsrf", "Sbsrf", "Psrf", "Satsrf" };
+	const char *colUnits[] = {
+		"m3/s", "mm/hr", "mm/hr", "mm/hr", "[]", "[]", "[]",
+		"[]", "mm", "mm", "[]", "[]",
+		"cm", "cm", "cm", "cm", "C", "kJ/m2",
+		"kJ/m2", "kJ/m2", "kJ/m2", "kJ/m2", "kJ/m2", "kJ/m2",
+		"kJ/m2", "cm", "cm", "cm", "[]",
+		"m3", "mm/hr",
+		"m3/s", "m3/s", "m3/s", "m3/s" };
+	int n = sizeof(colNames)/sizeof(colNames[0]);
+
+#ifdef PARALLEL_TRIBS
+	// Master processor writes the store
+	if (!tParallel::isMaster())
+		return;
+#endif
+
+	strcpy(storeName, baseHydroName);
+	strcat(storeName, ".hts");
+
+	store = new tHydroStore();
+	if (base > 0) {
+		if (store->append(storeName, timer->res_hour_begin(0),
+						  timer->getOutputInterval(),
+						  vector<string>(colNames, colNames+n),
+						  vector<string>(colUnits, colUnits+n), base)) {
+			Cout<<"Hydrograph Store: \t\t'"<<storeName<<"' (appended)"<<endl;
+			return;
+		}
+		Cout<<"\nWarning: No hydrograph store of the restarted run in '"
+			<<storeName<<"', steps before "<<base<<" are not in the store"<<endl;
+	}
+	if (!store->create(storeName, timer->res_hour_begin(0),
+					   timer->getOutputInterval(),
+					   vector<string>(colNames, colNames+n),
+					   vector<string>(colUnits, colUnits+n))) {
+		cout<<"\nError: Unable to open hydrograph store: "<<storeName<<endl;
+		cout<<"Exiting Program..."<<endl;
+		exit(2);
+	}
+	Cout<<"Hydrograph Store: \t\t'"<<storeName<<"'"<<endl;
+	return;
+}
+
+/***************************************************************************
+**
+**  tFlowResults::advance()
+**
+**  Called with the binary store once the maximum travel time (iimax) of
+**  the current step is known. Steps before the previous result step are
+**  complete; they are appended once a block of them has accumulated. The
+**  previous step is kept for the discharge used by the travel velocity.
+**  The arrays are extended to cover iimax.
+**
+***************************************************************************/
+void tFlowResults::advance()
+{
+	int done = timer->getResStep(0.0) - 1;
+
+	if (done - base >= kStoreBlock)
+		flushStore(done);
+	if (iimax - base >= limit)
+		resizeResults(2*(iimax - base + 1));
+	return;
+}
+
+/***************************************************************************
+**
+**  tFlowResults::flushStore(int last)
+**
+**  Appends the steps from base up to (not including) 'last' to the store
+**  as one block and shifts the arrays to start at 'last'. In parallel the
+**  block is summed over the processors (minimum and maximum for the rain
+**  extremes) and the master processor writes it.
+**
+***************************************************************************/
+void tFlowResults::flushStore(int last)
+{
+	double **cols[kNumColumns];
+	double *src[] = {
+		crr, max, min, NULL, msm, msmRt, msmU, mgw, met, sat, frac,
+		swe, melt, snsub, snevap, stC, DUint, slhf, sshf, sphf, sghf,
+		srli, srlo, srsi, intsn, intsub, intunl, sca, Perc, qunsat,
+		HsrfRout, SbsrfRout, PsrfRout, SatsrfRout };
+	int nSrc = sizeof(src)/sizeof(src[0]);
+	int n = last - base;
+	int keep;
+
+	if (n <= 0)
+		return;
+	if (n > limit)
+		n = limit;
+
+	// Block of the store, column by column (Srf first)
+	vector<double> values((size_t)(nSrc+1)*n);
+	for (int i = 0; i < n; i++)
+		values[i] = phydro[i] + mhydro[i];
+	for (int c = 0; c < nSrc; c++) {
+		double *col = &values[(size_t)(c+1)*n];
+		if (src[c] == NULL)
+			for (int i = 0; i < n; i++)
+				col[i] = (double)fState[i];
+		else
+			memcpy(col, src[c], n*sizeof(double));
+	}
+
+#ifdef PARALLEL_TRIBS
+	for (int c = 0; c < nSrc+1; c++) {
+		double *col = &values[(size_t)c*n];
+		double *reduced;
+		if (c > 0 && src[c-1] == NULL)
+			continue;
+		if (c > 0 && src[c-1] == max)
+			reduced = tParallel::max(col, n);
+		else if (c > 0 && src[c-1] == min)
+			reduced = tParallel::min(col, n);
+		else
+			reduced = tParallel::sum(col, n);
+		memcpy(col, reduced, n*sizeof(double));
+		delete [] reduced;
+	}
+#endif
+
+	if (store == NULL)
+		openStore();
+	if (store)
+		store->writeBlock(base, n, &values[0]);
+
+	// Shift the open steps to the start of the arrays
+	keep = limit - n;
+	getColumns(cols);
+	for (int c = 0; c < kNumColumns; c++) {
+		double *col = *cols[c];
+		memmove(col, col + n, keep*sizeof(double));
+		for (int i = keep; i < limit; i++)
+			col[i] = (col == min) ? 9999.99 : 0.0;
+	}
+	memmove(fState, fState + n, keep*sizeof(int));
+	for (int i = keep; i < limit; i++)
+		fState[i] = 0;
+
+	base += n;
+	return;
+}
+
 /***************************************************************************
 **
 ** tFlowResults::writeRestart() Function
@@ -1246,6 +1345,9 @@ void tFlowResults::writeRestart(fstream & rStr) const
     BinaryWrite(rStr, Perc[i]); //ASM Percolation option
     BinaryWrite(rStr, qunsat[i]); // CJC2025
   }
+
+  // Result step of the first entry, 0 unless OPTHYDROBINARY is on
+  BinaryWrite(rStr, base);
 }
 
 /***************************************************************************
@@ -1256,7 +1358,13 @@ void tFlowResults::writeRestart(fstream & rStr) const
 
 void tFlowResults::readRestart(fstream & rStr)
 {
-  BinaryRead(rStr, limit);
+  int entries;
+
+  BinaryRead(rStr, entries);
+  if (optStore)
+    resizeResults(entries);
+  else
+    limit = entries;
   BinaryRead(rStr, iimax);
   BinaryRead(rStr, ribsOutput);
   BinaryRead(rStr, writeFlag);
@@ -1302,6 +1410,15 @@ void tFlowResults::readRestart(fstream & rStr)
     BinaryRead(rStr, Perc[i]); //ASM Percolationoption
     BinaryRead(rStr, qunsat[i]); // CJC2025
   }
+
+  // Without the binary store the entries must start at the first step
+  BinaryRead(rStr, base);
+  if (!optStore && base != 0) {
+    cout<<"\nError: The restart file was written with OPTHYDROBINARY = 1,"
+        <<" the results before step "<<base<<" are only in its store"<<endl;
+    cout<<"Exiting Program..."<<endl;
+    exit(2);
+  }
 }
 
 //=========================================================================
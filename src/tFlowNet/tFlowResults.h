@@ -15,6 +15,15 @@
 **  and assigning values corresponding outputInterval in tRunTimer. It also
 **  deals with runoff types.
 **
+**  All result arrays are columns of one allocation. With the optional
+**  keyword OPTHYDROBINARY = 1 the arrays only cover the result steps that
+**  are still open (base to the maximum travel time ahead): completed steps
+**  are appended in blocks to the binary store <OUTHYDROFILENAME>.hts
+**  (see tHydroStore) and dropped, so memory does not grow with the
+**  length of the run. The *.mrf and *.rft files are then not written
+**  during the run; src/utilities/HydroStoreExport.cpp produces them
+**  from the store.
+**
 ***************************************************************************/
 
 #ifndef TFLOWRESULTS_H
@@ -31,6 +40,7 @@
 #include "src/tSimulator/tRunTimer.h"
 #include "src/tSimulator/tControl.h"
 #include "src/tInOut/tInputFile.h"
+#include "src/tFlowNet/tHydroStore.h"
 #include "src/Headers/Definitions.h"
 
 #ifdef ALPHA_64
@@ -91,6 +101,8 @@ public:
 
   int     limit;   		       // Size of results array 
   int     iimax;   		       // Last non-zero of results array
+  int     base;                        // Result step of the first entry
+  int     optStore;                    // Binary store option
   int     ribsOutput;                  // Compatibility with RIBS interphase
   int     writeFlag;                   // Flag for writing *.mrf header
   int     count;
@@ -136,6 +148,9 @@ public:
 
   int *fState;                  // Forecast state
 
+  double *block;                // Storage of the double arrays above
+  tHydroStore *store;           // Binary time series store
+
   int   checkForecast();
   void  SetFlowResVariables(tInputFile &, double); 
   void  writeAndUpdate(double, int);
@@ -152,18 +167,21 @@ public:
   void  store_volume(double, double);          
   void  store_volume_Type(double, double, int); 
   void  add_m_volume_Type(double, int, int); 
+  void  advance();
+  void  flushStore(int);
+  void  resizeResults(int);
 
   void  add_m_volume(double value, int iStep)   
-    { mhydro[iStep]+= value/timer->getOutputIntervalSec(); } 
+    { mhydro[iStep-base]+= value/timer->getOutputIntervalSec(); } 
 
   double get_discharge(int ihour)
-    {  return phydro[ihour]+mhydro[ihour]; }
+    {  return phydro[ihour-base]+mhydro[ihour-base]; }
 
   double get_discharge(double time) 
   { 
         int ihour;
         ihour=timer->getResStep(time); 
-        return phydro[ihour]+mhydro[ihour]; 
+        return phydro[ihour-base]+mhydro[ihour-base]; 
   }
 
   void reset_meas_hyd()
@@ -175,10 +193,17 @@ public:
    
 
   void update_prev_hyd()
-    { for(int ii=0; ii < iimax; ii++) phydro[ii]+=mhydro[ii]; }
+    { for(int ii=0; ii < iimax-base; ii++) phydro[ii]+=mhydro[ii]; }
 
   void writeRestart(fstream &) const;
   void readRestart(fstream &);
+
+private:
+  static const int kNumColumns = 36;     // Double arrays in block
+  static const int kStoreBlock = 256;    // Result steps per store block
+
+  void getColumns(double **[]);
+  void openStore();
 };
 
 #endif
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tHydroStore.cpp: Functions for class tHydroStore (see tHydroStore.h)
+**
+***************************************************************************/
+
+#include "src/tFlowNet/tHydroStore.h"
+#include "src/Headers/globalFns.h"
+
+#include <cstring>
+#include <unistd.h>
+
+using namespace std;
+
+static const char kStoreTag[8] = { 't','R','I','B','S','H','T','S' };
+static const int kStoreVersion = 1;
+
+tHydroStore::tHydroStore()
+  : startHour(0.0), interval(1.0)
+{}
+
+tHydroStore::~tHydroStore()
+{
+  close();
+}
+
+/***************************************************************************
+**
+**  tHydroStore::create()
+**
+**  Opens a new store and writes the header. Returns 0 if the file can
+**  not be opened.
+**
+***************************************************************************/
+int tHydroStore::create(const char *name, double start, double dt,
+                        const vector<string> &colNames,
+                        const vector<string> &colUnits)
+{
+  int n, len;
+
+  close();
+  file.open(name, ios::out | ios::trunc | ios::binary);
+  if (!file.good())
+    return 0;
+
+  names = colNames;
+  units = colUnits;
+  startHour = start;
+  interval = dt;
+
+  n = (int)names.size();
+  file.write(kStoreTag, sizeof(kStoreTag));
+  BinaryWrite(file, kStoreVersion);
+  BinaryWrite(file, n);
+  BinaryWrite(file, startHour);
+  BinaryWrite(file, interval);
+  for (int c = 0; c < n; c++) {
+    len = (int)names[c].size();
+    BinaryWrite(file, len);
+    file.write(names[c].data(), len);
+    len = (int)units[c].size();
+    BinaryWrite(file, len);
+    file.write(units[c].data(), len);
+  }
+  return 1;
+}
+
+/***************************************************************************
+**
+**  tHydroStore::writeBlock()
+**
+**  Appends the 'n' steps starting at 'first'; 'values' holds the n
+**  steps of the first column, then those of the second column, etc.
+**
+***************************************************************************/
+void tHydroStore::writeBlock(int first, int n, const double *values)
+{
+  if (!file.is_open() || n <= 0)
+    return;
+  BinaryWrite(file, first);
+  BinaryWrite(file, n);
+  file.write(reinterpret_cast<const char*>(values),
+             (streamsize)n * names.size() * sizeof(double));
+  file.flush();
+}
+
+void tHydroStore::close()
+{
+  if (file.is_open())
+    file.close();
+  file.clear();
+}
+
+/***************************************************************************
+**
+**  tHydroStore::open()
+**
+**  Opens a store for reading and reads the header. Returns 0 if the file
+**  can not be opened or is not a store.
+**
+***************************************************************************/
+int tHydroStore::open(const char *name)
+{
+  close();
+  file.open(name, ios::in | ios::binary);
+  if (!file.good())
+    return 0;
+  if (!readHeader()) {
+    close();
+    return 0;
+  }
+  return 1;
+}
+
+/***************************************************************************
+**
+**  tHydroStore::append()
+**
+**  Opens the store of a run continued from a restart file for writing.
+**  The store is kept if its header matches the arguments: the blocks of
+**  steps before 'next' are kept, later ones (written after the restart
+**  file) are removed and the blocks of the run follow. Returns 0 if there
+**  is no such store.
+**
+***************************************************************************/
+int tHydroStore::append(const char *name, double start, double dt,
+                        const vector<string> &colNames,
+                        const vector<string> &colUnits, int next)
+{
+  streamoff keep;
+  int first, n;
+  size_t nCol;
+
+  close();
+  file.open(name, ios::in | ios::binary);
+  if (!file.good() || !readHeader() || names != colNames ||
+      units != colUnits || startHour != start || interval != dt) {
+    close();
+    return 0;
+  }
+
+  // Keep the blocks before 'next', and the steps before 'next' of a
+  // block that holds it
+  nCol = names.size();
+  vector<double> values, part;
+  keep = file.tellg();
+  while (BinaryRead(file, first) && BinaryRead(file, n) && n >= 0 &&
+         first < next) {
+    values.resize((size_t)n*nCol);
+    file.read(reinterpret_cast<char*>(values.data()),
+              (streamsize)values.size()*sizeof(double));
+    if (!file.good())
+      break;
+    if (first + n > next) {
+      int m = next - first;
+      part.resize((size_t)m*nCol);
+      for (size_t c = 0; c < nCol; c++)
+        memcpy(&part[c*m], &values[c*n], m*sizeof(double));
+      break;
+    }
+    keep = file.tellg();
+  }
+  close();
+
+  if (truncate(name, (off_t)keep) != 0)
+    return 0;
+  file.open(name, ios::out | ios::app | ios::binary);
+  if (!file.good())
+    return 0;
+  if (!part.empty())
+    writeBlock(first, next - first, part.data());
+  return 1;
+}
+
+/***************************************************************************
+**
+**  tHydroStore::readHeader()
+**
+**  Reads the header of the open file. Returns 0 if it is not a store.
+**
+***************************************************************************/
+int tHydroStore::readHeader()
+{
+  char tag[sizeof(kStoreTag)];
+  int version, n, len;
+
+  file.read(tag, sizeof(tag));
+  BinaryRead(file, version);
+  BinaryRead(file, n);
+  if (!file.good() || memcmp(tag, kStoreTag, sizeof(tag)) != 0 ||
+      version != kStoreVersion || n < 0)
+    return 0;
+  BinaryRead(file, startHour);
+  BinaryRead(file, interval);
+
+  names.assign(n, string());
+  units.assign(n, string());
+  for (int c = 0; c < n; c++) {
+    BinaryRead(file, len);
+    names[c].resize(len);
+    file.read(&names[c][0], len);
+    BinaryRead(file, len);
+    units[c].resize(len);
+    file.read(&units[c][0], len);
+  }
+  return file.good() ? 1 : 0;
+}
+
+/***************************************************************************
+**
+**  tHydroStore::readBlock()
+**
+**  Reads the next block into 'values' (column by column, as written).
+**  Returns 0 at the end of the file.
+**
+***************************************************************************/
+int tHydroStore::readBlock(int &first, int &n, vector<double> &values)
+{
+  if (!file.is_open())
+    return 0;
+  if (!BinaryRead(file, first) || !BinaryRead(file, n) || n < 0)
+    return 0;
+  values.resize((size_t)n * names.size());
+  file.read(reinterpret_cast<char*>(values.data()),
+            (streamsize)values.size() * sizeof(double));
+  return file.good() ? 1 : 0;
+}
+
+int tHydroStore::findColumn(const char *name) const
+{
+  for (int c = 0; c < (int)names.size(); c++)
+    if (names[c] == name)
+      return c;
+  return -1;
+}
+
+/***************************************************************************
+**
+**  tHydroStore::stepTime()
+**
+**  Hour and minute of the end of result step 'step' (the time stamp of
+**  tRunTimer::res_time_begin(step+1))
+**
+***************************************************************************/
+void tHydroStore::stepTime(int step, int *ihour, int *imin) const
+{
+  double t_hour = (double)(step + 1)*interval + startHour;
+  *ihour = (int)t_hour;
+  *imin = (int)((t_hour - (double)(*ihour))*60. + .5);
+}
+
+//=========================================================================
+//
+//
+//                          End of tHydroStore.cpp
+//
+//
+//=========================================================================
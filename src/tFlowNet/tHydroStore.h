@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tHydroStore.h: Header for tHydroStore class
+**
+**  tHydroStore writes and reads the binary time series store of the basin
+**  outlet (hydrograph, runoff types and basin averages of tFlowResults).
+**  The file holds a header followed by blocks of consecutive result
+**  steps, each block written column by column:
+**
+**    char[8]  "tRIBSHTS"
+**    int      version, number of columns
+**    double   start hour, result step length (hours)
+**    per column: int length, name; int length, unit
+**    per block:  int first step, int number of steps n,
+**                then n doubles of each column in turn
+**
+**  A restarted run appends to the store of the run it continues (see
+**  append()). A step is stamped with the end of its result interval, as
+**  in the *.mrf and *.rft files (src/utilities/HydroStoreExport.cpp converts
+**  a store to these files).
+**
+***************************************************************************/
+
+#ifndef THYDROSTORE_H
+#define THYDROSTORE_H
+
+//=========================================================================
+//
+//
+//                  Section 1: tHydroStore Include and Define Statements
+//
+//
+//=========================================================================
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+//=========================================================================
+//
+//
+//                  Section 2: tHydroStore Class Definitions
+//
+//
+//=========================================================================
+
+class tHydroStore
+{
+public:
+  tHydroStore();
+  ~tHydroStore();
+
+  // Writing
+  int  create(const char *, double, double,
+              const std::vector<std::string> &,
+              const std::vector<std::string> &);
+  int  append(const char *, double, double,
+              const std::vector<std::string> &,
+              const std::vector<std::string> &, int);
+  void writeBlock(int, int, const double *);   // Values column by column
+  void close();
+
+  // Reading
+  int  open(const char *);
+  int  readBlock(int &, int &, std::vector<double> &);
+
+  int    getNumColumns() const           { return (int)names.size(); }
+  const  std::string &getName(int c) const { return names[c]; }
+  const  std::string &getUnit(int c) const { return units[c]; }
+  int    findColumn(const char *) const;
+  double getStartHour() const            { return startHour; }
+  double getInterval() const             { return interval; }
+  void   stepTime(int, int *, int *) const; // End of step (hour, minute)
+
+private:
+  int readHeader();
+
+  std::fstream file;
+  std::vector<std::string> names;
+  std::vector<std::string> units;
+  double startHour;
+  double interval;
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tHydroStore.h
+//
+//
+//=========================================================================
@@ -15,7 +15,10 @@
 ***************************************************************************/
 
 #include "src/tFlowNet/tKinemat.h"
+#include "src/Mathutil/bandSolver.h"
 #include "src/Headers/globalIO.h"
+#include "src/tThreadPool/tThreadPool.h"
+#include <map>
 
 #ifdef PARALLEL_TRIBS
 #include "src/tGraph/tGraph.h"
@@ -52,6 +55,27 @@ tKinemat::tKinemat(SimulationControl *sPtr, tMesh<tCNode> *gridRef, tInputFile &
     cHead = cOutlet = nullptr;
     TimeSteps = 0;    // Time steps elapsed
     qit = Qin = H0 = Qout = dt = 0;
+    worker = 0;
+    OutletQstrm = 0.0;
+    nAlloc = 0;
+    kwX = kwX1 = kwXR = kwF = kwGrad = kwA = kwB = kwC = kwXFK2 = NULL;
+    bandA = bandAl = NULL;
+    bandIndx = NULL;
+    geometry = new tReachGeometry;
+    geometry->dt = -1.0;
+    geometry->maxSize = 0;
+    stats = new tReachStats;
+    lsBacktracks = 0;
+
+    // Write the Newton solver counters of the reaches (0: no, 1: yes)
+    if (infile.IsItemIn("OPTROUTINGSTATS"))
+        statsOption = infile.ReadItem(statsOption, "OPTROUTINGSTATS");
+    else
+        statsOption = 0;
+    if (statsOption == 1) {
+        infile.ReadItem(statsName, "OUTHYDROFILENAME");
+        strcat(statsName, "_routing.stats");
+    }
 
     ChannelConduc = TransientConduc = reis1 = Pchannel = Preach = 0.0; //ASM 2/8/2017
     CountLimit = Count = 0; //ASM
@@ -133,15 +157,17 @@ tKinemat::tKinemat(SimulationControl *sPtr, tMesh<tCNode> *gridRef, tInputFile &
         theOFStream << "1-Time,hr\t " << "2-Qstrm,m3/s\t" << "3-Hlev,m" << "\n";
 #endif
 
-    // Allocate memory for stacks in stream nodes
+    // Allocate the travel queues of stream nodes, with room for the
+    // Reff intervals of the maximum travel time [hours]
+    int nBins = (int) ceil(maxttime / dtReff) + 2;
     tCNode *cn;
     tMeshListIter<tCNode> nodIter(gridPtr->getNodeList());
     for (cn = nodIter.FirstP(); nodIter.IsActive(); cn = nodIter.NextP()) {
         if (cn->getBoundaryFlag() == kStream) {
-            cn->allocDataStack();
+            cn->allocDataStack(nBins);
         }
     }
-    OutletNode->allocDataStack();
+    OutletNode->allocDataStack(nBins);
 
     /******* Edits by JECR 2015 Start ******/  
     optres = 0;
@@ -166,6 +192,51 @@ tKinemat::tKinemat(SimulationControl *sPtr, tMesh<tCNode> *gridRef, tInputFile &
     /******** Edits by JECR 2015 End *******/
 
 }
+
+/****************************************************************************
+**
+**  tKinemat::tKinemat(tKinemat *master)
+**
+**  Constructor for the worker objects of the threaded routing. A worker
+**  only holds the arrays and intermediate values of the reach it routes;
+**  it shares the nodes, timer and outlet levels of the master object and
+**  takes the channel parameters from SetWorkerParameters().
+**
+*****************************************************************************/
+tKinemat::tKinemat(tKinemat *master)
+        : tFlowNet(), ais(NULL), bis(NULL), his(NULL), reis(NULL), siis(NULL),
+          rifis(NULL), sumis(NULL), C(NULL), Y1(NULL), Y2(NULL), Y3(NULL),
+          clis(NULL) {
+
+    simCtrl = master->simCtrl;
+    tFlowNet::simCtrl = master->simCtrl;
+    timer = master->timer;
+    OutletNode = master->OutletNode;
+    OutletHlev = master->OutletHlev;
+
+    n = m = m1 = id = 0;
+    cHead = cOutlet = nullptr;
+    TimeSteps = 0;
+    qit = Qin = H0 = Qout = dt = 0;
+    Pchannel = Preach = TotChanLength = ParallelPerc = 0.0;
+    CountLimit = Count = 0;
+    NodeLoss = NULL;
+    worker = 1;
+    OutletQstrm = 0.0;
+    nAlloc = 0;
+    kwX = kwX1 = kwXR = kwF = kwGrad = kwA = kwB = kwC = kwXFK2 = NULL;
+    bandA = bandAl = NULL;
+    bandIndx = NULL;
+    geometry = master->geometry;
+    stats = master->stats;
+    statsOption = 0;
+    lsBacktracks = 0;
+
+    // Reservoirs are always routed by the master (see UseThreads)
+    optres = 0;
+    LevelPool.reservoirTypes = nullptr;
+    LevelPool.reservoirNodes = nullptr;
+}
 //
 // /****************************************************************************
 //**
@@ -251,6 +322,17 @@ tKinemat::tKinemat(SimulationControl *sPtr, tMesh<tCNode> *gridRef, tInputFile &
 *****************************************************************************/
 tKinemat::~tKinemat() {
     FreeMemory();
+    for (size_t t = 0; t < workers.size(); t++)
+        delete workers[t];
+
+    // Outlet levels, output files and stacks belong to the master
+    if (worker)
+        return;
+
+    if (statsOption == 1)
+        WriteRoutingStats();
+    delete geometry;
+    delete stats;
     delete[] OutletHlev;
 #ifdef PARALLEL_TRIBS
                                                                                                                             // The theOFStream only exists on the
@@ -261,7 +343,7 @@ tKinemat::~tKinemat() {
     ControlOut.close();
     GeomtFile.close();
 
-    // Deallocate memory for stacks in stream nodes //WR debug
+    // Deallocate the travel queues of stream nodes //WR debug
     tCNode *cn;
     tMeshListIter<tCNode> nodIter(gridPtr->getNodeList());
     for (cn = nodIter.FirstP(); nodIter.IsActive(); cn = nodIter.NextP()) {
@@ -287,8 +369,6 @@ void tKinemat::UpdateForNewRun(tInputFile &infile, int keep) {
     char fullName2[kMaxNameSize + 20];
 
     tCNode *cn;
-    tList<int> *TimeInd;  // Ptr to Time steps stack
-    tList<double> *Qeff;     // Ptr to Qeff stack
     tMeshListIter<tCNode> nodIter(gridPtr->getNodeList());
 
     n = m = m1 = 0;
@@ -316,6 +396,9 @@ void tKinemat::UpdateForNewRun(tInputFile &infile, int keep) {
         AssignChannelWidths(infile);
     }
 
+    // Widths and roughness may have changed: recompute reach geometry
+    geometry->reachPtr.clear();
+
     // Close the file and then re-open it
     ControlOut.close();
 
@@ -362,20 +445,14 @@ void tKinemat::UpdateForNewRun(tInputFile &infile, int keep) {
                 cn->setQstrm(0.0);
                 cn->percOccur = 0.0; //ASM set initial percOccur to 0
 
-                // Flush memory for stacks in stream nodes
-                TimeInd = cn->getTimeIndList();
-                Qeff = cn->getQeffList();
-                TimeInd->Flush();
-                Qeff->Flush();
+                // Clear the travel queues of stream nodes
+                cn->getTravelQueue()->clear();
             }
         }
         // Do the same for the basin outlet
         OutletNode->setHlevel(0.0);
         OutletNode->setQstrm(0.0);
-        TimeInd = OutletNode->getTimeIndList();
-        Qeff = OutletNode->getQeffList();
-        TimeInd->Flush();
-        Qeff->Flush();
+        OutletNode->getTravelQueue()->clear();
     }
     return;
 }
@@ -645,44 +722,71 @@ void tKinemat::AssignChannelWidths(tInputFile &infile) {
 **
 **  tKinemat::AllocateMemory
 **
-**  Allocates memory for all arrays used in the kinematic routing
+**  Allocates memory for all arrays used in the kinematic routing of a
+**  reach with up to NN nodes. The arrays are kept from reach to reach and
+**  from step to step; they are only reallocated if a longer reach comes.
 **
 *****************************************************************************/
 void tKinemat::AllocateMemory(int NN) {
-    n = NN;
-    bis = new double[n];
+    if (NN <= nAlloc)
+        return;
+    FreeMemory();
+    nAlloc = NN;
+
+    bis = new double[NN];
     assert(bis != 0);
-    his = new double[n];
+    his = new double[NN];
     assert(his != 0);
-    reis = new double[n];
+    reis = new double[NN];
     assert(reis != 0);
-    clis = new double[n];    // ASM 2/10/2017 (2 lines)
+    clis = new double[NN];    // ASM 2/10/2017 (2 lines)
     assert(clis != 0);
-    NodeLoss = new double[n]; // ASM 2/17/17 (2 lines)
+    NodeLoss = new double[NN]; // ASM 2/17/17 (2 lines)
     assert(NodeLoss != 0);
 
     // The following three vectors contain information only for stream
     // links (n-1) in total but it is more convenient to use size 'n' instead
 
-    ais = new double[n];    // It's n, not n-1
+    ais = new double[NN];    // It's n, not n-1
     assert(ais != 0);
-    siis = new double[n];   // It's n, not n-1
+    siis = new double[NN];   // It's n, not n-1
     assert(siis != 0);
-    rifis = new double[n];  // It's n, not n-1
+    rifis = new double[NN];  // It's n, not n-1
     assert(rifis != 0);
 
-    sumis = new double[n - 1];
+    // Sizes n-1 and n-2 are enough for sumis, Y1, Y2, Y3
+    sumis = new double[NN];
     assert(sumis != 0);
 
-    C = new double[n];
+    C = new double[NN];
     assert(C != 0);
-    Y1 = new double[n - 2];
+    Y1 = new double[NN];
     assert(Y1 != 0);
-    Y2 = new double[n - 1];
+    Y2 = new double[NN];
     assert(Y2 != 0);
-    Y3 = new double[n - 1];
+    Y3 = new double[NN];
     assert(Y3 != 0);
 
+    // Newton solver: levels, residuals, gradient, Jacobian diagonals
+    kwX = new double[NN];
+    kwX1 = new double[NN];
+    kwXR = new double[NN];
+    kwF = new double[NN];
+    kwGrad = new double[NN];
+    kwA = new double[NN];
+    kwB = new double[NN];
+    kwC = new double[NN];
+    kwXFK2 = new double[NN];
+    assert(kwX != 0 && kwX1 != 0 && kwXR != 0 && kwF != 0 && kwGrad != 0);
+    assert(kwA != 0 && kwB != 0 && kwC != 0 && kwXFK2 != 0);
+
+    // Compact tridiagonal matrix (rows of 4) and lower LU factor (rows
+    // of 2), row by row with indices from 1 (see SolveLinearSystem)
+    bandA = new double[4 * (NN + 1)];
+    bandAl = new double[2 * (NN + 1)];
+    bandIndx = new unsigned long[NN + 1];
+    assert(bandA != 0 && bandAl != 0 && bandIndx != 0);
+
     return;
 }
 
@@ -722,6 +826,128 @@ void tKinemat::FreeMemory() {
     clis = NULL; // ASM 2/10/2017
     NodeLoss = nullptr;
 
+    delete[] kwX;
+    delete[] kwX1;
+    delete[] kwXR;
+    delete[] kwF;
+    delete[] kwGrad;
+    delete[] kwA;
+    delete[] kwB;
+    delete[] kwC;
+    delete[] kwXFK2;
+    kwX = kwX1 = kwXR = kwF = kwGrad = kwA = kwB = kwC = kwXFK2 = NULL;
+
+    delete[] bandA;
+    delete[] bandAl;
+    delete[] bandIndx;
+    bandA = bandAl = NULL;
+    bandIndx = NULL;
+
+    nAlloc = 0;
+    return;
+}
+
+/*****************************************************************************
+**
+**  tKinemat::SetReachGeometry
+**
+**  Stores the channel widths, lengths and slopes of all stream reaches
+**  the first time it is called (or after UpdateForNewRun) and computes the
+**  coefficient arrays C, Y1, Y2, Y3 of all reaches whenever the time step
+**  'dt' differs from the one they were computed for. InitializeStreamReach
+**  then only copies them into the workspace.
+**
+*****************************************************************************/
+void tKinemat::SetReachGeometry() {
+    tReachGeometry &g = *geometry;
+    tPtrListIter<tCNode> HeadIter(NodesLstH);
+    tPtrListIter<tCNode> OutletIter(NodesLstO);
+    tListIter<int> NNodesIter(NNodes);
+    tCNode *cmove;
+    double Slope;
+    int i, r, p;
+
+    if (g.reachPtr.empty()) {
+        g.reachPtr.assign(1, 0);
+        g.maxSize = 0;
+        for (NNodesIter.First(); !(NNodesIter.AtEnd()); NNodesIter.Next()) {
+            g.reachPtr.push_back(g.reachPtr.back() + NNodesIter.DatRef());
+            g.maxSize = max(g.maxSize, NNodesIter.DatRef());
+        }
+        g.nodeWidth.assign(g.reachPtr.back(), 0.0);
+        g.width.assign(g.reachPtr.back(), 0.0);
+        g.length.assign(g.reachPtr.back(), 0.0);
+        g.slope.assign(g.reachPtr.back(), 0.0);
+        g.C.assign(g.reachPtr.back(), 0.0);
+        g.Y1.assign(g.reachPtr.back(), 0.0);
+        g.Y2.assign(g.reachPtr.back(), 0.0);
+        g.Y3.assign(g.reachPtr.back(), 0.0);
+
+        // Same approximations of the slopes as in the original
+        // InitializeStreamReach(): "error" slope = 0.5ft/30m = 0.152/30
+        for (HeadIter.First(), OutletIter.First(), r = 0;
+             !(HeadIter.AtEnd());
+             HeadIter.Next(), OutletIter.Next(), r++) {
+            p = g.reachPtr[r];
+            cmove = HeadIter.DatPtr();
+
+            i = 0;
+            g.slope[p] = cmove->getFlowEdg()->getSlope();
+            if (g.slope[p] <= 0)
+                g.slope[p] = 0.0050667;
+
+            while (cmove != OutletIter.DatPtr()) {
+                g.nodeWidth[p + i] = cmove->getChannelWidth();
+                g.length[p + i] = cmove->getFlowEdg()->getLength();
+                Slope = cmove->getFlowEdg()->getSlope();
+                if (Slope <= 0)
+                    g.slope[p + i + 1] = 0.0050667;
+                else
+                    g.slope[p + i + 1] = Slope;
+                cmove = cmove->getDownstrmNbr();
+                i++;
+            }
+            g.nodeWidth[p + i] = cmove->getChannelWidth();
+
+            // Use uniform width if desired
+            for (i = p; i < g.reachPtr[r + 1]; i++)
+                g.width[i] = (Width > 0.) ? Width : g.nodeWidth[i];
+        }
+        g.dt = -1.0;
+
+        int nr = (int) g.reachPtr.size() - 1;
+        stats->solves.assign(nr, 0);
+        stats->iterations.assign(nr, 0);
+        stats->backtracks.assign(nr, 0);
+        stats->failures.assign(nr, 0);
+        stats->maxIterations.assign(nr, 0);
+    }
+
+    if (g.dt != dt) {
+        AllocateMemory(g.maxSize);
+        for (r = 0; r < (int) g.reachPtr.size() - 1; r++) {
+            p = g.reachPtr[r];
+            n = g.reachPtr[r + 1] - p;
+            m = n - 1;
+            m1 = n - 2;
+            for (i = 0; i < n; i++) {
+                ais[i] = g.length[p + i];
+                bis[i] = g.width[p + i];
+                siis[i] = g.slope[p + i];
+                rifis[i] = Roughness;
+            }
+            ComputeCoefficientArrays();
+            for (i = 0; i < n; i++)
+                g.C[p + i] = C[i];
+            for (i = 0; i < m; i++) {
+                g.Y2[p + i] = Y2[i];
+                g.Y3[p + i] = Y3[i];
+            }
+            for (i = 0; i < m1; i++)
+                g.Y1[p + i] = Y1[i];
+        }
+        g.dt = dt;
+    }
     return;
 }
 
@@ -800,18 +1026,20 @@ void tKinemat::Reservoir_Routing(int Rnode) {
 **  'timeStep' is assumed to be in SECONDS
 **
 *****************************************************************************/
-void tKinemat::RunRoutingModel(int it, int *check, double timeStep) {
+void tKinemat::RunRoutingModel(int /*it*/, int *check, double timeStep) {
     tCNode *cn;
     tPtrListIter<tCNode> NodesIterO(NodesLstO);
     tPtrListIter<tCNode> NodesIterH(NodesLstH);
     tListIter<int> NNodesIter(NNodes);
-    int timerRes = 0;
     // Run hillslope routing model first
     RunHydrologicRouting();
 
 
     dt = timeStep;  // Computational time step
 
+    // Reach geometry and coefficient arrays for this dt
+    SetReachGeometry();
+
     // Update the counter for transient conditions
     if (Preach > 0.1)
         Count += 1;
@@ -824,77 +1052,316 @@ void tKinemat::RunRoutingModel(int it, int *check, double timeStep) {
     for (cn = NodesIterO.FirstP(); !(NodesIterO.AtEnd()); cn = NodesIterO.NextP())
         cn->setQstrm(0.0);
 
-    // Loop through all stream reaches id - Stream reach ID
+    // Route the reaches on threads, or loop through all stream
+    // reaches id - Stream reach ID
 
-    for (cn = NodesIterH.FirstP(), NodesIterO.First(), NNodesIter.First(), id = 0;
-         !(NodesIterH.AtEnd());
-         cn = NodesIterH.NextP(), NodesIterO.Next(), NNodesIter.Next(), id++) {
+    if (UseThreads()) {
+        RunRoutingThreaded(check);
+    } else {
+        for (cn = NodesIterH.FirstP(), NodesIterO.First(), NNodesIter.First(), id = 0;
+             !(NodesIterH.AtEnd());
+             cn = NodesIterH.NextP(), NodesIterO.Next(), NNodesIter.Next(), id++) {
 
 #ifdef GRAPH_TRIBS
-                                                                                                                                // Process only stream reaches in local partition
-    if (tGraph::inLocalPartition(id)) {
+            // Process only stream reaches in local partition
+            if (tGraph::inLocalPartition(id)) {
 #endif
 
-        // Initialize head and outlet for a current stream reach
-        cHead = NodesIterH.DatPtr();
-        cOutlet = NodesIterO.DatPtr();
+            // Initialize head and outlet for a current stream reach
+            cHead = NodesIterH.DatPtr();
+            cOutlet = NodesIterO.DatPtr();
 
-        //can calculate the number of time steps to check for transient period here ASM
-        CountLimit = TransientTime / (dt / 60);
+            RouteReach(NNodesIter.DatRef(), check);
 
-        // Initialize widths, lengths, slopes, levels, C, Y1, Y2, Y3
-        InitializeStreamReach(NNodesIter.DatRef(), CountLimit);
+#ifdef GRAPH_TRIBS
+            // End of processing stream reaches in local partition
+            }
+#endif
+        }
+    }
 
-        // Initialize lateral influx array
-        AssignLateralInflux();
+    // Close file with reach info
+    if (TimeSteps == 0) ControlOut.close();
 
-        // Initialize upper BND condition
-        AssignQin();
+    TimeSteps++;
+    return;
+}
 
-        // Check Reservoir Option
-        if (optres == 1) {
-            Reservoir_Routing(cn->getID()); // JECR 2015
-        }
+/*****************************************************************************
+**
+**  tKinemat::RouteReach
+**
+**  Routes the stream reach from 'cHead' to 'cOutlet' with 'NN' nodes and
+**  reach ID 'id' over one time step
+**
+*****************************************************************************/
+void tKinemat::RouteReach(int NN, int *check) {
 
+    //can calculate the number of time steps to check for transient period here ASM
+    CountLimit = TransientTime / (dt / 60);
 
-        // Assign reach percolation to total channel percolation ASM 2/10/2017
-        Pchannel += Preach;
+    // Initialize widths, lengths, slopes, levels, C, Y1, Y2, Y3
+    InitializeStreamReach(NN, CountLimit);
 
-        // Run kinematic wave routing model
-        if (NNodesIter.DatRef() == 2)
-            SolveForTwoNodeReach(C, Y1, Y2, Y3, reis, his, qit, H0);
-        else
-            KinematWave(C, Y1, Y2, Y3, reis, his, qit, H0, check);
+    // Initialize lateral influx array
+    AssignLateralInflux();
 
-        // Update computed values of levels & Qs
+    // Initialize upper BND condition
+    AssignQin();
+
+    // Check Reservoir Option
+    if (optres == 1) {
+        Reservoir_Routing(cHead->getID()); // JECR 2015
+    }
+
+    // Assign reach percolation to total channel percolation ASM 2/10/2017
+    Pchannel += Preach;
+
+    // Run kinematic wave routing model
+    if (NN == 2)
+        SolveForTwoNodeReach(C, Y1, Y2, Y3, reis, his, qit, H0);
+    else
+        KinematWave(C, Y1, Y2, Y3, reis, his, qit, H0, check);
+
+    // Update computed values of levels & Qs
 
 /********************* Start of modifications by JECR 2015 **************************/
-        if ((optres == 1) && (checkNode == checkID)) {
-            Qout = LevelPool.getResDischargeOut(); // Skip ComputeQout();
-        } else {
+    if ((optres == 1) && (checkNode == checkID)) {
+        Qout = LevelPool.getResDischargeOut(); // Skip ComputeQout();
+    } else {
 /********************** End of modifications by JECR 2015 ***************************/
 
-            ComputeQout();
-        }
+        ComputeQout();
+    }
 
-        UpdateStreamVars();
+    UpdateStreamVars();
+    return;
+}
 
-        // Write control info
-        it = TimeSteps;
+/*****************************************************************************
+**
+**  tKinemat::UseThreads()
+**
+**  The reaches are routed on threads when more than one thread is
+**  available and the reach graph could be scheduled. The first time step
+**  (which writes the reach info to the control file), reservoirs and the
+**  Green-Ampt channel percolation (which updates the confluence node of
+**  the tributaries) are routed serially, as is the MPI version.
+**
+*****************************************************************************/
+int tKinemat::UseThreads() {
+#ifdef PARALLEL_TRIBS
+    return 0;
+#else
+    if (tThreadPool::getNumThreads() < 2 || TimeSteps == 0 ||
+        optres == 1 || percolationOption == 3)
+        return 0;
+    if (levelPtr.empty())
+        BuildReachSchedule();
+    return !workers.empty();
+#endif
+}
 
-        // Memory management
-        FreeMemory();
+/*****************************************************************************
+**
+**  tKinemat::BuildReachSchedule()
+**
+**  Places the stream reaches on levels of the reach graph. As in
+**  tGraph::connectivity(), the reaches upstream of a reach are those with
+**  their outlet at its head. A reach is one level above its highest
+**  upstream reach, so the reaches of a level do not depend on each other.
+**  The serial loop relies on upstream reaches coming first in the reach
+**  list; if this is not the case, the routing stays serial. One worker
+**  object (reach workspace) is created per thread.
+**
+*****************************************************************************/
+void tKinemat::BuildReachSchedule() {
+    tPtrListIter<tCNode> HeadIter(NodesLstH);
+    tPtrListIter<tCNode> OutletIter(NodesLstO);
+    tListIter<int> NNodesIter(NNodes);
+    std::map<int, int> reachAtHead;
+    int r, k, nr, nLevels;
+
+    reachHead.clear();
+    reachOutlet.clear();
+    reachSize.clear();
+    for (HeadIter.First(), OutletIter.First(), NNodesIter.First();
+         !(HeadIter.AtEnd());
+         HeadIter.Next(), OutletIter.Next(), NNodesIter.Next()) {
+        reachAtHead[HeadIter.DatPtr()->getID()] = (int) reachHead.size();
+        reachHead.push_back(HeadIter.DatPtr());
+        reachOutlet.push_back(OutletIter.DatPtr());
+        reachSize.push_back(NNodesIter.DatRef());
+    }
+    nr = (int) reachHead.size();
+
+    // Downstream reach of each reach, -1 for the basin outlet
+    vector<int> down(nr, -1);
+    int ordered = (nr > 0);
+    for (r = 0; r < nr; r++) {
+        std::map<int, int>::iterator it = reachAtHead.find(reachOutlet[r]->getID());
+        if (it != reachAtHead.end())
+            down[r] = it->second;
+        if (r < nr - 1 && down[r] <= r)
+            ordered = 0;
+        if (r == nr - 1 && (down[r] != -1 || reachOutlet[r] != OutletNode))
+            ordered = 0;
+    }
 
-#ifdef GRAPH_TRIBS
-                                                                                                                                // End of processing stream reaches in local partition
+    // An empty schedule is marked by a single level pointer
+    levelPtr.assign(1, 0);
+    if (!ordered) {
+        Cout << "tKinemat: reach list is not ordered from upstream to "
+             << "downstream, routing stays serial" << endl;
+        return;
     }
-#endif
+
+    // Upstream reaches in reach order
+    upPtr.assign(nr + 1, 0);
+    for (r = 0; r < nr; r++)
+        if (down[r] >= 0)
+            upPtr[down[r] + 1]++;
+    for (r = 0; r < nr; r++)
+        upPtr[r + 1] += upPtr[r];
+    upIdx.assign(upPtr[nr], 0);
+    vector<int> fill(upPtr.begin(), upPtr.end() - 1);
+    for (r = 0; r < nr; r++)
+        if (down[r] >= 0)
+            upIdx[fill[down[r]]++] = r;
+
+    // Levels of the reach graph
+    vector<int> level(nr, 0);
+    nLevels = 0;
+    for (r = 0; r < nr; r++) {
+        for (k = upPtr[r]; k < upPtr[r + 1]; k++)
+            level[r] = max(level[r], level[upIdx[k]] + 1);
+        nLevels = max(nLevels, level[r] + 1);
     }
+    levelPtr.assign(nLevels + 1, 0);
+    for (r = 0; r < nr; r++)
+        levelPtr[level[r] + 1]++;
+    for (k = 0; k < nLevels; k++)
+        levelPtr[k + 1] += levelPtr[k];
+    levelReach.assign(nr, 0);
+    fill.assign(levelPtr.begin(), levelPtr.end() - 1);
+    for (r = 0; r < nr; r++)
+        levelReach[fill[level[r]]++] = r;
+
+    for (int t = 0; t < tThreadPool::getNumThreads(); t++)
+        workers.push_back(new tKinemat(this));
+
+    reachCheck.assign(nr, 0);
+    reachQout.assign(nr, 0.0);
+    reachSums.assign(3 * nr, 0.0);
+
+    Cout << "tKinemat: " << nr << " reaches on " << nLevels
+         << " levels for " << workers.size() << " threads" << endl;
+}
 
-    // Close file with reach info
-    if (TimeSteps == 0) ControlOut.close();
+/*****************************************************************************
+**
+**  tKinemat::SetWorkerParameters(tKinemat *w)
+**
+**  Copies the time step and channel parameters to worker 'w'
+**
+*****************************************************************************/
+void tKinemat::SetWorkerParameters(tKinemat *w) {
+    w->dt = dt;
+    w->dtReff = dtReff;
+    w->TimeSteps = TimeSteps;
+    w->Count = Count;
+    w->Roughness = Roughness;
+    w->Width = Width;
+    w->kincoef = kincoef;
+    w->percolationOption = percolationOption;
+    w->ChannelConduc = ChannelConduc;
+    w->TransientConduc = TransientConduc;
+    w->TransientTime = TransientTime;
+    w->channelPorosity = channelPorosity;
+    w->PoreInd = PoreInd;
+    w->PsiB = PsiB;
+    w->IntStormMax = IntStormMax;
+}
 
-    TimeSteps++;
+/*****************************************************************************
+**
+**  tKinemat::RunRoutingThreaded
+**
+**  Routes the reaches level by level; the reaches of a level are split
+**  among the workers. A worker does not add the discharge of its reach
+**  to the outlet node. Instead, before a level is routed, the inflow at
+**  the head of each of its reaches is summed from the upstream reaches
+**  in reach order, as in the serial loop. The last reach (basin outlet)
+**  is routed by this object itself, which leaves it in the same state as
+**  after the serial loop. Channel totals are summed in reach order.
+**
+*****************************************************************************/
+void tKinemat::RunRoutingThreaded(int *check) {
+    int k, i, j, r;
+    int nr = (int) reachHead.size();
+    int last = nr - 1;
+
+    for (size_t t = 0; t < workers.size(); t++)
+        SetWorkerParameters(workers[t]);
+
+    auto route = [this](tKinemat *kin, int rid) {
+        kin->id = rid;
+        kin->cHead = reachHead[rid];
+        kin->cOutlet = reachOutlet[rid];
+        kin->Pchannel = kin->TotChanLength = kin->ParallelPerc = 0.0;
+        kin->RouteReach(reachSize[rid], &reachCheck[rid]);
+        reachQout[rid] = kin->OutletQstrm;
+        reachSums[3 * rid] = kin->Preach;
+        reachSums[3 * rid + 1] = kin->TotChanLength;
+        reachSums[3 * rid + 2] = kin->ParallelPerc;
+    };
+
+    double pchannel = Pchannel;
+    double totChanLength = TotChanLength;
+    double parallelPerc = ParallelPerc;
+
+    for (k = 0; k < (int) levelPtr.size() - 1; k++) {
+
+        // Confluence inflows from the upstream reaches, in reach order
+        for (i = levelPtr[k]; i < levelPtr[k + 1]; i++) {
+            r = levelReach[i];
+            if (upPtr[r] < upPtr[r + 1]) {
+                reachHead[r]->setQstrm(0.0);
+                for (j = upPtr[r]; j < upPtr[r + 1]; j++)
+                    reachHead[r]->addQstrm(reachQout[upIdx[j]]);
+            }
+        }
+
+        int end = levelPtr[k + 1];
+        if (levelReach[end - 1] == last)
+            end--;
+
+        tThreadPool::parallelFor(levelPtr[k], end,
+            [&](int first, int stop, int t) {
+                for (int l = first; l < stop; l++)
+                    route(workers[t], levelReach[l]);
+            });
+
+        if (end < levelPtr[k + 1])
+            route(this, last);
+    }
+
+    for (r = 0; r < nr; r++) {
+        pchannel += reachSums[3 * r];
+        totChanLength += reachSums[3 * r + 1];
+        parallelPerc += reachSums[3 * r + 2];
+    }
+    Pchannel = pchannel;
+    TotChanLength = totChanLength;
+    ParallelPerc = parallelPerc;
+
+    // Status of the last reach solved with KinematWave()
+    for (r = last; r >= 0; r--) {
+        if (reachSize[r] > 2) {
+            *check = reachCheck[r];
+            break;
+        }
+    }
     return;
 }
 
@@ -913,18 +1380,13 @@ void tKinemat::RunRoutingModel(int it, int *check, double timeStep) {
 **       will show up in the stream node according to the set velocities
 **     - Get the generated runoff volume
 **     * Do the same for a _Stream_ node assuming zero travel time
-**     - Store the volume in an appropriate place in stack
-**       through the stream node stack
+**     - Add the volume to the bin of its Reff interval in the travel
+**       queue of the stream node
 **
 *****************************************************************************/
 void tKinemat::RunHydrologicRouting() {
     tCNode *cn;
-    tList<int> *TimeInd;  // Ptr to Time steps stack
-    tList<double> *Qeff;     // Ptr to Qeff stack
-    tListIter<int> IndIter;
-    tListIter<double> QIter;
-    tListNode<int> *indx;
-    tListNode<double> *Qvalue;
+    tTravelQueue *Travel = 0;  // Ptr to travel queue of the stream node
 
     tMeshListIter<tCNode> nodIter(gridPtr->getNodeList());
 
@@ -991,9 +1453,8 @@ void tKinemat::RunHydrologicRouting() {
                     vRunoff /= (dtReff * 3600.);
                 }
 
-                // Get appropriate lists
-                TimeInd = cn->getStreamNode()->getTimeIndList();
-                Qeff = cn->getStreamNode()->getQeffList();
+                // Get appropriate queue
+                Travel = cn->getStreamNode()->getTravelQueue();
             }
 
 
@@ -1011,60 +1472,13 @@ void tKinemat::RunHydrologicRouting() {
                     vRunoff /= ((nSStep * dtReff - timer->getCurrentTime()
                                  + timer->getTimeStep()) * 3600.);
 
-                // Get appropriate lists
-                TimeInd = cn->getTimeIndList();
-                Qeff = cn->getQeffList();
+                // Get appropriate queue
+                Travel = cn->getTravelQueue();
             }
 
-            // 3.) Now, work with the stacks
-            assert(TimeInd != 0);
-            assert(Qeff != 0);
-
-            if (TimeInd->getSize() > 0) {
-
-                // Initialize corresponding iterators
-                IndIter.Reset(*TimeInd);
-                QIter.Reset(*Qeff);
-
-                // Check First if the last is less than nSStep
-                IndIter.Last();
-                if (IndIter.DatRef() < nSStep) {
-                    TimeInd->insertAtBack(nSStep);
-                    Qeff->insertAtBack(vRunoff);
-                } else {
-                    // Start from the first element in stack
-                    // Find the one which corresponds to nSStep
-                    IndIter.First();
-                    QIter.First();
-                    while (!(IndIter.AtEnd()) && IndIter.DatRef() < nSStep) {
-                        IndIter.Next();
-                        QIter.Next();
-                    }
-
-                    // If equal, just add to it
-                    if (IndIter.DatRef() == nSStep) {
-                        *(QIter.DatPtr()) += vRunoff;
-                    }
-
-                        // Now, it is _larger_ than nSStep put
-                        // the value in the stack BEFORE
-                    else {
-                        indx = IndIter.NodePtr();
-                        Qvalue = QIter.NodePtr();
-                        TimeInd->insertAtPrev(nSStep, indx);
-                        Qeff->insertAtPrev(vRunoff, Qvalue);
-                    }
-                }
-            }
-
-                // If there are no data in stack yet
-            else {
-                TimeInd->insertAtBack(nSStep);
-                Qeff->insertAtBack(vRunoff);
-
-                // For LATER versions: to start looking for
-                // an appropriate place in stack...
-            }
+            // 3.) Add the volume to the bin of its Reff interval
+            assert(Travel != 0);
+            Travel->deposit(nSStep, vRunoff);
         } // (SRF > 0)
 
             // If runoff has not been generated update the flow field for the node
@@ -1134,64 +1548,60 @@ void tKinemat::setTravelVelocityKin(double curr_discharge, double CArea) {
 **
 *****************************************************************************/
 void tKinemat::InitializeStreamReach(int NN, int CountLimit) {
-    int i;
-    double Slope;
+    int i, p;
     tCNode *cmove, *cend;
     double ChanLength = TotWidth = 0.0; // ASM
-
-
+    double *nodeWidth;
 
     n = NN;        // # of nodes
     m = n - 1;
     m1 = n - 2;
 
-    AllocateMemory(n);
+    AllocateMemory(geometry->maxSize);
 
     maxH = maxReff = 0.0;
 
+    // Widths, lengths, slopes and coefficient arrays (see SetReachGeometry)
+    p = geometry->reachPtr[id];
+    nodeWidth = &geometry->nodeWidth[p];
+    for (i = 0; i < n; i++) {
+        ais[i] = geometry->length[p + i];
+        bis[i] = geometry->width[p + i];
+        siis[i] = geometry->slope[p + i];
+        rifis[i] = Roughness;
+        C[i] = geometry->C[p + i];
+    }
+    for (i = 0; i < m; i++) {
+        Y2[i] = geometry->Y2[p + i];
+        Y3[i] = geometry->Y3[p + i];
+    }
+    for (i = 0; i < m1; i++)
+        Y1[i] = geometry->Y1[p + i];
+
     i = 0;
     cmove = cHead;  // Points to the current stream head
     cend = cOutlet; // Point to the current outlet
 
-    // Approximate the slope for node '0' as the
-    // slope of the link downstream
-    // If the slope is < 0, approximate with the
-    // "error" slope = 0.5ft/30m = 0.152/30
-    siis[i] = cmove->getFlowEdg()->getSlope();
-    if (siis[i] <= 0)
-        siis[i] = 0.0050667;
-
     while (cmove != cend) {
         his[i] = cmove->getHlevel();
-        bis[i] = cmove->getChannelWidth();
-        ais[i] = cmove->getFlowEdg()->getLength();
-        rifis[i] = cmove->getRoughness();
         //ASM 2/9/2017
         if (percolationOption == 1) {
             //setCoeffstest(cmove);
             //poro = soilPtr->getSoilProp(9);  // Surface hydraulic conductivity
-            NodeLoss[i] = bis[i] * ais[i] * ChannelConduc * channelPorosity; // ASM testporo; w*l*poro*ksat [m3/s]
+            NodeLoss[i] = nodeWidth[i] * ais[i] * ChannelConduc * channelPorosity; // ASM testporo; w*l*poro*ksat [m3/s]
             ChanLength += ais[i]; // ASM
         } else if (percolationOption == 2) {
             // Need to get time information here
             if (Count > CountLimit - 1) {
-                NodeLoss[i] = bis[i] * ais[i] * ChannelConduc * channelPorosity;
+                NodeLoss[i] = nodeWidth[i] * ais[i] * ChannelConduc * channelPorosity;
                 ChanLength += ais[i];
             } else {
-                NodeLoss[i] = bis[i] * ais[i] * TransientConduc * channelPorosity;
+                NodeLoss[i] = nodeWidth[i] * ais[i] * TransientConduc * channelPorosity;
                 ChanLength += ais[i];
             }
         }
         //end ASM edits
 
-        Slope = cmove->getFlowEdg()->getSlope();
-
-        //"Error" slope = 0.5ft/30m = 0.152/30
-        if (Slope <= 0)
-            siis[i + 1] = 0.0050667;
-        else
-            siis[i + 1] = Slope;
-
         if (his[i] > maxH)
             maxH = his[i];
 
@@ -1206,30 +1616,9 @@ void tKinemat::InitializeStreamReach(int NN, int CountLimit) {
     // Special care has to be taken regarding the outlet nodes
     // Use the separately stored outlet level from time step (t-1)
     his[i] = OutletHlev[id];           // cmove->getHlevel();
-    bis[i] = cmove->getChannelWidth();
-    rifis[i] = cmove->getRoughness();
     if (his[i] > maxH)
         maxH = his[i];
 
-    // PARAMETERS
-    // Slope = 0.00061140520;
-    // Slope = 1.0;           // degree slope
-    // Slope = tan(Slope*(atan(1)*4)/180);
-
-    for (i = 0; i < n; i++) {
-        rifis[i] = Roughness;
-
-        // In case if uniform slope is desired
-        // siis[i]  = Slope;
-
-        // Use uniform width if desired
-        if (Width > 0.)
-            bis[i] = Width;
-    }
-
-    ComputeCoefficientArrays();
-
-
     // Output control
     if (TimeSteps == 0) {
         ControlOut << "## REACH ID = " << id + 1 << " ##" << "\n";
@@ -1499,54 +1888,26 @@ void tKinemat::AssignLateralInflux() {
 **  tKinemat::RetrieveQeff()
 **
 **  Based on the influx from hillsope, return Qeff for the current node cmove
+**  from the bin of the current Reff interval in its travel queue
 **
 *****************************************************************************/
 double tKinemat::RetrieveQeff(tCNode *cmove) {
-    int intmp;
-    double dtemp, value;
-
-    tList<int> *TimeInd;  // <-- Ptr to Time steps stack
-    tList<double> *Qeff;     // <-- Ptr to Qeff stack
-    tListIter<int> IndIter;
-    tListIter<double> QIter;
+    int nStep;
+    double value;
+    tTravelQueue *Travel;  // <-- Ptr to travel queue
 
-    intmp = -999;
-    dtemp = -999;
+    Travel = cmove->getTravelQueue();
+    if (Travel->isEmpty())
+        return 0.;
 
-    TimeInd = cmove->getTimeIndList();
+    // Average influx rate per time interval > dt
+    nStep = timer->getStepForSpecifiedDT(timer->getCurrentTime(), dtReff);
+    value = Travel->value(nStep);
 
-    // If the lists are NOT empty
-    if (!(TimeInd->isEmpty())) {
-        IndIter.Reset(*TimeInd);
-        IndIter.First();
-
-        // Average influx rate per time interval > dt
-        if (IndIter.DatRef() ==
-            timer->getStepForSpecifiedDT(timer->getCurrentTime(), dtReff)) {
-
-            Qeff = cmove->getQeffList();
-            QIter.Reset(*Qeff);
-            QIter.First();
-            value = QIter.DatRef();
-
-            // If current time is the end of Reff interval
-            if ((int) ceil(timer->getCurrentTime() / dtReff) ==
-                (int) floor(timer->getCurrentTime() / dtReff)) {
-
-                if (TimeInd->getSize() == 1) {
-                    TimeInd->Flush();
-                    Qeff->Flush();
-                }
-                    // - Or, delete the first from the stack -
-                else {
-                    TimeInd->removeFromFront(intmp);
-                    Qeff->removeFromFront(dtemp);
-                }
-            }
-        } else
-            value = 0.;
-    } else
-        value = 0.;
+    // If current time is the end of Reff interval, the bin is done
+    if ((int) ceil(timer->getCurrentTime() / dtReff) ==
+        (int) floor(timer->getCurrentTime() / dtReff))
+        Travel->release(nStep);
 
     return value;
 }
@@ -1661,7 +2022,9 @@ void tKinemat::UpdateStreamVars() {
     OutletHlev[id] = his[i];
 
     double cOutletQstrm = ComputeNodeQstrm(i);
-    cmove->addQstrm(cOutletQstrm); // 'add' not 'set'!
+    OutletQstrm = cOutletQstrm;
+    if (!worker)
+        cmove->addQstrm(cOutletQstrm); // 'add' not 'set'! (workers: see RunRoutingThreaded)
 
 #ifdef PARALLEL_TRIBS
                                                                                                                             // If downstream reaches are on other processors, send
@@ -1672,6 +2035,58 @@ void tKinemat::UpdateStreamVars() {
     return;
 }
 
+/*****************************************************************************
+**
+**  tKinemat::RecordSolve(int iters, int failed)
+**
+**  Adds a call of KinematWave() for the current reach 'id' to the solver
+**  counters: # Newton iterations, line search backtracks and whether the
+**  solve stopped without converging on the function values
+**
+*****************************************************************************/
+void tKinemat::RecordSolve(int iters, int failed) {
+    if (id < 0 || id >= (int) stats->solves.size())
+        return;
+    stats->solves[id]++;
+    stats->iterations[id] += iters;
+    stats->backtracks[id] += lsBacktracks;
+    stats->failures[id] += failed;
+    if (iters > stats->maxIterations[id])
+        stats->maxIterations[id] = iters;
+    lsBacktracks = 0;
+}
+
+/*****************************************************************************
+**
+**  tKinemat::WriteRoutingStats()
+**
+**  Writes the solver counters of all reaches to OUTHYDROFILENAME with
+**  the extension '_routing.stats'. Reaches with many iterations per solve,
+**  backtracks or failures are the stiff parts of the channel network.
+**
+*****************************************************************************/
+void tKinemat::WriteRoutingStats() {
+    tListIter<int> NNodesIter(NNodes);
+    int r;
+
+    ofstream Otp(statsName);
+    if (!Otp.good()) {
+        cout << "\nWarning: Routing statistics file " << statsName
+             << " not created..." << endl << flush;
+        return;
+    }
+    Otp << "1-ReachID\t2-Nodes\t3-Solves\t4-Iterations\t5-MaxIterations\t"
+        << "6-Backtracks\t7-Failures\n";
+    for (NNodesIter.First(), r = 0; !(NNodesIter.AtEnd()) &&
+         r < (int) stats->solves.size(); NNodesIter.Next(), r++) {
+        Otp << r + 1 << "\t" << NNodesIter.DatRef() << "\t"
+            << stats->solves[r] << "\t" << stats->iterations[r] << "\t"
+            << stats->maxIterations[r] << "\t" << stats->backtracks[r] << "\t"
+            << stats->failures[r] << "\n";
+    }
+    Otp.close();
+}
+
 /*****************************************************************************
 **
 **  tKinemat::ControlPrint()
@@ -1696,27 +2111,15 @@ void tKinemat::ControlPrint(ofstream &Otp, double *a, int NN) {
 **
 *****************************************************************************/
 void tKinemat::PrintFlowStacks(ofstream &Otp, tCNode *cmove) {
-    tList<int> *TimeInd;  // Ptr to Time steps stack
-    tList<double> *Qeff;     // Ptr to Qeff stack
-    tListIter<int> IndIter;
-    tListIter<double> QIter;
+    tTravelQueue *Travel;  // Ptr to travel queue
 
     if (cmove->getBoundaryFlag() == kStream) {
-        TimeInd = cmove->getTimeIndList();
-
-        if (!(TimeInd->isEmpty())) {
-            IndIter.Reset(*TimeInd);
-            Qeff = cmove->getQeffList();
-            QIter.Reset(*Qeff);
+        Travel = cmove->getTravelQueue();
 
+        if (!(Travel->isEmpty())) {
             Otp << "- NODE: " << cmove->getID() << " -" << endl;
-            for (IndIter.FirstP(); !(IndIter.AtEnd()); IndIter.NextP())
-                Otp << IndIter.DatRef() << " ";
+            Travel->print(Otp);
             Otp << endl;
-
-            for (QIter.First(); !(QIter.AtEnd()); QIter.Next())
-                Otp << QIter.DatRef() << " ";
-            Otp << endl << endl;
         } else
             Otp << "- NODE: " << cmove->getID() << " -\t--- ZERO STACKS ---" << endl;
     }
@@ -1795,28 +2198,21 @@ void tKinemat::KinematWave(double *c, double *y1,
     double *F, *aa, *bb, *cc, *gradf;
     double den, f, fold, stpmax, sum, temp, test;
 
-    X = new double[n];
-    assert(X != 0);
-    X1 = new double[n];
-    assert(X1 != 0);
-    XR = new double[n];
-    assert(XR != 0);
-    F = new double[n - 1];
-    assert(F != 0);
-
-    gradf = new double[n];
-    assert(gradf != 0);
+    // Buffers of the reach workspace (see AllocateMemory)
+    X = kwX;
+    X1 = kwX1;
+    XR = kwXR;
+    F = kwF;
+    gradf = kwGrad;
 
     // These will contain sparse Jacobian matrix though the actual size
     // of vectors for the problem with known upper BND condition is n-1
 
-    aa = new double[n];
-    assert(aa != 0);
-    bb = new double[n];
-    assert(bb != 0);
-    cc = new double[n];
-    assert(cc != 0);
+    aa = kwA;
+    bb = kwB;
+    cc = kwC;
 
+    lsBacktracks = 0;
 
     // Pay attention, values start from 1! Not from 0!
     for (i = 0; i < m; i++)
@@ -1842,7 +2238,8 @@ void tKinemat::KinematWave(double *c, double *y1,
     }
     if (test < 0.01 * TOLF) {
         *check = 0;
-        FREERETURN
+        RecordSolve(0, 0);
+        return;
     }
 
     for (sum = 0.0, i = 0; i < m; i++)
@@ -1895,8 +2292,9 @@ void tKinemat::KinematWave(double *c, double *y1,
         if (test < TOLF) { // TEST for convergence on function values
             *check = 0;
             UpdateHsShifted(X1, HLev, Hupp, m); // Update HLev for t=(j+1)
+            RecordSolve(ITER, 0);
 
-            FREERETURN
+            return;
         }
 
         if (*check) {      // TEST for grad(f) = zero
@@ -1909,8 +2307,9 @@ void tKinemat::KinematWave(double *c, double *y1,
             }
             *check = (test < TOLMIN ? 1 : 0);
             UpdateHsShifted(X1, HLev, Hupp, m); // <--- Update HLev for t=(j+1)
+            RecordSolve(ITER, 1);
 
-            FREERETURN
+            return;
         }
 
         test = 0.0;
@@ -1921,11 +2320,13 @@ void tKinemat::KinematWave(double *c, double *y1,
         }
         if (test < TOLX) {
             UpdateHsShifted(X1, HLev, Hupp, m); //Update HLev for t=(j+1)
+            RecordSolve(ITER, 1);
 
-            FREERETURN
+            return;
         }
     }
     cerr << "MAXITS exceeded in newt" << endl << flush;
+    RecordSolve(MAXITS, 1);
     return;
 }
 
@@ -1934,7 +2335,6 @@ void tKinemat::KinematWave(double *c, double *y1,
 #undef TOLMIN
 #undef TOLX
 #undef STPMX
-#undef FREERETURN
 
 /*****************************************************************************
 **
@@ -1959,8 +2359,7 @@ void tKinemat::ComputeFunction(double *F, double *c, double *y1,
     M = N - 1;
     M1 = N - 2;
 
-    XFK2 = new double[N];
-    assert(XFK2 != 0);
+    XFK2 = kwXFK2;
 
     for (i = 0; i < M; i++)
         XFK2[i] = pow(X[i], fk2); // levels in the power
@@ -1978,22 +2377,23 @@ void tKinemat::ComputeFunction(double *F, double *c, double *y1,
     // - 'X'    is a vector of water levels being computed for
     //          time (t+1) <--- the ones we are looking for
 
-    for (i = 0; i < M; i++) { // HLev: levels for time (t), X: time (t+1)
-        if (i == 0) {
-            F[0] = 0.5 * c[2] * XFK2[1] - Qit + y3[0] * (Hupp - HLev[0]) +
-                   y2[0] * (X[0] - HLev[1]) +
-                   y1[0] * (X[1] - HLev[2]) - Reff[0];
-        } else if (i == M1) // Changed below....
-            F[m1] = 0.5 * c[M] * XFK2[M1] - 0.5 * c[M1] * XFK2[M1 - 1] +
-                    y3[M1] * (X[M1 - 1] - HLev[M1]) +
-                    y2[M1] * (X[M1] - HLev[M]) - Reff[M1];
-        else {
-            F[i] = 0.5 * c[i + 2] * XFK2[i + 1] - 0.5 * c[i] * XFK2[i - 1] +
-                   y3[i] * (X[i - 1] - HLev[i]) + y2[i] * (X[i] - HLev[i + 1]) +
-                   y1[i] * (X[i + 1] - HLev[i + 2]) - Reff[i];
-        }
+    // HLev: levels for time (t), X: time (t+1). The first and last
+    // equations are written separately so that the loop over the
+    // interior nodes has no branches and can be vectorized.
+    F[0] = 0.5 * c[2] * XFK2[1] - Qit + y3[0] * (Hupp - HLev[0]) +
+           y2[0] * (X[0] - HLev[1]) +
+           y1[0] * (X[1] - HLev[2]) - Reff[0];
+
+    for (i = 1; i < M1; i++) {
+        F[i] = 0.5 * c[i + 2] * XFK2[i + 1] - 0.5 * c[i] * XFK2[i - 1] +
+               y3[i] * (X[i - 1] - HLev[i]) + y2[i] * (X[i] - HLev[i + 1]) +
+               y1[i] * (X[i + 1] - HLev[i + 2]) - Reff[i];
     }
-    delete[] XFK2;
+
+    if (M1 > 0)
+        F[M1] = 0.5 * c[M] * XFK2[M1] - 0.5 * c[M1] * XFK2[M1 - 1] +
+                y3[M1] * (X[M1 - 1] - HLev[M1]) +
+                y2[M1] * (X[M1] - HLev[M]) - Reff[M1];
     return;
 }
 
@@ -2074,70 +2474,41 @@ void tKinemat::ComputeJacobian(double *aa, double *bb, double *cc,
 **
 **  tKinemat::SolveLinearSystem
 **
-**  Using the two functions from Numerical Recipes 'bandec' and 'banbks'
-**  the function solves linear system of equation A*x = XR. The matrix
-**  A is sparse and is given by three vectors (diagonals) aa, bb, cc
-**  They are used to write the compact form of A - matrix a which is then
-**  used for LU decomposition.
+**  Solves the linear system of equations A*x = XR for the tridiagonal
+**  Jacobian A given by its three diagonals aa, bb, cc. A is written in
+**  the compact banded format (one row of 3 per equation, in the flat
+**  workspace array bandA) and solved by LU decomposition with partial
+**  pivoting, specialized for one sub- and one super-diagonal.
 **  The solution vector overwrites XR[1, N] -> XR[0,N-1]
 **
 *****************************************************************************/
 void tKinemat::SolveLinearSystem(double *aa, double *bb,
                                  double *cc, double *XR, int N) {
-    unsigned long *indx, i;
-    double **a, **al, d, *tt;
-
-    tt = new double[N];
-    assert(tt != 0);
-    indx = new unsigned long[N + 1];
-    assert(indx != 0);
-    al = new double *[N + 1];
-    assert(al != 0);
-    a = new double *[N + 1];
-    assert(a != 0);
-    for (i = 0; i < N + 1; i++) {
-        a[i] = new double[4];
-        assert(a[i] != 0);
-        al[i] = new double[2];
-        assert(al[i] != 0);
-    }
+    double *a = bandA;
+    unsigned long i;
 
     // Filling the matrix with aa, bb, cc, Zero-th elements are not used!
-    // (I did this only for convenience) Indices start from '1' not form '0'!
+    // Indices start from '1' not from '0'! Elements outside of the
+    // matrix are set to zero.
 
-    for (i = 0; i < 4; i++)
-        a[0][i] = 999.;  // wasted space in the compact format
-    a[1][0] = 999.;    // wasted space in the compact format
-    a[1][1] = 999.;    // wasted space in the compact format
-    a[1][2] = bb[0];
-    a[1][3] = cc[0];
+    a[4 * 1 + 1] = 0.0;
+    a[4 * 1 + 2] = bb[0];
+    a[4 * 1 + 3] = cc[0];
 
     for (i = 2; i < N; i++) {
-        a[i][0] = 999;
-        a[i][1] = aa[i - 1];
-        a[i][2] = bb[i - 1];
-        a[i][3] = cc[i - 1];
+        a[4 * i + 1] = aa[i - 1];
+        a[4 * i + 2] = bb[i - 1];
+        a[4 * i + 3] = cc[i - 1];
     }
-    a[N][0] = 999;
-    a[N][1] = aa[N - 1];
-    a[N][2] = bb[N - 1];
-    a[N][3] = 999.; // wasted space in the compact format
+    a[4 * N + 1] = aa[N - 1];
+    a[4 * N + 2] = bb[N - 1];
+    a[4 * N + 3] = 0.0;
 
-    bandec(a, N, 1, 1, al, indx, &d); // Solve linear equations
-    //by LU decomposition for banded matrix
+    BandDecompose<1, 1>(a, bandAl, bandIndx, N);
+    BandBackSubstitute<1, 1>(a, bandAl, bandIndx, XR, N);
 
-    banbks(a, N, 1, 1, al, indx, XR);
     for (i = 0; i < N; i++)
         XR[i] = XR[i + 1];  // <- XR[i]
-
-    for (i = 0; i < N + 1; i++) {
-        delete[] a[i];
-        delete[] al[i];
-    }
-    delete[] a;
-    delete[] al;
-    delete[] indx;
-    delete[] tt;
     return;
 }
 
@@ -2381,6 +2752,7 @@ void tKinemat::lnsrch(int N, double xold[], double fold,
 
 
         else { // Backtrack
+            lsBacktracks++;
             if (alam == 1.0)         // First time...
                 tmplam = -slope / (2.0 * (*f - fold - slope));
             else {                   // Subsequent backtracks...
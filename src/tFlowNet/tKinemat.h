@@ -40,15 +40,34 @@ using namespace std;
 //
 //=========================================================================
 
-static double sqrarg;
-#define SQR(a) ((sqrarg=(a)) == 0.0 ? 0.0 : sqrarg*sqrarg)
+// Inline functions rather than macros with static temporaries, so that
+// stream reaches can be routed on several threads at once
+inline double SQR(double a) { return a*a; }
+inline double FMAX(double a, double b) { return (a > b) ? a : b; }
 
-static double maxarg1, maxarg2;
-#define FMAX(a,b) (maxarg1=(a),maxarg2=(b),(maxarg1) > (maxarg2) ?\
-                  (maxarg1) : (maxarg2))
-#define FREERETURN {delete [] X; delete [] X1; delete [] XR; delete [] F;\
-       delete [] gradf; delete [] aa; delete [] bb; delete [] cc; return; }
 
+// Channel geometry of all stream reaches, stored reach after reach from
+// reachPtr[r] (n values per reach). Widths, lengths and slopes are fixed
+// for a run; the coefficient arrays are recomputed when 'dt' changes.
+struct tReachGeometry
+{
+  vector<int>    reachPtr;
+  vector<double> nodeWidth;   // Channel width of the nodes
+  vector<double> width, length, slope, C, Y1, Y2, Y3;
+  double         dt;          // Time step of the coefficient arrays
+  int            maxSize;     // # nodes of the longest reach
+};
+
+// Newton solver counters of each stream reach, written to the file
+// *_routing.stats if OPTROUTINGSTATS = 1
+struct tReachStats
+{
+  vector<long> solves;        // # calls of KinematWave
+  vector<long> iterations;    // # Newton iterations
+  vector<long> backtracks;    // # line search backtracks
+  vector<long> failures;      // # solves not converged on F
+  vector<int>  maxIterations; // Most iterations of a single solve
+};
 
 //=========================================================================
 //
@@ -64,6 +83,7 @@ class tKinemat : public tFlowNet
   tKinemat();
   tKinemat(char **);
   tKinemat(SimulationControl*, tMesh<tCNode> *, tInputFile &, tRunTimer *);
+  tKinemat(tKinemat *);  // Worker for the threaded routing
   ~tKinemat();
 
   void KinematWave(double *, double *, double *,  double *, 
@@ -98,6 +118,9 @@ class tKinemat : public tFlowNet
   void UpdateHsShifted(double *, double *, double, int);
   void AllocateMemory(int);
   void FreeMemory();
+  void SetReachGeometry();
+  void RecordSolve(int, int);
+  void WriteRoutingStats();
   void InitializeStreamReach(int, int);
   void AssignLateralInflux();
   void PrintFlowStacks(ofstream &, tCNode *);
@@ -108,6 +131,11 @@ class tKinemat : public tFlowNet
   void initialize_values(tInputFile &, double); // JECR 2015
   void Reservoir_Routing(int); // JECR 2015
   void RunRoutingModel(int, int *, double);
+  void RouteReach(int, int *);
+  void RunRoutingThreaded(int *);
+  void BuildReachSchedule();
+  void SetWorkerParameters(tKinemat *);
+  int  UseThreads();
   void RunHydrologicRouting();
   void SurfaceFlow();
   void setTravelVelocityKin(double, double);
@@ -163,6 +191,19 @@ protected:
   double  *ais, *bis, *his, *reis, *siis, *rifis, *sumis;
   double  *C, *Y1, *Y2, *Y3;
 
+  // Reach workspace: arrays above and the Newton solver buffers are kept
+  // for the whole run, sized for the longest reach
+  int     nAlloc;               // Size of the workspace arrays
+  double  *kwX, *kwX1, *kwXR, *kwF, *kwGrad, *kwA, *kwB, *kwC, *kwXFK2;
+  double  *bandA, *bandAl;      // Banded matrix and its LU factor
+  unsigned long *bandIndx;
+
+  tReachGeometry *geometry;     // Shared by the master and its workers
+  tReachStats *stats;           // Shared by the master and its workers
+  int     statsOption;          // Write the solver counters at the end
+  char    statsName[kMaxNameSize + 20];
+  long    lsBacktracks;         // Backtracks of the current solve
+
   double  *OutletHlev; // Used for storage of the outlet H values
 
   tCNode  *cHead;      // Ptr to a current stream head node
@@ -186,6 +227,18 @@ protected:
   tPreProcess ResReadItem;
 /**** End edits by JECR 2015 ****/
 
+  // Threaded routing: reaches are scheduled on levels of the reach graph
+  int     worker;             // 1 for the worker objects of the threads
+  double  OutletQstrm;        // Q added to the outlet of the last reach
+  vector<tKinemat*> workers;  // Per-thread reach workspaces
+  vector<tCNode*> reachHead, reachOutlet;
+  vector<int> reachSize;      // # nodes of each reach
+  vector<int> upPtr, upIdx;   // Upstream reaches of each reach (CSR)
+  vector<int> levelPtr;       // Reaches of level k: levelReach[levelPtr[k]..]
+  vector<int> levelReach;
+  vector<int> reachCheck;     // Per-reach results of a threaded step
+  vector<double> reachQout, reachSums;
+
 };
 
 #endif
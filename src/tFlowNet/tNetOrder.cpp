@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tNetOrder.cpp: Network order of the nodes (see tNetOrder.h)
+**
+***************************************************************************/
+
+#include "src/tFlowNet/tNetOrder.h"
+
+using namespace std;
+
+/***************************************************************************
+**
+**  NetOrder()
+**
+**  The flow network is traversed with Kahn's algorithm (a node is taken
+**  once all the nodes draining into it are) to count the nodes draining
+**  through each node, and the nodes are then sorted by this count with a
+**  counting sort that keeps the order of equal counts. A node always
+**  counts more than any node upstream of it.
+**
+***************************************************************************/
+int NetOrder(const vector<int> &receiver, vector<int> &order,
+             vector<int> &upstream)
+{
+  int i, k, n = (int)receiver.size();
+
+  // Nodes draining through each node, from the sources down
+  vector<int> donors(n, 0);
+  for (i = 0; i < n; i++)
+    if (receiver[i] >= 0)
+      donors[receiver[i]]++;
+
+  upstream.assign(n, 1);
+  vector<int> queue;
+  queue.reserve(n);
+  for (i = 0; i < n; i++)
+    if (donors[i] == 0)
+      queue.push_back(i);
+  for (k = 0; k < (int)queue.size(); k++) {
+    i = queue[k];
+    if (receiver[i] >= 0) {
+      upstream[receiver[i]] += upstream[i];
+      if (--donors[receiver[i]] == 0)
+        queue.push_back(receiver[i]);
+    }
+  }
+  if ((int)queue.size() < n) {
+    order.clear();
+    return n - (int)queue.size();
+  }
+
+  // Counting sort by the number of upstream nodes (1 to n)
+  vector<int> first(n + 2, 0);
+  order.resize(n);
+  for (i = 0; i < n; i++)
+    first[upstream[i] + 1]++;
+  for (k = 1; k <= n + 1; k++)
+    first[k] += first[k - 1];
+  for (i = 0; i < n; i++)
+    order[first[upstream[i]]++] = i;
+  return 0;
+}
+
+//=========================================================================
+//
+//
+//                          End of tNetOrder.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tNetOrder.h: Network order of the nodes of a flow network
+**
+**  NetOrder() orders the nodes 0 to n-1 given by the index of their flow
+**  receiver (-1 for none) from upstream to downstream, as the "cascade"
+**  algorithm of Braun and Sambridge does (see tFlowNet::SortNodesByNet-
+**  Order), in O(n). It is the part of tFlowNet::BuildNetOrder() that does
+**  not need the mesh.
+**
+***************************************************************************/
+
+#ifndef TNETORDER_H
+#define TNETORDER_H
+
+#include <vector>
+
+// Sets 'order' to the nodes from upstream to downstream and 'upstream' to
+// the number of nodes draining through each node (itself included).
+// Returns the number of nodes that drain in a loop, 0 if none.
+int NetOrder(const std::vector<int> &receiver, std::vector<int> &order,
+             std::vector<int> &upstream);
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tNetOrder.h
+//
+//
+//=========================================================================
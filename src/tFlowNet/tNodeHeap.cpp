@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tNodeHeap.cpp: Functions for class tNodeHeap (see tNodeHeap.h)
+**
+***************************************************************************/
+
+#include "src/tFlowNet/tNodeHeap.h"
+
+#include <cassert>
+
+using namespace std;
+
+tNodeHeap::tNodeHeap(int n)
+  : count(0), fifo(0)
+{
+  resize(n);
+}
+
+void tNodeHeap::resize(int n)
+{
+  heap.clear();
+  pos.assign(n, -1);
+  key.assign(n, 0.0);
+  level.assign(n, 0);
+  order.assign(n, 0);
+  count = 0;
+}
+
+void tNodeHeap::clear()
+{
+  for (size_t i = 0; i < heap.size(); i++)
+    pos[heap[i]] = -1;
+  heap.clear();
+}
+
+/***************************************************************************
+**
+**  tNodeHeap::push()
+**
+**  Inserts 'item' with 'key' at level 'lev'. If the item is queued
+**  already, its key is lowered to 'key' if that is smaller and kept
+**  otherwise; its level and place among equal keys are kept.
+**
+***************************************************************************/
+void tNodeHeap::push(int item, double k, int lev)
+{
+  assert(item >= 0 && item < (int)pos.size());
+  if (pos[item] < 0) {
+    key[item] = k;
+    level[item] = lev;
+    order[item] = count++;
+    pos[item] = (int)heap.size();
+    heap.push_back(item);
+    siftUp(pos[item]);
+  }
+  else if (k < key[item]) {
+    key[item] = k;
+    siftUp(pos[item]);
+  }
+}
+
+int tNodeHeap::pop()
+{
+  assert(!heap.empty());
+  int item = heap[0];
+  int last = heap.back();
+  heap.pop_back();
+  pos[item] = -1;
+  if (!heap.empty()) {
+    heap[0] = last;
+    pos[last] = 0;
+    siftDown(0);
+  }
+  return item;
+}
+
+int tNodeHeap::before(int a, int b) const
+{
+  if (fifo)
+    return order[a] < order[b];
+  if (key[a] != key[b])
+    return key[a] < key[b];
+  if (level[a] != level[b])
+    return level[a] < level[b];
+  return order[a] < order[b];
+}
+
+void tNodeHeap::siftUp(int i)
+{
+  int item = heap[i];
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (!before(item, heap[parent]))
+      break;
+    heap[i] = heap[parent];
+    pos[heap[i]] = i;
+    i = parent;
+  }
+  heap[i] = item;
+  pos[item] = i;
+}
+
+void tNodeHeap::siftDown(int i)
+{
+  int n = (int)heap.size();
+  int item = heap[i];
+  while (2 * i + 1 < n) {
+    int child = 2 * i + 1;
+    if (child + 1 < n && before(heap[child + 1], heap[child]))
+      child++;
+    if (!before(heap[child], item))
+      break;
+    heap[i] = heap[child];
+    pos[heap[i]] = i;
+    i = child;
+  }
+  heap[i] = item;
+  pos[item] = i;
+}
+
+//=========================================================================
+//
+//
+//                          End of tNodeHeap.cpp
+//
+//
+//=========================================================================
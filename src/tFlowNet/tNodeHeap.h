@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tNodeHeap.h: Header for tNodeHeap class
+**
+**  tNodeHeap is an indexed binary min-heap of the nodes waiting to be
+**  settled by the weighted shortest path of tFlowNet. Items are node IDs
+**  (0 to n-1) and the key of an item is the tentative value of its path
+**  variable. The position of each item in the heap is kept, so the key of
+**  a queued item can be lowered in O(log n). Items with equal keys leave
+**  the heap in the order of the former breadth-first search of tFlowNet:
+**  by the number of edges between the item and the outlet when it was
+**  first queued (its level), then in the order they entered the heap.
+**  With setFifo(1) the keys are kept but not used: items leave in the
+**  order they entered, as from the list of the former search.
+**
+***************************************************************************/
+
+#ifndef TNODEHEAP_H
+#define TNODEHEAP_H
+
+//=========================================================================
+//
+//
+//                  Section 1: tNodeHeap Include and Define Statements
+//
+//
+//=========================================================================
+
+#include <vector>
+
+//=========================================================================
+//
+//
+//                  Section 2: tNodeHeap Class Definitions
+//
+//
+//=========================================================================
+
+class tNodeHeap
+{
+public:
+  tNodeHeap(int n = 0);
+
+  void   resize(int n);                // Items 0 to n-1, empties the heap
+  void   push(int item, double key, int lev = 0); // Inserts, or lowers a key
+  int    pop();                        // Removes the item of smallest key
+  void   clear();
+  void   setFifo(int f)            { fifo = f; }
+
+  int    isEmpty() const           { return heap.empty(); }
+  int    getSize() const           { return (int)heap.size(); }
+  int    contains(int item) const  { return pos[item] >= 0; }
+  double getKey(int item) const    { return key[item]; }
+  int    getLevel(int item) const  { return level[item]; }
+
+private:
+  std::vector<int> heap;      // Items in heap order
+  std::vector<int> pos;       // Position of each item in heap, -1 if out
+  std::vector<double> key;
+  std::vector<int> level;     // Level when first queued, for equal keys
+  std::vector<long> order;    // Insertion count, for equal levels
+  long count;
+  int  fifo;                  // 1: first in, first out
+
+  int  before(int, int) const;
+  void siftUp(int);
+  void siftDown(int);
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tNodeHeap.h
+//
+//
+//=========================================================================
@@ -20,10 +20,12 @@
 
 #ifdef PARALLEL_TRIBS
 #include "src/tParallel/tParallel.h"
+#include "src/tParallel/tHaloExchange.h"
 #endif
 
 #include <cassert>
 #include <map>
+#include <algorithm>
 
 SimulationControl* tGraph::sim = 0;
 tMesh<tCNode>* tGraph::mesh = 0;
@@ -61,6 +63,37 @@ const int QPIN        = 7000;
 const int GROUNDWATER = 9000;
 const int NWT         = 10000;
 
+#ifdef PARALLEL_TRIBS
+// Persistent halo exchanges, created at the first exchange once the
+// overlap lists are complete
+static tHaloExchange overlapHalo;     // upFlow -> downFlow (OVERLAP)
+static tHaloExchange nwtHalo;         // localFlux -> remoteFlux (NWT)
+static tHaloExchange groundWaterHalo; // remoteFlux -> localFlux (GROUNDWATER)
+
+// Values per node in each exchange
+const int OVERLAP_VALUES     = 3;
+const int NWT_VALUES         = 1;
+const int GROUNDWATER_VALUES = 11;
+
+/*************************************************************************
+**
+** Size a halo exchange from the send and receive node sets of each
+** partition
+**
+*************************************************************************/
+
+static void setupHalo(tHaloExchange& halo, int tag, int nvalues, int np,
+                      std::set<tCNode*,IDOrder>* sendSet,
+                      std::set<tCNode*,IDOrder>* recvSet) {
+  std::vector<int> scount(np, 0), rcount(np, 0);
+  for (int i = 0; i < np; i++) {
+    scount[i] = nvalues * sendSet[i].size();
+    rcount[i] = nvalues * recvSet[i].size();
+  }
+  halo.initialize(tag, scount, rcount);
+}
+#endif
+
 // MeshBuilder variables
 int tGraph::nodeBytes = 0;
 int tGraph::edgeBytes = 0;
@@ -88,6 +121,12 @@ tGraph::~tGraph() {}
 *************************************************************************/
 
 void tGraph::finalize(){
+#ifdef PARALLEL_TRIBS
+  overlapHalo.finalize();
+  nwtHalo.finalize();
+  groundWaterHalo.finalize();
+#endif
+
   sim = nullptr;
   mesh = nullptr;
   flow = nullptr;
@@ -146,6 +185,7 @@ void tGraph::initialize(SimulationControl* s, tMesh<tCNode>* m, tKinemat* f,
   // Update stream reach and node list information
   Cout << "\nUpdating stream reach and node list..." << endl;
   update();
+  mesh->BuildActiveIndex();
 
   // Write connectivity to file
 #ifdef PARALLEL_TRIBS
@@ -182,6 +222,7 @@ void tGraph::initialize(SimulationControl* s, tMesh<tCNode>* m,
   // Update stream reach and node list information
   Cout << "\nRead partitioned reach and node list..." << endl;
   ReadFlowMesh();
+  mesh->BuildActiveIndex();
 
   // Calculate overlapping nodes for flux exchange
   Cout << "\nCalculate overlap ..." << endl;
@@ -450,8 +491,13 @@ void tGraph::partition(int np, tInputFile& InputFile) {
     int optgfile = 0;
     optgfile = InputFile.ReadItem( optgfile, "GRAPHOPTION"); 
 
+    // Partitioning balanced by reach node counts
+    if (optgfile == 3) {
+      createWeightedPartition(np, InputFile);
+    }
+
     // Check for partitioning file
-    if (optgfile == 1 || optgfile == 2) {
+    else if (optgfile == 1 || optgfile == 2) {
       char pfile[256];
       strcpy(pfile,"");
       InputFile.ReadItem( pfile, "GRAPHFILE" );
@@ -607,6 +653,238 @@ void tGraph::createDefaultPartition(int np) {
 
 }
 
+/*************************************************************************
+**
+** Create partitions weighted by the # of nodes of each reach
+** (GRAPHOPTION = 3).
+**
+** The reach graph is a tree draining to the basin outlet. Reaches are
+** ordered depth first from the outlet (upstream reaches first), so that
+** every subtree is a contiguous range, and the order is split in np
+** ranges of about equal node count. Each range is a few whole subtrees,
+** which keeps the # of cut upstream/downstream connections low. A
+** refinement pass then moves reaches at partition boundaries to the
+** partition of a neighbor if this removes cut connections without
+** exceeding the largest partition, or evens out the load without adding
+** cut connections. A reach is only moved if the reaches it connects in
+** its partition stay connected without it (leavesConnected()), so that
+** a move does not split a partition in two. The result is reported with its predicted imbalance
+** (largest / mean # of nodes) and written in the reach format of
+** readReachPartitionFromFile() to OUTFILENAME.partition, so that it can
+** be reused or edited with GRAPHOPTION = 1.
+**
+*************************************************************************/
+
+void tGraph::createWeightedPartition(int np, tInputFile& InputFile) {
+
+    assert(numGlobalReach >= np);
+    int i, j, r, q;
+    int nr = numGlobalReach;
+
+    // Weights: # of nodes of each reach, at least 1
+    std::vector<int> weight = countReachNodes();
+    weight.resize(nr);
+    long total = 0;
+    for (r = 0; r < nr; r++) {
+      if (weight[r] < 1) weight[r] = 1;
+      total += weight[r];
+    }
+
+    // Depth first order from the outlet(s), upstream reaches first
+    std::vector<int> order;
+    std::vector<int> stack, next;
+    std::vector<char> visited(nr, 0);
+    order.reserve(nr);
+    for (int root = nr - 1; root >= 0; root--) {
+      if (conn[root].hasDownstream() || visited[root]) continue;
+      stack.push_back(root);
+      next.push_back(0);
+      visited[root] = 1;
+      while (!stack.empty()) {
+        r = stack.back();
+        std::vector<int> up = conn[r].getUpstream();
+        if (next.back() < (int)up.size()) {
+          int u = up[next.back()++];
+          if (u >= 0 && u < nr && !visited[u]) {
+            visited[u] = 1;
+            stack.push_back(u);
+            next.push_back(0);
+          }
+        }
+        else {
+          order.push_back(r);
+          stack.pop_back();
+          next.pop_back();
+        }
+      }
+    }
+    // Reaches not reached from an outlet (should not happen)
+    for (r = 0; r < nr; r++)
+      if (!visited[r]) order.push_back(r);
+
+    // Split the order in np ranges of about total/np nodes each,
+    // leaving at least one reach for each remaining partition
+    std::vector<long> load(np, 0);
+    std::vector<int> count(np, 0);
+    long sum = 0;
+    int part = 0;
+    for (i = 0; i < nr; i++) {
+      r = order[i];
+      if (part < np - 1 && count[part] > 0 &&
+          (sum >= (long)(part + 1) * total / np || nr - i <= np - 1 - part))
+        part++;
+      reach2partition[r] = part;
+      load[part] += weight[r];
+      count[part]++;
+      sum += weight[r];
+    }
+
+    // Boundary refinement
+    long maxLoad = *std::max_element(load.begin(), load.end());
+    for (int pass = 0; pass < 10; pass++) {
+      int moved = 0;
+      for (i = 0; i < nr; i++) {
+        r = order[i];
+        int p = reach2partition[r];
+        if (count[p] < 2) continue;
+
+        // Neighbors of r: upstream and downstream reaches
+        std::vector<int> nbr;
+        std::vector<int> up = conn[r].getUpstream();
+        std::vector<int> down = conn[r].getDownstream();
+        up.insert(up.end(), down.begin(), down.end());
+        for (j = 0; j < (int)up.size(); j++)
+          if (up[j] >= 0 && up[j] < nr) nbr.push_back(up[j]);
+
+        int best = -1, bestGain = 0;
+        for (j = 0; j < (int)nbr.size(); j++) {
+          q = reach2partition[nbr[j]];
+          if (q == p) continue;
+          int gain = 0;
+          for (int k = 0; k < (int)nbr.size(); k++) {
+            if (reach2partition[nbr[k]] == q) gain++;
+            else if (reach2partition[nbr[k]] == p) gain--;
+          }
+          bool fits = (load[q] + weight[r] <= maxLoad);
+          bool evens = (load[p] - weight[r] >= load[q] + weight[r]);
+          if ((gain > 0 && fits) || (gain == 0 && evens)) {
+            if (best < 0 || gain > bestGain) {
+              best = q;
+              bestGain = gain;
+            }
+          }
+        }
+        if (best >= 0 && leavesConnected(r)) {
+          reach2partition[r] = best;
+          load[p] -= weight[r];
+          load[best] += weight[r];
+          count[p]--;
+          count[best]++;
+          moved++;
+        }
+      }
+      if (moved == 0) break;
+    }
+
+    // Report predicted load balance and communication
+    int cut = 0;
+    for (r = 0; r < nr; r++) {
+      std::vector<int> down = conn[r].getDownstream();
+      for (j = 0; j < (int)down.size(); j++)
+        if (reach2partition[down[j]] != reach2partition[r]) cut++;
+    }
+    maxLoad = *std::max_element(load.begin(), load.end());
+    Cout << "\nWeighted partitioning of " << nr << " reaches ("
+         << total << " nodes) on " << np << " partitions" << endl;
+    for (part = 0; part < np; part++)
+      Cout << "Partition " << part << ": " << count[part] << " reaches, "
+           << load[part] << " nodes" << endl;
+    Cout << "Predicted imbalance (max/mean nodes): "
+         << (double)maxLoad * np / total << endl;
+    Cout << "Cut reach connections: " << cut << endl;
+
+    // Write partitioning in the reach format
+#ifdef PARALLEL_TRIBS
+    if (tParallel::isMaster()) {
+#endif
+      char pfile[kMaxNameSize + 20];
+      InputFile.ReadItem(pfile, "OUTFILENAME");
+      strcat(pfile, ".partition");
+      writeReachPartitionToFile(pfile);
+#ifdef PARALLEL_TRIBS
+    }
+#endif
+}
+
+/*************************************************************************
+**
+** Does the partition of reach r stay connected without r? The upstream
+** and downstream reaches of r in its partition must all be reached from
+** the first of them without going through r. A reach with at most one
+** neighbor in its partition can always be removed.
+**
+*************************************************************************/
+
+bool tGraph::leavesConnected(int r) {
+
+    int p = reach2partition[r];
+    std::vector<int> nbr = conn[r].getUpstream();
+    const std::vector<int>& down = conn[r].getDownstream();
+    nbr.insert(nbr.end(), down.begin(), down.end());
+
+    std::vector<int> inPart;
+    for (int j = 0; j < (int)nbr.size(); j++)
+      if (nbr[j] >= 0 && nbr[j] < numGlobalReach &&
+          reach2partition[nbr[j]] == p) inPart.push_back(nbr[j]);
+    if (inPart.size() < 2) return true;
+
+    // Search the partition from the first neighbor, r excluded
+    std::vector<char> seen(numGlobalReach, 0);
+    std::vector<int> stack(1, inPart[0]);
+    seen[r] = 1;
+    seen[inPart[0]] = 1;
+    int found = 1;
+    while (!stack.empty() && found < (int)inPart.size()) {
+      int s = stack.back();
+      stack.pop_back();
+      std::vector<int> next = conn[s].getUpstream();
+      const std::vector<int>& sdown = conn[s].getDownstream();
+      next.insert(next.end(), sdown.begin(), sdown.end());
+      for (int j = 0; j < (int)next.size(); j++) {
+        int u = next[j];
+        if (u < 0 || u >= numGlobalReach || seen[u] ||
+            reach2partition[u] != p) continue;
+        seen[u] = 1;
+        stack.push_back(u);
+        for (int k = 1; k < (int)inPart.size(); k++)
+          if (inPart[k] == u) found++;
+      }
+    }
+    return found == (int)inPart.size();
+}
+
+/*************************************************************************
+**
+** Write graph partitioning to file in the reach format
+** (see readReachPartitionFromFile).
+**
+*************************************************************************/
+
+void tGraph::writeReachPartitionToFile(char* pfile) {
+
+    ofstream partFile;
+    partFile.open(pfile);
+    if (!partFile.good()) {
+      cout << "\nWarning: Partition file " << pfile 
+           << " not created..." << endl;
+      return;
+    }
+    for (int i = 0; i < numGlobalReach; i++)
+      partFile << reach2partition[i] << " " << i << "\n";
+    partFile.close();
+    Cout << "\nPartitioning written to reach file " << pfile << endl;
+}
+
 /*************************************************************************
 **
 ** Check if stream reach in the local partition.
@@ -1725,40 +2003,48 @@ void tGraph::calculateOverlap() {
 
 /*************************************************************************
 **
-** Print node counts for reaches.
+** Return # of active nodes associated with each reach.
+** The outlet is only associated with the last reach. For MeshBuilder
+** input (no flow net yet) the counts of the reach directory are used.
 **
 *************************************************************************/
 
-void tGraph::reachNodeCounts() {
-  // Get reach heads and outlets
-  tPtrList< tCNode >& hlist = flow->getReachHeadList();
-  tPtrList< tCNode >& olist = flow->getReachOutletList();
+std::vector<int> tGraph::countReachNodes() {
+  std::vector<int> ncount(numGlobalReach, 0);
 
-  // Create iterator for all nodes, heads, and outlets
-  tMeshList<tCNode> *nlist = mesh->getNodeList();
-  tMeshListIter<tCNode> niter(nlist);
-  int i;
+  if (flow == 0) {
+    for (int i = 0; i < numGlobalReach && i < (int)pointsPerReach.size(); i++)
+      ncount[i] = pointsPerReach[i];
+    return ncount;
+  }
+
+  tMeshListIter<tCNode> niter(mesh->getNodeList());
+  tCNode *cn;
+  int rnum;
+  for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP()) {
+    rnum = cn->getReach();
+    if (rnum >= 0 && rnum < numGlobalReach) ncount[rnum]++;
+  }
+  return ncount;
+}
+
+/*************************************************************************
+**
+** Print node counts for reaches.
+**
+*************************************************************************/
 
+void tGraph::reachNodeCounts() {
   // Collect information on node list
+  tMeshList<tCNode> *nlist = mesh->getNodeList();
   int nsize = nlist->getSize();
   cout << "# nodes in list = " << nsize << endl;
   int asize = nlist->getActiveSize();
   cout << "# active nodes in list = " << asize << endl;
 
   // Count # of nodes associated with each reach
-  // The outlet is only associated with the last reach
-  int *ncount = new int[numGlobalReach];
-  for (i = 0; i < numGlobalReach; i++)
-    ncount[i] = 0;
-
-  tCNode *cn, *chead, *coutlet, *creach;
-  int rnum;
-  // Figure out how many nodes are associated with each reach
-  for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP()) {
-    rnum = cn->getReach();
-    if (rnum >= 0) ncount[rnum]++;
-  }
-  for (i = 0; i < numGlobalReach; i++)
+  std::vector<int> ncount = countReachNodes();
+  for (int i = 0; i < numGlobalReach; i++)
     cout << "Reach " << i << " # nodes = " << ncount[i] << endl;
 }
 
@@ -1957,19 +2243,17 @@ bool tGraph::isRemotefluxNode(tCNode* cn) {
 void tGraph::sendDownstream(int rid, tCNode* snode, double value) {
   assert(rid >= 0 && rid < numGlobalReach);
 #ifdef PARALLEL_TRIBS
-  // double* ndata = new double[1]; //WR debug moved to inside scope of if statment to prevent memory leak
   // Get list of downstream reaches
-  std::vector<int> dreach = conn[rid].getDownstream();
+  const std::vector<int>& dreach = conn[rid].getDownstream();
   // For each on another processor, send data
   for (int i = 0; i < dreach.size(); i++) {
 
     // Send if last reach
     if ( !inLocalPartition(dreach[i])) {
-        double* ndata = new double[1]; // WR debug added
       int to_proc = reach2partition[ dreach[i] ]; // To processor
-      // Collect node data and send
-      ndata[0] = value;
-      tParallel::send(to_proc, DOWNSTREAM+snode->getReach(), ndata, 1);
+      // Send on the persistent request of this reach
+      tParallel::sendPersistent(to_proc, DOWNSTREAM+snode->getReach(),
+                                &value, 1);
     }
   }
 #endif
@@ -1984,9 +2268,9 @@ void tGraph::sendDownstream(int rid, tCNode* snode, double value) {
 void tGraph::receiveUpstream(int rid, tCNode* rnode) {
   assert(rid >= 0 && rid < numGlobalReach);
 #ifdef PARALLEL_TRIBS
-  double* ndata = new double[1];
+  double value;
   // Get list of upstream reaches
-  std::vector<int> ureach = conn[rid].getUpstream();
+  const std::vector<int>& ureach = conn[rid].getUpstream();
   // For each on another processor, receive data
   for (int i = 0; i < ureach.size(); i++) {
 
@@ -1995,12 +2279,11 @@ void tGraph::receiveUpstream(int rid, tCNode* rnode) {
     
       int from_proc = reach2partition[ ureach[i] ]; // From processor
       // Receive data and update node
-      tParallel::receive(from_proc, DOWNSTREAM+rnode->getReach(), ndata, 1);
-      rnode->addQstrm(ndata[0]);
+      tParallel::receivePersistent(from_proc, DOWNSTREAM+rnode->getReach(),
+                                   &value, 1);
+      rnode->addQstrm(value);
     }
   }
-  delete [] ndata;
-  tParallel::freeBuffers();// WR debug: put this at end of each receive call, it checks to see which previously assinged pointer  arrays can be safely deleted
 #endif
 }
 
@@ -2035,11 +2318,13 @@ void tGraph::resetOverlap() {
 void tGraph::sendOverlap() {
 
 #ifdef PARALLEL_TRIBS
-  int dsizeN = 0;
+  if (!overlapHalo.isInitialized())
+    setupHalo(overlapHalo, OVERLAP, OVERLAP_VALUES, numGlobalPart,
+              upFlow, downFlow);
+
   for (int i = 0; i < numGlobalPart; i++) {
-    dsizeN = 3 * upFlow[i].size(); 
-    if (dsizeN > 0) {
-      double* ndata = new double[dsizeN];
+    double* ndata = overlapHalo.sendBuffer(i);
+    if (ndata != nullptr) {
       int d = 0;
 
       // Pack data for upstream reach outlet nodes
@@ -2049,10 +2334,9 @@ void tGraph::sendOverlap() {
         ndata[d++] = (*iup)->getNwtOld();
         ndata[d++] = (*iup)->getNfOld();
       }
-
-      tParallel::send(i, OVERLAP, ndata, dsizeN);
     }
   }
+  overlapHalo.start();
 
 #endif
 }
@@ -2066,14 +2350,11 @@ void tGraph::sendOverlap() {
 void tGraph::receiveOverlap() {
 
 #ifdef PARALLEL_TRIBS
+  overlapHalo.finish();
 
-  int dsizeN = 0;
   for (int i = 0; i < numGlobalPart; i++) {
-   dsizeN = 3 * downFlow[i].size();
-    if (dsizeN > 0) {
-      double* ndata = new double[dsizeN];
-
-      tParallel::receive(i, OVERLAP, ndata, dsizeN);
+    double* ndata = overlapHalo.recvBuffer(i);
+    if (ndata != nullptr) {
       int d = 0;
 
       // Unpack data from downstream reach head nodes
@@ -2085,10 +2366,8 @@ void tGraph::receiveOverlap() {
         (*idw)->setNfOld(ndata[d++]);
 
       }
-      delete [] ndata;
     }
   }
-  tParallel::freeBuffers();// WR debug: put this at end of each receive call, it checks to see which previously assinged pointer  arrays can be safely deleted
 #endif
 }
 
@@ -2102,21 +2381,18 @@ void tGraph::sendQpin(int rid, tCNode* snode, double value) {
   assert(rid >= 0 && rid < numGlobalReach);
 
 #ifdef PARALLEL_TRIBS
-  //double* ndata = new double[1]; //WR debug added to scope of if statment to prevent memory leak
   // Get list of downstream reaches
-  std::vector<int> dreach = conn[rid].getDownstream();
+  const std::vector<int>& dreach = conn[rid].getDownstream();
 
   // For each on another processor, send data
   for (int i = 0; i < dreach.size(); i++) {
 
     // Send from last reach
     if ( !inLocalPartition(dreach[i])) {
-        double* ndata = new double[1];
-        int to_proc = reach2partition[ dreach[i] ]; // To processor
+      int to_proc = reach2partition[ dreach[i] ]; // To processor
 
-      // Collect node data and send
-      ndata[0] = value;
-      tParallel::send(to_proc, QPIN+snode->getReach(), ndata, 1);
+      // Send on the persistent request of this reach
+      tParallel::sendPersistent(to_proc, QPIN+snode->getReach(), &value, 1);
     }
   }
 #endif
@@ -2132,9 +2408,9 @@ void tGraph::receiveQpin(int rid, tCNode* rnode) {
   assert(rid >= 0 && rid < numGlobalReach);
 
 #ifdef PARALLEL_TRIBS
-  double* ndata = new double[1];
+  double value;
   // Get list of upstream reaches
-  std::vector<int> ureach = conn[rid].getUpstream();
+  const std::vector<int>& ureach = conn[rid].getUpstream();
 
   // For each on another processor, receive data
   for (int i = 0; i < ureach.size(); i++) {
@@ -2145,12 +2421,11 @@ void tGraph::receiveQpin(int rid, tCNode* rnode) {
       int from_proc = reach2partition[ ureach[i] ]; // From processor
 
       // Receive data and update node
-      tParallel::receive(from_proc, QPIN+rnode->getReach(), ndata, 1);
-      rnode->addQpin(ndata[0]);
+      tParallel::receivePersistent(from_proc, QPIN+rnode->getReach(),
+                                   &value, 1);
+      rnode->addQpin(value);
     }
   }
-  delete [] ndata;
-  tParallel::freeBuffers();// WR debug: put this at end of each receive call, it checks to see which previously assinged pointer  arrays can be safely deleted
 #endif
 }
 
@@ -2239,10 +2514,10 @@ void tGraph::sendRunFlux(tCNode* cn) {
 #ifdef PARALLEL_TRIBS
   int dsizeN = 2;
   int d;
-  double* ndata = new double[dsizeN];
+  double ndata[2];
 
   // Get list of downstream reaches
-  std::vector<int> dreach = conn[cn->getReach()].getDownstream();
+  const std::vector<int>& dreach = conn[cn->getReach()].getDownstream();
 
   // For each on another processor, send data
   for (int i = 0; i < dreach.size(); i++) {
@@ -2255,12 +2530,11 @@ void tGraph::sendRunFlux(tCNode* cn) {
        d = 0;
        ndata[d++] = cn->getSrf();
        ndata[d++] = cn->getVArea();
-       tParallel::send(to_proc, RUNON+cn->getReach(), ndata, dsizeN);
+       // The persistent request has its own copy of ndata
+       tParallel::sendPersistent(to_proc, RUNON+cn->getReach(), ndata, dsizeN);
 
    }
  }
-
-  delete [] ndata;
 #endif
 }
 
@@ -2274,11 +2548,10 @@ void tGraph::receiveRunFlux(tCNode* cn) {
 #ifdef PARALLEL_TRIBS
   int dsizeN = 2;
   int d;
-  double* ndata = new double[dsizeN];
-  int creach = cn->getReach();
+  double ndata[2];
 
   // Get list of upstream reaches
-  std::vector<int> ureach = conn[cn->getReach()].getUpstream();
+  const std::vector<int>& ureach = conn[cn->getReach()].getUpstream();
 
   // For each on another processor, receive data
   for (int i = 0; i < ureach.size(); i++) {
@@ -2290,14 +2563,12 @@ void tGraph::receiveRunFlux(tCNode* cn) {
 
       // Receive data and update node
       d = 0;
-      tParallel::receive(from_proc, RUNON+nodeAboveOutlet[ureach[i]]->getReach(), ndata, dsizeN);
+      tParallel::receivePersistent(from_proc, RUNON+nodeAboveOutlet[ureach[i]]->getReach(), ndata, dsizeN);
       nodeAboveOutlet[ureach[i]]->setsrf(ndata[d++]);
       nodeAboveOutlet[ureach[i]]->setVArea(ndata[d++]);
 
     }
   }
-  delete [] ndata;
-  tParallel::freeBuffers();// WR debug: put this at end of each receive call, it checks to see which previously assinged pointer  arrays can be safely deleted
 #endif
 }
 
@@ -2364,11 +2635,13 @@ void tGraph::receiveDownstreamFlow() {
 void tGraph::sendGroundWater() {
 
 #ifdef PARALLEL_TRIBS
-  int dsizeN = 0;
+  if (!groundWaterHalo.isInitialized())
+    setupHalo(groundWaterHalo, GROUNDWATER, GROUNDWATER_VALUES, numGlobalPart,
+              remoteFlux, localFlux);
+
   for (int i = 0; i < numGlobalPart; i++) {
-    dsizeN = 11 * remoteFlux[i].size();
-    if (dsizeN > 0) {
-      double* ndata = new double[dsizeN];
+    double* ndata = groundWaterHalo.sendBuffer(i);
+    if (ndata != nullptr) {
       int c = 0;
 
       // Pack data for remote saturated flux nodes
@@ -2383,9 +2656,10 @@ void tGraph::sendGroundWater() {
           ndata[c++] = (*iter);
         }
       }
-      tParallel::send(i, GROUNDWATER, ndata, dsizeN);
+      assert(c <= GROUNDWATER_VALUES * (int)remoteFlux[i].size());
     }
   }
+  groundWaterHalo.start();
 #endif 
 }
 
@@ -2398,12 +2672,11 @@ void tGraph::sendGroundWater() {
 void tGraph::receiveGroundWater() {
 
 #ifdef PARALLEL_TRIBS
-  int dsizeN = 0;
+  groundWaterHalo.finish();
+
   for (int i = 0; i < numGlobalPart; i++) {
-    dsizeN = 11 * localFlux[i].size();
-    if (dsizeN > 0) {
-      double* ndata = new double[dsizeN];
-      tParallel::receive(i, GROUNDWATER, ndata, dsizeN);
+    double* ndata = groundWaterHalo.recvBuffer(i);
+    if (ndata != nullptr) {
       int c = 0;
 
       // Unpack data for local saturated flux nodes
@@ -2415,10 +2688,8 @@ void tGraph::receiveGroundWater() {
           (*iflux)->addGwaterChng(ndata[c++]);
         }
       }
-      delete [] ndata; //WR debug: ndata can be deleted here as tParallel:receive uses MPI_Recv which is a blocking process
     }
   }
-    tParallel::freeBuffers();// WR debug: put this at end of each receive call, it checks to see which previously assinged pointer  arrays can be safely deleted
 #endif
 }
 
@@ -2431,20 +2702,21 @@ void tGraph::receiveGroundWater() {
 void tGraph::sendNwt() {
 
 #ifdef PARALLEL_TRIBS
-  int dsizeN = 0;
+  if (!nwtHalo.isInitialized())
+    setupHalo(nwtHalo, NWT, NWT_VALUES, numGlobalPart, localFlux, remoteFlux);
+
   for (int i = 0; i < numGlobalPart; i++) {
-    dsizeN = 1 * localFlux[i].size();
-    if (dsizeN > 0) {
-      double* ndata = new double[dsizeN];
+    double* ndata = nwtHalo.sendBuffer(i);
+    if (ndata != nullptr) {
       int d = 0;
       std::set<tCNode*>::iterator iflux;
       for (iflux = localFlux[i].begin(); iflux != localFlux[i].end(); 
           ++iflux) {
         ndata[d++] = (*iflux)->getNwtOld();
       }
-      tParallel::send(i, NWT, ndata, dsizeN);
     }
   }
+  nwtHalo.start();
 
 #endif
 }
@@ -2458,12 +2730,11 @@ void tGraph::sendNwt() {
 void tGraph::receiveNwt() {
 
 #ifdef PARALLEL_TRIBS
-  int dsizeN = 0;
+  nwtHalo.finish();
+
   for (int i = 0; i < numGlobalPart; i++) {
-   dsizeN = 1 * remoteFlux[i].size();
-    if (dsizeN > 0) {
-      double* ndata = new double[dsizeN];
-      tParallel::receive(i, NWT, ndata, dsizeN);
+    double* ndata = nwtHalo.recvBuffer(i);
+    if (ndata != nullptr) {
       std::set<tCNode*>::iterator iflux;
       int d = 0;
       // Unpack flux data from downstream
@@ -2471,10 +2742,8 @@ void tGraph::receiveNwt() {
           ++iflux) {
         (*iflux)->setNwtOld(ndata[d++]);
       }
-      delete [] ndata;
     }
   }
-    tParallel::freeBuffers();// WR debug: put this at end of each receive call, it checks to see which previously assinged pointer  arrays can be safely deleted
 #endif
 }
 
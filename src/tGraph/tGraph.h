@@ -101,6 +101,12 @@ public:
   static void readInletOutletPartitionFromFile(char* pfile);
   /// Create default partitions
   static void createDefaultPartition(int np);
+  /// Create partitions balanced by reach node counts with few cut edges
+  static void createWeightedPartition(int np, tInputFile& InputFile);
+  /// Does partition of reach r stay connected without r?
+  static bool leavesConnected(int r);
+  /// Write reach-based partitions to file
+  static void writeReachPartitionToFile(char* pfile);
 
   /// List ids of all active nodes
   static void listActiveNodes();
@@ -123,6 +129,8 @@ public:
   /// Calculate runoff/runon nodes
   static void calculateRunFlux();
 
+  /// Return # of active nodes associated with each reach
+  static std::vector<int> countReachNodes();
   /// Display node counts per reach
   static void reachNodeCounts();
   /// Display stream nodes in each reach
@@ -64,9 +64,9 @@ public:
   /// Return ID
   int getID() const { return id; }
   /// Return list of upstream nodes
-  std::vector<int> getUpstream() const { return upstream; }
+  const std::vector<int>& getUpstream() const { return upstream; }
   /// Return list of downstream nodes
-  std::vector<int> getDownstream() const { return downstream; }
+  const std::vector<int>& getDownstream() const { return downstream; }
   /// Return list of flux nodes
   std::vector<int> getFlux() const { return flux; }
   /// Return number of upstream nodes
@@ -0,0 +1,370 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tEnergyBalance.cpp:   Functions for class tEnergyBalance
+**                        (see tEnergyBalance.h)
+**
+***************************************************************************/
+
+#include "src/tHydro/tEnergyBalance.h"
+#include "src/tThreadPool/tThreadPool.h"
+#include "src/Headers/globalIO.h"
+
+#include <cmath>
+
+using namespace std;
+
+#define TOLF   1.0e-5   // Accuracy of Tg [K]
+
+tEnergyBalance::tEnergyBalance()
+  : etOption(0), gFluxOption(0), DTime(0.0), histogram(kEBMaxIter+2, 0)
+{}
+
+void tEnergyBalance::setOptions(int et, int gflux, double timeStep)
+{
+	etOption = et;
+	gFluxOption = gflux;
+	DTime = timeStep*60.0;  //Seconds
+}
+
+/***************************************************************************
+**
+**  tEnergyBalance::solveAll()
+**
+**  Solves nodes [0, n) on the threads; each thread counts its iterations
+**  in its own histogram, added to the total afterwards
+**
+***************************************************************************/
+void tEnergyBalance::solveAll(vector<tEBNode> &nodes, int n)
+{
+	threadHistogram.resize(tThreadPool::getNumThreads());
+	for (size_t t = 0; t < threadHistogram.size(); t++)
+		threadHistogram[t].assign(kEBMaxIter+2, 0);
+
+	tThreadPool::parallelFor(0, n, [&](int first, int last, int t) {
+		vector<long> &h = threadHistogram[t];
+		for (int i = first; i < last; i++) {
+			solve(nodes[i]);
+			h[nodes[i].converged ? nodes[i].iter : kEBMaxIter+1]++;
+		}
+	});
+
+	for (size_t t = 0; t < threadHistogram.size(); t++)
+		for (int k = 0; k < kEBMaxIter+2; k++)
+			histogram[k] += threadHistogram[t][k];
+}
+
+void tEnergyBalance::record(const tEBNode &eb)
+{
+	histogram[eb.converged ? eb.iter : kEBMaxIter+1]++;
+}
+
+void tEnergyBalance::writeHistogram() const
+{
+	long total = 0;
+	for (int k = 0; k < kEBMaxIter+2; k++)
+		total += histogram[k];
+	if (!total)
+		return;
+
+	Cout<<"\nEnergy balance iterations (solves: iterations - count):"<<endl;
+	for (int k = 0; k <= kEBMaxIter; k++)
+		if (histogram[k])
+			Cout<<"\t"<<k<<" - "<<histogram[k]<<endl;
+	if (histogram[kEBMaxIter+1])
+		Cout<<"\tno convergence - "<<histogram[kEBMaxIter+1]<<endl;
+}
+
+/***************************************************************************
+**
+**  tEnergyBalance::solve()
+**
+**  Finds Tg with rootSearch() and sets the fluxes of the node for it
+**
+***************************************************************************/
+void tEnergyBalance::solve(tEBNode &eb) const
+{
+	double df, Gso = 0.0;
+
+	eb.iter = 0;
+	eb.converged = 1;
+	eb.Tg = rootSearch(eb, Gso);
+
+	// To make sure the fluxes correspond to the obtained Tg
+	functionAndDerivative(eb, eb.Tg, eb.f, df, Gso);
+}
+
+/***************************************************************************
+**
+**  tEnergyBalance::rootSearch()
+**
+**  Finds the root of f(Tg) in [223.15, 373.15] K starting from Tso, as
+**  tEvapoTrans::rtsafe_mod_energy did: Newton steps that are bisected if
+**  they leave the bracket or do not decrease fast enough. If the search
+**  does not converge, returns the first guess.
+**
+***************************************************************************/
+double tEnergyBalance::rootSearch(tEBNode &eb, double &Gso) const
+{
+	int j;
+	double x1 = 223.15, x2 = 373.15, xguess = eb.Tso;
+	double df,dx,dxold,f,fh,fl;
+	double temp,xh,xl,rts;
+
+	// -- 'fl' & 'fh' below are the evaluation function values --
+	// -- corresponding to arguments 'x1' and 'x2' --
+	functionAndDerivative(eb, x1, fl, df, Gso);
+	if (fl == 0.0) return x1;
+
+	functionAndDerivative(eb, x2, fh, df, Gso);
+	if (fh == 0.0) return x2;
+
+	if (fl < 0.0) {  // Orient the search so that f(xl) < 0
+		xl = x1;
+		xh = x2;
+	}
+	else {
+		xh = x1;
+		xl = x2;
+	}
+
+	rts = xguess;         // A better guess than central value
+	dxold = fabs(x2-x1);  // the "stepsize before last",
+	dx = dxold;           // and the last step
+
+	functionAndDerivative(eb, rts, f, df, Gso);
+
+	for (j=1; j <= kEBMaxIter; j++) {  // Loop over allowed iterations
+		eb.iter = j;
+		if ((((rts-xh)*df-f)*((rts-xl)*df-f) > 0.0) // Bisect if Newton is out of range
+			|| (fabs(2.0*f) > fabs(dxold*df))) {    // or not decreasing fast enough
+			dxold = dx;
+			dx = 0.5*(xh-xl);
+			rts = xl+dx;
+			if (xl == rts) return rts; // Change in root is
+		}                              // negligible, take it
+		else {
+			dxold = dx;
+			dx = f/df;
+			temp = rts;
+			rts -= dx;
+			if (temp == rts) return rts;
+		}
+		if (fabs(dx) < TOLF) return rts; // Convergence criterion
+
+		functionAndDerivative(eb, rts, f, df, Gso);
+
+		if (f < 0.0) // <-- Maintain the bracket on the root
+			xl=rts;
+		else
+			xh=rts;
+	}
+	eb.converged = 0;
+	eb.lastTg = rts;
+	eb.lastF = f;
+	return xguess;
+}
+
+/***************************************************************************
+**
+**  tEnergyBalance::functionAndDerivative()
+**
+**  Value of the energy balance (fv) and of its derivative (dv) for the
+**  ground temperature Tg, and the fluxes of the node for Tg. Gso is the
+**  ground heat flux of the force-restore method at Tg, used for its
+**  derivative.
+**
+***************************************************************************/
+void tEnergyBalance::functionAndDerivative(tEBNode &eb, double Tg,
+										   double &fv, double &dv,
+										   double &Gso) const
+{
+	double Rn, Lsoi, Hsoi, lEsoi, G(0), dQ, num;
+	double Ep(0), Eps, LE(0), H(0), ccTs(0);
+	double alpha = 1.26;
+	double sigma = 5.67E-8;
+	double Es = 0.98;   //Calibrated for site (may need to be land parameter)
+	double Cp = 1013.0;
+	double Ch = 0.0025;
+	double rv = 461.5;
+	double rho    = eb.air.rho;
+	double P      = eb.air.totPress;
+	double satVap = eb.air.esat;
+	double es     = eb.air.vPress;
+	double lam    = eb.air.lam;
+	double cc     = eb.air.cc;
+	double psy    = 100.0*eb.air.psy;
+	double Rah    = eb.air.ra;
+	double Rstm   = eb.air.rs;
+	double windSpeedC = eb.air.windSpeed;
+	double denom   = ((cc/psy) + 1.0);
+	double denomrs = ((cc/psy) + 1.0 + Rstm/Rah);
+	double pi = 4.0*atan(1.0);
+	double outLongR;
+
+	double dRndTg(0), dLdTg, dHdTg(0), dlEdTg(0), dGdTg(0);
+	double soiFct(0), vegFct(0), esat, qhSatTs, qhTa;
+
+	// 1.) == NET longwave radiation ==
+	outLongR = eb.v1*Es*sigma*pow(Tg,4.0);
+	Lsoi = outLongR - eb.inLongR;
+
+	// 2.) == Ground heat flux ==
+	if (gFluxOption == 1) { // Surface toC from the previous time step Tso is used
+		G = pow((4.0 * eb.coeffKs * eb.coeffCs / (pi * DTime)), 0.5) * (Tg - eb.Tso);
+	}
+	else if (gFluxOption == 2) {
+		G = forceRestore(eb, Tg, 1, Gso);
+	}
+
+	// 3.) == NET radiation at the surface ==
+	Rn = eb.Rabsb - Lsoi;
+
+	// 4.) == Sensible heat flux ==
+	if (etOption == 1 || etOption == 3) {
+		H = rho * Cp * (Tg - (eb.airTemp + 273.15)) / Rah;
+	}
+	else if (etOption == 2) {
+		H = rho * Cp * (Tg - (eb.airTemp + 273.15)) * Ch * windSpeedC;
+	}
+	Hsoi = H;
+
+	// 5.) == Latent heat flux ==
+	if (etOption == 1) {
+		dQ = (0.622/P)*(satVap-es)*rho*lam/Rah;
+		soiFct = (1.0-eb.coeffV)*eb.betaS;
+		vegFct = eb.coeffV*eb.betaT;
+		num = (cc/psy)*(Rn-G) + dQ;
+
+		Eps = num/denom/lam;
+		Ep  = num/denomrs/lam;
+		LE = soiFct*lam*Eps + vegFct*lam*Ep;
+		Ep *= (denomrs/denom);
+	}
+	else if (etOption == 2) {
+		esat = (6.112*exp((17.67*(Tg-273.15))/((Tg-273.15)+243.5)));
+		ccTs = (lam*esat)/(rv*pow(Tg,2.0));
+		qhSatTs = (0.622/P)*esat;
+		qhTa    = (0.622/P)*es;
+		(qhSatTs > qhTa ? Ep = rho*Ch*(qhSatTs-qhTa)*windSpeedC : Ep = 0.0);
+		LE = Ep*lam*eb.betaS;
+	}
+	else if (etOption == 3) {
+		(Rn > G ? Ep = (alpha/lam)*(Rn-G)*((cc/psy)/denom) : Ep = 0.0);
+		LE = Ep*lam*eb.betaS;
+	}
+	lEsoi = LE;
+
+	// ----------------------------------------------
+	// Energy Balance as function of soil temperature
+	fv = -eb.Rabsb + Lsoi + Hsoi + lEsoi + G;
+
+	// Compute partial derivatives
+	dLdTg = 4.0*Es*sigma*pow(Tg,3.0);
+	dRndTg = -dLdTg;
+
+	if (gFluxOption == 1)
+		dGdTg = pow((4.0*eb.coeffKs*eb.coeffCs/(pi*DTime)),0.5);
+	else if (gFluxOption == 2)
+		dGdTg = forceRestore(eb, Tg, 2, Gso);
+
+	if (etOption == 1) {
+		dHdTg = rho*Cp/Rah;
+		dlEdTg = soiFct*(cc/psy)*(dRndTg-dGdTg)/denom
+			+ vegFct*(cc/psy)*(dRndTg-dGdTg)/denomrs;
+	}
+	else if (etOption == 2) {
+		dHdTg = rho*Cp*Ch*windSpeedC;
+		dlEdTg = lam*rho*Ch*windSpeedC*(0.622/P)*ccTs*eb.betaS;
+	}
+	else if (etOption == 3) {
+		dHdTg = rho*Cp/Rah;
+		dlEdTg = eb.betaS*(alpha)*((cc/psy)/denom)*(dRndTg - dGdTg);
+	}
+
+	// ----------------------------------------------
+	// Derivative with respect to the ground temperature
+	dv = dLdTg + dHdTg + dlEdTg + dGdTg;
+
+	eb.H = Hsoi;
+	eb.LE = lEsoi;
+	eb.Rn = Rn;
+	eb.G = G;
+	eb.Ep = Ep;
+	eb.outLongR = outLongR;
+}
+
+/***************************************************************************
+**
+**  tEnergyBalance::forceRestore()
+**
+**  Ground heat flux (option 1) or its derivative (option 2) with the
+**  force-restore method, see tEvapoTrans::ForceRestore. Option 1 sets
+**  Gso, used by option 2.
+**
+***************************************************************************/
+double tEnergyBalance::forceRestore(const tEBNode &eb, double Ts, int option,
+									double &Gso) const
+{
+	double w1, d1, k, cs, ddel, pi, dt;    // input
+	double alpha, nd, G, Tg, Tl, dg, dTgdt, dGdTg, dTK, tempo = {};
+
+	dTK = 0.001;                  // Delta T
+	pi = 4.0*atan(1.0);
+	w1 = 2.*pi/86400.;            // Daily frequency [s^-1]
+	dt = DTime;                   // Time step [s]
+
+	cs = eb.coeffCs;              // Heat capacity     [J m^-3 K^-1]
+	k  = eb.coeffKs/eb.coeffCs;   // Heat diffusivity  [m^2 s^-1]
+	d1 = pow((2.0*k/w1),0.5);     // Damping depth of the diurnal temperature [m]
+	ddel = 0.1;                   // Soil layer thickness  [m]
+
+	nd = ddel/d1;                 // Normalized depth, checked by validForceRestore
+	alpha = 1+0.943*nd+0.223*pow(nd,2.0)+0.0168*pow(nd,3.0)-0.00527*pow(nd,4.0);
+
+	Tg = Ts;     // degree Kelvin
+	Tl = eb.Tlo; // degree Kelvin
+
+	dg = (0.5*cs*d1)/(1.0 + (w1*dt)/(2.0*pow(365.,0.5)));
+
+	if (option == 1) {
+		dTgdt = (Tg - eb.Tso)/dt;
+		G = dg*(alpha*dTgdt + w1*(Tg - Tl));
+		Gso = G;   //Computed value of G at i-th iteration
+		tempo = G;
+	}
+	// Numerical approximation of the gradient
+	else if (option == 2) {
+		dTgdt = (Tg+dTK - eb.Tso)/dt;
+		dGdTg = (dg*(alpha*dTgdt + w1*(Tg - Tl)) - Gso)/dTK;
+		tempo = dGdTg;
+	}
+	return tempo;
+}
+
+int tEnergyBalance::validForceRestore(double coeffKs, double coeffCs)
+{
+	double pi = 4.0*atan(1.0);
+	double w1 = 2.*pi/86400.;
+	double d1 = pow((2.0*(coeffKs/coeffCs)/w1),0.5);
+	double nd = 0.1/d1;
+	return (nd >= 0.0 && nd <= 5.0);
+}
+
+#undef TOLF
+
+//=========================================================================
+//
+//
+//                       End of tEnergyBalance.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tEnergyBalance.h:   Header file for tEnergyBalance Class
+**
+**  tEnergyBalance finds the ground temperature Tg that closes the surface
+**  energy balance of tEvapoTrans (Penman-Monteith, Deardorff and
+**  Priestly-Taylor, ground heat flux from the temperature gradient or the
+**  force-restore method):
+**
+**    f(Tg) = -Rabsb_soi + L(Tg) + H(Tg) + lE(Tg) + G(Tg) = 0
+**
+**  with a safeguarded Newton-bisection search in [223.15, 373.15] K that
+**  starts from the surface temperature of the previous time step. All the
+**  values a node needs are held in a tEBNode, set by
+**  tEvapoTrans::prepareEnergyBalance, so that the nodes of a time step can
+**  be solved together on the NUMTHREADS threads of tThreadPool
+**  (solveAll) or one at a time (solve), with the same results. The number
+**  of iterations of each solve is collected in a histogram.
+**
+***************************************************************************/
+
+#ifndef TENERGYBALANCE_H
+#define TENERGYBALANCE_H
+
+#include "src/tHydro/tPETKernel.h"
+
+#include <vector>
+
+#define kEBMaxIter 100  // Maximum iterations of the root search
+
+//=========================================================================
+//
+//
+//            Section 1: tEBNode and tEnergyBalance Declarations
+//
+//
+//=========================================================================
+
+// Energy balance of one node
+struct tEBNode
+{
+  // Inputs
+  double Rabsb;        // Shortwave absorbed by the soil [W m^-2]
+  double inLongR;      // Incoming longwave [W m^-2]
+  double v1;           // Sky view factor of the outgoing longwave
+  double Tso, Tlo;     // Surface and deep soil temperature [K], previous
+                       // step; Tso is the first guess of Tg
+  double airTemp;      // [C]
+  double coeffV, betaS, betaT, coeffKs, coeffCs;
+  tPETTerms air;       // Terms of the air and resistances
+
+  // Values of tEvapoTrans set before the solve, kept for the results
+  double SunHour, landRefGlobal, skyCover, skyCoverC;
+  int ID;
+
+  // Results for Tg
+  double Tg, f, G, H, LE, Rn, Ep, outLongR;
+  int iter;            // Iterations of the search
+  int converged;       // 0 if Tg is the first guess after kEBMaxIter
+  double lastTg, lastF;  // Last estimate and its f if not converged
+};
+
+class tEnergyBalance
+{
+ public:
+  tEnergyBalance();
+
+  // Evapotranspiration and ground heat flux options, time step [min]
+  void setOptions(int etOption, int gFluxOption, double timeStep);
+
+  void solve(tEBNode &) const;
+  void solveAll(std::vector<tEBNode> &, int n);
+
+  // Iteration histogram: entry i counts solves of i iterations, the last
+  // entry solves that did not converge
+  void record(const tEBNode &);
+  const std::vector<long> &getHistogram() const { return histogram; }
+  void writeHistogram() const;
+
+  // Checks the normalized depth of the force-restore method
+  static int validForceRestore(double coeffKs, double coeffCs);
+
+ private:
+  int etOption, gFluxOption;
+  double DTime;                  // Time step [s]
+  std::vector<long> histogram;
+  std::vector<std::vector<long> > threadHistogram;
+
+  double rootSearch(tEBNode &, double &Gso) const;
+  void functionAndDerivative(tEBNode &, double Tg, double &fv, double &dv,
+                             double &Gso) const;
+  double forceRestore(const tEBNode &, double Tg, int option,
+                      double &Gso) const;
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                       End of tEnergyBalance.h
+//
+//
+//=========================================================================
@@ -16,6 +16,12 @@
 #include "src/tHydro/tEvapoTrans.h"
 #include "src/Headers/globalIO.h"
 
+// Diurnal cycle of the stomatal resistance, by hour (see stomResist)
+static const double kStomRatio[24] = {
+	3.837, 3.589, 3.21, 2.43, 1.617, 1.196, 1.067, 1.014, 
+	0.995, 0.976, 0.976, 1.0, 1.053, 1.167, 1.354, 1.637,
+	2.043, 2.66, 3.215, 3.507, 3.689, 3.818, 3.923, 4.024};
+
 //=========================================================================
 //
 //
@@ -202,6 +208,7 @@ tEvapoTrans::tEvapoTrans(SimulationControl *simCtrPtr, tMesh<tCNode> *gridRef,
 tEvapoTrans::~tEvapoTrans()
 {
 	DeleteEvapoTrans();
+	ebSolver.writeHistogram();
 	Cout<<"tEvapoTrans Object has been destroyed..."<<endl;
 }
 
@@ -231,7 +238,19 @@ void tEvapoTrans::SetEvapTVariables(tInputFile &infile, tHydroModel *hydro)
 	tempLapseRate = infile.ReadItem(tempLapseRate,"TEMPLAPSE");//K/m -- RINEHART 2007 @ NMT
   
 	rainInt = infile.ReadItem(rainInt,  "RAININTRVL");
-	
+
+	// Terms of the air evaluated for all nodes at once (1, default) or
+	// node by node by the scalar functions (0)
+	petOption = 1;
+	if (infile.IsItemIn( "OPTPETKERNEL" ))
+		petOption = infile.ReadItem(petOption, "OPTPETKERNEL");
+	if (petOption != 0 && petOption != 1) {
+		Cout<<"\ntEvapoTrans: Warning: OPTPETKERNEL = "<<petOption
+			<<" is not valid, using 1"<<endl;
+		petOption = 1;
+	}
+	ebSolver.setOptions(evapotransOption, gFluxOption, timeStep);
+
 	if (evapotransOption != 0) {
 		landPtr = hydro->landPtr;
 		soilPtr = hydro->soilPtr;
@@ -409,15 +428,6 @@ void tEvapoTrans::initializeVariables()
 	panEvap = 0.0; coeffPan = 0.0; // Giuseppe June 2012	
 
 	coeffLAI = 0.0; //RINEHART 2007 @ NMT
-	//Horizon angles
-	ha0000 = 0.0; ha0225 = 0.0;
-	ha0450 = 0.0; ha0675 = 0.0;
-	ha0900 = 0.0; ha1125 = 0.0;
-	ha1350 = 0.0; ha1575 = 0.0;
-	ha1800 = 0.0; ha2025 = 0.0;
-	ha2250 = 0.0; ha2475 = 0.0;
-	ha2700 = 0.0; ha2925 = 0.0;
-	ha3150 = 0.0; ha3375 = 0.0;
 
 	hourlyTimeStep = 0; thisStation = 0; oldTimeStep = 0;
 	vapOption = tsOption = nrOption = 0;
@@ -524,6 +534,12 @@ void tEvapoTrans::SetEnvironment() {
     // obtained by re-defining lat/long values for each node)
     SetSunVariables();
 
+    // Terrain terms of the radiation are set up once, then the sun terms
+    // are applied to all nodes for this hour
+    if (!solar.isInitialized())
+        solar.initialize(gridPtr, shelterOption == 1 || shelterOption == 2);
+    solar.setSun(sinAlpha, alphaD, sunaz, Io, Tlinke);
+
     // If stochastic rainfall is used -- use simulated
     // hydrometeorological variables (spatially uniform)
     if (rainPtr->getoptStorm()) {
@@ -566,7 +582,6 @@ void tEvapoTrans::callEvapoPotential()
 	tMeshListIter<tCNode> nodeIter(gridPtr->getNodeList());
 	int cnt {};
 	int count {};
-	int tempIndex {};
 	double EP {};
 	double SkyC {};
 	
@@ -591,6 +606,18 @@ void tEvapoTrans::callEvapoPotential()
 	  }	
 	} 
 
+	// Forcing and land use values are gathered by node for the terms
+	// of the air, which are evaluated for all nodes before the energy
+	// balance of each node. The humidity data and pan coefficient of a
+	// node, found at the first step, are kept in its 'nodeState'
+	if (pet.size() != gridPtr->getNumActiveNodes()) {
+		tETNodeState first = {};
+		first.dewHumFlag = dewHumFlag;
+		first.coeffPan = coeffPan;
+		pet.resize(gridPtr->getNumActiveNodes());
+		nodeState.assign(gridPtr->getNumActiveNodes(), first);
+	}
+
 	// Loop through all nodes for this time period
 	cNode = nodeIter.FirstP();
 	while (nodeIter.IsActive()) {
@@ -621,60 +648,7 @@ void tEvapoTrans::callEvapoPotential()
 	  
 	  //Develop sky view factors and horizon angles, if necessary
 	  if ((shelterOption > 0)&&(shelterOption < 4)) { //CHANGED IN 2008
-	    for (tempIndex = 0; tempIndex < 16; tempIndex++) {
-	      switch ( tempIndex ) {
-	      case 0:
-		ha2700 = cNode->getHorAngle2700();
-		break;
-	      case 1:
-		ha2925 = cNode->getHorAngle2925();
-		break;
-	      case 2:
-		ha3150 = cNode->getHorAngle3150();
-		break;
-	      case 3:
-		ha3375 = cNode->getHorAngle3375();
-		break;
-	      case 4:
-		ha0000 = cNode->getHorAngle0000();
-		break;
-	      case 5:
-		ha0225 = cNode->getHorAngle0225();
-		break;
-	      case 6:
-		ha0450 = cNode->getHorAngle0450();
-		break;
-	      case 7:
-		ha0675 = cNode->getHorAngle0675();
-		break;
-	      case 8:
-		ha0900 = cNode->getHorAngle0900();
-		break;
-	      case 9:
-		ha1125 = cNode->getHorAngle1125();
-		break;
-	      case 10:
-		ha1350 = cNode->getHorAngle1350();
-		break;
-	      case 11:
-		ha1575 = cNode->getHorAngle1575();
-		break;
-	      case 12:
-		ha1800 = cNode->getHorAngle1800();
-		break;
-	      case 13:
-		ha2025 = cNode->getHorAngle2025();
-		break;
-	      case 14:
-		ha2250 = cNode->getHorAngle2250();
-		break;
-	      case 15:
-		ha2475 = cNode->getHorAngle2475();
-		break;
-	      default:
-		cout << "\nCheck tempInd -- did not exist or assign" << endl;
-	      }//end-switch
-	    }//end-for
+	    // Horizon angles are looked up in 'solar' (tSolarGeometry)
 	    shelterFactorGlobal = cNode->getSheltFact();
 	  }
 	  else if (shelterOption == 0) {
@@ -702,6 +676,9 @@ void tEvapoTrans::callEvapoPotential()
 	  }
 
 
+      dewHumFlag = nodeState[count].dewHumFlag;
+      coeffPan = nodeState[count].coeffPan;
+
       //updates meteorological variables if not in stochastic mode
       if (!rainPtr->getoptStorm()) {
           if (metdataOption == 1) {
@@ -751,14 +728,54 @@ void tEvapoTrans::callEvapoPotential()
 	  if (Ioption == 0) {
 	    cNode->setNetPrecipitation(rain);
 	  }
+
+	  gatherForcing(count);
+
+	  cNode = nodeIter.NextP();
+	  count++;
+	}
+
+	// Terms of the air of all nodes
+	if (petOption == 1)
+		pet.evaluate(kStomRatio[currentTime[3]], alphaD < 0.0);
+
+	// Energy balance of all nodes: radiation and node values are set
+	// node by node, the ground temperatures are found on the threads
+	int batched = (evapotransOption >= 1 && evapotransOption <= 3);
+	if (batched) {
+	  if ((int)ebNodes.size() < count)
+	    ebNodes.resize(count);
+	  cNode = nodeIter.FirstP();
+	  for (int i = 0; i < count; i++) {
+	    scatterForcing(i);
+	    betaFunc(cNode); 
+	    betaFuncT(cNode);
+	    Tso = cNode->getSurfTemp() + 273.15;
+	    Tlo = cNode->getSoilTemp() + 273.15;
+	    prepareEnergyBalance(cNode, ebNodes[i]);
+	    cNode = nodeIter.NextP();
+	  }
+	  ebSolver.solveAll(ebNodes, count);
+	}
+
+	// Loop through all nodes for the energy balance
+	cNode = nodeIter.FirstP();
+	for (int i = 0; i < count; i++) {
+
+	  scatterForcing(i);
 	  
-	  // Call Beta functions
-	  betaFunc(cNode); 
-	  betaFuncT(cNode);
+	  if (batched) {
+	    ebSolved = &ebNodes[i];
+	  }
+	  else {
+	    // Call Beta functions
+	    betaFunc(cNode); 
+	    betaFuncT(cNode);
 	  
-	  // Get Soil/Surface Temperature
-	  Tso = cNode->getSurfTemp() + 273.15;
-	  Tlo = cNode->getSoilTemp() + 273.15;
+	    // Get Soil/Surface Temperature
+	    Tso = cNode->getSurfTemp() + 273.15;
+	    Tlo = cNode->getSoilTemp() + 273.15;
+	  }
 	  
 	  // Calculate the Potential and Actual Evaporation
 	  if (evapotransOption == 1) {   
@@ -795,8 +812,8 @@ void tEvapoTrans::callEvapoPotential()
 	  }
 	  
 	  cNode = nodeIter.NextP();
-	  count++;
 	}
+	termsFromKernel = 0;
 
 	timeCount++; // bug fixed by Pat - June 2009
 
@@ -1488,12 +1505,9 @@ double tEvapoTrans::stomResist()
 {
 	double rs;
 	int currenthour;
-	double rsRatio[24] = {3.837, 3.589, 3.21, 2.43, 1.617, 1.196, 1.067, 1.014, 
-		0.995, 0.976, 0.976, 1.0, 1.053, 1.167, 1.354, 1.637,
-		2.043, 2.66, 3.215, 3.507, 3.689, 3.818, 3.923, 4.024};
 	
 	currenthour = currentTime[3];
-	rs = coeffRs*rsRatio[currenthour];
+	rs = coeffRs*kStomRatio[currenthour];
 	
 	// A simple way to constrain transpiration during hours 
 	// when there is no incoming solar radiation
@@ -1503,6 +1517,32 @@ double tEvapoTrans::stomResist()
 	return rs;
 }
 
+/***************************************************************************
+**
+** tEvapoTrans::setPETTerms() Function
+**
+** Evaluates the terms of the air used by the energy balance for the
+** current node with the functions above (the scalar path, see tPETKernel
+** for the evaluation of all nodes at once).
+**
+***************************************************************************/
+void tEvapoTrans::setPETTerms() 
+{
+	terms.vPress    = vaporPress();
+	terms.dewTemp   = dewTempC;
+	terms.rHumid    = rHumidityC;
+	terms.totPress  = totalPress();
+	terms.atmPress  = atmPressC;
+	terms.lam       = latentHeat();
+	terms.esat      = satVaporPress();
+	terms.rho       = densityMoist();
+	terms.cc        = clausClap();
+	terms.psy       = psychoMetric();
+	terms.ra        = aeroResist();
+	terms.windSpeed = windSpeedC;
+	terms.rs        = stomResist();
+}
+
 //=========================================================================
 //
 //
@@ -1766,7 +1806,10 @@ double tEvapoTrans::inShortWave(tCNode *cNode)
 	cNode->setShortAbsbVeg    (0.0);
 	cNode->setShortAbsbSoi    (0.0);
 
-	// Elevation, slope and aspect have been set before
+	// Elevation, slope and aspect have been set before, their terms are
+	// in 'solar' for the node
+	solarNode = gridPtr->getActiveIndex(cNode);
+	assert(solarNode >= 0);
 
 	// SKY2008Snow from AJR2007
 	SunHour = 0.0;
@@ -1775,9 +1818,10 @@ double tEvapoTrans::inShortWave(tCNode *cNode)
 
 		// Atmospheric turbidity Tlinke: 2.0-3.0 - for rural sites: CALIBRATE
 
-		// Estimate direct beam and diffuse fluxes for horizontal surface
-		// Raditaion fluxes 'Ic' and 'Id' will be estimated
-		DirectDiffuse(elevation);
+		// Direct beam and diffuse fluxes for horizontal surface 'Ic' and
+		// 'Id' (as DirectDiffuse(elevation), evaluated for all nodes)
+		Ic = solar.getBeam(solarNode);
+		Id = solar.getDiffuse();
 
         // because inShortR is incoming solar radiation--sky cover is already factored in--WR
 
@@ -1813,7 +1857,7 @@ double tEvapoTrans::inShortWave(tCNode *cNode)
 		//  Only do this computation if sheltering is turned on.
 		if (shelterOption < 4) { //CHANGED IN 2008
 
-			cosi = cos(slope)*sinAlpha + sin(slope)*cos(asin(sinAlpha))*cos(sunaz-aspect);
+			cosi = solar.getCosIncidence(solarNode);
 
 			// SKY2008Snow, AJR2008
 			//if (cosi >= 0.0)
@@ -2076,219 +2120,62 @@ double tEvapoTrans::compSkyCover() {
 **    direction, (c) set yesOrNo appropriately, and (d) returns whether or
 **    not the point can see the sun.
 **
+**    Steps (a) and (b) are done for all nodes by tSolarGeometry::setSun,
+**    this returns the result for the node of the last inShortWave call.
+**
 ***************************************************************************/
 double tEvapoTrans::aboveHorizon(int IDinside) {
   double yesOrNo;
-  int count(0);
-  int dummy(0);
 
-  for(count = 0; count < 16; count++ ) {
-
-    dummy = 0;
+  if (solar.isAboveHorizon(solarNode))
     yesOrNo = 1.0;
-    
-    
-    if ( ((-count*22.5 + 180*sunaz/3.1416) < 12.25) || 
-		    ((-count*22.5 + 180*sunaz/3.1416) >= -12.25) ) {
-
-	 switch ( count ) {
-	    case 0:
-		    
-	      dummy++;
-	      if ( (ha0000)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-	      
-	      
-	    case 1:
-	      
-	      dummy++;
-	      if ( (ha0225)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 2:
-
-	      dummy++;
-	      if ( (ha0450)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 3:
-
-	      dummy++;
-	      if ( (ha0675)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 4:
-	      
-	      dummy++;
-	      if ( (ha0900)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 5:
-
-	      dummy++;
-	      if ( (ha1125)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 6:
-
-	      dummy++;
-	      if ( (ha1350)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 7:
-
-	      dummy++;
-	      if ( (ha1575)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 8:
-
-	      dummy++;
-	      if ( (ha1800)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 9:
-
-	      dummy++;
-	      if ( (ha2025)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 10:
-
-	      dummy++;
-	      if ( (ha2250)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 11:
-
-	      dummy++;
-	      if ( (ha2475)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 12:
-
-	      dummy++;
-	      if ( (ha2700)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 13:
-
-	      dummy++;
-	      if ( (ha2925)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 14:
-
-	      dummy++;
-	      if ( (ha3150)*(180/3.1416) < alphaD)
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-	      
-	    case 15:
-
-	      dummy++;
-	      if ( (ha3375)*(180/3.1416) < alphaD )
-		yesOrNo = 1.0;
-	      else
-	        yesOrNo = 0.0;
-	      break;
-
-
-	    default:
-	      cout << "\ncheck tempInd in aboveHorizon()" << endl;
-	 }//switch
-    }//if (sun at correct angle)
-	
-   
-    if (dummy)
-      break;
-
-  }//for
-
-  if (dummy == 0)
-    cout << "Did not find horizon angle azimuth" << endl;
+  else
+    yesOrNo = 0.0;
   
   return yesOrNo;
-}  
+}
 
-#define TOLF   1.0e-5
 /***************************************************************************
 **
 **  energyBalance() Function
 **
 **  The function estimates the ground 'Tg' temperature that leads to
-**  the radiation balance at the ground in the element. 
+**  the radiation balance at the ground in the element. The balance is
+**  solved by tEnergyBalance, here for this node or, if 'ebSolved' is set,
+**  already with the other nodes of the time step (callEvapoPotential).
 **
 ***************************************************************************/
 double tEvapoTrans::energyBalance(tCNode* cNode)
 {
-	int cnt;
-	double f, df;
-	double Tg, eps;
-	double cosi,v;
-	double Isw; // Following were removed as shadows WR: Ic,Ics,Id,Ids,Is
-	double soilAbs = 0.0;
+	tEBNode node;
+	const tEBNode *eb = ebSolved;
 
+	if (!eb) {
+		prepareEnergyBalance(cNode, node);
+		ebSolver.solve(node);
+		ebSolver.record(node);
+		eb = &node;
+	}
+	ebSolved = nullptr;
+	termsFromKernel = 0;
+
+	return finishEnergyBalance(cNode, *eb);
+}
+
+/***************************************************************************
+**
+**  prepareEnergyBalance() Function
+**
+**  Computes the radiation and the terms of the air of the node and sets
+**  everything the solution of its energy balance needs to 'eb'. The
+**  surface temperature of the previous time step (Tso) is the first
+**  guess of the ground temperature.
+**
+***************************************************************************/
+void tEvapoTrans::prepareEnergyBalance(tCNode* cNode, tEBNode &eb)
+{
     SunHour=0;
-	Ic=Ics=Id=Ids=Is=Isw=0.0;
+	Ic=Ics=Id=Ids=Is=0.0;
     elevation = cNode->getZ(); //SMM 10172008
 	HeatTransferProperties( cNode );
 
@@ -2302,29 +2189,101 @@ double tEvapoTrans::energyBalance(tCNode* cNode)
 	// soilAbs = shortWave absorbed by soil, used to get ground temperature
 
 	inShortWave( cNode );
-	soilAbs = cNode->getShortAbsbSoi();
 
-	// Compute resistances for turbulent fluxes
-	Rah  = aeroResist();
-	Rstm = stomResist();
+	// Terms of the air and resistances for turbulent fluxes, from
+	// tPETKernel for all nodes or from the scalar functions
+	if (!termsFromKernel)
+		setPETTerms();
+	termsFromKernel = 0;
+	Rah  = terms.ra;
+	Rstm = terms.rs;
 
-	Tg = Tso;  // Surface toK from the previous time step
-	
-	// Iteratively find the ground temperature
-	Tg = rtsafe_mod_energy(cNode, 223.15, 373.15, 
-						   TOLF, Tg, soilAbs, &eps, &cnt);
-	
-	// To make sure the fluxes correspond to the obtained Tg
-	FunctionAndDerivative(cNode, Tg, f, df, soilAbs);
+	if (gFluxOption == 2 && !tEnergyBalance::validForceRestore(coeffKs, coeffCs)) {
+		cout<<"\nWarning: Normalized depth for Force-Restore Equation out of ";
+		cout<<"\nvalid range (0 <= ddel/d1 <= 5). Please modify the soil heat ";
+		cout<<"\nconductivy (ks) and heat capacity (cs) accordingly.";
+		cout<<"\n\nExiting Program..."<<endl<<endl;
+		exit(1);
+	}
+
+	eb.Rabsb = cNode->getShortAbsbSoi();
+	eb.inLongR = inLongR;
+	if (shelterOption < 3)
+		eb.v1 = shelterFactorGlobal;
+	else
+		eb.v1 = 1;
+	eb.Tso = Tso;  // Surface toK from the previous time step
+	eb.Tlo = Tlo;
+	eb.airTemp = airTemp;
+	eb.coeffV = coeffV;
+	eb.betaS = betaS;
+	eb.betaT = betaT;
+	eb.coeffKs = coeffKs;
+	eb.coeffCs = coeffCs;
+	eb.air = terms;
+
+	eb.SunHour = SunHour;
+	eb.landRefGlobal = landRefGlobal;
+	eb.skyCover = skyCover;
+	eb.skyCoverC = skyCoverC;
+	eb.ID = ID;
+}
+
+/***************************************************************************
+**
+**  finishEnergyBalance() Function
+**
+**  Sets the solution of the energy balance of the node to tEvapoTrans and
+**  to the node. The values set by prepareEnergyBalance are set again, as
+**  other nodes may have been prepared in between.
+**
+***************************************************************************/
+double tEvapoTrans::finishEnergyBalance(tCNode* cNode, const tEBNode &eb)
+{
+	double Tg = eb.Tg;
+
+	inLongR = eb.inLongR;
+	SunHour = eb.SunHour;
+	landRefGlobal = eb.landRefGlobal;
+	skyCover = eb.skyCover;
+	skyCoverC = eb.skyCoverC;
+	betaS = eb.betaS;
+	betaT = eb.betaT;
+	Tso = eb.Tso;
+	Tlo = eb.Tlo;
+	terms = eb.air;
+	Rah = terms.ra;
+	Rstm = terms.rs;
+	windSpeedC = terms.windSpeed;
+	atmPressC = terms.atmPress;
+
+	// Fluxes for Tg
+	hFlux   = eb.H;
+	lFlux   = eb.LE;
+	netRadC = eb.Rn;
+	gFlux   = eb.G;
+	potEvap = eb.Ep;
+	outLongR = eb.outLongR;
+	surfTempC = surfTemp = Tg - 273.15;
+	if (gFluxOption == 2)
+		Gso = eb.G;
+
+	if (!eb.converged) {
+		cerr<<"\n\t\ttEvapotrans: Energy balance: NO convergence in "<<kEBMaxIter<<"\n";
+		cerr<<"\t ERROR = "<<eb.lastF
+			<<";  Initial = "<<eb.Tso
+			<<";  Last estimate = "<<eb.lastTg<<";  ID = "<<eb.ID
+			<<"\n\t##### Initial value is kept."<<endl<<endl<<flush;
+	}
 	
 	if (simCtrl->Verbose_label == 'Y' && ID == VerbID) {
 		cout<<"\n\t******** GROUND ENERGY BALANCE: ********"<<endl;
-		cout<<"\tRabsb_soi = "<<soilAbs<<";   NetLongRad = "<<(outLongR-inLongR)<<endl;
+		cout<<"\tRabsb_soi = "<<eb.Rabsb<<";   NetLongRad = "<<(outLongR-inLongR)<<endl;
 		cout<<"\t    lEsoi = "<<lFlux
 			<<";\t Hsoi = "<<hFlux<<";\t G = "<<gFlux<<endl<<flush;
 		cout<<"\n\t---> Tg = "<<Tg-273.15
 			<<";\t Tair = "<<airTemp<<endl<<flush;
-		cout<<"\tImbalance (fT) = "<<f<<endl;
+		cout<<"\tImbalance (fT) = "<<eb.f<<endl;
 		cout<<"\t****************************************"<<endl<<endl;
 		}
 
@@ -2355,7 +2314,6 @@ double tEvapoTrans::energyBalance(tCNode* cNode)
 	
 	return potEvap;
 }
-#undef TOLF
 
 /*****************************************************************************\
 **  
@@ -2376,341 +2334,6 @@ void tEvapoTrans::HeatTransferProperties(tCNode* cNode)
 	
 	SoilHeatDiffTh = SoilHeatCondTh/SoilHeatCpctTh; }
 
-#define MAXITER 100
-/*****************************************************************************\
-**  
-**  rtsafe_mod_energy()
-**
-**  Finds a root of the polynomial which lies in the range [x1 and x2] 
-**  starting from initial guess - xguess. Accuracy of estimation is xacc. 
-**  c1, c2, c3 are the polynomial coefficients
-**
-**  rtsafe_mod(C1, C2, C3, 0.0, 1.0, DX_TOL, VegT->getAllocationLeaf());
-** 
-\*****************************************************************************/
-double tEvapoTrans::rtsafe_mod_energy(tCNode* cNode, double x1, double x2,
-									  double xacc, double xguess,
-									  double Rabsb_soi, double *eps, int *cnt)
-{
-	int j;
-	double df,dx,dxold,f,fh,fl;
-	double temp,xh,xl,rts;
-	fh=fl=df=dx=0.0;
-	
-	(*eps) = 0.0;
-	(*cnt) = 0;
-	
-	// -- 'fl' & 'fh' below are the evaluation function values --
-	// -- corresponding to arguments 'x1' and 'x2' --
-	FunctionAndDerivative(cNode, x1, fl, df, Rabsb_soi);
-	if (fl == 0.0) return x1;
-	
-	FunctionAndDerivative(cNode, x2, fh, df, Rabsb_soi);
-	if (fh == 0.0) return x2;
-	
-	if ((fl > 0.0 && fh > 0.0) || (fl < 0.0 && fh < 0.0)) {
-		//cerr<<"tEvapotrans: Root must be bracketed by negative "
-		//    <<"and positive f_n values!"<<endl;
-		//cerr<<"\tfl = "<<fl<<"; fh = "<<fh<<"; xguess = "<<xguess<<endl<<flush;
-		//cerr<<"\tID = "<<ID<<"; wind = "<<windSpeed<<"; inShortR = "<<inShortR
-		//	 <<"; airTemp = "<<airTemp<<endl<<endl<<flush;
-		//double tt = 1.0;
-		//cout<<1./(tt-1.0)<<endl;
-	}
-	
-	(*eps) = 9999.0;
-	(*cnt) = 0;
-	
-	if (fl < 0.0) {  // Orient the search so that f(xl) < 0
-		xl = x1;
-		xh = x2;
-	}
-	else {
-		xh = x1;
-		xl = x2;
-	}
-	
-	rts = xguess;         // A better guess than central value
-	dxold = fabs(x2-x1);  // the "stepsize before last",
-	dx = dxold;           // and the last step
-	
-	FunctionAndDerivative(cNode, rts, f, df, Rabsb_soi);
-	
-	for (j=1; j <= MAXITER; j++) {  // Loop over allowed iterations
-		(*eps) = f;
-		(*cnt)=j;
-		if ((((rts-xh)*df-f)*((rts-xl)*df-f) > 0.0) // Bisect if Newton is out of range
-			|| (fabs(2.0*f) > fabs(dxold*df))) {    // or not decreasing fast enough
-			dxold = dx;
-			dx = 0.5*(xh-xl);
-			rts = xl+dx;
-			(*eps) = f;
-			if (xl == rts) return rts; // Change in root is
-		}                              // negligible, take it
-		else {
-			dxold = dx;
-			dx = f/df;
-			temp = rts;
-			rts -= dx;
-			(*eps) = f;
-			if (temp == rts) return rts;
-		}
-		if (fabs(dx) < xacc) return rts; // Convergence criterion
-		
-		FunctionAndDerivative(cNode, rts, f, df, Rabsb_soi);
-		(*eps) = f;
-		
-		if (f < 0.0) // <-- Maintain the bracket on the root
-			xl=rts;
-		else
-			xh=rts;
-	}
-	cerr<<"\n\t\ttEvapotrans: Energy balance: NO convergence in "<<MAXITER<<"\n";
-	cerr<<"\t ERROR = "<<f
-		<<";  Initial = "<<xguess
-		<<";  Last estimate = "<<rts<<";  ID = "<<ID
-		<<"\n\t##### Initial value is kept."<<endl<<endl<<flush;
-	return xguess;
-}
-#undef MAXITER
-
-/***************************************************************************
-**
-**  FunctionAndDerivative()
-** 
-**  Returns value of the function in non-closed form (fv) as well as 
-**  the value of its derivative (dv). Used in Newton iterative procedure  
-**  to find root of an equation.
-**
-***************************************************************************/
-void tEvapoTrans::FunctionAndDerivative(tCNode* cNode,
-										double Tg, double& fv, double& dv, 
-										double Rabsb_soi)
-{
-	double Rn, Lsoi, Hsoi, lEsoi, G(0), dQ, num;
-	double Ep(0), Eps, LE(0), H(0), ccTs;
-	double alpha = 1.26;
-	double sigma = 5.67E-8;
-	double Es = 0.98;   //Calibrated for site (may need to be land parameter)
-	double Cp = 1013.0;
-	double Ch = 0.0025;
-	double rv = 461.5;
-	double rho    = densityMoist();
-	double P      = totalPress();
-	double satVap = satVaporPress();
-	double es     = vaporPress();
-	double lam    = latentHeat();
-	double cc     = clausClap();
-	double psy    = 100.0*psychoMetric();
-	double denom   = ((cc/psy) + 1.0);
-	double denomrs = ((cc/psy) + 1.0 + Rstm/Rah);
-	double pi = 4.0*atan(1.0);
-	double DTime  = timeStep*60.0;  //Seconds
-	
-	double dRndTg(0), dLdTg, dHdTg(0), dlEdTg(0), dGdTg(0);
-	double soiFct, vegFct, esat, qhSatTs, qhTa;
-	double v1;
-
-	if (shelterOption < 3)
-		v1 = shelterFactorGlobal;
-	else
-		v1 = 1;
-
-	// Set temperature to the node
-	cNode->setSurfTemp(Tg - 273.15);
-	
-	// 1.) == NET longwave radiation ==
-	inLongR  = cNode->getLongRadIn();
-	outLongR = v1*Es*sigma*pow(Tg,4.0);
-	Lsoi = outLongR - inLongR;
-	
-	// 2.) == Ground heat flux ==
-	if (gFluxOption == 1) { // Surface toC from the previous time step Tso is used
-        G = pow((4.0 * coeffKs * coeffCs / (pi * DTime)), 0.5) * (Tg - Tso);
-    }
-	else if (gFluxOption == 2) {
-        G = ForceRestore(Tg, 1);
-    }
-	
-	// 3.) == NET radiation at the surface ==
-	Rn = Rabsb_soi - Lsoi;
-	
-	// 4.) == Sensible heat flux ==
-	if (evapotransOption == 1 || evapotransOption == 3) {
-        H = rho * Cp * (Tg - (airTemp + 273.15)) / Rah;
-    }
-	else if (evapotransOption == 2) {
-        H = rho * Cp * (Tg - (airTemp + 273.15)) * Ch * windSpeedC;
-    }
-	Hsoi = H;
-	
-	// 5.) == Latent heat flux ==
-	if (evapotransOption == 1) {
-		dQ = (0.622/P)*(satVap-es)*rho*lam/Rah;
-		soiFct = (1.0-coeffV)*betaS;
-		vegFct = coeffV*betaT;
-		num = (cc/psy)*(Rn-G) + dQ;
-		
-		Eps = num/denom/lam;
-		Ep  = num/denomrs/lam;
-		LE = soiFct*lam*Eps + vegFct*lam*Ep;
-		Ep *= (denomrs/denom);
-	}
-	else if (evapotransOption == 2) {
-		esat = satVaporPress(Tg-273.15);
-		ccTs = (lam*esat)/(rv*pow(Tg,2.0));  
-		qhSatTs = (0.622/P)*esat;
-		qhTa    = (0.622/P)*es;
-		(qhSatTs > qhTa ? Ep = rho*Ch*(qhSatTs-qhTa)*windSpeedC : Ep = 0.0);
-		LE = Ep*lam*betaS;
-	}
-	else if (evapotransOption == 3) {
-		(Rn > G ? Ep = (alpha/lam)*(Rn-G)*((cc/psy)/denom) : Ep = 0.0);
-		LE = Ep*lam*betaS;
-	}
-	lEsoi = LE;
-	
-	
-	// ----------------------------------------------
-	// Energy Balance as function of soil temperature
-	fv = -Rabsb_soi + Lsoi + Hsoi + lEsoi + G;
-	
-	
-	// Compute partial derivatives
- 	dLdTg = 4.0*Es*sigma*pow(Tg,3.0);
-	dRndTg = -dLdTg;
-	
-	if (gFluxOption == 1)
-		dGdTg = pow((4.0*coeffKs*coeffCs/(pi*DTime)),0.5);
-	else if (gFluxOption == 2)
-		dGdTg = ForceRestore(Tg, 2); 
-	
-	if (evapotransOption == 1) {
-		dHdTg = rho*Cp/Rah;
-		dlEdTg = soiFct*(cc/psy)*(dRndTg-dGdTg)/denom
-			+ vegFct*(cc/psy)*(dRndTg-dGdTg)/denomrs;
-	}
-	else if (evapotransOption == 2) {
-		dHdTg = rho*Cp*Ch*windSpeedC;
-		dlEdTg = lam*rho*Ch*windSpeedC*(0.622/P)*ccTs*betaS;
-	}
-	else if (evapotransOption == 3) {
-		dHdTg = rho*Cp/Rah;
-		dlEdTg = betaS*(alpha)*((cc/psy)/denom)*(dRndTg - dGdTg);
-	}
-	
-	// ----------------------------------------------
-	// Derivative with respect to the ground temperature
-	dv = dLdTg + dHdTg + dlEdTg + dGdTg;        
-	
-	// Assign values to the 
-	hFlux   = Hsoi;
-	lFlux   = lEsoi;
-	netRadC = Rn;
-	gFlux   = G;
-	potEvap = Ep;
-	surfTempC = surfTemp = Tg - 273.15;
-	
-	if (simCtrl->Verbose_label == 'Y' && ID == VerbID && false) {
-		cout<<"\n ---------> Tg = "<<Tg-273.15<<endl<<flush;
-		cout<<"\t---> Tair = "<<airTemp<<"; dewTemp = "<<dewTemp
-			<<"; dewTempC = "<<dewTempC<<";"<<endl;
-		cout<<"\trHumidity = "<<rHumidity<<"; vapPress = "<<vPress<<";"<<endl;
-		cout<<"\tatmPress = "<<atmPress<<"; windSpeed = "<<windSpeed
-			<<"; skyCover = "<<skyCover<<";"<<endl;
-		cout<<"== GROUND ENERGY BALANCE: =="<<endl;
-		cout<<"\tInShortR (Rabsb_soi) = "<<Rabsb_soi<<endl
-			<<"\tInLongR = "<<inLongR
-			<<";\t OutLongR = "<<(0.94*5.67E-8*pow(Tg,4.0))
-			<<"\t NetLongRsoi = "<<Lsoi<<";"<<endl;
-		cout<<"\tlEsoi = "<<lEsoi
-			<<";\t Hsoi = "<<Hsoi<<";\t G = "<<G<<endl<<flush;
-		cout<<"\tdLdTg = "<<dLdTg<<";\t dHdTg = "<<dHdTg
-			<<";\t dlEdTg = "<<dlEdTg<<";\t dGdTg = "<<dGdTg<<endl<<flush;
-		cout<<">>>>>>> fT = "<<fv<<";\t dfdT = "<<dv<<endl<<flush;
-	}
-	}
-
-/***************************************************************************
-**
-** tEvapoTrans::ForceRestore()
-** TODO see if the computations here can be optimized, notably pow is expensive -WR
-** Calculates the ground heat flux and the deep soil temperature using
-** the Force-restore method. Depending on the option used (1 or 2) this
-** function, can return G or dG/dTg. See Lin (1980) and Hu and Islam (1995).
-**
-** The force-restore expression for G(0,t) is:
-** 
-** G(0,t) = 0.5*cs*d1( alpha* dTg/dt + w1*(Tg - Tl))     (1)
-**
-** where w1 = daily frequency [sec-1]
-**       k = heat diffusivity = ks/cs  [m2/s]
-**       d1 = damping depth [m] = (2*k/w1)^0.5
-**       cs = heat capacity [J/m3K]
-**       del = depth of upper soil layer = 0.1 m
-**       Tg = soil heat in upper del layer [K]
-**       Tl = deep soil heat [K]
-**
-** dTl/dt = G(0,t)/(cs*(365pi)^0.5*d1         (2)
-**
-** Derivatives approximated at (T(t) - T(t-1))/dt
-** Equation (2) solved for Tl(t) and substituted in (1)
-** Equation (1) solved for G(0,t)
-**
-** dG/dTg = (0.5*cs*d1)/(1+(w1*dt)/(2*pow((365*pi),0.5)))*[alpha/dt + w]
-**
-***************************************************************************/
-double tEvapoTrans::ForceRestore(double Ts, int option) 
-{
-	double w1, d1, k, cs, ddel, pi, dt;    // input
-	double alpha, nd, G, Tg, Tl, dg, dTgdt, dGdTg, dTK, tempo = {};
-	
-	dTK = 0.001;                  // Delta T 
-	pi = 4.0*atan(1.0);
-	w1 = 2.*pi/86400.;            // Daily frequency [s^-1]
-	dt = timeStep*60.0;           // Time step [s]
-	
-	cs = coeffCs;                 // Heat capacity     [J m^-3 K^-1]
-	k  = coeffKs/coeffCs;         // Heat diffusivity  [m^2 s^-1]
-	d1 = pow((2.0*k/w1),0.5);     // Damping depth of the diurnal temperature [m] (not Tlo)
-				      // d1*sqrt(365)               // Penetration depth of the annual temperature wave  [m]
-	ddel = 0.1;                   // Soil layer thickness  [m]
-
-	//ERV 04/2009 soil layer thickness was 0.01 m (1 cm)
-	
-	nd = ddel/d1;                  // Normalized depth
-	
-	if (nd >= 0.0 && nd <= 5.0) {
-		alpha = 1+0.943*nd+0.223*pow(nd,2.0)+0.0168*pow(nd,3.0)-0.00527*pow(nd,4.0);
-	}
-	else {
-		cout<<"\nWarning: Normalized depth for Force-Restore Equation out of ";
-		cout<<"\nvalid range (0 <= ddel/d1 <= 5). Please modify the soil heat ";
-		cout<<"\nconductivy (ks) and heat capacity (cs) accordingly.";
-		cout<<"\n\nExiting Program..."<<endl<<endl;
-		exit(1);
-	}
-	
-	Tg = Ts;     // degree Kelvin
-	Tl = Tlo;    // degree Kelvin  
-    
-	dg = (0.5*cs*d1)/(1.0 + (w1*dt)/(2.0*pow(365.,0.5)));
-	
-	if (option == 1) {
-		dTgdt = (Tg - Tso)/dt;
-		G = dg*(alpha*dTgdt + w1*(Tg - Tl)); 
-		Gso = G;   //Computed value of G at i-th iteration
-		tempo = G;
-	}
-	// Numerical approximation of the gradient 
-	else if (option == 2) {
-		dTgdt = (Tg+dTK - Tso)/dt;
-		dGdTg = (dg*(alpha*dTgdt + w1*(Tg - Tl)) - Gso)/dTK;
-		tempo = dGdTg;
-	}
-	return tempo;
-}
-
 /***************************************************************************
 **
 ** tEvapoTrans::DeriveAspect() Function
@@ -3075,6 +2698,109 @@ void tEvapoTrans::setToNode(tCNode* cNode)
 	cNode->setLandFact(landRefGlobal);	
 	cNode->addRSin(inShortR*3600.0); }
 
+/***************************************************************************
+**
+** tEvapoTrans::gatherForcing() and scatterForcing() Functions
+**
+** gatherForcing() stores the forcing and land use values of the node with
+** active index 'i', as set by the first node loop of callEvapoPotential,
+** in the inputs of tPETKernel and in 'nodeState'. scatterForcing() sets
+** them back before the energy balance of the node, with the terms of the
+** air and the corrected humidity values (as from vaporPress) taken from
+** the kernel.
+**
+***************************************************************************/
+void tEvapoTrans::gatherForcing(int i) 
+{
+	tETNodeState &n = nodeState[i];
+
+	pet.airTemp[i] = airTemp;
+	pet.humFlag[i] = dewHumFlag;
+	if (dewHumFlag == 0)
+		pet.humidity[i] = rHumidity;
+	else if (dewHumFlag == 1)
+		pet.humidity[i] = dewTemp;
+	else if (dewHumFlag == 2)
+		pet.humidity[i] = vPress;
+	pet.atmPress[i] = atmPress;
+	pet.windSpeed[i] = windSpeed;
+	pet.vegHeight[i] = coeffH;
+	pet.vegFrac[i] = coeffV;
+	pet.stomRes[i] = coeffRs;
+
+	n.ID = ID;
+	n.skycover_flag = skycover_flag;
+	n.dewHumFlag = dewHumFlag;
+	n.rain = rain;
+	n.elevation = elevation;
+	n.slope = slope;
+	n.aspect = aspect;
+	n.shelterFactorGlobal = shelterFactorGlobal;
+	n.coeffAl = coeffAl;
+	n.coeffKt = coeffKt;
+	n.coeffKs = coeffKs;
+	n.coeffCs = coeffCs;
+	n.coeffSE = coeffSE;
+	n.coeffST = coeffST;
+	n.skyCover = skyCover;
+	n.inShortR = inShortR;
+	n.panEvap = panEvap;
+	n.coeffPan = coeffPan;
+	n.surfTemp = surfTemp;
+	n.netRad = netRad;
+}
+
+void tEvapoTrans::scatterForcing(int i) 
+{
+	const tETNodeState &n = nodeState[i];
+
+	ID = n.ID;
+	skycover_flag = n.skycover_flag;
+	dewHumFlag = n.dewHumFlag;
+	airTemp = pet.airTemp[i];
+	if (dewHumFlag == 0)
+		rHumidity = pet.humidity[i];
+	else if (dewHumFlag == 1)
+		dewTemp = pet.humidity[i];
+	else if (dewHumFlag == 2)
+		vPress = pet.humidity[i];
+	atmPress = pet.atmPress[i];
+	windSpeed = pet.windSpeed[i];
+	coeffH = pet.vegHeight[i];
+	coeffV = pet.vegFrac[i];
+	coeffRs = pet.stomRes[i];
+
+	rain = n.rain;
+	elevation = n.elevation;
+	slope = n.slope;
+	aspect = n.aspect;
+	shelterFactorGlobal = n.shelterFactorGlobal;
+	coeffAl = n.coeffAl;
+	coeffKt = n.coeffKt;
+	coeffKs = n.coeffKs;
+	coeffCs = n.coeffCs;
+	coeffSE = n.coeffSE;
+	coeffST = n.coeffST;
+	skyCover = n.skyCover;
+	inShortR = n.inShortR;
+	panEvap = n.panEvap;
+	coeffPan = n.coeffPan;
+	surfTemp = n.surfTemp;
+	netRad = n.netRad;
+
+	if (petOption == 1) {
+		pet.getTerms(i, terms);
+		termsFromKernel = 1;
+		vPress = vPressC = terms.vPress;
+		dewTemp = dewTempC = terms.dewTemp;
+		rHumidity = rHumidityC = terms.rHumid;
+		atmPressC = terms.atmPress;
+		windSpeedC = terms.windSpeed;
+	}
+	else
+		vaporPress();
+}
+
 //=========================================================================
 //
 //
@@ -5575,22 +5301,9 @@ void tEvapoTrans::writeRestart(fstream & rStr) const
   BinaryWrite(rStr, shelterFactorGlobal); 
   BinaryWrite(rStr, landRefGlobal);
   BinaryWrite(rStr, horizonAngle);
-  BinaryWrite(rStr, ha0000); 
-  BinaryWrite(rStr, ha0225); 
-  BinaryWrite(rStr, ha0450); 
-  BinaryWrite(rStr, ha0675); 
-  BinaryWrite(rStr, ha0900); 
-  BinaryWrite(rStr, ha1125);
-  BinaryWrite(rStr, ha1350); 
-  BinaryWrite(rStr, ha1575); 
-  BinaryWrite(rStr, ha1800); 
-  BinaryWrite(rStr, ha2025); 
-  BinaryWrite(rStr, ha2250);
-  BinaryWrite(rStr, ha2475);
-  BinaryWrite(rStr, ha2700);
-  BinaryWrite(rStr, ha2925);
-  BinaryWrite(rStr, ha3150);
-  BinaryWrite(rStr, ha3375);
+  // Slots of the former per-sector horizon angles, kept for the layout
+  for (int k = 0; k < 16; k++)
+    BinaryWrite(rStr, 0.0);
   BinaryWrite(rStr, tempLapseRate);
   BinaryWrite(rStr, SunHour);
   BinaryWrite(rStr, AtFirstTimeStepLUFlag);
@@ -5633,6 +5346,8 @@ void tEvapoTrans::writeRestart(fstream & rStr) const
 
 void tEvapoTrans::readRestart(fstream & rStr)
 {
+  double unused;
+
   BinaryRead(rStr, VerbID);
   BinaryRead(rStr, vapOption);
   BinaryRead(rStr, tsOption);
@@ -5747,22 +5462,9 @@ void tEvapoTrans::readRestart(fstream & rStr)
   BinaryRead(rStr, shelterFactorGlobal);
   BinaryRead(rStr, landRefGlobal);
   BinaryRead(rStr, horizonAngle);
-  BinaryRead(rStr, ha0000);
-  BinaryRead(rStr, ha0225);
-  BinaryRead(rStr, ha0450);
-  BinaryRead(rStr, ha0675);
-  BinaryRead(rStr, ha0900);
-  BinaryRead(rStr, ha1125);
-  BinaryRead(rStr, ha1350);
-  BinaryRead(rStr, ha1575);
-  BinaryRead(rStr, ha1800);
-  BinaryRead(rStr, ha2025);
-  BinaryRead(rStr, ha2250);
-  BinaryRead(rStr, ha2475);
-  BinaryRead(rStr, ha2700);
-  BinaryRead(rStr, ha2925);
-  BinaryRead(rStr, ha3150);
-  BinaryRead(rStr, ha3375);
+  // Slots of the former per-sector horizon angles
+  for (int k = 0; k < 16; k++)
+    BinaryRead(rStr, unused);
   BinaryRead(rStr, tempLapseRate);
   BinaryRead(rStr, SunHour);
   BinaryRead(rStr, AtFirstTimeStepLUFlag);
@@ -24,9 +24,23 @@
 
 #include "src/Headers/Inclusions.h"
 #include "src/tRasTin/tRainfall.h"
+#include "src/tHydro/tSolarGeometry.h"
+#include "src/tHydro/tPETKernel.h"
+#include "src/tHydro/tEnergyBalance.h"
 
 class tRainfall;
 
+// Values of a node set by the forcing and land use part of the node loop
+// of callEvapoPotential that the energy balance part reads, other than
+// the inputs of tPETKernel
+struct tETNodeState
+{
+  int ID, skycover_flag, dewHumFlag;
+  double rain, elevation, slope, aspect, shelterFactorGlobal;
+  double coeffAl, coeffKt, coeffKs, coeffCs, coeffSE, coeffST;
+  double skyCover, inShortR, panEvap, coeffPan, surfTemp, netRad;
+};
+
 //=========================================================================
 //
 //
@@ -78,7 +92,6 @@ class tEvapoTrans
   void betaFuncT(tCNode *);
   void ComputeETComponents(tIntercept *, tCNode *, int, int);
   void DeriveAspect();
-  void FunctionAndDerivative(tCNode *, double, double &, double &,  double);
   void HeatTransferProperties(tCNode *);
   void initialLUGridAssignment();
   void LUGridAssignment();
@@ -102,11 +115,15 @@ class tEvapoTrans
   double inLongWave(tCNode *);
   double inShortWave(tCNode *);
   double energyBalance(tCNode*);
+  void prepareEnergyBalance(tCNode*, tEBNode &);
+  double finishEnergyBalance(tCNode*, const tEBNode &);
+  void setPETTerms();
+  void gatherForcing(int);
+  void scatterForcing(int);
 
   // SKY2008Snow from AJR2007
   double compSkyCover();//find sky cover if marker is there -- RINEHART 2007 @ NMT
   double aboveHorizon(int);//check if sun is above horizon -- RINEHART 2007 @ NMT
-  double ForceRestore(double, int); 
   double ComputeHourAngle(double, double);
   double ApproximateEP();
   double getinShortWave() const;
@@ -120,8 +137,6 @@ class tEvapoTrans
   double getDeltaAngle() const;
   double getPhiAngle() const;
   double getTauAngle() const;
-  double rtsafe_mod_energy(tCNode*, double, double, double, 
-			   double, double, double *, int *);
 
   void writeRestart(fstream &) const;
   void readRestart(fstream &);
@@ -186,16 +201,19 @@ class tEvapoTrans
   double coeffSE{}, coeffST{};
   // SKY2008Snow from AJR2007
   //new for sheltering algorithm
-  //	RMK: THE HA* VARIABLES SHOULD ACTUALLY BE HANDLED IN AN ARRAY
-  //	BUT I COULDN'T GET THE INTERACTION W/ A POINTER IN TCNODE TO
-  //	WORK CORRECTLY
-  //
   //	RINEHART 2007 @ NEW MEXICO TECH
   double shelterFactorGlobal{}, landRefGlobal{};
   double horizonAngle{};
-  double ha0000{}, ha0225{}, ha0450{}, ha0675{}, ha0900{}, ha1125{};
-  double ha1350{}, ha1575{}, ha1800{}, ha2025{}, ha2250{}, ha2475{};
-  double ha2700{}, ha2925{}, ha3150{}, ha3375{};
+  tSolarGeometry solar;  // Terrain and sun terms of the radiation by node
+  int solarNode{};       // Active index of the node in inShortWave
+  tPETKernel pet;        // Terms of the air of all nodes (OPTPETKERNEL)
+  std::vector<tETNodeState> nodeState;  // Gathered with 'pet'
+  tPETTerms terms{};     // Terms of the air of the current node
+  int petOption{};       // 1 - batched terms (tPETKernel), 0 - scalar
+  int termsFromKernel{}; // 'terms' taken from 'pet' for the next balance
+  tEnergyBalance ebSolver;        // Ground temperature of the nodes
+  std::vector<tEBNode> ebNodes;   // Balances of a time step (solveAll)
+  const tEBNode *ebSolved{};      // Solved balance for the next energyBalance
   //information for lapse rates
   //  RINEHART 2007 @ NEW MEXICO TECH
   double tempLapseRate{}; //K/m -- make sure that time steps are consistent
@@ -139,12 +139,94 @@ void tHydroModel::SetHydroMVariables(tInputFile &infile,
 	TotRain = 0.;
 	TotGWchange = 0.;
 	TotMoist = 0.;
+
+	// Optional contiguous store of the node state variables
+	if (infile.IsItemIn( "OPTNODESTATE" ))
+		stateOption = infile.ReadItem(stateOption, "OPTNODESTATE");
+	else
+		stateOption = 0; //Default option
+	SetNodeState();
+
+	// Quiescent nodes: updated every OPTQUIESCENT steps while they have
+	// no water input and their storage changes by less than QUIESCENTTOL
+	// [mm/hr] (K > 1; 0 or 1, the default, update every node every step)
+	quietOption = 0;
+	if (infile.IsItemIn( "OPTQUIESCENT" ))
+		quietOption = infile.ReadItem(quietOption, "OPTQUIESCENT");
+	if (quietOption < 0) {
+		Cout<<"\ntHydroModel: Warning: OPTQUIESCENT = "<<quietOption
+			<<" is not valid, using 0"<<endl;
+		quietOption = 0;
+	}
+#ifdef PARALLEL_TRIBS
+	// Boundary nodes exchange fluxes with other processors at every step
+	if (quietOption > 1) {
+		Cout<<"\ntHydroModel: Warning: OPTQUIESCENT is not available in "
+			<<"the parallel version, using 0"<<endl;
+		quietOption = 0;
+	}
+#endif
+	quietTol = 0.01;
+	if (infile.IsItemIn( "QUIESCENTTOL" ))
+		quietTol = infile.ReadItem(quietTol, "QUIESCENTTOL");
+	quietSteps.clear();
+	quietDepth.clear();
+	quietRate.clear();
+	quietCount.clear();
+
+	// The workers are copies of the options and node list read above,
+	// they are rebuilt by the next threaded step (BuildNodeSchedule())
+	for (size_t t=0; t < workers.size(); t++)
+		delete workers[t];
+	workers.clear();
+	levelPtr.clear();
+}
+
+/*************************************************************************
+**
+**  tHydroModel::SetNodeState()
+**
+**  With OPTNODESTATE = 1, the dynamic variables listed in tCNodeState.h
+**  of the active nodes are moved to a tCNodeState, in the order of the
+**  active node list, so that whole-domain updates (see Reset()) work on
+**  contiguous arrays.
+**
+*************************************************************************/
+void tHydroModel::SetNodeState()
+{
+	if (stateOption != 1) {
+		delete nodeState;
+		nodeState = nullptr;
+		return;
+	}
+
+	if (!nodeState)
+		nodeState = new tCNodeState();
+	nodeState->attach(gridPtr->getActiveNodes());
+
+	Cout<<"tHydroModel: "<<nodeState->size()
+		<<" nodes in the state store"<<endl;
 }
 
 
 tHydroModel::~tHydroModel()
 {
 	gridPtr = nullptr;
+
+	// Workers share the soil, land and node list data of the model
+	if (worker)
+		return;
+
+	if (quietOption > 1 && !quietCount.empty()) {
+		long deferred = 0;
+		for (size_t i=0; i < quietCount.size(); i++)
+			deferred += quietCount[i];
+		Cout<<"tHydroModel: "<<deferred<<" node updates deferred"<<endl;
+	}
+
+	for (size_t t=0; t < workers.size(); t++)
+		delete workers[t];
+	delete nodeState;
 	delete soilPtr;
 	delete landPtr;
 	if (nodeList != nullptr)
@@ -653,7 +735,8 @@ void tHydroModel::SetupNodeUSZ(tCNode *cn)
 {
 	ID = cn->getID();
 
-	soilPtr->setSoilPtr( cn->getSoilID() ); //set current s.type
+	if (!worker)
+		soilPtr->setSoilPtr( cn->getSoilID() ); //set current s.type
 
 	// Get soil hydraulic properties
     // Giuseppe 2016 - Begin changes to allow reading soil properties from grids
@@ -724,11 +807,78 @@ void tHydroModel::UnSaturatedZone(double dt)
 		cout<<"->Unsaturated zone simulation... "<<endl<<flush;
 
 	tCNode * cn;
+	tMeshListIter<tCNode> nodIter( gridPtr->getNodeList() );
+	double AA;
+
+	// Start of Simulation Loop for Unsaturated Zone
+	//---------------------------------------------
+
+	if (quietOption > 1 &&
+		(int)quietSteps.size() != gridPtr->getNumActiveNodes()) {
+		quietSteps.assign(gridPtr->getNumActiveNodes(), 0);
+		quietDepth.assign(gridPtr->getNumActiveNodes(), 0.0);
+		quietRate.assign(gridPtr->getNumActiveNodes(), 1.0E+30);
+		quietCount.assign(gridPtr->getNumActiveNodes(), 0);
+	}
+
+	if (UseThreads())
+		UnSaturatedZoneThreaded(dt);
+	else {
+		int id = 0;
+		cn = nodIter.FirstP();
+		while ( nodIter.IsActive() ) {
+			UnSaturatedStep(this, id++, cn, dt);
+			cn = nodIter.NextP();
+		}
+	}
+
+
+#ifdef PARALLEL_TRIBS
+  // Send Qstrm, NwtOld, and NfOld to upstream reach outlet nodes
+  tGraph::sendOverlap();
+  // Receive as Qstrm, NwtOld, and NfOld from downstream reach head nodes
+  tGraph::receiveOverlap();
+#endif
+
+	if (simCtrl->Verbose_label == 'Y') {
+		// Output water balance information every 100 hours or at the end
+		AA = timer->getCurrentTime();
+		if (nodeList ||
+			(AA/100.-floor(AA/100.)) < (timer->getTimeStep()-timer->getTimeStep()/2.)/100. ||
+			timer->RemainingTime() == 0.0) {
+
+			cout<<"\t\tRUNOFF = "<<Stok<<" M^3"<<endl<<flush;
+			cout<<"\t\tTOTRAIN = "<<TotRain<<" M^3"<<endl<<flush;
+			cout<<"\t\tMOISTCHN = "<<TotMoist<<" M^3"<<endl<<flush;
+			cout<<"\t\tGWCHANGE = "<<TotGWchange<<" M^3"<<endl<<flush;
+		}
+	}
+
+	// In order to properly take care of the actual generated runoff in the element
+	if (RunOnoption) {
+		cn = nodIter.FirstP();
+		while ( nodIter.IsActive() ) {
+			SetCellRunon( cn, cn->getSrf()/dt, cn->getRunOn()/dt, dt, 1 );
+			cn = nodIter.NextP();
+		}
+	}
+}
+
+/*************************************************************************
+**
+**  tHydroModel::UnSaturatedNode( tCNode *, double )
+**
+**  Unsaturated zone update of a single node. All intermediate values of
+**  the node are kept in the data members of the object, so concurrent 
+**  calls must be made on different (worker) objects, see 
+**  UnSaturatedZoneThreaded().
+**
+*************************************************************************/
+void tHydroModel::UnSaturatedNode(tCNode *cn, double dt)
+{
 	tCNode * dnode;
 	tCNode * cdest;
 	tEdge  * ce;
-	tMeshListIter<tCNode> nodIter( gridPtr->getNodeList() );
-	tMeshListIter<tEdge>  edgIter( gridPtr->getEdgeList() );
 
 	double Kunsat;
 	double Ractual;
@@ -755,89 +905,63 @@ void tHydroModel::UnSaturatedZone(double dt)
         Storm_Unsat_Evol, Perched_Evol, Perched_SurfSat,
         StormToInterTransition, ExactInitial, IntStormBelow};
 
-	// Start of Simulation Loop for Unsaturated Zone
-	//---------------------------------------------
-
+#ifdef PARALLEL_TRIBS
 	int id = 0;
-	cn = nodIter.FirstP();
-	while ( nodIter.IsActive() ) {
 
-#ifdef PARALLEL_TRIBS
-  // Receive Qpin from incoming outlet node(s) on another processor
-  // if this is a stream head node
-  if (tGraph::isUpstreamNode(cn)) {
-    id = cn->getReach();
-    tGraph::receiveQpin(id, cn);
-
-    // If runon option set, receive flux node values
-    if (RunOnoption)
-        tGraph::receiveRunFlux(cn);
-  }
+// Receive Qpin from incoming outlet node(s) on another processor
+// if this is a stream head node
+if (tGraph::isUpstreamNode(cn)) {
+id = cn->getReach();
+tGraph::receiveQpin(id, cn);
+
+// If runon option set, receive flux node values
+if (RunOnoption)
+    tGraph::receiveRunFlux(cn);
+}
 #endif
 
-		// Setup basic variables
-		SetupNodeUSZ( cn );
+	// Setup basic variables
+	SetupNodeUSZ( cn );
 
-		// Initialize Runoff
-		srf=hsrf=esrf=psrf=satsrf=sbsrf=0.0;
+	// Initialize Runoff
+	srf=hsrf=esrf=psrf=satsrf=sbsrf=0.0;
 
-		// Get geometry properties
-		ce = cn->getFlowEdg();
+	// Get geometry properties
+	ce = cn->getFlowEdg();
 
-		alpha = atan(ce->getSlope());
-		(alpha > 0.0 ? Cos = fabs(cos(alpha)) : Cos = 1.0);
-		(alpha > 0.0 ? Sin = fabs(sin(alpha)) : Sin = 0.0);
-		
-		// Get Bedrock depth for computing Nwt
-		DtoBedrock = cn->getBedrockDepth(); // Added by CJC2020
-		
-		// Get Actual Rainfall after ET and I
-		EvapSoi = cn->getEvapSoil();
-		EvapVeg = cn->getEvapDryCanopy();
-
-		// No DEW is allowed in soil
-		if (EvapSoi < 0.0)
-			EvapSoi = 0.0;
-		if (EvapVeg < 0.0)
-			EvapVeg = 0.0;
-
-		// Get Actual Rainfall after ET and I
-		if (Ioption == 0 && EToption == 0)
-			Ractual = cn->getRain();
-
-		else if (Ioption == 0 && EToption != 0)
-			Ractual = cn->getRain() - EvapSoi - EvapVeg;
-
-		else if (Ioption != 0 && EToption == 0) {
-			if (Ioption != 1) {
-				cout<<"\nError: Cannot Have Rutter Model (on) and ET (off)"<<endl;
-				Ractual = cn->getRain();}
-			else
-				Ractual = cn->getNetPrecipitation();
-		}
-		else if (Ioption != 0 && EToption != 0) {
-            Ractual = cn->getNetPrecipitation() - EvapSoi - EvapVeg;
-        }
+	alpha = atan(ce->getSlope());
+	(alpha > 0.0 ? Cos = fabs(cos(alpha)) : Cos = 1.0);
+	(alpha > 0.0 ? Sin = fabs(sin(alpha)) : Sin = 0.0);
+	
+	// Get Bedrock depth for computing Nwt
+	DtoBedrock = cn->getBedrockDepth(); // Added by CJC2020
+	
+	// Get Actual Rainfall after ET and I
+	Ractual = ActualRain(cn, EvapSoi, EvapVeg);
 
-		// Runon calculations (if on), runon value [mm hr^-1]
-		qrunon = 0.0;
-		if (RunOnoption)
-			qrunon = GetCellRunon( cn, dt );
+	// Mean over the steps of a deferred update (see UnSaturatedStep())
+	if (quietTime > 0.0)
+		Ractual = (quietRain + Ractual*(dt - quietTime))/dt;
 
-		// Calculate accumulated rain [m^3]
-		TotRain += (Ractual*dt*cn->getVArea()/1000.);
+	// Runon calculations (if on), runon value [mm hr^-1]
+	qrunon = 0.0;
+	if (RunOnoption)
+		qrunon = GetCellRunon( cn, dt );
 
-		// SKY2008Snow from AJR2007
-		if (SnOpt) {
-			snWE = cn->getLiqWE() + cn->getIceWE();
-			routeWE = cn->getLiqRouted();
-			if ((snWE > 1e-3) || (routeWE > 0.)) {
-                //WR 12182023 removed EvapVeg from route water following above approach and because transpiration can still occur w/snow
-				Ractual = 10.0*routeWE-EvapVeg; //have to convert to mm // Changed from R to Ractual CJC2020
-			}
+	// Calculate accumulated rain [m^3]
+	TotRain += (Ractual*dt*cn->getVArea()/1000.);
+
+	// SKY2008Snow from AJR2007
+	if (SnOpt) {
+		snWE = cn->getLiqWE() + cn->getIceWE();
+		routeWE = cn->getLiqRouted();
+		if ((snWE > 1e-3) || (routeWE > 0.)) {
+            //WR 12182023 removed EvapVeg from route water following above approach and because transpiration can still occur w/snow
+			Ractual = 10.0*routeWE-EvapVeg; //have to convert to mm // Changed from R to Ractual CJC2020
 		}
+	}
 
-        // Adjust saturated hydraulic conductivity based on air
+    // Adjust saturated hydraulic conductivity based on air
 //        // temperature to account for frozen soil effects CJC2020
 //        Ta_hi = 8;
 //        Ta_lo = 4;
@@ -849,1377 +973,1790 @@ void tHydroModel::UnSaturatedZone(double dt)
 //        else if ((airTemp < Ta_hi) && (airTemp > Ta_lo)) {
 //            Ksat = Ksat*alphat + (airTemp - Ta_lo)*((Ksat - Ksat*alphat)/(Ta_hi - Ta_lo));
 //        }
-		
-		// Total rate of in/outfluxes [mm hr^-1]
-		R1 = (Ractual + (QpIn-QpOut))*Cos + qrunon;  // Moved this line to be below routeWE  calculation CJC2020
-		R = Ractual; // Moved this line to be below routeWE  calculation CJC2020
-
-
-		// Step1: Compute K_unsaturated and rainfall
-		//---------------------------------------------
-		if (Ksat != 0.0) {
-            ThSurf = get_InitMoist_depthZ(0.);
-        }
+	
+	// Total rate of in/outfluxes [mm hr^-1]
+	R1 = (Ractual + (QpIn-QpOut))*Cos + qrunon;  // Moved this line to be below routeWE  calculation CJC2020
+	R = Ractual; // Moved this line to be below routeWE  calculation CJC2020
 
-		if (RuOld == 0.0) {
-            Kunsat = Ksat * pow(((ThSurf - Thr) / (Ths - Thr)), Eps); //Initialized profile
-        }
-		else {
-            Kunsat = RuOld;  // There is wetted wedge
-        }
 
+	// Step1: Compute K_unsaturated and rainfall
+	//---------------------------------------------
+	if (Ksat != 0.0) {
+        ThSurf = get_InitMoist_depthZ(0.);
+    }
 
-		// Step2: Determine the node state
-		//---------------------------------------------
+	if (RuOld == 0.0) {
+        Kunsat = Ksat * pow(((ThSurf - Thr) / (Ths - Thr)), Eps); //Initialized profile
+    }
+	else {
+        Kunsat = RuOld;  // There is wetted wedge
+    }
 
-		// Splitting into different situations
-		Pixel_State = -1000;
-		if ( (NwtOld==0.) && (R1>=0.) ) { // WT initially at surface & stays there
-            Pixel_State = WTStaysAtSurf;
-        }
 
-		if ( (NwtOld==0.) && (R1<0.) ) {   // WT initially at surface & drops
-            Pixel_State = WTDropsFromSurf;
-        }
+	// Step2: Determine the node state
+	//---------------------------------------------
 
-		if ((NwtOld>0.)&&((R1*dt)>=(NwtOld*Ths-MuOld))&&(NfOld==0.||NfOld==NwtOld)) {
-            Pixel_State = WTGetsToSurf;       // WT initially at some depth, reaches surface
-        }
+	// Splitting into different situations
+	Pixel_State = -1000;
+	if ( (NwtOld==0.) && (R1>=0.) ) { // WT initially at surface & stays there
+        Pixel_State = WTStaysAtSurf;
+    }
 
-		if (Pixel_State==-1000) {        // None of the above
-			MuNew = MuOld + dt*R1;  	   // Calculate MuNew from forcing
+	if ( (NwtOld==0.) && (R1<0.) ) {   // WT initially at surface & drops
+        Pixel_State = WTDropsFromSurf;
+    }
 
-			if (MuNew < MiOld) {           // Apply the pertinent interstorm equation
-                Pixel_State = IntStormBelow;
-            }
-			if (fabs(MuNew - MiOld) < 1.0E-6) {
-                Pixel_State = ExactInitial; // Exactly Initialized State
-            }
-			if (MuNew > MiOld) {
-				if (R1 > 0.0) {
+	if ((NwtOld>0.)&&((R1*dt)>=(NwtOld*Ths-MuOld))&&(NfOld==0.||NfOld==NwtOld)) {
+        Pixel_State = WTGetsToSurf;       // WT initially at some depth, reaches surface
+    }
 
-					// Check if moisture redistribution is needed
-					if (R > RADAR ) {
+	if (Pixel_State==-1000) {        // None of the above
+		MuNew = MuOld + dt*R1;  	   // Calculate MuNew from forcing
 
-						// Must destroy the edge and redistribute moisture
-						if (IntStormVar >= IntStormMAX && NfOld > 0.0) {
-							if (MuNew >= NwtOld*Ths) {
-								NwtNew = 0.0;
-								MiNew = 0.0;
-								sbsrf = (MuNew - NwtOld*Ths)/dt;
-							}
-							else {
-								// There is enough space above Nt
-								Mdelt = Ths*NwtOld - MuOld;
-								NwtNew = Newton(Mdelt, NwtOld);
-								MiNew = get_Total_Moist(NwtNew);
-							}
-							NwtOld = NwtNew;
-							MiOld = MuOld = MuNew = MiNew;
-							NtOld = NtNew = 0.0;
-							NfOld = NfNew = 0.0;
-							RiOld = RiNew = 0.0;
-							RuOld = RuNew = 0.0;
-							IntStormVar   = 0.0;
+		if (MuNew < MiOld) {           // Apply the pertinent interstorm equation
+            Pixel_State = IntStormBelow;
+        }
+		if (fabs(MuNew - MiOld) < 1.0E-6) {
+            Pixel_State = ExactInitial; // Exactly Initialized State
+        }
+		if (MuNew > MiOld) {
+			if (R1 > 0.0) {
+
+				// Check if moisture redistribution is needed
+				if (R > RADAR ) {
+
+					// Must destroy the edge and redistribute moisture
+					if (IntStormVar >= IntStormMAX && NfOld > 0.0) {
+						if (MuNew >= NwtOld*Ths) {
+							NwtNew = 0.0;
+							MiNew = 0.0;
+							sbsrf = (MuNew - NwtOld*Ths)/dt;
+						}
+						else {
+							// There is enough space above Nt
+							Mdelt = Ths*NwtOld - MuOld;
+							NwtNew = Newton(Mdelt, NwtOld);
+							MiNew = get_Total_Moist(NwtNew);
 						}
+						NwtOld = NwtNew;
+						MiOld = MuOld = MuNew = MiNew;
+						NtOld = NtNew = 0.0;
+						NfOld = NfNew = 0.0;
+						RiOld = RiNew = 0.0;
+						RuOld = RuNew = 0.0;
+						IntStormVar   = 0.0;
 					}
+				}
 
-					// Proceed with old/new values
-					if (NtOld == NfOld) {
-                        Pixel_State = Storm_Unsat_Evol;
-                    }
+				// Proceed with old/new values
+				if (NtOld == NfOld) {
+                    Pixel_State = Storm_Unsat_Evol;
+                }
 
-					if ((NtOld < NfOld) && (NtOld != 0.0)) {
-                        Pixel_State = Perched_Evol;
+				if ((NtOld < NfOld) && (NtOld != 0.0)) {
+                    Pixel_State = Perched_Evol;
+                }
+				if ((NtOld == 0.0) && (NfOld > 0.0)) {
+					ThRiNf = get_InitMoist_depthZ(NfOld);
+					ThReNf = Ths;
+					set_Suction_Term(NfOld);
+					qn = Ksat*F*NfOld/expm1(F*NfOld)*(Cos + G/NfOld); //WR debug 01112024: Converted all instances of exp(x)-1 to expm1(x) to address loss in precision
+
+					xxsrf = qn - RiOld*Cos; // Net infiltration rate
+					if (R1 >= xxsrf) {
+                        Pixel_State = Perched_SurfSat;
                     }
-					if ((NtOld == 0.0) && (NfOld > 0.0)) {
-						ThRiNf = get_InitMoist_depthZ(NfOld);
-						ThReNf = Ths;
-						set_Suction_Term(NfOld);
-						qn = Ksat*F*NfOld/expm1(F*NfOld)*(Cos + G/NfOld); //WR debug 01112024: Converted all instances of exp(x)-1 to expm1(x) to address loss in precision
-
-						xxsrf = qn - RiOld*Cos; // Net infiltration rate
-						if (R1 >= xxsrf) {
-                            Pixel_State = Perched_SurfSat;
-                        }
-						else {
-                            Pixel_State = StormToInterTransition;
-                        }
-					}
+					else {
+                        Pixel_State = StormToInterTransition;
+                    }
+				}
 
-					// --------------------------------------------------
-					// The following handles two aspects:
-					//       a) Rainfall is continuing and Nf has reached
-					//          water table -> redistribute moisture
-					//       b) Interstorm  subsurface lateral fluxes
-					//          should not cause the formation of new Nf
-					//       -> NtOld = NwtOld, moisture is redistributed
-					if ((NfOld == NwtOld)||(R<=RADAR && IntStormVar>0 && NfOld==0.0))
-						Pixel_State = Storm_Evol;
-      }
-				if (R1 <= 0.0)
-					Pixel_State = StormToInterTransition;
-    }
-			if (Ksat == 0.0)
-				Pixel_State = Perched_SurfSat;
+				// --------------------------------------------------
+				// The following handles two aspects:
+				//       a) Rainfall is continuing and Nf has reached
+				//          water table -> redistribute moisture
+				//       b) Interstorm  subsurface lateral fluxes
+				//          should not cause the formation of new Nf
+				//       -> NtOld = NwtOld, moisture is redistributed
+				if ((NfOld == NwtOld)||(R<=RADAR && IntStormVar>0 && NfOld==0.0))
+					Pixel_State = Storm_Evol;
   }
+			if (R1 <= 0.0)
+				Pixel_State = StormToInterTransition;
+}
+		if (Ksat == 0.0)
+			Pixel_State = Perched_SurfSat;
+}
 
-		// Print old values of state variables
-		PrintOldVars( cn, ce, Ractual, Pixel_State );
-
-		// Step 3: Go to the cases
-		//---------------------------------------------
+	// Print old values of state variables
+	PrintOldVars( cn, ce, Ractual, Pixel_State );
 
-		switch (Pixel_State) {
+	// Step 3: Go to the cases
+	//---------------------------------------------
 
+	switch (Pixel_State) {
 
-			//----------------
-			case WTStaysAtSurf:
 
-				if (R > 0.0)
-					sbsrf = R*Cos;
+		//----------------
+		case WTStaysAtSurf:
 
-				// Exfiltration occurs due to lateral inflows
-				if (QpIn > QpOut)
-					psrf = (QpIn-QpOut)*Cos;
-				else
-					sbsrf -= (QpOut-QpIn)*Cos;
-
-				MiNew=0.0;
-				MuNew=0.0;
-				RiNew=0.0;
-				RuNew=0.0;
-				NfNew=0.0;
-				NtNew=0.0;
-				NwtNew=0.0;
-				QpOut=0.0;
+			if (R > 0.0)
+				sbsrf = R*Cos;
 
-				// If ExactInitial during interstorm period
-				// use 0.1 mm/hour is a threshold value for RADAR
+			// Exfiltration occurs due to lateral inflows
+			if (QpIn > QpOut)
+				psrf = (QpIn-QpOut)*Cos;
+			else
+				sbsrf -= (QpOut-QpIn)*Cos;
+
+			MiNew=0.0;
+			MuNew=0.0;
+			RiNew=0.0;
+			RuNew=0.0;
+			NfNew=0.0;
+			NtNew=0.0;
+			NwtNew=0.0;
+			QpOut=0.0;
 
-                if (R <= RADAR) {
-					IntStormVar += dt;
-				}
-                else {
-                    if (IntStormVar > 0.0)
-                        IntStormVar = 0.0;
-                }
-					break;
+			// If ExactInitial during interstorm period
+			// use 0.1 mm/hour is a threshold value for RADAR
 
+            if (R <= RADAR) {
+				IntStormVar += dt;
+			}
+            else {
+                if (IntStormVar > 0.0)
+                    IntStormVar = 0.0;
+            }
+				break;
 
-				//----------------
-			case WTGetsToSurf:
 
-				// Partitioning into sbsrf & psrf
-				if (QpIn > QpOut) {
-					psrf = (QpIn - QpOut)*Cos + MuOld/dt - NwtOld*Ths/dt;
-					if (psrf < 0.0) {
-						sbsrf = R*Cos + psrf;
-						psrf = 0.0;
-					}
-					else {
-						if (R > 0.0)
-							sbsrf = R*Cos;
-					}
+			//----------------
+		case WTGetsToSurf:
+
+			// Partitioning into sbsrf & psrf
+			if (QpIn > QpOut) {
+				psrf = (QpIn - QpOut)*Cos + MuOld/dt - NwtOld*Ths/dt;
+				if (psrf < 0.0) {
+					sbsrf = R*Cos + psrf;
+					psrf = 0.0;
 				}
-				else
-					sbsrf = (R + (QpIn - QpOut))*Cos + MuOld/dt - NwtOld*Ths/dt;
-
-				MuNew=0.0;
-				RiNew=0.0;
-				RuNew=0.0;
-				NfNew=0.0;
-				NtNew=0.0;
-				NwtNew=0.0;
-				MiNew=0.0;
-				QpOut=0.0;
+				else {
+					if (R > 0.0)
+						sbsrf = R*Cos;
+				}
+			}
+			else
+				sbsrf = (R + (QpIn - QpOut))*Cos + MuOld/dt - NwtOld*Ths/dt;
 
-				if (IntStormVar > 0.0)
-					IntStormVar = 0.0;
+			MuNew=0.0;
+			RiNew=0.0;
+			RuNew=0.0;
+			NfNew=0.0;
+			NtNew=0.0;
+			NwtNew=0.0;
+			MiNew=0.0;
+			QpOut=0.0;
 
-                break;
+			if (IntStormVar > 0.0)
+				IntStormVar = 0.0;
 
+            break;
 
-				//----------------
-			case WTDropsFromSurf:
 
-				R1 = (R + (QpIn - QpOut))*Cos;
-				if (R1 < 0.0)
-					NwtNew = Newton(fabs(R1*dt), 0.0);
+			//----------------
+		case WTDropsFromSurf:
 
-                MiNew = get_Total_Moist(NwtNew); //WR Clang-Tidy: Misleading indentation: statement is indented too deeply. Maybe should be in scope of if statement.
+			R1 = (R + (QpIn - QpOut))*Cos;
+			if (R1 < 0.0)
+				NwtNew = Newton(fabs(R1*dt), 0.0);
 
-				MuNew = MiNew;
-				RiNew = 0.0;
-				RuNew = 0.0;
-				QpOut=0.0;
+            MiNew = get_Total_Moist(NwtNew); //WR Clang-Tidy: Misleading indentation: statement is indented too deeply. Maybe should be in scope of if statement.
 
-				IntStormVar += dt;
+			MuNew = MiNew;
+			RiNew = 0.0;
+			RuNew = 0.0;
+			QpOut=0.0;
 
-                if(IntStormVar >= IntStormMAX) {
-					NfNew = 0.0;
-					NtNew = 0.0;
-				}else {
-                    NfNew=NwtNew;
-                    NtNew=NwtNew;
-                }
-                break;
+			IntStormVar += dt;
 
+            if(IntStormVar >= IntStormMAX) {
+				NfNew = 0.0;
+				NtNew = 0.0;
+			}else {
+                NfNew=NwtNew;
+                NtNew=NwtNew;
+            }
+            break;
 
-				//----------------
-			case ExactInitial:
 
-				// Moisture conditions correspond to initialized state
-				MiNew=MiOld;
-				MuNew=MiNew;
-				NwtNew=NwtOld;
-				RiNew=0.0;
-				RuNew=0.0;
-				QpOut=0.0;
+			//----------------
+		case ExactInitial:
 
-				if (R <= 0.0)
-					IntStormVar += dt;
+			// Moisture conditions correspond to initialized state
+			MiNew=MiOld;
+			MuNew=MiNew;
+			NwtNew=NwtOld;
+			RiNew=0.0;
+			RuNew=0.0;
+			QpOut=0.0;
 
-                if (NfOld == NwtOld) {
-                    if (IntStormVar >= IntStormMAX) {
-							NfNew = 0.0;
-							NtNew = 0.0;
-						}
-                    else {
-							NfNew=NwtNew;
-							NtNew=NwtNew;
-						}
+			if (R <= 0.0)
+				IntStormVar += dt;
+
+            if (NfOld == NwtOld) {
+                if (IntStormVar >= IntStormMAX) {
+						NfNew = 0.0;
+						NtNew = 0.0;
 					}
                 else {
-                    NfNew = 0.0;
-                    NtNew = 0.0;
-                }
+						NfNew=NwtNew;
+						NtNew=NwtNew;
+					}
+				}
+            else {
+                NfNew = 0.0;
+                NtNew = 0.0;
+            }
 
-                break;
+            break;
 
 
-				//----------------
-			case IntStormBelow:
+			//----------------
+		case IntStormBelow:
 
-				R1 = (R + (QpIn - QpOut))*Cos;
+			R1 = (R + (QpIn - QpOut))*Cos;
 
 
-                Mdelt = Ths*NwtOld - (MuOld + R1*dt); // Pixel moisture deficit
-				NwtNew = Newton(Mdelt, NwtOld);
+            Mdelt = Ths*NwtOld - (MuOld + R1*dt); // Pixel moisture deficit
+			NwtNew = Newton(Mdelt, NwtOld);
 
 
-				RiNew = 0.0;
-				RuNew = 0.0;
-				MiNew = get_Total_Moist(NwtNew);
-				MuNew = MiNew;
+			RiNew = 0.0;
+			RuNew = 0.0;
+			MiNew = get_Total_Moist(NwtNew);
+			MuNew = MiNew;
 
-				IntStormVar += dt;  // <- NOVA
+			IntStormVar += dt;  // <- NOVA
 
-				// If preceding state was StormToInterTransition
-				// assign fronts to the surface
-                if ((NfOld < NwtOld) && (NfOld > 0.0)) {
-					NfNew = NtNew = 0.0;
-				}
-                // If preceding state was {IntStormBelow, ExactInitial, WTDrops}
-                else {
-                    if (IntStormVar < IntStormMAX) {
-                        if (NfOld == 0.0)
-                            NfNew = NtNew = 0.0;
-                        else
-                            NfNew = NtNew = NwtNew;
-						}
-                    else
+			// If preceding state was StormToInterTransition
+			// assign fronts to the surface
+            if ((NfOld < NwtOld) && (NfOld > 0.0)) {
+				NfNew = NtNew = 0.0;
+			}
+            // If preceding state was {IntStormBelow, ExactInitial, WTDrops}
+            else {
+                if (IntStormVar < IntStormMAX) {
+                    if (NfOld == 0.0)
                         NfNew = NtNew = 0.0;
+                    else
+                        NfNew = NtNew = NwtNew;
 					}
-					QpOut = 0.0;
-				break;
+                else
+                    NfNew = NtNew = 0.0;
+				}
+				QpOut = 0.0;
+			break;
 
 
-				//----------------
-			case StormToInterTransition:
+			//----------------
+		case StormToInterTransition:
 
-				if (R <= RADAR) {
-					IntStormVar += dt;
+			if (R <= RADAR) {
+				IntStormVar += dt;
+			}
+			else
+				IntStormVar = 0.0;
+
+			R1 = (R + (QpIn - QpOut))*Cos;
+			MuNew  = MuOld + R1*dt;
+			NwtNew = NwtOld;
+			MiNew  = MiOld;
+			RiNew  = RiOld;
+
+			// The case of deep interstorm period:
+			// T >= Tmax (w/o rain on surface)
+			if (IntStormVar >= IntStormMAX && RdstrOption) {
+
+				// Destroy edge and redistribute moisture
+				if (MuNew >= NwtOld*Ths) {
+					NwtNew = 0.0;
+					sbsrf = (MuNew - NwtOld*Ths)/dt;
+					MiNew = 0.0;
 				}
-				else
-					IntStormVar = 0.0;
-
-				R1 = (R + (QpIn - QpOut))*Cos;
-				MuNew  = MuOld + R1*dt;
-				NwtNew = NwtOld;
-				MiNew  = MiOld;
-				RiNew  = RiOld;
-
-				// The case of deep interstorm period:
-				// T >= Tmax (w/o rain on surface)
-				if (IntStormVar >= IntStormMAX && RdstrOption) {
-
-					// Destroy edge and redistribute moisture
-					if (MuNew >= NwtOld*Ths) {
-						NwtNew = 0.0;
-						sbsrf = (MuNew - NwtOld*Ths)/dt;
-						MiNew = 0.0;
-					}
-					// There is enough space above Nt
-					else  {
-						Mdelt = Ths*NwtOld - MuNew;
-						NwtNew = Newton(Mdelt, NwtOld);
-						MiNew = get_Total_Moist(NwtNew);
-					}
-					MuNew = MiNew;
-					NtNew = 0.0;
-					NfNew = 0.0;
-					RiNew = 0.0;
-					RuNew = 0.0;
+				// There is enough space above Nt
+				else  {
+					Mdelt = Ths*NwtOld - MuNew;
+					NwtNew = Newton(Mdelt, NwtOld);
+					MiNew = get_Total_Moist(NwtNew);
 				}
-                // Rainfall hiatus or interstorm beginning:
-                // T < Tmax (w/o rain on surface), wedge is moving down
-
-                else {
-                    Mdelt = get_Lower_Moist(NfOld, NwtNew);
-                    Mdelt = MuNew - Mdelt;          //Amount of water in the wetted edge
-                    AA = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfOld/Eps)) + Thr*NfOld;
+				MuNew = MiNew;
+				NtNew = 0.0;
+				NfNew = 0.0;
+				RiNew = 0.0;
+				RuNew = 0.0;
+			}
+            // Rainfall hiatus or interstorm beginning:
+            // T < Tmax (w/o rain on surface), wedge is moving down
 
-                    // Correct variables in imbalance (artifacts of Perched_Evol case)
-                    if (Mdelt > AA && NtOld == NfOld) {
-                        Mdelt = AA - 1.0E-4;
+            else {
+                Mdelt = get_Lower_Moist(NfOld, NwtNew);
+                Mdelt = MuNew - Mdelt;          //Amount of water in the wetted edge
+                AA = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfOld/Eps)) + Thr*NfOld;
 
-                        if (simCtrl->Verbose_label == 'Y') {
-                            cout<<"\nWarning: IMBALANCE: Correction by "<<Mdelt - AA<<" mm"<<endl;
-                            cout<<"ID = "<<ID<<endl;
-							}
+                // Correct variables in imbalance (artifacts of Perched_Evol case)
+                if (Mdelt > AA && NtOld == NfOld) {
+                    Mdelt = AA - 1.0E-4;
 
+                    if (simCtrl->Verbose_label == 'Y') {
+                        cout<<"\nWarning: IMBALANCE: Correction by "<<Mdelt - AA<<" mm"<<endl;
+                        cout<<"ID = "<<ID<<endl;
 						}
 
+					}
 
-						// CASE 1 : UNSATURATED EDGE
-						if (Mdelt <= AA) {
 
-							if (R1 == 0.0) {
-								RuNew = RuOld;
-								Nstar = (log(Ksat/RuNew))/F;
-							}
-							else {   // [ R1 < 0 ]
-								RuNew = get_RechargeRate(Mdelt, NfOld);
-								Nstar = (log(Ksat/RuNew))/F;
+					// CASE 1 : UNSATURATED EDGE
+					if (Mdelt <= AA) {
+
+						if (R1 == 0.0) {
+							RuNew = RuOld;
+							Nstar = (log(Ksat/RuNew))/F;
+						}
+						else {   // [ R1 < 0 ]
+							RuNew = get_RechargeRate(Mdelt, NfOld);
+							Nstar = (log(Ksat/RuNew))/F;
+						}
+
+						// MOVE FRONTS: Wedge gets very close to the MiOld profile (0.05%)
+						if ((100.*(MuNew-MiOld)/MiOld) <= 0.05) {
+							NfNew = NtNew = 0.0;   //Pixel is "ready" for another rainfall
+
+							if ((MuNew - MiOld) > 1.0E-4) {
+								Mdelt = Ths*NwtOld - MuNew;
+								NwtNew = Newton(Mdelt, NwtOld);
 							}
+							MiNew = get_Total_Moist(NwtNew);
+							MuNew = MiNew;
+							RiNew = RuNew = 0.0;
+						}
 
-							// MOVE FRONTS: Wedge gets very close to the MiOld profile (0.05%)
-							if ((100.*(MuNew-MiOld)/MiOld) <= 0.05) {
-								NfNew = NtNew = 0.0;   //Pixel is "ready" for another rainfall
+						// Wetted wedge is still SIGNIFICANT (RuNew>RiNew >> 0.1%)
+						else {
+							ThRiNf = get_InitMoist_depthZ(NfOld);
+							ThReNf = get_EdgeMoist_depthZ(NfOld);
 
-								if ((MuNew - MiOld) > 1.0E-4) {
-									Mdelt = Ths*NwtOld - MuNew;
-									NwtNew = Newton(Mdelt, NwtOld);
-								}
+							// Gravity cannot be dominant any longer --
+							// The idea is to just redistribute the moisture
+							// in the profile by raising the water table
+							if (ThReNf <= ThRiNf) {
+								Mdelt = Ths*NwtOld - (MuOld + R1*dt);
+								NwtNew = Newton(Mdelt, NwtOld);
+								NtNew = NfNew = 0.0;
+								RuNew = RiNew = 0.0;
 								MiNew = get_Total_Moist(NwtNew);
 								MuNew = MiNew;
-								RiNew = RuNew = 0.0;
+								QpOut = 0.0;
 							}
-
-							// Wetted wedge is still SIGNIFICANT (RuNew>RiNew >> 0.1%)
 							else {
-								ThRiNf = get_InitMoist_depthZ(NfOld);
-								ThReNf = get_EdgeMoist_depthZ(NfOld);
-
-								// Gravity cannot be dominant any longer --
-								// The idea is to just redistribute the moisture
-								// in the profile by raising the water table
-								if (ThReNf <= ThRiNf) {
-									Mdelt = Ths*NwtOld - (MuOld + R1*dt);
-									NwtNew = Newton(Mdelt, NwtOld);
-									NtNew = NfNew = 0.0;
-									RuNew = RiNew = 0.0;
-									MiNew = get_Total_Moist(NwtNew);
-									MuNew = MiNew;
-									QpOut = 0.0;
-								}
-								else {
-									set_Suction_Term(NfOld);
-									qn = RuNew*Cos + Ksat*exp(-F*NfOld)*G/NfOld;
-									NfNew = NfOld + dt*(qn - RiNew*Cos)/(ThReNf-ThRiNf);
-									NtNew = NfNew;
-
-
-									if (NfNew < (NwtNew+Psib)) {
-										Mdelt = get_Lower_Moist(NfNew, NwtNew);
-										Mdelt = MuNew - Mdelt;
-										RuNew = get_RechargeRate(Mdelt, NfNew);
-										AA = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
-
-										// If the wedge perches, re-define variables
-										if (Mdelt > AA) {
-											NtNew = (log(Ksat/RuNew))/F;
-											RuNew = Ksat*exp(-F*NtNew);
-										}
-									}
-									// Wetting front hits the capillary fringe
-									else if (NfNew >= (NwtNew+Psib))  {
-										if ((MuNew - MiOld) > 1.0E-4) {
-											Mdelt = Ths*NwtOld - MuNew;
-											NwtNew = Newton(Mdelt, NwtOld);
-										}
-										MiNew = get_Total_Moist(NwtNew);
-										MuNew = MiNew;
-										RiNew = RuNew = 0.0;
-
-										cdest = (tCNode*)ce->getDestinationPtrNC();
-										NwtNext = cdest->getNwtOld();
-										NfNext  = cdest->getNfOld();
-
-										if ((NfNext == NwtNext) && (IntStormVar < IntStormMAX))
-											NfNew = NtNew = NwtNew;
-										else
-											NfNew = NtNew = 0.0;
-										RuNew = 0.0;
-									}
-								}
-							}
-						}
-
-						// CASE 2 :  PERCHED & SURFACE SATURATED WEDG
+								set_Suction_Term(NfOld);
+								qn = RuNew*Cos + Ksat*exp(-F*NfOld)*G/NfOld;
+								NfNew = NfOld + dt*(qn - RiNew*Cos)/(ThReNf-ThRiNf);
+								NtNew = NfNew;
 
-						// a.) Let's move the wetting front
-						else {
-							ThRiNf = get_InitMoist_depthZ(NfOld);
-							ThReNf = Ths;
-							set_Suction_Term(NfOld);
-							qn = Ksat*F*(NfOld-NtOld)/(exp(F*NfOld)-exp(F*NtOld));
-							qn *= (Cos + G/NfOld);
-
-							NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
-
-							// Check possible situations with Nf & Nwt
-							if (fabs(NfNew - (NwtNew+Psib)) <= 1.0E-3) {
-								NwtNew = NtOld-Psib;
-								cdest = (tCNode*)ce->getDestinationPtrNC();
-								NwtNext = cdest->getNwtOld();
-								NfNext  = cdest->getNfOld();
-
-								if ((NfNext == NwtNext) && (IntStormVar < IntStormMAX))
-									NfNew = NwtNew;
-								else
-									NfNew = 0.0;
-							}
-							else if (NfNew > (NwtNew+Psib)) {
-								NwtNew = NtOld-Psib;
-								cdest = (tCNode*)ce->getDestinationPtrNC();
-								NwtNext = cdest->getNwtOld();
-								NfNext  = cdest->getNfOld();
-
-								if ((NfNext == NwtNext) && (IntStormVar < IntStormMAX))
-									NfNew = NwtNew;
-								else
-									NfNew = 0;
-							}
 
-							// b.) Let's move the top front
+								if (NfNew < (NwtNew+Psib)) {
+									Mdelt = get_Lower_Moist(NfNew, NwtNew);
+									Mdelt = MuNew - Mdelt;
+									RuNew = get_RechargeRate(Mdelt, NfNew);
+									AA = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
 
-							// The wetting front has reached the water table
-							if ((NfNew == 0.0) || (NfNew == NwtNew)) {
-								if (MuNew >= NwtOld*Ths) {
-									NwtNew = 0.0;
-									NtNew = NfNew = 0.0;
-									sbsrf = (MuNew - NwtOld*Ths)/dt;
-									MuNew = MiNew = 0.0;
-									RuNew = RiNew = 0.0;
+									// If the wedge perches, re-define variables
+									if (Mdelt > AA) {
+										NtNew = (log(Ksat/RuNew))/F;
+										RuNew = Ksat*exp(-F*NtNew);
+									}
 								}
-								else  {    //Enough space above Nt
-									Mdelt = Ths*NwtOld - MuNew;
-									NwtNew = Newton(Mdelt, NwtOld);
-									RiNew = RuNew = 0.0;
+								// Wetting front hits the capillary fringe
+								else if (NfNew >= (NwtNew+Psib))  {
+									if ((MuNew - MiOld) > 1.0E-4) {
+										Mdelt = Ths*NwtOld - MuNew;
+										NwtNew = Newton(Mdelt, NwtOld);
+									}
 									MiNew = get_Total_Moist(NwtNew);
 									MuNew = MiNew;
-									if (NfNew == NwtNew)
+									RiNew = RuNew = 0.0;
+
+									cdest = (tCNode*)ce->getDestinationPtrNC();
+									NwtNext = cdest->getNwtOld();
+									NfNext  = cdest->getNfOld();
+
+									if ((NfNext == NwtNext) && (IntStormVar < IntStormMAX))
 										NfNew = NtNew = NwtNew;
 									else
 										NfNew = NtNew = 0.0;
+									RuNew = 0.0;
 								}
 							}
+						}
+					}
 
-							//  The wetting front is still above the water table
-							else if ((NfNew > 0.0) && (NfNew != NwtNew)) {
-								Mdelt = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NtOld/Eps)) + Thr*NtOld;
-								Mdva  = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
+					// CASE 2 :  PERCHED & SURFACE SATURATED WEDG
 
-								// Max of water that can be lost without
-								// transition to unsaturated state
-								AA = (Mdelt+(NfNew-NtOld)*Ths - Mdva);
+					// a.) Let's move the wetting front
+					else {
+						ThRiNf = get_InitMoist_depthZ(NfOld);
+						ThReNf = Ths;
+						set_Suction_Term(NfOld);
+						qn = Ksat*F*(NfOld-NtOld)/(exp(F*NfOld)-exp(F*NtOld));
+						qn *= (Cos + G/NfOld);
 
-								// Next state is unsaturated
-								if (R1 < (qn - AA/dt)) {
-									Mperch = get_Lower_Moist(NfNew, NwtNew);
-									Mperch = MuNew - Mperch; // water left in the wetted wedge
-									RuNew = get_RechargeRate(Mperch, NfNew);
-									NtNew = NfNew;
+						NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
 
-									if (Mdelt >= Mdva)
-										MuNew -= Mdelt - Mdva + 1.0E-4;
-								}
-								// Next state is either surfuce or perched saturated
-								else {
-									BB = -dt*(qn - R1)/(Ths-Thr) - Eps/F*exp(-F*NtOld/Eps);
-									AA = -exp(F*(BB-NtOld)/Eps);
-									NtNew = NtOld + (Eps/F*LambertW(AA) - BB);
-									if (AA < (-1/exp(1.0)))
-										cout<<"\nWarning: Value for LAMBERT f-n is too small\n\n";
-									RuNew = Ksat*exp(-F*NtNew);
-								}
+						// Check possible situations with Nf & Nwt
+						if (fabs(NfNew - (NwtNew+Psib)) <= 1.0E-3) {
+							NwtNew = NtOld-Psib;
+							cdest = (tCNode*)ce->getDestinationPtrNC();
+							NwtNext = cdest->getNwtOld();
+							NfNext  = cdest->getNfOld();
+
+							if ((NfNext == NwtNext) && (IntStormVar < IntStormMAX))
+								NfNew = NwtNew;
+							else
+								NfNew = 0.0;
+						}
+						else if (NfNew > (NwtNew+Psib)) {
+							NwtNew = NtOld-Psib;
+							cdest = (tCNode*)ce->getDestinationPtrNC();
+							NwtNext = cdest->getNwtOld();
+							NfNext  = cdest->getNfOld();
+
+							if ((NfNext == NwtNext) && (IntStormVar < IntStormMAX))
+								NfNew = NwtNew;
+							else
+								NfNew = 0;
+						}
+
+						// b.) Let's move the top front
+
+						// The wetting front has reached the water table
+						if ((NfNew == 0.0) || (NfNew == NwtNew)) {
+							if (MuNew >= NwtOld*Ths) {
+								NwtNew = 0.0;
+								NtNew = NfNew = 0.0;
+								sbsrf = (MuNew - NwtOld*Ths)/dt;
+								MuNew = MiNew = 0.0;
+								RuNew = RiNew = 0.0;
 							}
-	}
+							else  {    //Enough space above Nt
+								Mdelt = Ths*NwtOld - MuNew;
+								NwtNew = Newton(Mdelt, NwtOld);
+								RiNew = RuNew = 0.0;
+								MiNew = get_Total_Moist(NwtNew);
+								MuNew = MiNew;
+								if (NfNew == NwtNew)
+									NfNew = NtNew = NwtNew;
+								else
+									NfNew = NtNew = 0.0;
+							}
+						}
 
-						QpOut = 0.0;
-						if ((NtNew == NfNew) && (NfNew != NwtNew) && (NfNew > 10.))
-							QpOut = get_UnSat_LateralFlow(NfNew, RuNew, ce->getVEdgLen()*1000.);
+						//  The wetting front is still above the water table
+						else if ((NfNew > 0.0) && (NfNew != NwtNew)) {
+							Mdelt = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NtOld/Eps)) + Thr*NtOld;
+							Mdva  = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
 
-						if ((NfNew-NtNew) > 1.0)
-							QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.);
+							// Max of water that can be lost without
+							// transition to unsaturated state
+							AA = (Mdelt+(NfNew-NtOld)*Ths - Mdva);
 
-						QpOut *= Sin;
+							// Next state is unsaturated
+							if (R1 < (qn - AA/dt)) {
+								Mperch = get_Lower_Moist(NfNew, NwtNew);
+								Mperch = MuNew - Mperch; // water left in the wetted wedge
+								RuNew = get_RechargeRate(Mperch, NfNew);
+								NtNew = NfNew;
 
-      } // Matches *else* - the case of T < Tmax
-					break;
+								if (Mdelt >= Mdva)
+									MuNew -= Mdelt - Mdva + 1.0E-4;
+							}
+							// Next state is either surfuce or perched saturated
+							else {
+								BB = -dt*(qn - R1)/(Ths-Thr) - Eps/F*exp(-F*NtOld/Eps);
+								AA = -exp(F*(BB-NtOld)/Eps);
+								NtNew = NtOld + (Eps/F*LambertW(AA) - BB);
+								if (AA < (-1/exp(1.0)))
+									cout<<"\nWarning: Value for LAMBERT f-n is too small\n\n";
+								RuNew = Ksat*exp(-F*NtNew);
+							}
+						}
+}
 
+					QpOut = 0.0;
+					if ((NtNew == NfNew) && (NfNew != NwtNew) && (NfNew > 10.))
+						QpOut = get_UnSat_LateralFlow(NfNew, RuNew, ce->getVEdgLen()*1000.);
 
-				//---------------
-			case Storm_Evol:
+					if ((NfNew-NtNew) > 1.0)
+						QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.);
 
-				R1 = (R + (QpIn-QpOut))*Cos;
-				Mdelt = Ths*NwtOld - (MuOld + R1*dt);
-				NwtNew = Newton(Mdelt, NwtOld);
-				RiNew = RuNew = 0.0;
-				MiNew = get_Total_Moist(NwtNew);
-				MuNew = MiNew;
-				QpOut = 0.0;
+					QpOut *= Sin;
+
+  } // Matches *else* - the case of T < Tmax
+				break;
 
-				if (R <= RADAR) {
-					IntStormVar += dt;
 
-					if (NfOld == NwtOld) {
-						if (IntStormVar >= IntStormMAX)
-							NfNew = NtNew = 0.0;
-						else
-							NfNew=NtNew=NwtNew;
-					}
-					else
+			//---------------
+		case Storm_Evol:
+
+			R1 = (R + (QpIn-QpOut))*Cos;
+			Mdelt = Ths*NwtOld - (MuOld + R1*dt);
+			NwtNew = Newton(Mdelt, NwtOld);
+			RiNew = RuNew = 0.0;
+			MiNew = get_Total_Moist(NwtNew);
+			MuNew = MiNew;
+			QpOut = 0.0;
+
+			if (R <= RADAR) {
+				IntStormVar += dt;
+
+				if (NfOld == NwtOld) {
+					if (IntStormVar >= IntStormMAX)
 						NfNew = NtNew = 0.0;
+					else
+						NfNew=NtNew=NwtNew;
 				}
+				else
+					NfNew = NtNew = 0.0;
+			}
 
-                else {
-                    if (IntStormVar > 0.0)
-                        IntStormVar = 0.0;
-                    NfNew=NtNew=NwtNew;
-                }
-					break;
+            else {
+                if (IntStormVar > 0.0)
+                    IntStormVar = 0.0;
+                NfNew=NtNew=NwtNew;
+            }
+				break;
 
 
-				//--------------------
-			case Storm_Unsat_Evol:
+			//--------------------
+		case Storm_Unsat_Evol:
 
-				if (R <= RADAR)
-					IntStormVar += dt;
-				else
-					IntStormVar = 0.0;
+			if (R <= RADAR)
+				IntStormVar += dt;
+			else
+				IntStormVar = 0.0;
 
-				R1 = (R + (QpIn-QpOut))*Cos;
+			R1 = (R + (QpIn-QpOut))*Cos;
 
-				NwtNew= NwtOld;
-				MuNew = MuOld + R1*dt;
-				MiNew = MiOld;
-				RiNew = RiOld = 0.0;
+			NwtNew= NwtOld;
+			MuNew = MuOld + R1*dt;
+			MiNew = MiOld;
+			RiNew = RiOld = 0.0;
 
-				// CASE 1 : NO FRONTS YET / START FROM INITIALIZED STATE
+			// CASE 1 : NO FRONTS YET / START FROM INITIALIZED STATE
 
-				if (NfOld == 0.0 && NtOld == 0.0) {
+			if (NfOld == 0.0 && NtOld == 0.0) {
 
-					ThRiNf = get_InitMoist_depthZ(0.0);
-					// Only gravitational flow
-					if (R < Kunsat && R1/Cos < Kunsat) {
-						ThReNf = pow((R1/Ksat),(1/Eps))*(Ths-Thr)+Thr;
-						qn = R1;
-						NfNew = dt*qn/(ThReNf-ThRiNf);
-					}
-					else {
-						if (R1 < Ksat)  {
-							ThReNf = Thr + (Ths-Thr)*pow((R1/Ksat),(1/Eps));
-							set_Suction_Term(0.0);
-							if (fabs(ThReNf-ThRiNf) < 1.0E-4)
-								qn = R1;
-							else
-								qn = Ksat*exp(-F*R1/(ThReNf-ThRiNf))*G*(ThReNf-ThRiNf)/R1 + R1;
-							NfNew = dt*qn/(Ths-ThRiNf);
-						}
-						else  {   // [ R1 >= Ksat ]
-							ThReNf = Ths;
-							set_Suction_Term(0.0);
-							qn = Ksat*G*(ThReNf-ThRiNf)/Ksat + R1;
-							NfNew  = dt*qn/(ThReNf-ThRiNf);
-						}
+				ThRiNf = get_InitMoist_depthZ(0.0);
+				// Only gravitational flow
+				if (R < Kunsat && R1/Cos < Kunsat) {
+					ThReNf = pow((R1/Ksat),(1/Eps))*(Ths-Thr)+Thr;
+					qn = R1;
+					NfNew = dt*qn/(ThReNf-ThRiNf);
+				}
+				else {
+					if (R1 < Ksat)  {
+						ThReNf = Thr + (Ths-Thr)*pow((R1/Ksat),(1/Eps));
+						set_Suction_Term(0.0);
+						if (fabs(ThReNf-ThRiNf) < 1.0E-4)
+							qn = R1;
+						else
+							qn = Ksat*exp(-F*R1/(ThReNf-ThRiNf))*G*(ThReNf-ThRiNf)/R1 + R1;
+						NfNew = dt*qn/(Ths-ThRiNf);
 					}
-
-					// Artificial forcing to a larger value
-					if (NfNew > 0.0 && NfNew < 32000.) {
-						if (NfNew < 1.0)
-							NfNew = 1.0;
-						NtNew  = NfNew;
+					else  {   // [ R1 >= Ksat ]
+						ThReNf = Ths;
+						set_Suction_Term(0.0);
+						qn = Ksat*G*(ThReNf-ThRiNf)/Ksat + R1;
+						NfNew  = dt*qn/(ThReNf-ThRiNf);
 					}
-					else
-						NtNew = NfNew = NwtOld + 100.;
-
-					// Calculation of Requivalent:
-					if (NfNew < NwtOld) {
-						Mdelt = get_Lower_Moist(NfNew, NwtNew);
-						Mdelt = MuNew - Mdelt;
-						AA = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
+				}
 
-						if (Mdelt >= AA) {
-							// CASE 1
-							if (fabs(Mdelt - AA) <= 1.0E-6) {
-								NtNew = NfNew;
-								NfNew += 1.0E-5;
-								RuNew = Ksat*exp(-F*NtNew);
-							}
-							// CASE 2
-							else {
-								if (Mdelt >= NfNew*Ths) {
-									ThRiNf = get_InitMoist_depthZ(NfNew);
-									NfNew += (Mdelt - NfNew*Ths)/(Ths - ThRiNf);
-									if (NfNew >= (NwtNew + Psib)) {
-										NfNew = NtNew = NwtNew = 0.0;
-										MuNew = MiNew = 0.0;
-										RuNew = RiNew = 0.0;
-									}
-									else {
-										NtNew = 0.0;
-										RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-										AA = get_Lower_Moist(NfNew, NwtNew);
-										BB = NfNew*Ths;
-										MuNew = AA + BB;
-									}
+				// Artificial forcing to a larger value
+				if (NfNew > 0.0 && NfNew < 32000.) {
+					if (NfNew < 1.0)
+						NfNew = 1.0;
+					NtNew  = NfNew;
+				}
+				else
+					NtNew = NfNew = NwtOld + 100.;
+
+				// Calculation of Requivalent:
+				if (NfNew < NwtOld) {
+					Mdelt = get_Lower_Moist(NfNew, NwtNew);
+					Mdelt = MuNew - Mdelt;
+					AA = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
+
+					if (Mdelt >= AA) {
+						// CASE 1
+						if (fabs(Mdelt - AA) <= 1.0E-6) {
+							NtNew = NfNew;
+							NfNew += 1.0E-5;
+							RuNew = Ksat*exp(-F*NtNew);
+						}
+						// CASE 2
+						else {
+							if (Mdelt >= NfNew*Ths) {
+								ThRiNf = get_InitMoist_depthZ(NfNew);
+								NfNew += (Mdelt - NfNew*Ths)/(Ths - ThRiNf);
+								if (NfNew >= (NwtNew + Psib)) {
+									NfNew = NtNew = NwtNew = 0.0;
+									MuNew = MiNew = 0.0;
+									RuNew = RiNew = 0.0;
 								}
-								// Top front is NOT at the surface
-								else if (Mdelt < NfNew*Ths) {
-									RuNew = get_RechargeRate(Mdelt, NfNew);
-									NtNew = (log(Ksat/RuNew))/F;
-									NfNew += 1.0E-5;
+								else {
+									NtNew = 0.0;
+									RuNew = Ksat*F*NfNew/expm1(F*NfNew);
+									AA = get_Lower_Moist(NfNew, NwtNew);
+									BB = NfNew*Ths;
+									MuNew = AA + BB;
 								}
 							}
+							// Top front is NOT at the surface
+							else if (Mdelt < NfNew*Ths) {
+								RuNew = get_RechargeRate(Mdelt, NfNew);
+								NtNew = (log(Ksat/RuNew))/F;
+								NfNew += 1.0E-5;
+							}
 						}
-						// CASE 2
-						else
-							RuNew = get_RechargeRate(Mdelt, NfNew);
+					}
+					// CASE 2
+					else
+						RuNew = get_RechargeRate(Mdelt, NfNew);
 
 
-						if ((RiNew-RuNew) < 1.0E-2 && (RiNew - RuNew) > 0.0)
-							RuNew = RiNew;
-						else if ((RiNew-RuNew) > 1.0E-2)
-							cout<<"\nWarning: UNSAT: RuNew < RiNew: id = "<<cn->getID()<<"\n";
+					if ((RiNew-RuNew) < 1.0E-2 && (RiNew - RuNew) > 0.0)
+						RuNew = RiNew;
+					else if ((RiNew-RuNew) > 1.0E-2)
+						cout<<"\nWarning: UNSAT: RuNew < RiNew: id = "<<cn->getID()<<"\n";
 
-						if (RuNew > Ksat) {
-							cout<<"\nWarning: UNSAT: RuNew > Ksat: id = "
-							<<cn->getID()<<"\n\tRuNew = "<<RuNew<<"\tKsat = "<<Ksat<<"\n";
-						}
-                    }
-				}
+					if (RuNew > Ksat) {
+						cout<<"\nWarning: UNSAT: RuNew > Ksat: id = "
+						<<cn->getID()<<"\n\tRuNew = "<<RuNew<<"\tKsat = "<<Ksat<<"\n";
+					}
+                }
+			}
 
+            // CASE 2 : FRONTS BELOW THE SURFACE
+            //          A) Situation of surface perching
+
+            else if (NfOld > 0.0 && NtOld > 0.0) {
+                Mdelt = get_Lower_Moist(NfOld, NwtNew);
+                Mdelt = MuNew - Mdelt;
+
+                // The following case can be caused by too high dt
+                if (Mdelt >= NfOld*Ths) {
+                    ThRiNf = get_InitMoist_depthZ(NfOld);
+                    ThReNf = Ths;
+                    set_Suction_Term(NfOld);
+                    qn = Ksat*F*NfOld/expm1(F*NfOld);
+
+                    // Use SurfSatModel functions
+                    if ((qn*(Cos+G/NfOld)-RiOld*Cos) <= R1) {
+                        qn *= (Cos + G/NfOld);
+                        if (R1 >= (qn - RiOld*Cos)) {
+                            hsrf += (R1 - (qn - RiOld*Cos));
+                            R1 -= hsrf;
+                        }
+                        else
+                            cout<<"\nWarning: Wrong state def.: R < Keqviv-RiOld*Cos: id = "
+                            <<cn->getID()<<"\n\n";
+
+                        NtNew = 0.0;
+                        MuNew = MuOld + R1*dt;
+                        NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
+                        RuNew = Ksat*F*NfNew/expm1(F*NfNew);
+
+                        // Check to see whether WT has to be modified
+                        if ((fabs(NfNew-(NwtNew+Psib))<=1.0E-3) || (NfNew>(NwtNew+Psib))) {
+                            NwtNew = MiNew = 0.0;
+                            RuNew = RiNew = 0.0;
+                            Mperch = MuNew - NwtOld*Ths;
+                            if (Mperch > 0.0)
+                                sbsrf += Mperch/dt;
+                            MuNew = 0.0;
+                            NtNew = NfNew = 0.0;
+                        }
+                    }
+                    // Keep the unsaturated edge
+                    else {
+                        ThReNf = get_EdgeMoist_depthZ(NfOld);
+                        set_Suction_Term(NfOld);
+                        qn = RuOld*Cos + Ksat*exp(-F*NfOld)*G/NfOld;
+                        NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
+                        NtNew = NfNew;
+                        if (NfNew < (NwtNew+Psib)) {
+                            Mdelt = get_Lower_Moist(NfNew, NwtNew);
+                            Mdelt = MuNew - Mdelt;
+                            RuNew = get_RechargeRate(Mdelt, NfNew);
+                        }
+                        else {
+                            if (MuNew > Ths*NwtNew) {
+                                sbsrf += (MuNew  - Ths*NwtNew);
+                                NfNew = NtNew = NwtNew = 0.0;
+                                MuNew = MiNew = 0.0;
+                                RuNew = RiNew = 0.0;
+                            }
+                        }
+                    }
+                }
                 // CASE 2 : FRONTS BELOW THE SURFACE
-                //          A) Situation of surface perching
-
-                else if (NfOld > 0.0 && NtOld > 0.0) {
-                    Mdelt = get_Lower_Moist(NfOld, NwtNew);
-                    Mdelt = MuNew - Mdelt;
-
-                    // The following case can be caused by too high dt
-                    if (Mdelt >= NfOld*Ths) {
+                //          B) unsaturated wedge evolution
+                else {
+                    RuNew = get_RechargeRate(Mdelt, NfOld);
+                    Nstar = (log(Ksat/RuNew))/F;
+
+                    // The following situation occurs when a new slug of water
+                    // added to storage above NfOld exceeds the equivalent
+                    // moisture amount corresponding to NfOld depth but still
+                    // less than the maximum moisture capacity: NfOld*Ths
+                    // * The method used here to redefine Ntop and Ru is _approximate_
+                    // * More accurate way would be using LambertW function
+
+                    if (Nstar <= NfOld) {
+                        NtNew = Nstar;
+                        NfNew = NfOld+1.0E-5;
+                    }
+                    // We also need to move the wetting front deeper but
+                    // it is inconvenient because this requires re-writing
+                    // Perched_Sat case. With another code implementation,
+                    // we would call "Perched_Evol" function
+                    else {  // NfOld < Nstar - edge is still to be saturated
                         ThRiNf = get_InitMoist_depthZ(NfOld);
-                        ThReNf = Ths;
-                        set_Suction_Term(NfOld);
-                        qn = Ksat*F*NfOld/expm1(F*NfOld);
-
-                        // Use SurfSatModel functions
-                        if ((qn*(Cos+G/NfOld)-RiOld*Cos) <= R1) {
-                            qn *= (Cos + G/NfOld);
-                            if (R1 >= (qn - RiOld*Cos)) {
-                                hsrf += (R1 - (qn - RiOld*Cos));
-                                R1 -= hsrf;
+                        ThReNf = get_EdgeMoist_depthZ(NfOld);
+                        if (ThReNf <= ThRiNf) { // not too much water has been added
+
+                            // Water table is too close to the surface
+                            // The idea is to just redistribute the moisture
+                            // in the profile raising the local water table
+                            Mdelt = Ths*NwtOld - (MuOld + R1*dt);
+                            NwtNew = Newton(Mdelt, NwtOld);
+                            RuNew = RiNew = 0.0;
+                            MiNew = get_Total_Moist(NwtNew);
+                            MuNew = MiNew;
+                            QpOut = 0.0;
+
+                            if (NwtOld < 2.0*fabs(Psib)) {
+                                NtNew = NfNew = NwtNew;
                             }
-                            else
-                                cout<<"\nWarning: Wrong state def.: R < Keqviv-RiOld*Cos: id = "
-                                <<cn->getID()<<"\n\n";
-
-                            NtNew = 0.0;
-                            MuNew = MuOld + R1*dt;
-                            NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
-                            RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-
-                            // Check to see whether WT has to be modified
-                            if ((fabs(NfNew-(NwtNew+Psib))<=1.0E-3) || (NfNew>(NwtNew+Psib))) {
-                                NwtNew = MiNew = 0.0;
-                                RuNew = RiNew = 0.0;
-                                Mperch = MuNew - NwtOld*Ths;
-                                if (Mperch > 0.0)
-                                    sbsrf += Mperch/dt;
-                                MuNew = 0.0;
+                            else {
                                 NtNew = NfNew = 0.0;
-                            }
+								}
                         }
-                        // Keep the unsaturated edge
+
                         else {
-                            ThReNf = get_EdgeMoist_depthZ(NfOld);
                             set_Suction_Term(NfOld);
-                            qn = RuOld*Cos + Ksat*exp(-F*NfOld)*G/NfOld;
-                            NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
-                            NtNew = NfNew;
+                            qn = RuNew*Cos + Ksat*exp(-F*NfOld)*G/NfOld;
+                            NfNew  = NfOld + dt*(qn - RiNew*Cos)/(ThReNf-ThRiNf);
+                            NtNew  = NfNew;
                             if (NfNew < (NwtNew+Psib)) {
                                 Mdelt = get_Lower_Moist(NfNew, NwtNew);
                                 Mdelt = MuNew - Mdelt;
                                 RuNew = get_RechargeRate(Mdelt, NfNew);
                             }
-                            else {
-                                if (MuNew > Ths*NwtNew) {
-                                    sbsrf += (MuNew  - Ths*NwtNew);
-                                    NfNew = NtNew = NwtNew = 0.0;
-                                    MuNew = MiNew = 0.0;
-                                    RuNew = RiNew = 0.0;
-                                }
-                            }
-                        }
-                    }
-                    // CASE 2 : FRONTS BELOW THE SURFACE
-                    //          B) unsaturated wedge evolution
-                    else {
-                        RuNew = get_RechargeRate(Mdelt, NfOld);
-                        Nstar = (log(Ksat/RuNew))/F;
-
-                        // The following situation occurs when a new slug of water
-                        // added to storage above NfOld exceeds the equivalent
-                        // moisture amount corresponding to NfOld depth but still
-                        // less than the maximum moisture capacity: NfOld*Ths
-                        // * The method used here to redefine Ntop and Ru is _approximate_
-                        // * More accurate way would be using LambertW function
-
-                        if (Nstar <= NfOld) {
-                            NtNew = Nstar;
-                            NfNew = NfOld+1.0E-5;
                         }
-                        // We also need to move the wetting front deeper but
-                        // it is inconvenient because this requires re-writing
-                        // Perched_Sat case. With another code implementation,
-                        // we would call "Perched_Evol" function
-                        else {  // NfOld < Nstar - edge is still to be saturated
-                            ThRiNf = get_InitMoist_depthZ(NfOld);
-                            ThReNf = get_EdgeMoist_depthZ(NfOld);
-                            if (ThReNf <= ThRiNf) { // not too much water has been added
-
-                                // Water table is too close to the surface
-                                // The idea is to just redistribute the moisture
-                                // in the profile raising the local water table
-                                Mdelt = Ths*NwtOld - (MuOld + R1*dt);
-                                NwtNew = Newton(Mdelt, NwtOld);
-                                RuNew = RiNew = 0.0;
-                                MiNew = get_Total_Moist(NwtNew);
-                                MuNew = MiNew;
-                                QpOut = 0.0;
-
-                                if (NwtOld < 2.0*fabs(Psib)) {
-                                    NtNew = NfNew = NwtNew;
-                                }
-                                else {
-                                    NtNew = NfNew = 0.0;
-									}
-                            }
-
-                            else {
-                                set_Suction_Term(NfOld);
-                                qn = RuNew*Cos + Ksat*exp(-F*NfOld)*G/NfOld;
-                                NfNew  = NfOld + dt*(qn - RiNew*Cos)/(ThReNf-ThRiNf);
-                                NtNew  = NfNew;
-                                if (NfNew < (NwtNew+Psib)) {
-                                    Mdelt = get_Lower_Moist(NfNew, NwtNew);
-                                    Mdelt = MuNew - Mdelt;
-                                    RuNew = get_RechargeRate(Mdelt, NfNew);
-                                }
-                            }
-                        } // matches NfOld < Nstar
-                    }
+                    } // matches NfOld < Nstar
                 }
-					// Redistribute moisture along the profile:
-					// get to initialized state, raise water table
-					if ((NfNew > (NwtNew+Psib)) && (NfNew != NwtNew)) {
+            }
+				// Redistribute moisture along the profile:
+				// get to initialized state, raise water table
+				if ((NfNew > (NwtNew+Psib)) && (NfNew != NwtNew)) {
 
-						Mdelt = Ths*NwtNew - MuNew;
-						NwtNew = Newton(Mdelt, NwtOld);
-						RiNew = RuNew = 0.0;
-						MuNew = MiNew = get_Total_Moist(NwtNew);
-						NfNew = NtNew = NwtNew;
-					}
+					Mdelt = Ths*NwtNew - MuNew;
+					NwtNew = Newton(Mdelt, NwtOld);
+					RiNew = RuNew = 0.0;
+					MuNew = MiNew = get_Total_Moist(NwtNew);
+					NfNew = NtNew = NwtNew;
+				}
 
-					// Get the subsurface flux downstream
-					QpOut = 0.0;
-				if ((NtNew == NfNew) && (NfNew != NwtNew) && (NfNew > 10.0))
-					QpOut = get_UnSat_LateralFlow(NfNew, RuNew, ce->getVEdgLen()*1000.0);
+				// Get the subsurface flux downstream
+				QpOut = 0.0;
+			if ((NtNew == NfNew) && (NfNew != NwtNew) && (NfNew > 10.0))
+				QpOut = get_UnSat_LateralFlow(NfNew, RuNew, ce->getVEdgLen()*1000.0);
 
-                if ((NfNew-NtNew) > 1.0)
-                    QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.0);
+            if ((NfNew-NtNew) > 1.0)
+                QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.0);
 
-                QpOut *= Sin;
-				break;
+            QpOut *= Sin;
+			break;
 
 
-				//---------------
-			case Perched_Evol:
+			//---------------
+		case Perched_Evol:
 
-				if (R <= RADAR)
-					IntStormVar += dt;
-				else
-					IntStormVar = 0.0;
+			if (R <= RADAR)
+				IntStormVar += dt;
+			else
+				IntStormVar = 0.0;
 
-				R1 = (R + (QpIn-QpOut))*Cos;
+			R1 = (R + (QpIn-QpOut))*Cos;
 
-				NwtNew = NwtOld;
-				MuNew = MuOld + R1*dt;
-				MiNew = MiOld;
-				RiNew = RiOld;
+			NwtNew = NwtOld;
+			MuNew = MuOld + R1*dt;
+			MiNew = MiOld;
+			RiNew = RiOld;
 
-				// The problem here is that the new coming moisture is not
-				// taken into account up to the point where we define NtNew
-				// We define the flux qn based on the OLD position of Nf and Nt
-				// Given a sufficiently small time step this should not be an issue
+			// The problem here is that the new coming moisture is not
+			// taken into account up to the point where we define NtNew
+			// We define the flux qn based on the OLD position of Nf and Nt
+			// Given a sufficiently small time step this should not be an issue
 
-				ThRiNf = get_InitMoist_depthZ(NfOld);
-				ThReNf = Ths;
-				set_Suction_Term(NfOld);
+			ThRiNf = get_InitMoist_depthZ(NfOld);
+			ThReNf = Ths;
+			set_Suction_Term(NfOld);
 
-				qn = Ksat*F*(NfOld-NtOld)/(exp(F*NfOld)-exp(F*NtOld));
-				qn *= (Cos + G/NfOld);
+			qn = Ksat*F*(NfOld-NtOld)/(exp(F*NfOld)-exp(F*NtOld));
+			qn *= (Cos + G/NfOld);
 
-				// Wetting front evolution
-				NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
+			// Wetting front evolution
+			NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
 
-				// Check for possible situations with Nf and Nwt
-				if (fabs(NfNew - (NwtNew+Psib)) <= 1.0E-3) {
-					NwtNew = NtOld-Psib;
-					NfNew = NwtNew;
-				}
-                else if (NfNew > (NwtNew+Psib)) {
-                    NwtNew = NtOld-Psib;
-                    NfNew = NwtNew;
-                    R1 += qn - ((NwtOld+Psib-NfOld)*(Ths-ThRiNf)/dt + RiNew*Cos);
-                }
+			// Check for possible situations with Nf and Nwt
+			if (fabs(NfNew - (NwtNew+Psib)) <= 1.0E-3) {
+				NwtNew = NtOld-Psib;
+				NfNew = NwtNew;
+			}
+            else if (NfNew > (NwtNew+Psib)) {
+                NwtNew = NtOld-Psib;
+                NfNew = NwtNew;
+                R1 += qn - ((NwtOld+Psib-NfOld)*(Ths-ThRiNf)/dt + RiNew*Cos);
+            }
 
-                // Wetting front has reached the water table
-                if (NfNew == NwtNew) {
+            // Wetting front has reached the water table
+            if (NfNew == NwtNew) {
 
-                    if (MuNew >= NwtOld*Ths) {
-                        NwtNew = NtNew = NfNew = 0.0;
-                        sbsrf = (MuNew - NwtOld*Ths)/dt;
-                        MuNew = MiNew = 0.0;
-                        RuNew = RiNew = 0.0;
-                    }
-                    else  {
-                        Mdelt = Ths*NwtOld - MuNew;
-                        NwtNew = Newton(Mdelt, NwtOld);
-                        RiNew = RuNew = 0.0;
-                        MiNew = get_Total_Moist(NwtNew);
-                        MuNew = MiNew;
-                        NtNew = NfNew = NwtNew;
-                    }
+                if (MuNew >= NwtOld*Ths) {
+                    NwtNew = NtNew = NfNew = 0.0;
+                    sbsrf = (MuNew - NwtOld*Ths)/dt;
+                    MuNew = MiNew = 0.0;
+                    RuNew = RiNew = 0.0;
                 }
-                // If NfNew is still above water table
-
-                else if (NfNew != NwtNew) {
-                    Mdelt = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NtOld/Eps)) + Thr*NtOld;
-                    Mdva  = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
-                    // Max amount of water that can be lost without
-                    // transforming the state to unsaturated state
-                    AA = (Mdelt+(NfNew-NtOld)*Ths - Mdva);
-
-                    // Next state is unsaturated
-                    if ((R1+RiNew*Cos) < (qn - AA/dt)) {
-                        Mperch = get_Lower_Moist(NfNew, NwtNew);
-                        Mperch = MuNew - Mperch;
-                        RuNew = get_RechargeRate(Mperch, NfNew);
-                        NtNew = NfNew;
+                else  {
+                    Mdelt = Ths*NwtOld - MuNew;
+                    NwtNew = Newton(Mdelt, NwtOld);
+                    RiNew = RuNew = 0.0;
+                    MiNew = get_Total_Moist(NwtNew);
+                    MuNew = MiNew;
+                    NtNew = NfNew = NwtNew;
+                }
+            }
+            // If NfNew is still above water table
+
+            else if (NfNew != NwtNew) {
+                Mdelt = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NtOld/Eps)) + Thr*NtOld;
+                Mdva  = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfNew/Eps)) + Thr*NfNew;
+                // Max amount of water that can be lost without
+                // transforming the state to unsaturated state
+                AA = (Mdelt+(NfNew-NtOld)*Ths - Mdva);
+
+                // Next state is unsaturated
+                if ((R1+RiNew*Cos) < (qn - AA/dt)) {
+                    Mperch = get_Lower_Moist(NfNew, NwtNew);
+                    Mperch = MuNew - Mperch;
+                    RuNew = get_RechargeRate(Mperch, NfNew);
+                    NtNew = NfNew;
+                }
+                //  Next state is either Surf_Sat or Perch_Sat
+                else {
+                    xxsrf = (R1 - qn)*dt + Mdelt;
+                    // The influx is high enough to fill space above Ntop
+                    if (xxsrf >= NtOld*Ths) {
+                        NtNew = 0.0;
+                        hsrf += (xxsrf - NtOld*Ths)/dt;
+                        MuNew -= hsrf*dt;
+                        RuNew = Ksat*F*NfNew/expm1(F*NfNew);
                     }
-                    //  Next state is either Surf_Sat or Perch_Sat
                     else {
-                        xxsrf = (R1 - qn)*dt + Mdelt;
-                        // The influx is high enough to fill space above Ntop
-                        if (xxsrf >= NtOld*Ths) {
-                            NtNew = 0.0;
-                            hsrf += (xxsrf - NtOld*Ths)/dt;
-                            MuNew -= hsrf*dt;
-                            RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-                        }
-                        else {
-                            BB = -dt*(qn - R1)/(Ths-Thr) - Eps/F*exp(-F*NtOld/Eps);
-                            AA = -exp(F*(BB-NtOld)/Eps);
-                            if (AA < (-1.0/exp(1.0)))
-                                cout<<"\n\n\t\tWarning: Value for LAMBERT f-n is too small\n\n";
-                            NtNew = NtOld + (Eps/F*LambertW(AA) - BB);
-                            RuNew = Ksat*exp(-F*NtNew);
-                        }
+                        BB = -dt*(qn - R1)/(Ths-Thr) - Eps/F*exp(-F*NtOld/Eps);
+                        AA = -exp(F*(BB-NtOld)/Eps);
+                        if (AA < (-1.0/exp(1.0)))
+                            cout<<"\n\n\t\tWarning: Value for LAMBERT f-n is too small\n\n";
+                        NtNew = NtOld + (Eps/F*LambertW(AA) - BB);
+                        RuNew = Ksat*exp(-F*NtNew);
+                    }
+
+                    // Only for the cases when Nf has not reached WT
 
-                        // Only for the cases when Nf has not reached WT
-
-                        if (NwtNew != 0.0) {
-                            AA = get_Lower_Moist(NfNew, NwtNew);
-                            BB=(NfNew-NtNew)*Ths + Eps/F*(Ths-Thr)*(1.0-exp(-F*NtNew/Eps))+Thr*NtNew;
-
-                            if (MuNew > (AA + BB)) {
-                                ThRiNf = get_InitMoist_depthZ(NfNew);
-                                // To redistribute imbalance
-                                NfNew += (MuNew - (AA+BB))/(Ths - ThRiNf);
-
-                                if (NfNew >= (NwtNew+Psib)) {
-                                    if (NtNew > 0.0) {
-                                        NwtNew = NtNew - Psib;
-                                        NfNew = NtNew = NwtNew;
-                                        MuNew = MiNew = get_Total_Moist(NwtNew);
-                                        RiNew = RuNew = 0.0;
-                                    }
-                                    else if (NtNew == 0.0) {
-                                        NwtNew = NfNew = NtNew = 0.0;
-                                        MuNew = MiNew = 0.0;
-                                        RiNew = RuNew = 0.0;
-                                    }
+                    if (NwtNew != 0.0) {
+                        AA = get_Lower_Moist(NfNew, NwtNew);
+                        BB=(NfNew-NtNew)*Ths + Eps/F*(Ths-Thr)*(1.0-exp(-F*NtNew/Eps))+Thr*NtNew;
+
+                        if (MuNew > (AA + BB)) {
+                            ThRiNf = get_InitMoist_depthZ(NfNew);
+                            // To redistribute imbalance
+                            NfNew += (MuNew - (AA+BB))/(Ths - ThRiNf);
+
+                            if (NfNew >= (NwtNew+Psib)) {
+                                if (NtNew > 0.0) {
+                                    NwtNew = NtNew - Psib;
+                                    NfNew = NtNew = NwtNew;
+                                    MuNew = MiNew = get_Total_Moist(NwtNew);
+                                    RiNew = RuNew = 0.0;
                                 }
-                                else {
-                                    MuNew = AA+BB;
-                                    if (NtNew == 0.0)
-                                        RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-									}
+                                else if (NtNew == 0.0) {
+                                    NwtNew = NfNew = NtNew = 0.0;
+                                    MuNew = MiNew = 0.0;
+                                    RiNew = RuNew = 0.0;
+                                }
+                            }
+                            else {
+                                MuNew = AA+BB;
+                                if (NtNew == 0.0)
+                                    RuNew = Ksat*F*NfNew/expm1(F*NfNew);
 								}
 							}
 						}
 					}
+				}
 
-					QpOut = 0.0;
-				if ((NtNew == NfNew) && (NfNew != NwtNew) && (NfNew > 10.0))
-					QpOut = get_UnSat_LateralFlow(NfNew, RuNew, ce->getVEdgLen()*1000.0);
+				QpOut = 0.0;
+			if ((NtNew == NfNew) && (NfNew != NwtNew) && (NfNew > 10.0))
+				QpOut = get_UnSat_LateralFlow(NfNew, RuNew, ce->getVEdgLen()*1000.0);
 
-                if ((NfNew-NtNew) > 1.0)
-                    QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.0);
+            if ((NfNew-NtNew) > 1.0)
+                QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.0);
 
-                QpOut *= Sin;
+            QpOut *= Sin;
 
-                break;
+            break;
 
 
-				//-------------------
-			case Perched_SurfSat:
+			//-------------------
+		case Perched_SurfSat:
 
-				if (R <= RADAR )
-					IntStormVar += dt;
-				else
-					IntStormVar = 0.0;
+			if (R <= RADAR )
+				IntStormVar += dt;
+			else
+				IntStormVar = 0.0;
 
-				if (Ksat == 0.0) {
-					MuNew=MiNew=0.0;
-					RiNew=RuNew=0.0;
-					NfNew=NtNew=0.0;
-					NwtNew=NwtOld;
-					QpOut=0.0;
-					hsrf+=R*Cos;
-				}
-					else  {
-						NwtNew = NwtOld;
+			if (Ksat == 0.0) {
+				MuNew=MiNew=0.0;
+				RiNew=RuNew=0.0;
+				NfNew=NtNew=0.0;
+				NwtNew=NwtOld;
+				QpOut=0.0;
+				hsrf+=R*Cos;
+			}
+				else  {
+					NwtNew = NwtOld;
 
-						// Pearched surface saturation has already developed
-						if ((NtOld == 0.0) && (NfOld > 0.0) && (NfOld != NwtOld)) {
-							ThRiNf = get_InitMoist_depthZ(NfOld);
-							ThReNf = Ths;
-							set_Suction_Term(NfOld);
-							qn = Ksat*F*NfOld/expm1(F*NfOld);
-							qn *= (Cos + G/NfOld);
+					// Pearched surface saturation has already developed
+					if ((NtOld == 0.0) && (NfOld > 0.0) && (NfOld != NwtOld)) {
+						ThRiNf = get_InitMoist_depthZ(NfOld);
+						ThReNf = Ths;
+						set_Suction_Term(NfOld);
+						qn = Ksat*F*NfOld/expm1(F*NfOld);
+						qn *= (Cos + G/NfOld);
 
-							// The newcoming moisture is not taken into account
-							// define the flux based on old state variables
+						// The newcoming moisture is not taken into account
+						// define the flux based on old state variables
 
-							R1 = (R + (QpIn-QpOut))*Cos;
+						R1 = (R + (QpIn-QpOut))*Cos;
 
-							// Infiltration excess runoff is generated
-							if (R1 >= qn) {
-								hsrf += (R1 - qn);
-								R1 -= hsrf;
-							}
+						// Infiltration excess runoff is generated
+						if (R1 >= qn) {
+							hsrf += (R1 - qn);
+							R1 -= hsrf;
+						}
 
-							else {
-						    	    cout<<"\nWarning: WRONG state def.: R < Keqviv-RiOld*Cos: id = "
-								<<cn->getID()<<"\n\n";
-                            }
+						else {
+					    	    cout<<"\nWarning: WRONG state def.: R < Keqviv-RiOld*Cos: id = "
+							<<cn->getID()<<"\n\n";
+                        }
 
-							NtNew = 0.0;
-							RiNew = RiOld;
-							MiNew = MiOld;
-							MuNew = MuOld + R1*dt;
-							NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
-						}
+						NtNew = 0.0;
+						RiNew = RiOld;
+						MiNew = MiOld;
+						MuNew = MuOld + R1*dt;
+						NfNew = NfOld + dt*(qn-RiNew*Cos)/(Ths-ThRiNf);
+					}
 
-						if (NfNew >= 1.0) {
-							RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-							if (RuNew > Ksat)
-								RuNew = Ksat;
-						}
-						else
+					if (NfNew >= 1.0) {
+						RuNew = Ksat*F*NfNew/expm1(F*NfNew);
+						if (RuNew > Ksat)
 							RuNew = Ksat;
+					}
+					else
+						RuNew = Ksat;
+
+					// Check to see if WT is needed to be modified
+					if ((fabs(NfNew-(NwtNew+Psib)) <= 1.0E-3) || (NfNew > (NwtNew+Psib))) {
+						Mperch = MuNew - NwtOld*Ths;
+						if (Mperch >= 0.0) {
+							sbsrf += Mperch/dt;
+							NfNew = NtNew = NwtNew = 0.0;
+							MiNew = MuNew = 0.0;
+							RiNew = RuNew = 0.0;
+						}
+						else {
+							NwtNew = Newton(fabs(Mperch), 0.0);
+							MuNew = MiNew = get_Total_Moist(NwtNew);
+							RiNew = RuNew = 0.0;
+							NfNew=NtNew=NwtNew;
+						}
+					}
 
-						// Check to see if WT is needed to be modified
-						if ((fabs(NfNew-(NwtNew+Psib)) <= 1.0E-3) || (NfNew > (NwtNew+Psib))) {
-							Mperch = MuNew - NwtOld*Ths;
-							if (Mperch >= 0.0) {
-								sbsrf += Mperch/dt;
-								NfNew = NtNew = NwtNew = 0.0;
-								MiNew = MuNew = 0.0;
+					// Only for the case when Nf has not reached water table
+					if (NwtNew != 0.0 && NfNew >= 1.0 && NfNew != NwtNew) {
+						AA = get_Lower_Moist(NfNew, NwtNew);
+						BB = NfNew*Ths;
+						if (MuNew >= (AA+BB)) {
+							ThRiNf = get_InitMoist_depthZ(NfNew);
+							NfNew += (MuNew - (AA+BB))/(Ths-ThRiNf);
+							if (NfNew >= (NwtNew+Psib)) {
+								if (MuNew >= (NwtOld*Ths))
+									sbsrf += (MuNew - NwtOld*Ths);
+								NwtNew = 0.0;
 								RiNew = RuNew = 0.0;
+								MiNew = MuNew = 0.0;
+								NfNew = NtNew = 0.0;
 							}
 							else {
-								NwtNew = Newton(fabs(Mperch), 0.0);
-								MuNew = MiNew = get_Total_Moist(NwtNew);
-								RiNew = RuNew = 0.0;
-								NfNew=NtNew=NwtNew;
-							}
-						}
-
-						// Only for the case when Nf has not reached water table
-						if (NwtNew != 0.0 && NfNew >= 1.0 && NfNew != NwtNew) {
-							AA = get_Lower_Moist(NfNew, NwtNew);
-							BB = NfNew*Ths;
-							if (MuNew >= (AA+BB)) {
-								ThRiNf = get_InitMoist_depthZ(NfNew);
-								NfNew += (MuNew - (AA+BB))/(Ths-ThRiNf);
-								if (NfNew >= (NwtNew+Psib)) {
-									if (MuNew >= (NwtOld*Ths))
-										sbsrf += (MuNew - NwtOld*Ths);
-									NwtNew = 0.0;
-									RiNew = RuNew = 0.0;
-									MiNew = MuNew = 0.0;
-									NfNew = NtNew = 0.0;
-								}
-								else {
-									MuNew = AA+BB;
-									RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-								}
+								MuNew = AA+BB;
+								RuNew = Ksat*F*NfNew/expm1(F*NfNew);
 							}
 						}
-						QpOut = 0.0;
-						if ((NfNew-NtNew) > 10.0) {
-							QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.0);
-							QpOut *= Sin;
-						}
 					}
-					break;
+					QpOut = 0.0;
+					if ((NfNew-NtNew) > 10.0) {
+						QpOut = get_Sat_LateralFlow(NtNew, NfNew, RuNew, ce->getVEdgLen()*1000.0);
+						QpOut *= Sin;
+					}
+				}
+				break;
 
-            default:
-                cerr<<"No Case Identified in tHydroModel::UnSaturatedZone"<<endl; //WR debug: Clang warning
-  }
+        default:
+            cerr<<"No Case Identified in tHydroModel::UnSaturatedZone"<<endl; //WR debug: Clang warning
+}
 
-		// End of case handling for unsat+perched timestep
+	// End of case handling for unsat+perched timestep
 
-		// Step 4: Print Statements
-		//---------------------------------------------
+	// Step 4: Print Statements
+	//---------------------------------------------
 
-		if (simCtrl->Verbose_label == 'Y') {
-			if (NtNew<0 || NtOld<0) { cout <<"\nWarning: Top Front < 0\n\n";
-				cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
-					<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout<<"NtNew = "<< NtNew << "\tR1 = " << R1 <<"; id = "<<cn->getID()<<endl;}
-
-			if (NfNew<0 || NfOld<0) { cout<<"\nWarning: Wetting Front < 0\n\n";
-				cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
-					<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout<<"NfNew = " <<NfNew<<"\tR1 = "<<R1<<"; id = "<<cn->getID()<<endl;}
-
-			if (NtNew>NwtNew) { cout <<"\nWarning: Top Front > WT depth\n\n";
-				cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
-					<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout<<"NtNew = " << NtNew <<", NwtNew = " << NwtNew
-					<<"\tR1 = " << R1 <<"; id = "<<cn->getID()<<endl; }
-
-			if (NfNew>NwtNew) { cout<<"\nWarning: Top Front > WT depth\n\n";
-				cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
-					<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout<<"NfNew = " << NfNew <<", NwtNew = " << NwtNew
-					<<"\tR1 = " << R1 <<"; id = "<<cn->getID()<<endl; }
-
-			if (NtNew>NfNew) { cout<<"\nWarning: Top Front > Wet front\n\n";
-				cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
-					<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout<<"NtNew = "<<NtNew<<", NfNew = "<<NfNew
-					<<"\tR1 = "<<R1 <<"; id = "<<cn->getID()<<endl; }
-
-			if (NwtNew<0 || NwtOld<0) { cout<<"\nWarning: Water Table < 0\n\n";
-				cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
-					<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout<<"NwtNew = "<<NwtNew<<"\tR1 = "<<R1<<"; id = "<<cn->getID()<<endl; }
-
-			if (hsrf<0.0)  cout<<"\nWarning: RUNOFF - hsrf  < 0: id = "<<cn->getID()<<"\n";
-			if (sbsrf<0.0) cout<<"\nWarning: RUNOFF - sbsrf < 0: id = "<<cn->getID()<<"\n";
-			if (psrf<0.0)  cout<<"\nWarning:  RUNOFF - psrf  < 0: id = "<<cn->getID()<<"\n";
-
-			if (hsrf>999999.) {
-				cout<<"\nWarning! RUNOFF comp.- hsrf  "
-				<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
-				hsrf = 0.0;
-			}
-			if (sbsrf>999999.) {
-				cout<<"\nWarning! RUNOFF comp.- sbsrf  "
-				<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
-				sbsrf = 0.0;
-			}
-			if (psrf>999999.) {
-				cout<<"\nWarning! RUNOFF comp.- psrf  "
-				<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
-				psrf = 0.0;
-			}
+	if (simCtrl->Verbose_label == 'Y') {
+		if (NtNew<0 || NtOld<0) { cout <<"\nWarning: Top Front < 0\n\n";
+			cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
+				<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout<<"NtNew = "<< NtNew << "\tR1 = " << R1 <<"; id = "<<cn->getID()<<endl;}
+
+		if (NfNew<0 || NfOld<0) { cout<<"\nWarning: Wetting Front < 0\n\n";
+			cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
+				<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout<<"NfNew = " <<NfNew<<"\tR1 = "<<R1<<"; id = "<<cn->getID()<<endl;}
+
+		if (NtNew>NwtNew) { cout <<"\nWarning: Top Front > WT depth\n\n";
+			cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
+				<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout<<"NtNew = " << NtNew <<", NwtNew = " << NwtNew
+				<<"\tR1 = " << R1 <<"; id = "<<cn->getID()<<endl; }
+
+		if (NfNew>NwtNew) { cout<<"\nWarning: Top Front > WT depth\n\n";
+			cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
+				<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout<<"NfNew = " << NfNew <<", NwtNew = " << NwtNew
+				<<"\tR1 = " << R1 <<"; id = "<<cn->getID()<<endl; }
+
+		if (NtNew>NfNew) { cout<<"\nWarning: Top Front > Wet front\n\n";
+			cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
+				<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout<<"NtNew = "<<NtNew<<", NfNew = "<<NfNew
+				<<"\tR1 = "<<R1 <<"; id = "<<cn->getID()<<endl; }
+
+		if (NwtNew<0 || NwtOld<0) { cout<<"\nWarning: Water Table < 0\n\n";
+			cout<<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld
+				<<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout<<"NwtNew = "<<NwtNew<<"\tR1 = "<<R1<<"; id = "<<cn->getID()<<endl; }
+
+		if (hsrf<0.0)  cout<<"\nWarning: RUNOFF - hsrf  < 0: id = "<<cn->getID()<<"\n";
+		if (sbsrf<0.0) cout<<"\nWarning: RUNOFF - sbsrf < 0: id = "<<cn->getID()<<"\n";
+		if (psrf<0.0)  cout<<"\nWarning:  RUNOFF - psrf  < 0: id = "<<cn->getID()<<"\n";
+
+		if (hsrf>999999.) {
+			cout<<"\nWarning! RUNOFF comp.- hsrf  "
+			<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
+			hsrf = 0.0;
+		}
+		if (sbsrf>999999.) {
+			cout<<"\nWarning! RUNOFF comp.- sbsrf  "
+			<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
+			sbsrf = 0.0;
+		}
+		if (psrf>999999.) {
+			cout<<"\nWarning! RUNOFF comp.- psrf  "
+			<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
+			psrf = 0.0;
+		}
 
-			if (MuNew < MiNew)
-				cout<<"\nWarning: MuNew < MiNew -- ENDDD --: id = "<<cn->getID()<<"\n\n";
+		if (MuNew < MiNew)
+			cout<<"\nWarning: MuNew < MiNew -- ENDDD --: id = "<<cn->getID()<<"\n\n";
 
-			if ((RuNew < RiNew) && (RuNew != 0.0))
-				cout<<"\nWarning: RuNew < RiNew: id = "<<cn->getID()<<"\n\n";
+		if ((RuNew < RiNew) && (RuNew != 0.0))
+			cout<<"\nWarning: RuNew < RiNew: id = "<<cn->getID()<<"\n\n";
 
-			if (RuNew < 0.0)
-				cout<<"\nWarning: RuNew < 0: id = "<<cn->getID()<<"\n\n";
+		if (RuNew < 0.0)
+			cout<<"\nWarning: RuNew < 0: id = "<<cn->getID()<<"\n\n";
 
-			if (RiNew > 0.0) {
-				cout<<"\nWarning: NON-Equilibrium rate - RiNew>0: id =";
-				cout<<cn->getID()<<"\n\n";}
+		if (RiNew > 0.0) {
+			cout<<"\nWarning: NON-Equilibrium rate - RiNew>0: id =";
+			cout<<cn->getID()<<"\n\n";}
 
-			if ((NfNew < NfOld) && (NfNew != 0.0) &&
-				(NfNew != NwtNew) && (NfOld != NwtOld))
-				cout<<"\nWarning: NfNew < NfOld: id = "<<cn->getID()<<"\n\n";
-		}
+		if ((NfNew < NfOld) && (NfNew != 0.0) &&
+			(NfNew != NwtNew) && (NfOld != NwtOld))
+			cout<<"\nWarning: NfNew < NfOld: id = "<<cn->getID()<<"\n\n";
+	}
 
 
-		// Adding runoff contributions from Unsat Zone dynamics
-		esrf = psrf;
-		esrf = esrf/Cos;
+	// Adding runoff contributions from Unsat Zone dynamics
+	esrf = psrf;
+	esrf = esrf/Cos;
+
+	srf = hsrf + sbsrf + psrf;
+
+	// 'Cos' factor in order to transform
+	// to the rate for a horizontal plane
+	srf /= Cos;
+	hsrf  /= Cos;
+	sbsrf /= Cos;
+	psrf  /= Cos;
+
+	// Update Variables
+	double dM1, dM2, ThSurf0, ThRoot0, QpOut0;
+
+	ThSurf0 = cn->getSoilMoistureSC();
+	ThRoot0 = cn->getRootMoistureSC();
+	QpOut0  = cn->getQpout();
+
+	cn->setNwtNew(NwtNew);
+	cn->setMuNew(MuNew);
+	cn->setMiNew(MiNew);
+	cn->setNfNew(NfNew);
+	cn->setNtNew(NtNew);
+	cn->setRiNew(RiNew);
+	cn->setRuNew(RuNew);
+	cn->setQpout(QpOut);
+	cn->setIntStormVar(IntStormVar);
+
+	cn->addSrf_Hr(srf*dt); // WR debug 02062024-- this scaled by dt so appears that it is only a total (mm), but its re-set every hour it the total runoff in an hour as written to .pixel file
+	cn->setsrf(srf*dt);
+	cn->addCumSrf(srf*dt);
+	cn->setsbsrf(sbsrf*dt);
+	cn->sethsrf(hsrf*dt);
+	cn->setpsrf(psrf*dt);
+	cn->setesrf(esrf*dt);
+
+	// Soil moisture in the top 10 cm
+	ThSurf = ComputeSurfSoilMoist(surfaceSoilDepth);
+	cn->setSoilMoisture( ThSurf );
+	cn->setSoilMoistureSC( ThSurf/Ths );
+
+	// Soil moisture in the unsaturated zone
+	if (NwtNew)
+		cn->setSoilMoistureUNSC( MuNew/NwtNew/Ths );
+	else
+		cn->setSoilMoistureUNSC( 1.0 );
+
+	// Estimate root soil moisture and the averages
+	ThSurf = ComputeSurfSoilMoist(rootZoneDepth);
+	cn->setRootMoisture( ThSurf );
+	cn->setRootMoistureSC( ThSurf/Ths );
+	AverageSoilMoisture(cn, cn->getSoilMoistureSC(), cn->getRootMoistureSC());
+
+	// Set other variables
+	cn->setRecharge((NwtNew-NwtOld)*Ths/(Cos*dt));
+	cn->setUnSatFlowOut(QpOut*1.0E-6/(cn->getVArea()));
+	cn->setUnSatFlowIn(QpIn*1.0E-6/(cn->getVArea()));
+
+	//Saturation frequencies
+	if (hsrf>0.0)
+		cn->hsrfOccur=cn->hsrfOccur+floor(hsrf*1.0E+3)+1.0E-6;
+	if (sbsrf>0.0)
+		cn->sbsrfOccur=cn->sbsrfOccur+floor(sbsrf*1.0E+3)+1.0E-6;
+	if (psrf>0.0)
+		cn->psrfOccur=cn->psrfOccur+floor(psrf*1.0E+3)+1.0E-6;
+	if (ComputeSurfSoilMoist(1.0)/Ths > 0.999)
+		cn->satOccur = cn->satOccur + 1;
+
+	// The term with 'sbsrf' is not exactly right...
+	cn->RechDisch=cn->RechDisch+((NwtOld-NwtNew)+sbsrf*dt*Cos/Ths)*1.0E-3;
+
+	// Set QpIn to downslope cell, workers leave this to the caller
+	dnode = (tCNode *)ce->getDestinationPtrNC();
+	if (!worker)
+		dnode->addQpin(QpOut);
 
-		srf = hsrf + sbsrf + psrf;
+#ifdef PARALLEL_TRIBS
+// Send Qpin from reach outlet node to
+// reach head node, if on another processor
+int idin = cn->getReach();
+int idout = dnode->getReach();
+if (idin != idout && tGraph::hasDownstream(idin)) {
+tGraph::sendQpin(idin, dnode, QpOut);
+
+  // If runon option is set, send srf to node above
+  // outlet to head
+  if (RunOnoption)
+      tGraph::sendRunFlux(cn);
+}
 
-		// 'Cos' factor in order to transform
-		// to the rate for a horizontal plane
-		srf /= Cos;
-		hsrf  /= Cos;
-		sbsrf /= Cos;
-		psrf  /= Cos;
+#endif
 
-		// Update Variables
-		double dM1, dM2, ThSurf0, ThRoot0, QpOut0;
+	// The following units are [m^3]
+	Stok += srf*dt*cn->getVArea()/1000.0;
+    TotGWchange += (NwtNew-NwtOld)*Ths*cn->getVArea()/(Cos*1000.0);
+	TotMoist += (MuNew-MuOld)*cn->getVArea()/(Cos*1000.0);
 
-		ThSurf0 = cn->getSoilMoistureSC();
-		ThRoot0 = cn->getRootMoistureSC();
-		QpOut0  = cn->getQpout();
+	// Code related to soil moisture study by Valerio Noto
+	double AreaF, fs, ft, fc;
+    fs = ft = fc = 0;
 
-		cn->setNwtNew(NwtNew);
-		cn->setMuNew(MuNew);
-		cn->setMiNew(MiNew);
-		cn->setNfNew(NfNew);
-		cn->setNtNew(NtNew);
-		cn->setRiNew(RiNew);
-		cn->setRuNew(RuNew);
-		cn->setQpout(QpOut);
-		cn->setIntStormVar(IntStormVar);
-
-		cn->addSrf_Hr(srf*dt); // WR debug 02062024-- this scaled by dt so appears that it is only a total (mm), but its re-set every hour it the total runoff in an hour as written to .pixel file
-		cn->setsrf(srf*dt);
-		cn->addCumSrf(srf*dt);
-		cn->setsbsrf(sbsrf*dt);
-		cn->sethsrf(hsrf*dt);
-		cn->setpsrf(psrf*dt);
-		cn->setesrf(esrf*dt);
-
-		// Soil moisture in the top 10 cm
-		ThSurf = ComputeSurfSoilMoist(surfaceSoilDepth);
-		cn->setSoilMoisture( ThSurf );
-		cn->setSoilMoistureSC( ThSurf/Ths );
-
-		// Soil moisture in the unsaturated zone
-		if (NwtNew)
-			cn->setSoilMoistureUNSC( MuNew/NwtNew/Ths );
+	QpOut0 *= ((1.0E-6)/(cn->getVArea()));
+
+	// GW rise
+	if (NwtNew < NwtOld) {
+		fs = fabs(MuNew+Ths*(NwtOld-NwtNew)-MuOld)/dt-(QpIn-QpOut0)*Cos+(EvapSoi+EvapVeg);
+		ft = fabs(QpIn-QpOut0)*Cos;
+		fc = fabs(EvapSoi+EvapVeg);
+	}
+	// GW drop
+	else if (NwtNew > NwtOld) {
+		if (RuOld > 0)
+			fs = RuOld;
 		else
-			cn->setSoilMoistureUNSC( 1.0 );
-
-		// Need to divide by the total # of time steps elapsed
-		AA = (double)timer->getElapsedSteps(timer->getCurrentTime());
-		// The integer part - surface SM
-		BB = floor(cn->getAvSoilMoisture())*1.0E-4;
-		// The decimal part - root SM
-		Mdelt = (cn->getAvSoilMoisture() - floor(cn->getAvSoilMoisture()))*1.0E+1;
-		cn->setAvSoilMoisture(0.0);
-		cn->setAvSoilMoisture(floor((BB*AA + ThSurf/Ths)/(AA+1)*1.0E+4));
-
-		// Estimate average root soil moisture
-		ThSurf = ComputeSurfSoilMoist(rootZoneDepth);
-		cn->setRootMoisture( ThSurf );
-		cn->setRootMoistureSC( ThSurf/Ths );
-		cn->addAvSoilMoisture((Mdelt*AA + ThSurf/Ths)/(AA+1.0)*1.0E-1);
-
-		// Set other variables
-		cn->setRecharge((NwtNew-NwtOld)*Ths/(Cos*dt));
-		cn->setUnSatFlowOut(QpOut*1.0E-6/(cn->getVArea()));
-		cn->setUnSatFlowIn(QpIn*1.0E-6/(cn->getVArea()));
-
-		//Saturation frequencies
-		if (hsrf>0.0)
-			cn->hsrfOccur=cn->hsrfOccur+floor(hsrf*1.0E+3)+1.0E-6;
-		if (sbsrf>0.0)
-			cn->sbsrfOccur=cn->sbsrfOccur+floor(sbsrf*1.0E+3)+1.0E-6;
-		if (psrf>0.0)
-			cn->psrfOccur=cn->psrfOccur+floor(psrf*1.0E+3)+1.0E-6;
-		if (ComputeSurfSoilMoist(1.0)/Ths > 0.999)
-			cn->satOccur = cn->satOccur + 1;
-
-		// The term with 'sbsrf' is not exactly right...
-		cn->RechDisch=cn->RechDisch+((NwtOld-NwtNew)+sbsrf*dt*Cos/Ths)*1.0E-3;
-
-		// Set QpIn to downslope cell
-		dnode = (tCNode *)ce->getDestinationPtrNC();
-		dnode->addQpin(QpOut);
+			fs = cn->getNetPrecipitation();
+		ft = fabs(QpIn-QpOut0)*Cos;
+		fc = fabs(EvapSoi+EvapVeg);
+	}
+	// GW is zero
+	else if (NwtOld == 0.0 && NwtNew == 0.0) {
+		ft = (QpIn-QpOut0)*Cos;
+		fc = fabs(EvapSoi+EvapVeg);
+		if (ft-fc > 0.0)
+			fs = 0.0;
+		else
+			fs = fabs(ft+fc);
+		ft = fabs(ft);
+	}
+	// GW does not change
+	else if (fabs(NwtNew-NwtOld) < 1.0E-9) {
+		fs = RuNew;
+		ft = fabs(QpIn-QpOut0)*Cos;
+		fc = fabs(EvapSoi+EvapVeg);
+	}
 
-#ifdef PARALLEL_TRIBS
-  // Send Qpin from reach outlet node to
-  // reach head node, if on another processor
-  int idin = cn->getReach();
-  int idout = dnode->getReach();
-  if (idin != idout && tGraph::hasDownstream(idin)) {
-    tGraph::sendQpin(idin, dnode, QpOut);
-
-      // If runon option is set, send srf to node above
-      // outlet to head
-      if (RunOnoption)
-          tGraph::sendRunFlux(cn);
-  }
+	// Relative contribution to the basin-scale
+	AreaF = (cn->getVArea())/BasArea;
+	fs *= AreaF;
+	ft *= AreaF;
+	fc *= AreaF;
+
+	fSoi100 += fs;
+	fTop100 += ft;
+	fClm100 += fc;
+	dM100   += ((cn->getSoilMoistureSC()) - ThSurf0)*AreaF*Ths*100.;
+	dMRt    += ((cn->getRootMoistureSC()) - ThRoot0)*AreaF*Ths*1000.;
+	mTh100  += ((cn->getSoilMoistureSC()) + ThSurf0)/2.0*AreaF;
+	mThRt   += ((cn->getRootMoistureSC()) + ThRoot0)/2.0*AreaF;
+
+	/*
+		if (Pixel_State == Storm_Evol)
+	     cout << "\tCASE: *** Storm_Evol ***\n";
+     else if (Pixel_State == WTStaysAtSurf)
+	     cout << "\tCASE: *** WTStaysAtSurf ***\n";
+     else if (Pixel_State == WTDropsFromSurf)
+	     cout << "\tCASE: *** WTDropsFromSurf ***\n";
+     else if (Pixel_State == WTGetsToSurf)
+	     cout << "\tCASE: *** WTGetsToSurf ***\n";
+     else if (Pixel_State == Storm_Unsat_Evol)
+	     cout << "\tCASE: *** Storm_Unsat_Evol ***\n";
+     else if (Pixel_State == Perched_Evol)
+	     cout << "\tCASE: *** Perched_Evol ***\n";
+     else if (Pixel_State == Perched_SurfSat)
+	     cout << "\tCASE: *** Perched_SurfSat ***\n";
+     else if (Pixel_State == StormToInterTransition)
+	     cout << "\tCASE: *** StormToInterTransition ***\n";
+     else if (Pixel_State == ExactInitial)
+	     cout << "\tCASE: *** ExactInitial ***\n";
+     else if (Pixel_State == IntStormBelow)
+	     cout << "\tCASE: *** IntStormBelow ***\n";
+
+	 cout<<"\tQpIn = "<<QpIn<<"  QpOut0 = "<<QpOut0<<endl;
+	 cout<<"\tdm100 = "<<((cn->getSoilMoistureSC()) - ThSurf0)*Ths*100.
+	 <<"  fSoi100 = "<<fs
+	 <<"  fTop100 = "<<ft
+	 <<"  fClm100 = "<<fc
+	 <<"  NfOld = "<<NfOld<<"  NwtOld = "<<NwtOld<<"  NwtNew = "<<NwtNew
+	 <<endl<<flush;
+	 */
+
+	PrintNewVars( cn, Ractual );
+
+	R = R1 = -999.0;
+}
 
-#endif
+/*************************************************************************
+**
+**  tHydroModel::ActualRain(tCNode *, double &, double &)
+**
+**  Rainfall rate reaching the soil after interception and evaporation
+**  [mm hr^-1]; also returns the soil and canopy evaporation (no dew)
+**
+*************************************************************************/
+double tHydroModel::ActualRain(tCNode *cn, double &EvapSoi, double &EvapVeg)
+{
+	double Ractual = 0.0;
 
-		// The following units are [m^3]
-		Stok += srf*dt*cn->getVArea()/1000.0;
-        TotGWchange += (NwtNew-NwtOld)*Ths*cn->getVArea()/(Cos*1000.0);
-		TotMoist += (MuNew-MuOld)*cn->getVArea()/(Cos*1000.0);
+	EvapSoi = cn->getEvapSoil();
+	EvapVeg = cn->getEvapDryCanopy();
 
-		// Code related to soil moisture study by Valerio Noto
-		double AreaF, fs, ft, fc;
-        fs = ft = fc = 0;
+	// No DEW is allowed in soil
+	if (EvapSoi < 0.0)
+		EvapSoi = 0.0;
+	if (EvapVeg < 0.0)
+		EvapVeg = 0.0;
 
-		QpOut0 *= ((1.0E-6)/(cn->getVArea()));
+	if (Ioption == 0 && EToption == 0)
+		Ractual = cn->getRain();
 
-		// GW rise
-		if (NwtNew < NwtOld) {
-			fs = fabs(MuNew+Ths*(NwtOld-NwtNew)-MuOld)/dt-(QpIn-QpOut0)*Cos+(EvapSoi+EvapVeg);
-			ft = fabs(QpIn-QpOut0)*Cos;
-			fc = fabs(EvapSoi+EvapVeg);
-		}
-		// GW drop
-		else if (NwtNew > NwtOld) {
-			if (RuOld > 0)
-				fs = RuOld;
-			else
-				fs = cn->getNetPrecipitation();
-			ft = fabs(QpIn-QpOut0)*Cos;
-			fc = fabs(EvapSoi+EvapVeg);
-		}
-		// GW is zero
-		else if (NwtOld == 0.0 && NwtNew == 0.0) {
-			ft = (QpIn-QpOut0)*Cos;
-			fc = fabs(EvapSoi+EvapVeg);
-			if (ft-fc > 0.0)
-				fs = 0.0;
-			else
-				fs = fabs(ft+fc);
-			ft = fabs(ft);
-		}
-		// GW does not change
-		else if (fabs(NwtNew-NwtOld) < 1.0E-9) {
-			fs = RuNew;
-			ft = fabs(QpIn-QpOut0)*Cos;
-			fc = fabs(EvapSoi+EvapVeg);
-		}
+	else if (Ioption == 0 && EToption != 0)
+		Ractual = cn->getRain() - EvapSoi - EvapVeg;
 
-		// Relative contribution to the basin-scale
-		AreaF = (cn->getVArea())/BasArea;
-		fs *= AreaF;
-		ft *= AreaF;
-		fc *= AreaF;
+	else if (Ioption != 0 && EToption == 0) {
+		if (Ioption != 1) {
+			cout<<"\nError: Cannot Have Rutter Model (on) and ET (off)"<<endl;
+			Ractual = cn->getRain();}
+		else
+			Ractual = cn->getNetPrecipitation();
+	}
+	else if (Ioption != 0 && EToption != 0) {
+        Ractual = cn->getNetPrecipitation() - EvapSoi - EvapVeg;
+    }
+	return Ractual;
+}
 
-		fSoi100 += fs;
-		fTop100 += ft;
-		fClm100 += fc;
-		dM100   += ((cn->getSoilMoistureSC()) - ThSurf0)*AreaF*Ths*100.;
-		dMRt    += ((cn->getRootMoistureSC()) - ThRoot0)*AreaF*Ths*1000.;
-		mTh100  += ((cn->getSoilMoistureSC()) + ThSurf0)/2.0*AreaF;
-		mThRt   += ((cn->getRootMoistureSC()) + ThRoot0)/2.0*AreaF;
+/*************************************************************************
+**
+**  tHydroModel::AverageSoilMoisture(tCNode *, double, double)
+**
+**  Adds the relative surface and root zone soil moisture of the current
+**  step to their running averages, stored in AvSoilMoisture as the
+**  integer (surface) and decimal (root) part
+**
+*************************************************************************/
+void tHydroModel::AverageSoilMoisture(tCNode *cn, double surfSC, double rootSC)
+{
+	double AA, BB, Mdelt;
+
+	// Need to divide by the total # of time steps elapsed
+	AA = (double)timer->getElapsedSteps(timer->getCurrentTime());
+	// The integer part - surface SM
+	BB = floor(cn->getAvSoilMoisture())*1.0E-4;
+	// The decimal part - root SM
+	Mdelt = (cn->getAvSoilMoisture() - floor(cn->getAvSoilMoisture()))*1.0E+1;
+	cn->setAvSoilMoisture(0.0);
+	cn->setAvSoilMoisture(floor((BB*AA + surfSC)/(AA+1)*1.0E+4));
+	cn->addAvSoilMoisture((Mdelt*AA + rootSC)/(AA+1.0)*1.0E-1);
+}
 
-		/*
-			if (Pixel_State == Storm_Evol)
-  	     cout << "\tCASE: *** Storm_Evol ***\n";
-         else if (Pixel_State == WTStaysAtSurf)
-  	     cout << "\tCASE: *** WTStaysAtSurf ***\n";
-         else if (Pixel_State == WTDropsFromSurf)
-  	     cout << "\tCASE: *** WTDropsFromSurf ***\n";
-         else if (Pixel_State == WTGetsToSurf)
-  	     cout << "\tCASE: *** WTGetsToSurf ***\n";
-         else if (Pixel_State == Storm_Unsat_Evol)
-  	     cout << "\tCASE: *** Storm_Unsat_Evol ***\n";
-         else if (Pixel_State == Perched_Evol)
-  	     cout << "\tCASE: *** Perched_Evol ***\n";
-         else if (Pixel_State == Perched_SurfSat)
-  	     cout << "\tCASE: *** Perched_SurfSat ***\n";
-         else if (Pixel_State == StormToInterTransition)
-  	     cout << "\tCASE: *** StormToInterTransition ***\n";
-         else if (Pixel_State == ExactInitial)
-  	     cout << "\tCASE: *** ExactInitial ***\n";
-         else if (Pixel_State == IntStormBelow)
-  	     cout << "\tCASE: *** IntStormBelow ***\n";
-
-		 cout<<"\tQpIn = "<<QpIn<<"  QpOut0 = "<<QpOut0<<endl;
-		 cout<<"\tdm100 = "<<((cn->getSoilMoistureSC()) - ThSurf0)*Ths*100.
-		 <<"  fSoi100 = "<<fs
-		 <<"  fTop100 = "<<ft
-		 <<"  fClm100 = "<<fc
-		 <<"  NfOld = "<<NfOld<<"  NwtOld = "<<NwtOld<<"  NwtNew = "<<NwtNew
-		 <<endl<<flush;
-		 */
-
-		PrintNewVars( cn, Ractual );
-
-		R = R1 = -999.0;
-		id++;
+/*************************************************************************
+**
+**  tHydroModel::UnSaturatedStep(tHydroModel *w, int id, tCNode *cn, 
+**                               double dt)
+**
+**  Updates node 'cn' (number 'id' in the active node list) with the
+**  object 'w' (this object or a worker). With OPTQUIESCENT = K > 1, the
+**  update of a quiescent node (see QuiescentNode()) is deferred: its
+**  actual rain (evaporation, in dry periods) is accumulated and the
+**  node is updated once every K steps with the time step and the mean
+**  rain of the steps, or as soon as it has water input again. At the
+**  last step of the run all nodes are updated. The results of a run
+**  differ from those with every node updated at every step by the error
+**  of the longer time step; the state of a deferred node in the output
+**  lags by up to K-1 steps.
+**
+*************************************************************************/
+void tHydroModel::UnSaturatedStep(tHydroModel *w, int id, tCNode *cn, double dt)
+{
+	double EvapSoi, EvapVeg, Ractual;
 
-		cn = nodIter.NextP();
+	if (quietOption < 2) {
+		w->UnSaturatedNode(cn, dt);
+		return;
+	}
+
+	Ractual = w->ActualRain(cn, EvapSoi, EvapVeg);
+	if (quietSteps[id] < quietOption-1 && timer->RemainingTime() > 0.0 &&
+		w->QuiescentNode(cn, dt, quietRate[id])) {
+		quietSteps[id]++;
+		quietDepth[id] += Ractual*dt;
+		quietCount[id]++;
+		w->DeferNode(cn);
+		return;
+	}
 
-  } // End of long while node loop
+	w->quietTime = quietSteps[id]*dt;
+	w->quietRain = quietDepth[id];
+	w->UnSaturatedNode(cn, dt + w->quietTime);
 
+	// Storage change rate of the update [mm/hr]
+	quietRate[id] = (fabs(cn->getMuNew() - cn->getMuOld()) +
+		fabs(cn->getNwtNew() - cn->getNwtOld())*w->Ths)/(dt + w->quietTime);
+
+	quietSteps[id] = 0;
+	quietDepth[id] = 0.0;
+	w->quietTime = w->quietRain = 0.0;
+}
+
+/*************************************************************************
+**
+**  tHydroModel::QuiescentNode(tCNode *cn, double dt, double rate)
+**
+**  A node is quiescent if it has no rain, net precipitation, runon,
+**  snow melt or lateral inflow, no lateral outflow, a water table below
+**  the surface, an unsaturated surface and if its storage changed by
+**  less than QUIESCENTTOL at the last update ('rate', mm/hr). Returns 1
+**  if the node is quiescent, 0 otherwise.
+**
+*************************************************************************/
+int tHydroModel::QuiescentNode(tCNode *cn, double dt, double rate)
+{
+	if (rate > quietTol)
+		return 0;
+	if (cn->getRain() > 0.0 || (Ioption != 0 && cn->getNetPrecipitation() > 0.0))
+		return 0;
+	if (cn->getQpin() != 0.0 || cn->getQpout() != 0.0)
+		return 0;
+	if (cn->getNwtOld() <= 0.0 || cn->getSoilMoistureSC() > 0.999)
+		return 0;
+	if (SnOpt && (cn->getLiqWE() + cn->getIceWE() > 1e-3 ||
+				  cn->getLiqRouted() > 0.0))
+		return 0;
+	if (RunOnoption && GetCellRunon(cn, dt) > 0.0)
+		return 0;
+	return 1;
+}
+
+/*************************************************************************
+**
+**  tHydroModel::DeferNode(tCNode *cn)
+**
+**  Outputs of a deferred step of node 'cn': no runoff, recharge or 
+**  lateral flow (the runoff is set to zero by Reset()), the soil 
+**  moisture of the last update in the averages
+**
+*************************************************************************/
+void tHydroModel::DeferNode(tCNode *cn)
+{
+	double AreaF;
+
+	// Re-set runoff which is accumulated over 'EtIStep' time interval
+	if ( !(fmod((timer->getCurrentTime() - timer->getTimeStep()),
+				timer->getEtIStep())) )
+		cn->setSrf_Hr(0.0);
+	cn->setesrf(0.0);
+
+	cn->setRecharge(0.0);
+	cn->setUnSatFlowOut(0.0);
+	cn->setUnSatFlowIn(0.0);
+
+	AverageSoilMoisture(cn, cn->getSoilMoistureSC(), cn->getRootMoistureSC());
+
+	AreaF = (cn->getVArea())/BasArea;
+	mTh100 += (cn->getSoilMoistureSC())*AreaF;
+	mThRt  += (cn->getRootMoistureSC())*AreaF;
+}
+
+/*************************************************************************
+**
+**  tHydroModel::UseThreads()
+**
+**  The threaded node loops are used when more than one thread is available.
+**  Verbose output (written node by node) and the MPI version, which
+**  exchanges fluxes with other processors inside the loop, stay serial.
+**
+*************************************************************************/
+int tHydroModel::UseThreads()
+{
 #ifdef PARALLEL_TRIBS
-  // Send Qstrm, NwtOld, and NfOld to upstream reach outlet nodes
-  tGraph::sendOverlap();
-  // Receive as Qstrm, NwtOld, and NfOld from downstream reach head nodes
-  tGraph::receiveOverlap();
+	return 0;
+#else
+	return (tThreadPool::getNumThreads() > 1 && simCtrl->Verbose_label != 'Y');
 #endif
+}
 
-	if (simCtrl->Verbose_label == 'Y') {
-		// Output water balance information every 100 hours or at the end
-		AA = timer->getCurrentTime();
-		if (nodeList ||
-			(AA/100.-floor(AA/100.)) < (timer->getTimeStep()-timer->getTimeStep()/2.)/100. ||
-			timer->RemainingTime() == 0.0) {
+/*************************************************************************
+**
+**  tHydroModel::BuildNodeSchedule()
+**
+**  Orders the active nodes for the threaded unsaturated zone loop. In the
+**  serial loop a node uses two values of the nodes that drain into it: 
+**  their QpOut (added to its QpIn) and their runoff (for runon), both only
+**  updated if they come earlier in the node list. Nodes are placed on
+**  wavefront levels so that of any node and its flow receiver, the one 
+**  earlier in the list is on a lower level. Nodes of a level are then
+**  independent and can be processed concurrently while reproducing the
+**  serial results exactly. The edges of the groundwater flux computation
+**  are indexed by node for ComputeFluxesEdgesThreaded().
+**
+*************************************************************************/
+void tHydroModel::BuildNodeSchedule()
+{
+	tCNode *cn, *dn;
+	tEdge *ce;
+	int i, k, n, nLevels;
+
+	receiver.clear();
+	donorPtr.clear();
+	donorIdx.clear();
+	levelPtr.clear();
+	levelNodes.clear();
+	gwEdges.clear();
+	gwNodePtr.clear();
+	gwNodeEdge.clear();
+	gwLastOrg.clear();
+	nodeSums.clear();
+
+	// One worker (per-thread scratch state) for each thread
+	for (size_t t=0; t < workers.size(); t++)
+		delete workers[t];
+	workers.clear();
+	for (int t=0; t < tThreadPool::getNumThreads(); t++) {
+		tHydroModel *w = new tHydroModel(*this);
+		w->worker = 1;
+		w->workers.clear();
+		w->quietSteps.clear();
+		w->quietDepth.clear();
+		w->quietRate.clear();
+		w->quietCount.clear();
+		w->Stok = w->TotRain = w->TotGWchange = w->TotMoist = 0.0;
+		w->fSoi100 = w->fTop100 = w->fClm100 = 0.0;
+		w->dM100 = w->dMRt = w->mTh100 = w->mThRt = 0.0;
+		workers.push_back(w);
+	}
+
+	// Nodes are numbered by their position in the active node index
+	n = gridPtr->getNumActiveNodes();
+
+	// Flow receiver of each node, -1 if it is not an active node
+	receiver.assign(n, -1);
+	for (i=0; i < n; i++) {
+		dn = (tCNode *)gridPtr->getActiveFlowEdge(i)->getDestinationPtrNC();
+		receiver[i] = gridPtr->getActiveIndex(dn);
+	}
+
+	// Donors that precede their receiver, in list order
+	donorPtr.assign(n+1, 0);
+	for (i=0; i < n; i++)
+		if (receiver[i] > i)
+			donorPtr[receiver[i]+1]++;
+	for (i=0; i < n; i++)
+		donorPtr[i+1] += donorPtr[i];
+	donorIdx.assign(donorPtr[n], 0);
+	std::vector<int> fill(donorPtr.begin(), donorPtr.end()-1);
+	for (i=0; i < n; i++)
+		if (receiver[i] > i)
+			donorIdx[fill[receiver[i]]++] = i;
+
+	// Wavefront level: one above all flow neighbors earlier in the list
+	std::vector<int> level(n, 0);
+	nLevels = 0;
+	for (i=0; i < n; i++) {
+		if (receiver[i] >= 0 && receiver[i] < i)
+			level[i] = max(level[i], level[receiver[i]]+1);
+		for (k=donorPtr[i]; k < donorPtr[i+1]; k++)
+			level[i] = max(level[i], level[donorIdx[k]]+1);
+		nLevels = max(nLevels, level[i]+1);
+	}
+	levelPtr.assign(nLevels+1, 0);
+	for (i=0; i < n; i++)
+		levelPtr[level[i]+1]++;
+	for (k=0; k < nLevels; k++)
+		levelPtr[k+1] += levelPtr[k];
+	levelNodes.assign(n, 0);
+	fill.assign(levelPtr.begin(), levelPtr.end()-1);
+	for (i=0; i < n; i++)
+		levelNodes[fill[level[i]]++] = i;
+
+	// Groundwater: edges between active nodes and the edges of each node,
+	// stored as e if the node is the origin and ~e if the destination
+	std::vector<int> org, dst;
+	for (k=0; k < gridPtr->getNumActiveEdges(); k++) {
+		ce = gridPtr->getActiveEdge(k);
+		cn = (tCNode *)ce->getOriginPtrNC();
+		dn = (tCNode *)ce->getDestinationPtrNC();
+		if ( (cn->getBoundaryFlag() != kOpenBoundary) &&
+			 (dn->getBoundaryFlag() != kOpenBoundary) &&
+			 (cn->getBoundaryFlag() != kClosedBoundary) &&
+			 (dn->getBoundaryFlag() != kClosedBoundary) ) {
+			gwEdges.push_back(ce);
+			org.push_back(gridPtr->getActiveIndex(cn));
+			dst.push_back(gridPtr->getActiveIndex(dn));
+			assert(org.back() >= 0 && dst.back() >= 0);
+		}
+	}
+	gwNodePtr.assign(n+1, 0);
+	gwLastOrg.assign(n, -1);
+	for (k=0; k < (int)gwEdges.size(); k++) {
+		gwNodePtr[org[k]+1]++;
+		gwNodePtr[dst[k]+1]++;
+		gwLastOrg[org[k]] = k;
+	}
+	for (i=0; i < n; i++)
+		gwNodePtr[i+1] += gwNodePtr[i];
+	gwNodeEdge.assign(gwNodePtr[n], 0);
+	fill.assign(gwNodePtr.begin(), gwNodePtr.end()-1);
+	for (k=0; k < (int)gwEdges.size(); k++) {
+		gwNodeEdge[fill[org[k]]++] = k;
+		gwNodeEdge[fill[dst[k]]++] = ~k;
+	}
+	gwFound.assign(gwEdges.size(), 0);
+	gwFlux.assign(gwEdges.size(), 0.0);
+	gwTrans.assign(gwEdges.size(), 0.0);
+
+	nodeSums.assign(n*kNumNodeSums, 0.0);
+
+	Cout<<"tHydroModel: "<<n<<" nodes on "<<nLevels
+		<<" levels for "<<workers.size()<<" threads"<<endl;
+}
+
+/*************************************************************************
+**
+**  tHydroModel::TakeNodeSums(double *sums)
+**
+**  Moves the basin totals accumulated by a worker for one node to 'sums'
+**
+*************************************************************************/
+void tHydroModel::TakeNodeSums(double *sums)
+{
+	sums[0] = TotRain;      TotRain = 0.0;
+	sums[1] = Stok;         Stok = 0.0;
+	sums[2] = TotGWchange;  TotGWchange = 0.0;
+	sums[3] = TotMoist;     TotMoist = 0.0;
+	sums[4] = fSoi100;      fSoi100 = 0.0;
+	sums[5] = fTop100;      fTop100 = 0.0;
+	sums[6] = fClm100;      fClm100 = 0.0;
+	sums[7] = dM100;        dM100 = 0.0;
+	sums[8] = dMRt;         dMRt = 0.0;
+	sums[9] = mTh100;       mTh100 = 0.0;
+	sums[10] = mThRt;       mThRt = 0.0;
+}
 
-			cout<<"\t\tRUNOFF = "<<Stok<<" M^3"<<endl<<flush;
-			cout<<"\t\tTOTRAIN = "<<TotRain<<" M^3"<<endl<<flush;
-			cout<<"\t\tMOISTCHN = "<<TotMoist<<" M^3"<<endl<<flush;
-			cout<<"\t\tGWCHANGE = "<<TotGWchange<<" M^3"<<endl<<flush;
+/*************************************************************************
+**
+**  tHydroModel::CopyNodeState(const tHydroModel *src)
+**
+**  Copies the intermediate values of the current node (soil parameters,
+**  moisture state, fluxes and runoff components) from 'src'. Used to keep
+**  the values of this object and its workers as in the serial loops.
+**
+*************************************************************************/
+void tHydroModel::CopyNodeState(const tHydroModel *src)
+{
+	ID = src->ID;
+	NwtOld = src->NwtOld;  NwtNew = src->NwtNew;
+	MuOld = src->MuOld;    MuNew = src->MuNew;
+	MiOld = src->MiOld;    MiNew = src->MiNew;
+	NfOld = src->NfOld;    NfNew = src->NfNew;
+	NtOld = src->NtOld;    NtNew = src->NtNew;
+	RuOld = src->RuOld;    RuNew = src->RuNew;
+	RiOld = src->RiOld;    RiNew = src->RiNew;
+	QpIn = src->QpIn;      QpOut = src->QpOut;
+	QIn = src->QIn;        QOut = src->QOut;
+	R = src->R;            R1 = src->R1;
+	Rain = src->Rain;
+	alpha = src->alpha;    Cos = src->Cos;    Sin = src->Sin;
+	gwchange = src->gwchange;
+	srf = src->srf;        hsrf = src->hsrf;  esrf = src->esrf;
+	psrf = src->psrf;      satsrf = src->satsrf;
+	sbsrf = src->sbsrf;
+	G = src->G;            SeIn = src->SeIn;  Se0 = src->Se0;
+	ThRiNf = src->ThRiNf;  ThReNf = src->ThReNf;
+	Ksat = src->Ksat;      F = src->F;
+	Ths = src->Ths;        Thr = src->Thr;
+	Ar = src->Ar;          UAr = src->UAr;
+	PoreInd = src->PoreInd;
+	Eps = src->Eps;        Psib = src->Psib;
+	porosity = src->porosity;
+	DtoBedrock = src->DtoBedrock;
+}
+
+/*************************************************************************
+**
+**  tHydroModel::UnSaturatedZoneThreaded(double dt)
+**
+**  Threaded version of the unsaturated zone node loop. Each thread uses
+**  its own worker object for the intermediate values of a node. Levels 
+**  are processed in order (see BuildNodeSchedule()); before a node is 
+**  updated it collects the QpOut of its donors, which the serial loop 
+**  adds as it goes. The basin totals are stored per node and summed in 
+**  list order afterwards, so results do not depend on the thread count.
+**
+*************************************************************************/
+void tHydroModel::UnSaturatedZoneThreaded(double dt)
+{
+	int i, k, n;
+
+	if (levelPtr.empty() || (int)workers.size() != tThreadPool::getNumThreads())
+		BuildNodeSchedule();
+	n = gridPtr->getNumActiveNodes();
+
+	tThreadPool::tLoopBody body = [&](int first, int last, int t) {
+		tHydroModel *w = workers[t];
+		for (int j=first; j < last; j++) {
+			int id = levelNodes[j];
+			tCNode *node = gridPtr->getActiveNode(id);
+			for (int d=donorPtr[id]; d < donorPtr[id+1]; d++)
+				node->addQpin(gridPtr->getActiveNode(donorIdx[d])->getQpout());
+			UnSaturatedStep(w, id, node, dt);
+			w->TakeNodeSums(&nodeSums[id*kNumNodeSums]);
+			if (id == n-1)
+				CopyNodeState(w);
 		}
+	};
+
+	// Small levels (near the outlet) are not worth waking the threads
+	for (k=0; k < (int)levelPtr.size()-1; k++) {
+		if (levelPtr[k+1] - levelPtr[k] < kMinThreadedNodes)
+			body(levelPtr[k], levelPtr[k+1], 0);
+		else
+			tThreadPool::parallelFor(levelPtr[k], levelPtr[k+1], body);
 	}
 
-	// In order to properly take care of the actual generated runoff in the element
-	if (RunOnoption) {
-		cn = nodIter.FirstP();
-		while ( nodIter.IsActive() ) {
-			SetCellRunon( cn, cn->getSrf()/dt, cn->getRunOn()/dt, dt, 1 );
-			cn = nodIter.NextP();
+	// Basin totals in the order of the serial loop
+	for (i=0; i < n; i++) {
+		double *sums = &nodeSums[i*kNumNodeSums];
+		TotRain += sums[0];
+		Stok += sums[1];
+		TotGWchange += sums[2];
+		TotMoist += sums[3];
+		fSoi100 += sums[4];
+		fTop100 += sums[5];
+		fClm100 += sums[6];
+		dM100 += sums[7];
+		dMRt += sums[8];
+		mTh100 += sums[9];
+		mThRt += sums[10];
+	}
+
+	// QpOut of donors that follow their receiver or drain out of the basin
+	for (i=0; i < n; i++) {
+		if (receiver[i] < 0 || receiver[i] < i) {
+			tCNode *dn = (tCNode *)gridPtr->getActiveFlowEdge(i)->getDestinationPtrNC();
+			dn->addQpin(gridPtr->getActiveNode(i)->getQpout());
 		}
 	}
+
+	if (n > 0)
+		soilPtr->setSoilPtr( gridPtr->getActiveNode(n-1)->getSoilID() );
 }
 
 //=========================================================================
@@ -2442,6 +2979,15 @@ void tHydroModel::Reset()
 {
 	tCNode * cn;
 	tMeshListIter<tCNode> nodIter( gridPtr->getNodeList());
+
+	// Stored variables are reset array by array
+	if (nodeState) {
+		ResetNodeState(0);
+		for (tCNode *node : gridPtr->getActiveNodes())
+			node->setGwaterChng( 0.0 );
+		return;
+	}
+
 	cn = nodIter.FirstP();
 	while ( nodIter.IsActive() ) {
 		cn->setNwtOld(cn->getNwtNew());
@@ -2471,6 +3017,15 @@ void tHydroModel::ResetGW()
 {
 	tCNode * cn;
 	tMeshListIter<tCNode> nodIter( gridPtr->getNodeList());
+
+	// Stored variables are reset array by array
+	if (nodeState) {
+		ResetNodeState(1);
+		for (tCNode *node : gridPtr->getActiveNodes())
+			node->setGwaterChng( 0.0 );
+		return;
+	}
+
 	cn = nodIter.FirstP();
 	while ( nodIter.IsActive() ) {
 		cn->setNwtOld(cn->getNwtNew());
@@ -2487,6 +3042,35 @@ void tHydroModel::ResetGW()
 	}
 	}
 
+/*************************************************************************
+**
+**  tHydroModel::ResetNodeState(int gw)
+**
+**  Reset() (gw = 0) and ResetGW() (gw = 1) for the variables in the state
+**  store: the 'Old' state is set to the 'New' one and runoff components
+**  are zeroed for all active nodes at once.
+**
+*************************************************************************/
+void tHydroModel::ResetNodeState(int gw)
+{
+	int old[] = {kStNwtOld, kStMuOld, kStMiOld, kStNfOld, kStNtOld, kStRuOld, kStRiOld};
+	int cur[] = {kStNwtNew, kStMuNew, kStMiNew, kStNfNew, kStNtNew, kStRuNew, kStRiNew};
+
+	for (int k=0; k < 7; k++)
+		nodeState->copyField(old[k], cur[k]);
+
+	if (!gw) {
+		nodeState->fillField(kStQpin, 0.0);
+		nodeState->fillField(kStSrf, 0.0);
+		nodeState->fillField(kStSbsrf, 0.0);
+		nodeState->fillField(kStHsrf, 0.0);
+		nodeState->fillField(kStPsrf, 0.0);
+	}
+	else
+		nodeState->fillField(kStEsrf, 0.0);
+	nodeState->fillField(kStSatsrf, 0.0);
+}
+
 //=========================================================================
 //
 //
@@ -2667,10 +3251,12 @@ void tHydroModel::ComputeFluxesEdgesND()
 	tEdge  * ce;
 	tMeshListIter<tEdge>  edgIter( gridPtr->getEdgeList() );
 
-	double Cos1, Cos2;
-	double Width, Transmissivity, WTSlope;
-	double thisWTElevation, nextWTElevation; //Absolute elevation of WT, m abs.
-	double deficit; 			   //Average deficit between two edges.
+	double Transmissivity;
+
+	if (UseThreads()) {
+		ComputeFluxesEdgesThreaded();
+		return;
+	}
 
 	for ( ce=edgIter.FirstP(); edgIter.IsActive(); ce=edgIter.NextP() ) {
 		// Destination and Origin Nodes
@@ -2683,143 +3269,17 @@ void tHydroModel::ComputeFluxesEdgesND()
 			 &&  (cnorg->getBoundaryFlag() != kClosedBoundary) &&
 			 (cndest->getBoundaryFlag() != kClosedBoundary) ) {
 
-			alpha = atan( (cnorg->getFlowEdg())->getSlope() );    //Slope for subsurface fl.
-			Cos1 = cos(alpha);
-			alpha = atan( (cndest->getFlowEdg())->getSlope() );   //Slope for subsurface fl.
-			Cos2 = cos(alpha);
-
-            // Giuseppe 2016 - Begin changes to allow reading soil properties from grids
-			//            soilPtr->setSoilPtr( cnorg->getSoilID() );
-            //            Psib = soilPtr->getSoilProp(5);
-            Psib = cnorg->getAirEBubPres(); // Air entry bubbling pressure
-			// Giuseppe 2016 - End changes to allow reading soil properties from grids
-
-			// Depending on whether the water table is at the surface or not,
-			// define the gradient of the GW head
-			if (cnorg->getNwtOld() == 0.0) {
-                thisWTElevation = (cnorg->getZ()) - ((-Psib) / (Cos1 * 1000.0));
-            }
-			else {
-                thisWTElevation = (cnorg->getZ()) - (cnorg->getNwtOld() / (Cos1 * 1000.0));
-            }
-
-			// Giuseppe 2016 - Begin changes to allow reading soil properties from grids
-            //            soilPtr->setSoilPtr( cndest->getSoilID() );
-            //            Psib = soilPtr->getSoilProp(5);
-            Psib = cndest->getAirEBubPres(); // Air entry bubbling pressure
-			// Giuseppe 2016 - End changes to allow reading soil properties from grids
-
-			if (cndest->getNwtOld() == 0.0) {
-                nextWTElevation = (cndest->getZ()) - ((-Psib) / (Cos2 * 1000.0));
-            }
-			else {
-                nextWTElevation = (cndest->getZ()) - (cndest->getNwtOld() / (Cos2 * 1000.0));
-            }
-
-			// Compute only positive fluxes
-         DtoBedrock = cnorg->getBedrockDepth(); //SMM - 09232008
-			if (thisWTElevation > nextWTElevation &&
-				cnorg->getNwtOld() <= DtoBedrock &&
-				cndest->getNwtOld() <= DtoBedrock) {
-
-				// Giuseppe 2016 - Begin changes to allow reading soil properties from grids
-                //soilPtr->setSoilPtr( cnorg->getSoilID() );
-                // Get soil hydraulic properties
-                //                Ksat    = soilPtr->getSoilProp(1);  // Surface hydraulic conductivity
-                //                Ths     = soilPtr->getSoilProp(2);  // Saturation moisture content
-                //                Thr     = soilPtr->getSoilProp(3);  // Residual moisture content
-                //                PoreInd = soilPtr->getSoilProp(4);  // Pore-size distribution index
-                //                Psib    = soilPtr->getSoilProp(5);  // Air entry bubbling pressure
-                //                F       = soilPtr->getSoilProp(6);  // Decay parameter in the exp
-                //                Ar      = soilPtr->getSoilProp(7);  // Anisotropy ratio (saturated)
-                //                UAr     = soilPtr->getSoilProp(8);  // Anisotropy ratio (unsaturated)
-                //                porosity = soilPtr->getSoilProp(9); // Porosity
-                Ksat = cnorg->getKs();  // Surface hydraulic conductivity
-                Ths = cnorg->getThetaS(); // Saturation moisture content
-                Thr = cnorg->getThetaR(); // Residual moisture content
-                PoreInd = cnorg->getPoreSize(); // Pore-size distribution index
-                Psib = cnorg->getAirEBubPres(); // Air entry bubbling pressure
-                F = cnorg->getDecayF(); // Decay parameter in the exp
-                Ar = cnorg->getSatAnRatio(); // Anisotropy ratio (saturated)
-                UAr = cnorg->getUnsatAnRatio(); // Anisotropy ratio (unsaturated)
-                porosity = cnorg->getPorosity(); // Porosity
-				// Giuseppe 2016 - End changes to allow reading soil properties from grids
-                Eps = 3 + 2/PoreInd;
-
-				DtoBedrock = cnorg->getBedrockDepth();  //Local variable
-
-				deficit  = cnorg->getNwtOld();
-				deficit += cndest->getNwtOld();
-				deficit  = deficit/2;           // Average Water Table depth
-
-				WTSlope = (thisWTElevation - nextWTElevation)/ce->getLength();
-
-				// Transmissivity (depth averaged quantity) (MM^2/HOUR)
-				Transmissivity = getTransmissivityFinD( cnorg->getNwtOld() );
-
-				// Width in the direction of flow (MM)
-				Width = ce->getVEdgLen()*1000.0;
-
-				// Constrain the GW gradient
-				if (WTSlope > 1.0) {
-                    WTSlope = 1.0;
-                }
-
-                // Unconfined aquifer HGL (MM^3/HOUR)
-				QOut = Transmissivity * Width * WTSlope;
-
-				// Compute Voronoi polygon shape factor and constrain the model dynamics
-				if (Width) {
-					deficit = cndest->getVArea()/(Width*Width*10.0E-6);
-					if (deficit <= 0.1)
-						QOut *= deficit;
-				}
-
-				if (cnorg->getID() == -1 || cndest->getID() == -1) {
-					if (simCtrl->Verbose_label == 'Y') {
-						cout<<"ORIGIN Node ID = "<<cnorg->getID()<<"  ("<<cnorg->getX()<<","
-						<<cnorg->getY()<<")"<<endl<<flush;
-						cout<<"DESTIN Node ID = "<<cndest->getID()<<"  ("<<cndest->getX()<<","
-							<<cndest->getY()<<")"<<endl<<flush;
-						cout<<"\tthisWTElevation = "<<thisWTElevation
-							<<" m\tnextWTElevation = "<<nextWTElevation<<" m"<<endl<<flush;
-						cout<<"\tFluxin Origin BEFORE: "<<cnorg->getGwaterChng()*1.0E-9
-							<<" m^3/hr"<<endl<<flush;
-						cout<<"\tFluxin Destin BEFORE: "<<cndest->getGwaterChng()*1.0E-9
-							<<" m^3/hr"<<endl<<flush;
-						cout<<"\tWidth = "<<Width<<" mm\tWTSlope = "<<WTSlope<<"\tTransmissivity = "
-							<<Transmissivity*1.0E-6<<" m^2/hr\tQOut = "
-							<<QOut*1.0E-9<<" m^3/hr"<<endl<<flush;
-					}
-				}
-
-            // No need to add unless not 0.0 SMM - 09232008
-            if (QOut > 0.0 || QOut < 0.0) {
+			// No need to add unless not 0.0 SMM - 09232008
+			if (ComputeEdgeFlux(ce, Transmissivity) && (QOut > 0.0 || QOut < 0.0)) {
 
-				    // Record outgoing flux from origin
-				    cnorg->addGwaterChng(QOut);
+				// Record outgoing flux from origin
+				cnorg->addGwaterChng(QOut);
 
-				    // Record incoming flux to destination
-				    cndest->addGwaterChng(-QOut);
-
-            }
-
-				cnorg->setTransmiss(Transmissivity);
+				// Record incoming flux to destination
+				cndest->addGwaterChng(-QOut);
 			}
-			else {
-				// Giuseppe 2016 - Begin changes to allow reading soil properties from grids
-                //                soilPtr->setSoilPtr( cnorg->getSoilID() );
-                //                Ksat    = soilPtr->getSoilProp(1);
-                //                F       = soilPtr->getSoilProp(6);
-                //                Ar      = soilPtr->getSoilProp(7);
-                Ksat = cnorg->getKs();  // Surface hydraulic conductivity
-                F = cnorg->getDecayF(); // Decay parameter in the exp
-                Ar = cnorg->getSatAnRatio(); // Anisotropy ratio (saturated)
-				// Giuseppe 2016 - End changes to allow reading soil properties from grids
 
-				Transmissivity = Ar * Ksat * exp(-F*cnorg->getNwtOld())/F;
-				cnorg->setTransmiss(Transmissivity);
-			}
+			cnorg->setTransmiss(Transmissivity);
 		}
 
 		/*
@@ -2938,6 +3398,223 @@ void tHydroModel::ComputeFluxesEdgesND()
 
 	}
 
+/***************************************************************************
+**
+**  tHydroModel::ComputeEdgeFlux(tEdge *ce, double &Transmissivity)
+**
+**  Saturated lateral flux along edge 'ce' used by ComputeFluxesEdgesND().
+**  Returns 1 if the water table slopes down towards the destination (the
+**  flux is left in QOut) and 0 otherwise. The nodes are not modified, so
+**  different edges can be handled concurrently by different (worker)
+**  objects.
+**
+***************************************************************************/
+int tHydroModel::ComputeEdgeFlux(tEdge *ce, double &Transmissivity)
+{
+	tCNode * cnorg  = (tCNode *)ce->getOriginPtrNC();
+	tCNode * cndest = (tCNode *)ce->getDestinationPtrNC();
+
+	double Cos1, Cos2;
+	double Width, WTSlope;
+	double thisWTElevation, nextWTElevation; //Absolute elevation of WT, m abs.
+	double deficit; 			   //Average deficit between two edges.
+
+	alpha = atan( (cnorg->getFlowEdg())->getSlope() );    //Slope for subsurface fl.
+	Cos1 = cos(alpha);
+	alpha = atan( (cndest->getFlowEdg())->getSlope() );   //Slope for subsurface fl.
+	Cos2 = cos(alpha);
+
+    // Giuseppe 2016 - Begin changes to allow reading soil properties from grids
+	//            soilPtr->setSoilPtr( cnorg->getSoilID() );
+    //            Psib = soilPtr->getSoilProp(5);
+    Psib = cnorg->getAirEBubPres(); // Air entry bubbling pressure
+	// Giuseppe 2016 - End changes to allow reading soil properties from grids
+
+	// Depending on whether the water table is at the surface or not,
+	// define the gradient of the GW head
+	if (cnorg->getNwtOld() == 0.0) {
+        thisWTElevation = (cnorg->getZ()) - ((-Psib) / (Cos1 * 1000.0));
+    }
+	else {
+        thisWTElevation = (cnorg->getZ()) - (cnorg->getNwtOld() / (Cos1 * 1000.0));
+    }
+
+	// Giuseppe 2016 - Begin changes to allow reading soil properties from grids
+    //            soilPtr->setSoilPtr( cndest->getSoilID() );
+    //            Psib = soilPtr->getSoilProp(5);
+    Psib = cndest->getAirEBubPres(); // Air entry bubbling pressure
+	// Giuseppe 2016 - End changes to allow reading soil properties from grids
+
+	if (cndest->getNwtOld() == 0.0) {
+        nextWTElevation = (cndest->getZ()) - ((-Psib) / (Cos2 * 1000.0));
+    }
+	else {
+        nextWTElevation = (cndest->getZ()) - (cndest->getNwtOld() / (Cos2 * 1000.0));
+    }
+
+	// Compute only positive fluxes
+	DtoBedrock = cnorg->getBedrockDepth(); //SMM - 09232008
+	if (thisWTElevation > nextWTElevation &&
+		cnorg->getNwtOld() <= DtoBedrock &&
+		cndest->getNwtOld() <= DtoBedrock) {
+
+		// Giuseppe 2016 - Begin changes to allow reading soil properties from grids
+        //soilPtr->setSoilPtr( cnorg->getSoilID() );
+        // Get soil hydraulic properties
+        //                Ksat    = soilPtr->getSoilProp(1);  // Surface hydraulic conductivity
+        //                Ths     = soilPtr->getSoilProp(2);  // Saturation moisture content
+        //                Thr     = soilPtr->getSoilProp(3);  // Residual moisture content
+        //                PoreInd = soilPtr->getSoilProp(4);  // Pore-size distribution index
+        //                Psib    = soilPtr->getSoilProp(5);  // Air entry bubbling pressure
+        //                F       = soilPtr->getSoilProp(6);  // Decay parameter in the exp
+        //                Ar      = soilPtr->getSoilProp(7);  // Anisotropy ratio (saturated)
+        //                UAr     = soilPtr->getSoilProp(8);  // Anisotropy ratio (unsaturated)
+        //                porosity = soilPtr->getSoilProp(9); // Porosity
+        Ksat = cnorg->getKs();  // Surface hydraulic conductivity
+        Ths = cnorg->getThetaS(); // Saturation moisture content
+        Thr = cnorg->getThetaR(); // Residual moisture content
+        PoreInd = cnorg->getPoreSize(); // Pore-size distribution index
+        Psib = cnorg->getAirEBubPres(); // Air entry bubbling pressure
+        F = cnorg->getDecayF(); // Decay parameter in the exp
+        Ar = cnorg->getSatAnRatio(); // Anisotropy ratio (saturated)
+        UAr = cnorg->getUnsatAnRatio(); // Anisotropy ratio (unsaturated)
+        porosity = cnorg->getPorosity(); // Porosity
+		// Giuseppe 2016 - End changes to allow reading soil properties from grids
+        Eps = 3 + 2/PoreInd;
+
+		DtoBedrock = cnorg->getBedrockDepth();  //Local variable
+
+		deficit  = cnorg->getNwtOld();
+		deficit += cndest->getNwtOld();
+		deficit  = deficit/2;           // Average Water Table depth
+
+		WTSlope = (thisWTElevation - nextWTElevation)/ce->getLength();
+
+		// Transmissivity (depth averaged quantity) (MM^2/HOUR)
+		Transmissivity = getTransmissivityFinD( cnorg->getNwtOld() );
+
+		// Width in the direction of flow (MM)
+		Width = ce->getVEdgLen()*1000.0;
+
+		// Constrain the GW gradient
+		if (WTSlope > 1.0) {
+            WTSlope = 1.0;
+        }
+
+        // Unconfined aquifer HGL (MM^3/HOUR)
+		QOut = Transmissivity * Width * WTSlope;
+
+		// Compute Voronoi polygon shape factor and constrain the model dynamics
+		if (Width) {
+			deficit = cndest->getVArea()/(Width*Width*10.0E-6);
+			if (deficit <= 0.1)
+				QOut *= deficit;
+		}
+
+		if (cnorg->getID() == -1 || cndest->getID() == -1) {
+			if (simCtrl->Verbose_label == 'Y') {
+				cout<<"ORIGIN Node ID = "<<cnorg->getID()<<"  ("<<cnorg->getX()<<","
+				<<cnorg->getY()<<")"<<endl<<flush;
+				cout<<"DESTIN Node ID = "<<cndest->getID()<<"  ("<<cndest->getX()<<","
+					<<cndest->getY()<<")"<<endl<<flush;
+				cout<<"\tthisWTElevation = "<<thisWTElevation
+					<<" m\tnextWTElevation = "<<nextWTElevation<<" m"<<endl<<flush;
+				cout<<"\tFluxin Origin BEFORE: "<<cnorg->getGwaterChng()*1.0E-9
+					<<" m^3/hr"<<endl<<flush;
+				cout<<"\tFluxin Destin BEFORE: "<<cndest->getGwaterChng()*1.0E-9
+					<<" m^3/hr"<<endl<<flush;
+				cout<<"\tWidth = "<<Width<<" mm\tWTSlope = "<<WTSlope<<"\tTransmissivity = "
+					<<Transmissivity*1.0E-6<<" m^2/hr\tQOut = "
+					<<QOut*1.0E-9<<" m^3/hr"<<endl<<flush;
+			}
+		}
+
+		return 1;
+	}
+	else {
+		// Giuseppe 2016 - Begin changes to allow reading soil properties from grids
+        //                soilPtr->setSoilPtr( cnorg->getSoilID() );
+        //                Ksat    = soilPtr->getSoilProp(1);
+        //                F       = soilPtr->getSoilProp(6);
+        //                Ar      = soilPtr->getSoilProp(7);
+        Ksat = cnorg->getKs();  // Surface hydraulic conductivity
+        F = cnorg->getDecayF(); // Decay parameter in the exp
+        Ar = cnorg->getSatAnRatio(); // Anisotropy ratio (saturated)
+		// Giuseppe 2016 - End changes to allow reading soil properties from grids
+
+		Transmissivity = Ar * Ksat * exp(-F*cnorg->getNwtOld())/F;
+		return 0;
+	}
+}
+
+/***************************************************************************
+**
+**  tHydroModel::ComputeFluxesEdgesThreaded()
+**
+**  Threaded version of ComputeFluxesEdgesND(). The flux of every edge is
+**  computed on the workers and stored by edge, then each node gathers the
+**  fluxes of its own edges. As in tCNode::getGwaterChng(), the flux 
+**  contributions of a node are summed in ascending order, and the 
+**  transmissivity of a node is the one of its last edge in the list, so
+**  the result does not depend on the number of threads.
+**
+***************************************************************************/
+void tHydroModel::ComputeFluxesEdgesThreaded()
+{
+	int e, nEdges;
+	double Transmissivity;
+
+	if (levelPtr.empty() || (int)workers.size() != tThreadPool::getNumThreads())
+		BuildNodeSchedule();
+	nEdges = (int)gwEdges.size();
+
+	// Edge fluxes
+	tThreadPool::parallelFor(0, nEdges, [&](int first, int last, int t) {
+		tHydroModel *w = workers[t];
+		for (int j=first; j < last; j++) {
+			gwFound[j] = w->ComputeEdgeFlux(gwEdges[j], gwTrans[j]);
+			gwFlux[j] = (gwFound[j] ? w->QOut : 0.0);
+		}
+	});
+
+	// Node totals
+	tThreadPool::parallelFor(0, gridPtr->getNumActiveNodes(), [&](int first, int last, int) {
+		std::vector<double> flux;
+		for (int i=first; i < last; i++) {
+			tCNode *node = gridPtr->getActiveNode(i);
+			double gw;
+
+			flux.clear();
+			for (int k=gwNodePtr[i]; k < gwNodePtr[i+1]; k++) {
+				int j = gwNodeEdge[k];
+				int org = (j >= 0);
+				if (!org)
+					j = ~j;
+				// No need to add unless not 0.0 SMM - 09232008
+				if (gwFound[j] && (gwFlux[j] > 0.0 || gwFlux[j] < 0.0))
+					flux.push_back(org ? gwFlux[j] : -gwFlux[j]);
+			}
+			std::sort(flux.begin(), flux.end());
+			gw = node->getGwaterChng();
+			for (size_t k=0; k < flux.size(); k++)
+				gw += flux[k];
+			node->setGwaterChng(gw);
+
+			if (gwLastOrg[i] >= 0)
+				node->setTransmiss(gwTrans[gwLastOrg[i]]);
+		}
+	});
+
+	// Leave the intermediate values of this object as the serial loop does:
+	// those of the last edge with a flux, then those of the last edge
+	for (e=nEdges-1; e >= 0 && !gwFound[e]; e--)
+		;
+	if (e >= 0 && e < nEdges-1)
+		ComputeEdgeFlux(gwEdges[e], Transmissivity);
+	if (nEdges > 0)
+		ComputeEdgeFlux(gwEdges[nEdges-1], Transmissivity);
+}
+
 //=========================================================================
 //
 //
@@ -2980,597 +3657,700 @@ void tHydroModel::SetupNodeSZ(tCNode *cn)
 	// Giuseppe 2016 - End changes to allow reading soil properties from grids
 	Eps = 3 + 2/PoreInd;
 
-	// Get dynamic variables
-	NwtOld = NwtNew= cn->getNwtOld();
-	MuOld  = MuNew = cn->getMuOld();
-	MiOld  = MiNew = cn->getMiOld();
-	NtOld  = NtNew = cn->getNtOld();
-	NfOld  = NfNew = cn->getNfOld();
-	RuOld  = RuNew = cn->getRuOld();
-	RiOld  = RiNew = cn->getRiOld();
-}
+	// Get dynamic variables
+	NwtOld = NwtNew= cn->getNwtOld();
+	MuOld  = MuNew = cn->getMuOld();
+	MiOld  = MiNew = cn->getMiOld();
+	NtOld  = NtNew = cn->getNtOld();
+	NfOld  = NfNew = cn->getNfOld();
+	RuOld  = RuNew = cn->getRuOld();
+	RiOld  = RiNew = cn->getRiOld();
+}
+
+/*************************************************************************
+**
+**  tHydroModel::MaxStateChange()
+**
+**  Largest change of the water table, wetting front or moisture content
+**  above the water table [mm] of the active nodes in the last update of
+**  the unsaturated zone. Used to adapt the groundwater time step.
+**
+*************************************************************************/
+double tHydroModel::MaxStateChange()
+{
+	double dmax = 0.0;
+
+	for (tCNode *node : gridPtr->getActiveNodes()) {
+		dmax = max(dmax, fabs(node->getNwtNew() - node->getNwtOld()));
+		dmax = max(dmax, fabs(node->getNfNew() - node->getNfOld()));
+		dmax = max(dmax, fabs(node->getMuNew() - node->getMuOld()));
+	}
+	return dmax;
+}
+
+/*************************************************************************
+**
+**  tHydroModel::SaturatedZone(double dtGW)
+**
+*************************************************************************/
+void tHydroModel::SaturatedZone(double dtGW)
+{
+
+#ifdef PARALLEL_TRIBS
+  // Exchange Nwt (send localFlux NwtNew)
+  tGraph::sendNwt();
+  tGraph::receiveNwt();
+#endif
+
+	// Calculate the fluxes between cells
+	ComputeFluxesEdgesND();
+
+#ifdef PARALLEL_TRIBS
+  // Exchange groundwater (send remoteFlux getGwaterChng)
+  tGraph::sendGroundWater();
+  tGraph::receiveGroundWater();
+#endif
+
+	// Calculate changes in water table level
+	tCNode * cn;
+	tMeshListIter<tCNode> nodIter( gridPtr->getNodeList() );
+
+	int cnt = 0;
+	int k;
+	int threaded = UseThreads();
+	double fsum;
+	double sums[kNumNodeSums];
+	double *nsums;
+
+	double gwdm = 0.0;
+	double mth100 = 0.0;
+	double mthrt = 0.0;
+	double AreaGW = 0.0;
+	int gwcnt = 0;
+	int id = 0;
+
+	if (threaded)
+		SaturatedZoneThreaded(dtGW);
+
+	for ( cn=nodIter.FirstP(); nodIter.IsActive(); cn=nodIter.NextP() ) {
+
+		// Update the node or take the results of the threaded loop
+		if (threaded)
+			nsums = &nodeSums[id*kNumNodeSums];
+		else {
+			for (k=0; k < kNumNodeSums; k++)
+				sums[k] = 0.0;
+			SaturatedNode(cn, dtGW, sums);
+			nsums = sums;
+		}
+
+		// Basin totals and relative factors, see SaturatedNode()
+		Stok        += nsums[0];
+		TotMoist    += nsums[1];
+		TotGWchange += nsums[2];
+		fGW100      += nsums[3];
+		gwdm        += nsums[4];
+		AreaGW      += nsums[5];
+		gwcnt       += (int)nsums[6];
+		dMRt        += nsums[7];
+		mth100      += nsums[8];
+		mthrt       += nsums[9];
+
+		id++;
+
+		// if (cn->getNwtOld() > DtoBedrock) cnt++;
+	}
+	// cout<<"In total "<<cnt<<" cells have WT > BEDROCK\n"<<endl;
+
+	if (gwcnt > 0) {
+		fGW100 /= AreaGW;
+		gwdm   /= AreaGW;
+	}
+
+	dM100   += gwdm;
+	mTh100  /= (dtGW/(timer->getTimeStep()));
+	mThRt   /= (dtGW/(timer->getTimeStep()));
+	mTh100   = (mTh100+mth100)/2.0;
+	mThRt    = (mThRt+mthrt)/2.0;
+	fSoi100 /= (dtGW/(timer->getTimeStep()));
+	fTop100 /= (dtGW/(timer->getTimeStep()));
+	fClm100 /= (dtGW/(timer->getTimeStep()));
+
+	// Could also be:
+	//      /= (gridPtr->getNodeList()->getActiveSize());
+
+	fsum = (fabs(fSoi100)+fabs(fTop100)+fabs(fClm100)+fabs(fGW100));
+	if (!fsum) fsum = 1.0E-6;
+
+	//fctout<<setprecision(10)<<timer->getCurrentTime()<<"  "
+	//    <<dM100<<"  "<<dMRt<<"  "
+	//	  <<mTh100<<"  "<<mThRt<<"  "
+	//	  <<fsum<<"  "
+	//	  <<fSoi100/fsum<<"  "<<fTop100/fsum<<"  "
+	//	  <<fClm100/fsum<<"  "<<fGW100/fsum<<endl;
+
+	fSoi100=fTop100=fClm100=fGW100=dM100=dMRt=mTh100=mThRt=0.0;
+
+#ifndef PARALLEL_TRIBS
+    if (simCtrl->Verbose_label == 'Y') { //WR 08292023 change conditions from nodelist to Verbose
+		cout<<"\t\tRUNOFF = "<<Stok<<" M^3"<<endl<<flush;
+		cout<<"\t\tMOISTCHN = "<<TotMoist<<" M^3"<<endl<<flush;
+		cout<<"\t\tGWCHANGE = "<<TotGWchange<<" M^3"<<endl<<flush;
+	}
+#endif
+
+	} // End of SaturatedZone Routine...
 
 /*************************************************************************
 **
-**  tHydroModel::SaturatedZone(double dtGW)
+**  tHydroModel::SaturatedNode(tCNode *cn, double dtGW, double *sums)
+**
+**  Saturated zone update of node 'cn' from its groundwater flux. The
+**  contributions of the node to the basin totals are added to 'sums': 
+**  runoff, moisture and GW storage change (M^3), fGW100, dm100 and area
+**  of the nodes with a surface moisture change, their number, dMRt and
+**  mean surface and root moisture. Like UnSaturatedNode(), the data 
+**  members hold the intermediate values of the node.
 **
 *************************************************************************/
-void tHydroModel::SaturatedZone(double dtGW)
+void tHydroModel::SaturatedNode(tCNode *cn, double dtGW, double *sums)
 {
-
-#ifdef PARALLEL_TRIBS
-  // Exchange Nwt (send localFlux NwtNew)
-  tGraph::sendNwt();
-  tGraph::receiveNwt();
-#endif
-
-	// Calculate the fluxes between cells
-	ComputeFluxesEdgesND();
-
-#ifdef PARALLEL_TRIBS
-  // Exchange groundwater (send remoteFlux getGwaterChng)
-  tGraph::sendGroundWater();
-  tGraph::receiveGroundWater();
-#endif
-
-	// Calculate changes in water table level
-	tCNode * cn;
-	tMeshListIter<tCNode> nodIter( gridPtr->getNodeList() );
-
-	int cnt = 0;
 	int Couple_State;
 	double Area, Nstar;
 	double Mdelt, dM1, dM2, dM3, ThSurf, AA, BB;
-	double ThSurf0, ThRoot0, fsum, AreaF;
-
-	double gwdm = 0.0;
-	double mth100 = 0.0;
-	double mthrt = 0.0;
-	double AreaGW = 0.0;
-	int gwcnt = 0;
-	int id = 0;
-
-	for ( cn=nodIter.FirstP(); nodIter.IsActive(); cn=nodIter.NextP() ) {
-
-		// Setup the node
-		SetupNodeSZ( cn );
+	double ThSurf0, ThRoot0, AreaF;
 
-		// Initialize runoff
-		srf = satsrf = 0.0;
+	// Setup the node
+	SetupNodeSZ( cn );
 
-		// Get geometry
-		alpha = atan(cn->getFlowEdg()->getSlope());
-		(alpha > 0.0 ? Cos = fabs(cos(alpha)) : Cos = 1.0);
+	// Initialize runoff
+	srf = satsrf = 0.0;
 
-		Area = cn->getVArea();   // M^2;
-		
-		// Get Bedrock depth for computing Nwt
-		DtoBedrock = cn->getBedrockDepth(); // added by CJC2020
+	// Get geometry
+	alpha = atan(cn->getFlowEdg()->getSlope());
+	(alpha > 0.0 ? Cos = fabs(cos(alpha)) : Cos = 1.0);
 
-		// Calculate approximate water table depth (Cos to get actual area)
-		NwtNew = NwtOld + dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/(Area*Ths);
-		if (NwtNew < 0.0) {
-			satsrf = fabs(NwtNew*Ths)/dtGW;
-			NwtNew=0.0;
-		}
+	Area = cn->getVArea();   // M^2;
+	
+	// Get Bedrock depth for computing Nwt
+	DtoBedrock = cn->getBedrockDepth(); // added by CJC2020
+
+	// Calculate approximate water table depth (Cos to get actual area)
+	NwtNew = NwtOld + dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/(Area*Ths);
+	if (NwtNew < 0.0) {
+		satsrf = fabs(NwtNew*Ths)/dtGW;
+		NwtNew=0.0;
+	}
 
-		// Potential States
-		enum {GW_Exfiltrate, GW_IntStorm_Like, GW_Initial, GW_Positive_Bal};
-		Couple_State = -1000;
+	// Potential States
+	enum {GW_Exfiltrate, GW_IntStorm_Like, GW_Initial, GW_Positive_Bal};
+	Couple_State = -1000;
 
-		if (NwtNew == NwtOld) {
+	if (NwtNew == NwtOld) {
             Couple_State=GW_Initial;
         }
-		else if (NwtNew-NwtOld > 1.0E-3) {
+	else if (NwtNew-NwtOld > 1.0E-3) {
             Couple_State=GW_IntStorm_Like;
         }
-		else if (NwtOld-NwtNew > 1.0E-3) {
+	else if (NwtOld-NwtNew > 1.0E-3) {
             Couple_State=GW_Positive_Bal;
         }
-		if (MuOld > NwtNew*Ths) {
+	if (MuOld > NwtNew*Ths) {
             Couple_State=GW_Exfiltrate;
         }
-		if (Couple_State==-1000) {
+	if (Couple_State==-1000) {
             Couple_State=GW_Initial;
         }
-		
-		// State Switch Statements
-		//---------------------------------------------
+	
+	// State Switch Statements
+	//---------------------------------------------
 
 
-		switch (Couple_State) {
-			//----------------
-			case GW_Exfiltrate:
-				satsrf += (MuOld - NwtNew*Ths)/dtGW;
-				NwtNew=0;
-				MuNew=MiNew=0.0;
-				RiNew=RuNew=0.0;
-				NfNew=NtNew=0.0;
-				break;
+	switch (Couple_State) {
+		//----------------
+		case GW_Exfiltrate:
+			satsrf += (MuOld - NwtNew*Ths)/dtGW;
+			NwtNew=0;
+			MuNew=MiNew=0.0;
+			RiNew=RuNew=0.0;
+			NfNew=NtNew=0.0;
+			break;
 
 
-				//----------------
-			case GW_Initial:
-				NwtNew=NwtOld;
-				MuNew=MuOld;
-				MiNew=MiOld;
-				NfNew=NfOld;
-				NtNew=NtOld;
-				RuNew=RuOld;
-				RiNew=RiOld;
-				break;
+			//----------------
+		case GW_Initial:
+			NwtNew=NwtOld;
+			MuNew=MuOld;
+			MiNew=MiOld;
+			NfNew=NfOld;
+			NtNew=NtOld;
+			RuNew=RuOld;
+			RiNew=RiOld;
+			break;
 
 
-				//----------------
-			case GW_IntStorm_Like:
+			//----------------
+		case GW_IntStorm_Like:
 
-				// Redefine Nwt according to the new moisture deficit in the element
-				// The amount of water that is extracted
-				Mdelt = (NwtNew - NwtOld)*Ths;
+			// Redefine Nwt according to the new moisture deficit in the element
+			// The amount of water that is extracted
+			Mdelt = (NwtNew - NwtOld)*Ths;
 
-				if (NwtOld > 0.0)
-					NwtNew = Newton((Ths*NwtOld - (MiOld-Mdelt)), NwtNew);
-				else
-					NwtNew = Newton((Ths*NwtOld - (MiOld-Mdelt)), 0.0);
+			if (NwtOld > 0.0)
+				NwtNew = Newton((Ths*NwtOld - (MiOld-Mdelt)), NwtNew);
+			else
+				NwtNew = Newton((Ths*NwtOld - (MiOld-Mdelt)), 0.0);
 
-				MiNew = get_Total_Moist(NwtNew);
-				RiNew = 0.0;
+			MiNew = get_Total_Moist(NwtNew);
+			RiNew = 0.0;
 
-				// Initialized state at the beginning
-				if ((NfOld == 0.0) || (NfOld == NwtOld)) {
-					RuNew = 0.0;
-					MuNew = MiNew;
-					if (NfOld == 0.0)
-						NfNew=NtNew=0.0;
-					else
-						NfNew=NtNew=NwtNew;
-				}
-					// There was a wetted wedge of moisture
+			// Initialized state at the beginning
+			if ((NfOld == 0.0) || (NfOld == NwtOld)) {
+				RuNew = 0.0;
+				MuNew = MiNew;
+				if (NfOld == 0.0)
+					NfNew=NtNew=0.0;
+				else
+					NfNew=NtNew=NwtNew;
+			}
+				// There was a wetted wedge of moisture
+				else {
+					dM1 = get_Upper_Moist(NfOld, NwtNew);
+					dM2 = MuOld - MiOld;
+					Mdelt = dM1 + dM2;
+					dM3 = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfOld/Eps)) + Thr*NfOld;
+					MuNew = MiNew + dM2;
+
+					// It is an unsaturated wedge
+					if (Mdelt < dM3) {
+						NtNew = NfNew = NfOld;
+						// Wetting front in the same position
+						// but the wedge has become "thinner"
+						RuNew = get_RechargeRate(Mdelt, NfOld);
+					}
+					// Perched Saturated wedge or Surface Perched case
 					else {
-						dM1 = get_Upper_Moist(NfOld, NwtNew);
-						dM2 = MuOld - MiOld;
-						Mdelt = dM1 + dM2;
-						dM3 = Eps/F*(Ths-Thr)*(1.0 - exp(-F*NfOld/Eps)) + Thr*NfOld;
-						MuNew = MiNew + dM2;
-
-						// It is an unsaturated wedge
-						if (Mdelt < dM3) {
-							NtNew = NfNew = NfOld;
-							// Wetting front in the same position
-							// but the wedge has become "thinner"
-							RuNew = get_RechargeRate(Mdelt, NfOld);
-						}
-						// Perched Saturated wedge or Surface Perched case
-						else {
-							// Mdelt is the amount of water we
-							// need to subtract from the wedge
-							Mdelt = get_Upper_Moist(NfOld, NwtOld);
-							Mdelt -= dM1;
-
-							// Perched Saturated wedge
-							if ((NtOld > 0.0) && (NtOld < NfOld)) {
-								// Note: it makes more sense to substract moisture
-								// from below the wetting front rather from the top:
-								// effect on surface runoff should be smaller
-								NfNew = Newton(Mdelt, NwtNew, NfOld, 0);
-
-								if (NfNew <= NtOld) {
-									if ((NtOld-NfNew) >= 10.0) {
-										cout<<"GW_Intstorm_Like: Warning: ";
-										cout<<"Difference higher then the thresh.!!"<<endl;
-									}
-									else
-										NfNew = NtOld+0.001;
+						// Mdelt is the amount of water we
+						// need to subtract from the wedge
+						Mdelt = get_Upper_Moist(NfOld, NwtOld);
+						Mdelt -= dM1;
+
+						// Perched Saturated wedge
+						if ((NtOld > 0.0) && (NtOld < NfOld)) {
+							// Note: it makes more sense to substract moisture
+							// from below the wetting front rather from the top:
+							// effect on surface runoff should be smaller
+							NfNew = Newton(Mdelt, NwtNew, NfOld, 0);
+
+							if (NfNew <= NtOld) {
+								if ((NtOld-NfNew) >= 10.0) {
+									cout<<"GW_Intstorm_Like: Warning: ";
+									cout<<"Difference higher then the thresh.!!"<<endl;
 								}
-								NtNew = NtOld;
-								RuNew = RuOld;
-							}
-							// Surface Perched case
-							else if (NtOld == 0.0 && NfOld > 0.0) {
-								NfNew = Newton(Mdelt, NwtNew, NfOld, 0);
-								NtNew = NtOld;
-								RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-							}
-							if (NtNew > NfOld) {
-								cout<<"\nWarning: Incorrect case definition:";
-								cout<<" NtNew > NfOld: id = "<<cn->getID()<<"\n";
+								else
+									NfNew = NtOld+0.001;
 							}
+							NtNew = NtOld;
+							RuNew = RuOld;
+						}
+						// Surface Perched case
+						else if (NtOld == 0.0 && NfOld > 0.0) {
+							NfNew = Newton(Mdelt, NwtNew, NfOld, 0);
+							NtNew = NtOld;
+							RuNew = Ksat*F*NfNew/expm1(F*NfNew);
+						}
+						if (NtNew > NfOld) {
+							cout<<"\nWarning: Incorrect case definition:";
+							cout<<" NtNew > NfOld: id = "<<cn->getID()<<"\n";
 						}
 					}
-					break;
+				}
+				break;
 
 
-				//----------------
-			case GW_Positive_Bal:
+			//----------------
+		case GW_Positive_Bal:
 
-				// Water table has not reached the wetting front yet
-				if (((NwtNew+Psib) > NfOld) || (NfOld == NwtOld)) {
+			// Water table has not reached the wetting front yet
+			if (((NwtNew+Psib) > NfOld) || (NfOld == NwtOld)) {
 
-					MiNew = get_Total_Moist(NwtNew);
-					dM1 = get_Lower_Moist(NwtNew, NwtOld);
-					dM2 = MiOld - dM1;
-					// Moisture imbalance: we must account for it
-					Mdelt = dM1 - (MiNew-dM2);
-
-					if (Mdelt < 0.0) {
-						cout<<"\n\t\tGround Water Model: Warning! Mdelt < 0\n";
-						cout<<"\t\tNwtOld = "<<NwtOld<<"  NwtNew = "<<NwtNew<<endl;
-						cout<<"\t\tMiOld = " <<MiOld<<"  MiNew = " <<MiNew<<endl;
-						cout<<"\t\tMdelt = " <<Mdelt<<endl;
-						cout<<"\t\tid = "<<cn->getID()<<"\n";
-					}
+				MiNew = get_Total_Moist(NwtNew);
+				dM1 = get_Lower_Moist(NwtNew, NwtOld);
+				dM2 = MiOld - dM1;
+				// Moisture imbalance: we must account for it
+				Mdelt = dM1 - (MiNew-dM2);
+
+				if (Mdelt < 0.0) {
+					cout<<"\n\t\tGround Water Model: Warning! Mdelt < 0\n";
+					cout<<"\t\tNwtOld = "<<NwtOld<<"  NwtNew = "<<NwtNew<<endl;
+					cout<<"\t\tMiOld = " <<MiOld<<"  MiNew = " <<MiNew<<endl;
+					cout<<"\t\tMdelt = " <<Mdelt<<endl;
+					cout<<"\t\tid = "<<cn->getID()<<"\n";
+				}
 
-					// Redefine Nwt
-					NwtNew = Newton((Ths*NwtNew - (MiNew+Mdelt)), NwtNew);
-					MiNew = get_Total_Moist(NwtNew);
+				// Redefine Nwt
+				NwtNew = Newton((Ths*NwtNew - (MiNew+Mdelt)), NwtNew);
+				MiNew = get_Total_Moist(NwtNew);
 
-					// The element has been in an initialized state
-					if ((NfOld == 0.0) || (NfOld == NwtOld)) {
-						MuNew = MiNew;
-						RuNew = RiNew = 0.0;
+				// The element has been in an initialized state
+				if ((NfOld == 0.0) || (NfOld == NwtOld)) {
+					MuNew = MiNew;
+					RuNew = RiNew = 0.0;
 
-						if (NfOld == NwtOld)
-							NfNew = NtNew = NwtNew;
-						else
-							NfNew = NtNew = 0.0;
-					}
+					if (NfOld == NwtOld)
+						NfNew = NtNew = NwtNew;
+					else
+						NfNew = NtNew = 0.0;
+				}
 
-					else if ((NfOld > 0.0) && (NfOld != NwtOld)) {
+				else if ((NfOld > 0.0) && (NfOld != NwtOld)) {
 
-						// After relocation of the water table, it could reach the
-						// wetting front. If Nwt has not reached:
-						if ((NwtNew+Psib) > NfOld) {
-							Mdelt = get_Upper_Moist(NfOld, NwtNew);
-							Mdelt += (MuOld - MiOld); //Amount of SM above Nf
+					// After relocation of the water table, it could reach the
+					// wetting front. If Nwt has not reached:
+					if ((NwtNew+Psib) > NfOld) {
+						Mdelt = get_Upper_Moist(NfOld, NwtNew);
+						Mdelt += (MuOld - MiOld); //Amount of SM above Nf
 
-							// Element was in the unsaturated state
-							if (NtOld == NfOld) {
+						// Element was in the unsaturated state
+						if (NtOld == NfOld) {
 
-								// The re-adjusted moisture profile lead to perching
-								// of moisture in the top layer: adjust everything else
-								if (Mdelt >= NfOld*Ths) {
-									// Total influx from the saturated zone
-									Mdelt = -dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/Area;
-									NwtNew = Newton((Ths*NwtOld - (MuOld+Mdelt)), (NtOld-Psib));
-									MuNew = MiNew = get_Total_Moist(NwtNew);
-									RiNew = RuNew = 0.0;
-									NfNew=NtNew=NwtNew;
+							// The re-adjusted moisture profile lead to perching
+							// of moisture in the top layer: adjust everything else
+							if (Mdelt >= NfOld*Ths) {
+								// Total influx from the saturated zone
+								Mdelt = -dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/Area;
+								NwtNew = Newton((Ths*NwtOld - (MuOld+Mdelt)), (NtOld-Psib));
+								MuNew = MiNew = get_Total_Moist(NwtNew);
+								RiNew = RuNew = 0.0;
+								NfNew=NtNew=NwtNew;
+							}
+							else {
+								RuNew = get_RechargeRate(Mdelt, NfOld);
+								Nstar = (log(Ksat/RuNew))/F;
+								// If the wedge becomes perched
+								if (Nstar <= NfOld) {
+									NtNew = Nstar;
+									NfNew = NfOld+1.0E-5;
 								}
+								// It is still unsaturated
 								else {
-									RuNew = get_RechargeRate(Mdelt, NfOld);
-									Nstar = (log(Ksat/RuNew))/F;
-									// If the wedge becomes perched
-									if (Nstar <= NfOld) {
-										NtNew = Nstar;
-										NfNew = NfOld+1.0E-5;
-									}
-									// It is still unsaturated
-									else {
-										NfNew = NtNew = NfOld;
-									}
-									MuNew = MiNew + (MuOld - MiOld);
-									RiNew = 0.0;
+									NfNew = NtNew = NfOld;
 								}
+								MuNew = MiNew + (MuOld - MiOld);
+								RiNew = 0.0;
 							}
+						}
 
-							// Element was in perched or surface saturated state
-							else if (NtOld < NfOld) {
+						// Element was in perched or surface saturated state
+						else if (NtOld < NfOld) {
 
-								if (Mdelt >= NfOld*Ths) {
-									Mdelt -= NfOld*Ths;
-									dM3 = NwtOld;
-									NwtOld = NwtNew;
+							if (Mdelt >= NfOld*Ths) {
+								Mdelt -= NfOld*Ths;
+								dM3 = NwtOld;
+								NwtOld = NwtNew;
 
-									// Redistribute imbalance
-									dM1 = Ths*(NwtNew+Psib-NfNew);
-									//dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew);
-									// SKY2008Snow from AJR2007
-									dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew,0);
+								// Redistribute imbalance
+								dM1 = Ths*(NwtNew+Psib-NfNew);
+								//dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew);
+								// SKY2008Snow from AJR2007
+								dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew,0);
 
-									if ((dM1-dM2-Mdelt) > 1.0E-6)
-										NfNew = Newton(Mdelt, NwtNew, NfOld, 1);
-									else
-										NfNew = NwtNew+Psib+1.0E-6;
-									NtNew = NtOld;
-								}
-								else {
-									dM1 = get_Upper_Moist(NfOld, NwtNew);
-									dM2 = get_Upper_Moist(NfOld, NwtOld);
-									Mdelt = dM1 - dM2;
-									if (Mdelt < 0.0)
-										cout<<"\nWarning: GW Model: Mdelt< 0:id = "<<cn->getID()<<"\n";
-									dM3 = NwtOld;
-									NwtOld = NwtNew;
-									// Redistribute imbalance
-									dM1 = Ths*(NwtNew+Psib-NfNew);
-									//dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew);
-									// SKY2008Snow from AJR2007
-									dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew,0);
-
-									if ((dM1-dM2-Mdelt) > 1.0E-6)
-										NfNew = Newton(Mdelt, NwtNew, NfOld, 1);
-									else
-										NfNew = NwtNew+Psib+1.0E-6;
-									NtNew = NtOld;
-								}
+								if ((dM1-dM2-Mdelt) > 1.0E-6)
+									NfNew = Newton(Mdelt, NwtNew, NfOld, 1);
+								else
+									NfNew = NwtNew+Psib+1.0E-6;
+								NtNew = NtOld;
+							}
+							else {
+								dM1 = get_Upper_Moist(NfOld, NwtNew);
+								dM2 = get_Upper_Moist(NfOld, NwtOld);
+								Mdelt = dM1 - dM2;
+								if (Mdelt < 0.0)
+									cout<<"\nWarning: GW Model: Mdelt< 0:id = "<<cn->getID()<<"\n";
+								dM3 = NwtOld;
+								NwtOld = NwtNew;
+								// Redistribute imbalance
+								dM1 = Ths*(NwtNew+Psib-NfNew);
+								//dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew);
+								// SKY2008Snow from AJR2007
+								dM2 = get_Z1Z2_Moist(NfNew, NwtNew+Psib, NwtNew,0);
+
+								if ((dM1-dM2-Mdelt) > 1.0E-6)
+									NfNew = Newton(Mdelt, NwtNew, NfOld, 1);
+								else
+									NfNew = NwtNew+Psib+1.0E-6;
+								NtNew = NtOld;
+							}
 
-								// There is groundwater - unsaturated zone interaction
-								if (NfNew >= (NwtNew+Psib)) {
-									if (NtOld > 0.0) {
-										Mdelt = -dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/Area;
-										NwtOld = dM3;
-										NwtNew = Newton((Ths*NwtOld - (MuOld+Mdelt)),(NtOld-Psib));
-										MuNew = MiNew = get_Total_Moist(NwtNew);
-										RiNew = RuNew = 0.0;
-										NfNew=NtNew=NwtNew;
-									}
-									else if (NtNew == 0.0) {
-										NwtNew = NfNew = NtNew = 0.0;
-										MuNew = MiNew = 0.0;
-										RiNew = RuNew = 0.0;
-									}
+							// There is groundwater - unsaturated zone interaction
+							if (NfNew >= (NwtNew+Psib)) {
+								if (NtOld > 0.0) {
+									Mdelt = -dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/Area;
+									NwtOld = dM3;
+									NwtNew = Newton((Ths*NwtOld - (MuOld+Mdelt)),(NtOld-Psib));
+									MuNew = MiNew = get_Total_Moist(NwtNew);
+									RiNew = RuNew = 0.0;
+									NfNew=NtNew=NwtNew;
 								}
-								// Wetting front has not reached water table yet
-								else {
-									MuNew = MiNew + (MuOld - MiOld);
-									RiNew = 0.0;
-									if (NtNew == 0.0)
-										RuNew = Ksat*F*NfNew/expm1(F*NfNew);
-									else
-										RuNew = RuOld;
+								else if (NtNew == 0.0) {
+									NwtNew = NfNew = NtNew = 0.0;
+									MuNew = MiNew = 0.0;
+									RiNew = RuNew = 0.0;
 								}
 							}
-						}
-
-						// Defined Nwt has reached NfOld
-						else {
-							Mdelt = -dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/Area;
-							NwtNew = Newton((Ths*NwtOld - (MuOld+Mdelt)), NwtOld);
-							MuNew = MiNew = get_Total_Moist(NwtNew);
-							RiNew=RuNew=0.0;
-							NfNew=NtNew=NwtNew;
+							// Wetting front has not reached water table yet
+							else {
+								MuNew = MiNew + (MuOld - MiOld);
+								RiNew = 0.0;
+								if (NtNew == 0.0)
+									RuNew = Ksat*F*NfNew/expm1(F*NfNew);
+								else
+									RuNew = RuOld;
+							}
 						}
 					}
-				} // Matches (NwtNew+Psib) > NfOld || (NfOld == NwtOld)
 
-
-				// New water table has risen and reached NfOld
-				else if ( ((NwtNew+Psib) <= NfOld) && (NfOld != NwtOld) ) {
-					MiNew = get_Total_Moist(NwtNew);
-					dM1 = get_Lower_Moist(NwtNew, NwtOld);
-					dM2 = MiOld - dM1;
-					Mdelt = dM1 - (MiNew-dM2); //Moisture imbalance
-
-					if (Mdelt < 0) {
-						cout<<"\n\t\tGround Water Model: Warning! Mdelt < 0\n";
-						cout<<"\t\tNwtOld = "<<NwtOld<<"  NwtNew = "<<NwtNew<<endl;
-						cout<<"\t\tMiOld = " <<MiOld<<"  MiNew = " <<MiNew<<endl;
-						cout<<"\t\tMdelt = " <<Mdelt<<endl;
-						cout<<"\t\tid = "<<cn->getID()<<"\n";
+					// Defined Nwt has reached NfOld
+					else {
+						Mdelt = -dtGW*(cn->getGwaterChng()*1.0E-6)*Cos/Area;
+						NwtNew = Newton((Ths*NwtOld - (MuOld+Mdelt)), NwtOld);
+						MuNew = MiNew = get_Total_Moist(NwtNew);
+						RiNew=RuNew=0.0;
+						NfNew=NtNew=NwtNew;
 					}
+				}
+			} // Matches (NwtNew+Psib) > NfOld || (NfOld == NwtOld)
 
-					// This only works for (dM1 > (MiNew-dM2))
-					if (NtOld == NfOld)
-						NwtNew = Newton((Ths*NwtOld - (MuOld+Ths*(NwtOld-NwtNew))), NwtNew);
-					else if (NtOld < NfOld)
-						NwtNew = Newton((Ths*NwtOld - (MuOld+Ths*(NwtOld-NwtNew))), (NtOld-Psib));
 
-					MuNew = MiNew = get_Total_Moist(NwtNew);
-					RuNew = RiNew = 0.0;
-					NtNew = NwtNew;
-					NfNew = NwtNew;
+			// New water table has risen and reached NfOld
+			else if ( ((NwtNew+Psib) <= NfOld) && (NfOld != NwtOld) ) {
+				MiNew = get_Total_Moist(NwtNew);
+				dM1 = get_Lower_Moist(NwtNew, NwtOld);
+				dM2 = MiOld - dM1;
+				Mdelt = dM1 - (MiNew-dM2); //Moisture imbalance
+
+				if (Mdelt < 0) {
+					cout<<"\n\t\tGround Water Model: Warning! Mdelt < 0\n";
+					cout<<"\t\tNwtOld = "<<NwtOld<<"  NwtNew = "<<NwtNew<<endl;
+					cout<<"\t\tMiOld = " <<MiOld<<"  MiNew = " <<MiNew<<endl;
+					cout<<"\t\tMdelt = " <<Mdelt<<endl;
+					cout<<"\t\tid = "<<cn->getID()<<"\n";
 				}
-				break;
-            default:
-                cerr<<"No case identified in tHydroModel::SaturatedZone"<<endl;
-                break;
-
-		}   //End of Switch Statements
 
+				// This only works for (dM1 > (MiNew-dM2))
+				if (NtOld == NfOld)
+					NwtNew = Newton((Ths*NwtOld - (MuOld+Ths*(NwtOld-NwtNew))), NwtNew);
+				else if (NtOld < NfOld)
+					NwtNew = Newton((Ths*NwtOld - (MuOld+Ths*(NwtOld-NwtNew))), (NtOld-Psib));
 
-		// Print out Statements
-		if (simCtrl->Verbose_label == 'Y') {
-			if (NtNew<0.0 || NtOld<0.0) {
-				cout <<"\nWarning: Top Front < 0\n\n";
-				cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
-				cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout <<"NtNew = "<<NtNew<<"\nid = "<<cn->getID();
-				cout <<"\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
+				MuNew = MiNew = get_Total_Moist(NwtNew);
+				RuNew = RiNew = 0.0;
+				NtNew = NwtNew;
+				NfNew = NwtNew;
 			}
+			break;
+            default:
+                cerr<<"No case identified in tHydroModel::SaturatedZone"<<endl;
+                break;
 
-			if (NfNew<0.0 || NfOld<0.0) {
-				cout << "\nWarning: Wetting Front < 0\n\n\n";
-				cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
-				cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout <<"NfNew = "<<NfNew<<"\nid = "<<cn->getID();
-				cout <<"\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
-			}
+	}   //End of Switch Statements
 
-			if (NtNew>NwtNew)  {
-				cout << "\nWarning: Top Front > WT depth\n\n";
-				cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
-				cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout <<"NtNew = "<<NtNew<<", NwtNew = "<<NwtNew<<"\nid = "<<cn->getID();
-				cout <<"\tQIn = "<<QIn<<"  QOut ="<<QOut<<endl;
-			}
 
-			if (NfNew>NwtNew)  {
-				cout << "\nWarning: Top Front > WT depth\n\n";
-				cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
-				cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout <<"NfNew = "<<NfNew<<", NwtNew = "<<NwtNew<<"\nid = "<<cn->getID();
-				cout << "\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
-			}
+	// Print out Statements
+	if (simCtrl->Verbose_label == 'Y') {
+		if (NtNew<0.0 || NtOld<0.0) {
+			cout <<"\nWarning: Top Front < 0\n\n";
+			cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
+			cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout <<"NtNew = "<<NtNew<<"\nid = "<<cn->getID();
+			cout <<"\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
+		}
 
-			if (NtNew>NfNew) {
-				cout << "\nWarning: Top Front > Wet front\n\n";
-				cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
-				cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout <<"NtNew = "<<NtNew<<", NfNew = "<<NfNew<<"\nid = "<<cn->getID();
-				cout<<"\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
-			}
+		if (NfNew<0.0 || NfOld<0.0) {
+			cout << "\nWarning: Wetting Front < 0\n\n\n";
+			cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
+			cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout <<"NfNew = "<<NfNew<<"\nid = "<<cn->getID();
+			cout <<"\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
+		}
 
-			if (NwtNew<0.0 || NwtOld<0.0) {
-				cout << "\nWarning: Water table < 0\n\n";
-				cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
-				cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
-				cout << "NwtNew = " << NwtNew <<"\nid = "<<cn->getID();
-				cout << "\tQIn = " << QIn << "  QOut = " << QOut << endl;
-			}
+		if (NtNew>NwtNew)  {
+			cout << "\nWarning: Top Front > WT depth\n\n";
+			cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
+			cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout <<"NtNew = "<<NtNew<<", NwtNew = "<<NwtNew<<"\nid = "<<cn->getID();
+			cout <<"\tQIn = "<<QIn<<"  QOut ="<<QOut<<endl;
+		}
 
-			if (satsrf<0.0) {
-				cout <<"\nWarning: RUNOFF component (satsrf) < 0: id = ";
-				cout <<cn->getID()<<"\n\n";
-			}
+		if (NfNew>NwtNew)  {
+			cout << "\nWarning: Top Front > WT depth\n\n";
+			cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
+			cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout <<"NfNew = "<<NfNew<<", NwtNew = "<<NwtNew<<"\nid = "<<cn->getID();
+			cout << "\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
+		}
 
-			if (satsrf>999999.0) {
-				cout<<"\nWarning: RUNOFF comp.- satsrf  "
-				<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
-				satsrf = 0.0;
-			}
+		if (NtNew>NfNew) {
+			cout << "\nWarning: Top Front > Wet front\n\n";
+			cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
+			cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout <<"NtNew = "<<NtNew<<", NfNew = "<<NfNew<<"\nid = "<<cn->getID();
+			cout<<"\tQIn = "<<QIn<<"  QOut = "<<QOut<<endl;
+		}
 
-			if (MuNew<MiNew) {
-				cout <<"\nWarning: Total moisture content (MuNew) < MiNew: id = ";
-				cout <<cn->getID()<<"\n\n";
-			}
+		if (NwtNew<0.0 || NwtOld<0.0) {
+			cout << "\nWarning: Water table < 0\n\n";
+			cout <<"NwtOld: "<<NwtOld<<", MiOld: "<<MiOld<<", MuOld: "<<MuOld;
+			cout <<", NtOld= "<<NtOld<<", NfOld= "<<NfOld<<endl;
+			cout << "NwtNew = " << NwtNew <<"\nid = "<<cn->getID();
+			cout << "\tQIn = " << QIn << "  QOut = " << QOut << endl;
 		}
 
-		// GW contribution to surface runoff
-		esrf = psrf+satsrf;
-		esrf = esrf/Cos;
-		satsrf /= Cos;
-		srf = satsrf;
+		if (satsrf<0.0) {
+			cout <<"\nWarning: RUNOFF component (satsrf) < 0: id = ";
+			cout <<cn->getID()<<"\n\n";
+		}
 
-		// Print the variables of interest
-		PrintNewGWVars( cn, Couple_State );
+		if (satsrf>999999.0) {
+			cout<<"\nWarning: RUNOFF comp.- satsrf  "
+			<<"> 999999: id = "<<cn->getID()<<"\n\t\t-> Assigned to zero\n\n";
+			satsrf = 0.0;
+		}
 
-		// Update Variables
-		ThSurf0 = cn->getSoilMoistureSC();
-		ThRoot0 = cn->getRootMoistureSC();
+		if (MuNew<MiNew) {
+			cout <<"\nWarning: Total moisture content (MuNew) < MiNew: id = ";
+			cout <<cn->getID()<<"\n\n";
+		}
+	}
 
-		cn->setNwtNew(NwtNew);
-		cn->setMuNew(MuNew);
-		cn->setMiNew(MiNew);
-		cn->setNfNew(NfNew);
-		cn->setNtNew(NtNew);
-		cn->setRuNew(RuNew);
-		cn->setRiNew(RiNew);
-
-		cn->addSrf_Hr(srf*dtGW);// WR debug 02062024, this is not in hours?
-		cn->setsrf(cn->getSrf()+srf*dtGW); // this is a total depth in mm#
-		cn->addCumSrf(cn->getSrf()); // Added line compared to old tRIBS version, not documented CJC 2022 //WRdebug 02062024: Above line was called, then called again in addCumSrf doubling the
-		cn->setsatsrf(satsrf*dtGW);
-		cn->setesrf(esrf*dtGW);
-
-		if (satsrf>0.0) {
+	// GW contribution to surface runoff
+	esrf = psrf+satsrf;
+	esrf = esrf/Cos;
+	satsrf /= Cos;
+	srf = satsrf;
+
+	// Print the variables of interest
+	PrintNewGWVars( cn, Couple_State );
+
+	// Update Variables
+	ThSurf0 = cn->getSoilMoistureSC();
+	ThRoot0 = cn->getRootMoistureSC();
+
+	cn->setNwtNew(NwtNew);
+	cn->setMuNew(MuNew);
+	cn->setMiNew(MiNew);
+	cn->setNfNew(NfNew);
+	cn->setNtNew(NtNew);
+	cn->setRuNew(RuNew);
+	cn->setRiNew(RiNew);
+
+	cn->addSrf_Hr(srf*dtGW);// WR debug 02062024, this is not in hours?
+	cn->setsrf(cn->getSrf()+srf*dtGW); // this is a total depth in mm#
+	cn->addCumSrf(cn->getSrf()); // Added line compared to old tRIBS version, not documented CJC 2022 //WRdebug 02062024: Above line was called, then called again in addCumSrf doubling the
+	cn->setsatsrf(satsrf*dtGW);
+	cn->setesrf(esrf*dtGW);
+
+	if (satsrf>0.0) {
             cn->satsrfOccur = cn->satsrfOccur + floor(satsrf * 1.0E+3) + 1.0E-6;
         }
 
-		if (ComputeSurfSoilMoist(1.0)/Ths > 0.999) {
+	if (ComputeSurfSoilMoist(1.0)/Ths > 0.999) {
             cn->satOccur = cn->satOccur + 1;
         }
 
-		cn->RechDisch=cn->RechDisch+((NwtOld-NwtNew)+satsrf*dtGW*Cos/Ths)*1.0E-3;
+	cn->RechDisch=cn->RechDisch+((NwtOld-NwtNew)+satsrf*dtGW*Cos/Ths)*1.0E-3;
 
-		// Soil moisture in the top 10 cm
-		ThSurf = ComputeSurfSoilMoist(surfaceSoilDepth);
-		cn->setSoilMoisture( ThSurf );
-		cn->setSoilMoistureSC( ThSurf/Ths );
+	// Soil moisture in the top 10 cm
+	ThSurf = ComputeSurfSoilMoist(surfaceSoilDepth);
+	cn->setSoilMoisture( ThSurf );
+	cn->setSoilMoistureSC( ThSurf/Ths );
 
-		// Soil moisture in the unsaturated zone
-		if (NwtNew) {
+	// Soil moisture in the unsaturated zone
+	if (NwtNew) {
             cn->setSoilMoistureUNSC(MuNew / NwtNew / Ths);
         }
-		else {
+	else {
             cn->setSoilMoistureUNSC(1.0);
         }
 
-		// Need to divide by the total # of time steps elapsed
-		AA = (double)timer->getElapsedSteps(timer->getCurrentTime());
-		// The integer part --surface SM--
-		BB = floor(cn->getAvSoilMoisture())*1.0E-4;
-		// The decimal part --root SM--
-		Mdelt = (cn->getAvSoilMoisture() - floor(cn->getAvSoilMoisture()))*1.0E+1;
-		cn->setAvSoilMoisture(0.0);
-		cn->setAvSoilMoisture(floor((BB*AA + ThSurf/Ths)/(AA+1)*1.0E+4));
-
-		// Estimate average root soil moisture
-		ThSurf = ComputeSurfSoilMoist(rootZoneDepth);
-		cn->setRootMoisture( ThSurf );
-		cn->setRootMoistureSC( ThSurf/Ths );
-		cn->addAvSoilMoisture((Mdelt*AA + ThSurf/Ths)/(AA+1.0)*1.0E-1);
-
-		cn->setRecharge((NwtNew-NwtOld)*Ths/(Cos*dtGW));
-		// The following are in [M^3]
-		Stok += srf*dtGW*cn->getVArea()/1000.0;
-		TotMoist += (MuNew - MuOld)*cn->getVArea()/(Cos*1000.0);
-        TotGWchange += (NwtNew-NwtOld)*Ths*cn->getVArea()/(Cos*1000.0);
-
-		// Estimate and output relative factors
-		if (fabs((cn->getSoilMoistureSC()) - ThSurf0) > 1.0E-6) {
-			AA = 1.0;
-			fGW100 += fabs(dtGW*(cn->getGwaterChng()*1.0E-6)/Area)*AA*Area;
-			gwdm   += ((cn->getSoilMoistureSC()) - ThSurf0)*Ths*100.0*Area;
-			AreaGW += Area;
-			gwcnt++;
-			/*
-				cout<<"\t\tfGW100 = "<<dtGW*(cn->getGwaterChng()*1E-6)/Area
-			 <<"\tdm100 = "<<((cn->getSoilMoistureSC()) - ThSurf0)*Ths*100.
-			 <<"\tNwtOld = "<<NwtOld
-			 <<endl<<flush; */
-		}
-
-		AreaF = Area/BasArea;
-		dMRt += ((cn->getRootMoistureSC()) - ThRoot0)*Ths*1000.0*AreaF;
-
-		// Mean soil moisture within the GW time interval over the domain
-		mth100 += ((cn->getSoilMoistureSC()) + ThSurf0)/2.0*AreaF;
-		mthrt  += ((cn->getRootMoistureSC()) + ThRoot0)/2.0*AreaF;
-	
-		id++;
-
-		// if (cn->getNwtOld() > DtoBedrock) cnt++;
+	// Need to divide by the total # of time steps elapsed
+	AA = (double)timer->getElapsedSteps(timer->getCurrentTime());
+	// The integer part --surface SM--
+	BB = floor(cn->getAvSoilMoisture())*1.0E-4;
+	// The decimal part --root SM--
+	Mdelt = (cn->getAvSoilMoisture() - floor(cn->getAvSoilMoisture()))*1.0E+1;
+	cn->setAvSoilMoisture(0.0);
+	cn->setAvSoilMoisture(floor((BB*AA + ThSurf/Ths)/(AA+1)*1.0E+4));
+
+	// Estimate average root soil moisture
+	ThSurf = ComputeSurfSoilMoist(rootZoneDepth);
+	cn->setRootMoisture( ThSurf );
+	cn->setRootMoistureSC( ThSurf/Ths );
+	cn->addAvSoilMoisture((Mdelt*AA + ThSurf/Ths)/(AA+1.0)*1.0E-1);
+
+	cn->setRecharge((NwtNew-NwtOld)*Ths/(Cos*dtGW));
+	// The following are in [M^3]
+	sums[0] += srf*dtGW*cn->getVArea()/1000.0;
+	sums[1] += (MuNew - MuOld)*cn->getVArea()/(Cos*1000.0);
+        sums[2] += (NwtNew-NwtOld)*Ths*cn->getVArea()/(Cos*1000.0);
+
+	// Estimate and output relative factors
+	if (fabs((cn->getSoilMoistureSC()) - ThSurf0) > 1.0E-6) {
+		AA = 1.0;
+		sums[3] += fabs(dtGW*(cn->getGwaterChng()*1.0E-6)/Area)*AA*Area;
+		sums[4] += ((cn->getSoilMoistureSC()) - ThSurf0)*Ths*100.0*Area;
+		sums[5] += Area;
+		sums[6] += 1.0;
+		/*
+			cout<<"\t\tfGW100 = "<<dtGW*(cn->getGwaterChng()*1E-6)/Area
+		 <<"\tdm100 = "<<((cn->getSoilMoistureSC()) - ThSurf0)*Ths*100.
+		 <<"\tNwtOld = "<<NwtOld
+		 <<endl<<flush; */
 	}
-	// cout<<"In total "<<cnt<<" cells have WT > BEDROCK\n"<<endl;
 
-	if (gwcnt > 0) {
-		fGW100 /= AreaGW;
-		gwdm   /= AreaGW;
-	}
+	AreaF = Area/BasArea;
+	sums[7] += ((cn->getRootMoistureSC()) - ThRoot0)*Ths*1000.0*AreaF;
 
-	dM100   += gwdm;
-	mTh100  /= (dtGW/(timer->getTimeStep()));
-	mThRt   /= (dtGW/(timer->getTimeStep()));
-	mTh100   = (mTh100+mth100)/2.0;
-	mThRt    = (mThRt+mthrt)/2.0;
-	fSoi100 /= (dtGW/(timer->getTimeStep()));
-	fTop100 /= (dtGW/(timer->getTimeStep()));
-	fClm100 /= (dtGW/(timer->getTimeStep()));
+	// Mean soil moisture within the GW time interval over the domain
+	sums[8] += ((cn->getSoilMoistureSC()) + ThSurf0)/2.0*AreaF;
+	sums[9] += ((cn->getRootMoistureSC()) + ThRoot0)/2.0*AreaF;
+}
 
-	// Could also be:
-	//      /= (gridPtr->getNodeList()->getActiveSize());
+/*************************************************************************
+**
+**  tHydroModel::SaturatedZoneThreaded(double dtGW)
+**
+**  Threaded saturated zone node loop. Nodes only depend on their own
+**  groundwater flux and are updated in any order on the workers; their
+**  contributions to the basin totals are kept in nodeSums and summed in
+**  list order by SaturatedZone(). The workers start from the values of
+**  this object and the last node is updated here, so that intermediate
+**  values are left as in the serial loop.
+**
+*************************************************************************/
+void tHydroModel::SaturatedZoneThreaded(double dtGW)
+{
+	int n;
 
-	fsum = (fabs(fSoi100)+fabs(fTop100)+fabs(fClm100)+fabs(fGW100));
-	if (!fsum) fsum = 1.0E-6;
+	if (levelPtr.empty() || (int)workers.size() != tThreadPool::getNumThreads())
+		BuildNodeSchedule();
+	n = gridPtr->getNumActiveNodes();
 
-	//fctout<<setprecision(10)<<timer->getCurrentTime()<<"  "
-	//    <<dM100<<"  "<<dMRt<<"  "
-	//	  <<mTh100<<"  "<<mThRt<<"  "
-	//	  <<fsum<<"  "
-	//	  <<fSoi100/fsum<<"  "<<fTop100/fsum<<"  "
-	//	  <<fClm100/fsum<<"  "<<fGW100/fsum<<endl;
+	for (size_t t=0; t < workers.size(); t++)
+		workers[t]->CopyNodeState(this);
 
-	fSoi100=fTop100=fClm100=fGW100=dM100=dMRt=mTh100=mThRt=0.0;
+	tThreadPool::parallelFor(0, n-1, [&](int first, int last, int t) {
+		for (int i=first; i < last; i++) {
+			std::fill(&nodeSums[i*kNumNodeSums], &nodeSums[(i+1)*kNumNodeSums], 0.0);
+			workers[t]->SaturatedNode(gridPtr->getActiveNode(i), dtGW, &nodeSums[i*kNumNodeSums]);
+		}
+	});
 
-#ifndef PARALLEL_TRIBS
-    if (simCtrl->Verbose_label == 'Y') { //WR 08292023 change conditions from nodelist to Verbose
-		cout<<"\t\tRUNOFF = "<<Stok<<" M^3"<<endl<<flush;
-		cout<<"\t\tMOISTCHN = "<<TotMoist<<" M^3"<<endl<<flush;
-		cout<<"\t\tGWCHANGE = "<<TotGWchange<<" M^3"<<endl<<flush;
+	if (n > 0) {
+		std::fill(&nodeSums[(n-1)*kNumNodeSums], &nodeSums[n*kNumNodeSums], 0.0);
+		SaturatedNode(gridPtr->getActiveNode(n-1), dtGW, &nodeSums[(n-1)*kNumNodeSums]);
 	}
-#endif
-
-	} // End of SaturatedZone Routine...
+}
 
 
 //=========================================================================
@@ -4465,6 +5245,15 @@ void tHydroModel::writeRestart(fstream & rStr) const
   BinaryWrite(rStr, V_LU);
   BinaryWrite(rStr, LAI_LU);
 
+  // Deferred steps and rain of the quiescent nodes (none unless
+  // OPTQUIESCENT > 1)
+  int n = (int)quietSteps.size();
+  BinaryWrite(rStr, n);
+  for (int i = 0; i < n; i++) {
+    BinaryWrite(rStr, quietSteps[i]);
+    BinaryWrite(rStr, quietDepth[i]);
+    BinaryWrite(rStr, quietRate[i]);
+  }
 }
 
 /***************************************************************************
@@ -4560,6 +5349,31 @@ void tHydroModel::readRestart(fstream & rStr)
   BinaryRead(rStr, Rs_LU);
   BinaryRead(rStr, V_LU);
   BinaryRead(rStr, LAI_LU);
+
+  // Deferred steps and rain of the quiescent nodes (none unless
+  // OPTQUIESCENT > 1)
+  int n = 0, deferred = 0;
+  BinaryRead(rStr, n);
+  quietSteps.assign(n, 0);
+  quietDepth.assign(n, 0.0);
+  quietRate.assign(n, 1.0E+30);
+  quietCount.assign(n, 0);
+  for (int i = 0; i < n; i++) {
+    BinaryRead(rStr, quietSteps[i]);
+    BinaryRead(rStr, quietDepth[i]);
+    BinaryRead(rStr, quietRate[i]);
+    if (quietSteps[i] > 0)
+      deferred++;
+  }
+  if (quietOption < 2 && n > 0) {
+    if (deferred > 0)
+      Cout<<"\ntHydroModel: Warning: OPTQUIESCENT is off, the deferred "
+          <<"updates of "<<deferred<<" nodes in the restart are dropped"<<endl;
+    quietSteps.clear();
+    quietDepth.clear();
+    quietRate.clear();
+    quietCount.clear();
+  }
 }
 
 //=========================================================================
@@ -28,8 +28,12 @@
 //=========================================================================
 
 #include "src/Headers/Inclusions.h"
+#include "src/tThreadPool/tThreadPool.h"
+#include "src/tCNode/tCNodeState.h"
 
 #define LAMBEPS 2.2204E-16
+#define kNumNodeSums 11        // Basin totals accumulated by each node
+#define kMinThreadedNodes 64   // Smallest level worth running on threads
 
 //=========================================================================
 //
@@ -57,11 +61,29 @@ public:
   void   CheckMoistureContent(tCNode *);
 
   void   UnSaturatedZone(double);
+  void   UnSaturatedNode(tCNode *, double);
+  void   UnSaturatedStep(tHydroModel *, int, tCNode *, double);
+  int    QuiescentNode(tCNode *, double, double);
+  void   DeferNode(tCNode *);
+  double ActualRain(tCNode *, double &, double &);
+  void   AverageSoilMoisture(tCNode *, double, double);
+  void   UnSaturatedZoneThreaded(double);
+  void   BuildNodeSchedule();
+  void   TakeNodeSums(double *);
+  int    UseThreads();
+  void   CopyNodeState(const tHydroModel *);
+  double MaxStateChange();
   void   SaturatedZone(double);
+  void   SaturatedNode(tCNode *, double, double *);
+  void   SaturatedZoneThreaded(double);
   void   Reset();
   void   ResetGW();
+  void   ResetNodeState(int);
+  void   SetNodeState();
   void   ComputeFluxesNodes1D(); 
   void   ComputeFluxesEdgesND();
+  void   ComputeFluxesEdgesThreaded();
+  int    ComputeEdgeFlux(tEdge *, double &);
   void   PrintOldVars(tCNode *, tEdge *, double, int);
   void   PrintNewVars(tCNode *, double); 
   void   PrintNewGWVars(tCNode *, int); 
@@ -198,10 +220,40 @@ private:
   double DtoBedrock{}; 			// Depth to bedrock
   double surfaceSoilDepth; // Depth for surface soil moisture [mm]
   double rootZoneDepth;    // Depth for root zone moisture [mm]
-  
-  ofstream fctout;
+
+  // Threaded node loops: per-thread workers are copies of the
+  // model object holding the intermediate values of the current node
+  int worker{};                       // 1 if this object is a worker
+  std::vector<tHydroModel*> workers;  // One worker per thread
+  std::vector<int> receiver;          // Flow receiver, -1 if not active
+  std::vector<int> donorPtr;          // Donors preceding each node (CSR)
+  std::vector<int> donorIdx;
+  std::vector<int> levelPtr;          // Nodes of each wavefront level
+  std::vector<int> levelNodes;
+  std::vector<tEdge*> gwEdges;        // Edges with groundwater flux
+  std::vector<int> gwNodePtr;         // Edges of each node (CSR), ~e if
+  std::vector<int> gwNodeEdge;        // the node is the destination
+  std::vector<int> gwLastOrg;         // Last edge leaving each node
+  std::vector<int> gwFound;           // Edge has a downslope flux
+  std::vector<double> gwFlux;         // Flux of each edge
+  std::vector<double> gwTrans;        // Transmissivity of each edge
+  std::vector<double> nodeSums;       // Basin totals of each node
   double fSoi100{}, fTop100{}, fClm100{}, fGW100{}, dM100{}, dMRt{}, mTh100{}, mThRt{};
 
+  // Quiescent nodes (OPTQUIESCENT): the update of a node without water
+  // input is deferred and made for several steps at once
+  int quietOption{};                  // OPTQUIESCENT, steps per update
+  double quietTol{};                  // QUIESCENTTOL [mm/hr]
+  double quietTime{}, quietRain{};    // Deferred time [hr] and rain [mm]
+                                      // of the current node
+  std::vector<int> quietSteps;        // Steps deferred, per active node
+  std::vector<double> quietDepth;     // Actual rain of these steps [mm]
+  std::vector<double> quietRate;      // Storage change of the last update
+  std::vector<long> quietCount;       // Deferred steps of the run
+
+  int stateOption{};                  // OPTNODESTATE
+  tCNodeState *nodeState{};           // Store of node variables, or null
+
   tMesh<tCNode>   *gridPtr;      // Pointer to mesh
   tRunTimer *timer;              // Pointer to timer
    
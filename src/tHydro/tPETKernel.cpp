@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tPETKernel.cpp:   Functions for class tPETKernel (see tPETKernel.h)
+**
+***************************************************************************/
+
+#include "src/tHydro/tPETKernel.h"
+#include "src/tThreadPool/tThreadPool.h"
+
+#include <cmath>
+
+using namespace std;
+
+tPETKernel::tPETKernel()
+  : nNodes(0)
+{}
+
+void tPETKernel::resize(int n)
+{
+	nNodes = n;
+	airTemp.resize(n);
+	humFlag.resize(n);
+	humidity.resize(n);
+	atmPress.resize(n);
+	windSpeed.resize(n);
+	vegHeight.resize(n);
+	vegFrac.resize(n);
+	stomRes.resize(n);
+
+	vPress.resize(n);
+	dewTemp.resize(n);
+	rHumid.resize(n);
+	atmPressC.resize(n);
+	totPress.resize(n);
+	lam.resize(n);
+	esat.resize(n);
+	rho.resize(n);
+	cc.resize(n);
+	psy.resize(n);
+	windSpeedC.resize(n);
+	ra.resize(n);
+	rs.resize(n);
+}
+
+/***************************************************************************
+**
+**  tPETKernel::evaluate()
+**
+**  Each thread takes a contiguous range of nodes and evaluates it block
+**  by block, so the terms of a block stay in cache between the loops
+**
+***************************************************************************/
+void tPETKernel::evaluate(double rsRatio, int dark)
+{
+	tThreadPool::parallelFor(0, nNodes, [&](int first, int last, int) {
+		for (int b = first; b < last; b += kPETBlock)
+			evaluateBlock(b, (b + kPETBlock < last) ? b + kPETBlock : last,
+						  rsRatio, dark);
+	});
+}
+
+void tPETKernel::evaluateBlock(int first, int last, double rsRatio, int dark)
+{
+	const double rv = 461.5;
+	const double eo = 6.112;
+	const double to = 273.15;
+	const double eps = 0.622;
+	const double cp = 1013.0;
+	const double Rconst = 287.6;
+	const double k2 = pow(0.41, 2.0);
+
+	// Bare soil part of the aerodynamic resistance (vegBare = 1 m)
+	const double vegBare = 1.0;
+	const double lnBare = log((2.0 + vegBare - 0.67*vegBare)/(0.123*vegBare))*
+		log((2.0 + vegBare - 0.67*vegBare)/(0.0123*vegBare));
+
+	const double *T = &airTemp[0];
+	const double *H = &humidity[0];
+	const int *F = &humFlag[0];
+
+	// latentHeat, satVaporPress
+	for (int i = first; i < last; i++) {
+		lam[i] = (597.3 - T[i]*0.57)*(4186.8);
+		esat[i] = 6.112*exp((17.67*T[i])/(T[i] + 243.5));
+	}
+
+	// vaporPress, with the humidity data of each node
+	for (int i = first; i < last; i++) {
+		if (F[i] == 0) {
+			vPress[i] = esat[i]*H[i]/100.0;
+			dewTemp[i] = 1.0/((1.0/to) - (log(vPress[i]/eo)*rv/lam[i])) - 273.15;
+			rHumid[i] = H[i];
+		}
+		else if (F[i] == 1) {
+			vPress[i] = eo*exp((lam[i]/rv)*((1.0/to) - (1.0/(H[i] + 273.15))));
+			dewTemp[i] = H[i];
+			rHumid[i] = 100.0*vPress[i]/esat[i];
+		}
+		else if (F[i] == 2) {
+			vPress[i] = H[i];
+			rHumid[i] = 100.0*vPress[i]/esat[i];
+			dewTemp[i] = 1.0/((1.0/to) - (log(vPress[i]/eo)*rv/lam[i])) - 273.15;
+		}
+	}
+
+	// totalPress, densityMoist, clausClap, psychoMetric
+	for (int i = first; i < last; i++) {
+		double TK = T[i] + 273.15;
+		atmPressC[i] = (fabs(atmPress[i] - 9999.99) < 1.0E-3) ? 1000.0 : atmPress[i];
+		totPress[i] = atmPressC[i] + vPress[i];
+		rho[i] = (100.0*totPress[i]/(Rconst*TK))*
+			(1.0 - 0.378*vPress[i]/totPress[i]);
+		cc[i] = 100.0*(lam[i]*esat[i])/(rv*(TK*TK));
+		psy[i] = (cp*totPress[i])/(eps*lam[i]);
+	}
+
+	// aeroResist
+	for (int i = first; i < last; i++) {
+		double u = (windSpeed[i] == 0.0 || fabs(windSpeed[i] - 9999.99) < 1.0E-3)
+			? 0.1 : windSpeed[i];
+		double h = (vegHeight[i] == 0) ? 0.1 : vegHeight[i];
+		double zmd = 2.0 + h - 0.67*h;
+		double rav = log(zmd/(0.123*h))*log(zmd/(0.0123*h))/(u*k2);
+		double ras = lnBare/(u*k2);
+		windSpeedC[i] = u;
+		ra[i] = (1 - vegFrac[i])*ras + vegFrac[i]*rav;
+	}
+
+	// stomResist
+	for (int i = first; i < last; i++)
+		rs[i] = dark ? stomRes[i]*rsRatio*1000.0 : stomRes[i]*rsRatio;
+}
+
+void tPETKernel::getTerms(int i, tPETTerms &t) const
+{
+	t.vPress = vPress[i];
+	t.dewTemp = dewTemp[i];
+	t.rHumid = rHumid[i];
+	t.atmPress = atmPressC[i];
+	t.totPress = totPress[i];
+	t.lam = lam[i];
+	t.esat = esat[i];
+	t.rho = rho[i];
+	t.cc = cc[i];
+	t.psy = psy[i];
+	t.windSpeed = windSpeedC[i];
+	t.ra = ra[i];
+	t.rs = rs[i];
+}
+
+//=========================================================================
+//
+//
+//                       End of tPETKernel.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tPETKernel.h:   Header file for tPETKernel Class
+**
+**  tPETKernel evaluates the terms of the air used by the energy balance
+**  of tEvapoTrans (Penman-Monteith, Deardorff and Priestly-Taylor) for
+**  all active nodes of a time step at once. The forcing and land cover
+**  parameters of the nodes are gathered into one array per variable
+**  (structure of arrays, in the order of tMesh::getActiveNode) and the
+**  formulas of the scalar functions
+**
+**    latentHeat, satVaporPress, vaporPress, totalPress, densityMoist,
+**    clausClap, psychoMetric, aeroResist and stomResist
+**
+**  are applied term by term over blocks of kPETBlock nodes, in plain
+**  loops over the arrays (missing values are replaced by selection, not
+**  branches) that the compiler can vectorize. The blocks run on the
+**  NUMTHREADS threads of tThreadPool.
+**
+**  The expressions and their order of operations are those of the scalar
+**  functions (T*T for pow(T,2.0) in clausClap), so the terms are the same
+**  bit for bit unless the compiler contracts them differently (e.g. into
+**  fused multiply-adds); the tolerance against the scalar path is a
+**  relative difference of 1.0E-12. The scalar path is kept
+**  (OPTPETKERNEL = 0) to check a run against it.
+**
+***************************************************************************/
+
+#ifndef TPETKERNEL_H
+#define TPETKERNEL_H
+
+#include <vector>
+
+#define kPETBlock 256  // Nodes evaluated together by one thread
+
+//=========================================================================
+//
+//
+//            Section 1: tPETTerms and tPETKernel Declarations
+//
+//
+//=========================================================================
+
+// Terms of the air of one node
+struct tPETTerms
+{
+  double vPress;     // e(t), vapor pressure [mb] (vaporPress)
+  double dewTemp;    // Dew point temperature [C]
+  double rHumid;     // Relative humidity [%]
+  double atmPress;   // Atmospheric pressure, 1000 mb if missing [mb]
+  double totPress;   // P(t) = Patm(t) + e(t) [mb] (totalPress)
+  double lam;        // L(t) [J/kg] (latentHeat)
+  double esat;       // es(t) [mb] (satVaporPress)
+  double rho;        // Moist air density [kg/m3] (densityMoist)
+  double cc;         // Clausius-Clapeyron [N/m2/K] (clausClap)
+  double psy;        // Psychometric constant [mb/K] (psychoMetric)
+  double windSpeed;  // Wind speed, 0.1 m/s if zero or missing [m/s]
+  double ra;         // Aerodynamic resistance [s/m] (aeroResist)
+  double rs;         // Stomatal resistance [s/m] (stomResist)
+};
+
+class tPETKernel
+{
+ public:
+  tPETKernel();
+
+  void resize(int);
+  int  size() const { return nNodes; }
+
+  // Evaluates the terms of all nodes: 'rsRatio' is the diurnal factor
+  // of the stomatal resistance and 'dark' is set if the sun is below
+  // the horizon
+  void evaluate(double rsRatio, int dark);
+  void getTerms(int, tPETTerms &) const;
+
+  // Inputs, one entry per node
+  std::vector<double> airTemp;     // [C]
+  std::vector<int>    humFlag;     // dewHumFlag of tEvapoTrans: humidity
+                                   // given as 0 - relative humidity,
+                                   // 1 - dew point, 2 - vapor pressure
+  std::vector<double> humidity;    // rHumidity, dewTemp or vPress
+  std::vector<double> atmPress;    // [mb]
+  std::vector<double> windSpeed;   // [m/s]
+  std::vector<double> vegHeight;   // coeffH
+  std::vector<double> vegFrac;     // coeffV
+  std::vector<double> stomRes;     // coeffRs
+
+ private:
+  int nNodes;
+
+  // Outputs, one entry per node (see tPETTerms)
+  std::vector<double> vPress, dewTemp, rHumid, atmPressC, totPress;
+  std::vector<double> lam, esat, rho, cc, psy, windSpeedC, ra, rs;
+
+  void evaluateBlock(int, int, double, int);
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                       End of tPETKernel.h
+//
+//
+//=========================================================================
@@ -14,6 +14,7 @@
 ***************************************************************************/
 
 #include "src/tHydro/tSnowPack.h"
+#include "src/tThreadPool/tThreadPool.h"
 #include "src/Headers/globalIO.h"
 
 //===========================================================================
@@ -75,6 +76,17 @@ void tSnowPack::SetSnowPackVariables(tInputFile &infile) {
     minSnTemp = infile.ReadItem(minSnTemp, "MINSNTEMP");
     snliqfrac = infile.ReadItem(snliqfrac, "SNLIQFRAC"); // Added by CJC 2020
     hillAlbedoOption = infile.ReadItem(hillAlbedoOption, "HILLALBOPT");
+
+    // Snowpacks of the nodes solved node by node in the loop of
+    // callSnowPack (0, default) or together on the threads (1)
+    snowKernelOption = 0;
+    if (infile.IsItemIn("SNOWKERNEL"))
+        snowKernelOption = infile.ReadItem(snowKernelOption, "SNOWKERNEL");
+    if (snowKernelOption != 0 && snowKernelOption != 1) {
+        Cout << "\ntSnowPack: Warning: SNOWKERNEL = " << snowKernelOption
+             << " is not valid, using 0" << endl;
+        snowKernelOption = 0;
+    }
     densityAge = 0.0;
     ETAge = 0.0;
     compactParam = 0.3;
@@ -257,6 +269,12 @@ void tSnowPack::callSnowPack(tIntercept *Intercept, int flag) {
     double SkyC = 0.0; //double tmpC = 0.0;
     double vegHeight = 0;
 
+    // With SNOWKERNEL = 1 the snow of the nodes is solved together after
+    // the node loop (snowStep), except in stochastic mode, where the
+    // radiation is written from inside the loop
+    int kernel = (snowKernelOption == 1 && !rainPtr->getoptStorm());
+    int nSnow = 0;
+
     // SKY2008Snow, AJR2008
     //  metHour = metStep;
     //  etHour = etStep;
@@ -438,6 +456,8 @@ void tSnowPack::callSnowPack(tIntercept *Intercept, int flag) {
             snSub = 0.0; // No sublimation occurs CJC2020
             snEvap = 0.0; // No evaporation occurs CJC2020
             dUint = RLin = RLout = RSin = H = L = G = Prec = 0.0; //reinitialize energy terms
+            if (kernel)
+                Uerr = 0.0; // that of the nodes with snow is set by scatterSnowNode
             ETAge = ETAge + timeStepm;
             liqRoute = 0.0;
             iceWE = 0.0;
@@ -453,6 +473,23 @@ void tSnowPack::callSnowPack(tIntercept *Intercept, int flag) {
             setToNodeSnP(cNode);
         }//end no-snow
 
+        else if (kernel) // snow, solved with that of the other nodes after the loop
+        {
+            int canopy = 0;
+            if (Ioption && Intercept->IsThereCanopy(cNode)) { // && coeffV>0
+                canopy = callSnowIntercept(cNode, Intercept, count, 1);
+            } else {
+                cNode->setNetPrecipitation(rain);
+            }
+
+            if ((int) snowNodes.size() <= nSnow) {
+                snowNodes.resize(nSnow + 1);
+                snowPackNodes.resize(nSnow + 1);
+            }
+            snowPackNodes[nSnow] = cNode;
+            gatherSnowNode(cNode, canopy, snowNodes[nSnow++]);
+        }
+
         else //condtions include some combination of snowpack and snow in canopy, and snowing, rain on snow, or no precip
         {
 
@@ -728,6 +765,18 @@ void tSnowPack::callSnowPack(tIntercept *Intercept, int flag) {
         count++;
 
     }//end while-nodes
+
+    // Canopy snow and snowpacks of the nodes with snow (SNOWKERNEL = 1), on
+    // the threads, then set to the nodes in the order of the loop
+    if (nSnow) {
+        tThreadPool::parallelFor(0, nSnow, [&](int first, int last, int) {
+            for (int i = first; i < last; i++)
+                snowStep(snowNodes[i]);
+        });
+        for (int i = 0; i < nSnow; i++)
+            scatterSnowNode(snowPackNodes[i], snowNodes[i]);
+    }
+
     timeCount++;
     oldTimeStep = hourlyTimeStep;
     hourlyTimeStep++;
@@ -762,11 +811,12 @@ void tSnowPack::callSnowPack(tIntercept *Intercept, int flag) {
 //
 //    Calls the physical algorithms from tSnow::callSnowPack(). Some of
 //    tIntercept::callIntercept() is implemented for the case when there is
-//    no snow.
+//    no snow. With 'kernel', the snow in the canopy is left to canopyStep()
+//    and 1 is returned if there is any or it is snowing, else 0.
 //
 //---------------------------------------------------------------------------
 
-void tSnowPack::callSnowIntercept(tCNode *node, tIntercept *interceptModel, int count) {
+int tSnowPack::callSnowIntercept(tCNode *node, tIntercept *interceptModel, int count, int kernel) {
     double CanStorage;
     double subFrac, unlFrac, precip, Isnow, throughfall, scover;// SKY2008Snow, AJR2008
     int flag;
@@ -849,6 +899,11 @@ void tSnowPack::callSnowIntercept(tCNode *node, tIntercept *interceptModel, int
 
     }//end -- no snow
 
+        //snowing with or without snow in canopy, see canopyStep()
+    else if (kernel) {
+        return 1;
+    }
+
         //snowing with or without snow in canopy
     else {
 
@@ -930,7 +985,7 @@ void tSnowPack::callSnowIntercept(tCNode *node, tIntercept *interceptModel, int
         node->setPotEvap(0.0);
     }//end -- snow exists
 
-    return;
+    return 0;
 }
 
 /****************************************************************************
@@ -1584,14 +1639,19 @@ double tSnowPack::inShortWaveSn(tCNode *cNode) {
 
     Ic = Is = Id = Ir = Ids = Ics = Isw = Iv = 0.0;
 
-    // Elevation, Slope and Aspect have been set before
+    // Elevation, Slope and Aspect have been set before, their terms are
+    // in 'solar' for the node
+    solarNode = gridPtr->getActiveIndex(cNode);
+    assert(solarNode >= 0);
 
     SunHour = 0.0; //Rinehart 2007 -- initialize whether we see sun or not to NO
 
     if (alphaD > 0.0) {
 
         elevation = cNode->getZ(); //SMM 10142008
-        DirectDiffuse(elevation);  // SKY2008Snow, AJR2007
+        // As DirectDiffuse(elevation), evaluated for all nodes -- SKY2008Snow, AJR2007
+        Ic = solar.getBeam(solarNode);
+        Id = solar.getDiffuse();
 
         // because inShortR is incoming solar radiation--sky cover is already factored in--WR
 
@@ -1637,7 +1697,7 @@ double tSnowPack::inShortWaveSn(tCNode *cNode) {
 
         if (shelterOption < 4) {//CHANGED IN 2008
 
-            cosi = 1.0 * (cos(slope) * sinAlpha + sin(slope) * cos(asin(sinAlpha)) * cos(sunaz - aspect));
+            cosi = solar.getCosIncidence(solarNode);
 
             if (cosi >= 0.0) {
                 Ics = Ic * cosi;
@@ -1909,7 +1969,7 @@ double tSnowPack::inShortWaveCan() {
 //
 //----------------------------------------------------------------------------
 
-double tSnowPack::emmisSn() {
+double tSnowPack::emmisSn() const {
 
     double emiss = 0.9;
     return emiss;
@@ -2000,221 +2060,1317 @@ void tSnowPack::snowEB(int nodeID, tCNode *node) {
     Utot += dUint;
 }
 
-/*****************************************************************************
+/****************************************************************************
 **
-**			  tSnowPack I/O Functions
+**			tSnowPack -- Snowpack of a tSnowNode
 **
-**	This set of functions deal with the I/O of tSnowPack that is not already
-**	derived from tEvapoTrans.
+**	The canopy snow and snowpack step of a node, on a tSnowNode, so that
+**	the nodes with snow can be solved together on the NUMTHREADS threads of
+**	tThreadPool (SNOWKERNEL = 1). The node loop of callSnowPack does the
+**	forcing, the interception without snow and the radiation terms that do
+**	not depend on the pack, and gathers them with the state of the node
+**	(gatherSnowNode). snowStep() only reads the tSnowNode and the constants
+**	of the class, and scatterSnowNode() sets the results to the node in the
+**	order of the loop.
 **
-*****************************************************************************/
+**	The physical routines are those above, for the values of the node
+**	instead of those of the class. Unlike the node loop (SNOWKERNEL = 0,
+**	kept to check a run against), the balance error Uerr, the albedo of the
+**	canopy sublimation and the snow in the canopy are those of the node,
+**	not the ones left by the previous node with snow.
+**
+****************************************************************************/
 
-int tSnowPack::getSnowOpt() {
-    return snowOption; //found in tEvapoTrans construction
-}
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::gatherSnowNode()
+//
+//	Stores a node with snow in 'n', after getFrNodeSnP() and
+//	callSnowIntercept() ('canopy' as returned by it, 0 without canopy).
+//
+//---------------------------------------------------------------------------
 
+void tSnowPack::gatherSnowNode(tCNode *cNode, int canopy, tSnowNode &n) {
 
-/*****************************************************************************
-**
-**			  tSnowPack Conversion Functions
-**
-**	This set of functions deal with the I/O of tSnowPack that is not already
-**	derived from tEvapoTrans.
-**
-*****************************************************************************/
+    n.ID = ID;
+    n.eb = 0;
+    n.canopy = canopy;
+
+    // Snow in the canopy, see canopyStep; else the net precipitation set
+    // by the loop of callSnowPack
+    if (canopy) {
+        n.canStorage = cNode->getCanStorage();
+        n.Iold = Iold;
+        n.rHumidityC = rHumidityC;
+    }
+    else {
+        n.snUnload = 0.0;
+        n.snCanWE = cNode->getIntSWE();
+        n.precip = cNode->getNetPrecipitation();
+    }
+
+    n.airTemp = airTemp;
+    n.rHumidity = rHumidity;
+    n.vPress = vPress;
+    n.atmPress = atmPress;
+    n.windSpeed = windSpeed;
+    n.rain = rain;
+    n.coeffH = coeffH;
+    n.coeffV = coeffV;
+    n.coeffLAI = coeffLAI;
+    n.coeffKt = coeffKt;
+    n.coeffAl = coeffAl;
+    n.slope = slope;
+    n.shelterFactorGlobal = shelterFactorGlobal;
+    n.inShortR = inShortR;
+
+    // Radiation, as in snowEB, after 'vPress' is stored for the
+    // turbulent fluxes
+    n.landRefGlobal = landRefGlobal;
+    n.hillalbedo = hillalbedo;
+    shortWaveTermsSn(cNode, n);
+    n.longIn = inLongWave(cNode);
+
+    n.liqWE = liqWE;
+    n.iceWE = iceWE;
+    n.snWE = snWE;
+    n.snTempC = snTempC;
+    n.iceTempC = iceTempC;
+    n.liqTempC = liqTempC;
+    n.crustAge = crustAge;
+    n.densityAge = densityAge;
+    n.ETAge = ETAge;
+    n.albedo = albedo;
+    n.persMax = persMax;
+    n.persMaxtemp = persMaxtemp;
+    n.peakSnWE = peakSnWE;
+    n.peakSnWEtemp = peakSnWEtemp;
+    n.inittime = inittime;
+    n.inittimeTemp = inittimeTemp;
+    n.peaktime = peaktime;
+
+    n.snSub = snSub;
+    n.snEvap = snEvap;
+    n.liqRoute = liqRoute;
+    n.snDepthm = snDepthm;
+    n.phfOnOff = phfOnOff;
+    n.snOnOff = snOnOff;
+    n.Utot = Utot;
+    n.Usn = Usn;
+    n.Uwat = Uwat;
+    n.Utotold = Utotold;
+    n.Uerr = Uerr;
+    n.dUint = dUint;
+    n.liqWatCont = liqWatCont;
+    n.resFact = resFact;
+    n.snTempK = snTempK;
+    n.H = H;
+    n.L = L;
+    n.G = G;
+    n.Prec = Prec;
+    n.Rn = Rn;
+    n.RSin = RSin;
+    n.RLin = RLin;
+    n.RLout = RLout;
+    n.snPrec = snPrec;
+    n.liqPrec = liqPrec;
+}
 
 //---------------------------------------------------------------------------
 //
-//				tSnowPack::CtoK()
-//	
-//	Convert Celsius to Kelvin
-//	
+//			tSnowPack::scatterSnowNode()
+//
+//	Sets the results of snowStep() for the node 'n' to the class and to
+//	the node.
+//
 //---------------------------------------------------------------------------
 
-double tSnowPack::CtoK(double temperature) {
+void tSnowPack::scatterSnowNode(tCNode *cNode, const tSnowNode &n) {
 
-    return (temperature + 273.15);
+    if (n.canopy) {
+        //CanStorage was added to the snow in the canopy
+        if (n.canStorage > 1e-5)
+            cNode->setCanStorage(0.0);
+
+        // Flux variables represent the flux averaged over the entire voronoi cell (scaled by veg fraction)
+        // State variables represent teh state of the canopy itself (un-scaled by veg fraction)
+        cNode->setIntSWE(n.snCanWE); //length units in cm
+        cNode->setIntSnUnload(n.snUnload);
+        cNode->setIntSub(n.intSub);
+        cNode->addIntSub(n.intSub);
+        cNode->addIntUnl(n.snUnload);
+        cNode->setIntPrec(n.intPrec);
+        // Rain rate for the _ENTIRE_ cell:
+        cNode->setNetPrecipitation(n.netPrecip);
+
+        //set wet and dry evap to 0 when snow in canopy
+        cNode->setEvapWetCanopy(0.0);
+        cNode->setEvapDryCanopy(0.0);
+        cNode->setEvapSoil(0.0);
+        cNode->setEvapoTrans(0.0);
+        cNode->setPotEvap(0.0);
+
+        Qcs = n.Qcs;
+        Lm = n.Lm;
+        I = Iold = n.I;
+        Imax = n.Imax;
+    }
+    snUnload = n.snUnload;
+    snCanWE = n.snCanWE;
+
+    ID = n.ID;
+    liqWE = n.liqWE;
+    iceWE = n.iceWE;
+    snWE = n.snWE;
+    snTempC = n.snTempC;
+    iceTempC = n.iceTempC;
+    liqTempC = n.liqTempC;
+    crustAge = n.crustAge;
+    densityAge = n.densityAge;
+    ETAge = n.ETAge;
+    albedo = n.albedo;
+    persMax = n.persMax;
+    persMaxtemp = n.persMaxtemp;
+    peakSnWE = n.peakSnWE;
+    peakSnWEtemp = n.peakSnWEtemp;
+    inittime = n.inittime;
+    inittimeTemp = n.inittimeTemp;
+    peaktime = n.peaktime;
+
+    snSub = n.snSub;
+    snEvap = n.snEvap;
+    liqRoute = n.liqRoute;
+    snDepthm = n.snDepthm;
+    phfOnOff = n.phfOnOff;
+    snOnOff = n.snOnOff;
+    Utot = n.Utot;
+    Usn = n.Usn;
+    Uwat = n.Uwat;
+    Utotold = n.Utotold;
+    Uerr = n.Uerr;
+    dUint = n.dUint;
+    liqWatCont = n.liqWatCont;
+    resFact = n.resFact;
+    snTempK = n.snTempK;
+    H = n.H;
+    L = n.L;
+    G = n.G;
+    Prec = n.Prec;
+    Rn = n.Rn;
+    RSin = n.RSin;
+    RLin = n.RLin;
+    RLout = n.RLout;
+    snPrec = n.snPrec;
+    liqPrec = n.liqPrec;
+
+    if (n.eb) {
+        // As inShortWaveSn
+        Ics = n.Ics;
+        Ids = n.Ids;
+        SunHour = n.SunHour;
+        landRefGlobal = n.landRefGlobal;
+        hillalbedo = n.hillalbedo;
+        if (tsOption > 1 && !rainPtr->getoptStorm()) {
+            cNode->setShortRadIn(n.inShortR);
+        } else {
+            cNode->setShortRadIn(n.Isw);
+        }
+        cNode->setShortRadIn_dir(n.Ics); // No cloud cover term (N = 0)
+        cNode->setShortRadIn_dif(n.Ids + n.Ir);
+
+        // As snowEB
+        inShortR = kilotonaught * RSin;
+        inLongR = kilotonaught * RLin;
+        outLongR = kilotonaught * RLout;
+
+        cNode->setHFlux(0.0);
+        cNode->setLFlux(0.0);
+        cNode->setLongRadIn(0.0);
+        cNode->setLongRadOut(0.0);
+        cNode->setShortAbsbVeg(0.0);
+        cNode->setShortAbsbSoi(0.0);
+
+        cNode->setSnLHF(L * kilotonaught);
+        cNode->setSnSHF(H * kilotonaught);
+        cNode->setSnPHF(Prec * kilotonaught);
+        cNode->setSnGHF(n.G * kilotonaught);
+        cNode->setSnRLin(RLin * kilotonaught);
+        cNode->setSnRLout(RLout * kilotonaught);
+        cNode->setSnRSin(RSin * kilotonaught);
+    }
+
+    // Set ET variables equal to zero due to snowpack
+    cNode->setEvapSoil(0.0);
+    cNode->setActEvap(0.0);
+    cNode->setEvapoTrans(cNode->getEvapWetCanopy() + cNode->getEvapDryCanopy());
 
+    setToNodeSnP(cNode);
 }
 
 //---------------------------------------------------------------------------
 //
-//				tSnowPack::KtoC()
+//			tSnowPack::shortWaveTermsSn()
+//
+//	The part of inShortWaveSn(tCNode *) that does not depend on the albedo
+//	of the pack: beam and diffuse irradiance on the slope, with the
+//	sheltering.
 //
-//	Convert Kelvin to Celsius
 //---------------------------------------------------------------------------
 
-double tSnowPack::KtoC(double temperature) {
+void tSnowPack::shortWaveTermsSn(tCNode *cNode, tSnowNode &n) {
+    double N, v, cosi;
+    double RadGlobClr;
 
-    return (temperature - 273.15);
+    Ic = Id = Ids = Ics = 0.0;
+    n.Is = 0.0;
 
-}
+    solarNode = gridPtr->getActiveIndex(cNode);
+    assert(solarNode >= 0);
 
-/***************************************************************************
-**
-** tSnowPack::writeRestart() Function
-**
-** Called from tSimulator during simulation loop
-**
-***************************************************************************/
-void tSnowPack::writeRestart(fstream &rStr) const {
-    BinaryWrite(rStr, hillAlbedoOption);
-    BinaryWrite(rStr, densityAge);
-    BinaryWrite(rStr, rainTemp);
-    BinaryWrite(rStr, ETAge);
+    SunHour = 0.0;
+    n.sun = (alphaD > 0.0);
 
-    BinaryWrite(rStr, timeSteph);
-    BinaryWrite(rStr, timeSteps);
-    BinaryWrite(rStr, timeStepm);
-    BinaryWrite(rStr, minutelyTimeStep);
+    if (n.sun) {
 
-    BinaryWrite(rStr, liqWE);
-    BinaryWrite(rStr, iceWE);
-    BinaryWrite(rStr, snWE);
-    BinaryWrite(rStr, canWE);
-    BinaryWrite(rStr, liqRoute);
-    BinaryWrite(rStr, liqWEm);
-    BinaryWrite(rStr, iceWEm);
-    BinaryWrite(rStr, snWEm);
-    BinaryWrite(rStr, Utot);
-    BinaryWrite(rStr, Usn);
-    BinaryWrite(rStr, Uwat);
-    BinaryWrite(rStr, Utotold);
-    BinaryWrite(rStr, liqWatCont);
-    BinaryWrite(rStr, liqTempC);
-    BinaryWrite(rStr, iceTempC);
-    BinaryWrite(rStr, snTempC);
-    BinaryWrite(rStr, liqTempK);
-    BinaryWrite(rStr, iceTempK);
-    BinaryWrite(rStr, snTempK);
-    BinaryWrite(rStr, crustAge);
+        elevation = cNode->getZ();
+        Ic = solar.getBeam(solarNode);
+        Id = solar.getDiffuse();
 
-    BinaryWrite(rStr, H);
-    BinaryWrite(rStr, L);
-    BinaryWrite(rStr, G);
-    BinaryWrite(rStr, Prec);
-    BinaryWrite(rStr, Rn);
-    BinaryWrite(rStr, dUint);
-    BinaryWrite(rStr, RLin);
-    BinaryWrite(rStr, RLout);
-    BinaryWrite(rStr, RSin);
-    BinaryWrite(rStr, Uerr);
-    BinaryWrite(rStr, snPrec);
-    BinaryWrite(rStr, liqPrec);
-    BinaryWrite(rStr, snPrecm);
-    BinaryWrite(rStr, liqPrecm);
-    BinaryWrite(rStr, snPrecmm);
-    BinaryWrite(rStr, liqPrecmm);
-    BinaryWrite(rStr, snUnload);
-    BinaryWrite(rStr, snCanWE);
-    BinaryWrite(rStr, vapPressSmb);
-    BinaryWrite(rStr, vapPresskSPa);
+        N = 0;
 
-    BinaryWrite(rStr, rholiqcgs);
-    BinaryWrite(rStr, rhoicecgs);
-    BinaryWrite(rStr, rhosncgs);
-    BinaryWrite(rStr, rholiqkg);
-    BinaryWrite(rStr, rhoicekg);
-    BinaryWrite(rStr, rhosnkg);
-    BinaryWrite(rStr, rhoAir);
-    BinaryWrite(rStr, phfOnOff);
+        if (tsOption > 1 && !rainPtr->getoptStorm()) {
+            RadGlobClr = (inShortR / (1.0 - 0.65 * pow(N, 2.0)));
+            Ic = Ic / (Ic * sinAlpha + Id) * RadGlobClr;
+            Id = RadGlobClr - Ic * sinAlpha;
+        }
 
-    BinaryWrite(rStr, cpsnowkJ);
-    BinaryWrite(rStr, cpicekJ);
-    BinaryWrite(rStr, cpwaterkJ);
-    BinaryWrite(rStr, cpairkJ);
-    BinaryWrite(rStr, latFreezekJ);
-    BinaryWrite(rStr, latVapkJ);
-    BinaryWrite(rStr, latSubkJ);
+        if (shelterOption < 4) {
 
-    BinaryWrite(rStr, resFact);
-    BinaryWrite(rStr, albedo);
-    BinaryWrite(rStr, hillalbedo);
-    BinaryWrite(rStr, compactParam);
-    BinaryWrite(rStr, rhoSnFreshkg);
-    BinaryWrite(rStr, minSnTemp);
+            cosi = solar.getCosIncidence(solarNode);
 
-    BinaryWrite(rStr, snDepth);
-    BinaryWrite(rStr, snDepthm);
-    BinaryWrite(rStr, snOnOff);
-    BinaryWrite(rStr, peakSnWE);
-    BinaryWrite(rStr, peakSnWEtemp);
-    BinaryWrite(rStr, persMax);
-    BinaryWrite(rStr, persMaxtemp);
-    BinaryWrite(rStr, inittime);
-    BinaryWrite(rStr, inittimeTemp);
-    BinaryWrite(rStr, peaktime);
+            if (cosi >= 0.0) {
+                Ics = Ic * cosi;
+                SunHour = 1.0;
+            } else {
+                Ics = 0.0;
+                SunHour = 0.0;
+            }
+        } else {
+            Ics = 1.0 * Ic;
+            SunHour = 1.0;
+        }
 
-    BinaryWrite(rStr, naughttokilo);
-    BinaryWrite(rStr, kilotonaught);
-    BinaryWrite(rStr, cgsRHOtomks);
-    BinaryWrite(rStr, mksRHOtocgs);
-    BinaryWrite(rStr, naughttocm);
-    BinaryWrite(rStr, cmtonaught);
-    BinaryWrite(rStr, ctom);
-    BinaryWrite(rStr, mtoc);
+        if ((shelterOption == 2) || (shelterOption == 1)) {
+            Ics *= aboveHorizon(ID);
+            SunHour *= aboveHorizon(ID);
+        }
 
-    BinaryWrite(rStr, Qcs);
-    BinaryWrite(rStr, Ce);
-    BinaryWrite(rStr, I);
-    BinaryWrite(rStr, Iold);
-    BinaryWrite(rStr, psiS);
-    BinaryWrite(rStr, Imax);
-    BinaryWrite(rStr, prec);
-    BinaryWrite(rStr, LAI);
-    BinaryWrite(rStr, kc);
-    BinaryWrite(rStr, iceRad);
-    BinaryWrite(rStr, dmdt);
-    BinaryWrite(rStr, Omega);
-    BinaryWrite(rStr, Sp);
-    BinaryWrite(rStr, RH);
-    BinaryWrite(rStr, D);
-    BinaryWrite(rStr, rhoVap);
-    BinaryWrite(rStr, Sh);
-    BinaryWrite(rStr, Nu);
-    BinaryWrite(rStr, Re);
-    BinaryWrite(rStr, KtAtm);
-    BinaryWrite(rStr, Ta);
-    BinaryWrite(rStr, Mwater);
-    BinaryWrite(rStr, R);
-    BinaryWrite(rStr, RdryAir);
-    BinaryWrite(rStr, esatIce);
-    BinaryWrite(rStr, nu);
-    BinaryWrite(rStr, beta);
-    BinaryWrite(rStr, acoefficient);
-    BinaryWrite(rStr, Lm);
-    BinaryWrite(rStr, airTempK);
-    BinaryWrite(rStr, effPrecip);
+        if ((shelterOption > 0) && (shelterOption < 3)) {
+            v = shelterFactorGlobal;
+        } else if (shelterOption == 0 || shelterOption == 3) {
+            v = 0.5 * (1 + cos(slope));
+        } else {
+            v = 1.0;
+        }
 
-    tEvapoTrans::writeRestart(rStr);
+        Ids = Id * v;
+
+        n.Is = (1.0 - 0.65 * pow(N, 2)) * (Ics + Ids);
+    }
+
+    n.Ics = Ics;
+    n.Ids = Ids;
+    n.SunHour = SunHour;
 }
 
-/***************************************************************************
-**
-** tSnowPack::readRestart() Function
-**
-***************************************************************************/
-void tSnowPack::readRestart(fstream &rStr) {
-    BinaryRead(rStr, hillAlbedoOption);
-    BinaryRead(rStr, densityAge);
-    BinaryRead(rStr, rainTemp);
-    BinaryRead(rStr, ETAge);
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::inShortWaveSn()
+//
+//	The part of inShortWaveSn(tCNode *) that depends on the albedo of the
+//	pack: reflection from the hills, vegetation and albedo, after
+//	shortWaveTermsSn(). Returns the shortwave absorbed by the pack.
+//
+//---------------------------------------------------------------------------
 
-    BinaryRead(rStr, timeSteph);
-    BinaryRead(rStr, timeSteps);
-    BinaryRead(rStr, timeStepm);
-    BinaryRead(rStr, minutelyTimeStep);
+double tSnowPack::inShortWaveSn(tSnowNode &n) const {
+    double Is, Iv, Isw, Ir;
 
-    BinaryRead(rStr, liqWE);
-    BinaryRead(rStr, iceWE);
-    BinaryRead(rStr, snWE);
-    BinaryRead(rStr, canWE);
-    BinaryRead(rStr, liqRoute);
-    BinaryRead(rStr, liqWEm);
-    BinaryRead(rStr, iceWEm);
-    BinaryRead(rStr, snWEm);
-    BinaryRead(rStr, Utot);
-    BinaryRead(rStr, Usn);
+    if (n.sun) {
+        Is = n.Is;
+
+        if (hillAlbedoOption == 0) {
+            n.hillalbedo = n.albedo;
+        } else if (hillAlbedoOption == 1) {
+            n.hillalbedo = n.coeffAl;
+        } else if (hillAlbedoOption == 2) {
+
+            if (n.snCanWE == 0)
+                n.hillalbedo = n.coeffV * n.coeffAl + (1 - n.coeffV) * n.albedo;
+            else
+                n.hillalbedo = n.albedo;
+        }
+
+        if (shelterOption == 0) {
+            Ir = n.hillalbedo * Is * (1 - cos(n.slope)) * 0.5;
+            Is += Ir;
+        } else if ((shelterOption > 1) && (shelterOption < 4)) {
+            Ir = n.hillalbedo * Is * (0.5 * (1 + cos(n.slope)) - n.shelterFactorGlobal);
+            n.landRefGlobal = 0.5 * (1 + cos(n.slope)) - n.shelterFactorGlobal;
+            Is += Ir;
+
+        } else {
+            Ir = 0.0;
+        }
+
+        if ((evapotransOption == 1) || (snowOption)) {
+            Iv = Is * exp((n.coeffKt - 1) * n.coeffLAI) * n.coeffV +
+                 Is * (1.0 - n.coeffV);
+        } else
+            Iv = Is;
+
+        Isw = Iv * (1.0 - n.albedo);
+    }
+    else {
+        Ir = Isw = 0.0;
+    }
+
+    n.Ir = Ir;
+    n.Isw = Isw;
+    return Isw;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::updateRipeSnowPack()
+//
+//	updateRipeSnowPack(double) for the node 'n'
+//
+//---------------------------------------------------------------------------
+
+void tSnowPack::updateRipeSnowPack(tSnowNode &n, double precip) const {
+    //liq WE update
+    n.snEvap = (1 - n.coeffV) * latentHFCalc(n, resFactCalc(n)) * timeSteps /
+             (rholiqkg * latVapkJ); // units should be in meters
+    n.liqWE += cmtonaught * ((mtoc * precip) * (1 - snowFracCalc(n.airTemp, n.rHumidity))) * timeSteps /
+             3600; // Removed snUnload term CJC2020
+
+    if (n.liqWE + n.snEvap <= 0) {
+        n.snEvap = n.liqWE;
+        n.liqWE = 0;
+    } else {
+        n.liqWE += n.snEvap;
+    }
+
+    //solid WE update
+    n.iceWE += cmtonaught * (mtoc * (precip * snowFracCalc(n.airTemp, n.rHumidity))) * timeSteps / 3600;
+    n.snSub = 0.0; // No sublimation occurs CJC2020
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::updateSolidSnowPack()
+//
+//	updateSolidSnowPack(double) for the node 'n'
+//
+//---------------------------------------------------------------------------
+
+void tSnowPack::updateSolidSnowPack(tSnowNode &n, double precip) const {
+    //liq WE update
+    n.liqWE += cmtonaught * (mtoc * (precip * (1 - snowFracCalc(n.airTemp, n.rHumidity)))) * timeSteps /
+             3600; // Removed snUnload term CJC2020
+    n.snEvap = 0.0; // No evaporation occurs CJC2020
+
+
+    //ice WE update
+    n.snSub = (1 - n.coeffV) * latentHFCalc(n, resFactCalc(n)) * timeSteps /
+            (rholiqkg * latSubkJ);// units should be in meters
+    n.iceWE += cmtonaught * (mtoc * (precip * snowFracCalc(n.airTemp, n.rHumidity))) * timeSteps / 3600;
+
+    if (n.iceWE + n.snSub <= 0) {
+        n.snSub = n.iceWE;
+        n.iceWE = 0;
+    } else {
+        n.iceWE += n.snSub;
+    }
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::snowEB()
+//
+//	snowEB(int, tCNode *) for the node 'n', the fluxes are set to the
+//	node by scatterSnowNode()
+//
+//---------------------------------------------------------------------------
+
+void tSnowPack::snowEB(tSnowNode &n) const {
+
+    double sigma(5.67e-8);
+    double v1;
+
+    if (shelterOption > 0 && shelterOption < 3)
+        v1 = n.shelterFactorGlobal;
+    else
+        v1 = 1;
+
+    n.eb = 1;
+
+    //convert temperature
+    n.snTempK = CtoK(n.snTempC);
+
+    //set up resistance
+    n.resFact = resFactCalc(n);
+
+    //turbulent heat fluxes
+    n.H = sensibleHFCalc(n, n.resFact);
+    n.L = latentHFCalc(n, n.resFact);
+
+    //precipitation heat flux
+    n.Prec = n.phfOnOff * precipitationHFCalc(n);
+
+    //atmospheric heat flux (the fluxes are set to the node by scatterSnowNode)
+    n.RSin = naughttokilo * inShortWaveSn(n); // AJR2008, SKY2008Snow
+    n.RLin = naughttokilo * n.longIn; // AJR2008, SKY2008Snow
+    n.RLout = -naughttokilo * v1 * emmisSn() * sigma * pow(n.snTempK, 4.0);
+
+    n.Rn = n.RSin + n.RLin + n.RLout;
+    n.G = 0;
+
+    //calculate total dU over given timestep
+    n.dUint = (n.H + n.Rn + n.L + n.Prec + n.G) * timeSteps; // Changed *3600 to *timeSteps CJC2020
+
+    //find new energy state of snow
+    n.Utot += n.dUint;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::latentHFCalc()
+//
+//	latentHFCalc(double) for the node 'n'
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::latentHFCalc(const tSnowNode &n, double Kaero) const {
+
+    double lhf;
+    double snTemp_corr = n.snTempC;
+
+    // If snowpack has liquid then make sure temp isn't below 0C
+    if (n.liqWE > 1e-5) {
+        snTemp_corr = 0.0;
+    }
+
+    // If the snow surface is at or above the melting point, the process is evaporation.
+    if (snTemp_corr == 0.0) {
+        // Use latent heat of vaporization.
+        lhf = (latVapkJ * 0.622 * rhoAir * Kaero * (n.vPress - 6.111) / n.atmPress); //evaporation by THM 2012
+    // If the snow surface is frozen, the process is sublimation.
+    } else {
+        // Use latent heat of sublimation.
+        // Should we be using Clausius-Clapeyron here for the vapor pressure (liquid water) or should it be for ice?
+        // Could use Magnus-Tetens formula for ice vapor pressure.
+        lhf = (latSubkJ * 0.622 * rhoAir * Kaero * (n.vPress - 6.112 * exp((17.67 * snTemp_corr) / (snTemp_corr + 243.5))) /
+               n.atmPress); //sublimation by THM 2012
+    }
+    return lhf;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::sensibleHFCalc()
+//
+//	sensibleHFCalc(double) for the node 'n'
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::sensibleHFCalc(const tSnowNode &n, double Kaero) const {
+
+    double shf;
+    double snTemp_corr = n.snTempC;
+
+    // If snowpack has liquid then make sure temp isn't below 0C
+    if (n.liqWE > 1e-5) {
+        snTemp_corr = 0.0;
+    }
+
+    shf = (rhoAir * cpairkJ * Kaero * ((n.airTemp + 273.15) - (snTemp_corr + 273.15)));
+    return shf;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::snowFracCalc()
+//
+//	snowFracCalc() for the air temperature 'Ta' (C) and relative
+//	humidity 'RH' (%)
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::snowFracCalc(double Ta, double RH) const {
+
+    double snowfrac;
+    double Tw, f1;
+    // Calculate wet-Bulb Temperature according to Stull (2011) https://doi.org/10.1175/JAMC-D-11-0143.1
+    Tw = Ta*atan(0.151977*pow(RH + 8.313659,0.5)) + atan(Ta + RH) - atan(RH - 1.676331) +
+         0.00391838*pow(RH,1.5)*atan(0.023101*RH) - 4.686035; // in degC
+
+    // Calculate  snowfall fraction according to Wang et al. (2019) https://doi.org/10.1029/2019GL085722
+    f1 = 1 + 6.99*pow(10,-5)*exp(2*(Tw + 3.97));
+
+    // Wet-bulb temperature > 5C corresponds to Ta = 10C and RH = 50%, assuming no snowfall
+    if ( Tw > 5 ) {
+        snowfrac = 0;
+    }
+    else {
+        snowfrac = 1/f1;
+    }
+
+/*  Updated as outlined above to reflect influence of RH on snow fall partitioning -WR 11272023
+//    double TMin(0), TMax(4.4); //indices (Wigmosta et al. 1994)—updated for CJC thesis (see table 11)
+//
+//    if (airTemp <= TMin)
+//        snowfrac = 1; // all ice
+//    if (airTemp >= TMax)
+//        snowfrac = 0; // all liquid
+//    if ((airTemp >= TMin) && (airTemp <= TMax))
+//        snowfrac = (TMax - airTemp) / (TMax - TMin); //mixture
+*/
+
+    return snowfrac;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::precipitationHFCalc()
+//
+//	precipitationHFCalc() for the node 'n'
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::precipitationHFCalc(tSnowNode &n) const {
+    double phf = 0;
+
+    n.snPrec = (snowFracCalc(n.airTemp, n.rHumidity) * (n.rain + ctom * n.snUnload)) * mtoc; //convert from mm to cm
+    n.liqPrec = ((1 - snowFracCalc(n.airTemp, n.rHumidity)) * (n.rain + ctom * n.snUnload)) * mtoc; //convert from mm to cm
+
+    if (n.airTemp > 0) {
+        phf = (cmtonaught * n.snPrec * 0 * rholiqkg * cpicekJ +
+               cmtonaught * n.liqPrec * (latFreezekJ + n.airTemp * rholiqkg * cpwaterkJ)) / 3600;
+
+    } else if (n.airTemp <= 0) {
+        phf = (cmtonaught * n.snPrec * n.airTemp * rholiqkg * cpicekJ +
+               cmtonaught * n.liqPrec * latFreezekJ * rholiqkg) / 3600;
+
+    }
+
+    return phf;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::agingAlbedo()
+//
+//	agingAlbedo() for the node 'n'
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::agingAlbedo(const tSnowNode &n) const {
+    double alb;
+
+    // Albedo Parameters for Central Arizona
+    // Based on Sun et al. (2019) and general values for dusty, ephemeral snowpacks.
+    const double snInitialAlbedo = 0.85; // Albedo of fresh, new snow.
+    const double snLambdaDry     = 0.96; // Decay factor for dry snow aging.
+    const double snLambdaWet     = 0.87; // Faster decay factor for wet/melting snow.
+    const double snMinAlbedo     = 0.45; // Minimum albedo for old, "dirty" snow.
+
+    if (n.liqWE < 1.0E-5) {
+        // Dry snow aging
+        alb = snInitialAlbedo * pow(snLambdaDry, pow(n.crustAge / 24.0, 0.58));
+    } else {
+        // Wet snow aging
+        alb = snInitialAlbedo * pow(snLambdaWet, pow(n.crustAge / 24.0, 0.46));
+    }
+
+    // Enforce the minimum albedo floor
+    if (alb < snMinAlbedo) {
+        alb = snMinAlbedo;
+    }
+
+    return alb;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::resFactCalc()
+//
+//	resFactCalc() for the node 'n'
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::resFactCalc(const tSnowNode &n) const {
+    const double vonKarm = 0.41;
+    const double g = 9.81;
+    double windSpeedC, windSpeedS; // windspeed 2 meters above canopy & snow/surface JB2025 @ASU
+    double rf, ra;
+    double vegHeight, vegFrac, vegBare;
+    double zm, zom, zov, d, rav, ras;
+	double Ri_cr = 0.1;  // Critical Richardson number, 0.2 is the most aggresive
+
+    windSpeedC = (n.windSpeed == 0.0 || fabs(n.windSpeed - 9999.99) < 1e-3) ? 0.01 : n.windSpeed;
+
+    // Vegetation height adjusted for snow
+    vegHeight = (n.coeffH <= 0) ? 0.1 : n.coeffH;
+    vegHeight = (vegHeight > n.snDepthm) ? vegHeight - n.snDepthm : 0.1;
+
+    vegBare = 0.1;
+    vegFrac = n.coeffV;
+
+    // Compute below canopy windspeed at snow surface following equation Moreno et al. (2016) CJC 2020
+    if (n.snDepthm < n.coeffH) {
+        windSpeedS = windSpeedC * exp(-0.5 * n.coeffLAI * (1.0 - (n.snDepthm / n.coeffH)));
+    } else {
+        windSpeedS = windSpeedC;  // No canopy attenuation
+    }
+
+    // --- Aerodynamic resistance for vegetation ---
+    zm = 2.0 + vegHeight;
+    zom = 0.123 * vegHeight;
+    zov = 0.0123 * vegHeight;
+    d = 0.67 * vegHeight;
+
+    rav = log((zm - d) / zom) * log((zm - d) / zov) / (windSpeedC * pow(vonKarm, 2)); //Uses canopy level wind speed
+
+    // --- Aerodynamic resistance for bare soil ---
+    zm = 2.0 + vegBare;
+    zom = 0.123 * vegBare;
+    zov = 0.0123 * vegBare;
+    d = 0.67 * vegBare;
+
+    ras = log((zm - d) / zom) * log((zm - d) / zov) / (windSpeedS * pow(vonKarm, 2)); // Uses snow/surface level wind
+
+    // Weighted resistance
+    ra = (1 - vegFrac) * ras + vegFrac * rav;
+
+    // If snowpack has liquid then make sure snow temp isn't below 0C
+    double Ts; // Snow temperature in K
+    if (n.liqWE > 1e-5) {
+        Ts = 273.15;
+    } else {
+        Ts = n.snTempC + 273.15; 
+    }
+
+    double Ta = n.airTemp + 273.15;    // Air temp in K
+    double T_avg = 0.5 * (Ta + Ts);  // Mean temp
+    // Effective vertical distance between reference air temperature (2 m AGL) and snow surface.
+    // If snow depth exceeds 2 m, zm_eff becomes negative or zero, which is non-physical.
+    // Clamp to minimum of 0.1 m to preserve numerical stability in RiB calculation.
+    double zm_eff = std::max(0.1, 2.0 - n.snDepthm);
+    double z0 = 0.123 * vegHeight;    // Roughness length, same as zom above
+
+    // Considering atmospheric stability, Andreadis et al. (2009), JB2025 @ASU
+    // https://doi.org/10.1029/2008WR007042
+
+    // Bulk Richardson Number (Eq. 17)
+    // Use windSpeedS (attenuated wind at snow surface) in RiB calc.
+    // Though Ta is from 2m AGL, we prioritize the snow–air interface.
+    // This matches the aerodynamic resistance formulation and maintains internal consistency.
+    double RiB = (g * zm_eff * (Ta - Ts)) / (T_avg * windSpeedS* windSpeedS);
+
+    // Compute upper limit Ri_u (Eq. 24)
+    double Ri_u = 1.0 / (log(zm_eff / z0) + 5.0);
+
+    // Stability correction factor
+    double C_stab;
+    if (RiB < 0.0) {
+        // Unstable conditions (Eq. 19)
+        C_stab = pow(1.0 - 16.0 * RiB, 0.5);
+    } else if (RiB <= Ri_u) {
+        // Stable but not extreme (Eq. 25)
+        C_stab = 1.0 / pow(1.0 - (RiB / Ri_cr), 2.0);
+    } else {
+        // Very stable, capped (Eq. 26)
+        C_stab = 1.0 / pow(1.0 - (Ri_u / Ri_cr), 2.0);
+    }
+
+	// Clamp the stability correction factor to a reasonable range
+	// As RiB approaches Ri_cr, C_stab approaches infinity, so we limit it
+	if (C_stab > 15.0) { C_stab = 15.0; } // kaero can at most be 15 times the original value
+
+    // Apply correction to aerodynamic resistance
+    ra *= C_stab;
+
+    // Convert resistance to conductance
+    rf = 1.0 / ra; // Otherwise known as kaero
+
+    return rf;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::computeSub()
+//
+//	Sublimation from the canopy of the node 'n' as computeSub(), with the
+//	albedo of its snow; returns Qcs
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::computeSub(const tSnowNode &n) const {
+    double airTempK = CtoK(n.airTemp);
+    double Sp, acoefficient, windSpeedC, Re, Sh, Nu, esatIce, rhoVap, D;
+    double Omega, dmdt, psiS, Ce;
+
+    //compute effective incident shortwave radiation on snow crystal
+    // The albedo is that of the snow of the node (crust age at the start of
+    // the step), not the one left by the last node with a snowpack
+    Sp = PI * pow(iceRad, 2.0) * (1 - agingAlbedo(n)) * n.inShortR;//check units--check (W)//WR debug change 0.8 to albedo
+
+    //Find coefficient for changing windspeed
+    acoefficient = beta * n.coeffLAI;
+
+    //find windspeed
+    windSpeedC = n.windSpeed * exp(-acoefficient * 0.4);
+
+    //Calculate Reynolds number
+    Re = 2 * iceRad * windSpeedC / nu;
+
+    //Calculate Sherwood number
+    Sh = 1.79 + 0.606 * pow(Re, 0.5);
+
+    //Calculate Nusselt number
+    Nu = Sh;
+
+    //calculate saturated vapor pressure of at ice interface
+    esatIce = 611.15 * exp(22.452 * (airTempK - 273.16) / (airTempK - 0.61)); //check units--check
+
+    //calculate density of vapor
+    rhoVap = 0.622 * esatIce / (RdryAir * airTempK);
+
+    //compute vapor diffusivity
+    D = 2.06e-5 * pow(airTempK / 273.0, 1.75);
+
+    //Place holder in algorithm
+    Omega = (1 / (KtAtm * airTempK * Nu)) * (1000 * latSubkJ * Mwater / (R * airTempK) - 1);//check units--check
+
+    //find change of mass of ice crystal with respect to time
+    dmdt = (2.0 * PI * iceRad * (n.rHumidityC / 100 - 1) - Sp * Omega) / //WR 01032024 switched to rHumidtyC since that is what is set to node.
+           (1000 * latSubkJ * Omega + (1 / (D * rhoVap * Sh)));//1000 conversion from KJ to J
+
+    //relative sublimation from ice sphere
+    psiS = dmdt / ((4.0 / 3.0) * PI * rhoicekg * iceRad * iceRad * iceRad);
+
+    //canopy exposure coefficient
+    Ce = kc * pow(n.I / n.Imax, -0.4);
+
+    //compute total sublimated snow during timestep
+    return Ce * n.I * psiS * timeSteps;
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::computeUnload()
+//
+//	Unloading from the canopy of the node 'n' as computeUnload(); returns Lm
+//
+//---------------------------------------------------------------------------
+
+double tSnowPack::computeUnload(const tSnowNode &n) const {
+    double airTempK = CtoK(n.airTemp);
+
+    //find if over critical temperature
+    if (airTempK >= 273.16) {
+        return 5.8e-5 * (airTempK - 273.16) * timeSteps;//unload
+    } else {
+        return 0.0;//do not unload
+    }
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::snowStep()
+//
+//	Snow in the canopy (canopyStep), then mass and energy balance of the
+//	snowpack of the node 'n' with snow on the ground or falling, for the
+//	net precipitation n.precip (mm), as the node loop of callSnowPack.
+//
+//---------------------------------------------------------------------------
+
+void tSnowPack::snowStep(tSnowNode &n) const {
+    double precip;
+
+    if (n.canopy)
+        canopyStep(n);
+    precip = n.precip;
+
+    n.snDepthm = cmtonaught * n.snWE / 0.312; // 0.312 is value for bulk density of snow, Sturm et al. 2010
+
+    //change mass (volume) quantities to correct units (kJ, m, C, s)
+    n.iceWE = n.iceWE * cmtonaught; // mm to m
+    n.liqWE = n.liqWE * cmtonaught; // mm to m
+    n.snWE = n.iceWE + n.liqWE; // mm to m
+
+    if (n.airTemp > 0.0) {
+        n.snTempC = 0.0;
+    } else {
+        n.snTempC = n.airTemp;
+    }
+
+    if (n.snWE < 1e-5) {
+
+        n.phfOnOff = 0.0;
+        n.densityAge = 0.0;
+        n.crustAge = 0.0;
+
+        if (n.snTempC == 0.0) {
+            updateRipeSnowPack(n, precip);
+        }
+        else {
+            updateSolidSnowPack(n, precip);
+        }
+
+        n.snWE = n.iceWE + n.liqWE; // unit in meters here
+        n.snSub *= naughttocm; // m to cm
+        n.snEvap *= naughttocm; // m to cm
+
+        n.L = n.H = n.G = n.Prec = n.Utotold = n.Uerr = 0.0;
+
+        if (n.liqWE > snliqfrac * n.iceWE) {
+            if (n.liqWE != n.snWE) {
+                n.liqRoute = (n.liqWE - snliqfrac * n.iceWE);
+                n.liqWE = n.liqWE - n.liqRoute;
+                n.snWE = n.liqWE + n.iceWE;
+            }
+            else {
+                n.liqRoute = n.snWE;
+                n.liqWE = 0.0;
+                n.iceWE = 0.0;
+                n.snWE = 0.0;
+            }
+        }
+        if (n.liqWE < 0) {
+            n.liqWE = 0;
+            n.snWE = n.iceWE;
+        }
+
+        n.Utot = n.dUint = n.iceWE * rhoicekg * cpicekJ * n.snTempC
+                           + n.liqWE * rholiqkg * latFreezekJ;
+
+    } else {
+
+        n.phfOnOff = 1.0;
+        n.densityAge = (n.snWE * n.densityAge) / (n.snWE + mtoc * precip);
+
+        if (precip * snowFracCalc(n.airTemp, n.rHumidity) > 1e-3) {
+            n.crustAge = 0.0;
+        }
+
+        if (n.snTempC == 0.0) {
+            updateRipeSnowPack(n, precip);
+        }
+        else {
+            updateSolidSnowPack(n, precip);
+        }
+
+        n.snWE = n.iceWE + n.liqWE;// unit in meters here
+        n.snSub *= naughttocm;// m to cm
+        n.snEvap *= naughttocm;// m to cm
+
+        n.ETAge = 0.0;
+        n.L = latentHFCalc(n, resFactCalc(n));
+        n.Prec = precipitationHFCalc(n);
+
+        if ((n.snWE <= 5e-6) || (n.snTempC < -800.0)) {
+            n.liqRoute = 0.0;
+            n.snWE = 0.0;
+            n.iceWE = 0.0;
+            n.liqWE = 0.0;
+            n.Utot = 0.0;
+            n.Usn = 0.0;
+            n.Uwat = 0.0;
+            n.snTempC = 0.0;
+            n.crustAge = 0.0;
+            n.densityAge = 0.0;
+            n.Uerr = 0.0;
+        } else {
+
+            n.Utot = n.Utotold = n.iceWE * rhoicekg * cpicekJ * n.snTempC + n.liqWE * rholiqkg *
+                                                                            latFreezekJ;
+            n.albedo = agingAlbedo(n);
+
+            snowEB(n);
+
+            n.Uerr = (n.Utot - n.Utotold) - n.dUint;
+
+            if (n.Utot < 0.0) { //frozen pack -- change temperature
+                n.Usn = n.Utot;
+                n.Uwat = 0.0;
+                n.liqWatCont = 0.0;
+                n.liqWE = 0.0;
+                n.liqTempC = 0.0;
+
+                n.iceWE = n.snWE;
+
+                if (n.iceWE < 0.1 && n.iceWE > 0) {
+                    n.iceTempC = n.Usn / (cpicekJ * rhoicekg * 0.1);
+                } else {
+                    n.iceTempC = n.Usn / (cpicekJ * rhoicekg * n.snWE);
+                }
+
+                if (n.iceTempC <= minSnTemp) {
+                    n.iceTempC = minSnTemp;
+                }
+
+                n.snTempC = n.iceTempC;
+
+            }//end -- frozen pack
+
+            else {//melt
+                n.Uwat = n.Utot;
+                n.Usn = 0.0;
+
+                n.liqWE = n.Uwat / (latFreezekJ * rholiqkg);
+
+                if (n.liqWE >= n.snWE) {
+                    n.liqWE = n.snWE;
+                }
+                n.iceWE = n.snWE - n.liqWE;
+
+                if (n.liqWE > snliqfrac * n.iceWE) {
+                    if (n.liqWE != n.snWE) {
+                        n.liqRoute = (n.liqWE - snliqfrac * n.iceWE);
+                        n.liqWE = n.liqWE - n.liqRoute;
+                        n.snWE = n.liqWE + n.iceWE;
+                    }
+                    else {
+                        n.liqRoute = n.snWE;
+                        n.liqWE = 0.0;
+                        n.iceWE = 0.0;
+                        n.snWE = 0.0;
+                    }
+                }
+                n.snTempC = 0.0;
+                n.iceTempC = 0.0;
+                n.liqTempC = 0.0;
+            }//end -- melt
+        }
+    }
+
+    //make sure that we still have snow
+    if (n.snWE <= 5e-6) {
+        n.liqRoute += n.snWE;
+        n.snWE = 0.0;
+        n.liqWE = 0.0;
+        n.iceWE = 0.0;
+        n.crustAge = 0.0;
+        n.densityAge = 0.0;
+        n.Utot = 0.0;
+        n.Usn = 0.0;
+        n.Uwat = 0.0;
+    } else {
+        n.crustAge += timeSteph;
+        n.densityAge += timeSteph;
+        n.snOnOff = 1.0;
+    }
+
+    n.snWE = naughttocm * n.snWE; // m to cm
+    n.iceWE = naughttocm * n.iceWE; // m to cm
+    n.liqWE = naughttocm * n.liqWE; // m to cm
+    n.liqRoute = naughttocm * n.liqRoute; // m to cm
+}
+
+//---------------------------------------------------------------------------
+//
+//			tSnowPack::canopyStep()
+//
+//	Snow in the canopy of the node 'n' when it is snowing or there is snow
+//	in the canopy, as callSnowIntercept(): interception, sublimation and
+//	unloading (Liston and Elder, 2006). Sets the net precipitation n.precip
+//	(mm) to the throughfall and unloaded snow scaled by the vegetation
+//	fraction plus the rain on the rest of the cell.
+//
+//---------------------------------------------------------------------------
+
+void tSnowPack::canopyStep(tSnowNode &n) const {
+    double subFrac, unlFrac, Isnow, throughfall;
+    double precip = n.rain;
+    int flag = 1;
+
+    //Note no actual unit conversion is necessary from mm to kg/m^2
+    //Here mm values (i.e. canopy storage, precip) are assumed to be converted to kg/m^2
+
+    //Add CanStorage to I_old, the node canopy storage is reset to zero
+    //by scatterSnowNode
+    if (n.canStorage > 1e-5) {
+        n.Iold += n.canStorage; //CanStorage has been scaled by coeffV, through scaling of precip
+        flag = 0; // WR refactor, initial setup did not compute Qcs and Lm on first event of snow
+    }
+
+    //maximum mass of snow stored in canopy (kg/m^2)
+    n.Imax = 4.4 * n.coeffLAI;
+
+    //compute new intercepted snow (kg/m^2)
+    Isnow = 0.7 * (n.Imax - n.Iold) * (1 - exp(-precip / n.Imax));
+    n.I = n.Iold + Isnow;
+
+    //precip minus intercepted snow (i.e. throughfall)
+    throughfall = precip - Isnow;
+
+    //if there was old snow, sublimate and unload
+    if (n.Iold > 0.0 && flag) {
+        n.Qcs = computeSub(n);
+        n.Lm = computeUnload(n);
+    } else {
+        n.Qcs = 0.0;//sublimation term
+        n.Lm = 0.0;//unloading term
+    }
+
+    n.I += n.Qcs - n.Lm; //I == interception (kg), Qcs == sublimation (kg) (sign computed), Lm == unloading (computed positive) (kg)
+
+    // SKY2008Snow based on AJR2008's recommendation starts here (water balance now preserved)
+    if (n.I < 0.0) {
+
+        if (n.Qcs < 0.0) {
+            subFrac = fabs(n.Qcs) / (fabs(n.Qcs) + n.Lm);
+            unlFrac = n.Lm / (fabs(n.Qcs) + n.Lm);
+        } else {
+            subFrac = 0.0;
+            unlFrac = 1.0;
+        }
+        n.Qcs -= n.I * subFrac;
+        n.Lm += n.I * unlFrac;
+        n.I = 0.0;
+    }
+
+    // Fluxes of the entire cell (scaled by veg fraction), set to the node
+    // by scatterSnowNode; note mm and kg/m^2 requires no conversion
+    n.snCanWE = naughttocm * (1 / rholiqkg) * n.I; //units in cm
+    n.snUnload = naughttocm * (1 / rholiqkg) * n.Lm * n.coeffV; //units in cm
+    n.intSub = naughttocm * (1 / rholiqkg) * n.Qcs * n.coeffV;
+    n.intPrec = Isnow * (1 / rholiqkg) * naughttocm;
+    n.netPrecip = (throughfall * n.coeffV) + (n.rain * (1 - n.coeffV));
+
+    // Throughfall + unloaded snow (so scaled by coeffV) and precipitation
+    // that falls on the no vegetated fraction of the cell (1-coeffV)
+    n.precip = n.netPrecip + n.snUnload * ctom; // units in mm
+}
+
+/*****************************************************************************
+**
+**			  tSnowPack I/O Functions
+**
+**	This set of functions deal with the I/O of tSnowPack that is not already
+**	derived from tEvapoTrans.
+**
+*****************************************************************************/
+
+int tSnowPack::getSnowOpt() {
+    return snowOption; //found in tEvapoTrans construction
+}
+
+
+/*****************************************************************************
+**
+**			  tSnowPack Conversion Functions
+**
+**	This set of functions deal with the I/O of tSnowPack that is not already
+**	derived from tEvapoTrans.
+**
+*****************************************************************************/
+
+//---------------------------------------------------------------------------
+//
+//				tSnowPack::CtoK()
+//	
+//	Convert Celsius to Kelvin
+//	
+//---------------------------------------------------------------------------
+
+double tSnowPack::CtoK(double temperature) const {
+
+    return (temperature + 273.15);
+
+}
+
+//---------------------------------------------------------------------------
+//
+//				tSnowPack::KtoC()
+//
+//	Convert Kelvin to Celsius
+//---------------------------------------------------------------------------
+
+double tSnowPack::KtoC(double temperature) const {
+
+    return (temperature - 273.15);
+
+}
+
+/***************************************************************************
+**
+** tSnowPack::writeRestart() Function
+**
+** Called from tSimulator during simulation loop
+**
+***************************************************************************/
+void tSnowPack::writeRestart(fstream &rStr) const {
+    BinaryWrite(rStr, hillAlbedoOption);
+    BinaryWrite(rStr, densityAge);
+    BinaryWrite(rStr, rainTemp);
+    BinaryWrite(rStr, ETAge);
+
+    BinaryWrite(rStr, timeSteph);
+    BinaryWrite(rStr, timeSteps);
+    BinaryWrite(rStr, timeStepm);
+    BinaryWrite(rStr, minutelyTimeStep);
+
+    BinaryWrite(rStr, liqWE);
+    BinaryWrite(rStr, iceWE);
+    BinaryWrite(rStr, snWE);
+    BinaryWrite(rStr, canWE);
+    BinaryWrite(rStr, liqRoute);
+    BinaryWrite(rStr, liqWEm);
+    BinaryWrite(rStr, iceWEm);
+    BinaryWrite(rStr, snWEm);
+    BinaryWrite(rStr, Utot);
+    BinaryWrite(rStr, Usn);
+    BinaryWrite(rStr, Uwat);
+    BinaryWrite(rStr, Utotold);
+    BinaryWrite(rStr, liqWatCont);
+    BinaryWrite(rStr, liqTempC);
+    BinaryWrite(rStr, iceTempC);
+    BinaryWrite(rStr, snTempC);
+    BinaryWrite(rStr, liqTempK);
+    BinaryWrite(rStr, iceTempK);
+    BinaryWrite(rStr, snTempK);
+    BinaryWrite(rStr, crustAge);
+
+    BinaryWrite(rStr, H);
+    BinaryWrite(rStr, L);
+    BinaryWrite(rStr, G);
+    BinaryWrite(rStr, Prec);
+    BinaryWrite(rStr, Rn);
+    BinaryWrite(rStr, dUint);
+    BinaryWrite(rStr, RLin);
+    BinaryWrite(rStr, RLout);
+    BinaryWrite(rStr, RSin);
+    BinaryWrite(rStr, Uerr);
+    BinaryWrite(rStr, snPrec);
+    BinaryWrite(rStr, liqPrec);
+    BinaryWrite(rStr, snPrecm);
+    BinaryWrite(rStr, liqPrecm);
+    BinaryWrite(rStr, snPrecmm);
+    BinaryWrite(rStr, liqPrecmm);
+    BinaryWrite(rStr, snUnload);
+    BinaryWrite(rStr, snCanWE);
+    BinaryWrite(rStr, vapPressSmb);
+    BinaryWrite(rStr, vapPresskSPa);
+
+    BinaryWrite(rStr, rholiqcgs);
+    BinaryWrite(rStr, rhoicecgs);
+    BinaryWrite(rStr, rhosncgs);
+    BinaryWrite(rStr, rholiqkg);
+    BinaryWrite(rStr, rhoicekg);
+    BinaryWrite(rStr, rhosnkg);
+    BinaryWrite(rStr, rhoAir);
+    BinaryWrite(rStr, phfOnOff);
+
+    BinaryWrite(rStr, cpsnowkJ);
+    BinaryWrite(rStr, cpicekJ);
+    BinaryWrite(rStr, cpwaterkJ);
+    BinaryWrite(rStr, cpairkJ);
+    BinaryWrite(rStr, latFreezekJ);
+    BinaryWrite(rStr, latVapkJ);
+    BinaryWrite(rStr, latSubkJ);
+
+    BinaryWrite(rStr, resFact);
+    BinaryWrite(rStr, albedo);
+    BinaryWrite(rStr, hillalbedo);
+    BinaryWrite(rStr, compactParam);
+    BinaryWrite(rStr, rhoSnFreshkg);
+    BinaryWrite(rStr, minSnTemp);
+
+    BinaryWrite(rStr, snDepth);
+    BinaryWrite(rStr, snDepthm);
+    BinaryWrite(rStr, snOnOff);
+    BinaryWrite(rStr, peakSnWE);
+    BinaryWrite(rStr, peakSnWEtemp);
+    BinaryWrite(rStr, persMax);
+    BinaryWrite(rStr, persMaxtemp);
+    BinaryWrite(rStr, inittime);
+    BinaryWrite(rStr, inittimeTemp);
+    BinaryWrite(rStr, peaktime);
+
+    BinaryWrite(rStr, naughttokilo);
+    BinaryWrite(rStr, kilotonaught);
+    BinaryWrite(rStr, cgsRHOtomks);
+    BinaryWrite(rStr, mksRHOtocgs);
+    BinaryWrite(rStr, naughttocm);
+    BinaryWrite(rStr, cmtonaught);
+    BinaryWrite(rStr, ctom);
+    BinaryWrite(rStr, mtoc);
+
+    BinaryWrite(rStr, Qcs);
+    BinaryWrite(rStr, Ce);
+    BinaryWrite(rStr, I);
+    BinaryWrite(rStr, Iold);
+    BinaryWrite(rStr, psiS);
+    BinaryWrite(rStr, Imax);
+    BinaryWrite(rStr, prec);
+    BinaryWrite(rStr, LAI);
+    BinaryWrite(rStr, kc);
+    BinaryWrite(rStr, iceRad);
+    BinaryWrite(rStr, dmdt);
+    BinaryWrite(rStr, Omega);
+    BinaryWrite(rStr, Sp);
+    BinaryWrite(rStr, RH);
+    BinaryWrite(rStr, D);
+    BinaryWrite(rStr, rhoVap);
+    BinaryWrite(rStr, Sh);
+    BinaryWrite(rStr, Nu);
+    BinaryWrite(rStr, Re);
+    BinaryWrite(rStr, KtAtm);
+    BinaryWrite(rStr, Ta);
+    BinaryWrite(rStr, Mwater);
+    BinaryWrite(rStr, R);
+    BinaryWrite(rStr, RdryAir);
+    BinaryWrite(rStr, esatIce);
+    BinaryWrite(rStr, nu);
+    BinaryWrite(rStr, beta);
+    BinaryWrite(rStr, acoefficient);
+    BinaryWrite(rStr, Lm);
+    BinaryWrite(rStr, airTempK);
+    BinaryWrite(rStr, effPrecip);
+
+    tEvapoTrans::writeRestart(rStr);
+}
+
+/***************************************************************************
+**
+** tSnowPack::readRestart() Function
+**
+***************************************************************************/
+void tSnowPack::readRestart(fstream &rStr) {
+    BinaryRead(rStr, hillAlbedoOption);
+    BinaryRead(rStr, densityAge);
+    BinaryRead(rStr, rainTemp);
+    BinaryRead(rStr, ETAge);
+
+    BinaryRead(rStr, timeSteph);
+    BinaryRead(rStr, timeSteps);
+    BinaryRead(rStr, timeStepm);
+    BinaryRead(rStr, minutelyTimeStep);
+
+    BinaryRead(rStr, liqWE);
+    BinaryRead(rStr, iceWE);
+    BinaryRead(rStr, snWE);
+    BinaryRead(rStr, canWE);
+    BinaryRead(rStr, liqRoute);
+    BinaryRead(rStr, liqWEm);
+    BinaryRead(rStr, iceWEm);
+    BinaryRead(rStr, snWEm);
+    BinaryRead(rStr, Utot);
+    BinaryRead(rStr, Usn);
     BinaryRead(rStr, Uwat);
     BinaryRead(rStr, Utotold);
     BinaryRead(rStr, liqWatCont);
@@ -2328,62 +3484,7 @@ void tSnowPack::readRestart(fstream &rStr) {
 
 void tSnowPack::checkShelter(tCNode *cNode) {
     if ((shelterOption > 0) && (shelterOption < 4)) {//CHANGED 2008
-        int tempIndex;
-        for (tempIndex = 0; tempIndex < 16; tempIndex++) {
-            switch (tempIndex) {
-                case 0:
-                    ha2700 = cNode->getHorAngle2700();
-                    break;
-                case 1:
-                    ha2925 = cNode->getHorAngle2925();
-                    break;
-                case 2:
-                    ha3150 = cNode->getHorAngle3150();
-                    break;
-                case 3:
-                    ha3375 = cNode->getHorAngle3375();
-                    break;
-                case 4:
-                    ha0000 = cNode->getHorAngle0000();
-                    break;
-                case 5:
-                    ha0225 = cNode->getHorAngle0225();
-                    break;
-                case 6:
-                    ha0450 = cNode->getHorAngle0450();
-                    break;
-                case 7:
-                    ha0675 = cNode->getHorAngle0675();
-                    break;
-                case 8:
-                    ha0900 = cNode->getHorAngle0900();
-                    break;
-                case 9:
-                    ha1125 = cNode->getHorAngle1125();
-                    break;
-                case 10:
-                    ha1350 = cNode->getHorAngle1350();
-                    break;
-                case 11:
-                    ha1575 = cNode->getHorAngle1575();
-                    break;
-                case 12:
-                    ha1800 = cNode->getHorAngle1800();
-                    break;
-                case 13:
-                    ha2025 = cNode->getHorAngle2025();
-                    break;
-                case 14:
-                    ha2250 = cNode->getHorAngle2250();
-                    break;
-                case 15:
-                    ha2475 = cNode->getHorAngle2475();
-                    break;
-                default:
-                    cout << "\nCheck tempInd -- did not exist or assign" << endl;
-            }//end-switch
-        }    //end-for
-
+        // Horizon angles are looked up in 'solar' (tSolarGeometry)
         shelterFactorGlobal = cNode->getSheltFact(); //computed in tShelter
 
     } else if (shelterOption == 0) { // local sheltering for factor only
@@ -65,6 +65,48 @@
 #include "src/Headers/Inclusions.h"
 #include "src/tHydro/tEvapoTrans.h"
 
+#include <vector>
+
+// Canopy snow and snowpack of one node for snowStep() (SNOWKERNEL = 1): the
+// forcing and land cover values, the radiation terms before the albedo, the
+// state from the node and the results of the time step. Gathered by
+// gatherSnowNode() in the node loop of callSnowPack, set back to the node by
+// scatterSnowNode().
+struct tSnowNode
+{
+  int ID;
+  int eb;   // 1 if the energy balance was computed (snowEB)
+  int canopy;   // 1 if the snow in the canopy is updated (canopyStep)
+
+  // Forcing and land cover
+  double airTemp, rHumidity, vPress, atmPress, windSpeed, rain;
+  double precip, snUnload, snCanWE;
+  double coeffH, coeffV, coeffLAI, coeffKt, coeffAl;
+  double slope, shelterFactorGlobal;
+
+  // Snow in the canopy [kg m^-2] and its fluxes to the node
+  double canStorage, rHumidityC, Iold, I, Imax, Qcs, Lm;
+  double intSub, intPrec, netPrecip;
+
+  // Radiation: incoming longwave [W m^-2], observed shortwave and the
+  // terms of inShortWaveSn before the reflection from the hills
+  double longIn, inShortR;
+  int sun;  // alphaD > 0
+  double Ics, Ids, Is, SunHour, landRefGlobal, hillalbedo, Ir, Isw;
+
+  // State
+  double liqWE, iceWE, snWE, snTempC, iceTempC, liqTempC;
+  double crustAge, densityAge, ETAge, albedo;
+  double persMax, persMaxtemp, peakSnWE, peakSnWEtemp;
+  double inittime, inittimeTemp, peaktime;
+
+  // Mass and energy of the step
+  double snSub, snEvap, liqRoute, snDepthm, phfOnOff, snOnOff;
+  double Utot, Usn, Uwat, Utotold, Uerr, dUint, liqWatCont;
+  double resFact, snTempK, H, L, G, Prec, Rn, RSin, RLin, RLout;
+  double snPrec, liqPrec;
+};
+
 
 
 //=========================================================================
@@ -96,7 +138,7 @@ public:
 
   //calling functions
   void callSnowPack(tIntercept *, int);
-  void callSnowIntercept(tCNode *, tIntercept *,int count);
+  int callSnowIntercept(tCNode *, tIntercept *,int count, int kernel = 0);
 
   //initialization, interact w/ tCNode
   void getFrNodeSnP(tCNode *);
@@ -120,15 +162,34 @@ public:
   double resFactCalc();
   double inShortWaveSn(tCNode *);
   double inShortWaveCan();
-  double emmisSn();
+  double emmisSn() const;
 
   
   //EB function
   void snowEB(int, tCNode *); // AJR2008, SKY2008Snow
 
+  //canopy snow and snowpack of a tSnowNode (SNOWKERNEL = 1), see snowStep()
+  void gatherSnowNode(tCNode *, int, tSnowNode &);
+  void scatterSnowNode(tCNode *, const tSnowNode &);
+  void shortWaveTermsSn(tCNode *, tSnowNode &);
+  void snowStep(tSnowNode &) const;
+  void canopyStep(tSnowNode &) const;
+  void snowEB(tSnowNode &) const;
+  void updateRipeSnowPack(tSnowNode &, double) const;
+  void updateSolidSnowPack(tSnowNode &, double) const;
+  double latentHFCalc(const tSnowNode &, double) const;
+  double sensibleHFCalc(const tSnowNode &, double) const;
+  double snowFracCalc(double, double) const;
+  double precipitationHFCalc(tSnowNode &) const;
+  double agingAlbedo(const tSnowNode &) const;
+  double resFactCalc(const tSnowNode &) const;
+  double inShortWaveSn(tSnowNode &) const;
+  double computeSub(const tSnowNode &) const;
+  double computeUnload(const tSnowNode &) const;
+
   //conversion functions
-  double CtoK(double);
-  double KtoC(double);
+  double CtoK(double) const;
+  double KtoC(double) const;
   
   //communication functions
   int getSnowOpt();
@@ -200,6 +261,11 @@ protected:
   double minSnTemp;
   double snliqfrac; // Added by CJC2020
 
+  //snowpacks of the nodes with snow in a time step (SNOWKERNEL)
+  int snowKernelOption; // 0 - node by node in callSnowPack, 1 - on the threads (snowStep)
+  std::vector<tSnowNode> snowNodes;
+  std::vector<tCNode *> snowPackNodes;
+
   //output variables
   double snDepth,snDepthm; //snow depths (cm,m)
   double snOnOff;
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tSolarGeometry.cpp:   Functions for class tSolarGeometry
+**                        (see tSolarGeometry.h)
+**
+***************************************************************************/
+
+#include "src/tHydro/tSolarGeometry.h"
+#include "src/Headers/Inclusions.h"
+#include "src/tThreadPool/tThreadPool.h"
+
+// Horizon angle getters of tCNode by sector, in steps of 22.5 degrees
+static double (tCNode::*getHorAngle[kHorizonSectors])() = {
+  &tCNode::getHorAngle0000, &tCNode::getHorAngle0225,
+  &tCNode::getHorAngle0450, &tCNode::getHorAngle0675,
+  &tCNode::getHorAngle0900, &tCNode::getHorAngle1125,
+  &tCNode::getHorAngle1350, &tCNode::getHorAngle1575,
+  &tCNode::getHorAngle1800, &tCNode::getHorAngle2025,
+  &tCNode::getHorAngle2250, &tCNode::getHorAngle2475,
+  &tCNode::getHorAngle2700, &tCNode::getHorAngle2925,
+  &tCNode::getHorAngle3150, &tCNode::getHorAngle3375
+};
+
+tSolarGeometry::tSolarGeometry()
+  : nNodes(0), useHorizons(0), sector(0), diffuse(0.0)
+{}
+
+/***************************************************************************
+**
+**  tSolarGeometry::initialize(tMesh<tCNode> *gridPtr, int horizons)
+**
+**  Slope and aspect are taken as in tEvapoTrans (flow edge slope, aspect
+**  from tEvapoTrans::DeriveAspect), the horizon angles as set by tShelter
+**
+***************************************************************************/
+void tSolarGeometry::initialize(tMesh<tCNode> *gridPtr, int horizons)
+{
+	double slope, aspect, ha;
+
+	nNodes = gridPtr->getNumActiveNodes();
+	useHorizons = horizons;
+
+	cosSlope.resize(nNodes);
+	sinSlopeCos.resize(nNodes);
+	sinSlopeSin.resize(nNodes);
+	pressure.resize(nNodes);
+	horizon.assign(useHorizons ? (size_t)kHorizonSectors*nNodes : 0, 0.0);
+
+	for (int i = 0; i < nNodes; i++) {
+		tCNode *cNode = gridPtr->getActiveNode(i);
+
+		slope = fabs(atan(cNode->getFlowEdg()->getSlope()));
+		aspect = cNode->getAspect();
+		cosSlope[i] = cos(slope);
+		sinSlopeCos[i] = sin(slope)*cos(aspect);
+		sinSlopeSin[i] = sin(slope)*sin(aspect);
+		pressure[i] = exp(-cNode->getZ()/8434.5);
+
+		if (useHorizons) {
+			for (int s = 0; s < kHorizonSectors; s++) {
+				ha = (cNode->*getHorAngle[s])();
+				horizon[(size_t)s*nNodes + i] = (ha)*(180/3.1416);
+			}
+		}
+	}
+
+	beam.assign(nNodes, 0.0);
+	cosi.assign(nNodes, 0.0);
+	visible.assign(nNodes, 1);
+	return;
+}
+
+/***************************************************************************
+**
+**  tSolarGeometry::setSun()
+**
+**  Evaluates the radiation terms of all nodes for the current sun
+**  position. The beam and diffuse irradiances follow
+**  tEvapoTrans::DirectDiffuse; the incidence angle is
+**
+**    cos(i) = cos(slope)*sin(alpha)
+**             + sin(slope)*cos(alpha)*cos(sunaz - aspect)
+**
+**  with cos(sunaz - aspect) expanded so that only the sun terms change.
+**  The horizon sector faces the sun: the sectors of tShelter start at
+**  South (0) and go through West (90), the sun azimuth starts at North.
+**
+***************************************************************************/
+void tSolarGeometry::setSun(double sinAlpha, double alphaD, double sunaz,
+							double Io, double Tlinke)
+{
+	double pi = 4.0*atan(1.0);
+	double h0, Dh0ref, h0ref, airMass;
+	double TnTLK, Fdh0, A1p, A1, A2, A3;
+	double cosAlpha, sunCos, sunSin;
+
+	// Horizon sector closest to the sun azimuth
+	double az = sunaz*180.0/pi - 180.0;
+	sector = int(floor(az/22.5 + 0.5)) % kHorizonSectors;
+	if (sector < 0)
+		sector += kHorizonSectors;
+
+	// Below the horizon, tEvapoTrans does not use the terms
+	if (alphaD <= 0.0 || nNodes == 0)
+		return;
+
+	// Relative optical air mass without the elevation correction
+	h0 = alphaD;
+	Dh0ref = 0.061359*(0.1594+1.123*h0+0.065656*h0*h0)/(1+28.9344*h0+277.3971*h0*h0);
+	h0ref = h0 + Dh0ref;
+	airMass = sin(h0ref*pi/180.)+0.50572*pow((h0ref+6.07995),-1.6364);
+
+	// Diffuse radiation on horizontal surface [W m^-2]
+	TnTLK = -0.015843 + 0.030543*Tlinke + 0.0003797*pow(Tlinke,2.0);
+	A1p = 0.26463 - 0.061581*Tlinke + 0.0031408*pow(Tlinke,2.0);
+	if (A1p*TnTLK < 0.0022)
+		A1 = 0.0022/TnTLK;
+	else
+		A1 = A1p;
+	A2 = 2.04020 + 0.018945*Tlinke - 0.011161*pow(Tlinke,2.0);
+	A3 = -1.3025 + 0.039231*Tlinke + 0.0085079*pow(Tlinke,2.0);
+	Fdh0 = A1 + A2*sinAlpha + A3*pow(sinAlpha,2.0);
+	diffuse = Io*TnTLK*Fdh0;
+
+	cosAlpha = cos(asin(sinAlpha));
+	sunCos = cosAlpha*cos(sunaz);
+	sunSin = cosAlpha*sin(sunaz);
+	const double *ha = useHorizons ? &horizon[(size_t)sector*nNodes] : nullptr;
+
+	tThreadPool::parallelFor(0, nNodes, [&](int first, int last, int) {
+		for (int i = first; i < last; i++) {
+			double m = pressure[i]/airMass;
+			double drm;
+			if (m <= 20.0)
+				drm = 1/(6.6296+1.7513*m-0.1202*m*m+0.0065*pow(m,3.0)-0.00013*pow(m,4.0));
+			else
+				drm = 1/(10.4 + 0.718*m);
+			beam[i] = Io*exp(-0.8662*Tlinke*m*drm);
+		}
+		for (int i = first; i < last; i++)
+			cosi[i] = cosSlope[i]*sinAlpha + sinSlopeCos[i]*sunCos
+				+ sinSlopeSin[i]*sunSin;
+		if (ha) {
+			for (int i = first; i < last; i++)
+				visible[i] = (ha[i] < alphaD);
+		}
+	});
+	return;
+}
+
+//=========================================================================
+//
+//
+//                       End of tSolarGeometry.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tSolarGeometry.h:   Header file for tSolarGeometry Class
+**
+**  tSolarGeometry holds the terrain terms of the shortwave radiation of
+**  tEvapoTrans that do not change during a run, one entry per active node
+**  (in the order of tMesh::getActiveNode):
+**
+**    cos(slope), sin(slope)*cos(aspect), sin(slope)*sin(aspect)
+**    the pressure correction of the optical air mass, exp(-z/8434.5)
+**    the 16 horizon angles of tShelter (degrees), by sector
+**
+**  Once per time step, setSun() takes the sun position of
+**  tEvapoTrans::SetSunVariables and evaluates, for all nodes in one pass,
+**  the clear sky beam irradiance (as tEvapoTrans::DirectDiffuse), the
+**  cosine of the incidence angle on the slope and whether the sun is
+**  above the horizon of the node. The diffuse irradiance on a horizontal
+**  surface does not depend on the node and is computed once.
+**
+***************************************************************************/
+
+#ifndef TSOLARGEOMETRY_H
+#define TSOLARGEOMETRY_H
+
+#include "src/Headers/Classes.h"
+
+#include <vector>
+
+#define kHorizonSectors 16  // Horizon angles stored in tCNode
+
+//=========================================================================
+//
+//
+//            Section 1: tSolarGeometry Class Declaration
+//
+//
+//=========================================================================
+
+class tSolarGeometry
+{
+ public:
+  tSolarGeometry();
+
+  // Terrain terms of the active nodes, 'horizons' if sheltering uses them
+  void initialize(tMesh<tCNode> *, int horizons);
+  int  isInitialized() const { return nNodes > 0; }
+
+  // Sun altitude (sin and degrees), azimuth (rad from North), Io, Tlinke
+  void setSun(double sinAlpha, double alphaD, double sunaz,
+              double Io, double Tlinke);
+
+  double getBeam(int i) const { return beam[i]; }         // Ic
+  double getDiffuse() const { return diffuse; }            // Id
+  double getCosIncidence(int i) const { return cosi[i]; }  // cos(i)
+  double getCosSlope(int i) const { return cosSlope[i]; }
+  int    isAboveHorizon(int i) const { return visible[i]; }
+  int    getSunSector() const { return sector; }
+
+ private:
+  int nNodes;              // Active nodes
+  int useHorizons;         // Horizon angles are checked
+  int sector;              // Horizon sector of the sun in the current step
+
+  std::vector<double> cosSlope;      // cos(slope)
+  std::vector<double> sinSlopeCos;   // sin(slope)*cos(aspect)
+  std::vector<double> sinSlopeSin;   // sin(slope)*sin(aspect)
+  std::vector<double> pressure;      // exp(-z/8434.5)
+  std::vector<double> horizon;       // Degrees, sector by sector
+
+  std::vector<double> beam;          // Ic of each node, current step
+  std::vector<double> cosi;          // cos(i) of each node, current step
+  std::vector<char>   visible;       // Sun above the horizon, current step
+  double diffuse;                    // Id, current step
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                       End of tSolarGeometry.h
+//
+//
+//=========================================================================
@@ -17,6 +17,7 @@
 #include "src/tInOut/tOutput.h"
 #include "src/Headers/globalIO.h"
 #include "src/Headers/Inclusions.h"
+#include "src/tThreadPool/tThreadPool.h"
 
 #ifdef PARALLEL_TRIBS
 #include "src/tGraph/tGraph.h"
@@ -824,6 +825,9 @@ tCOutput<tSubNode>::tCOutput(SimulationControl *simCtrPtr, tMesh<tSubNode> *g,
 	this->CreateAndOpenFile( &drareaofs, drarsext );
 	this->CreateAndOpenFile( &widthsofs, widthsext );
 	
+	// Variables of the visualization files
+	dynSnap = (this->vizOption == 1) ? new tSnapshot(infile) : NULL;
+	
 	WriteNodeData( 0, resamp );
 }
 
@@ -833,6 +837,7 @@ tCOutput<tSubNode>::tCOutput(SimulationControl *simCtrPtr, tMesh<tSubNode> *g,
 : tOutput<tSubNode>(simCtrPtr, g, infile, resamp, this->timptr)
 {   
 	char vorofsext[10] = "_voi";
+	dynSnap = NULL;
 	this->CreateAndOpenFile( &vorofs, vorofsext);
 }
 
@@ -851,10 +856,30 @@ tCOutput<tSubNode>::~tCOutput()
 		delete [] Outlets; 
 		delete [] outletinfo; 
 	}       
+	delete dynSnap;
 
     Cout<<"tCOutput Object has been destroyed..."<<endl<<flush;
 }
 
+/*************************************************************************
+**
+**  tCOutput::CloseOutletFiles()
+**
+**  Closes the files of the interior outlets, for a run that ends without
+**  deleting this object (see Simulator::RunEnsemble). They are opened 
+**  again by UpdateForNewRun().
+**
+*************************************************************************/
+template< class tSubNode >
+void tCOutput<tSubNode>::CloseOutletFiles()
+{
+	for (int j=0; j < numOutlets; j++) 
+#ifdef PARALLEL_TRIBS
+    if ( (Outlets[j] != NULL) && (OutletList[j] > 0) )
+#endif
+		outletinfo[j].close(); 
+}
+
 /*************************************************************************
 **
 **  tCOutput::WriteNodeData()
@@ -1237,9 +1262,6 @@ void tCOutput<tSubNode>::WritePixelInfo( double time )
 template< class tSubNode >
 void tCOutput<tSubNode>::WriteDynamicVars( double time )
 {
-	tSubNode *cn;
-	tMeshListIter<tSubNode> ni( this->g->getNodeList() );
-	
 #ifdef PARALLEL_TRIBS
    int nActiveNodes = this->g->getNodeList()->getGlobalActiveSize();
 #else
@@ -1325,76 +1347,24 @@ void tCOutput<tSubNode>::WriteDynamicVars( double time )
     }
 
 	
-	cn = ni.FirstP();
-    while (ni.IsActive()) {
-
-    // --- START FIX ---
-    tEdge *flowEdge = cn->getFlowEdg();
-    double slope_rad = atan(flowEdge->getSlope());
-    double cos_slope = cos(slope_rad);
-    if (cos_slope < 1E-9) cos_slope = 1.E-9;
-    // --- END FIX ---
-        arcofs << cn->getID() << ',' // 1
-               << setprecision(5) << cn->getNwtNew() / cos_slope << ',' // 2
-               << setprecision(5) << cn->getMuNew() / cos_slope << ',' // 3
-               << setprecision(5) << cn->getMiNew() / cos_slope << ',' // 4
-               << setprecision(5) << cn->getNfNew() / cos_slope << ',' // 5
-               << setprecision(5) << cn->getNtNew() / cos_slope << ',' // 6
-               << setprecision(5) << cn->getQpout() * 1.E-6 / cn->getVArea() << ',' // 7
-               << cn->getQpin() * 1.E-6 / cn->getVArea() << ',' // 8
-               << setprecision(4) << cn->getSrf_Hr()  << ',' // 9 in mm (mm of runoff reset to 0 every hour)
-               << setprecision(3) << cn->getRain() << ',' // 10
-               << setprecision(3) << cn->getSnTempC() << ',' // 11
-               << setprecision(5) << cn->getIceWE() << ',' // 12 SWE = this column + next
-               << setprecision(5) << cn->getLiqWE() << ',' // 13
-               << setprecision(7) << cn->getSnSub()  << ',' // 14
-               << setprecision(7) << cn->getSnEvap() << ',' // 15
-               << setprecision(7) << cn->getLiqRouted() << ',' // 16
-               << setprecision(5) << cn->getUnode() << ',' // 17
-               << setprecision(5) << cn->getSnLHF() << ',' // 18
-               << setprecision(5) << cn->getSnSHF() << ',' // 19
-               << setprecision(5) << cn->getSnGHF() << ',' // 20
-               << setprecision(5) << cn->getSnPHF() << ',' // 21
-               << setprecision(5) << cn->getSnRLout() << ',' // 22
-               << setprecision(5) << cn->getSnRLin() << ',' // 23
-               << setprecision(5) << cn->getSnRSin() << ',' // 24
-               << setprecision(5) << cn->getUerror() << ',' // 25
-               << setprecision(5) << cn->getIntSWE() << ',' // 26
-               << setprecision(5) << cn->getIntSub() << ',' // 27
-               << setprecision(5) << cn->getIntSnUnload() << ',' // 28
-               << setprecision(3) << cn->getSoilMoistureSC() << ',' // 29
-               << setprecision(3) << cn->getRootMoistureSC() << ',' // 30
-               << setprecision(3) << cn->getCanStorage() << ',' // 31
-               << setprecision(3) << cn->getActEvap() << ',' // 32
-               << setprecision(5) << cn->getEvapSoil() << ',' // 33
-               << setprecision(5) << cn->getEvapoTrans() << ',' // 34
-               << setprecision(3) << cn->getGFlux() << ',' // 35
-               << setprecision(3) << cn->getHFlux() << ',' // 36
-               << setprecision(3) << cn->getLFlux() << ',' // 37
-               << setprecision(3) << cn->getQstrm() << ',' //  38
-               << setprecision(3) << cn->getHlevel() << ',' // 39
-               << setprecision(3) << cn->getFlowVelocity() << ',' // 40
-               << setprecision(5) << cn->getCanStorParam() << ',' // 41
-               << setprecision(5) << cn->getIntercepCoeff() << ',' // 42 , meaning of life?
-               << setprecision(5) << cn->getThroughFall() << ',' // 43
-               << setprecision(5) << cn->getCanFieldCap() << ',' // 44
-               << setprecision(5) << cn->getDrainCoeff() << ',' // 45
-               << setprecision(5) << cn->getDrainExpPar() << ',' // 46
-               << setprecision(5) << cn->getLandUseAlb() << ',' // 47
-               << setprecision(5) << cn->getVegHeight() << ',' // 48
-               << setprecision(5) << cn->getOptTransmCoeff() << ',' // 49
-               << setprecision(5) << cn->getStomRes() << ',' // 50
-               << setprecision(5) << cn->getVegFraction() << ',' // 51
-               << setprecision(5) << cn->getLeafAI(); // 52
-
-        if (time == 0)
-            arcofs << ',' << setprecision(0) << cn->getSoilID() << ','
-                   << setprecision(0) << cn->getLandUse() << endl;
-        else
-            arcofs << "\n";
-
-        cn = ni.NextP();
-    }
+	// Rows are formatted on NUMTHREADS threads, each a piece of the
+	// nodes, and written in node order, rowBlock nodes at a time
+	const int rowBlock = 16384;
+	const vector<tSubNode*> &nodes = this->g->getActiveNodes();
+	int nNodes = (int)nodes.size();
+	vector<string> rows(tThreadPool::getNumThreads());
+
+	for (int start = 0; start < nNodes; start += rowBlock) {
+		int stop = (start + rowBlock < nNodes) ? start + rowBlock : nNodes;
+		for (size_t t = 0; t < rows.size(); t++)
+			rows[t].clear();
+		tThreadPool::parallelFor(start, stop, [&](int first, int last, int t) {
+			for (int i = first; i < last; i++)
+				FormatDynamicRow(rows[t], nodes[i], time);
+		});
+		for (size_t t = 0; t < rows.size(); t++)
+			arcofs.write(rows[t].data(), rows[t].size());
+	}
     arcofs.close();
 
 
@@ -1411,113 +1381,119 @@ void tCOutput<tSubNode>::WriteDynamicVars( double time )
 	return;
 }
 
+/*************************************************************************
+**
+**  FormatDynamicRow( row, cn, time )
+**
+**  Appends the line of node cn to the *.HHHH_MMd file. Values are
+**  printed with %g and the precision of each column, as the stream
+**  does with setprecision(); the soil and land use IDs are added at
+**  time 0.
+**
+*************************************************************************/
+template< class tSubNode >
+void tCOutput<tSubNode>::FormatDynamicRow( string &row, tSubNode *cn,
+										   double time )
+{
+	char field[40];
+	int len;
+	auto put = [&](double value, int prec) {
+		len = snprintf(field, sizeof(field), ",%.*g", prec, value);
+		row.append(field, len);
+	};
+
+	tEdge *flowEdge = cn->getFlowEdg();
+	double slope_rad = atan(flowEdge->getSlope());
+	double cos_slope = cos(slope_rad);
+	if (cos_slope < 1E-9) cos_slope = 1.E-9;
+
+	len = snprintf(field, sizeof(field), "%d", cn->getID()); // 1
+	row.append(field, len);
+	put(cn->getNwtNew() / cos_slope, 5); // 2
+	put(cn->getMuNew() / cos_slope, 5); // 3
+	put(cn->getMiNew() / cos_slope, 5); // 4
+	put(cn->getNfNew() / cos_slope, 5); // 5
+	put(cn->getNtNew() / cos_slope, 5); // 6
+	put(cn->getQpout() * 1.E-6 / cn->getVArea(), 5); // 7
+	put(cn->getQpin() * 1.E-6 / cn->getVArea(), 5); // 8
+	put(cn->getSrf_Hr(), 4); // 9 in mm (mm of runoff reset to 0 every hour)
+	put(cn->getRain(), 3); // 10
+	put(cn->getSnTempC(), 3); // 11
+	put(cn->getIceWE(), 5); // 12 SWE = this column + next
+	put(cn->getLiqWE(), 5); // 13
+	put(cn->getSnSub(), 7); // 14
+	put(cn->getSnEvap(), 7); // 15
+	put(cn->getLiqRouted(), 7); // 16
+	put(cn->getUnode(), 5); // 17
+	put(cn->getSnLHF(), 5); // 18
+	put(cn->getSnSHF(), 5); // 19
+	put(cn->getSnGHF(), 5); // 20
+	put(cn->getSnPHF(), 5); // 21
+	put(cn->getSnRLout(), 5); // 22
+	put(cn->getSnRLin(), 5); // 23
+	put(cn->getSnRSin(), 5); // 24
+	put(cn->getUerror(), 5); // 25
+	put(cn->getIntSWE(), 5); // 26
+	put(cn->getIntSub(), 5); // 27
+	put(cn->getIntSnUnload(), 5); // 28
+	put(cn->getSoilMoistureSC(), 3); // 29
+	put(cn->getRootMoistureSC(), 3); // 30
+	put(cn->getCanStorage(), 3); // 31
+	put(cn->getActEvap(), 3); // 32
+	put(cn->getEvapSoil(), 5); // 33
+	put(cn->getEvapoTrans(), 5); // 34
+	put(cn->getGFlux(), 3); // 35
+	put(cn->getHFlux(), 3); // 36
+	put(cn->getLFlux(), 3); // 37
+	put(cn->getQstrm(), 3); // 38
+	put(cn->getHlevel(), 3); // 39
+	put(cn->getFlowVelocity(), 3); // 40
+	put(cn->getCanStorParam(), 5); // 41
+	put(cn->getIntercepCoeff(), 5); // 42
+	put(cn->getThroughFall(), 5); // 43
+	put(cn->getCanFieldCap(), 5); // 44
+	put(cn->getDrainCoeff(), 5); // 45
+	put(cn->getDrainExpPar(), 5); // 46
+	put(cn->getLandUseAlb(), 5); // 47
+	put(cn->getVegHeight(), 5); // 48
+	put(cn->getOptTransmCoeff(), 5); // 49
+	put(cn->getStomRes(), 5); // 50
+	put(cn->getVegFraction(), 5); // 51
+	put(cn->getLeafAI(), 5); // 52
+
+	if (time == 0) {
+		len = snprintf(field, sizeof(field), ",%d,%d",
+					   cn->getSoilID(), cn->getLandUse());
+		row.append(field, len);
+	}
+	row += '\n';
+}
+
+/*************************************************************************
+**
+**  WriteDynamicVarsBinary( double time )
+**
+**  Writes the *_dyn.HHHH visualization file: the selected variables of
+**  the active nodes (see tSnapshot), gathered in one pass over the nodes
+**  and written one column after the other
+**
+*************************************************************************/
 template< class tSubNode >
 void tCOutput<tSubNode>::WriteDynamicVarsBinary( double time )
 {
-	tSubNode* cn;
-	tMeshListIter<tCNode> niter(this->g->getNodeList());
 	int hour = (int)floor(time);
-    int nActiveNodes = this->g->getNodeList()->getActiveSize(); // Get number of nodes for array sizing
-
-    // Create temporary arrays to hold the corrected vertical depths for all nodes.
-    float* nwt_vert = new float[nActiveNodes];
-    float* nf_vert = new float[nActiveNodes];
-    float* nt_vert = new float[nActiveNodes];
-    float* mu_vert = new float[nActiveNodes];
-
-    // Loop through the nodes once to populate all temporary arrays.
-    int i = 0;
-    for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP(), i++) {
-        // Calculate cos_slope just once per node in this single loop.
-        tEdge *flowEdge = cn->getFlowEdg();
-        double slope_rad = atan(flowEdge->getSlope());
-        double cos_slope = cos(slope_rad);
-        if (cos_slope < 1E-9) cos_slope = 1.E-9;
-
-        // Apply correction and store in the corresponding temporary array.
-        nwt_vert[i] = (float)(cn->getNwtNew() / cos_slope);
-        nf_vert[i]  = (float)(cn->getNfNew()  / cos_slope);
-        nt_vert[i]  = (float)(cn->getNtNew()  / cos_slope);
-        mu_vert[i]  = (float)(cn->getMuNew()  / cos_slope);
-    }
-
 	char extension[20];
-	snprintf(extension,sizeof(extension), "_dyn.%04d", hour);
-
 	ofstream ostr;
-	this->CreateAndOpenVizFile(&ostr, extension);
 
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) nwt_vert[i]);
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) nf_vert[i]);
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) nt_vert[i]);
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) mu_vert[i]);
-
-    // 4. Clean up the memory allocated for the temporary arrays.
-    delete[] nwt_vert;
-    delete[] nf_vert;
-    delete[] nt_vert;
-    delete[] mu_vert;
-
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getQpout());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getQpin());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getGwaterChng());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getSrf());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getRain());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getSoilMoistureSC());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getRootMoistureSC());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getAirTemp());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getDewTemp());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getSurfTemp());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getSoilTemp());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getAirPressure());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getRelHumid());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getSkyCover());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getWindSpeed());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getNetRad());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getActEvap());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getEvapoTrans());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getEvapSoil());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getGFlux());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getHFlux());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getLFlux());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getNetPrecipitation());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getRecharge());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getQstrm());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getHlevel());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getCanStorage());
-	for (cn = niter.FirstP(); niter.IsActive(); cn = niter.NextP())
-		BinaryWrite(ostr, (float) cn->getFlowVelocity());
+	if (dynSnap == NULL)
+		return;
+
+	dynSnap->gather(this->g->getActiveNodes());
+
+	snprintf(extension,sizeof(extension), "_dyn.%04d", hour);
+	this->CreateAndOpenVizFile(&ostr, extension);
+	dynSnap->write(ostr);
+	ostr.close();
 }
 
 /*************************************************************************
@@ -2152,6 +2128,10 @@ void tCOutput<tSubNode>::UpdateForNewRun( tInputFile &infile )
 	CreateAndOpenOutlet();
 	SetInteriorOutlet();
 	
+	// Variables of the visualization files
+	delete dynSnap;
+	dynSnap = (this->vizOption == 1) ? new tSnapshot(infile) : NULL;
+	
 	return;
 }
 
@@ -31,6 +31,7 @@
 #include "src/tInOut/tInputFile.h"
 #include "src/tSimulator/tRunTimer.h"
 #include "src/tRasTin/tResample.h"
+#include "src/tInOut/tSnapshot.h"
 
 using namespace std;
 
@@ -127,6 +128,7 @@ public:
   void WriteNodeData(double, tResample*); 
   void WriteGeometry(tResample*);
   void UpdateForNewRun(tInputFile &); 
+  void CloseOutletFiles();
 
   void WriteOutletInfo(double);
   void ReadOutletNodeList(char *);
@@ -134,7 +136,10 @@ public:
   void SetInteriorOutlet();
 
 private:
+  void FormatDynamicRow(string &, tSubNode *, double);
+
   tSubNode **Outlets;    //Pointer to an array of tCNode objects
+  tSnapshot *dynSnap;    //Columns of the *_dyn visualization files
   ofstream *outletinfo;     
   ofstream arcofs;
   ofstream vorofs;
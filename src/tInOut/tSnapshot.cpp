@@ -0,0 +1,280 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tSnapshot.cpp: Functions for class tSnapshot (see tSnapshot.h)
+**
+***************************************************************************/
+
+#include "src/tInOut/tSnapshot.h"
+#include "src/tInOut/tInputFile.h"
+#include "src/tCNode/tCNode.h"
+#include "src/tThreadPool/tThreadPool.h"
+#include "src/Headers/globalIO.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+//=========================================================================
+//
+//
+//                  Section 1: Variables of the Snapshot
+//
+//
+//=========================================================================
+
+struct tSnapshotVar {
+  const char *name;
+  tSnapshotGetter get;
+  int field;                   // Variable of tCNodeState, or -1
+  int vertical;                // 1 if divided by the cosine of the slope
+};
+
+// Default order of the *_dyn files. The moisture depths Nwt, Nf, Nt and
+// Mu are given along the vertical.
+static const tSnapshotVar kSnapshotVars[] = {
+  { "Nwt",        [](tCNode *cn, double cs) { return cn->getNwtNew()/cs; }, kStNwtNew, 1 },
+  { "Nf",         [](tCNode *cn, double cs) { return cn->getNfNew()/cs; }, kStNfNew, 1 },
+  { "Nt",         [](tCNode *cn, double cs) { return cn->getNtNew()/cs; }, kStNtNew, 1 },
+  { "Mu",         [](tCNode *cn, double cs) { return cn->getMuNew()/cs; }, kStMuNew, 1 },
+  { "Qpout",      [](tCNode *cn, double) { return cn->getQpout(); }, kStQpout, 0 },
+  { "Qpin",       [](tCNode *cn, double) { return cn->getQpin(); }, kStQpin, 0 },
+  { "GwChng",     [](tCNode *cn, double) { return cn->getGwaterChng(); }, -1, 0 },
+  { "Srf",        [](tCNode *cn, double) { return cn->getSrf(); }, kStSrf, 0 },
+  { "Rain",       [](tCNode *cn, double) { return cn->getRain(); }, -1, 0 },
+  { "SoilMoist",  [](tCNode *cn, double) { return cn->getSoilMoistureSC(); }, -1, 0 },
+  { "RootMoist",  [](tCNode *cn, double) { return cn->getRootMoistureSC(); }, -1, 0 },
+  { "AirT",       [](tCNode *cn, double) { return cn->getAirTemp(); }, -1, 0 },
+  { "DewT",       [](tCNode *cn, double) { return cn->getDewTemp(); }, -1, 0 },
+  { "SurfT",      [](tCNode *cn, double) { return cn->getSurfTemp(); }, -1, 0 },
+  { "SoilT",      [](tCNode *cn, double) { return cn->getSoilTemp(); }, -1, 0 },
+  { "AirPress",   [](tCNode *cn, double) { return cn->getAirPressure(); }, -1, 0 },
+  { "RelHum",     [](tCNode *cn, double) { return cn->getRelHumid(); }, -1, 0 },
+  { "SkyCov",     [](tCNode *cn, double) { return cn->getSkyCover(); }, -1, 0 },
+  { "Wind",       [](tCNode *cn, double) { return cn->getWindSpeed(); }, -1, 0 },
+  { "NetRad",     [](tCNode *cn, double) { return cn->getNetRad(); }, -1, 0 },
+  { "ActEvp",     [](tCNode *cn, double) { return cn->getActEvap(); }, -1, 0 },
+  { "ET",         [](tCNode *cn, double) { return cn->getEvapoTrans(); }, kStEvapoTrans, 0 },
+  { "EvpSoil",    [](tCNode *cn, double) { return cn->getEvapSoil(); }, -1, 0 },
+  { "GFlux",      [](tCNode *cn, double) { return cn->getGFlux(); }, -1, 0 },
+  { "HFlux",      [](tCNode *cn, double) { return cn->getHFlux(); }, -1, 0 },
+  { "LFlux",      [](tCNode *cn, double) { return cn->getLFlux(); }, -1, 0 },
+  { "NetPrecip",  [](tCNode *cn, double) { return cn->getNetPrecipitation(); }, -1, 0 },
+  { "Recharge",   [](tCNode *cn, double) { return cn->getRecharge(); }, -1, 0 },
+  { "Qstrm",      [](tCNode *cn, double) { return cn->getQstrm(); }, -1, 0 },
+  { "Hlev",       [](tCNode *cn, double) { return cn->getHlevel(); }, -1, 0 },
+  { "CanStorage", [](tCNode *cn, double) { return cn->getCanStorage(); }, -1, 0 },
+  { "FlwVlc",     [](tCNode *cn, double) { return cn->getFlowVelocity(); }, -1, 0 }
+};
+
+// Further variables, written only when named in OUTVIZVARS
+static const tSnapshotVar kSnapshotExtra[] = {
+  { "Mi",         [](tCNode *cn, double cs) { return cn->getMiNew()/cs; }, kStMiNew, 1 },
+  { "Ri",         [](tCNode *cn, double) { return cn->getRiNew(); }, kStRiNew, 0 },
+  { "IWE",        [](tCNode *cn, double) { return cn->getIceWE(); }, -1, 0 },
+  { "LWE",        [](tCNode *cn, double) { return cn->getLiqWE(); }, -1, 0 },
+  { "ST",         [](tCNode *cn, double) { return cn->getSnTempC(); }, -1, 0 },
+  { "SnMelt",     [](tCNode *cn, double) { return cn->getLiqRouted(); }, -1, 0 },
+  { "IntSWE",     [](tCNode *cn, double) { return cn->getIntSWE(); }, -1, 0 }
+};
+
+static const int kNumDefault = sizeof(kSnapshotVars)/sizeof(kSnapshotVars[0]);
+static const int kNumExtra = sizeof(kSnapshotExtra)/sizeof(kSnapshotExtra[0]);
+
+// Entry i of the table: the default variables, then the extra ones
+static const tSnapshotVar &SnapshotVar(int i)
+{
+  return (i < kNumDefault) ? kSnapshotVars[i] : kSnapshotExtra[i - kNumDefault];
+}
+
+//=========================================================================
+//
+//
+//                  Section 2: tSnapshot Functions
+//
+//
+//=========================================================================
+
+tSnapshot::tSnapshot(tInputFile &infile)
+  : nNodes(0), compress(0)
+{
+  char list[kMaxNameLength];
+
+  if (infile.IsItemIn("VIZCOMPRESS"))
+    compress = infile.ReadItem(compress, "VIZCOMPRESS");
+
+  if (infile.IsItemIn("OUTVIZVARS")) {
+    infile.ReadItem(list, "OUTVIZVARS");
+    select(list);
+  }
+  else
+    for (int i = 0; i < kNumDefault; i++)
+      columns.push_back(i);
+}
+
+/***************************************************************************
+**
+**  tSnapshot::select()
+**
+**  Columns named in 'list', separated by commas, spaces or tabs
+**
+***************************************************************************/
+void tSnapshot::select(char *list)
+{
+  const char *sep = " ,\t\r\n";
+  int found;
+
+  for (char *name = strtok(list, sep); name; name = strtok(NULL, sep)) {
+    found = 0;
+    for (int i = 0; i < kNumDefault + kNumExtra && !found; i++)
+      if (strcmp(name, SnapshotVar(i).name) == 0) {
+        columns.push_back(i);
+        found = 1;
+      }
+    if (!found) {
+      cout<<"\nError: Unknown variable '"<<name<<"' in OUTVIZVARS"<<endl;
+      cout<<"Exiting Program..."<<endl;
+      exit(2);
+    }
+  }
+  Cout<<"Visualization variables: \t"<<columns.size()<<endl;
+}
+
+/***************************************************************************
+**
+**  tSnapshot::gather()
+**
+**  Fills the columns for the nodes given, in one pass over them (on
+**  NUMTHREADS threads). The slope correction is computed once per node.
+**  If the nodes are those of the state store (OPTNODESTATE = 1, see
+**  tCNodeState), the columns of its variables are copied from its arrays
+**  instead, with the same values.
+**
+***************************************************************************/
+void tSnapshot::gather(const vector<tCNode*> &nodes)
+{
+  int nCol = (int)columns.size();
+  tCNodeState *state = nodes.empty() ? NULL : nodes[0]->getState();
+
+  if (state && !state->isStoreOrder(nodes))
+    state = NULL;
+
+  nNodes = (int)nodes.size();
+  values.resize((size_t)nCol*nNodes);
+  cosSlope.resize(nNodes);
+
+  tThreadPool::parallelFor(0, nNodes, [&](int first, int last, int) {
+    for (int i = first; i < last; i++) {
+      tCNode *cn = nodes[i];
+      double cos_slope = cos(atan(cn->getFlowEdg()->getSlope()));
+      if (cos_slope < 1E-9) cos_slope = 1.E-9;
+      cosSlope[i] = cos_slope;
+      for (int c = 0; c < nCol; c++)
+        if (!state || SnapshotVar(columns[c]).field < 0)
+          values[(size_t)c*nNodes + i] =
+            (float)SnapshotVar(columns[c]).get(cn, cos_slope);
+    }
+
+    for (int c = 0; c < nCol && state; c++) {
+      const tSnapshotVar &var = SnapshotVar(columns[c]);
+      if (var.field < 0)
+        continue;
+      const double *v = state->getField(var.field);
+      float *col = &values[(size_t)c*nNodes];
+      for (int i = first; i < last; i++)
+        col[i] = (float)(var.vertical ? v[i]/cosSlope[i] : v[i]);
+    }
+  });
+}
+
+/***************************************************************************
+**
+**  tSnapshot::write()
+**
+**  Writes the columns one after the other, each with a single write
+**
+***************************************************************************/
+void tSnapshot::write(ofstream &ostr) const
+{
+  if (compress)
+    writeHeader(ostr);
+  for (int c = 0; c < (int)columns.size(); c++) {
+    const float *col = &values[(size_t)c*nNodes];
+    if (compress)
+      writeRuns(ostr, col);
+    else
+      ostr.write(reinterpret_cast<const char*>(col),
+                 (streamsize)nNodes*sizeof(float));
+  }
+}
+
+/***************************************************************************
+**
+**  tSnapshot::writeHeader()
+**
+**  Tag, version and size of a run-length encoded file (see tSnapshot.h)
+**
+***************************************************************************/
+void tSnapshot::writeHeader(ofstream &ostr) const
+{
+  int head[3] = { kSnapshotVersion, (int)columns.size(), nNodes };
+
+  ostr.write(kSnapshotTag, sizeof(kSnapshotTag));
+  ostr.write(reinterpret_cast<const char*>(head), sizeof(head));
+}
+
+/***************************************************************************
+**
+**  tSnapshot::writeRuns()
+**
+**  Writes a column run-length encoded, or as is after a 0 if the runs
+**  take more room than the values
+**
+***************************************************************************/
+void tSnapshot::writeRuns(ofstream &ostr, const float *col) const
+{
+  struct tRun { int count; float value; };
+  vector<tRun> runs;
+  int none = 0;
+
+  for (int i = 0; i < nNodes; i++) {
+    if (!runs.empty() && memcmp(&runs.back().value, &col[i], sizeof(float)) == 0)
+      runs.back().count++;
+    else {
+      runs.push_back(tRun());
+      runs.back().count = 1;
+      runs.back().value = col[i];
+    }
+    if (runs.size()*sizeof(tRun) >= (size_t)nNodes*sizeof(float))
+      break;
+  }
+
+  if (runs.size()*sizeof(tRun) >= (size_t)nNodes*sizeof(float)) {
+    ostr.write(reinterpret_cast<const char*>(&none), sizeof(int));
+    ostr.write(reinterpret_cast<const char*>(col),
+               (streamsize)nNodes*sizeof(float));
+  }
+  else {
+    int n = (int)runs.size();
+    ostr.write(reinterpret_cast<const char*>(&n), sizeof(int));
+    ostr.write(reinterpret_cast<const char*>(runs.data()),
+               (streamsize)n*sizeof(tRun));
+  }
+}
+
+//=========================================================================
+//
+//
+//                          End of tSnapshot.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tSnapshot.h: Header for tSnapshot class
+**
+**  tSnapshot gathers node variables of the active nodes into one float
+**  column per variable and writes each column with a single write. It
+**  is used for the dynamic variables of the visualization output
+**  (*_dyn.HHHH files, OPTVIZ = 1). The variables are chosen by name with
+**  the optional keyword OUTVIZVARS (a list separated by commas or
+**  spaces); by default all variables of the table in tSnapshot.cpp are
+**  written, in the order of that table.
+**
+**  With the optional keyword VIZCOMPRESS = 1 the file starts with a
+**  header of four ints: the tag kSnapshotTag ("TSRL"), the format version
+**  kSnapshotVersion, the number of columns and the number of nodes. Each
+**  column is then preceded by an int: 0 if the column follows as is,
+**  otherwise the number of runs of equal values that follow, each written
+**  as an int count and a float value. A column is run-length encoded only
+**  if this is smaller. Without it the file has no header.
+**
+***************************************************************************/
+
+#ifndef TSNAPSHOT_H
+#define TSNAPSHOT_H
+
+//=========================================================================
+//
+//
+//                  Section 1: tSnapshot Include and Define Statements
+//
+//
+//=========================================================================
+
+#include <vector>
+#include <fstream>
+
+class tCNode;
+class tInputFile;
+
+// Header of the run-length encoded files (VIZCOMPRESS = 1)
+const char kSnapshotTag[4] = { 'T', 'S', 'R', 'L' };
+const int  kSnapshotVersion = 1;
+
+//=========================================================================
+//
+//
+//                  Section 2: tSnapshot Class Definitions
+//
+//
+//=========================================================================
+
+// Value of a variable at a node; cosSlope is the cosine of the slope
+// of the flow edge, for depths given along the vertical
+typedef double (*tSnapshotGetter)(tCNode *, double cosSlope);
+
+class tSnapshot
+{
+public:
+  tSnapshot(tInputFile &);
+
+  void gather(const std::vector<tCNode*> &);  // One pass over the nodes
+  void write(std::ofstream &) const;
+
+  int  getNumColumns() const { return (int)columns.size(); }
+
+private:
+  std::vector<int> columns;    // Selected entries of the table
+  std::vector<float> values;   // Column after column
+  std::vector<double> cosSlope; // Cosine of the slope of each node
+  int nNodes;
+  int compress;
+
+  void select(char *);
+  void writeHeader(std::ofstream &) const;
+  void writeRuns(std::ofstream &, const float *) const;
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tSnapshot.h
+//
+//
+//=========================================================================
@@ -4708,6 +4708,50 @@ tList< tTriangle > * tMesh<tSubNode>::
 getTriList() {return &triList;}
 
 
+/**************************************************************************
+**
+**  tMesh::BuildActiveIndex
+**
+**  Copies the active nodes and edges, and the flow edge of each active
+**  node, into contiguous arrays in list order. Must be called again when
+**  the lists are changed or sorted: this is done at the end of 
+**  UpdateMesh() and by tFlowNet once the flow network is set.
+**
+**************************************************************************/
+
+template< class tSubNode >
+void tMesh< tSubNode >::
+BuildActiveIndex()
+{
+	tMeshListIter< tSubNode > nodIter( nodeList );
+	tMeshListIter< tEdge > edgIter( edgeList );
+	tSubNode *cn;
+	tEdge *ce;
+	int maxID = -1;
+	
+	activeNodes.clear();
+	activeEdges.clear();
+	activeFlowEdges.clear();
+	activeIndexByID.clear();
+	
+	for( cn=nodIter.FirstP(); nodIter.IsActive(); cn=nodIter.NextP() ) {
+		activeNodes.push_back( cn );
+		activeFlowEdges.push_back( cn->getFlowEdg() );
+		maxID = max( maxID, cn->getID() );
+	}
+	for( ce=edgIter.FirstP(); edgIter.IsActive(); ce=edgIter.NextP() )
+		activeEdges.push_back( ce );
+	
+	activeIndexByID.assign( maxID+1, -1 );
+	for( size_t i=0; i<activeNodes.size(); i++ ) {
+		if( activeNodes[i]->getID() >= 0 ) {
+			assert( activeIndexByID[ activeNodes[i]->getID() ] == -1 );
+			activeIndexByID[ activeNodes[i]->getID() ] = (int)i;
+		}
+	}
+}
+
+
 /**************************************************************************
 **
 **  tMesh::getEdgeComplement
@@ -4754,12 +4798,13 @@ getEdgeComplement( tEdge *edge )
 **   - computes Voronoi edge lengths
 **   - computes Voronoi areas for interior (active) nodes
 **   - updates CCW-edge connectivity
+**   - rebuilds the contiguous index of active nodes and edges
 **
 **  Note that the call to CheckMeshConsistency is for debugging
 **  purposes and should be removed prior to release.
 **
 **  Calls: MakeCCWEdges(), setVoronoiVertices(), CalcVoronoiEdgeLengths(),
-**   CalcVAreas(), CheckMeshConsistency()
+**   CalcVAreas(), BuildActiveIndex(), CheckMeshConsistency()
 **  Assumes: nodes have been properly triangulated
 **  Created: SL fall, '97
 **
@@ -4799,6 +4844,8 @@ UpdateMesh()
 	setVoronoiVertices();
 	CalcVoronoiEdgeLengths();
 	CalcVAreas();
+	
+	BuildActiveIndex();
 }
 
 /*****************************************************************************
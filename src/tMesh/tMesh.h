@@ -111,6 +111,28 @@ public:
    tMeshList<tSubNode> * getNodeList()
    { return &nodeList; }
    tMeshList<tSubNode> * getUnsortList();  
+
+   // Contiguous index of the active nodes and edges in list order, i.e.
+   // in flow order once tFlowNet has sorted the nodes. Loops over the
+   // active part of the lists can use it instead of tMeshListIter:
+   //   for (int i=0; i < mesh->getNumActiveNodes(); i++)
+   //     cn = mesh->getActiveNode(i);
+   //   for (tSubNode *cn : mesh->getActiveNodes()) ...
+   void BuildActiveIndex();
+   int getNumActiveNodes() const { return (int)activeNodes.size(); }
+   int getNumActiveEdges() const { return (int)activeEdges.size(); }
+   tSubNode *getActiveNode(int i) const { return activeNodes[i]; }
+   tEdge *getActiveEdge(int i) const { return activeEdges[i]; }
+   tEdge *getActiveFlowEdge(int i) const { return activeFlowEdges[i]; }
+   const std::vector<tSubNode*> &getActiveNodes() const { return activeNodes; }
+   const std::vector<tEdge*> &getActiveEdges() const { return activeEdges; }
+   int getActiveIndex(tSubNode *cn) const      // -1 if not active
+   {
+      int id = cn->getID();
+      if( id < 0 || id >= (int)activeIndexByID.size() ) return -1;
+      int i = activeIndexByID[id];
+      return ( i >= 0 && activeNodes[i] == cn ) ? i : -1;
+   }
    tList< tTriangle > * getTriList();  
    tEdge *getEdgeComplement( tEdge * );
 
@@ -156,6 +178,11 @@ protected:
    tSubNode** NodeTable;		// lookup table for node pointers
 					// must be available to tFlowNet and
 					// tGraph if using MeshBuilder files
+
+   std::vector<tSubNode*> activeNodes;   // active nodes, list order
+   std::vector<tEdge*> activeEdges;      // active edges, list order
+   std::vector<tEdge*> activeFlowEdges;  // flow edge of each active node
+   std::vector<int> activeIndexByID;     // index of active nodes by ID
    
 };
 
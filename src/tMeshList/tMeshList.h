@@ -37,6 +37,8 @@
 #include "src/Headers/Definitions.h"
 #include "src/tList/tList.h"
 
+#include <vector>
+
 #ifdef PARALLEL_TRIBS
 #include "src/tParallel/tParallel.h"
 #endif
@@ -96,6 +98,7 @@ public:
   void moveToFront( tListNode< NodeType > * );
   void moveToActiveBack( tListNode< NodeType > * );
   void moveToBoundFront( tListNode< NodeType > * );
+  void setActiveOrder( const std::vector< tListNode< NodeType > * > & );
   void moveToBack( NodeType * );
   void insertAtFront( const NodeType & );
   int removeFromFront( NodeType & );
@@ -652,6 +655,36 @@ moveToActiveBack( tListNode< NodeType > * mvnode )
     }
 }
 
+/**************************************************************************
+**
+**  tMeshList::setActiveOrder()
+**
+**  Relinks the active part of the list in the order of 'order', which
+**  must hold each active list node once. Unlike moving the nodes one by
+**  one with moveToActiveBack, this takes a single pass over the nodes.
+**
+**************************************************************************/
+
+template< class NodeType >
+void tMeshList< NodeType >::
+setActiveOrder( const std::vector< tListNode< NodeType > * > &order )
+{
+    assert( (int)order.size() == nActiveNodes );
+    if( nActiveNodes == 0 ) return;
+
+    int circular = ( this->last->next != 0 );
+    tListNode< NodeType > * bound =
+        ( nActiveNodes < this->nNodes ) ? lastactive->next : 0;
+
+    this->first = order[0];
+    for( size_t i=0; i+1<order.size(); i++ )
+        order[i]->next = order[i+1];
+    lastactive = order.back();
+    lastactive->next = bound;
+    if( bound == 0 ) this->last = lastactive;
+    if( circular ) this->last->next = this->first;
+}
+
 /**************************************************************************
 **
 **  tMeshList::moveToBoundFront()
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tHaloExchange.cpp: Functions for class tHaloExchange
+**                     (see tHaloExchange.h)
+**
+***************************************************************************/
+
+#include "src/tParallel/tHaloExchange.h"
+
+#include <cassert>
+
+using namespace std;
+
+tHaloExchange::tHaloExchange()
+  : tag(0), initialized(false), active(false)
+{}
+
+tHaloExchange::~tHaloExchange()
+{
+  // Requests are freed in finalize() while MPI is still running
+}
+
+/***************************************************************************
+**
+** Allocate one contiguous block for all send (receive) buffers and
+** create a persistent request for each processor with a non-zero count.
+** The buffers are not resized afterwards, the requests point into them.
+**
+***************************************************************************/
+
+void tHaloExchange::initialize(int rtag, const vector<int>& sendCount,
+                               const vector<int>& recvCount)
+{
+  finalize();
+  assert(sendCount.size() == recvCount.size());
+
+  tag = rtag;
+  int np = sendCount.size();
+  sendOffset.assign(np, -1);
+  recvOffset.assign(np, -1);
+
+  int ns = 0, nr = 0;
+  for (int i = 0; i < np; i++) {
+    if (sendCount[i] > 0) { sendOffset[i] = ns; ns += sendCount[i]; }
+    if (recvCount[i] > 0) { recvOffset[i] = nr; nr += recvCount[i]; }
+  }
+  sendData.assign(ns, 0.0);
+  recvData.assign(nr, 0.0);
+
+  for (int i = 0; i < np; i++) {
+    if (recvOffset[i] >= 0) {
+      MPI_Request request;
+      MPI_Recv_init(&recvData[recvOffset[i]], recvCount[i], MPI_DOUBLE, i,
+                    tag, MPI_COMM_WORLD, &request);
+      requests.push_back(request);
+    }
+  }
+  for (int i = 0; i < np; i++) {
+    if (sendOffset[i] >= 0) {
+      MPI_Request request;
+      MPI_Send_init(&sendData[sendOffset[i]], sendCount[i], MPI_DOUBLE, i,
+                    tag, MPI_COMM_WORLD, &request);
+      requests.push_back(request);
+    }
+  }
+  initialized = true;
+}
+
+/***************************************************************************
+**
+** Complete any exchange in progress and free the persistent requests
+**
+***************************************************************************/
+
+void tHaloExchange::finalize()
+{
+  if (!initialized) return;
+  finish();
+  for (size_t i = 0; i < requests.size(); i++)
+    MPI_Request_free(&requests[i]);
+  requests.clear();
+  sendOffset.clear();
+  recvOffset.clear();
+  sendData.clear();
+  recvData.clear();
+  initialized = false;
+}
+
+double* tHaloExchange::sendBuffer(int proc)
+{
+  assert(initialized && !active);
+  if (sendOffset[proc] < 0) return nullptr;
+  return &sendData[sendOffset[proc]];
+}
+
+double* tHaloExchange::recvBuffer(int proc)
+{
+  assert(initialized && !active);
+  if (recvOffset[proc] < 0) return nullptr;
+  return &recvData[recvOffset[proc]];
+}
+
+/***************************************************************************
+**
+** Start the receives first so that they are posted before the matching
+** sends of the neighbors arrive, then start the sends
+**
+***************************************************************************/
+
+void tHaloExchange::start()
+{
+  assert(initialized && !active);
+  if (!requests.empty())
+    MPI_Startall(requests.size(), &requests[0]);
+  active = true;
+}
+
+void tHaloExchange::finish()
+{
+  if (!active) return;
+  if (!requests.empty())
+    MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+  active = false;
+}
+
+//=========================================================================
+//
+//
+//                        End of tHaloExchange.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tHaloExchange.h: Header for tHaloExchange class
+**
+**  tHaloExchange is a persistent halo (ghost/overlap node) exchange
+**  between partitions of the parallel version. One send and one receive
+**  buffer per neighbor processor is sized once from the overlap lists of
+**  tGraph, and the matching persistent MPI requests are reused at every
+**  exchange. Fields are packed into the send buffers in bulk, the
+**  exchange is started with start() and completed with finish(), so
+**  that work that does not depend on the halo can be done in between.
+**
+***************************************************************************/
+
+//=========================================================================
+//
+//
+//                  Section 1: tHaloExchange Include and Define Statements
+//
+//
+//=========================================================================
+
+#ifndef THALOEXCHANGE_H
+#define THALOEXCHANGE_H
+
+#include <mpi.h>
+#include <vector>
+
+//=========================================================================
+//
+//
+//                  Section 2: tHaloExchange Class Definitions
+//
+//
+//=========================================================================
+
+class tHaloExchange {
+
+public:
+  /// Constructor
+  tHaloExchange();
+  /// Destructor
+  ~tHaloExchange();
+
+  /// Create buffers and persistent requests, counts indexed by processor
+  void initialize(int tag, const std::vector<int>& sendCount,
+                  const std::vector<int>& recvCount);
+  /// Free persistent requests and buffers
+  void finalize();
+  /// Have the buffers been created?
+  bool isInitialized() const { return initialized; }
+
+  /// Send buffer for a processor (nullptr if nothing is sent to it)
+  double* sendBuffer(int proc);
+  /// Receive buffer for a processor (nullptr if nothing is received)
+  double* recvBuffer(int proc);
+
+  /// Start all receives and sends (send buffers must be packed)
+  void start();
+  /// Wait for all receives and sends of the last start()
+  void finish();
+
+private:
+  int tag;                                   //!< Message tag
+  bool initialized;                          //!< Buffers created
+  bool active;                               //!< Exchange in progress
+
+  std::vector<int> sendOffset;               //!< Offset per proc (-1 none)
+  std::vector<int> recvOffset;               //!< Offset per proc (-1 none)
+  std::vector<double> sendData;              //!< Packed send buffers
+  std::vector<double> recvData;              //!< Packed receive buffers
+  std::vector<MPI_Request> requests;         //!< Receives, then sends
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tHaloExchange.h
+//
+//
+//=========================================================================
@@ -27,6 +27,9 @@ int tParallel::myProc = -1;
 list<double*> tParallel::buffers;
 list<MPI_Request> tParallel::requests;
 
+map<tParallel::tChannelKey, list<tParallel::tChannel> > tParallel::sendChannels;
+map<tParallel::tChannelKey, tParallel::tChannel> tParallel::recvChannels;
+
 tParallel::tParallel() {}
 tParallel::~tParallel() {}
 
@@ -65,6 +68,9 @@ void tParallel::initialize(int& argc, char** argv) {
 *************************************************************************/
 
 void tParallel::finalize() {
+  // Persistent requests must be freed before MPI shuts down
+  freePersistent();
+
   // Delete data and zero
   numProcs = 0;
   myProc = -1;
@@ -245,6 +251,102 @@ void tParallel::freeBuffers() {
    }
 }
 
+/***************************************************************************
+**
+** Send a short message through a persistent request for (tproc, rtag).
+** The data are copied into the buffer of the first channel whose last
+** send has completed, a new channel is only created when all channels
+** of the pair are still in flight. This replaces a new buffer and an
+** MPI_Isend for every value sent between reaches.
+**
+***************************************************************************/
+
+void tParallel::sendPersistent(int tproc, int rtag, const double* sdata,
+                               int scnt) {
+  assert((tproc >= 0) && (tproc < numProcs));
+
+  list<tChannel>& channels = sendChannels[tChannelKey(tproc, rtag)];
+  tChannel* ch = nullptr;
+  int complete;
+  for (list<tChannel>::iterator it = channels.begin();
+       it != channels.end() && ch == nullptr; ++it) {
+    if (it->active) {
+      MPI_Test(&(it->request), &complete, MPI_STATUS_IGNORE);
+      if (complete) it->active = false;
+    }
+    if (!it->active && (int)it->data.size() == scnt)
+      ch = &(*it);
+  }
+
+  if (ch == nullptr) {
+    channels.push_back(tChannel());
+    ch = &channels.back();
+    ch->data.assign(scnt, 0.0);
+    ch->active = false;
+    MPI_Send_init(&(ch->data[0]), scnt, MPI_DOUBLE, tproc, rtag,
+                  MPI_COMM_WORLD, &(ch->request));
+  }
+
+  for (int i = 0; i < scnt; i++) ch->data[i] = sdata[i];
+  MPI_Start(&(ch->request));
+  ch->active = true;
+}
+
+/***************************************************************************
+**
+** Receive a short message through a persistent request for (fproc, rtag),
+** blocking like receive()
+**
+***************************************************************************/
+
+void tParallel::receivePersistent(int fproc, int rtag, double* rdata,
+                                  int rcnt) {
+  assert((fproc >= 0) && (fproc < numProcs));
+
+  tChannelKey key(fproc, rtag);
+  map<tChannelKey, tChannel>::iterator it = recvChannels.find(key);
+  if (it == recvChannels.end() || (int)it->second.data.size() != rcnt) {
+    if (it != recvChannels.end()) {
+      MPI_Request_free(&(it->second.request));
+      recvChannels.erase(it);
+    }
+    tChannel& nc = recvChannels[key];
+    nc.data.assign(rcnt, 0.0);
+    nc.active = false;
+    MPI_Recv_init(&(nc.data[0]), rcnt, MPI_DOUBLE, fproc, rtag,
+                  MPI_COMM_WORLD, &(nc.request));
+    it = recvChannels.find(key);
+  }
+
+  tChannel& ch = it->second;
+  MPI_Start(&(ch.request));
+  MPI_Wait(&(ch.request), MPI_STATUS_IGNORE);
+  for (int i = 0; i < rcnt; i++) rdata[i] = ch.data[i];
+}
+
+/***************************************************************************
+**
+** Complete outstanding persistent sends and free all persistent requests
+**
+***************************************************************************/
+
+void tParallel::freePersistent() {
+  map<tChannelKey, list<tChannel> >::iterator is;
+  for (is = sendChannels.begin(); is != sendChannels.end(); ++is) {
+    list<tChannel>::iterator ic;
+    for (ic = is->second.begin(); ic != is->second.end(); ++ic) {
+      if (ic->active) MPI_Wait(&(ic->request), MPI_STATUS_IGNORE);
+      MPI_Request_free(&(ic->request));
+    }
+  }
+  sendChannels.clear();
+
+  map<tChannelKey, tChannel>::iterator ir;
+  for (ir = recvChannels.begin(); ir != recvChannels.end(); ++ir)
+    MPI_Request_free(&(ir->second.request));
+  recvChannels.clear();
+}
+
 /***************************************************************************
 **
 ** Int global summation across processors.
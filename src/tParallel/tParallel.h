@@ -29,6 +29,9 @@
 
 #include <mpi.h>
 #include <list>
+#include <map>
+#include <utility>
+#include <vector>
 
 //=========================================================================
 //
@@ -73,6 +76,14 @@ public:
   /// Delete buffers for which the send has completed
   static void freeBuffers();
 
+  /// Send a short message on a persistent request kept for (proc, tag)
+  static void sendPersistent(int tproc, int rtag, const double* sdata,
+                             int scnt);
+  /// Receive a short message on a persistent request kept for (proc, tag)
+  static void receivePersistent(int fproc, int rtag, double* rdata, int rcnt);
+  /// Free all persistent requests
+  static void freePersistent();
+
   /// Global sum for a single value
   static int sum(int value);
   /// Global sum for a single value with broadcast
@@ -97,6 +108,17 @@ private:
 
   static std::list<double*> buffers;      //!< Buffers immediately sent
   static std::list<MPI_Request> requests; //!< Matching requests to check
+
+  /// Persistent request with its own buffer
+  struct tChannel {
+    std::vector<double> data;
+    MPI_Request request;
+    bool active;
+  };
+  typedef std::pair<int,int> tChannelKey;   //!< (processor, tag)
+
+  static std::map<tChannelKey, std::list<tChannel> > sendChannels;
+  static std::map<tChannelKey, tChannel> recvChannels;
 };
 
 #endif
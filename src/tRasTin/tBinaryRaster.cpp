@@ -0,0 +1,366 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tBinaryRaster.cpp:   Functions for tBinaryRaster class
+**                       (see tBinaryRaster.h)
+**
+***************************************************************************/
+
+#include "src/tRasTin/tBinaryRaster.h"
+#include "src/tRasTin/tGridPrefetch.h"
+
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+
+#if defined(LINUX_32) || defined(MAC)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define RASTER_MMAP
+#endif
+
+using namespace std;
+
+static const char    kRasterMagic[8] = {'t','R','I','B','S','R','A','S'};
+static const int32_t kRasterVersion  = 2;
+static const int32_t kRasterOrder    = 0x01020304;
+
+// Offsets of the header fields
+#define kOffVersion   8
+#define kOffOrder    12
+#define kOffSize     16
+#define kOffRows     20
+#define kOffCols     24
+#define kOffSlices   28
+#define kOffXllc     32
+#define kOffYllc     40
+#define kOffCell     48
+#define kOffDummy    56
+
+template<class T> static void getField(const char *h, int off, T &v)
+{
+	memcpy(&v, h + off, sizeof(T));
+}
+
+template<class T> static void putField(char *h, int off, T v)
+{
+	memcpy(h + off, &v, sizeof(T));
+}
+
+//=========================================================================
+//
+//
+//                  Section 1: tBinaryRaster Constructors and Destructors
+//
+//
+//=========================================================================
+
+tBinaryRaster::tBinaryRaster()
+  : NR(0), MR(0), nSlices(0), valueSize(0), xllc(0.0), yllc(0.0),
+	dR(0.0), dummy(0.0), base(nullptr), length(0), mapped(0)
+{}
+
+tBinaryRaster::~tBinaryRaster()
+{
+	close();
+}
+
+//=========================================================================
+//
+//
+//                  Section 2: tBinaryRaster Functions
+//
+//
+//=========================================================================
+
+/***************************************************************************
+**
+**  tBinaryRaster::open(const char *file)
+**
+**  Maps the file read only (or reads it where mmap is not available) and
+**  checks the header. Returns 0 if the file is missing or not a valid
+**  raster.
+**
+***************************************************************************/
+int tBinaryRaster::open(const char *file)
+{
+	close();
+
+#ifdef RASTER_MMAP
+	int fd = ::open(file, O_RDONLY);
+	if (fd < 0)
+		return 0;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < kRasterHeaderSize) {
+		::close(fd);
+		return 0;
+	}
+	void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (p == MAP_FAILED)
+		return 0;
+	base = (char *)p;
+	length = st.st_size;
+	mapped = 1;
+#else
+	ifstream in(file, ios::in | ios::binary);
+	if (!in)
+		return 0;
+	in.seekg(0, ios::end);
+	length = in.tellg();
+	in.seekg(0, ios::beg);
+	if (length < kRasterHeaderSize)
+		return 0;
+	buffer.resize(length);
+	in.read(&buffer[0], length);
+	base = &buffer[0];
+	mapped = 0;
+#endif
+
+	int32_t version, order, vsize, rows, cols, slices;
+	getField(base, kOffVersion, version);
+	getField(base, kOffOrder, order);
+	getField(base, kOffSize, vsize);
+	getField(base, kOffRows, rows);
+	getField(base, kOffCols, cols);
+	getField(base, kOffSlices, slices);
+
+	if (memcmp(base, kRasterMagic, 8) != 0 || version != kRasterVersion ||
+		order != kRasterOrder || (vsize != 4 && vsize != 8) ||
+		rows <= 0 || cols <= 0 || slices <= 0 ||
+		length < kRasterHeaderSize + (size_t)slices*kRasterLabelSize +
+				 (size_t)slices*rows*cols*vsize) {
+		close();
+		return 0;
+	}
+
+	valueSize = vsize;
+	NR = rows;
+	MR = cols;
+	nSlices = slices;
+	getField(base, kOffXllc, xllc);
+	getField(base, kOffYllc, yllc);
+	getField(base, kOffCell, dR);
+	getField(base, kOffDummy, dummy);
+
+	char label[kRasterLabelSize+1];
+	for (int s = 0; s < nSlices; s++) {
+		memcpy(label, base + kRasterHeaderSize + (size_t)s*kRasterLabelSize,
+			   kRasterLabelSize);
+		label[kRasterLabelSize] = '\0';
+		if (label[0] != '\0')
+			labels[label] = s;
+	}
+	return 1;
+}
+
+void tBinaryRaster::close()
+{
+#ifdef RASTER_MMAP
+	if (base && mapped)
+		munmap(base, length);
+#endif
+	base = nullptr;
+	length = 0;
+	mapped = 0;
+	buffer.clear();
+	labels.clear();
+	NR = MR = nSlices = valueSize = 0;
+}
+
+/***************************************************************************
+**
+**  tBinaryRaster::labelName(const char *file)
+**
+**  Returns the label of a file path: the path without a leading "./"
+**
+***************************************************************************/
+const char* tBinaryRaster::labelName(const char *file)
+{
+	while (file[0] == '.' && file[1] == '/')
+		file += 2;
+	return file;
+}
+
+int tBinaryRaster::findSlice(const char *file) const
+{
+	map<string, int>::const_iterator it = labels.find(labelName(file));
+	if (it == labels.end())
+		return -1;
+	return it->second;
+}
+
+char* tBinaryRaster::sliceData(int slice) const
+{
+	return base + kRasterHeaderSize + (size_t)nSlices*kRasterLabelSize
+		+ (size_t)slice*NR*MR*valueSize;
+}
+
+const double* tBinaryRaster::getRow(int slice, int row) const
+{
+	if (valueSize != 8)
+		return nullptr;
+	return (const double *)(sliceData(slice) + (size_t)row*MR*8);
+}
+
+void tBinaryRaster::readRow(int slice, int row, double *out) const
+{
+	const char *p = sliceData(slice) + (size_t)row*MR*valueSize;
+	if (valueSize == 8)
+		memcpy(out, p, (size_t)MR*8);
+	else {
+		float v;
+		for (int j = 0; j < MR; j++) {
+			memcpy(&v, p + (size_t)j*4, 4);
+			out[j] = v;
+		}
+	}
+}
+
+void tBinaryRaster::readSlice(int slice, tGridData &grid) const
+{
+	grid.NR = NR;
+	grid.MR = MR;
+	grid.xllc = xllc;
+	grid.yllc = yllc;
+	grid.dR = dR;
+	grid.dummy = dummy;
+	grid.values.resize((size_t)NR*MR);
+	for (int i = 0; i < NR; i++)
+		readRow(slice, i, &grid.values[(size_t)i*MR]);
+}
+
+/***************************************************************************
+**
+**  tBinaryRaster::isRasterFile(const char *file)
+**
+**  Checks the magic bytes at the start of a file
+**
+***************************************************************************/
+int tBinaryRaster::isRasterFile(const char *file)
+{
+	char magic[8];
+	ifstream in(file, ios::in | ios::binary);
+	if (!in)
+		return 0;
+	in.read(magic, 8);
+	return (in.gcount() == 8 && memcmp(magic, kRasterMagic, 8) == 0);
+}
+
+/***************************************************************************
+**
+**  tBinaryRaster::convertGrids(out, valueSize, n, gridFiles)
+**
+**  Writes the n ASCII grids to one binary raster file, one slice per
+**  grid in the order given, labeled with the grid paths (which must be
+**  those read by the model, and different). All grids must have the
+**  same header. The grids are read one at a time. Returns 1 on success.
+**
+***************************************************************************/
+int tBinaryRaster::convertGrids(const char *out, int vsize, int n,
+								char **gridFiles)
+{
+	if (n < 1 || (vsize != 4 && vsize != 8)) {
+		cout<<"tBinaryRaster: Nothing to convert or value size "<<vsize
+			<<" is not 4 or 8"<<endl;
+		return 0;
+	}
+
+	map<string, int> seen;
+	for (int s = 0; s < n; s++) {
+		const char *label = labelName(gridFiles[s]);
+		if (strlen(label) >= kRasterLabelSize) {
+			cout<<"tBinaryRaster: File name "<<label
+				<<" is longer than "<<kRasterLabelSize-1<<" characters"<<endl;
+			return 0;
+		}
+		if (!seen.insert(make_pair(string(label), s)).second) {
+			cout<<"tBinaryRaster: File "<<label<<" is given twice"<<endl;
+			return 0;
+		}
+	}
+
+	tGridData first;
+	if (!first.read(gridFiles[0])) {
+		cout<<"tBinaryRaster: File "<<gridFiles[0]<<" not found"<<endl;
+		return 0;
+	}
+
+	ofstream os(out, ios::out | ios::binary);
+	if (!os) {
+		cout<<"tBinaryRaster: Cannot write "<<out<<endl;
+		return 0;
+	}
+
+	char header[kRasterHeaderSize];
+	memset(header, 0, kRasterHeaderSize);
+	memcpy(header, kRasterMagic, 8);
+	putField(header, kOffVersion, kRasterVersion);
+	putField(header, kOffOrder, kRasterOrder);
+	putField(header, kOffSize, (int32_t)vsize);
+	putField(header, kOffRows, (int32_t)first.NR);
+	putField(header, kOffCols, (int32_t)first.MR);
+	putField(header, kOffSlices, (int32_t)n);
+	putField(header, kOffXllc, first.xllc);
+	putField(header, kOffYllc, first.yllc);
+	putField(header, kOffCell, first.dR);
+	putField(header, kOffDummy, first.dummy);
+	os.write(header, kRasterHeaderSize);
+
+	char label[kRasterLabelSize];
+	for (int s = 0; s < n; s++) {
+		memset(label, 0, kRasterLabelSize);
+		strncpy(label, labelName(gridFiles[s]), kRasterLabelSize-1);
+		os.write(label, kRasterLabelSize);
+	}
+
+	int rows = first.NR, cols = first.MR;
+	double x0 = first.xllc, y0 = first.yllc, cell = first.dR, nodata = first.dummy;
+	vector<float> row32(cols);
+	for (int s = 0; s < n; s++) {
+		tGridData grid;
+		if (s == 0)
+			grid = std::move(first);
+		else if (!grid.read(gridFiles[s])) {
+			cout<<"tBinaryRaster: File "<<gridFiles[s]<<" not found"<<endl;
+			return 0;
+		}
+		if (grid.NR != rows || grid.MR != cols || grid.xllc != x0 ||
+			grid.yllc != y0 || grid.dR != cell || grid.dummy != nodata) {
+			cout<<"tBinaryRaster: Grid "<<gridFiles[s]
+				<<" does not have the header of the first grid"<<endl;
+			return 0;
+		}
+		if (vsize == 8)
+			os.write((const char *)&grid.values[0],
+					 grid.values.size()*sizeof(double));
+		else {
+			for (int i = 0; i < grid.NR; i++) {
+				for (int j = 0; j < grid.MR; j++)
+					row32[j] = (float)grid.values[(size_t)i*grid.MR + j];
+				os.write((const char *)&row32[0], grid.MR*sizeof(float));
+			}
+		}
+	}
+	os.close();
+	return os.good() ? 1 : 0;
+}
+
+//=========================================================================
+//
+//
+//                         End of tBinaryRaster.cpp
+//
+//
+//=========================================================================
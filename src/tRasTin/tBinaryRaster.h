@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tBinaryRaster.h:   Header File for tBinaryRaster class
+**
+**  tBinaryRaster is a native binary alternative to the ArcInfo/ArcView
+**  ASCII grids read by tResample. A file holds one or more grids (time
+**  slices) with the same header, stored as:
+**
+**    header      kRasterHeaderSize bytes: magic, version, byte order
+**                check, value size (4 - float32, 8 - float64), rows,
+**                columns, # of slices, lower left corner, cell size and
+**                NODATA value
+**    labels      kRasterLabelSize bytes per slice: the path of the ASCII
+**                grid the slice was converted from, as given to
+**                convertGrids() (a leading "./" is dropped)
+**    values      rows x columns values per slice, row by row from the
+**                top as in the ASCII format
+**
+**  A grid is found in a file by the path it is read from in the model, so
+**  grids of the same name in different directories are distinct slices.
+**  The file is memory mapped read only where available, so float64 rows
+**  are used in place without copying; a caller that changes the values
+**  must copy the rows (tResample::copyGridRows). convertGrids() writes a
+**  file from a list of ASCII grids, see also
+**  src/utilities/GridToBinary.cpp.
+**
+***************************************************************************/
+
+#ifndef  TBINARYRASTER_H
+#define  TBINARYRASTER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#define kRasterHeaderSize 128  // Bytes of the file header
+#define kRasterLabelSize  256  // Bytes of each slice label
+
+class tGridData;
+
+//=========================================================================
+//
+//
+//                  Section 1: tBinaryRaster Class Declarations
+//
+//
+//=========================================================================
+
+class tBinaryRaster
+{
+ public:
+  tBinaryRaster();
+  ~tBinaryRaster();
+
+  int    open(const char *);   // Returns 0 if not a valid raster file
+  void   close();
+  int    isOpen() const { return base != nullptr; }
+
+  int    NR;        // Rows in the grid
+  int    MR;        // Columns in the grid
+  int    nSlices;   // Number of grids in the file
+  int    valueSize; // 4 - float32, 8 - float64
+  double xllc;      // X -LOWER left corner of the grid
+  double yllc;      // Y -LOWER left corner of the grid
+  double dR;        // Spatial resolution of the grid
+  double dummy;     // NODATA value of the grid
+
+  // Slice with the label of a file path, or -1
+  int    findSlice(const char *) const;
+  // Row of a float64 slice in place, read only (nullptr for float32 files)
+  const double* getRow(int slice, int row) const;
+  // Copy (and convert) a row of a slice
+  void   readRow(int slice, int row, double *) const;
+  // Copy a slice into a tGridData
+  void   readSlice(int slice, tGridData &) const;
+
+  static int isRasterFile(const char *);
+  static const char* labelName(const char *);
+  static int convertGrids(const char *out, int valueSize,
+                          int n, char **gridFiles);
+
+ private:
+  char       *base;               // Start of the mapped (or read) file
+  size_t      length;             // Bytes of the file
+  int         mapped;             // 1 if 'base' is a memory map
+  std::vector<char> buffer;       // File contents if it is not mapped
+  std::map<std::string, int> labels;  // Slice of each label
+
+  char*  sliceData(int) const;
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                         End of tBinaryRaster.h
+//
+//
+//=========================================================================
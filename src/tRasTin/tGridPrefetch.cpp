@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tGridPrefetch.cpp:   Functions for tGridPrefetch class
+**                       (see tGridPrefetch.h)
+**
+***************************************************************************/
+
+#include "src/tRasTin/tGridPrefetch.h"
+#include "src/tRasTin/tBinaryRaster.h"
+
+#include <fstream>
+#include <cstdio>
+
+using namespace std;
+
+//=========================================================================
+//
+//
+//                  Section 1: tGridData Functions
+//
+//
+//=========================================================================
+
+tGridData::tGridData()
+  : NR(0), MR(0), xllc(0.0), yllc(0.0), dR(0.0), dummy(0.0)
+{}
+
+/***************************************************************************
+**
+**  tGridData::read(const char *GridIn)
+**
+**  Reads a grid in the standard ArcInfo/ArcView ASCII format, in the same
+**  way as tResample::readInputGrid did before the grids could be read
+**  ahead. The first slice of a binary raster file (tBinaryRaster) is
+**  read as well. Returns 0 if the file cannot be opened.
+**
+***************************************************************************/
+int tGridData::read(const char *GridIn)
+{
+	char lineIn[300];
+	char tmp[20];
+	double tempo;
+
+	if (tBinaryRaster::isRasterFile(GridIn)) {
+		tBinaryRaster raster;
+		if (!raster.open(GridIn))
+			return 0;
+		raster.readSlice(0, *this);
+		return 1;
+	}
+
+	ifstream Inp0(GridIn);
+	if (!Inp0)
+		return 0;
+
+	Inp0.getline(lineIn, 256);
+	sscanf(lineIn, "%10s %d", tmp, &MR);
+
+	Inp0.getline(lineIn, 256);
+	sscanf(lineIn, "%10s %d", tmp, &NR);
+
+	Inp0 >> tmp >> xllc;
+	Inp0 >> tmp >> yllc;
+	Inp0 >> tmp >> dR;
+	Inp0 >> tmp >> dummy;
+
+	values.resize((size_t)NR*MR);
+	tempo = 0.0;
+	for (size_t k = 0; k < values.size(); k++) {
+		Inp0 >> tempo;
+		values[k] = tempo;
+	}
+	Inp0.close();
+	return 1;
+}
+
+//=========================================================================
+//
+//
+//                  Section 2: tGridPrefetch Functions
+//
+//
+//=========================================================================
+
+/***************************************************************************
+**
+**  tGridPrefetch::tGridPrefetch(int depth)
+**
+**  Starts the reader thread, 'depth' grids are kept ahead per series
+**
+***************************************************************************/
+tGridPrefetch::tGridPrefetch(int n)
+  : depth(n), hits(0), misses(0), stopping(false)
+{
+	if (depth < 1)
+		depth = 1;
+	worker = thread(&tGridPrefetch::workerLoop, this);
+}
+
+tGridPrefetch::~tGridPrefetch()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		stopping = true;
+	}
+	posted.notify_all();
+	if (worker.joinable())
+		worker.join();
+
+	for (size_t k = 0; k < entries.size(); k++)
+		delete entries[k];
+	entries.clear();
+}
+
+/***************************************************************************
+**
+**  tGridPrefetch::request(const char *series, const char *fileName)
+**
+**  Queues a file of an input series. When the series already has 'depth'
+**  grids waiting, its oldest one is given up to make room.
+**
+***************************************************************************/
+void tGridPrefetch::request(const char *series, const char *fileName)
+{
+	lock_guard<mutex> guard(lock);
+
+	int count = 0;
+	size_t oldest = entries.size();
+	for (size_t k = 0; k < entries.size(); k++) {
+		if (entries[k]->name == fileName)
+			return;
+		if (entries[k]->series == series) {
+			count++;
+			if (oldest == entries.size() && entries[k]->state != kReading)
+				oldest = k;
+		}
+	}
+
+	if (count >= depth) {
+		if (oldest == entries.size())
+			return;
+		dropEntry(oldest);
+	}
+
+	tEntry *entry = new tEntry;
+	entry->series = series;
+	entry->name = fileName;
+	entry->state = kQueued;
+	entries.push_back(entry);
+	posted.notify_one();
+}
+
+/***************************************************************************
+**
+**  tGridPrefetch::take(const char *fileName, tGridData &grid)
+**
+**  Hands over a prefetched grid. Grids of the same series requested
+**  before this one were skipped by the model and are given up.
+**
+***************************************************************************/
+int tGridPrefetch::take(const char *fileName, tGridData &grid)
+{
+	unique_lock<mutex> guard(lock);
+
+	size_t k;
+	for (k = 0; k < entries.size(); k++)
+		if (entries[k]->name == fileName)
+			break;
+	if (k == entries.size()) {
+		misses++;
+		return 0;
+	}
+
+	tEntry *entry = entries[k];
+	for (size_t j = 0; j < k; ) {
+		if (entries[j]->series == entry->series &&
+			entries[j]->state != kReading) {
+			dropEntry(j);
+			k--;
+		}
+		else
+			j++;
+	}
+
+	while (entry->state == kReading)
+		done.wait(guard);
+
+	int found = 0;
+	if (entry->state == kReady) {
+		grid = std::move(entry->grid);
+		found = 1;
+		hits++;
+	}
+	else
+		misses++;
+
+	for (k = 0; k < entries.size(); k++)
+		if (entries[k] == entry)
+			break;
+	dropEntry(k);
+	return found;
+}
+
+/***************************************************************************
+**
+**  tGridPrefetch::dropEntry(size_t k)
+**
+**  Removes entry k, the lock must be held and the entry not being read
+**
+***************************************************************************/
+void tGridPrefetch::dropEntry(size_t k)
+{
+	delete entries[k];
+	entries.erase(entries.begin() + k);
+}
+
+/***************************************************************************
+**
+**  tGridPrefetch::workerLoop()
+**
+**  Reads queued grids in the order requested. The file is read without
+**  the lock held, the entry cannot be removed while it is being read.
+**
+***************************************************************************/
+void tGridPrefetch::workerLoop()
+{
+	unique_lock<mutex> guard(lock);
+	while (true) {
+		tEntry *entry = nullptr;
+		for (size_t k = 0; k < entries.size() && !entry; k++)
+			if (entries[k]->state == kQueued)
+				entry = entries[k];
+
+		if (!entry) {
+			if (stopping)
+				return;
+			posted.wait(guard);
+			continue;
+		}
+		if (stopping)
+			return;
+
+		entry->state = kReading;
+		string name = entry->name;
+		guard.unlock();
+
+		tGridData grid;
+		int ok = grid.read(name.c_str());
+
+		guard.lock();
+		entry->grid = std::move(grid);
+		entry->state = ok ? kReady : kFailed;
+		done.notify_all();
+	}
+}
+
+//=========================================================================
+//
+//
+//                         End of tGridPrefetch.cpp
+//
+//
+//=========================================================================
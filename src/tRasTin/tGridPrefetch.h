@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tGridPrefetch.h:   Header File for tGridPrefetch class
+**
+**  tGridPrefetch reads time-series ASCII grids (radar rainfall and
+**  meteorological grids) ahead of the simulation on a background thread.
+**  The readers that know their upcoming file names (tRainfall, tVariant)
+**  request them through tResample; the parsed grids wait in a bounded
+**  queue per input series until tResample::readInputGrid asks for them.
+**  Grids that were not requested, or whose files could not be read, are
+**  parsed on the calling thread as before.
+**
+***************************************************************************/
+
+#ifndef  TGRIDPREFETCH_H
+#define  TGRIDPREFETCH_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//=========================================================================
+//
+//
+//                  Section 1: tGridData Class Declarations
+//
+//
+//=========================================================================
+
+/***************************************************************************
+**
+**  tGridData holds the header and the values (row by row, from the top)
+**  of one grid in the ArcInfo/ArcView ASCII format
+**
+***************************************************************************/
+
+class tGridData
+{
+ public:
+  tGridData();
+
+  int    NR;        // Rows in the grid
+  int    MR;        // Columns in the grid
+  double xllc;      // X -LOWER left corner of the grid
+  double yllc;      // Y -LOWER left corner of the grid
+  double dR;        // Spatial resolution of the grid
+  double dummy;     // NODATA value of the grid
+  std::vector<double> values;  // NR x MR values
+
+  int    read(const char *);   // Returns 0 if the file cannot be opened
+};
+
+//=========================================================================
+//
+//
+//                  Section 2: tGridPrefetch Class Declarations
+//
+//
+//=========================================================================
+
+class tGridPrefetch
+{
+ public:
+  tGridPrefetch(int);
+  ~tGridPrefetch();
+
+  int  getDepth() const { return depth; }
+
+  // Queue a grid of an input series to be read in the background
+  void request(const char *series, const char *fileName);
+  // Move a prefetched grid into 'grid', waits if it is being read.
+  // Returns 0 if the file was not requested or could not be read.
+  int  take(const char *fileName, tGridData &grid);
+
+  int  getHits() const { return hits; }
+  int  getMisses() const { return misses; }
+
+ private:
+  enum { kQueued, kReading, kReady, kFailed };
+
+  struct tEntry {
+    std::string series;
+    std::string name;
+    int         state;
+    tGridData   grid;
+  };
+
+  void workerLoop();
+  void dropEntry(size_t);
+
+  int depth;                        // Grids kept ahead per input series
+  int hits, misses;                 // Grids taken / not found
+  bool stopping;
+  std::deque<tEntry*> entries;      // In the order requested
+  std::thread worker;
+  std::mutex lock;
+  std::condition_variable posted;   // New request or stop
+  std::condition_variable done;     // A grid was read
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                         End of tGridPrefetch.h
+//
+//
+//=========================================================================
@@ -195,26 +195,16 @@ int tRainfall::Compose_In_Mrain_Name(tRunTimer *t)
 	// Read rainfall file depending on forecast state
 	if (fState == 0) {
 		
-		if (t->minuteRn || t->dtRain < 1) //If 'minute' is NOT equal to '0'  
-			snprintf(mrainfileIn,sizeof(mrainfileIn), "%s%02d%02d%04d%02d%02d.%s", inputname,
-					t->monthRn, t->dayRn, t->yearRn, t->hourRn, t->minuteRn, extension);//WR--09192023:'sprintf' is deprecated: This function is provided for compatibility reasons only.
-		else {           //If 'minute' IS equal to '0'
-			snprintf(mrainfileIn,sizeof(mrainfileIn),"%s%02d%02d%04d%02d.%s", inputname,
-					t->monthRn, t->dayRn, t->yearRn, t->hourRn, extension);//WR--09192023:'sprintf' is deprecated: This function is provided for compatibility reasons only.
-		}
+		Compose_Mrain_Name(mrainfileIn, sizeof(mrainfileIn), inputname, t,
+						   t->monthRn, t->dayRn, t->yearRn, t->hourRn, t->minuteRn);
 		infile.open(mrainfileIn);
 	}
 	
 	else if (fState == 1) {
 		
 		if (t->getoptForecast() == 1) {
-			if (t->minuteRn || t->dtRain < 1) //If 'minute' is NOT equal to '0'  
-				snprintf(mrainfileIn,sizeof(mrainfileIn), "%s%02d%02d%04d%02d%02d.%s", forecastname,
-						t->monthRn, t->dayRn, t->yearRn, t->hourRn, t->minuteRn, extension); //WR--09192023:'sprintf' is deprecated: This function is provided for compatibility reasons only.
-			else {           //If 'minute' IS equal to '0'
-				snprintf(mrainfileIn,sizeof(mrainfileIn),"%s%02d%02d%04d%02d.%s", forecastname,
-						t->monthRn, t->dayRn, t->yearRn, t->hourRn, extension);//WR--09192023:'sprintf' is deprecated: This function is provided for compatibility reasons only.
-			}
+			Compose_Mrain_Name(mrainfileIn, sizeof(mrainfileIn), forecastname, t,
+							   t->monthRn, t->dayRn, t->yearRn, t->hourRn, t->minuteRn);
 			infile.open(mrainfileIn);
 		}
 		else if (t->getoptForecast() == 2) {   //Persistence
@@ -228,6 +218,10 @@ int tRainfall::Compose_In_Mrain_Name(tRunTimer *t)
 	else if (fState == 2)
 		return 1;
 	
+	// Grids in the binary grid archive have no file of their own
+	if (respPtr->isGridInArchive(mrainfileIn))
+		return 1;
+	
 	// Check if file opened
 #ifdef ALPHA_64
     if ( !infile )
@@ -248,6 +242,65 @@ int tRainfall::Compose_In_Mrain_Name(tRunTimer *t)
 	}
 }
 
+/***************************************************************************
+**
+**  tRainfall::Compose_Mrain_Name()
+**
+**  Composes the name of the rainfall file with prefix 'base' for the
+**  given calendar time
+**
+***************************************************************************/
+void tRainfall::Compose_Mrain_Name(char *name, int size, const char *base,
+								   tRunTimer *t, int mo, int dy, int yr,
+								   int hr, int mi)
+{
+	if (mi || t->dtRain < 1) //If 'minute' is NOT equal to '0'  
+		snprintf(name, size, "%s%02d%02d%04d%02d%02d.%s", base,
+				mo, dy, yr, hr, mi, extension);
+	else            //If 'minute' IS equal to '0'
+		snprintf(name, size, "%s%02d%02d%04d%02d.%s", base,
+				mo, dy, yr, hr, extension);
+	return;
+}
+
+/***************************************************************************
+**
+**  tRainfall::PrefetchRain(tRunTimer *t)
+**
+**  Asks tResample to read the rainfall files of the next rainfall times
+**  ahead, advancing a copy of the rainfall calendar time as
+**  tRunTimer::addRainTime does. Missing files are simply not found by
+**  the background reader and searched for as before.
+**
+***************************************************************************/
+void tRainfall::PrefetchRain(tRunTimer *t)
+{
+	int depth = respPtr->getPrefetchDepth();
+	if (depth == 0)
+		return;
+
+	const char *base;
+	if (fState == 0)
+		base = inputname;
+	else if (fState == 1 && t->getoptForecast() == 1)
+		base = forecastname;
+	else
+		return;
+
+	int mi = t->minuteRn, hr = t->hourRn, dy = t->dayRn;
+	int mo = t->monthRn, yr = t->yearRn;
+	double rainTime = t->getRainTime();
+	char name[kMaxNameSize];
+
+	for (int k = 0; k < depth; k++) {
+		rainTime += t->dtRain;
+		t->correctCalendarTime(rainTime, t->dtRain, &mi, &hr, &dy, &mo, &yr);
+		Compose_Mrain_Name(name, sizeof(name), base, t, mo, dy, yr, hr, mi);
+		respPtr->prefetchGrid(inputname, name);
+	}
+	return;
+}
+
 /***************************************************************************
 **
 **  tRainfall::NewRain()
@@ -318,6 +371,9 @@ void tRainfall::NewRain(tRunTimer *t)
 	if (fState == 0 || fState == 1) {
 		
 		curRain = respPtr->doIt(mrainfileIn, 1);
+
+		// Read the next rainfall files while this interval is simulated
+		PrefetchRain(t);
 		
 		// Check Valid Rainfall and Compute MAP 
 		while( nodeIter.IsActive() ) {
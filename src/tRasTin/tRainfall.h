@@ -42,6 +42,9 @@ public:
   SimulationControl *simCtrl;    
   
   int  Compose_In_Mrain_Name(tRunTimer *);
+  void Compose_Mrain_Name(char *, int, const char *, tRunTimer *,
+                          int, int, int, int, int);
+  void PrefetchRain(tRunTimer *);
   void SetRainVariables(tInputFile &);  
   void NewRain();
   void NewRain(double);
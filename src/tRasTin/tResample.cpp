@@ -14,6 +14,8 @@
 ***************************************************************************/
 
 #include "src/tRasTin/tResample.h"
+#include "src/tRasTin/tGridPrefetch.h"
+#include "src/tRasTin/tBinaryRaster.h"
 #include "src/Headers/globalIO.h"
 
 //=========================================================================
@@ -68,6 +70,88 @@ tResample::tResample(SimulationControl *simCtrPtr, tMesh<tCNode> * gridPtr)
 	dR = dummy = 0.0;
 	xllcR=yllcR=xulcR=yulcR=0.0;
 
+	// Overlap weights are kept in memory by default
+	cacheOption = 1;
+	cacheDir[0] = '\0';
+	computeMeshSignature();
+
+	// Grids are read when needed unless OPTGRIDPREFETCH is set
+	prefetch = NULL;
+
+	// Binary rasters
+	archive = NULL;
+	rasterIn = NULL;
+	gridInMapped = 0;
+}
+
+/***************************************************************************
+**
+**  tResample::tResample(SimulationControl*, tMesh<tCNode>*, tInputFile&)
+**
+**  Same as above, but reads the optional caching keywords for the
+**  Voronoi-grid overlap weights:
+**   OPTRESAMPLECACHE  0 - no caching, 1 - memory (default), 2 - memory
+**                     and disk (weights are reused by restarts/other runs)
+**   RESAMPLECACHEDIR  directory (or path prefix) for the weight files
+**  and the number of rainfall/meteorological grids of each series to be
+**  read ahead on a background thread:
+**   OPTGRIDPREFETCH   0 - grids are read when needed (default), N > 0 -
+**                     up to N upcoming grids per series are read ahead
+**  and an optional binary raster file holding many grids:
+**   GRIDARCHIVE       tBinaryRaster file, grids whose file names match
+**                     one of its slice labels are taken from it
+**
+***************************************************************************/
+tResample::tResample(SimulationControl *simCtrPtr, tMesh<tCNode> * gridPtr,
+					 tInputFile &infile) : tResample(simCtrPtr, gridPtr)
+{
+	if (infile.IsItemIn( "OPTRESAMPLECACHE" ))
+		cacheOption = infile.ReadItem(cacheOption, "OPTRESAMPLECACHE");
+
+	if (cacheOption < 0 || cacheOption > 2) {
+		Cout<<"\ntResample: Warning: OPTRESAMPLECACHE = "<<cacheOption
+			<<" is not valid, using memory cache (1)"<<endl;
+		cacheOption = 1;
+	}
+
+	if (cacheOption == 2) {
+		if (infile.IsItemIn( "RESAMPLECACHEDIR" ))
+			infile.ReadItem(cacheDir, "RESAMPLECACHEDIR");
+		else {
+			Cout<<"\ntResample: Warning: RESAMPLECACHEDIR is not specified, "
+				<<"overlap weights will not be written to disk"<<endl;
+			cacheOption = 1;
+		}
+	}
+
+	int depth = 0;
+	if (infile.IsItemIn( "OPTGRIDPREFETCH" ))
+		depth = infile.ReadItem(depth, "OPTGRIDPREFETCH");
+	if (depth < 0) {
+		Cout<<"\ntResample: Warning: OPTGRIDPREFETCH = "<<depth
+			<<" is not valid, grids will not be read ahead"<<endl;
+		depth = 0;
+	}
+	if (depth > 0) {
+		prefetch = new tGridPrefetch(depth);
+		Cout<<"\ntResample: Reading up to "<<depth
+			<<" grid(s) per input series ahead"<<endl;
+	}
+
+	if (infile.IsItemIn( "GRIDARCHIVE" )) {
+		char archiveName[kMaxNameSize];
+		infile.ReadItem(archiveName, "GRIDARCHIVE");
+		archive = new tBinaryRaster();
+		if (!archive->open(archiveName)) {
+			Cout<<"\ntResample: Error: GRIDARCHIVE "<<archiveName
+				<<" is not a valid binary raster file"<<endl;
+			Cout<<"Exiting Program..."<<endl<<endl;
+			exit(2);
+		}
+		Cout<<"\ntResample: Grid archive "<<archiveName<<" holds "
+			<<archive->nSlices<<" grid(s) of "<<archive->NR<<" x "
+			<<archive->MR<<endl;
+	}
 }
 
 tResample::~tResample()
@@ -86,6 +170,19 @@ tResample::~tResample()
 	mew = NULL;
 	if ( eta )
 		delete eta;
+
+	for (size_t k=0; k < overlapCache.size(); k++)
+		delete overlapCache[k];
+	overlapCache.clear();
+
+	if (prefetch) {
+		Cout<<"tResample: "<<prefetch->getHits()<<" grid(s) read ahead, "
+			<<prefetch->getMisses()<<" read when needed"<<endl;
+		delete prefetch;
+		prefetch = NULL;
+	}
+	delete archive;
+	delete rasterIn;
 	
 	Cout<<"tResample Object has been destroyed..."<<endl<<flush;
 	return;
@@ -93,9 +190,14 @@ tResample::~tResample()
 
 void tResample::DestrtResample()
 {
-	for (int i=0; i<NR; i++)
-		delete [] gridIn[i];
+	// Rows in a binary raster belong to the raster
+	if (!gridInMapped)
+		for (int i=0; i<NR; i++)
+			delete [] gridIn[i];
 	delete [] gridIn;
+	gridInMapped = 0;
+	if (rasterIn)
+		rasterIn->close();
 	delete [] coorXG;
 	delete [] coorYG;
 	return;
@@ -930,32 +1032,49 @@ double* tResample::doIt(char *GridIn, int flag)
 	
 	// Reads Input Grid
 	readInputGrid(GridIn);
+
+	// Overlap weights of this grid geometry, if cached or to be built
+	int build = 0;
+	tOverlapWeights *weights = findOverlapWeights(flag, &build);
 	
 	int i=0;
 	for (cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP()) {
-		
-		// Initialize current Cell
-		eta->initializeVCell(simCtrl, this, vXs[i], vYs[i], nPoints[i]);
 
-		// Assign YmaxInd, YminInd, etc. to tCNode to increase efficiency
-		// NOTE: NOT done yet
+		// Sparse matrix-vector product with the cached weights
+		if (weights && !build && weights->state[i] != kOverlapDirect) {
+			varFromGrid[i] = weights->apply(i, gridIn);
+		}
+		else {
+			// Initialize current Cell
+			eta->initializeVCell(simCtrl, this, vXs[i], vYs[i], nPoints[i]);
+
+			// Assign YmaxInd, YminInd, etc. to tCNode to increase efficiency
+			// NOTE: NOT done yet
 		
-		// Get an appropriate grid value
-		varFromGrid[i] = dummy;
-		varFromGrid[i] = eta->convertToVoronoiFormat(flag);
+			// Get an appropriate grid value, recording the weights of 
+			// the grid cells when they are built
+			varFromGrid[i] = dummy;
+			varFromGrid[i] = eta->convertToVoronoiFormat(flag, 
+										build ? weights : NULL);
+			if (build)
+				finishOverlapWeights(i, varFromGrid[i], weights);
+		
+			// Destroy temporary arrays in 'vCell'
+			eta->DestrtvCell();
+		}
 		
     // Set resample index for nodes
     cn->setResIndex(i);
 		
-		// Destroy temporary arrays in 'vCell'
-		eta->DestrtvCell();
-		
 		// Check if there is a problem with the value
 		if (varFromGrid[i] == dummy)
 			NodesLst.insertAtBack( (tCNode*)cn );
 		
 		i++;
 	}
+
+	if (build)
+		storeOverlapWeights(weights);
 	
 	// Run the correction procedure if needed
 	for ( cn=NodesIter.FirstP(); !(NodesIter.AtEnd()); cn=NodesIter.NextP() )
@@ -1065,50 +1184,132 @@ int* tResample::doIt(int *statID, double *XX, double *YY, int NN)
 ***************************************************************************/
 void tResample::readInputGrid(char *GridIn) 
 {
-	int i,j;
-	double tempo, mott;
-	char lineIn[300];
-	char tmp[20];
+	int slice;
+	tGridData grid;
 	
-	ifstream Inp0(GridIn);
-	if (!Inp0) {
-		cout <<"File "<<GridIn<<" not found!!!"<<endl;
-		cout<<", tResample.cpp Error Location"<<endl;
-		exit(2);
+	// Grid archive, prefetched grid, binary raster file or ASCII grid
+	if (archive && (slice = archive->findSlice(GridIn)) >= 0) {
+		setGridRows(archive, slice);
+	}
+	else if (prefetch && prefetch->take(GridIn, grid)) {
+		setGridRows(grid);
+	}
+	else if (tBinaryRaster::isRasterFile(GridIn)) {
+		if (!rasterIn)
+			rasterIn = new tBinaryRaster();
+		if (!rasterIn->open(GridIn)) {
+			cout <<"File "<<GridIn<<" is not a valid binary raster!!!"<<endl;
+			cout<<", tResample.cpp Error Location"<<endl;
+			exit(2);
+		}
+		setGridRows(rasterIn, 0);
+	}
+	else {
+		if (!grid.read(GridIn)) {
+			cout <<"File "<<GridIn<<" not found!!!"<<endl;
+			cout<<", tResample.cpp Error Location"<<endl;
+			exit(2);
+		}
+		setGridRows(grid);
 	}
 	
-	Inp0.getline(lineIn, 256);
-	sscanf(lineIn, "%10s %d", tmp, &MR);
-	
-	Inp0.getline(lineIn, 256);
-	sscanf(lineIn, "%10s %d", tmp, &NR);
-	
-	Inp0 >> tmp >> xllcR;
-	Inp0 >> tmp >> yllcR;
-	Inp0 >> tmp >> dR;
-	Inp0 >> tmp >> dummy;
+	setGridCoordinates();
+	return;
+}
+
+/***************************************************************************
+**
+**  tResample::setGridRows()
+**
+**  Sets the grid header and 'gridIn' from a slice of a binary raster or
+**  from a grid that has been read. Rows of float64 rasters are used in
+**  place (read only, see copyGridRows), other rows are allocated and
+**  copied.
+**
+***************************************************************************/
+void tResample::setGridRows(tBinaryRaster *raster, int slice)
+{
+	MR = raster->MR;
+	NR = raster->NR;
+	xllcR = raster->xllc;
+	yllcR = raster->yllc;
+	dR = raster->dR;
+	dummy = raster->dummy;
 	
-	coorYG = new double [NR+1];  //NR+1
-	assert(coorYG != 0);
-	coorXG = new double [MR+1];  //MR+1
-	assert(coorXG != 0);
+	gridIn = new double* [NR]; 
+	assert(gridIn != 0);
 	
-	for (i=0; i < NR+1; i++)
-		coorYG[i] = 0.;
-	for (j=0; j < MR+1; j++)
-		coorXG[j] = 0.;
+	gridInMapped = (raster->valueSize == 8);
+	for (int i=0; i < NR; i++)  {
+		if (gridInMapped)
+			gridIn[i] = const_cast<double *>(raster->getRow(slice, i));
+		else {
+			gridIn[i] = new double[MR];
+			raster->readRow(slice, i, gridIn[i]);
+		}
+	}
+	return;
+}
+
+void tResample::setGridRows(tGridData &grid)
+{
+	MR = grid.MR;
+	NR = grid.NR;
+	xllcR = grid.xllc;
+	yllcR = grid.yllc;
+	dR = grid.dR;
+	dummy = grid.dummy;
 	
 	gridIn = new double* [NR]; 
 	assert(gridIn != 0);
 	
-	for (i=0; i < NR; i++)  {
+	gridInMapped = 0;
+	for (int i=0; i < NR; i++)  {
 		gridIn[i] = new double[MR];
 		assert(gridIn[i] != 0);
-		for (j=0; j < MR; j++)    {
-			Inp0 >> tempo;
-			gridIn[i][j] = tempo;
-		}
+		for (int j=0; j < MR; j++)
+			gridIn[i][j] = grid.values[(size_t)i*MR + j];
 	}
+	return;
+}
+
+/***************************************************************************
+**
+**  tResample::copyGridRows()
+**
+**  Copies the rows of 'gridIn' used in place from a binary raster, which
+**  are read only, for callers that change the values of the grid
+**
+***************************************************************************/
+void tResample::copyGridRows()
+{
+	if (!gridInMapped)
+		return;
+	for (int i=0; i < NR; i++)  {
+		double *row = new double[MR];
+		memcpy(row, gridIn[i], MR*sizeof(double));
+		gridIn[i] = row;
+	}
+	gridInMapped = 0;
+	return;
+}
+
+/***************************************************************************
+**
+**  tResample::setGridCoordinates()
+**
+**  Computes the coordinates of the grid lines from the grid header
+**
+***************************************************************************/
+void tResample::setGridCoordinates()
+{
+	int i,j;
+	double tempo, mott;
+	
+	coorYG = new double [NR+1];  //NR+1
+	assert(coorYG != 0);
+	coorXG = new double [MR+1];  //MR+1
+	assert(coorXG != 0);
 	
 	// Get upper left corner coordinates
 	xulcR = xllcR;
@@ -1124,10 +1325,42 @@ void tResample::readInputGrid(char *GridIn)
 		coorXG[j] = mott;
 		mott += dR;
 	}
-	Inp0.close();
 	return;
 }
 
+/***************************************************************************
+**
+**  tResample::isGridInArchive(const char *GridIn)
+**
+**  Is the grid file one of the slices of the grid archive?
+**
+***************************************************************************/
+int tResample::isGridInArchive(const char *GridIn)
+{
+	return (archive && archive->findSlice(GridIn) >= 0);
+}
+
+/***************************************************************************
+**
+**  tResample::prefetchGrid(const char *series, const char *GridIn)
+**
+**  Asks for grid 'GridIn' of an input series (e.g. the rainfall or air
+**  temperature file prefix) to be read ahead. Does nothing if the grids
+**  are not read ahead.
+**
+***************************************************************************/
+void tResample::prefetchGrid(const char *series, const char *GridIn)
+{
+	if (prefetch && !isGridInArchive(GridIn))
+		prefetch->request(series, GridIn);
+	return;
+}
+
+int tResample::getPrefetchDepth()
+{
+	return prefetch ? prefetch->getDepth() : 0;
+}
+
 /***************************************************************************
 **
 **  tResample::In_Mrain_Name( )
@@ -1176,6 +1409,245 @@ void tResample::PrintEdgeInfo(tEdge *be)
 }
 
 
+/***************************************************************************
+**
+**  hashBytes()
+**
+**  64-bit FNV-1a hash used to identify grid geometries and Voronoi meshes
+**
+***************************************************************************/
+static unsigned long long hashBytes(unsigned long long h, const void *data,
+									size_t n)
+{
+	const unsigned char *p = (const unsigned char *)data;
+	for (size_t k=0; k < n; k++) {
+		h ^= (unsigned long long)p[k];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+/***************************************************************************
+**
+**  tResample::computeMeshSignature()
+**
+**  Hashes the vertices of all Voronoi polygons so that weights written to
+**  disk are only reused with the mesh (or partition) they were built for
+**
+***************************************************************************/
+void tResample::computeMeshSignature()
+{
+	unsigned long long h = 14695981039346656037ULL;
+	h = hashBytes(h, &NVor, sizeof(int));
+	for (int i=0; i < NVor; i++) {
+		h = hashBytes(h, &nPoints[i], sizeof(int));
+		if (nPoints[i] > 0) {
+			h = hashBytes(h, vXs[i], nPoints[i]*sizeof(double));
+			h = hashBytes(h, vYs[i], nPoints[i]*sizeof(double));
+		}
+	}
+	meshSignature = h;
+	return;
+}
+
+/***************************************************************************
+**
+**  tResample::gridSignature(int flag)
+**
+**  Hashes the header, the resampling option and the NODATA mask of the 
+**  grid currently in 'gridIn'. The overlap weights only depend on these,
+**  not on the grid values themselves.
+**
+***************************************************************************/
+unsigned long long tResample::gridSignature(int flag)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	h = hashBytes(h, &flag, sizeof(int));
+	h = hashBytes(h, &NR, sizeof(int));
+	h = hashBytes(h, &MR, sizeof(int));
+	h = hashBytes(h, &xllcR, sizeof(double));
+	h = hashBytes(h, &yllcR, sizeof(double));
+	h = hashBytes(h, &dR, sizeof(double));
+	h = hashBytes(h, &dummy, sizeof(double));
+
+	std::vector<unsigned char> mask(MR);
+	for (int i=0; i < NR; i++) {
+		for (int j=0; j < MR; j++)
+			mask[j] = (gridIn[i][j] == dummy);
+		h = hashBytes(h, mask.data(), MR);
+	}
+	return h;
+}
+
+/***************************************************************************
+**
+**  tResample::gridChecksum()
+**
+**  Hashes the header and all values of the grid currently in 'gridIn',
+**  used to identify results derived from a particular grid (e.g. the
+**  horizon angles of a DEM in tShelter)
+**
+***************************************************************************/
+unsigned long long tResample::gridChecksum()
+{
+	unsigned long long h = 14695981039346656037ULL;
+	h = hashBytes(h, &NR, sizeof(int));
+	h = hashBytes(h, &MR, sizeof(int));
+	h = hashBytes(h, &xllcR, sizeof(double));
+	h = hashBytes(h, &yllcR, sizeof(double));
+	h = hashBytes(h, &dR, sizeof(double));
+	h = hashBytes(h, &dummy, sizeof(double));
+	for (int i=0; i < NR; i++)
+		h = hashBytes(h, gridIn[i], MR*sizeof(double));
+	return h;
+}
+
+/***************************************************************************
+**
+**  tResample::composeCacheName()
+**
+**  Returns 0 if the name does not fit (the disk cache is then skipped)
+**
+***************************************************************************/
+int tResample::composeCacheName(char *name, unsigned long long sig)
+{
+	int len = snprintf(name, kMaxNameSize, "%srsw_%016llx_%016llx.bin",
+					   cacheDir, sig, meshSignature);
+	return (len >= 0 && len < kMaxNameSize) ? 1 : 0;
+}
+
+/***************************************************************************
+**
+**  tResample::findOverlapWeights(int flag, int *build)
+**
+**  Returns the cached overlap weights for the grid in 'gridIn', loading
+**  them from disk if available. If they are not cached, a new (empty)
+**  object is returned and 'build' is set so that doIt() records the 
+**  weights while resampling. In memory-only mode the weights are built
+**  the second time a geometry is read, so that grids read only once 
+**  (e.g. soil and land use maps) do not pay for building them.
+**
+***************************************************************************/
+tOverlapWeights* tResample::findOverlapWeights(int flag, int *build)
+{
+	char name[kMaxNameSize];
+	tOverlapWeights *weights;
+
+	*build = 0;
+	if (cacheOption == 0)
+		return NULL;
+
+	unsigned long long sig = gridSignature(flag);
+	for (size_t k=0; k < overlapCache.size(); k++) {
+		if (overlapCache[k]->matches(sig, flag, NVor, NR, MR, 
+									 xllcR, yllcR, dR, dummy))
+			return overlapCache[k];
+	}
+
+	if (cacheOption == 2 && composeCacheName(name, sig)) {
+		weights = new tOverlapWeights();
+		if (weights->read(name, meshSignature) &&
+			weights->matches(sig, flag, NVor, NR, MR, xllcR, yllcR, dR, dummy)) {
+			if (simCtrl->Verbose_label == 'Y')
+				Cout<<"tResample: Read overlap weights from "<<name<<endl;
+			storeOverlapWeights(weights);
+			return weights;
+		}
+		delete weights;
+	}
+
+	if (cacheOption == 1 && ++gridsSeen[sig] < 2)
+		return NULL;
+
+	weights = new tOverlapWeights();
+	weights->signature = sig;
+	weights->flag = flag;
+	weights->NVor = NVor;
+	weights->NR = NR;
+	weights->MR = MR;
+	weights->xllc = xllcR;
+	weights->yllc = yllcR;
+	weights->dR = dR;
+	weights->dummy = dummy;
+	weights->state.assign(NVor, kOverlapDirect);
+	weights->rowPtr.assign(NVor+1, 0);
+	*build = 1;
+	return weights;
+}
+
+/***************************************************************************
+**
+**  tResample::finishOverlapWeights(int id, double value, ...)
+**
+**  Closes the row of node 'id', whose weights have been recorded by
+**  vCell::convertToVoronoiFormat. The weights are accepted only if they
+**  reproduce 'value', the result of the direct computation; otherwise
+**  the node keeps being resampled directly.
+**
+***************************************************************************/
+void tResample::finishOverlapWeights(int id, double value,
+									 tOverlapWeights *weights)
+{
+	int start = weights->rowPtr[id];
+	weights->rowPtr[id+1] = (int)weights->weight.size();
+
+	if (value == dummy) {
+		weights->state[id] = kOverlapDummy;
+		return;
+	}
+
+	weights->state[id] = kOverlapSparse;
+	double check = weights->apply(id, gridIn);
+	if (weights->rowPtr[id+1] == start ||
+		fabs(check - value) > 1.0E-9*max(1.0, fabs(value))) {
+		weights->state[id] = kOverlapDirect;
+		weights->cellIdx.resize(start);
+		weights->weight.resize(start);
+		weights->rowPtr[id+1] = start;
+	}
+	return;
+}
+
+/***************************************************************************
+**
+**  tResample::storeOverlapWeights(tOverlapWeights *weights)
+**
+**  Keeps the weights in memory (dropping the oldest geometry when the 
+**  cache is full) and writes them to disk if requested
+**
+***************************************************************************/
+void tResample::storeOverlapWeights(tOverlapWeights *weights)
+{
+	char name[kMaxNameSize];
+	int known = 0;
+
+	for (size_t k=0; k < overlapCache.size(); k++)
+		if (overlapCache[k] == weights)
+			known = 1;
+
+	if (!known) {
+		if (overlapCache.size() >= kMaxOverlapCache) {
+			delete overlapCache.front();
+			overlapCache.erase(overlapCache.begin());
+		}
+		overlapCache.push_back(weights);
+	}
+
+	if (cacheOption == 2 && !known && 
+		composeCacheName(name, weights->signature)) {
+		ifstream exists(name);
+		if (!exists) {
+			if (weights->write(name, meshSignature)) {
+				if (simCtrl->Verbose_label == 'Y')
+					Cout<<"tResample: Wrote overlap weights to "<<name<<endl;
+			}
+			else
+				Cout<<"tResample: Warning: could not write "<<name<<endl;
+		}
+	}
+	return;
+}
+
 //=========================================================================
 //
 //
@@ -1191,6 +1663,8 @@ vCell::vCell() {
 	VoronX = NULL;
 	VoronY = NULL;
 	base   = NULL; 
+	record = NULL;
+	recordStart = 0;
 	
 	xMax = -999.0;
 	yMax = -999.0;
@@ -1202,6 +1676,8 @@ vCell::vCell(SimulationControl *simCtrPtr, tResample *tres, double *x,
 			 double *y, int n) 
 {  
 	simCtrl = simCtrPtr;
+	record = NULL;
+	recordStart = 0;
 	initializeVCell(simCtrl, tres, x, y, n);
 	
 }
@@ -1580,12 +2056,14 @@ double vCell::findDistance(double x1, double y1, double x2, double y2)
 
 /***************************************************************************
 **
-**  vCell::convertToVoronoiFormat(int flag)
+**  vCell::convertToVoronoiFormat(int flag, tOverlapWeights *weights)
 **
-**  Function:  convertToVoronoiFormat(int flag)
+**  Function:  convertToVoronoiFormat(int flag, tOverlapWeights *weights)
 **  Arguments: * flag of the option should be used: 
 **       '1'-to use weighted average
 **       '2'- to use a discrete grid value 
+**             * weights: if not NULL, the weight of each grid cell in
+**               the value is appended to its arrays (see addWeight)
 **     - input GRID dimensions must be set before: NR, MR
 **     - GRID values must be read 
 **     - arrays of node coordinates *coorXG[MR+1]* *coorYG[NR+1]* must be defined 
@@ -1594,8 +2072,10 @@ double vCell::findDistance(double x1, double y1, double x2, double y2)
 **  Return value: value of variable extracted from the input GRID
 **  
 ***************************************************************************/
-double vCell::convertToVoronoiFormat(int flag)
+double vCell::convertToVoronoiFormat(int flag, tOverlapWeights *weights)
 {
+	record = weights;
+	recordStart = weights ? weights->weight.size() : 0;
 	
 	// GMnSKY2008MLE
 	//int i, ii, L, M, l, m;
@@ -1702,8 +2182,10 @@ double vCell::convertToVoronoiFormat(int flag)
 		}
 		
 		
-		if (base->gridIn[M][L] != base->dummy)
+		if (base->gridIn[M][L] != base->dummy) {
 			value = base->gridIn[M][L];
+			addWeight(M, L, 1.0);
+		}
 		else {
 			cout<<"\n\n\tWarning! tResample::convertToVoronoiFormat: CASE #00\n"
 			<<"The current cell is not within the grid domain!"<<endl;
@@ -1718,8 +2200,10 @@ double vCell::convertToVoronoiFormat(int flag)
 		
 		// The cell is completely within 1 grid cell
 		if (abs(YmaxInd-YminInd)==1 && abs(XmaxInd-XminInd)==1) {
-			if (base->gridIn[YminInd][XminInd] != base->dummy)
+			if (base->gridIn[YminInd][XminInd] != base->dummy) {
 				value = base->gridIn[YminInd][XminInd];
+				addWeight(YminInd, XminInd, 1.0);
+			}
 			else {
 				cout<<"\n\n\tWarning! tResample::convertToVoronoiFormat: CASE #1\n"
 				<<"The current cell is NOT within the grid domain!"<<endl;
@@ -1769,6 +2253,8 @@ double vCell::convertToVoronoiFormat(int flag)
 				areaT = area1 + area2;
 				value = (base->gridIn[YminInd][XminInd]*area1 +
 						 base->gridIn[YminInd+1][XminInd]*area2)/areaT;
+				addWeight(YminInd, XminInd, area1/areaT);
+				addWeight(YminInd+1, XminInd, area2/areaT);
 			
 				// GMnSKY2008MLE
 				// deallocate memory
@@ -1789,12 +2275,14 @@ double vCell::convertToVoronoiFormat(int flag)
 			else if ((base->gridIn[YminInd][XminInd]   == base->dummy) &&
 					 (base->gridIn[YminInd+1][XminInd] != base->dummy) ) {
 				value = base->gridIn[YminInd+1][XminInd];
+				addWeight(YminInd+1, XminInd, 1.0);
 			}
 			// Current Voronoi cell is partly outside of the grid domain
 			// A value of an adjacent non-void grid cell is assigned
 			else if ((base->gridIn[YminInd][XminInd]   != base->dummy) &&
 					 (base->gridIn[YminInd+1][XminInd] == base->dummy) ) {
 				value = base->gridIn[YminInd][XminInd];
+				addWeight(YminInd, XminInd, 1.0);
 			}
 			// Current Voronoi cell is not within the grid domain
 			// A dummy value is accepted (will be modified later)
@@ -1844,6 +2332,8 @@ double vCell::convertToVoronoiFormat(int flag)
 				areaT = area1 + area2;
 				value = (base->gridIn[YminInd][XminInd]*area2 +
 						 base->gridIn[YminInd][XminInd+1]*area1)/areaT;
+				addWeight(YminInd, XminInd, area2/areaT);
+				addWeight(YminInd, XminInd+1, area1/areaT);
 			
 				// GMnSKY2008MLE
 				// deallocate memory
@@ -1864,12 +2354,14 @@ double vCell::convertToVoronoiFormat(int flag)
 			else if ((base->gridIn[YminInd][XminInd]   == base->dummy) && 
 					 (base->gridIn[YminInd][XminInd+1] != base->dummy) ) {
 				value = base->gridIn[YminInd][XminInd+1];
+				addWeight(YminInd, XminInd+1, 1.0);
 			}
 			// Current Voronoi cell is partly outside of the grid domain
 			// A value of an adjacent non-void grid cell is assigned
 			else if ((base->gridIn[YminInd][XminInd]   != base->dummy) && 
 					 (base->gridIn[YminInd][XminInd+1] == base->dummy) ) {
 				value = base->gridIn[YminInd][XminInd];
+				addWeight(YminInd, XminInd, 1.0);
 			}
 			// Current Voronoi cell is not within the grid domain
 			// A dummy value is accepted (will be modified later)
@@ -1984,8 +2476,10 @@ double vCell::convertToVoronoiFormat(int flag)
 					areaT -= area1;
 					cntr++;
 				}
-				else 
+				else {
 					value += base->gridIn[YminInd][XminInd+1]*area1;
+					addWeight(YminInd, XminInd+1, area1);
+				}
 			}
 			if (m > 0) { //If polygon has area at all...
 				area2 = polygonArea(pxy_2, m);
@@ -1995,8 +2489,10 @@ double vCell::convertToVoronoiFormat(int flag)
 					areaT -= area2;
 					cntr++;
 				}
-				else 
+				else {
 					value += base->gridIn[YminInd][XminInd]*area2;
+					addWeight(YminInd, XminInd, area2);
+				}
 			}
 			
 			// GMnSKY2008MLE
@@ -2068,8 +2564,10 @@ double vCell::convertToVoronoiFormat(int flag)
 					areaT -= area1;
 					cntr++;
 				}
-				else 
+				else {
 					value += base->gridIn[YminInd+1][XminInd+1]*area1;
+					addWeight(YminInd+1, XminInd+1, area1);
+				}
 			}
 			
 			if (m > 0) {
@@ -2080,12 +2578,16 @@ double vCell::convertToVoronoiFormat(int flag)
 					areaT -= area2;
 					cntr++;
 				}
-				else 
+				else {
 					value += base->gridIn[YminInd+1][XminInd]*area2;
+					addWeight(YminInd+1, XminInd, area2);
+				}
 			}
 			
-			if (cntr != 4)
+			if (cntr != 4) {
 				value /= areaT;
+				scaleWeights(1.0/areaT);
+			}
 			// Current Voronoi cell is not within the grid domain
 			// A dummy value is accepted (will be modified later)
 			else {
@@ -2454,7 +2956,8 @@ double vCell::convertToVoronoiFormat(int flag)
 						{
 							//all the way in
 							fracOfGrid += 1.0;
-							weightedAveSum += 1.0*base->gridIn[i_row][i_col];						
+							weightedAveSum += 1.0*base->gridIn[i_row][i_col];
+							addWeight(i_row, i_col, 1.0);						
 						}
 						else 
 						// here we have different cases:
@@ -2648,7 +3151,8 @@ double vCell::convertToVoronoiFormat(int flag)
 										area1 = fabs(area1);
 									//find fraction of area IN the polygon
 									fracOfGrid += area1/(base->dR * base->dR);
-									weightedAveSum += (area1/(base->dR * base->dR)) * base->gridIn[i_row][i_col];	
+									weightedAveSum += (area1/(base->dR * base->dR)) * base->gridIn[i_row][i_col];
+									addWeight(i_row, i_col, area1/(base->dR * base->dR));	
 								}
 							}//end else of the if (ind_poly < 3)							
 							// deallocate memory							
@@ -2665,6 +3169,7 @@ double vCell::convertToVoronoiFormat(int flag)
 			}//i_col-for			
             if (fracOfGrid > 1e-9) { // Use a small tolerance
                 value = (weightedAveSum / fracOfGrid);
+                scaleWeights(1.0/fracOfGrid);
             }
             else {
                 // If no overlap was found, the algorithm failed.
@@ -2713,8 +3218,10 @@ double vCell::convertToVoronoiFormat(int flag)
 				findCorrespInd(VoronX[ii], VoronY[ii], &L, &M);
 			}
 			
-			if (base->gridIn[M][L] != base->dummy)
+			if (base->gridIn[M][L] != base->dummy) {
 				value = base->gridIn[M][L];
+				addWeight(M, L, 1.0);
+			}
 			// Current Voronoi cell is not within the grid domain
 			// A dummy value is accepted (will be modified later)
 			else {
@@ -2733,9 +3240,43 @@ double vCell::convertToVoronoiFormat(int flag)
 	delete [] polyXY_2;
 	*/
 
+	// A cell without a value has no weights
+	if (record && value == base->dummy)
+		record->weight.resize(recordStart);
+	if (record)
+		record->cellIdx.resize(record->weight.size());
+	record = NULL;
+
 	return value;
 }
 
+/***************************************************************************
+**
+**  vCell::addWeight(int row, int col, double w) and scaleWeights(double s)
+**
+**  Record the weight of grid cell [row][col] in the value computed by
+**  convertToVoronoiFormat and scale the weights recorded in this call
+**  (for the division by the area of the cell)
+**
+***************************************************************************/
+void vCell::addWeight(int row, int col, double w)
+{
+	if (record == NULL || w == 0.0)
+		return;
+	record->cellIdx.push_back(row*base->MR + col);
+	record->weight.push_back(w);
+	return;
+}
+
+void vCell::scaleWeights(double s)
+{
+	if (record == NULL)
+		return;
+	for (size_t k=recordStart; k < record->weight.size(); k++)
+		record->weight[k] *= s;
+	return;
+}
+
 /*********************************************************************
 **
 **  vCell:: polyCentroid()
@@ -3174,6 +3715,150 @@ void vCell::printCellData()
 	return;
 }
 
+//=========================================================================
+//
+//
+//                  Section 5: tOverlapWeights Functions
+//
+//
+//=========================================================================
+
+tOverlapWeights::tOverlapWeights()
+{
+	signature = 0;
+	flag = 0;
+	NVor = NR = MR = 0;
+	xllc = yllc = dR = dummy = 0.0;
+}
+
+tOverlapWeights::~tOverlapWeights()
+{
+}
+
+/***************************************************************************
+**
+**  tOverlapWeights::matches( )
+**
+**  Compares the full grid header in addition to the hash
+**
+***************************************************************************/
+int tOverlapWeights::matches(unsigned long long sig, int flg, int nvor, 
+							 int nr, int mr, double xl, double yl, 
+							 double res, double nodata)
+{
+	return (sig == signature && flg == flag && nvor == NVor && 
+			nr == NR && mr == MR && xl == xllc && yl == yllc && 
+			res == dR && nodata == dummy);
+}
+
+/***************************************************************************
+**
+**  tOverlapWeights::apply(int id, double **grid)
+**
+**  Returns the resampled value of node 'id' as the weighted sum of the
+**  grid cells its Voronoi polygon overlaps
+**
+***************************************************************************/
+double tOverlapWeights::apply(int id, double **grid)
+{
+	if (state[id] == kOverlapDummy)
+		return dummy;
+
+	double value = 0.0;
+	for (int k=rowPtr[id]; k < rowPtr[id+1]; k++)
+		value += weight[k]*grid[cellIdx[k]/MR][cellIdx[k]%MR];
+	return value;
+}
+
+/***************************************************************************
+**
+**  tOverlapWeights::write(const char *name, unsigned long long meshSig)
+**
+**  Writes the weights in binary form: a header identifying the grid and 
+**  the mesh followed by the CSR arrays. Returns 1 on success.
+**
+***************************************************************************/
+int tOverlapWeights::write(const char *name, unsigned long long meshSig)
+{
+	const char magic[8] = {'t','R','I','B','S','R','S','W'};
+	int version = 1;
+	int nnz = (int)weight.size();
+
+	ofstream Otp(name, ios::out | ios::binary);
+	if (!Otp)
+		return 0;
+
+	Otp.write(magic, 8);
+	Otp.write((char *)&version, sizeof(int));
+	Otp.write((char *)&signature, sizeof(unsigned long long));
+	Otp.write((char *)&meshSig, sizeof(unsigned long long));
+	Otp.write((char *)&flag, sizeof(int));
+	Otp.write((char *)&NVor, sizeof(int));
+	Otp.write((char *)&NR, sizeof(int));
+	Otp.write((char *)&MR, sizeof(int));
+	Otp.write((char *)&xllc, sizeof(double));
+	Otp.write((char *)&yllc, sizeof(double));
+	Otp.write((char *)&dR, sizeof(double));
+	Otp.write((char *)&dummy, sizeof(double));
+	Otp.write((char *)&nnz, sizeof(int));
+	Otp.write(state.data(), NVor*sizeof(char));
+	Otp.write((char *)rowPtr.data(), (NVor+1)*sizeof(int));
+	Otp.write((char *)cellIdx.data(), nnz*sizeof(int));
+	Otp.write((char *)weight.data(), nnz*sizeof(double));
+	Otp.close();
+	return Otp.good() ? 1 : 0;
+}
+
+/***************************************************************************
+**
+**  tOverlapWeights::read(const char *name, unsigned long long meshSig)
+**
+**  Reads weights written by write(). Returns 0 if the file does not 
+**  exist, is corrupt or was built for a different mesh.
+**
+***************************************************************************/
+int tOverlapWeights::read(const char *name, unsigned long long meshSig)
+{
+	char magic[8];
+	int version, nnz;
+	unsigned long long fileMesh;
+
+	ifstream Inp(name, ios::in | ios::binary);
+	if (!Inp)
+		return 0;
+
+	Inp.read(magic, 8);
+	Inp.read((char *)&version, sizeof(int));
+	if (!Inp || strncmp(magic, "tRIBSRSW", 8) != 0 || version != 1)
+		return 0;
+
+	Inp.read((char *)&signature, sizeof(unsigned long long));
+	Inp.read((char *)&fileMesh, sizeof(unsigned long long));
+	Inp.read((char *)&flag, sizeof(int));
+	Inp.read((char *)&NVor, sizeof(int));
+	Inp.read((char *)&NR, sizeof(int));
+	Inp.read((char *)&MR, sizeof(int));
+	Inp.read((char *)&xllc, sizeof(double));
+	Inp.read((char *)&yllc, sizeof(double));
+	Inp.read((char *)&dR, sizeof(double));
+	Inp.read((char *)&dummy, sizeof(double));
+	Inp.read((char *)&nnz, sizeof(int));
+	if (!Inp || fileMesh != meshSig || NVor <= 0 || nnz < 0)
+		return 0;
+
+	state.resize(NVor);
+	rowPtr.resize(NVor+1);
+	cellIdx.resize(nnz);
+	weight.resize(nnz);
+	Inp.read(state.data(), NVor*sizeof(char));
+	Inp.read((char *)rowPtr.data(), (NVor+1)*sizeof(int));
+	Inp.read((char *)cellIdx.data(), nnz*sizeof(int));
+	Inp.read((char *)weight.data(), nnz*sizeof(double));
+	if (!Inp || rowPtr[NVor] != nnz)
+		return 0;
+	return 1;
+}
+
 //=========================================================================
 //
 //
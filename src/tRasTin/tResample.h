@@ -17,8 +17,18 @@
 #define  TRESAMPLE_H
 
 #include "src/Headers/Inclusions.h"
+#include <map>
 
 class vCell;
+class tOverlapWeights;
+class tGridPrefetch;
+class tGridData;
+class tBinaryRaster;
+
+#define kOverlapDirect 0    // Node is resampled with the polygon intersection
+#define kOverlapSparse 1    // Node is resampled with its cached weights
+#define kOverlapDummy  2    // Node does not overlap valid grid cells
+#define kMaxOverlapCache 8  // Grid geometries kept in memory at one time
 
 //=========================================================================
 //
@@ -32,6 +42,7 @@ class tResample
 {
  public:
   tResample(SimulationControl*, tMesh<tCNode> *);
+  tResample(SimulationControl*, tMesh<tCNode> *, tInputFile &);
   ~tResample();
 
   tMesh<tCNode> *mew; // Pointer to tMesh 
@@ -62,6 +73,17 @@ class tResample
   char   fileIn[30];
   char   fileOut[30];
 
+  int    cacheOption;             // 0: no cache, 1: memory, 2: memory and disk
+  char   cacheDir[kMaxNameSize];  // Directory/prefix of the weight files
+  unsigned long long meshSignature;            // Hash of all Voronoi polygons
+  std::vector<tOverlapWeights*> overlapCache;  // Weights for recent grids
+  std::map<unsigned long long, int> gridsSeen; // Times a geometry was read
+
+  tGridPrefetch *prefetch;        // Background grid reader (NULL if off)
+  tBinaryRaster *archive;         // Binary raster of many grids (GRIDARCHIVE)
+  tBinaryRaster *rasterIn;        // Binary raster file of the current grid
+  int      gridInMapped;          // 1 if rows of 'gridIn' are in a raster
+
   double* doIt(char *, int);  // Returns array 'varFromGrid'
   int*    doIt(int *, double *, double *, int); // Returns array 'varFromGrid'
 
@@ -72,6 +94,13 @@ class tResample
   void    PrintEdgeInfo(tEdge *); 
 
   void    readInputGrid(char *);
+  void    setGridRows(tBinaryRaster *, int);
+  void    setGridRows(tGridData &);
+  void    copyGridRows();
+  void    setGridCoordinates();
+  int     isGridInArchive(const char *);
+  void    prefetchGrid(const char *, const char *);
+  int     getPrefetchDepth();
   void    DestrtResample();
   void    allocMemory(double **, int, int);
   void    In_Mrain_Name (char *, char *, int, int, int, int);
@@ -81,6 +110,14 @@ class tResample
   void    FixVoronoiPolygon(tCNode *, tCNode *, tArray< double > &, tArray< double > &);
   tArray<double> FindNormal(double, double, double, double, double);
 
+  unsigned long long gridSignature(int);
+  unsigned long long gridChecksum();
+  void    computeMeshSignature();
+  int     composeCacheName(char *, unsigned long long);
+  tOverlapWeights* findOverlapWeights(int, int *);
+  void    finishOverlapWeights(int, double, tOverlapWeights *);
+  void    storeOverlapWeights(tOverlapWeights *);
+
 };
 
 //=========================================================================
@@ -143,9 +180,61 @@ class vCell
 
   double polygonArea(double **, int);
   double findDistance(double, double, double, double);
-  double convertToVoronoiFormat(int flag);
+  double convertToVoronoiFormat(int flag, tOverlapWeights *weights = NULL);
   int    convertPointData(int *, double *, double *, int);
 
+ private:
+  tOverlapWeights *record;  // Weights recorded by convertToVoronoiFormat
+  size_t recordStart;       // First weight of the current call
+
+  void addWeight(int, int, double);
+  void scaleWeights(double);
+
+};
+
+//=========================================================================
+//
+//
+//                  Section 3: tOverlapWeights Class Declarations
+//
+//
+//=========================================================================
+
+/***************************************************************************
+**
+**  tOverlapWeights holds the Voronoi cell - grid cell overlap weights of
+**  one input grid geometry (header, resampling flag and NODATA mask) as a
+**  sparse node x cell matrix in compressed row (CSR) format. Resampling
+**  a grid with the same geometry reduces to a sparse matrix-vector product.
+**
+***************************************************************************/
+
+class tOverlapWeights
+{
+ public:
+  tOverlapWeights();
+  ~tOverlapWeights();
+
+  unsigned long long signature; // Hash of grid header, flag and NODATA mask
+  int    flag;      // Resampling option: '1' weighted, '2' discrete
+  int    NVor;      // Number of Voronoi cells (rows of the matrix)
+  int    NR;        // Rows in the grid
+  int    MR;        // Columns in the grid
+  double xllc;      // X -LOWER left corner of the grid
+  double yllc;      // Y -LOWER left corner of the grid
+  double dR;        // Spatial resolution of the grid
+  double dummy;     // NODATA value of the grid
+
+  std::vector<char>   state;   // kOverlapDirect, kOverlapSparse, kOverlapDummy
+  std::vector<int>    rowPtr;  // Offsets of each node's weights, NVor+1
+  std::vector<int>    cellIdx; // Flat grid index (row*MR + column)
+  std::vector<double> weight;  // Overlap weights
+
+  int    matches(unsigned long long, int, int, int, int,
+                 double, double, double, double);
+  double apply(int, double **);
+  int    write(const char *, unsigned long long);
+  int    read(const char *, unsigned long long);
 };
 
 #endif
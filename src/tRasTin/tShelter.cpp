@@ -16,6 +16,21 @@
 
 #include "src/tRasTin/tShelter.h"
 #include "src/Headers/globalIO.h"
+#include "src/tThreadPool/tThreadPool.h"
+
+#include <algorithm>
+
+// Horizon angle setters of tCNode by azimuth, in steps of 22.5 degrees
+static void (tCNode::*setHorAngle[16])(double) = {
+  &tCNode::setHorAngle0000, &tCNode::setHorAngle0225,
+  &tCNode::setHorAngle0450, &tCNode::setHorAngle0675,
+  &tCNode::setHorAngle0900, &tCNode::setHorAngle1125,
+  &tCNode::setHorAngle1350, &tCNode::setHorAngle1575,
+  &tCNode::setHorAngle1800, &tCNode::setHorAngle2025,
+  &tCNode::setHorAngle2250, &tCNode::setHorAngle2475,
+  &tCNode::setHorAngle2700, &tCNode::setHorAngle2925,
+  &tCNode::setHorAngle3150, &tCNode::setHorAngle3375
+};
 
 //==========================================================================
 //
@@ -28,20 +43,13 @@ tShelter::tShelter(SimulationControl *simCtrPtr, tMesh<tCNode> * gridPtr,
 
 { 
 
-  int i(0), j(0), k(0), l(0);//looping variables
-  int angleHolder(0);
-  int delRow(0), delCol(0);
-  int delXInt(0), delYInt(0);//variables for navigating through grid
-  double delXReal(0.), delYReal(0.), remX(0.), remY(0.);//structural navigation 
-  double tanAngle(0.), cosAngle(0.);			//variables
-  double angle(0);//angle of transform to loop through
-  double absTan, absCos;
+  int i(0), j(0), d(0);//looping variables
+  int counter(0);
+  double azimuth(0.);
+  char cacheName[kMaxNameSize];
   
   tCNode *cn;
   tMeshListIter< tCNode > niter ( mew->getNodeList() );
-  tPtrList< tCNode >     NodesLst;
-  tPtrListIter< tCNode > NodesIter( NodesLst );
-  NodesLst.Flush();
 
   //get input information
   radSheltOpt = infile.ReadItem(radSheltOpt,"OPTRADSHELT");
@@ -49,17 +57,53 @@ tShelter::tShelter(SimulationControl *simCtrPtr, tMesh<tCNode> * gridPtr,
   //get the file path to the DEM
   infile.ReadItem(GridInPath,"DEMFILE");
 
-  angleDiv = 22.5;
-
-//  cout << "Shelt option: " << radSheltOpt << endl;
+  //number of azimuth sectors, the 16 directions stored in tCNode must
+  //be among them
+  nSectors = 16;
+  if (infile.IsItemIn( "HORIZONSECTORS" ))
+    nSectors = infile.ReadItem(nSectors, "HORIZONSECTORS");
+  if (nSectors < 16 || nSectors % 16 != 0) {
+    int n = std::max(16, 16*((nSectors + 15)/16));
+    Cout << "\ntShelter: Warning: HORIZONSECTORS = " << nSectors
+	 << " is not a multiple of 16, using " << n << endl;
+    nSectors = n;
+  }
+  angleDiv = 360.0/nSectors;
+
+  //horizon angles are written to and read from RESAMPLECACHEDIR
+  horizonCache = 0;
+  horizonDir[0] = '\0';
+  if (infile.IsItemIn( "OPTHORIZONCACHE" ))
+    horizonCache = infile.ReadItem(horizonCache, "OPTHORIZONCACHE");
+  if (horizonCache) {
+    if (infile.IsItemIn( "RESAMPLECACHEDIR" ))
+      infile.ReadItem(horizonDir, "RESAMPLECACHEDIR");
+    else {
+      Cout << "\ntShelter: Warning: RESAMPLECACHEDIR is not specified, "
+	   << "horizon angles will not be cached" << endl;
+      horizonCache = 0;
+    }
+  }
 
-  
   //derive HA maps
   if ( (radSheltOpt > 0) && (radSheltOpt < 4) ) {//CHANGED IN 2008
   
   cout << "read DEM" << endl;
   readInputGrid(GridInPath);
 
+  //the horizon angles are written over the grid values
+  copyGridRows();
+
+  //horizon angle of each node (in mesh order) and sector
+  std::vector<double> horizon((size_t)NVor*nSectors, 0.0);
+
+  if (horizonCache && !composeHorizonName(cacheName, gridChecksum()))
+    horizonCache = 0;
+
+  if (horizonCache && readHorizonCache(cacheName, horizon)) {
+    Cout << "\ntShelter: Read horizon angles from " << cacheName << endl;
+  }
+  else {
 
   // cout << "initialize grid" << endl;
   tempGrid = new double* [NR]; 
@@ -73,323 +117,43 @@ tShelter::tShelter(SimulationControl *simCtrPtr, tMesh<tCNode> * gridPtr,
     }
   }
 
-  //i,j are for the address of the point of interest
-  //k is for looping through the angles
-  //
-  //cout << "navigation variable loop" << endl;
-  for (int tempInd = 0; tempInd < 16; tempInd = tempInd+1) {
-
-    //cout << "navigation variable loop"<< tempInd << endl;
-
-    angle = 22.5*double(tempInd);
-
-    //find navigation variables and initialize properly
-    //
-    //	  This "pixelates" the navigation of the grid so that
-    //	  we can work on angles.
-    //
-    //	  If the code is to use a dynamic discretization of the
-    //	  azimuthal angles, then this will need to be automated.
-    //	  But that is what held me up for so long last time.
-    
-    switch (tempInd) {
-      case 0:
-	//0.0 degrees
-	delXReal = 1.0;
-	delYReal = 0.0;
-	break;
-      case 1:
-	//22.5 degrees
-	delXReal = 1.0;
-	delYReal = 0.414213562;
-	break;
-      case 2:
-	//45.0 degrees
-	delXReal = 1.0;
-	delYReal = 1.0;
-	break;
-      case 3:
-	//67.5 degrees
-	delXReal = 0.414213562;
-	delYReal = 1.0;
-      case 4:
-	//90.0 degrees
-	delXReal = 0.0;
-	delYReal = 1.0;
-	break;
-      case 5:
-	//112.5 degrees
-	delXReal = -0.414213562;
-	delYReal = 1.0;
-	break;
-      case 6:
-	//135.0 degrees
-	delXReal = -1.0;
-	delYReal = 1.0;
-	break;
-      case 7:
-	//157.5 degrees
-	delXReal = -1.0;
-	delYReal = 0.414213562;
-	break;
-      case 8:
-	//180.0 degrees
-	delXReal = -1.0;
-	delYReal = 0.0;
-	break;
-      case 9:
-	//202.5 degrees
-	delXReal = -1.0;
-	delYReal = -0.414213562;
-	break;
-      case 10:
-	//225.0 degrees
-	delXReal = -1.0;
-	delYReal = -1.0;
-	break;
-      case 11:
-	//247.5 degrees
-	delXReal = -0.414213562;
-	delYReal = -1.0;
-	break;
-      case 12:
-	//270.0 degrees
-	delXReal = 0.0;
-	delYReal = -1.0;
-	break;
-      case 13:
-	//292.5 degrees
-	delXReal = 0.414213562;
-	delYReal = -1.0;
-	break;
-      case 14:
-	//315.0 degrees
-	delXReal = 1.0;
-	delYReal = -1.0;
-	break;
-      case 15:
-	//337.5 degrees
-	delXReal = 1.0;
-	delYReal = -0.414213562;
-	break;
-      default:
-	cout << "\nSomething is screwed up in the for loop of tShelter alg" << endl;
-    }
-    
-    //find trig values
-    tanAngle = tan(3.1416*angle/180);
-    cosAngle = cos(3.1416*angle/180);
-    absTan = fabs(3.1416*tanAngle/180);
-    absCos = fabs(3.1416*cosAngle/180);
-
-    //initialize index stepping variables and remainder variables
-    delXInt = 0;
-    delYInt = 0;
-    remX = 0;
-    remY = 0;
-
-//    cout << "go to unique (or starting) point in the grid" << endl;
-    for(i = 0; i < NR; i++) {
-
-      for(j = 0; j < MR; j++) {
-	
-
-	//ALL INITIALIZATIONS ARE FOR WHILE-LOOP
-	
-	//initialize elevation
-	initZ = tempGrid[i][j];
-
-	//intitialize HA to lowest value
-  	gridIn[i][j] = 0.0;
-
-	//initialize location of where HA occurs
-	k = i;
-	l = j;
-	
-	//initialize state variables
-	maxTan = 0.0;
-	maxRow = i;
-	maxCol = j;
-	maxZ = initZ;
-	
-	//initialize remainders and integer steps
-	remX = delXReal;
-	remY = delYReal;
-	
-	//set step in x-dir
-	if (fabs(remX) >= 1.0) {
-	  if (remX >= 0.0) {
-	    delXInt = int(floor(remX));
-	    remX = remX - 1.0;
-	  }
-	  else if (remX < 0.0) {
-	    delXInt = int(ceil(remX));
-	    remX = remX + 1.0;
-	  }
-	}
-
-	//set integer step in y-dir
-	if (fabs(remY) >= 1.0) {
-	  if (remY >= 0.0) {
-	    delYInt = int(floor(remY));//go down
-	    remY = remY - 1.0;//find difference and redo remainder
-	  }
-	  else if (remY < 0.0) {
-	    delYInt = int(ceil(remY));//go up
-	    remY = remY + 1.0;//find difference
-	  }
-	
-	}
-	
-	//initialize to next location away from i,j
-	k += delYInt;
-        l += delXInt;
-
-	while (( (k >= 0)&&(k < NR)) && ( (l >= 0)&&(l < MR) )) {
-	  
-	  //find difference locations for length calculations
-	  delRow = k - i;
-	  delCol = l - j;
-
-	  tempZ = tempGrid[k][l];
-	  tempTan = (tempZ - initZ)/(
-		  pow(pow(dR,2.0)*
-		  (pow(delRow,2.0) + pow(delCol,2.0)), 0.5));
-
-	  //compare to previous maxTan
-	  if (tempTan > maxTan) {
-	    maxTan = tempTan;
-	    maxRow = k;
-	    maxCol = l;
-	  }
-
-	  //get the next delXInt, delYInt, remX, remY
-	  remX += delXReal;
-	  remY += delYReal;
-
-	  //find integer x-step if needed
-	  if (fabs(remX) >= 1.0) {
-	    if (remX >= 0.0) {
-	      delXInt = int(floor(remX));
-	      remX = remX - 1.0;
-	    }
-	    else {
-	      delXInt = int(ceil(remX));
-	      remX = remX + 1.0;
-	    }
-	  }
-
-	  //find integer y-step if needed
-	  if (fabs(remY) >= 1.0) {
-	    if (remY >= 0.0) {
-	      delYInt = int(floor(remY));
-	      remY = remY - 1.0;
-	    }
-	    else {
-	      delYInt = int(ceil(remY));
-	      remY = remY + 1.0;
-	    }
-	  }	    
-
-	  //change location
-	  k += delYInt;
-	  l += delXInt;
-	  
-	}//end of line of interest (while-loop)	
-
-	//set to HA grid	
-	if (maxTan > 1e-5) {
-		gridIn[i][j] = fabs(atan(maxTan));
-      	}
-	else {
-		gridIn[i][j] = 0.0;
-	}
-      }//end of j-loop
-    }//end of i-loop
+  for (d = 0; d < nSectors; d++) {
 
+    //horizon angle grid of this direction in gridIn
+    sweepHorizon(d);
 
-    //cout << "resample temporary grid to node (we need to set up the node function)" << endl;
-    //	  This is mostly taken from tResample
-    //
     //	  Resample to polygons
-    int counter = 0;
+    //	  This is mostly taken from tResample
+    counter = 0;
     for (cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP()) {  
       eta -> initializeVCell(simCtrl, this, vXs[counter], vYs[counter], nPoints[counter]);
 
       varFromGrid[counter] = dummy;
       varFromGrid[counter] = eta->convertToVoronoiFormat(1);
       eta -> DestrtvCell();
+
+      //polygons entirely on NODATA cells of the DEM are not sheltered
+      if (varFromGrid[counter] == dummy)
+	varFromGrid[counter] = 0.0;
+      horizon[(size_t)counter*nSectors + d] = varFromGrid[counter];
       
       counter++;
     }
-    
-    //cout << "set HA to tCNode objects" << endl;
-    counter = 0;
-    for (cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP()) {
-      
-      switch ( tempInd ) {
-	case 0:
-	  cn->setHorAngle2700(varFromGrid[counter]);
-	  break;
-	case 1:
-	  cn->setHorAngle2925(varFromGrid[counter]);
-	  break;
-	case 2:
-	  cn->setHorAngle3150(varFromGrid[counter]);
-	  break;
-	case 3:
-	  cn->setHorAngle3375(varFromGrid[counter]);
-	  break;
-	case 4:
-	  cn->setHorAngle0000(varFromGrid[counter]);
-	  break;
-	case 5:
-	  cn->setHorAngle0225(varFromGrid[counter]);
-	  break;
-	case 6:
-	  cn->setHorAngle0450(varFromGrid[counter]);
-	  break;
-	case 7:
-	  cn->setHorAngle0675(varFromGrid[counter]);
-	  break;
-	case 8:
-	  cn->setHorAngle0900(varFromGrid[counter]);
-	  break;
-	case 9:
-	  cn->setHorAngle1125(varFromGrid[counter]);
-	  break;
-	case 10:
-	  cn->setHorAngle1350(varFromGrid[counter]);
-	  break;
-	case 11:
-	  cn->setHorAngle1575(varFromGrid[counter]);
-	  break;
-	case 12:
-	  cn->setHorAngle1800(varFromGrid[counter]);
-	  break;
-	case 13:
-	  cn->setHorAngle2025(varFromGrid[counter]);
-	  break;
-	case 14:
-	  cn->setHorAngle2250(varFromGrid[counter]);
-	  break;
-	case 15:
-	  cn->setHorAngle2475(varFromGrid[counter]);
-	  break;
-	default:
-	  cout << "\nCheck tempInd -- did not exist or assign" << endl;
-      }//end-switch
-	
-      counter++;
-    }
 
-  //cout << "loop through next angle" << endl;  
   }//loop through next angle
 
+  for (i = 0; i<NR; i++)
+    delete [] tempGrid[i];
+  delete [] tempGrid;
+
+  if (horizonCache)
+    writeHorizonCache(cacheName, horizon);
+  }
   
-  //set up shelter and lv factors
+  //set HA to tCNode objects and set up shelter and lv factors
+  counter = 0;
   for (cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP()) {
-    
+
     //compute slope and aspect for polygon
     elevation = cn->getZ();
     slope = fabs(atan(cn->getFlowEdg()->getSlope()));
@@ -398,130 +162,29 @@ tShelter::tShelter(SimulationControl *simCtrPtr, tMesh<tCNode> * gridPtr,
     //compute sv
     sv = 0.0;
     //integrate
-    for (int tempInd(0); tempInd < 16; tempInd++) {
-      
-      switch ( tempInd ) {
-	 case 0:
-	    horAngle = cn->getHorAngle0000();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 -horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 1:
-	    horAngle = cn->getHorAngle0225();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle- sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 2:
-	    horAngle = cn->getHorAngle0450();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 3:
-	    horAngle = cn->getHorAngle0675();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 -horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 4:
-	    horAngle = cn->getHorAngle0900();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 5:
-	    horAngle = cn->getHorAngle1125();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 -horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 6:
-	    horAngle = cn->getHorAngle1350();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 -horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 7:
-	    horAngle = cn->getHorAngle1575();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 8:
-	    horAngle = cn->getHorAngle1800();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 9:
-	    horAngle = cn->getHorAngle2025();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 10:
-	    horAngle = cn->getHorAngle2250();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 -horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 11:
-	    horAngle = cn->getHorAngle2475();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 12:
-	    horAngle = cn->getHorAngle2700();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 13:
-	    horAngle = cn->getHorAngle2925();
-	    sv += (cos(atan(slope))*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(atan(slope))*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 14:
-	    horAngle = cn->getHorAngle3150();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  case 15:
-	    horAngle = cn->getHorAngle3375();
-	    sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
-			sin(slope)*cos(tempInd*22.5*3.1416/180 - aspect)) *
-			0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
-			(3.1416/8);
-	    break;
-	  default:
-	    cout << "\ncheck for-loop in sheltFactorFunc()" << endl;
-      }//switch
-    }//for-loop
+    for (d = 0; d < nSectors; d++) {
+
+      //direction d looks along 'd*angleDiv' degrees on the grid (columns
+      //to the east, rows to the south), i.e. at the azimuth below
+      horAngle = horizon[(size_t)counter*nSectors + d];
+      azimuth = fmod(d*angleDiv + 270.0, 360.0);
+      if ((d*16) % nSectors == 0)
+	(cn->*setHorAngle[int(azimuth/22.5 + 0.5) % 16])(horAngle);
+
+      sv += (cos(slope)*sin(3.1416/2 - horAngle)*sin(3.1416/2 - horAngle) +
+	     sin(slope)*cos(azimuth*3.1416/180 - aspect)) *
+	    0.5*(3.1416/2 - horAngle - sin(2*(3.1416/2 - horAngle))) *
+	    (2*3.1416/nSectors);
+    }
     sv /= (2*3.1416);
     cn->setSheltFact(sv);
 
+    counter++;
   }//nodes-loop
 
+  // Grid rows and coordinates (rows may belong to a binary raster)
+  DestrtResample();
+
   }//shelter-on loop
 
   else {
@@ -553,24 +216,169 @@ tShelter::tShelter(SimulationControl *simCtrPtr, tMesh<tCNode> * gridPtr,
     }
   }
  
-  //cout << "delete statements at the end of the shelter constructor" << endl;
-  if (radSheltOpt > 0 && radSheltOpt < 4) {//CHANGED IN 2008
-    for (int i = 0; i<NR; i++)
-	    delete [] tempGrid[i];
-    delete [] tempGrid;
-
-    for (int i=0; i<NR; i++) {
-       delete [] gridIn[i];
+}//end of constructor
+
+/***************************************************************************
+**
+**  tShelter::sweepHorizon(int d)
+**
+**  Fills gridIn with the horizon angles of the DEM (in tempGrid) looking
+**  along direction d. The grid is split into digital lines parallel to
+**  the direction: for a direction closer to the columns (rows) each line
+**  has one cell per column (row). Each line is swept against the
+**  direction, keeping the upper convex hull of the cells already passed;
+**  the hull vertex tangent from the current cell is its horizon. Every
+**  cell is pushed and popped once, so a direction takes O(NR x MR). The
+**  lines are independent and split among the threads. NODATA cells of
+**  the DEM do not block the horizon and stay NODATA.
+**
+***************************************************************************/
+void tShelter::sweepHorizon(int d)
+{
+  double angle = 2.0*PI*d/nSectors;
+  double dCol = cos(angle);
+  double dRow = sin(angle);
+
+  //t counts steps along a line, p is the index across it
+  int colMajor = (fabs(dCol) >= fabs(dRow));
+  double major = colMajor ? dCol : dRow;
+  double m = (colMajor ? dRow : dCol)/fabs(major);
+  int forward = (major > 0.0);
+  int nT = colMajor ? MR : NR;
+  int nP = colMajor ? NR : MR;
+  double step = dR*sqrt(1.0 + m*m);
+
+  //lines are labeled by their index across at t = 0
+  int offEnd = int(lround((nT-1)*m));
+  int qFirst = -std::max(0, offEnd);
+  int qLast = nP - 1 - std::min(0, offEnd);
+
+  tThreadPool::parallelFor(qFirst, qLast + 1, [&](int first, int last, int) {
+    std::vector<double> hullS, hullZ;
+    hullS.reserve(nT);
+    hullZ.reserve(nT);
+
+    for (int q = first; q < last; q++) {
+      hullS.clear();
+      hullZ.clear();
+
+      for (int t = nT - 1; t >= 0; t--) {
+	int p = q + int(lround(t*m));
+	if (p < 0 || p >= nP)
+	  continue;
+	int k = forward ? t : nT - 1 - t;
+	int r = colMajor ? p : k;
+	int c = colMajor ? k : p;
+
+	double z = tempGrid[r][c];
+	if (z == dummy) {
+	  gridIn[r][c] = dummy;
+	  continue;
+	}
+	double s = t*step;
+
+	//drop hull vertices below the line to the next one
+	size_t n = hullS.size();
+	while (n >= 2 && (hullZ[n-1] - z)*(hullS[n-2] - s) <=
+			 (hullZ[n-2] - z)*(hullS[n-1] - s)) {
+	  hullS.pop_back();
+	  hullZ.pop_back();
+	  n--;
+	}
+
+	double tanMax = 0.0;
+	if (n > 0)
+	  tanMax = (hullZ[n-1] - z)/(hullS[n-1] - s);
+
+	//set to HA grid
+	if (tanMax > 1e-5)
+	  gridIn[r][c] = fabs(atan(tanMax));
+	else
+	  gridIn[r][c] = 0.0;
+
+	hullS.push_back(s);
+	hullZ.push_back(z);
+      }
     }
-    delete [] gridIn;
-//    delete [] GridInPath;
-	delete [] coorXG;
-	delete [] coorYG;
+  });
+  return;
+}
 
+/***************************************************************************
+**
+**  tShelter::composeHorizonName(char *name, unsigned long long demSum)
+**
+**  Horizon angles depend on the DEM, the Voronoi mesh and the sectors.
+**  Returns 0 if the name does not fit (the cache is then not used).
+**
+***************************************************************************/
+int tShelter::composeHorizonName(char *name, unsigned long long demSum)
+{
+  int len = snprintf(name, kMaxNameSize, "%shor_%016llx_%016llx_%d.bin",
+		     horizonDir, demSum, meshSignature, nSectors);
+  return (len >= 0 && len < kMaxNameSize) ? 1 : 0;
+}
 
-  }
+/***************************************************************************
+**
+**  tShelter::readHorizonCache(const char *name, vector<double> &horizon)
+**
+**  Reads the horizon angles written by writeHorizonCache(). Returns 0 if
+**  the file does not exist or does not match the mesh.
+**
+***************************************************************************/
+int tShelter::readHorizonCache(const char *name, std::vector<double> &horizon)
+{
+  char magic[8];
+  int version, n, sectors;
+  unsigned long long fileMesh;
+
+  ifstream Inp(name, ios::in | ios::binary);
+  if (!Inp)
+    return 0;
+
+  Inp.read(magic, 8);
+  Inp.read((char *)&version, sizeof(int));
+  Inp.read((char *)&fileMesh, sizeof(unsigned long long));
+  Inp.read((char *)&n, sizeof(int));
+  Inp.read((char *)&sectors, sizeof(int));
+  if (!Inp || strncmp(magic, "tRIBSHOR", 8) != 0 || version != 1 ||
+      fileMesh != meshSignature || n != NVor || sectors != nSectors)
+    return 0;
+
+  Inp.read((char *)horizon.data(), horizon.size()*sizeof(double));
+  if (!Inp)
+    return 0;
+  return 1;
+}
 
-}//end of constructor
+/***************************************************************************
+**
+**  tShelter::writeHorizonCache(const char *name, vector<double> &horizon)
+**
+***************************************************************************/
+void tShelter::writeHorizonCache(const char *name,
+				 const std::vector<double> &horizon)
+{
+  const char magic[8] = {'t','R','I','B','S','H','O','R'};
+  int version = 1;
+
+  ofstream Otp(name, ios::out | ios::binary);
+  if (Otp) {
+    Otp.write(magic, 8);
+    Otp.write((char *)&version, sizeof(int));
+    Otp.write((char *)&meshSignature, sizeof(unsigned long long));
+    Otp.write((char *)&NVor, sizeof(int));
+    Otp.write((char *)&nSectors, sizeof(int));
+    Otp.write((char *)horizon.data(), horizon.size()*sizeof(double));
+    Otp.close();
+  }
+  if (Otp.good())
+    Cout << "\ntShelter: Wrote horizon angles to " << name << endl;
+  else
+    Cout << "\ntShelter: Warning: could not write " << name << endl;
+  return;
+}
 
 tShelter::~tShelter() {
   Cout << "tShelter Object Destroyed..." << endl;
@@ -19,17 +19,23 @@
 **  entirely contained in the object constructor, as we only need to do this 
 **  process once at the initialization of the model.
 **
-**  Currently, there are only 16 directions used to find horizon angles, which
-**  will introduce error in larger regions. The algorithm is fairly straight
-**  forward.
+**  Horizon angles are found in 16 directions by default; the optional
+**  keyword HORIZONSECTORS (a multiple of 16) sets a finer division of the
+**  azimuth for the sky view factor. The algorithm is as follows:
 **
 **    Initialize DEM array
 **    Choose a direction
-**    Pixelate and set up navigation variables
-**    For each grid cell and in each direction, find steepest neigbor.
+**    Split the DEM into digital lines parallel to the direction
+**    Sweep each line against the direction, keeping the upper convex
+**      hull of the cells ahead; the hull vertex tangent from a cell is
+**      its horizon (O(N) per direction, lines run on NUMTHREADS threads)
 **    Resample finished grid to Voronoi cells.
 **    Calculate sky view and land view factors.
 **
+**  With OPTHORIZONCACHE = 1 the resampled horizon angles are written to
+**  RESAMPLECACHEDIR, keyed by a checksum of the DEM and of the Voronoi
+**  mesh, and read back by later runs instead of being recomputed.
+**
 **    RINEHART 2007 @ NEW MEXICO TECH
 **  
 **
@@ -68,6 +74,14 @@ public:
   double **horAngleX; //pointer to temporary horizon angle grid
   double **tempGrid;
   int radSheltOpt, windSheltOpt;
+  int nSectors;       //number of azimuth sectors (multiple of 16)
+  int horizonCache;   //0 - horizon angles computed, 1 - cached on disk
+  char horizonDir[kMaxNameSize]; //directory/prefix of the cache files
+
+  void sweepHorizon(int);
+  int  composeHorizonName(char *, unsigned long long);
+  int  readHorizonCache(const char *, std::vector<double> &);
+  void writeHorizonCache(const char *, const std::vector<double> &);
 
 };
 
@@ -370,10 +370,51 @@ int tVariant::composeFileName(tRunTimer *t)
 	
 	infile.open(fileIn);
 	//if (!infile)
-	if (!infile.is_open()) // SKYnGM2008LU
+	if (!infile.is_open() && !respPtr->isGridInArchive(fileIn)) // SKYnGM2008LU
 		return 0;
-	else 
+	else {
+		// Read the grids of the next meteorological times ahead
+		prefetchFileNames(t);
 		return 1;
+	}
+}
+
+/***************************************************************************
+**
+** prefetchFileNames() Function
+**
+** Asks tResample to read the grids of this variable for the next
+** meteorological times ahead, advancing a copy of the calendar time by
+** the meteorological time step
+**
+***************************************************************************/
+void tVariant::prefetchFileNames(tRunTimer *t)
+{
+	int depth = respPtr->getPrefetchDepth();
+	if (depth == 0)
+		return;
+
+	int mi = t->minute, hr = t->hour, dy = t->day, mo = t->month, yr = t->year;
+	double metTime = t->getCurrentTime();
+	char name[kName];
+	int len;
+
+	for (int k = 0; k < depth; k++) {
+		metTime += t->getMetStep();
+		t->correctCalendarTime(metTime, t->getMetStep(), &mi, &hr, &dy, &mo, &yr);
+		if (t->getMetStep() < t->getRainDT())
+			len = snprintf(name, sizeof(name), "%s%02d%02d%04d%02d%02d.%s",
+					inputName, mo, dy, yr, hr, mi, extension);
+		else
+			len = snprintf(name, sizeof(name), "%s%02d%02d%04d%02d.%s",
+					inputName, mo, dy, yr, hr, extension);
+
+		// A truncated name would not be the grid read later
+		if (len < 0 || len >= (int)sizeof(name))
+			return;
+		respPtr->prefetchGrid(inputName, name);
+	}
+	return;
 }
 
 /***************************************************************************
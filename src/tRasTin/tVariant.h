@@ -41,6 +41,7 @@ public:
   void setFileNames(char *, char*);
   void noData(char *);
   int  composeFileName(tRunTimer *);
+  void prefetchFileNames(tRunTimer *);
   char fileIn[kName];
 
   // SKYnGM2008LU
@@ -95,6 +95,8 @@ public:
   double  RemainingTime() const;
   double  getOutputInterval() const;
   double  getSpatialOutputInterval() const;
+  double  getNextOutputTime() const;
+  double  getNextSPOutputTime() const;
   double  RemainingTime(double);
   double  getOutputIntervalSec();
   double  getSpatialOutputIntervalSec();
@@ -176,6 +178,8 @@ inline double tRunTimer::getGWTimeStep()  const { return gwatstep; }
 inline double tRunTimer::getEndTime()     const { return endTime; }
 inline double tRunTimer::getOutputInterval() const { return outputInterval; }
 inline double tRunTimer::getSpatialOutputInterval() const { return SPOutputInterval; }
+inline double tRunTimer::getNextOutputTime() const { return nextOutputTime; }
+inline double tRunTimer::getNextSPOutputTime() const { return nextSPOutputTime; }
 
 #endif
        
@@ -18,6 +18,12 @@
 #include "src/tSimulator/tSimul.h"
 #include "src/Headers/TemplDefinitions.h"
 #include "src/Headers/globalIO.h"
+#include "src/tThreadPool/tThreadPool.h"
+
+#ifndef WIN
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 #ifdef PARALLEL_TRIBS
 #include "src/tGraph/tGraph.h"
@@ -49,6 +55,11 @@ Simulator::Simulator(SimulationControl *simctrlptr, tRainfall *rainptr,
 	
 	// Counter of time, used for GW model
 	GW_label = 0.;
+	gwAdaptOption = 0;
+	gwAdaptTol = gwAdaptMax = 0.;
+	gwLast = gwChange = 0.;
+	gwSteps = 0;
+	ensembleJobs = 1;
 
 	// Output data on Mesh and Voronoi elements
 	outp->WriteOutput( 0 );
@@ -116,6 +127,39 @@ void Simulator::initialize_simulation(tEvapoTrans *EvapoTrans, tSnowPack *SnowPa
     else
         simCtrl->hydrog_results = false; //Default option
 
+    // Adaptive groundwater time step: a GW step is taken once the state
+    // of a node changed by GWADAPTTOL [mm] since the last one, at the
+    // latest after GWADAPTMAX [minutes] (default 4*GWSTEP)
+    gwAdaptOption = 0;
+    if (InFl.IsItemIn( "OPTGWADAPT" ))
+        gwAdaptOption = InFl.ReadItem(gwAdaptOption, "OPTGWADAPT");
+    if (gwAdaptOption != 0 && gwAdaptOption != 1) {
+        Cout<<"\nSimulator: Warning: OPTGWADAPT = "<<gwAdaptOption
+            <<" is not valid, using 0"<<endl;
+        gwAdaptOption = 0;
+    }
+#ifdef PARALLEL_TRIBS
+    // All processors have to take the GW steps together
+    if (gwAdaptOption) {
+        Cout<<"\nSimulator: Warning: OPTGWADAPT is not available in "
+            <<"the parallel version, using 0"<<endl;
+        gwAdaptOption = 0;
+    }
+#endif
+    gwAdaptTol = 1.0;
+    if (InFl.IsItemIn( "GWADAPTTOL" ))
+        gwAdaptTol = InFl.ReadItem(gwAdaptTol, "GWADAPTTOL");
+    gwAdaptMax = 4.0*timer->getGWTimeStep();
+    if (InFl.IsItemIn( "GWADAPTMAX" )) {
+        gwAdaptMax = InFl.ReadItem(gwAdaptMax, "GWADAPTMAX");
+        gwAdaptMax /= 60.;
+    }
+    if (gwAdaptMax < timer->getTimeStep())
+        gwAdaptMax = timer->getTimeStep();
+    gwLast = timer->getCurrentTime();
+    gwChange = 0.;
+    gwSteps = 0;
+
 	// Ouput pre-processing
 	if (simCtrl->inter_results)
 		outp->CreateAndOpenDynVar();
@@ -320,6 +364,9 @@ void Simulator::end_simulation(tKinemat *Flow)
 		outp->WriteDynamicVars( timer->getCurrentTime() );
 	
 	outp->end_simulation();
+
+	if (gwAdaptOption && simCtrl->GW_model_label)
+		Cout<<"\nSimulator: "<<gwSteps<<" adaptive groundwater steps"<<endl;
 	
 	Cout<<"\nSimulation completed...\n"<<endl;
 	
@@ -505,20 +552,65 @@ void Simulator::SurfaceHydroProcesses(tEvapoTrans *EvapoTrans,
 *****************************************************************************/
 void Simulator::SubSurfaceHydroProcesses(tHydroModel *Moisture)
 {
+	double gwStep;
+
 	// Call Unsaturated Zone in tHydroModel
 	Moisture->UnSaturatedZone( timer->getTimeStep() );
     
-	GW_label = fmod(timer->getCurrentTime(), timer->getGWTimeStep());
+	if (gwAdaptOption) {
+		gwStep = timer->getCurrentTime() - gwLast;
+		GW_label = AdaptiveGWStep( Moisture );
+	}
+	else {
+		gwStep = timer->getGWTimeStep();
+		GW_label = fmod(timer->getCurrentTime(), timer->getGWTimeStep());
+	}
 	
 	// Call Saturated Zone in tHydroModel 
 	if (simCtrl->GW_model_label) {
 		if ( !GW_label ) {
 			Moisture->ResetGW(); 
-			Moisture->SaturatedZone( timer->getGWTimeStep() );
+			Moisture->SaturatedZone( gwStep );
+			gwSteps++;
 		}
 	}
 }
 
+/*****************************************************************************
+**  
+**  Simulator::AdaptiveGWStep()
+**  
+**  Controller of the groundwater time step with OPTGWADAPT = 1. The 
+**  largest change of the water table, wetting front or moisture of a 
+**  node in each unsaturated zone step (tHydroModel::MaxStateChange) is
+**  summed since the last GW step. A GW step over the time since the last
+**  one is taken when this sum reaches GWADAPTTOL, so that it is taken at
+**  every unsaturated zone step during intense storms and grows up to 
+**  GWADAPTMAX during recessions. A GW step is also taken at the output
+**  times and at the end of the run. Returns 0 if a GW step is due (as
+**  the GW_label of the fixed step), the time since the last one if not.
+**
+*****************************************************************************/
+double Simulator::AdaptiveGWStep(tHydroModel *Moisture)
+{
+	double now = timer->getCurrentTime();
+	double eps = timer->getTimeStep()*1.0E-6;
+	double elapsed = now - gwLast;
+
+	gwChange += Moisture->MaxStateChange();
+
+	if (gwChange >= gwAdaptTol ||
+		elapsed >= gwAdaptMax - eps ||
+		timer->RemainingTime() <= eps ||
+		now >= timer->getNextOutputTime() - eps ||
+		(simCtrl->inter_results && now >= timer->getNextSPOutputTime() - eps)) {
+		gwLast = now;
+		gwChange = 0.;
+		return 0.;
+	}
+	return elapsed;
+}
+
 /*****************************************************************************
 **  
 **  Simulator::OutputSimulatedVars()
@@ -845,6 +937,27 @@ void Simulator::RunItAgain( tInputFile &InFl, tHydroModel *Moisture,
 	cerr<<endl<<flush;
 	cerr<<"----------------------------------------------------"<<endl;
 	
+	StartNewRun(InFl, Moisture, Flow, EvapoTrans, Intercept, Balance,
+				PreProcessor, SnowPack, wish, keep);
+	return;
+}
+
+/*****************************************************************************
+**  
+**  Simulator::StartNewRun()
+**
+**  Runs the model for the input file simCtrl->infile with the mesh and
+**  objects of the previous run. 'wish' is 1 if the soil and land use 
+**  maps have to be resampled again, 'keep' is 1 if the state of the 
+**  system is the initial condition of the run.
+**  
+*****************************************************************************/
+void Simulator::StartNewRun( tInputFile &InFl, tHydroModel *Moisture, 
+							 tKinemat *Flow, tEvapoTrans *EvapoTrans, 
+							 tIntercept *Intercept, tWaterBalance *Balance,
+							 tPreProcess *PreProcessor, tSnowPack *SnowPack,
+							 int wish, int keep)
+{
 	if ( !wish ) {
 		cerr<<"\n\tNOTE: Previous soil and landuse maps are used. Continuing..."
 		<<endl<<flush;
@@ -854,7 +967,6 @@ void Simulator::RunItAgain( tInputFile &InFl, tHydroModel *Moisture,
 		<<"\tA new tRIBS run has been initiated..."<<endl<<flush;
 	cout<<"-----------------------------------------------------\n";
 	
-	simCtrl->infile = filein;
 	cerr<<"\n\tName of *.in file: '"<<simCtrl->infile<<"'"<<endl<<flush;
 	
 	// Re-initializing tInputFile
@@ -898,6 +1010,12 @@ void Simulator::RunItAgain( tInputFile &InFl, tHydroModel *Moisture,
 	// Re-initializing tEvapoTrans 
 	EvapoTrans->DeleteEvapoTrans();
 	EvapoTrans->SetEvapTVariables( InFl, Moisture );
+
+	// Re-initializing the meteorological input of tSnowPack
+	if (SnowPack->getSnowOpt()) {
+		SnowPack->DeleteEvapoTrans();
+		SnowPack->SetEvapTVariables( InFl, Moisture );
+	}
 	
 	// Re-initializing tIntercept 
 	Intercept->SetIntercpVariables( InFl, Moisture );
@@ -919,6 +1037,227 @@ void Simulator::RunItAgain( tInputFile &InFl, tHydroModel *Moisture,
 	return;
 }
 
+/*****************************************************************************
+**  
+**  Simulator::initialize_ensemble()
+**
+**  With the optional keyword ENSEMBLEFILE, the model is run for each 
+**  member of an ensemble (e.g. of forcing) with the mesh, flow network,
+**  resampling, sheltering and soil and land use data built from the input
+**  file of the command line, which is the first member. The file lists 
+**  the input file of each further member, one per line ('#' starts a 
+**  comment); a member input differs from the first in its forcing and 
+**  output file names, which tag the outputs of the member. The state of 
+**  the system after the initialization is saved to '<ENSEMBLEFILE>_state'
+**  and each member starts from it. ENSEMBLEJOBS members (default 
+**  NUMTHREADS) run at the same time, see RunEnsemble().
+**  
+*****************************************************************************/
+void Simulator::initialize_ensemble(tInputFile &InFl)
+{
+	char listFile[kName];
+	string line;
+
+	ensembleFiles.clear();
+	ensembleState.clear();
+	if (!InFl.IsItemIn( "ENSEMBLEFILE" ))
+		return;
+
+	ensembleJobs = tThreadPool::getNumThreads();
+	if (InFl.IsItemIn( "ENSEMBLEJOBS" ))
+		ensembleJobs = InFl.ReadItem(ensembleJobs, "ENSEMBLEJOBS");
+	if (ensembleJobs < 1)
+		ensembleJobs = 1;
+
+#ifdef PARALLEL_TRIBS
+	Cout<<"\nSimulator: Warning: ENSEMBLEFILE is not available in the "
+		<<"parallel version, running one member"<<endl;
+	return;
+#endif
+
+	InFl.ReadItem(listFile, "ENSEMBLEFILE");
+	ifstream list(listFile);
+	if (!list.good()) {
+		Cout<<"\nSimulator: Warning: ensemble file '"<<listFile
+			<<"' not found, running one member"<<endl;
+		return;
+	}
+	ensembleFiles.push_back(simCtrl->infile);
+	while (getline(list, line)) {
+		size_t b = line.find_first_not_of(" \t\r");
+		if (b == string::npos || line[b] == '#')
+			continue;
+		size_t e = line.find_last_not_of(" \t\r");
+		ensembleFiles.push_back(line.substr(b, e-b+1));
+	}
+	list.close();
+
+	ensembleState = string(listFile) + "_state";
+	writeState(ensembleState.c_str());
+
+	Cout<<"\nEnsemble of "<<ensembleFiles.size()
+		<<" members, initial state in '"<<ensembleState<<"'"<<endl;
+	if (ensembleJobs > 1)
+		Cout<<"Ensemble: "<<ensembleJobs<<" members at a time"<<endl;
+}
+
+/*****************************************************************************
+**  
+**  Simulator::RunEnsemble()
+**
+**  Runs the members of the ensemble, the first included, see 
+**  initialize_ensemble(). With ENSEMBLEJOBS = 1 the members run one after
+**  the other in this process, each on the NUMTHREADS threads.
+**
+**  Otherwise up to ENSEMBLEJOBS members run at the same time, each in a 
+**  process forked from this one, with its own copy of the nodes and of 
+**  the model objects. The NUMTHREADS threads are split between the 
+**  running members and the console output of a member goes to 
+**  '<member input>.log'. The thread pool is stopped while members are 
+**  started, so that no thread is copied in the middle of a loop. A member
+**  process closes the output files of its run and exits (_exit) without 
+**  deleting the objects it copied or flushing the streams of this one.
+**
+**  Returns 0 if there is no ensemble, 1 when the members have run.
+**  
+*****************************************************************************/
+int Simulator::RunEnsemble( tInputFile &InFl, tHydroModel *Moisture, 
+							tKinemat *Flow, tEvapoTrans *EvapoTrans, 
+							tIntercept *Intercept, tWaterBalance *Balance,
+							tPreProcess *PreProcessor, tSnowPack *SnowPack)
+{
+	int nMembers = (int)ensembleFiles.size();
+
+	if (!nMembers)
+		return 0;
+
+#ifndef WIN
+	if (ensembleJobs > 1) {
+		int nThreads = tThreadPool::getNumThreads();
+		int jobs = min(ensembleJobs, nMembers);
+		int memberThreads = max(1, nThreads/jobs);
+		int next = 0, running = 0, failed = 0;
+		vector<pid_t> pids(nMembers, 0);
+
+		tThreadPool::finalize();
+		cout<<flush;
+		cerr<<flush;
+		fflush(NULL);
+
+		while (next < nMembers || running) {
+			// Start a member if a job is free
+			if (next < nMembers && running < jobs) {
+				int k = next++;
+				if (!memberInput(k))
+					continue;
+
+				pid_t pid = fork();
+				if (pid == 0) {
+					string log = ensembleFiles[k] + ".log";
+					if (freopen(log.c_str(), "w", stdout))
+						dup2(fileno(stdout), fileno(stderr));
+					tThreadPool::initialize(memberThreads);
+					simCtrl->num_simul += k;
+					RunMember(k, InFl, Moisture, Flow, EvapoTrans, Intercept,
+							  Balance, PreProcessor, SnowPack);
+
+					Flow->theOFStream.close();
+					Flow->ControlOut.close();
+					outp->CloseOutletFiles();
+					tThreadPool::finalize();
+					cout<<flush;
+					cerr<<flush;
+					fflush(NULL);
+					_exit(0);
+				}
+				if (pid < 0) {
+					Cout<<"\nSimulator: Warning: member "<<k+1
+						<<" could not be started, skipping it"<<endl;
+					failed++;
+					continue;
+				}
+				pids[k] = pid;
+				running++;
+				Cout<<"\nEnsemble member "<<k+1<<" of "<<nMembers
+					<<": '"<<ensembleFiles[k]<<"' started"<<endl;
+				continue;
+			}
+
+			// Wait for a member to finish
+			int status;
+			pid_t pid = wait(&status);
+			if (pid < 0)
+				break;
+			for (int k = 0; k < nMembers; k++) {
+				if (pids[k] != pid)
+					continue;
+				running--;
+				if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+					Cout<<"\nEnsemble member "<<k+1<<" completed"<<endl;
+				else {
+					Cout<<"\nSimulator: Warning: member "<<k+1
+						<<" failed, see '"<<ensembleFiles[k]<<".log'"<<endl;
+					failed++;
+				}
+			}
+		}
+		if (failed)
+			Cout<<"\nSimulator: Warning: "<<failed<<" of "<<nMembers
+				<<" ensemble members did not complete"<<endl;
+
+		tThreadPool::initialize(nThreads);
+		remove(ensembleState.c_str());
+		return 1;
+	}
+#endif
+
+	for (int k=0; k < nMembers; k++) {
+		Cout<<"\n\nEnsemble member "<<k+1<<" of "<<nMembers
+			<<": '"<<ensembleFiles[k]<<"'"<<endl;
+		Cout<<"--------------------------------------"<<endl;
+
+		if (memberInput(k))
+			RunMember(k, InFl, Moisture, Flow, EvapoTrans, Intercept,
+					  Balance, PreProcessor, SnowPack);
+	}
+	remove(ensembleState.c_str());
+	return 1;
+}
+
+/*****************************************************************************
+**  
+**  Simulator::memberInput() and RunMember()
+**
+**  memberInput() checks that the input file of member 'k' exists.
+**  RunMember() resets the state of the system to the saved initial state;
+**  the forcing, time and output settings are then read from the member 
+**  input as in a new run that keeps the state and the soil and land use 
+**  maps.
+**  
+*****************************************************************************/
+int Simulator::memberInput(int k)
+{
+	ifstream source( ensembleFiles[k].c_str() );
+	if (!source.good()) {
+		Cout<<"\nSimulator: Warning: input file of member "<<k+1
+			<<" not found, skipping it"<<endl;
+		return 0;
+	}
+	return 1;
+}
+
+void Simulator::RunMember( int k, tInputFile &InFl, tHydroModel *Moisture, 
+						   tKinemat *Flow, tEvapoTrans *EvapoTrans, 
+						   tIntercept *Intercept, tWaterBalance *Balance,
+						   tPreProcess *PreProcessor, tSnowPack *SnowPack)
+{
+	readState(ensembleState.c_str());
+	simCtrl->num_simul++;
+	simCtrl->infile = (char *)ensembleFiles[k].c_str();
+	StartNewRun(InFl, Moisture, Flow, EvapoTrans, Intercept, Balance,
+				PreProcessor, SnowPack, 0, 1);
+}
+
 /***************************************************************************
 **
 ** Simulator::writeRestart() Function
@@ -959,6 +1298,64 @@ void Simulator::writeRestart(char* directory) const
   rStr.close();
 }
 
+/***************************************************************************
+**
+** Simulator::writeState() and readState() Functions
+**
+** Save the state of the simulation to file 'name' and read it back, in
+** the format of the restart files
+**
+***************************************************************************/
+void Simulator::writeState(const char *name) const
+{
+  fstream rStr;
+  rStr.open(name, ios::out|ios::binary);
+
+  BinaryWrite(rStr, count);
+  BinaryWrite(rStr, fState);
+  BinaryWrite(rStr, dt_rain);
+  BinaryWrite(rStr, lfr_hour);
+  BinaryWrite(rStr, lmr_hour);
+  BinaryWrite(rStr, begin_hour);
+  BinaryWrite(rStr, met_hour);
+  BinaryWrite(rStr, eti_hour);
+  BinaryWrite(rStr, GW_label);
+  BinaryWrite(rStr, searchRain);
+  restart->writeRestart(rStr);
+
+  if (!rStr.good()) {
+    Cout<<"\nSimulator: Error: state file '"<<name<<"' not written"<<endl;
+    Cout<<"Exiting Program..."<<endl;
+    exit(2);
+  }
+  rStr.close();
+}
+
+void Simulator::readState(const char *name)
+{
+  fstream rStr;
+  rStr.open(name, ios::in|ios::binary);
+
+  BinaryRead(rStr, count);
+  BinaryRead(rStr, fState);
+  BinaryRead(rStr, dt_rain);
+  BinaryRead(rStr, lfr_hour);
+  BinaryRead(rStr, lmr_hour);
+  BinaryRead(rStr, begin_hour);
+  BinaryRead(rStr, met_hour);
+  BinaryRead(rStr, eti_hour);
+  BinaryRead(rStr, GW_label);
+  BinaryRead(rStr, searchRain);
+  restart->readRestart(rStr);
+
+  if (!rStr.good()) {
+    Cout<<"\nSimulator: Error: state file '"<<name<<"' not read"<<endl;
+    Cout<<"Exiting Program..."<<endl;
+    exit(2);
+  }
+  rStr.close();
+}
+
 /***************************************************************************
 **
 ** Simulator::readRestart() Function
@@ -997,6 +1394,10 @@ void Simulator::readRestart(tInputFile &InFl)
   restart->readRestart(rStr);
 
   rStr.close();
+
+  // The adaptive GW step starts over at the restart time
+  gwLast = timer->getCurrentTime();
+  gwChange = 0.;
 }
 
 //=========================================================================
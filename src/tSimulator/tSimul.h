@@ -35,6 +35,9 @@
 #include "src/tHydro/tSnowPack.h" // SKY2008Snow from AJR2007
 #include "src/Headers/Inclusions.h"
 
+#include <string>
+#include <vector>
+
 //=========================================================================
 //
 //
@@ -65,9 +68,22 @@ class Simulator
   double met_hour;                // Time tag of last measured met
   double eti_hour;                // Time tag of last eti comp
   double GW_label;                // Label to check GW model run 
+
+  // Adaptive groundwater time step (OPTGWADAPT)
+  int gwAdaptOption;              // 1 if the GW step is adapted
+  double gwAdaptTol;              // GWADAPTTOL, change per GW step [mm]
+  double gwAdaptMax;              // GWADAPTMAX, longest GW step [hour]
+  double gwLast;                  // Time of the last GW step [hour]
+  double gwChange;                // Change since the last GW step [mm]
+  int gwSteps;                    // Number of GW steps of the run
   
   int searchRain;                 // Search threshold (hours)
 
+  // Ensemble of runs on the same mesh and static data (ENSEMBLEFILE)
+  std::vector<std::string> ensembleFiles;  // Input file of each member
+  std::string ensembleState;               // Initial state of the members
+  int ensembleJobs;                        // Members run at the same time
+
 
   int  check_mod_status();
   int  checkForecast();
@@ -83,14 +99,26 @@ class Simulator
 		       tInputFile&); // SKY2008Snow
   void RunItAgain(tInputFile&, tHydroModel*, tKinemat*, 
 		  tEvapoTrans*, tIntercept*, tWaterBalance*, tPreProcess*,  tSnowPack*); // SKY2008Snow from AJR2007
+  void StartNewRun(tInputFile&, tHydroModel*, tKinemat*, tEvapoTrans*,
+		   tIntercept*, tWaterBalance*, tPreProcess*, tSnowPack*,
+		   int, int);
+  void initialize_ensemble(tInputFile&);
+  int  RunEnsemble(tInputFile&, tHydroModel*, tKinemat*, tEvapoTrans*,
+		   tIntercept*, tWaterBalance*, tPreProcess*, tSnowPack*);
+  int  memberInput(int);
+  void RunMember(int, tInputFile&, tHydroModel*, tKinemat*, tEvapoTrans*,
+		 tIntercept*, tWaterBalance*, tPreProcess*, tSnowPack*);
   void PrintRunTimeVars(tHydroModel *, int);
   void UpdatePrecipitationInput(int);
   void SurfaceHydroProcesses(tEvapoTrans *, tIntercept *, tSnowPack *); // SKY2008Snow from AJR2007
   void SubSurfaceHydroProcesses(tHydroModel *);
+  double AdaptiveGWStep(tHydroModel *);
   void OutputSimulatedVars(tKinemat *);
   void UpdateWaterBalance(tWaterBalance *);
   void writeRestart(char*) const;
   void readRestart(tInputFile&);
+  void writeState(const char*) const;
+  void readState(const char*);
 };
 
 #endif 
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tThreadPool.cpp: Functions for class tThreadPool (see tThreadPool.h)
+**
+***************************************************************************/
+
+#include "src/tThreadPool/tThreadPool.h"
+#include "src/tInOut/tInputFile.h"
+#include "src/Headers/globalIO.h"
+
+#include <cstdlib>
+
+using namespace std;
+
+int tThreadPool::numThreads = 1;
+bool tThreadPool::running = false;
+bool tThreadPool::stopping = false;
+int tThreadPool::generation = 0;
+int tThreadPool::pending = 0;
+int tThreadPool::loopBegin = 0;
+int tThreadPool::loopEnd = 0;
+const tThreadPool::tLoopBody *tThreadPool::loopBody = nullptr;
+
+vector<thread> tThreadPool::workers;
+mutex tThreadPool::lock;
+condition_variable tThreadPool::posted;
+condition_variable tThreadPool::finished;
+
+int tThreadPool::getNumThreads()
+{
+  return numThreads;
+}
+
+bool tThreadPool::isRunning()
+{
+  return running;
+}
+
+/*************************************************************************
+**
+** Start the pool from the optional NUMTHREADS keyword
+**
+*************************************************************************/
+
+void tThreadPool::initialize(tInputFile &infile)
+{
+  int n = 1;
+  if (infile.IsItemIn( "NUMTHREADS" ))
+    n = infile.ReadItem(n, "NUMTHREADS");
+  initialize(n);
+}
+
+/*************************************************************************
+**
+** Start n-1 worker threads, the calling thread works as thread 0
+**
+*************************************************************************/
+
+void tThreadPool::initialize(int n)
+{
+  finalize();
+
+  if (n < 1) {
+    Cout << "tThreadPool: Warning: NUMTHREADS = " << n 
+         << " is not valid, using 1 thread" << endl;
+    n = 1;
+  }
+  numThreads = n;
+  stopping = false;
+  generation = 0;
+
+  // Threads still running at exit() (error paths) must not be joinable
+  static bool registered = false;
+  if (!registered) {
+    atexit(detachAll);
+    registered = true;
+  }
+
+  for (int t = 1; t < numThreads; t++)
+    workers.push_back(thread(workerLoop, t));
+
+  if (numThreads > 1)
+    Cout << "tThreadPool: " << numThreads << " thread(s) started." << endl;
+}
+
+/*************************************************************************
+**
+** Stop and join the worker threads
+**
+*************************************************************************/
+
+void tThreadPool::finalize()
+{
+  {
+    unique_lock<mutex> guard(lock);
+    stopping = true;
+  }
+  posted.notify_all();
+  for (size_t t = 0; t < workers.size(); t++)
+    workers[t].join();
+  workers.clear();
+  numThreads = 1;
+  stopping = false;
+}
+
+/*************************************************************************
+**
+** Called at exit(): release the worker threads without waiting for them
+**
+*************************************************************************/
+
+void tThreadPool::detachAll()
+{
+  for (size_t t = 0; t < workers.size(); t++)
+    if (workers[t].joinable())
+      workers[t].detach();
+}
+
+/*************************************************************************
+**
+** Run the block of the current loop that belongs to thread t
+**
+*************************************************************************/
+
+void tThreadPool::runBlock(int t)
+{
+  long n = loopEnd - loopBegin;
+  int first = loopBegin + (int)(n*t/numThreads);
+  int last  = loopBegin + (int)(n*(t+1)/numThreads);
+  if (first < last)
+    (*loopBody)(first, last, t);
+}
+
+/*************************************************************************
+**
+** Worker threads wait for a new loop, run their block and report back
+**
+*************************************************************************/
+
+void tThreadPool::workerLoop(int t)
+{
+  int seen = 0;
+  while (true) {
+    {
+      unique_lock<mutex> guard(lock);
+      posted.wait(guard, [&]{ return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+    }
+
+    runBlock(t);
+
+    {
+      unique_lock<mutex> guard(lock);
+      if (--pending == 0)
+        finished.notify_one();
+    }
+  }
+}
+
+/*************************************************************************
+**
+** Split [begin, end) in numThreads contiguous blocks. Block t always 
+** covers the same range for a given thread count, and the call returns 
+** when all blocks are done. Nested calls run serially.
+**
+*************************************************************************/
+
+void tThreadPool::parallelFor(int begin, int end, const tLoopBody &body)
+{
+  if (end <= begin)
+    return;
+
+  if (numThreads == 1 || running) {
+    body(begin, end, 0);
+    return;
+  }
+
+  {
+    unique_lock<mutex> guard(lock);
+    running = true;
+    loopBegin = begin;
+    loopEnd = end;
+    loopBody = &body;
+    pending = numThreads - 1;
+    generation++;
+  }
+  posted.notify_all();
+
+  runBlock(0);
+
+  {
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, []{ return pending == 0; });
+    running = false;
+    loopBody = nullptr;
+  }
+}
+
+/*************************************************************************
+**
+** Call body(t) once on each thread t
+**
+*************************************************************************/
+
+void tThreadPool::forEachThread(const function<void(int)> &body)
+{
+  parallelFor(0, numThreads, [&](int first, int last, int) {
+    for (int t = first; t < last; t++)
+      body(t);
+  });
+}
+
+//=========================================================================
+//
+//
+//                          End of tThreadPool.cpp
+//
+//
+//=========================================================================
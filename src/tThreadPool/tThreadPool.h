@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tThreadPool.h: Header for tThreadPool class
+**
+**  tThreadPool provides the shared-memory (thread) parallelism used by
+**  the node loops of the hydrologic model. The pool is started once with
+**  the number of threads given by the optional keyword NUMTHREADS 
+**  (default 1, i.e. everything runs serially on the calling thread).
+**  Work is split into contiguous blocks, one per thread, so that the
+**  assignment of work to threads is deterministic.
+** 
+***************************************************************************/
+
+//=========================================================================
+//
+//
+//                  Section 1: tThreadPool Include and Define Statements
+//
+//
+//=========================================================================
+
+#ifndef TTHREADPOOL_H
+#define TTHREADPOOL_H
+
+#include <functional>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class tInputFile;
+
+//=========================================================================
+//
+//
+//                  Section 2: tThreadPool Class Definitions
+//
+//
+//=========================================================================
+
+class tThreadPool {
+
+public:
+  /// Body of a parallel loop: (first, last+1, thread number)
+  typedef std::function<void(int, int, int)> tLoopBody;
+
+  /// Start the pool with the number of threads in the input file
+  static void initialize(tInputFile &);
+  /// Start the pool with a given number of threads
+  static void initialize(int);
+  /// Stop and join the worker threads
+  static void finalize();
+
+  /// Return number of threads (including the calling thread)
+  static int getNumThreads();
+  /// Is a parallel loop currently running?
+  static bool isRunning();
+
+  /// Split [begin, end) in contiguous blocks and run them on the pool
+  static void parallelFor(int begin, int end, const tLoopBody &body);
+  /// Run body(i) for i in [0, n) on the pool, one call per thread
+  static void forEachThread(const std::function<void(int)> &body);
+
+private:
+  static void workerLoop(int);
+  static void runBlock(int);
+  static void detachAll();
+
+  static int numThreads;                     //!< # of threads
+  static bool running;                       //!< Loop in progress
+  static bool stopping;                      //!< Workers should exit
+  static int generation;                     //!< Counter of posted loops
+  static int pending;                        //!< Blocks not yet finished
+  static int loopBegin;                      //!< Current loop range
+  static int loopEnd;
+  static const tLoopBody *loopBody;          //!< Current loop body
+
+  static std::vector<std::thread> workers;   //!< Worker threads
+  static std::mutex lock;
+  static std::condition_variable posted;     //!< Signals new work
+  static std::condition_variable finished;   //!< Signals completed work
+};
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of tThreadPool.h 
+//
+//
+//=========================================================================
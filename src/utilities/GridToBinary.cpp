@@ -0,0 +1,75 @@
+/***************************************************************************
+**
+**                           tRIBS Version 1.0
+**
+**              TIN-based Real-time Integrated Basin Simulator
+**
+**
+**  GridToBinary.cpp:  Utility program used for converting ArcInfo/ArcView
+**                     ASCII grids to a tRIBS binary raster file
+**                     (see src/tRasTin/tBinaryRaster.h). All grids must
+**                     have the same header; each becomes one slice of the
+**                     file, labeled with its path. The paths must be
+**                     those the input file gives (run from the same
+**                     directory as tRIBS).
+**
+**  Usage:
+**
+**  GridToBinary [-f32] <output file> <grid 1> [<grid 2> ...]
+**
+**      -f32  stores the values as float32 (half the size, the values
+**            are copied on reading instead of used in place)
+**
+**  A single binary file may be given wherever tRIBS reads an ASCII grid.
+**  A file of several grids (e.g. all radar rainfall grids of a run) is
+**  given with the GRIDARCHIVE keyword of the input file.
+**
+**  Program compiled separately from tRIBS (from the project root) as:
+**
+**  UNIX%  g++ -std=c++11 -I. -o <executable> src/utilities/GridToBinary.cpp
+**         src/tRasTin/tBinaryRaster.cpp src/tRasTin/tGridPrefetch.cpp
+**         -DLINUX_32 -lpthread
+**
+***************************************************************************/
+
+#include "src/tRasTin/tBinaryRaster.h"
+
+#include <iostream>
+#include <cstring>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+	int valueSize = 8;
+	int first = 1;
+
+	if (argc > 1 && strcmp(argv[1], "-f32") == 0) {
+		valueSize = 4;
+		first++;
+	}
+	if (argc - first < 2) {
+		cout<<"Usage: "<<argv[0]
+			<<" [-f32] <output file> <grid 1> [<grid 2> ...]"<<endl;
+		return 1;
+	}
+
+	int n = argc - first - 1;
+	cout<<"Converting "<<n<<" grid(s) to "<<argv[first]<<" ("
+		<<(valueSize == 8 ? "float64" : "float32")<<")"<<endl;
+
+	if (!tBinaryRaster::convertGrids(argv[first], valueSize, n,
+									 argv + first + 1))
+		return 1;
+
+	cout<<"Done."<<endl;
+	return 0;
+}
+
+//=========================================================================
+//
+//
+//                         End of GridToBinary.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,149 @@
+/***************************************************************************
+**
+**                           tRIBS Version 1.0
+**
+**              TIN-based Real-time Integrated Basin Simulator
+**
+**
+**  HydroStoreExport.cpp:  Utility program used for converting the binary
+**                         hydrograph store written with OPTHYDROBINARY = 1
+**                         (<OUTHYDROFILENAME>.hts, see
+**                         src/tFlowNet/tHydroStore.h) to the text files
+**                         of the basin outlet: the *.mrf hydrograph and
+**                         basin averages, and the *.rft runoff types.
+**
+**  Usage:
+**
+**  HydroStoreExport [-noheader] <store> <mrf file> [<rft file>]
+**
+**      -noheader  omits the two header lines (as with HEADERLABEL N)
+**
+**  The store is read one block at a time, so memory does not depend on
+**  the length of the run. The lines are those of the *.mrf and *.rft
+**  files written at the end of the run.
+**
+**  Program built with tRIBS by CMake (target HydroStoreExport), or
+**  separately (from the project root) as:
+**
+**  UNIX%  g++ -std=c++11 -I. -o <executable>
+**         src/utilities/HydroStoreExport.cpp src/tFlowNet/tHydroStore.cpp
+**         -DLINUX_32
+**
+***************************************************************************/
+
+#include "src/tFlowNet/tHydroStore.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+// Columns of the *.rft file, all others go to the *.mrf file
+static int IsRunoffType(const string &name)
+{
+	return name == "Hsrf" || name == "Sbsrf" || name == "Psrf" ||
+		name == "Satsrf";
+}
+
+int main(int argc, char **argv)
+{
+	int header = 1;
+	int first = 1;
+
+	if (argc > 1 && strcmp(argv[1], "-noheader") == 0) {
+		header = 0;
+		first++;
+	}
+	if (argc - first < 2) {
+		cout<<"Usage: "<<argv[0]
+			<<" [-noheader] <store> <mrf file> [<rft file>]"<<endl;
+		return 1;
+	}
+
+	tHydroStore store;
+	if (!store.open(argv[first])) {
+		cout<<"Error: "<<argv[first]<<" is not a hydrograph store"<<endl;
+		return 1;
+	}
+
+	FILE *mrf = fopen(argv[first+1], "w");
+	FILE *rft = (argc - first > 2) ? fopen(argv[first+2], "w") : NULL;
+	if (mrf == NULL || (argc - first > 2 && rft == NULL)) {
+		cout<<"Error: Unable to open output files"<<endl;
+		return 1;
+	}
+
+	int nCol = store.getNumColumns();
+	int fCol = store.findColumn("FState");
+
+	if (header) {
+		fprintf(mrf, "Time");
+		for (int c = 0; c < nCol; c++)
+			if (!IsRunoffType(store.getName(c)))
+				fprintf(mrf, "\t%s", store.getName(c).c_str());
+		fprintf(mrf, "\nhr");
+		for (int c = 0; c < nCol; c++)
+			if (!IsRunoffType(store.getName(c)))
+				fprintf(mrf, "\t%s", store.getUnit(c).c_str());
+		fprintf(mrf, "\n");
+
+		if (rft) {
+			fprintf(rft, "Time");
+			for (int c = 0; c < nCol; c++)
+				if (IsRunoffType(store.getName(c)))
+					fprintf(rft, "\t%s", store.getName(c).c_str());
+			fprintf(rft, "\nhr");
+			for (int c = 0; c < nCol; c++)
+				if (IsRunoffType(store.getName(c)))
+					fprintf(rft, "\t%s", store.getUnit(c).c_str());
+			fprintf(rft, "\n");
+		}
+	}
+
+	vector<double> values;
+	int step0, n, it_hour, it_min;
+	long steps = 0;
+
+	while (store.readBlock(step0, n, values)) {
+		for (int i = 0; i < n; i++) {
+			store.stepTime(step0 + i, &it_hour, &it_min);
+
+			fprintf(mrf, "%d.%d", it_hour, it_min);
+			for (int c = 0; c < nCol; c++) {
+				if (IsRunoffType(store.getName(c)))
+					continue;
+				if (c == fCol)
+					fprintf(mrf, "\t%d", (int)values[(size_t)c*n + i]);
+				else
+					fprintf(mrf, "\t%f", values[(size_t)c*n + i]);
+			}
+			fprintf(mrf, "\n");
+
+			if (rft) {
+				fprintf(rft, "%04d.%02d \t", it_hour, it_min);
+				int k = 0;
+				for (int c = 0; c < nCol; c++)
+					if (IsRunoffType(store.getName(c)))
+						fprintf(rft, k++ ? "\t%f" : "%f",
+								values[(size_t)c*n + i]);
+				fprintf(rft, "\n");
+			}
+		}
+		steps += n;
+	}
+
+	fclose(mrf);
+	if (rft)
+		fclose(rft);
+	cout<<"Exported "<<steps<<" result steps."<<endl;
+	return 0;
+}
+
+//=========================================================================
+//
+//
+//                         End of HydroStoreExport.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  bandSolverTest.cpp: Unit test of BandDecompose()/BandBackSubstitute()
+**
+**  Solves tridiagonal systems filled as tKinemat::SolveLinearSystem does,
+**  and a system with two sub-diagonals, and compares the solutions with
+**  those of a dense Gaussian elimination with partial pivoting.
+**
+***************************************************************************/
+
+#include "src/Mathutil/bandSolver.h"
+#include "testing/unit/unitTest.h"
+
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+
+// Dense matrix 'A' (n x n, row by row) and right hand side 'b'
+static vector<double> DenseSolve(vector<double> A, vector<double> b, int n)
+{
+  for (int k = 0; k < n; k++) {
+    int p = k;
+    for (int i = k + 1; i < n; i++)
+      if (fabs(A[i * n + k]) > fabs(A[p * n + k]))
+        p = i;
+    for (int j = 0; j < n; j++)
+      swap(A[k * n + j], A[p * n + j]);
+    swap(b[k], b[p]);
+    for (int i = k + 1; i < n; i++) {
+      double f = A[i * n + k] / A[k * n + k];
+      for (int j = k; j < n; j++)
+        A[i * n + j] -= f * A[k * n + j];
+      b[i] -= f * b[k];
+    }
+  }
+  vector<double> x(n);
+  for (int i = n - 1; i >= 0; i--) {
+    double s = b[i];
+    for (int j = i + 1; j < n; j++)
+      s -= A[i * n + j] * x[j];
+    x[i] = s / A[i * n + i];
+  }
+  return x;
+}
+
+// Solves A*x = b for the band of A (M1 sub-, M2 super-diagonals) with
+// BandDecompose/BandBackSubstitute and compares with DenseSolve()
+template <int M1, int M2>
+static void CheckBand(const vector<double> &A, const vector<double> &b, int n)
+{
+  const int ra = M1 + M2 + 2;
+  vector<double> a((n + 1) * ra, 0.0), al((n + 1) * (M1 + 1), 0.0);
+  vector<unsigned long> indx(n + 1);
+  vector<double> x(n + 1);
+
+  // Row i holds A(i, i-M1 .. i+M2), elements outside of A are zero
+  for (int i = 1; i <= n; i++) {
+    for (int j = 1; j <= M1 + M2 + 1; j++) {
+      int col = i - M1 + j - 2;
+      if (col >= 0 && col < n)
+        a[i * ra + j] = A[(i - 1) * n + col];
+    }
+    x[i] = b[i - 1];
+  }
+
+  BandDecompose<M1, M2>(a.data(), al.data(), indx.data(), n);
+  BandBackSubstitute<M1, M2>(a.data(), al.data(), indx.data(), x.data(), n);
+
+  vector<double> ref = DenseSolve(A, b, n);
+  for (int i = 0; i < n; i++)
+    CHECK_CLOSE(x[i + 1], ref[i], 1e-9 * (1.0 + fabs(ref[i])));
+}
+
+static double Random(double lo, double hi)
+{
+  return lo + (hi - lo) * (rand() % 10000) / 10000.0;
+}
+
+static void testTridiagonal()
+{
+  srand(2025);
+
+  // The Jacobians of the channel routing are diagonally dominant
+  for (int n = 1; n <= 40; n += 3) {
+    vector<double> A(n * n, 0.0), b(n);
+    for (int i = 0; i < n; i++) {
+      if (i > 0) A[i * n + i - 1] = Random(-2.0, 0.0);
+      if (i < n - 1) A[i * n + i + 1] = Random(0.0, 2.0);
+      A[i * n + i] = Random(4.0, 6.0);
+      b[i] = Random(-10.0, 10.0);
+    }
+    CheckBand<1, 1>(A, b, n);
+  }
+
+  // Rows that need pivoting: small and zero diagonal elements
+  int n = 9;
+  vector<double> A(n * n, 0.0), b(n);
+  for (int i = 0; i < n; i++) {
+    if (i > 0) A[i * n + i - 1] = Random(1.0, 3.0);
+    if (i < n - 1) A[i * n + i + 1] = Random(1.0, 3.0);
+    A[i * n + i] = (i % 2) ? 0.0 : Random(-0.01, 0.01);
+    b[i] = Random(-1.0, 1.0);
+  }
+  CheckBand<1, 1>(A, b, n);
+}
+
+static void testWiderBand()
+{
+  int n = 17;
+  vector<double> A(n * n, 0.0), b(n);
+
+  srand(7);
+  for (int i = 0; i < n; i++) {
+    for (int j = i - 2; j <= i + 1; j++)
+      if (j >= 0 && j < n)
+        A[i * n + j] = Random(-1.0, 1.0);
+    b[i] = Random(-5.0, 5.0);
+  }
+  CheckBand<2, 1>(A, b, n);
+}
+
+int main()
+{
+  testTridiagonal();
+  testWiderBand();
+  return unitTestResult("bandSolverTest");
+}
+
+//=========================================================================
+//
+//
+//                          End of bandSolverTest.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tHydroStoreTest.cpp: Unit test of tHydroStore
+**
+**  Writes a store in blocks and reads it back, then continues it from a
+**  restart as tFlowResults does: append() keeps the steps before the
+**  restart, within a block too, and removes the later ones, and the
+**  blocks of the continued run follow.
+**
+***************************************************************************/
+
+#include "src/tFlowNet/tHydroStore.h"
+#include "testing/unit/unitTest.h"
+
+#include <cstdio>
+
+using namespace std;
+
+static const char *kName = "tHydroStoreTest.hts";
+static const int kCols = 3;
+
+static vector<string> Names() { return {"Qout", "Rain", "SM"}; }
+static vector<string> Units() { return {"m3/s", "mm/hr", "-"}; }
+
+// Value of column 'c' at 'step' in run 'run'
+static double Value(int run, int step, int c)
+{
+  return 1000.0 * run + 10.0 * step + c;
+}
+
+// Writes the steps [first, first+n) of run 'run' as one block
+static void WriteSteps(tHydroStore &store, int run, int first, int n)
+{
+  vector<double> values(n * kCols);
+  for (int c = 0; c < kCols; c++)
+    for (int i = 0; i < n; i++)
+      values[c * n + i] = Value(run, first + i, c);
+  store.writeBlock(first, n, values.data());
+}
+
+// Reads the store back: run[step] is the run of each step read in order
+static void CheckStore(const vector<int> &run)
+{
+  tHydroStore store;
+  int first, n, next = 0;
+  vector<double> values;
+
+  CHECK(store.open(kName));
+  CHECK(store.getNumColumns() == kCols);
+  CHECK(store.getStartHour() == 6.0 && store.getInterval() == 0.25);
+  while (store.readBlock(first, n, values)) {
+    CHECK(first == next);
+    for (int i = 0; i < n && first + i < (int)run.size(); i++)
+      for (int c = 0; c < kCols; c++)
+        CHECK(values[c * n + i] == Value(run[first + i], first + i, c));
+    next = first + n;
+  }
+  CHECK(next == (int)run.size());
+}
+
+static void testWriteRead()
+{
+  tHydroStore store;
+
+  CHECK(store.create(kName, 6.0, 0.25, Names(), Units()));
+  WriteSteps(store, 0, 0, 4);
+  WriteSteps(store, 0, 4, 1);
+  WriteSteps(store, 0, 5, 6);
+  store.writeBlock(11, 0, NULL);
+  store.close();
+  CheckStore(vector<int>(11, 0));
+
+  CHECK(store.open(kName));
+  CHECK(store.findColumn("Rain") == 1);
+  CHECK(store.findColumn("Qin") == -1);
+  CHECK(store.getName(2) == "SM" && store.getUnit(0) == "m3/s");
+
+  int ihour, imin;
+  store.stepTime(5, &ihour, &imin);
+  CHECK(ihour == 7 && imin == 30);
+}
+
+static void testAppend()
+{
+  tHydroStore store;
+  vector<int> run(11, 0);
+
+  // Restart at step 7, within the block of steps 5 to 10
+  CHECK(store.append(kName, 6.0, 0.25, Names(), Units(), 7));
+  WriteSteps(store, 1, 7, 5);
+  store.close();
+  run.resize(12);
+  for (int s = 7; s < 12; s++)
+    run[s] = 1;
+  CheckStore(run);
+
+  // Restart at the first step of a block
+  CHECK(store.append(kName, 6.0, 0.25, Names(), Units(), 7));
+  WriteSteps(store, 2, 7, 2);
+  store.close();
+  run.resize(9);
+  run[7] = run[8] = 2;
+  CheckStore(run);
+
+  // Restart after the last step: all is kept
+  CHECK(store.append(kName, 6.0, 0.25, Names(), Units(), 20));
+  store.close();
+  CheckStore(run);
+
+  // Restart at the start: no step is kept
+  CHECK(store.append(kName, 6.0, 0.25, Names(), Units(), 0));
+  WriteSteps(store, 3, 0, 3);
+  store.close();
+  CheckStore(vector<int>(3, 3));
+}
+
+static void testMismatch()
+{
+  tHydroStore store;
+  vector<string> names = Names();
+
+  // A store of other columns or times is not continued
+  names[1] = "MAP";
+  CHECK(!store.append(kName, 6.0, 0.25, names, Units(), 2));
+  CHECK(!store.append(kName, 5.0, 0.25, Names(), Units(), 2));
+  CHECK(!store.append(kName, 6.0, 0.5, Names(), Units(), 2));
+  CheckStore(vector<int>(3, 3));
+
+  remove(kName);
+  CHECK(!store.append(kName, 6.0, 0.25, Names(), Units(), 2));
+  CHECK(!store.open(kName));
+
+  // Nor is a file that is not a store
+  FILE *fp = fopen(kName, "w");
+  fputs("Not a store of the outlet\n", fp);
+  fclose(fp);
+  CHECK(!store.open(kName));
+  CHECK(!store.append(kName, 6.0, 0.25, Names(), Units(), 2));
+  remove(kName);
+}
+
+int main()
+{
+  testWriteRead();
+  testAppend();
+  testMismatch();
+  return unitTestResult("tHydroStoreTest");
+}
+
+//=========================================================================
+//
+//
+//                          End of tHydroStoreTest.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tNetOrderTest.cpp: Unit test of NetOrder()
+**
+**  Compares the order of NetOrder() with that of the "cascade" algorithm
+**  of Braun and Sambridge, as the former tFlowNet::SortNodesByNetOrder()
+**  ran it on the node list, for sample flow networks: a chain, a binary
+**  tree, random networks draining to one or more outlets and to nodes
+**  that are not active. Checks that loops are reported.
+**
+***************************************************************************/
+
+#include "src/tFlowNet/tNetOrder.h"
+#include "testing/unit/unitTest.h"
+
+#include <cstdlib>
+
+using namespace std;
+
+// The cascade: each node starts with a tracer; at each pass every node
+// left sends a tracer to its receiver (lost if not active), then the
+// nodes without tracers move to the bottom of the list, in list order
+static vector<int> Cascade(const vector<int> &receiver)
+{
+  int n = (int)receiver.size();
+  vector<int> tracer(n, 1), list, sorted;
+
+  for (int i = 0; i < n; i++)
+    list.push_back(i);
+  while (!list.empty()) {
+    for (size_t k = 0; k < list.size(); k++) {
+      tracer[list[k]]--;
+      if (receiver[list[k]] >= 0)
+        tracer[receiver[list[k]]]++;
+    }
+    vector<int> left;
+    for (size_t k = 0; k < list.size(); k++)
+      if (tracer[list[k]] == 0)
+        sorted.push_back(list[k]);
+      else
+        left.push_back(list[k]);
+    list.swap(left);
+  }
+  return sorted;
+}
+
+static void CheckNet(const vector<int> &receiver)
+{
+  int n = (int)receiver.size();
+  vector<int> order, upstream;
+
+  CHECK(NetOrder(receiver, order, upstream) == 0);
+  CHECK(order == Cascade(receiver));
+  CHECK((int)upstream.size() == n);
+
+  // Upstream counts: the node and those of its donors
+  vector<int> sum(n, 1);
+  for (int i = 0; i < n; i++)
+    if (receiver[i] >= 0)
+      sum[receiver[i]] += upstream[i];
+  CHECK(sum == upstream);
+
+  // Every receiver comes after the node
+  vector<int> position(n, -1);
+  for (int k = 0; k < (int)order.size(); k++)
+    position[order[k]] = k;
+  for (int i = 0; i < n; i++)
+    CHECK(receiver[i] < 0 || position[receiver[i]] > position[i]);
+}
+
+// A network of 'n' nodes: each node drains to a random node of a later
+// rank, with the ranks in a random list order; 'outlets' nodes of the
+// last ranks drain out, and 'lost' nodes drain to nodes that are not
+// active
+static vector<int> RandomNet(int n, int outlets, int lost)
+{
+  vector<int> rank(n), receiver(n, -1);
+
+  for (int i = 0; i < n; i++)
+    rank[i] = i;
+  for (int i = n - 1; i > 0; i--)
+    swap(rank[i], rank[rand() % (i + 1)]);
+  for (int r = 0; r < n - outlets; r++) {
+    int to = r + 1 + rand() % (n - r - 1 < 6 ? n - r - 1 : 6);
+    receiver[rank[r]] = rank[to];
+  }
+  for (int k = 0; k < lost; k++)
+    receiver[rank[rand() % n]] = -1;
+  return receiver;
+}
+
+static void testSamples()
+{
+  // A chain listed from the outlet up
+  vector<int> chain(8);
+  for (int i = 0; i < 8; i++)
+    chain[i] = i - 1;
+  CheckNet(chain);
+
+  // A binary tree: node i drains to (i-1)/2, the root 0 is the outlet
+  vector<int> tree(31);
+  for (int i = 0; i < 31; i++)
+    tree[i] = (i - 1) / 2 - (i == 0);
+  CheckNet(tree);
+
+  // Single node and no nodes
+  CheckNet(vector<int>(1, -1));
+  CheckNet(vector<int>());
+}
+
+static void testRandom()
+{
+  srand(4321);
+  for (int t = 0; t < 50; t++) {
+    int n = 2 + rand() % 300;
+    CheckNet(RandomNet(n, 1, 0));
+    CheckNet(RandomNet(n, 1 + rand() % 3, rand() % 5));
+  }
+}
+
+static void testLoop()
+{
+  // 1 -> 2 -> 3 -> 1, and 4 draining into the loop: the nodes of the
+  // loop are reported
+  vector<int> receiver = { -1, 2, 3, 1, 2, 0 };
+  vector<int> order, upstream;
+  CHECK(NetOrder(receiver, order, upstream) == 3);
+}
+
+int main()
+{
+  testSamples();
+  testRandom();
+  testLoop();
+  return unitTestResult("tNetOrderTest");
+}
+
+//=========================================================================
+//
+//
+//                          End of tNetOrderTest.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tNodeHeapTest.cpp: Unit test of tNodeHeap
+**
+**  Checks the order of the heap (keys, decrease-key, equal keys, FIFO)
+**  and compares the search of tFlowNet::WeightedShortestPath on a sample
+**  stream network, a grid with its outlet in a corner, settling the nodes
+**  least path variable first and in the order they are reached (the
+**  former search, OPTPATHHEAP = 0).
+**
+***************************************************************************/
+
+#include "src/tFlowNet/tNodeHeap.h"
+#include "testing/unit/unitTest.h"
+
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+
+//=========================================================================
+//
+//  Order of the heap
+//
+//=========================================================================
+
+static void testOrder()
+{
+  tNodeHeap heap(8);
+  double keys[8] = {5.0, 3.0, 7.0, 1.0, 6.0, 2.0, 8.0, 4.0};
+
+  for (int i = 0; i < 8; i++)
+    heap.push(i, keys[i]);
+  CHECK(heap.getSize() == 8);
+
+  double last = -1.0;
+  while (!heap.isEmpty()) {
+    int item = heap.pop();
+    CHECK(!heap.contains(item));
+    CHECK(heap.getKey(item) >= last);
+    last = heap.getKey(item);
+  }
+
+  // A queued key is lowered, not raised
+  heap.push(0, 5.0);
+  heap.push(1, 4.0);
+  heap.push(0, 3.0);
+  heap.push(1, 9.0);
+  CHECK(heap.getKey(0) == 3.0);
+  CHECK(heap.getKey(1) == 4.0);
+  CHECK(heap.pop() == 0);
+  CHECK(heap.pop() == 1);
+
+  // clear() empties the heap, resize() also the keys
+  heap.push(2, 1.0);
+  heap.push(3, 1.0);
+  heap.clear();
+  CHECK(heap.isEmpty());
+  CHECK(!heap.contains(2) && !heap.contains(3));
+  heap.resize(3);
+  CHECK(heap.isEmpty() && heap.getKey(0) == 0.0);
+}
+
+static void testTies()
+{
+  tNodeHeap heap(6);
+
+  // Equal keys: lower level first, then in the order queued
+  heap.push(4, 1.0, 2);
+  heap.push(2, 1.0, 1);
+  heap.push(5, 1.0, 1);
+  heap.push(0, 1.0, 2);
+  heap.push(1, 0.5, 3);
+  CHECK(heap.pop() == 1);
+  CHECK(heap.pop() == 2);
+  CHECK(heap.pop() == 5);
+  CHECK(heap.pop() == 4);
+  CHECK(heap.pop() == 0);
+
+  // Lowering a key keeps the level and place among equal keys
+  heap.push(3, 2.0, 1);
+  heap.push(4, 2.0, 1);
+  heap.push(3, 2.0);
+  heap.push(4, 2.0, 0);
+  CHECK(heap.getLevel(4) == 1);
+  CHECK(heap.pop() == 3);
+  CHECK(heap.pop() == 4);
+}
+
+static void testFifo()
+{
+  tNodeHeap heap(5);
+  heap.setFifo(1);
+
+  heap.push(3, 4.0);
+  heap.push(1, 1.0, 5);
+  heap.push(4, 2.0);
+  heap.push(3, 0.5);
+  heap.push(0, 3.0);
+  CHECK(heap.getKey(3) == 0.5);
+  CHECK(heap.pop() == 3);
+  CHECK(heap.pop() == 1);
+  CHECK(heap.pop() == 4);
+  CHECK(heap.pop() == 0);
+  CHECK(heap.isEmpty());
+}
+
+//=========================================================================
+//
+//  Sample stream network
+//
+//  The nodes of a grid of 'rows' x 'cols' joined to their 4 neighbors,
+//  with the outlet at node 0. Search() follows WeightedShortestPath: a
+//  settled node takes the least path variable through its settled
+//  neighbors (first found on equal values), corrects the settled
+//  neighbors that have a shorter path through it (UpdatePathVariable),
+//  queues its unreached neighbors and lowers the keys of the queued ones.
+//
+//=========================================================================
+
+struct tSampleNet
+{
+  int rows, cols;
+  vector<double> weight;             // Edge weights, 4 per node
+  vector<double> path;               // Path variable
+  vector<int> receiver;              // Flow receiver
+  vector<int> settled;               // Order of settling
+  int corrections;
+
+  tSampleNet(int r, int c) : rows(r), cols(c), weight(4 * r * c, 1.0) {}
+
+  int size() const { return rows * cols; }
+
+  // Neighbor 'k' (E, N, W, S) of 'n', -1 off the grid
+  int neighbor(int n, int k) const
+  {
+    int r = n / cols, c = n % cols;
+    switch (k) {
+    case 0:  return c + 1 < cols ? n + 1 : -1;
+    case 1:  return r + 1 < rows ? n + cols : -1;
+    case 2:  return c > 0 ? n - 1 : -1;
+    default: return r > 0 ? n - cols : -1;
+    }
+  }
+
+  // The weight of an edge is the same both ways
+  double edgeWeight(int n, int k) const
+  {
+    int m = neighbor(n, k);
+    return (k < 2) ? weight[4 * n + k] : weight[4 * m + k - 2];
+  }
+
+  void correct(int n, vector<int> &done)
+  {
+    for (int k = 0; k < 4; k++) {
+      int m = neighbor(n, k);
+      if (m < 0 || !done[m])
+        continue;
+      if (path[n] + edgeWeight(n, k) < path[m]) {
+        path[m] = path[n] + edgeWeight(n, k);
+        receiver[m] = n;
+        corrections++;
+        correct(m, done);
+      }
+    }
+  }
+
+  void search(int fifo)
+  {
+    tNodeHeap heap(size());
+    vector<int> done(size(), 0);
+
+    heap.setFifo(fifo);
+    path.assign(size(), 1.0E+9);
+    receiver.assign(size(), -1);
+    settled.clear();
+    corrections = 0;
+
+    path[0] = 0.0;
+    int n = 0;
+    while (1) {
+      for (int k = 0; k < 4 && n != 0; k++) {
+        int m = neighbor(n, k);
+        if (m >= 0 && done[m] && path[m] + edgeWeight(n, k) < path[n]) {
+          path[n] = path[m] + edgeWeight(n, k);
+          receiver[n] = m;
+        }
+      }
+      done[n] = 1;
+      settled.push_back(n);
+      correct(n, done);
+
+      for (int k = 0; k < 4; k++) {
+        int m = neighbor(n, k);
+        if (m >= 0 && !done[m] && !heap.contains(m))
+          heap.push(m, 1.0E+9, heap.getLevel(n) + 1);
+      }
+      for (int k = 0; k < 4; k++) {
+        int m = neighbor(n, k);
+        if (m >= 0 && heap.contains(m))
+          heap.push(m, path[n] + edgeWeight(n, k));
+      }
+      if (heap.isEmpty())
+        break;
+      n = heap.pop();
+    }
+  }
+};
+
+static void testSampleNet()
+{
+  // Equal weights: every node of a level has the same path variable, and
+  // the nodes are settled in the order of the former search
+  tSampleNet flat(12, 9);
+  flat.search(1);
+  vector<int> order = flat.settled;
+  vector<int> receiver = flat.receiver;
+  flat.search(0);
+  CHECK((int)flat.settled.size() == flat.size());
+  CHECK(flat.settled == order);
+  CHECK(flat.receiver == receiver);
+  CHECK(flat.corrections == 0);
+
+  // Other weights: same path variables, no correction least first
+  tSampleNet net(15, 11);
+  srand(12345);
+  for (size_t i = 0; i < net.weight.size(); i++)
+    net.weight[i] = 1.0 + (rand() % 1000) / 100.0;
+  net.search(1);
+  vector<double> path = net.path;
+  CHECK(net.corrections > 0);
+  net.search(0);
+  CHECK(net.corrections == 0);
+  for (int i = 0; i < net.size(); i++) {
+    CHECK_CLOSE(net.path[i], path[i], 1e-9);
+    CHECK(i == 0 || net.receiver[i] >= 0);
+  }
+
+  // Least first, the nodes are settled by increasing path variable
+  for (size_t i = 1; i < net.settled.size(); i++)
+    CHECK(net.path[net.settled[i]] >= net.path[net.settled[i - 1]]);
+}
+
+int main()
+{
+  testOrder();
+  testTies();
+  testFifo();
+  testSampleNet();
+  return unitTestResult("tNodeHeapTest");
+}
+
+//=========================================================================
+//
+//
+//                          End of tNodeHeapTest.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,285 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tSnapshotTest.cpp: Unit test of tSnapshot
+**
+**  Sets a different value of each variable on a few nodes and checks that
+**  the *_dyn file holds the columns in the order of the former writer of
+**  tCOutput, corrected for the slope, also when the values are read from
+**  the state store (tCNodeState), and in the order of OUTVIZVARS when it
+**  is given. Checks the header and runs of VIZCOMPRESS = 1.
+**
+***************************************************************************/
+
+#include "src/tInOut/tSnapshot.h"
+#include "src/tInOut/tInputFile.h"
+#include "src/tCNode/tCNode.h"
+#include "src/tCNode/tCNodeState.h"
+#include "src/Headers/globalIO.h"
+#include "testing/unit/unitTest.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+// Globals of main.cpp
+tOstream Cout(cout);
+Predicates predicate;
+
+static const char *kInput = "tSnapshotTest.in";
+static const char *kOutput = "tSnapshotTest_dyn";
+static const int kNodes = 5;
+
+//=========================================================================
+//
+//  Variables in the order of the former *_dyn files, then those written
+//  only when named in OUTVIZVARS. Srf has no set function and is set in
+//  the state store.
+//
+//=========================================================================
+
+struct tVar {
+  const char *name;
+  void (tCNode::*set)(double);
+  int vertical;
+};
+
+static const tVar kVars[] = {
+  { "Nwt",        &tCNode::setNwtNew, 1 },
+  { "Nf",         &tCNode::setNfNew, 1 },
+  { "Nt",         &tCNode::setNtNew, 1 },
+  { "Mu",         &tCNode::setMuNew, 1 },
+  { "Qpout",      &tCNode::setQpout, 0 },
+  { "Qpin",       &tCNode::setQpin, 0 },
+  { "GwChng",     &tCNode::setGwaterChng, 0 },
+  { "Srf",        NULL, 0 },
+  { "Rain",       &tCNode::setRain, 0 },
+  { "SoilMoist",  &tCNode::setSoilMoistureSC, 0 },
+  { "RootMoist",  &tCNode::setRootMoistureSC, 0 },
+  { "AirT",       &tCNode::setAirTemp, 0 },
+  { "DewT",       &tCNode::setDewTemp, 0 },
+  { "SurfT",      &tCNode::setSurfTemp, 0 },
+  { "SoilT",      &tCNode::setSoilTemp, 0 },
+  { "AirPress",   &tCNode::setAirPressure, 0 },
+  { "RelHum",     &tCNode::setRelHumid, 0 },
+  { "SkyCov",     &tCNode::setSkyCover, 0 },
+  { "Wind",       &tCNode::setWindSpeed, 0 },
+  { "NetRad",     &tCNode::setNetRad, 0 },
+  { "ActEvp",     &tCNode::setActEvap, 0 },
+  { "ET",         &tCNode::setEvapoTrans, 0 },
+  { "EvpSoil",    &tCNode::setEvapSoil, 0 },
+  { "GFlux",      &tCNode::setGFlux, 0 },
+  { "HFlux",      &tCNode::setHFlux, 0 },
+  { "LFlux",      &tCNode::setLFlux, 0 },
+  { "NetPrecip",  &tCNode::setNetPrecipitation, 0 },
+  { "Recharge",   &tCNode::setRecharge, 0 },
+  { "Qstrm",      &tCNode::setQstrm, 0 },
+  { "Hlev",       &tCNode::setHlevel, 0 },
+  { "CanStorage", &tCNode::setCanStorage, 0 },
+  { "FlwVlc",     &tCNode::setFlowVelocity, 0 },
+  { "Mi",         &tCNode::setMiNew, 1 },
+  { "Ri",         &tCNode::setRiNew, 0 },
+  { "IWE",        &tCNode::setIceWE, 0 },
+  { "LWE",        &tCNode::setLiqWE, 0 },
+  { "ST",         &tCNode::setSnTempC, 0 },
+  { "SnMelt",     &tCNode::setLiqRouted, 0 },
+  { "IntSWE",     &tCNode::setIntSWE, 0 }
+};
+
+static const int kNumDefault = 32;
+static const int kNumVars = sizeof(kVars)/sizeof(kVars[0]);
+
+static double Value(int v, int i) { return 100.0 * (v + 1) + i; }
+
+static double Slope(int i) { return 0.1 * i; }
+
+//=========================================================================
+//
+//  Sample nodes
+//
+//=========================================================================
+
+struct tSampleNodes
+{
+  tCNode cnodes[kNodes];
+  tEdge edges[kNodes];
+  vector<tCNode*> nodes;
+  tCNodeState state;
+
+  tSampleNodes()
+  {
+    for (int i = 0; i < kNodes; i++) {
+      edges[i].setSlope(Slope(i));
+      cnodes[i].setFlowEdg(&edges[i]);
+      for (int v = 0; v < kNumVars; v++)
+        if (kVars[v].set)
+          (cnodes[i].*kVars[v].set)(Value(v, i));
+      nodes.push_back(&cnodes[i]);
+    }
+    // Srf through the store
+    state.attach(nodes);
+    for (int i = 0; i < kNodes; i++)
+      state.value(kStSrf, i) = Value(7, i);
+    state.detach();
+  }
+};
+
+static void WriteInput(const char *lines)
+{
+  FILE *fp = fopen(kInput, "w");
+  fputs(lines, fp);
+  fputs("\nEND\n\n", fp);
+  fclose(fp);
+}
+
+// The file written by 'snap' for 'nodes'
+static vector<char> Snapshot(tSnapshot &snap, const vector<tCNode*> &nodes)
+{
+  snap.gather(nodes);
+  ofstream ostr(kOutput, ios::out | ios::binary);
+  snap.write(ostr);
+  ostr.close();
+
+  ifstream istr(kOutput, ios::in | ios::binary);
+  vector<char> bytes((istreambuf_iterator<char>(istr)),
+                     istreambuf_iterator<char>());
+  remove(kOutput);
+  return bytes;
+}
+
+// Column 'c' of an uncompressed file is variable 'v'
+static void CheckColumn(const vector<char> &bytes, int c, int v)
+{
+  const float *col = reinterpret_cast<const float*>(bytes.data()) + c*kNodes;
+  for (int i = 0; i < kNodes; i++) {
+    double expect = Value(v, i);
+    if (kVars[v].vertical)
+      expect /= cos(atan(Slope(i)));
+    CHECK((double)col[i] == (double)(float)expect);
+  }
+}
+
+//=========================================================================
+//
+//  Tests
+//
+//=========================================================================
+
+static void testDefaultOrder()
+{
+  tSampleNodes sample;
+
+  WriteInput("VIZCOMPRESS:\n0");
+  tInputFile infile(kInput);
+  tSnapshot snap(infile);
+  CHECK(snap.getNumColumns() == kNumDefault);
+
+  vector<char> bytes = Snapshot(snap, sample.nodes);
+  CHECK(bytes.size() == (size_t)kNumDefault*kNodes*sizeof(float));
+  if (bytes.size() == (size_t)kNumDefault*kNodes*sizeof(float))
+    for (int c = 0; c < kNumDefault; c++)
+      CheckColumn(bytes, c, c);
+
+  // The same file from the arrays of the state store
+  sample.state.attach(sample.nodes);
+  CHECK(Snapshot(snap, sample.nodes) == bytes);
+
+  // Not in the order of the store: from the nodes
+  vector<tCNode*> some(sample.nodes.begin(), sample.nodes.begin() + 3);
+  vector<char> part = Snapshot(snap, some);
+  CHECK(part.size() == (size_t)kNumDefault*3*sizeof(float));
+  sample.state.detach();
+  CHECK(Snapshot(snap, some) == part);
+}
+
+static void testSelected()
+{
+  tSampleNodes sample;
+  const char *names[] = { "RelHum", "Mi", "Nwt", "SnMelt", "Srf" };
+  const int n = 5;
+  int vars[n];
+
+  WriteInput("OUTVIZVARS:\nRelHum, Mi Nwt,SnMelt\tSrf");
+  tInputFile infile(kInput);
+  tSnapshot snap(infile);
+  CHECK(snap.getNumColumns() == n);
+
+  for (int c = 0; c < n; c++)
+    for (int v = 0; v < kNumVars; v++)
+      if (strcmp(names[c], kVars[v].name) == 0)
+        vars[c] = v;
+
+  sample.state.attach(sample.nodes);
+  vector<char> bytes = Snapshot(snap, sample.nodes);
+  CHECK(bytes.size() == (size_t)n*kNodes*sizeof(float));
+  if (bytes.size() == (size_t)n*kNodes*sizeof(float))
+    for (int c = 0; c < n; c++)
+      CheckColumn(bytes, c, vars[c]);
+  sample.state.detach();
+  CHECK(Snapshot(snap, sample.nodes) == bytes);
+}
+
+static void testCompress()
+{
+  tSampleNodes sample;
+
+  // All nodes of the same Rain, different Nwt
+  for (int i = 0; i < kNodes; i++)
+    sample.cnodes[i].setRain(2.5);
+
+  WriteInput("VIZCOMPRESS:\n1\nOUTVIZVARS:\nRain,Nwt");
+  tInputFile infile(kInput);
+  tSnapshot snap(infile);
+  vector<char> bytes = Snapshot(snap, sample.nodes);
+
+  // Header, one run of Rain, Nwt as is
+  size_t size = 4 + 3*sizeof(int) + sizeof(int) + sizeof(int) + sizeof(float)
+                + sizeof(int) + kNodes*sizeof(float);
+  CHECK(bytes.size() == size);
+  if (bytes.size() != size)
+    return;
+
+  const char *p = bytes.data();
+  int head[3], runs, count, none;
+  float value;
+  CHECK(memcmp(p, kSnapshotTag, 4) == 0);
+  memcpy(head, p + 4, sizeof(head));
+  CHECK(head[0] == kSnapshotVersion && head[1] == 2 && head[2] == kNodes);
+  p += 4 + sizeof(head);
+  memcpy(&runs, p, sizeof(int));
+  memcpy(&count, p + sizeof(int), sizeof(int));
+  memcpy(&value, p + 2*sizeof(int), sizeof(float));
+  CHECK(runs == 1 && count == kNodes && value == 2.5f);
+  p += 2*sizeof(int) + sizeof(float);
+  memcpy(&none, p, sizeof(int));
+  CHECK(none == 0);
+
+  vector<char> column(p + sizeof(int), p + sizeof(int) + kNodes*sizeof(float));
+  CheckColumn(column, 0, 0);
+}
+
+int main()
+{
+  testDefaultOrder();
+  testSelected();
+  testCompress();
+  remove(kInput);
+  return unitTestResult("tSnapshotTest");
+}
+
+//=========================================================================
+//
+//
+//                          End of tSnapshotTest.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  tTravelQueueTest.cpp: Unit test of tTravelQueue
+**
+**  Checks deposits, retrievals and releases of the circular buffer,
+**  including deposits before the oldest bin and beyond the capacity,
+**  against a map of the steps (the former sorted lists of tKinemat),
+**  and the restart round trip.
+**
+***************************************************************************/
+
+#include "src/tCNode/tTravelQueue.h"
+#include "testing/unit/unitTest.h"
+
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+using namespace std;
+
+static void checkSame(const tTravelQueue &queue, const map<int, double> &ref,
+                      int first, int last)
+{
+  CHECK(queue.getSize() == (int)ref.size());
+  CHECK(queue.isEmpty() == ref.empty());
+  for (int step = first; step <= last; step++) {
+    map<int, double>::const_iterator it = ref.find(step);
+    CHECK(queue.value(step) == (it == ref.end() ? 0.0 : it->second));
+  }
+}
+
+static void testBasics()
+{
+  tTravelQueue queue(5);
+  CHECK(queue.getCapacity() == 8);
+  CHECK(queue.isEmpty());
+  CHECK(queue.value(3) == 0.0);
+
+  queue.deposit(10, 1.5);
+  queue.deposit(12, 2.0);
+  queue.deposit(10, 0.5);
+  CHECK(queue.getSize() == 2);
+  CHECK(queue.value(10) == 2.0);
+  CHECK(queue.value(11) == 0.0);
+  CHECK(queue.value(12) == 2.0);
+
+  // A step before the oldest bin
+  queue.deposit(8, 3.0);
+  CHECK(queue.value(8) == 3.0);
+  CHECK(queue.value(10) == 2.0);
+
+  // Beyond the capacity: the buffer doubles
+  queue.deposit(30, 4.0);
+  CHECK(queue.getCapacity() == 32);
+  CHECK(queue.value(30) == 4.0);
+  CHECK(queue.value(12) == 2.0);
+
+  queue.release(10);
+  CHECK(queue.getSize() == 2);
+  CHECK(queue.value(8) == 0.0 && queue.value(10) == 0.0);
+  CHECK(queue.value(12) == 2.0);
+
+  queue.release(40);
+  CHECK(queue.isEmpty());
+
+  // An empty queue starts again at the next deposit
+  queue.deposit(100, 1.0);
+  CHECK(queue.value(100) == 1.0);
+  queue.clear();
+  CHECK(queue.isEmpty() && queue.value(100) == 0.0);
+
+  ostringstream out;
+  queue.deposit(4, 0.25);
+  queue.deposit(6, 0.5);
+  queue.print(out);
+  CHECK(out.str() == "4 6 \n0.25 0.5 \n");
+}
+
+// Random deposits and releases as the hillslope routing makes them: the
+// Reff interval 'now' advances, deposits fall from a few steps before it
+// to the travel time after it
+static void testRouting()
+{
+  tTravelQueue queue(4);
+  map<int, double> ref;
+
+  srand(2025);
+  for (int now = 0; now < 400; now++) {
+    int n = rand() % 6;
+    for (int k = 0; k < n; k++) {
+      int step = now - 2 + rand() % (now < 200 ? 20 : 70);
+      double q = (rand() % 1000) / 8.0;
+      queue.deposit(step, q);
+      ref[step] += q;
+    }
+    checkSame(queue, ref, now - 5, now + 75);
+
+    if (now % 3 == 0) {
+      queue.release(now);
+      while (!ref.empty() && ref.begin()->first <= now)
+        ref.erase(ref.begin());
+      checkSame(queue, ref, now - 5, now + 75);
+    }
+  }
+}
+
+static void testRestart()
+{
+  const char *name = "tTravelQueueTest.rst";
+  tTravelQueue queue(8), copy;
+
+  queue.deposit(7, 1.0);
+  queue.deposit(9, 2.5);
+  queue.deposit(3, 0.75);
+  queue.deposit(40, 6.0);
+
+  fstream out(name, ios::out | ios::binary);
+  queue.writeRestart(out);
+  out.close();
+
+  copy.deposit(1, 9.0);
+  fstream in(name, ios::in | ios::binary);
+  copy.readRestart(in);
+  in.close();
+  remove(name);
+
+  CHECK(copy.getSize() == 4);
+  for (int step = 0; step < 50; step++)
+    CHECK(copy.value(step) == queue.value(step));
+}
+
+int main()
+{
+  testBasics();
+  testRouting();
+  testRestart();
+  return unitTestResult("tTravelQueueTest");
+}
+
+//=========================================================================
+//
+//
+//                          End of tTravelQueueTest.cpp
+//
+//
+//=========================================================================
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * TIN-based Real-time Integrated Basin Simulator (tRIBS)
+ * Distributed Hydrologic Model
+ *
+ * Copyright (c) 2025. tRIBS Developers
+ *
+ * See LICENSE file in the project root for full license information.
+ ******************************************************************************/
+
+/***************************************************************************
+**
+**  unitTest.h: Checks of the unit tests in testing/unit
+**
+**  Each test is a program built and registered with ctest by the
+**  CMakeLists.txt of the project root. CHECK() prints the failed
+**  condition and counts it; main() returns unitTestResult(), nonzero if
+**  any check failed.
+**
+***************************************************************************/
+
+#ifndef UNITTEST_H
+#define UNITTEST_H
+
+#include <iostream>
+#include <cmath>
+
+inline int unitTestFailures = 0;
+
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if (!(cond)) {                                                      \
+      std::cout << __FILE__ << ":" << __LINE__                          \
+                << ": CHECK(" #cond ") failed" << std::endl;            \
+      unitTestFailures++;                                               \
+    }                                                                   \
+  } while (0)
+
+#define CHECK_CLOSE(a, b, tol) CHECK(std::fabs((a) - (b)) <= (tol))
+
+inline int unitTestResult(const char *name)
+{
+  if (unitTestFailures)
+    std::cout << name << ": " << unitTestFailures << " checks failed"
+              << std::endl;
+  else
+    std::cout << name << ": all checks passed" << std::endl;
+  return unitTestFailures ? 1 : 0;
+}
+
+#endif
+
+//=========================================================================
+//
+//
+//                          End of unitTest.h
+//
+//
+//=========================================================================